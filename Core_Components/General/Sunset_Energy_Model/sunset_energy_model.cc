@@ -44,7 +44,7 @@ Sunset_Energy_Model::Sunset_Energy_Model()
 	
 	stat = NULL;
 	
-	Sunset_Debug::debugInfo(3, -1, "Sunset_Energy_Model::Sunset_Energy_Model CREATED");
+	SUNSET_DEBUG_LOG(3, -1, "Sunset_Energy_Model::Sunset_Energy_Model CREATED");
 }
 
 /*!
@@ -65,19 +65,19 @@ void Sunset_Energy_Model::start()
 	// check if power consumptions for tx, rx and idle have been set
 	if ( txPower.size() == 0 ) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Energy_Model::start() No TX Consumption set!");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Energy_Model::start() No TX Consumption set!");
 		exit(-1);
 	}
 	
 	if ( rxPower == 0.0 ) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Energy_Model::start() No RX Consumption set!");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Energy_Model::start() No RX Consumption set!");
 		exit(-1);
 	}
 	
 	if ( idlePower == 0.0 ) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Energy_Model::start() No IDLE Consumption set!");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Energy_Model::start() No IDLE Consumption set!");
 		exit(-1);
 	}
 	
@@ -136,7 +136,7 @@ int Sunset_Energy_Model::command(int argc, const char*const* argv)
                         totalEnergy = atof(argv[2]);
 			residualEnergy = totalEnergy;
 			
-			Sunset_Debug::debugInfo(3, -1, "Sunset_Energy_Model::command totalEnergy %f", totalEnergy);
+			SUNSET_DEBUG_LOG(3, -1, "Sunset_Energy_Model::command totalEnergy %f", totalEnergy);
 			
 			return TCL_OK;
                 }
@@ -147,7 +147,7 @@ int Sunset_Energy_Model::command(int argc, const char*const* argv)
                 {
                         rxPower = atof(argv[2]);
 			
-			Sunset_Debug::debugInfo(3, -1, "Sunset_Energy_Model::command rxPower %f", rxPower);
+			SUNSET_DEBUG_LOG(3, -1, "Sunset_Energy_Model::command rxPower %f", rxPower);
 			
                         return TCL_OK;
                 } 
@@ -158,7 +158,7 @@ int Sunset_Energy_Model::command(int argc, const char*const* argv)
                 {
                         idlePower = atof(argv[2]);
 			
-			Sunset_Debug::debugInfo(3, -1, "Sunset_Energy_Model::command idlePower %f", idlePower);
+			SUNSET_DEBUG_LOG(3, -1, "Sunset_Energy_Model::command idlePower %f", idlePower);
 			
                         return TCL_OK;
                 } 
@@ -171,7 +171,7 @@ int Sunset_Energy_Model::command(int argc, const char*const* argv)
 			
 			txTime[atof(argv[2])] = 0.0;
 			
-			Sunset_Debug::debugInfo(3, -1, "Sunset_Energy_Model::command setTxConsumption %f -> %f", atof(argv[2]), fromuPaToWatt(atof(argv[2])));
+			SUNSET_DEBUG_LOG(3, -1, "Sunset_Energy_Model::command setTxConsumption %f -> %f", atof(argv[2]), fromuPaToWatt(atof(argv[2])));
 			
                         return TCL_OK;
                 }
@@ -182,7 +182,7 @@ int Sunset_Energy_Model::command(int argc, const char*const* argv)
 			
 			eneAddress = atoi(argv[2]);
 			
-			Sunset_Debug::debugInfo(3, -1, "Sunset_Energy_Model::command eneAddress %d", getModuleAddress());
+			SUNSET_DEBUG_LOG(3, -1, "Sunset_Energy_Model::command eneAddress %d", getModuleAddress());
 			
 			return TCL_OK;
 		}
@@ -197,7 +197,7 @@ int Sunset_Energy_Model::command(int argc, const char*const* argv)
 			
 			txTime[atof(argv[2])] = 0.0;
 			
-			Sunset_Debug::debugInfo(3, -1, "Sunset_Energy_Model::command setTxConsumption %f -> %f", atof(argv[2]), atof(argv[3]));
+			SUNSET_DEBUG_LOG(3, -1, "Sunset_Energy_Model::command setTxConsumption %f -> %f", atof(argv[2]), atof(argv[3]));
 			
                         return TCL_OK;
                 }
@@ -306,7 +306,7 @@ void Sunset_Energy_Model::setTxDuration(double pow, double sec)
 	
 	residualEnergy = residualEnergy - (txPower[pow] * sec);
 	
-	Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Energy_Model::setTxDuration Sec %f - Tot Sec %f - Residual Energy %f", sec, txTime[pow], residualEnergy);
+	SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Energy_Model::setTxDuration Sec %f - Tot Sec %f - Residual Energy %f", sec, txTime[pow], residualEnergy);
 	
 	if (Sunset_Statistics::use_stat() && stat != NULL) {
 		
@@ -326,7 +326,7 @@ void Sunset_Energy_Model::setRxDuration(double sec)
 	
 	residualEnergy = residualEnergy - (rxPower * sec);
 	
-	Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Energy_Model::setRxDuration Sec %f - Tot Sec %f - Residual Energy %f", sec, rxTime, residualEnergy);
+	SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Energy_Model::setRxDuration Sec %f - Tot Sec %f - Residual Energy %f", sec, rxTime, residualEnergy);
 	
 	if (Sunset_Statistics::use_stat() && stat != NULL) {
 		
@@ -346,7 +346,7 @@ void Sunset_Energy_Model::setIdleDuration(double sec)
 	
 	residualEnergy = residualEnergy - (idlePower * sec);
 	
-	Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Energy_Model::setIdleDuration Sec %f - Tot Sec %f - Residual Energy %f", sec, idleTime, residualEnergy);
+	SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Energy_Model::setIdleDuration Sec %f - Tot Sec %f - Residual Energy %f", sec, idleTime, residualEnergy);
 	
 	if (Sunset_Statistics::use_stat() && stat != NULL) {
 		
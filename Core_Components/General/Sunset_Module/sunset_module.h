@@ -47,7 +47,7 @@ public:
 	
 	virtual int notify_info(list<notified_info> linfo) 
 	{ 
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), " Sunset_Module::notify_info NOTHING TO DO");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), " Sunset_Module::notify_info NOTHING TO DO");
 		return 0; 
 	} 
 	
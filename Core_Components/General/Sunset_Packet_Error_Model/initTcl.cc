@@ -1,3 +1,5 @@
-static char code[] = "";
+static char code[] = "\n\
+Module/Sunset_Packet_Error_Model set usePerTable_ 1\n\
+Module/Sunset_Packet_Error_Model set perTableStep_ 0.05";
 #include "tclcl.h"
 EmbeddedTcl Sunset_Packet_Error_Model_TclCode(code);
@@ -1 +1,4 @@
 # Dummy Initialization
+
+Module/Sunset_Packet_Error_Model set usePerTable_ 1
+Module/Sunset_Packet_Error_Model set perTableStep_ 0.05
@@ -51,6 +51,16 @@ Sunset_Packet_Error_Model::Sunset_Packet_Error_Model() : TclObject()
 	PER = 0.0;
 	RxSnrPenalty_dB_ = 0.0;
 	
+	usePerTable = 1;
+	perTableStep = 0.05;
+	perTableSize = 0;
+	tableStep = 0.0;
+	lastBits = -1;
+	lastRow = 0;
+	
+	bind("usePerTable_", &usePerTable);
+	bind("perTableStep_", &perTableStep);
+	
 	per_model = this;	
 }
 
@@ -95,10 +105,12 @@ int Sunset_Packet_Error_Model::command( int argc, const char*const* argv )
 			}
 			else {
 				
-				Sunset_Debug::debugInfo(-1, -1, "Sunset_Packet_Error_Model::command Unknown Error Model");
+				SUNSET_DEBUG_LOG(-1, -1, "Sunset_Packet_Error_Model::command Unknown Error Model");
 				exit(1);
 			}
 			
+			buildPerTable();
+			
 			return TCL_OK;
 		}
 	}
@@ -122,6 +134,7 @@ Sunset_Packet_Error_Model* Sunset_Packet_Error_Model::instance()
 
 /*!
  * 	@brief The getPER function returns the Packet Error Rate according to the selected packet error model.
+ *	When the PER table is used the value is interpolated from the row of the given packet length.
  *	@param snr The Signal-to-noise ratio.
  *  	@param nbits Packet size expressed in bits.
  * 	@retval PER Packet Error Rate.
@@ -132,12 +145,14 @@ double Sunset_Packet_Error_Model::getPER(double snr, int nbits)
 	switch( model ) {
 			
 		case BPSK_MOD:
-			
-			return getPER_bpsk(snr, nbits);
-			
 		case FSK_MOD:
 			
-			return getPER_fsk(snr, nbits);
+			if ( usePerTable && perTableSize > 0 ) {
+				
+				return lookupPER(getPerRow(nbits), snr, nbits);
+			}
+			
+			return (model == BPSK_MOD) ? getPER_bpsk(snr, nbits) : getPER_fsk(snr, nbits);
 			
 		case STATIC_MOD:
 			
@@ -145,11 +160,34 @@ double Sunset_Packet_Error_Model::getPER(double snr, int nbits)
 			
 		default:
 			
-			Sunset_Debug::debugInfo(-1, -1, "Sunset_Packet_Error_Model::getPER No model defined - ERROR");
+			SUNSET_DEBUG_LOG(-1, -1, "Sunset_Packet_Error_Model::getPER No model defined - ERROR");
 			exit(1);
 	}
 }
 
+/*!
+ * 	@brief The getBER function returns the Bit Error Rate of the selected modulation, the SNR penalty on the receiver is applied.
+ *	@param snr The Signal-to-noise ratio.
+ * 	@retval BER Bit Error Rate.
+ */
+
+double Sunset_Packet_Error_Model::getBER(double snr)
+{
+	double snr_with_penalty = snr * pow(10, RxSnrPenalty_dB_/10.0);
+	
+	if ( snr_with_penalty < 0.0 ) {
+		
+		snr_with_penalty = 0.0;
+	}
+	
+	if ( model == FSK_MOD ) {
+		
+		return 0.5*erfc(sqrt(snr_with_penalty/2.0));
+	}
+	
+	return 0.5*erfc(sqrt(snr_with_penalty));
+}
+
 /*!
  * 	@brief The getPER_bpsk function returns the Packet Error Rate according to the BPSK modulation.
  *	@param snr The Signal-to-noise ratio.
@@ -161,12 +199,11 @@ double Sunset_Packet_Error_Model::getPER_bpsk(double snr, int nbits)
 {
 	if ( model != BPSK_MOD ) {
 		
-		Sunset_Debug::debugInfo(-1, -1, "Sunset_Packet_Error_Model::getPER_bpsk BPSK model unexpected - ERROR");
+		SUNSET_DEBUG_LOG(-1, -1, "Sunset_Packet_Error_Model::getPER_bpsk BPSK model unexpected - ERROR");
 		exit(1);
 	}
 	
-	double snr_with_penalty = snr * pow(10, RxSnrPenalty_dB_/10.0);
-	double ber = 0.5*erfc(sqrt(snr));  
+	double ber = getBER(snr);
 	
 	double per = 1-pow(1 - ber, nbits );
 	
@@ -184,18 +221,130 @@ double Sunset_Packet_Error_Model::getPER_fsk(double snr, int nbits)
 {
 	if ( model != FSK_MOD ) {
 		
-		Sunset_Debug::debugInfo(-1, -1, "Sunset_Packet_Error_Model::getPER_fsk FSK model unexpected - ERROR");
+		SUNSET_DEBUG_LOG(-1, -1, "Sunset_Packet_Error_Model::getPER_fsk FSK model unexpected - ERROR");
 		exit(1);
 	}
 	
-	double snr_with_penalty = snr * pow(10, RxSnrPenalty_dB_/10.0);
-	double ber = 0.5*erfc(sqrt(snr/2.0));  
+	double ber = getBER(snr);
 	
 	double per = 1-pow(1 - ber, nbits );
 	
 	return per;
 }
 
+/*!
+ * 	@brief The buildPerTable function computes log(1 - BER) for the SNR values of the table, from PER_TABLE_MIN_SNR_DB 
+ *	to PER_TABLE_MAX_SNR_DB with step perTableStep. It is called when the error model is configured, the rows for 
+ *	the different packet lengths are then computed from these values the first time a length is used.
+ */
+
+void Sunset_Packet_Error_Model::buildPerTable()
+{
+	double ber = 0.0;
+	
+	perTable.clear();
+	logSuccess.clear();
+	lastBits = -1;
+	lastRow = 0;
+	perTableSize = 0;
+	
+	if ( (model != BPSK_MOD && model != FSK_MOD) || !usePerTable ) {
+		
+		return;
+	}
+	
+	if ( perTableStep <= 0.0 ) {
+		
+		SUNSET_DEBUG_LOG(-1, -1, "Sunset_Packet_Error_Model::buildPerTable ERROR step %f - PER computed for each packet", perTableStep);
+		
+		return;
+	}
+	
+	tableStep = perTableStep;
+	perTableSize = (int)ceil((PER_TABLE_MAX_SNR_DB - PER_TABLE_MIN_SNR_DB) / tableStep) + 1;
+	logSuccess.resize(perTableSize);
+	
+	for ( int i = 0; i < perTableSize; i++ ) {
+		
+		ber = getBER(pow(10, (PER_TABLE_MIN_SNR_DB + i * tableStep)/10.0));
+		
+		logSuccess[i] = log1p(-ber);
+	}
+	
+	SUNSET_DEBUG_LOG(3, -1, "Sunset_Packet_Error_Model::buildPerTable model %d penalty %f size %d", model, RxSnrPenalty_dB_, perTableSize);
+}
+
+/*!
+ * 	@brief The getPerRow function returns the PER table row of the given packet length, creating it the first time.
+ *  	@param nbits Packet size expressed in bits.
+ * 	@retval row The PER of each SNR value of the table, 0 if the maximum number of rows has been reached.
+ */
+
+vector<double>* Sunset_Packet_Error_Model::getPerRow(int nbits)
+{
+	map<int, vector<double> >::iterator it;
+	vector<double>* row = 0;
+	
+	if ( nbits == lastBits ) {
+		
+		return lastRow;
+	}
+	
+	it = perTable.find(nbits);
+	
+	if ( it != perTable.end() ) {
+		
+		row = &(it->second);
+	}
+	else if ( (int)perTable.size() < PER_TABLE_MAX_ROWS ) {
+		
+		row = &(perTable[nbits]);
+		row->resize(perTableSize);
+		
+		for ( int i = 0; i < perTableSize; i++ ) {
+			
+			(*row)[i] = -expm1(nbits * logSuccess[i]);
+		}
+	}
+	
+	lastBits = nbits;
+	lastRow = row;
+	
+	return row;
+}
+
+/*!
+ * 	@brief The lookupPER function interpolates the PER of the given SNR from a table row. Outside the table range,
+ *	or when no row is available, the PER is computed.
+ *  	@param row The table row of the packet length.
+ *	@param snr The Signal-to-noise ratio.
+ *  	@param nbits Packet size expressed in bits.
+ * 	@retval PER Packet Error Rate.
+ */
+
+double Sunset_Packet_Error_Model::lookupPER(vector<double>* row, double snr, int nbits)
+{
+	double pos = 0.0;
+	double frac = 0.0;
+	int i = 0;
+	
+	if ( row == 0 || snr <= 0.0 ) {
+		
+		return 1 - pow(1 - getBER(snr), nbits);
+	}
+	
+	pos = (10.0 * log10(snr) - PER_TABLE_MIN_SNR_DB) / tableStep;
+	
+	if ( pos < 0.0 || pos >= perTableSize - 1 ) {
+		
+		return 1 - pow(1 - getBER(snr), nbits);
+	}
+	
+	i = (int)pos;
+	frac = pos - i;
+	
+	return (*row)[i] + frac * ((*row)[i + 1] - (*row)[i]);
+}
 
 /*!
  * 	@brief The getPER_static function returns a static PER.
@@ -206,7 +355,7 @@ double Sunset_Packet_Error_Model::getPER_static()
 {
 	if ( model != STATIC_MOD ) {
 		
-		Sunset_Debug::debugInfo(-1, -1, "Sunset_Packet_Error_Model::getPER_static STATIC model unexpected - ERROR");
+		SUNSET_DEBUG_LOG(-1, -1, "Sunset_Packet_Error_Model::getPER_static STATIC model unexpected - ERROR");
 		exit(1);
 	}
 	
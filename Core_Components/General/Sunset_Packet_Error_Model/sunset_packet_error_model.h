@@ -29,12 +29,18 @@
 #include <string>
 #include <map>
 #include <set>
+#include <vector>
 #include <stdlib.h>
+#include <math.h>
 #include <sunset_debug.h>
 #include <sunset_module.h>
 
 enum error_model { BPSK_MOD = 0, STATIC_MOD = 1, FSK_MOD = 2};
 
+#define PER_TABLE_MIN_SNR_DB	-20.0	/*!< \brief Lowest SNR (dB) in the PER table, below it the PER is computed. */
+#define PER_TABLE_MAX_SNR_DB	40.0	/*!< \brief Highest SNR (dB) in the PER table, above it the PER is computed. */
+#define PER_TABLE_MAX_ROWS	256	/*!< \brief Maximum number of packet lengths stored in the PER table. */
+
 /*! @brief This class defines a packet error model that can be used by the SUNSET modules to obtain the PER related to a certain data packet according to the chosen modulation. Actually the supported modulation are BPSK, FSK or static PER. */
 
 class Sunset_Packet_Error_Model : public TclObject, public Sunset_Module {
@@ -58,9 +64,24 @@ private:
 	double RxSnrPenalty_dB_; 	/*!< \brief SNR penalty on the receiver */
 	int model;			/*!< \brief Packet error model */
 	
+	int usePerTable;		/*!< \brief If 1 the PER is read from the precomputed table, otherwise it is computed for each packet */
+	double perTableStep;		/*!< \brief SNR step (dB) of the PER table */
+	
+	int perTableSize;				/*!< \brief Number of SNR values in the PER table */
+	double tableStep;				/*!< \brief SNR step (dB) used when the PER table has been built */
+	vector<double> logSuccess;			/*!< \brief log(1 - BER) for each SNR value of the table */
+	map<int, vector<double> > perTable;		/*!< \brief PER for each packet length (bits) and SNR value */
+	int lastBits;					/*!< \brief Packet length of the last used table row */
+	vector<double>* lastRow;			/*!< \brief Last used table row */
+	
+	double getBER(double);
 	double getPER_bpsk(double, int );
 	double getPER_fsk(double, int );
 	double getPER_static();
+	
+	void buildPerTable();
+	vector<double>* getPerRow(int);
+	double lookupPER(vector<double>*, double, int);
 };
 
 #endif
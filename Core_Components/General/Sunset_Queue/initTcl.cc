@@ -5,6 +5,14 @@ Queue/Sunset_Queue set		qlimBytes	50000\n\
 \n\
 Queue/Sunset_Queue set		limit_			50\n\
 \n\
+Queue/Sunset_Queue set		perNextHop_		1\n\
+Queue/Sunset_Queue set		usePriority_		1\n\
+Queue/Sunset_Queue set		quantum_		0\n\
+Queue/Sunset_Queue set		limitControl_		0\n\
+Queue/Sunset_Queue set		limitData_		0\n\
+Queue/Sunset_Queue set		limitBytesControl_	0\n\
+Queue/Sunset_Queue set		limitBytesData_		0\n\
+\n\
 Queue/Sunset_Queue set moduleAddress -1\n\
 Queue/Sunset_Queue set debug_ false\n\
 ";
@@ -6,5 +6,13 @@ Queue/Sunset_Queue set		qlimBytes	50000
 
 Queue/Sunset_Queue set		limit_			50
 
+Queue/Sunset_Queue set		perNextHop_		1
+Queue/Sunset_Queue set		usePriority_		1
+Queue/Sunset_Queue set		quantum_		0
+Queue/Sunset_Queue set		limitControl_		0
+Queue/Sunset_Queue set		limitData_		0
+Queue/Sunset_Queue set		limitBytesControl_	0
+Queue/Sunset_Queue set		limitBytesData_		0
+
 Queue/Sunset_Queue set moduleAddress -1
 Queue/Sunset_Queue set debug_ false
@@ -37,11 +37,25 @@ public:
 	
 } class_Sunset_Queue;
 
-/*! @brief This constructor sets up the queue parameters and creates a new PacketQueue object. */
+/*! @brief This constructor sets up the queue parameters. The sub-queues are created when the first packet for a given class and next hop is enqueued. */
 
 Sunset_Queue::Sunset_Queue() : TclObject() 
 {
 	
+	perNextHop_ = 1;
+	usePriority_ = 1;
+	quantum_ = 0;
+	len_ = 0;
+	bytes_ = 0;
+	
+	for (int i = 0; i < SUNSET_QUEUE_CLASSES; i++) {
+		
+		classLimit_[i] = 0;
+		classLimitBytes_[i] = 0;
+		classLen_[i] = 0;
+		classBytes_[i] = 0;
+	}
+	
 	// Get variables initialization from the Tcl script
 	
 	bind_bool("drop_front_", &drop_front_);
@@ -49,12 +63,37 @@ Sunset_Queue::Sunset_Queue() : TclObject()
 	bind("qlimBytes", &qlimBytes);
 	bind("limit_", &qlim_);
 	bind("moduleAddress", &module_address);
+	bind("perNextHop_", &perNextHop_);
+	bind("usePriority_", &usePriority_);
+	bind("quantum_", &quantum_);
+	bind("limitControl_", &classLimit_[SUNSET_QUEUE_CONTROL]);
+	bind("limitData_", &classLimit_[SUNSET_QUEUE_DATA]);
+	bind("limitBytesControl_", &classLimitBytes_[SUNSET_QUEUE_CONTROL]);
+	bind("limitBytesData_", &classLimitBytes_[SUNSET_QUEUE_DATA]);
 	
-	pq_ = new PacketQueue();
+	// no module sends control packets of its own type through the queue, the control class is empty until addPriorityType is used
 	
 	stat = NULL;
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Queue limit %d dropFront %d qib %d", qlim_, drop_front_, qib_);
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Queue limit %d dropFront %d qib %d", qlim_, drop_front_, qib_);
+}
+
+Sunset_Queue::~Sunset_Queue() 
+{
+	map<int, sunset_sub_queue*>::iterator it;
+	
+	reset();
+	
+	for (int c = 0; c < SUNSET_QUEUE_CLASSES; c++) {
+		
+		for (it = subQueues_[c].begin(); it != subQueues_[c].end(); it++) {
+			
+			delete (it->second)->pq;
+			delete it->second;
+		}
+		
+		subQueues_[c].clear();
+	}
 }
 
 /*!
@@ -76,7 +115,7 @@ int Sunset_Queue::command(int argc, const char*const* argv)
 		
 		if (strcmp(argv[1], "start") == 0) {
 			
-			Sunset_Debug::debugInfo(1, getModuleAddress(), "Sunset_Agent::command start Module");
+			SUNSET_DEBUG_LOG(1, getModuleAddress(), "Sunset_Agent::command start Module");
 			start();
 			
 			return TCL_OK;
@@ -86,11 +125,21 @@ int Sunset_Queue::command(int argc, const char*const* argv)
 		
 		if (strcmp(argv[1], "stop") == 0) {
 			
-			Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Agent::command stop Module");
+			SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Agent::command stop Module");
 			stop();
 			
 			return TCL_OK;
 		}
+		
+		/* The "clearPriorityTypes" command removes all the packet types from the control class. */
+		
+		if (strcmp(argv[1], "clearPriorityTypes") == 0) {
+			
+			priorityTypes_.clear();
+			typeClass_.clear();
+			
+			return TCL_OK;
+		}
 	}
 	else if ( argc == 3 ) {
 		
@@ -99,11 +148,38 @@ int Sunset_Queue::command(int argc, const char*const* argv)
 		if (strcmp(argv[1], "setModuleAddress") == 0) {
 			
 			module_address = atoi(argv[2]);
-			Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Queue::command macAddress %d", getModuleAddress());
+			SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Queue::command macAddress %d", getModuleAddress());
 			
 			return (TCL_OK);
 		}
 		
+		/* The "addPriorityType" command adds the packet type with the given name (i.e. SUNSET_RTG) to the control class. */
+		
+		if (strcmp(argv[1], "addPriorityType") == 0) {
+			
+			priorityTypes_.insert(argv[2]);
+			typeClass_.clear();
+			
+			return (TCL_OK);
+		}
+		
+		/* The "getClassLength" command returns the number of packets and bytes of the given class (0 control, 1 data) in the queue. */
+		
+		if (strcmp(argv[1], "getClassLength") == 0) {
+			
+			int c = atoi(argv[2]);
+			
+			if (c < 0 || c >= SUNSET_QUEUE_CLASSES) {
+				
+				SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Queue::command getClassLength class %d ERROR", c);
+				
+				return TCL_ERROR;
+			}
+			
+			tcl.resultf("%d %d", classLen_[c], classBytes_[c]);
+			
+			return (TCL_OK);
+		}
 	}
 	
 	return TclObject::command(argc, argv);
@@ -138,113 +214,408 @@ void Sunset_Queue::stop()
 	return;
 }
 
-/*! @brief This function inserts a packet element at the beginning of the queue.
- *  @param[in] p The packet to be enqueued.
+/*! @brief This function returns the class of a packet: control if its type has been added to the priority types, data otherwise.
+ *  @param[in] p The packet.
  */
 
-void Sunset_Queue::enqueFront(Packet* p)
+int Sunset_Queue::getClass(Packet* p)
 {
+	map<int, int>::iterator it;
+	int type = (int)(HDR_CMN(p)->ptype());
+	int c = SUNSET_QUEUE_DATA;
 	
-	if (Sunset_Statistics::use_stat() && stat != NULL) {
+	if (!usePriority_) {
+		
+		return SUNSET_QUEUE_DATA;
+	}
+	
+	it = typeClass_.find(type);
+	
+	if (it != typeClass_.end()) {
+		
+		return it->second;
+	}
+	
+	if (priorityTypes_.find(packet_info.name((packet_t)type)) != priorityTypes_.end()) {
+		
+		c = SUNSET_QUEUE_CONTROL;
+	}
+	
+	typeClass_[type] = c;
+	
+	return c;
+}
+
+/*! @brief This function returns the key of the sub-queue of a packet inside its class: the next hop if perNextHop_ is set, 0 otherwise.
+ *  @param[in] p The packet.
+ */
+
+int Sunset_Queue::getNextHop(Packet* p)
+{
+	if (!perNextHop_) {
+		
+		return 0;
+	}
+	
+	return HDR_CMN(p)->next_hop();
+}
+
+/*! @brief This function returns the sub-queue of a packet, 0 if it does not exist.
+ *  @param[in] p The packet.
+ */
+
+sunset_sub_queue* Sunset_Queue::findSubQueue(Packet* p)
+{
+	int c = getClass(p);
+	map<int, sunset_sub_queue*>::iterator it = subQueues_[c].find(getNextHop(p));
+	
+	if (it == subQueues_[c].end()) {
+		
+		return 0;
+	}
+	
+	return it->second;
+}
+
+/*! @brief This function returns the sub-queue of a packet, it is created if it does not exist.
+ *  @param[in] p The packet.
+ */
+
+sunset_sub_queue* Sunset_Queue::getSubQueue(Packet* p)
+{
+	int c = getClass(p);
+	int h = getNextHop(p);
+	sunset_sub_queue* q = findSubQueue(p);
+	
+	if (q != 0) {
+		
+		return q;
+	}
+	
+	q = new sunset_sub_queue;
+	
+	q->pq = new PacketQueue();
+	q->nextHop = h;
+	q->cls = c;
+	q->deficit = 0;
+	q->active = false;
+	
+	subQueues_[c][h] = q;
+	
+	SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Queue::getSubQueue new sub-queue class %d nextHop %d", c, h);
+	
+	return q;
+}
+
+/*! @brief This function adds a packet to a sub-queue and updates the queue counters. A sub-queue becoming non empty enters the round robin list
+ *  of its class, at the end or at the front if the packet has to be served first.
+ *  @param[in] q The sub-queue.
+ *  @param[in] p The packet.
+ *  @param[in] front True if the packet has to be served before the other packets.
+ */
+
+void Sunset_Queue::push(sunset_sub_queue* q, Packet* p, bool front)
+{
+	int size = HDR_CMN(p)->size();
+	list<sunset_sub_queue*>& l = active_[q->cls];
+	
+	if (front) {
 		
-		stat->logStatInfo(SUNSET_STAT_ENQUE, getModuleAddress(), p, HDR_CMN(p)->timestamp(), "");	
+		q->pq->enqueHead(p);
+	}
+	else {
 		
+		q->pq->enque(p);
 	}
 	
-	if ( ((pq_->length() + 1) > qlim_) ||
-	    (qib_ && (pq_->byteLength() + hdr_cmn::access(p)->size()) > qlimBytes) ){
+	len_++;
+	bytes_ += size;
+	classLen_[q->cls]++;
+	classBytes_[q->cls] += size;
+	
+	if (!q->active) {
 		
-		if (Sunset_Statistics::use_stat() && stat != NULL) {
+		q->active = true;
+		q->deficit = 0;
+		
+		if (front) {
+			
+			l.push_front(q);
+			q->pos = l.begin();
+		}
+		else {
 			
-			stat->logStatInfo(SUNSET_STAT_QUEUE_DISCARD, getModuleAddress(), p, HDR_CMN(p)->timestamp(), "");	
+			l.push_back(q);
+			q->pos = --(l.end());
 		}
+	}
+	else if (front) {
 		
-		if ( drop_front_ ) { /* remove from head of queue */
+		l.splice(l.begin(), l, q->pos);
+	}
+	
+	return;
+}
+
+/*! @brief This function updates the queue counters after a packet has been removed from a sub-queue. An empty sub-queue leaves the round robin list.
+ *  @param[in] q The sub-queue.
+ *  @param[in] p The packet removed.
+ */
+
+void Sunset_Queue::pop(sunset_sub_queue* q, Packet* p)
+{
+	int size = HDR_CMN(p)->size();
+	
+	len_--;
+	bytes_ -= size;
+	classLen_[q->cls]--;
+	classBytes_[q->cls] -= size;
+	
+	if (q->pq->length() == 0 && q->active) {
+		
+		active_[q->cls].erase(q->pos);
+		q->active = false;
+		q->deficit = 0;
+	}
+	
+	return;
+}
+
+/*! @brief This function returns the sub-queue whose head is the next packet to be served. Control packets are served first. When quantum_ 
+ *  is set, a sub-queue is served only if its deficit covers the size of its head, otherwise the deficit is increased and the next sub-queue is considered.
+ *  Calling it again without changing the queue returns the same sub-queue.
+ */
+
+sunset_sub_queue* Sunset_Queue::select()
+{
+	sunset_sub_queue* q = 0;
+	
+	for (int c = 0; c < SUNSET_QUEUE_CLASSES; c++) {
+		
+		list<sunset_sub_queue*>& l = active_[c];
+		
+		if (l.empty()) {
+			
+			continue;
+		}
+		
+		if (quantum_ <= 0) {
+			
+			return l.front();
+		}
+		
+		while (true) {
 			
-			Packet *pp = pq_->deque();
-			pq_->enqueHead(p);
+			q = l.front();
 			
-			Sunset_Utilities::erasePkt(pp, getModuleAddress());
+			if (q->deficit >= HDR_CMN(q->pq->head())->size()) {
+				
+				return q;
+			}
 			
-		} else {
+			q->deficit += quantum_;
 			
-			Sunset_Utilities::erasePkt(p, getModuleAddress());
+			l.splice(l.end(), l, q->pos);
 		}
+	}
+	
+	return 0;
+}
+
+/*! @brief This function returns the packet to be discarded when packet p does not fit in the queue. If the limit of the control class is not exceeded, 
+ *  a control packet replaces a data packet. Otherwise, the head of the sub-queue of p is discarded if drop_front_ is set, p itself otherwise.
+ *  @param[in] p The packet to be enqueued.
+ *  @param[in] q The sub-queue of p.
+ *  @param[out] vq The sub-queue of the packet to be discarded.
+ */
+
+Packet* Sunset_Queue::getVictim(Packet* p, sunset_sub_queue* q, sunset_sub_queue*& vq)
+{
+	int c = q->cls;
+	int size = HDR_CMN(p)->size();
+	bool classFull = (classLimit_[c] > 0 && classLen_[c] + 1 > classLimit_[c]) || 
+			(classLimitBytes_[c] > 0 && classBytes_[c] + size > classLimitBytes_[c]);
+	
+	if (!classFull && c == SUNSET_QUEUE_CONTROL && !active_[SUNSET_QUEUE_DATA].empty()) {
 		
-		Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Queue::enqueFront DISCARDING PKT - queueLength %d size %d", length(), byteLength());
+		vq = active_[SUNSET_QUEUE_DATA].back();
 		
-	} else {
+		return vq->pq->head();
+	}
+	
+	vq = q;
+	
+	if (drop_front_ && q->pq->length() > 0) {
 		
-		Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Queue::enqueFront ENQUE - queueLength %d size %d", length(), byteLength());
+		return q->pq->head();
+	}
+	
+	return p;
+}
+
+/*! @brief This function logs a queue action on the statistics module, together with the number of packets and bytes of the packet class.
+ *  @param[in] sType The action.
+ *  @param[in] p The packet.
+ *  @param[in] c The class of the packet.
+ */
+
+void Sunset_Queue::logQueue(sunset_statisticType sType, Packet* p, int c)
+{
+	if (Sunset_Statistics::use_stat() && stat != NULL) {
 		
-		pq_->enqueHead(p);
+		stat->logStatInfo(sType, getModuleAddress(), p, HDR_CMN(p)->timestamp(), " %d %d %d", c, classLen_[c], classBytes_[c]);	
 	}
 	
 	return;
 }
 
-/*! @brief This function inserts a packet at the end of the queue.
+/*! @brief This function inserts a packet element at the beginning of its sub-queue, the sub-queue is the first one served in the packet class.
  *  @param[in] p The packet to be enqueued.
  */
 
-void Sunset_Queue::enque(Packet* p)
+void Sunset_Queue::enqueFront(Packet* p)
 {
+	sunset_sub_queue* q = getSubQueue(p);
+	sunset_sub_queue* vq = 0;
+	Packet* pp = 0;
+	int size = HDR_CMN(p)->size();
 	
-	if (Sunset_Statistics::use_stat() && stat != NULL) {
+	logQueue(SUNSET_STAT_ENQUE, p, q->cls);
+	
+	if ( ((len_ + 1) > qlim_) ||
+	    (qib_ && (bytes_ + size) > qlimBytes) ||
+	    (classLimit_[q->cls] > 0 && (classLen_[q->cls] + 1) > classLimit_[q->cls]) ||
+	    (classLimitBytes_[q->cls] > 0 && (classBytes_[q->cls] + size) > classLimitBytes_[q->cls]) ) {
 		
-		stat->logStatInfo(SUNSET_STAT_ENQUE, getModuleAddress(), p, HDR_CMN(p)->timestamp(), "");
+		pp = getVictim(p, q, vq);
 		
+		if ( pp != p ) { /* remove from head of queue */
+			
+			vq->pq->deque();
+			pop(vq, pp);
+			
+			logQueue(SUNSET_STAT_QUEUE_DISCARD, pp, vq->cls);
+			
+			push(q, p, true);
+			
+		} else {
+			
+			logQueue(SUNSET_STAT_QUEUE_DISCARD, p, q->cls);
+		}
+		
+		Sunset_Utilities::erasePkt(pp, getModuleAddress());
+		
+		SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Queue::enqueFront DISCARDING PKT - queueLength %d size %d", length(), byteLength());
+		
+	} else {
+		
+		SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Queue::enqueFront ENQUE - queueLength %d size %d", length(), byteLength());
+		
+		push(q, p, true);
 	}
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Queue::enque  queueLength %d", length());
+	return;
+}
+
+/*! @brief This function inserts a packet at the end of its sub-queue.
+ *  @param[in] p The packet to be enqueued.
+ */
+
+void Sunset_Queue::enque(Packet* p)
+{
+	sunset_sub_queue* q = getSubQueue(p);
+	sunset_sub_queue* vq = 0;
+	Packet* pp = 0;
+	int size = HDR_CMN(p)->size();
 	
-	if ( ((pq_->length() + 1) > qlim_) ||
-	    (qib_ && (pq_->byteLength() + hdr_cmn::access(p)->size()) > qlimBytes) ) {
+	logQueue(SUNSET_STAT_ENQUE, p, q->cls);
+	
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Queue::enque  queueLength %d class %d nextHop %d", length(), q->cls, q->nextHop);
+	
+	if ( ((len_ + 1) > qlim_) ||
+	    (qib_ && (bytes_ + size) > qlimBytes) ||
+	    (classLimit_[q->cls] > 0 && (classLen_[q->cls] + 1) > classLimit_[q->cls]) ||
+	    (classLimitBytes_[q->cls] > 0 && (classBytes_[q->cls] + size) > classLimitBytes_[q->cls]) ) {
 		
 		/* the queue would overflow if we added this packet... */
 		
-		if (Sunset_Statistics::use_stat() && stat != NULL) {
-			
-			stat->logStatInfo(SUNSET_STAT_QUEUE_DISCARD, getModuleAddress(), p, HDR_CMN(p)->timestamp(), "");	
-		}
+		pp = getVictim(p, q, vq);
 		
-		if (drop_front_) { /* remove from head of queue */
+		if (pp != p) { /* remove from head of queue */
+			
+			vq->pq->deque();
+			pop(vq, pp);
 			
-			pq_->enque(p);
-			Packet *pp = pq_->deque();
+			logQueue(SUNSET_STAT_QUEUE_DISCARD, pp, vq->cls);
 			
-			Sunset_Utilities::erasePkt(pp, getModuleAddress());
+			push(q, p, false);
 			
 		} else {
 			
-			Sunset_Utilities::erasePkt(p, getModuleAddress());
+			logQueue(SUNSET_STAT_QUEUE_DISCARD, p, q->cls);
 		}
 		
-		Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Queue::enque DISCARDING PKT - queueLength %d size %d", length(), byteLength());
+		Sunset_Utilities::erasePkt(pp, getModuleAddress());
+		
+		SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Queue::enque DISCARDING PKT - queueLength %d size %d", length(), byteLength());
 		
 	} else {
 		
-		Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Queue::enque ENQUE PKT - queueLength %d size %d", length(), byteLength());
+		SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Queue::enque ENQUE PKT - queueLength %d size %d", length(), byteLength());
 		
-		pq_->enque(p);
+		push(q, p, false);
 	}
 	
 	return;
 }
 
-/*! @brief This function returns the first packet in the queue: the packet will be removed from the queue.
+/*! @brief This function returns the head of the queue, i.e. the packet which will be returned by the next deque. The packet is not removed from the queue.
+ *  @retval p The head of the queue, 0 if the queue is empty.
+ */
+
+Packet* Sunset_Queue::getHead()
+{
+	sunset_sub_queue* q = select();
+	
+	if (q == 0) {
+		
+		return 0;
+	}
+	
+	return q->pq->head();
+}
+
+/*! @brief This function returns the first packet in the queue: the packet will be removed from the queue. The next packet of the same class 
+ *  is taken from the following next hop sub-queue (if quantum_ is set, when the deficit of the current sub-queue is over).
  *  @retval p The packet to be dequeued.
  */
 
 Packet* Sunset_Queue::deque()
 {
-	Packet* p = pq_->deque();
+	sunset_sub_queue* q = select();
+	Packet* p = 0;
 	
-	if (Sunset_Statistics::use_stat() && stat != NULL) {
+	if (q == 0) {
 		
-		stat->logStatInfo(SUNSET_STAT_DEQUE, getModuleAddress(), p, HDR_CMN(p)->timestamp(), "");	
+		return 0;
 	}
 	
+	p = q->pq->deque();
+	
+	if (quantum_ > 0) {
+		
+		q->deficit -= HDR_CMN(p)->size();
+	}
+	
+	pop(q, p);
+	
+	if (quantum_ <= 0 && q->active) {
+		
+		active_[q->cls].splice(active_[q->cls].end(), active_[q->cls], q->pos);
+	}
+	
+	logQueue(SUNSET_STAT_DEQUE, p, q->cls);
+	
 	return p;
 }
 
@@ -254,28 +625,71 @@ Packet* Sunset_Queue::deque()
 
 void Sunset_Queue::remove(Packet* p) 
 {
-	if (Sunset_Statistics::use_stat() && stat != NULL) {
+	sunset_sub_queue* q = findSubQueue(p);
+	map<int, sunset_sub_queue*>::iterator it;
+	Packet* pp = 0;
+	
+	if (q != 0) {
+		
+		for (pp = q->pq->head(); pp != 0 && pp != p; pp = pp->next_);
+	}
+	
+	// the packet header could have been modified after enqueuing it, look for it in all the sub-queues
+	
+	for (int c = 0; c < SUNSET_QUEUE_CLASSES && pp == 0; c++) {
+		
+		for (it = subQueues_[c].begin(); it != subQueues_[c].end() && pp == 0; it++) {
+			
+			q = it->second;
+			
+			for (pp = q->pq->head(); pp != 0 && pp != p; pp = pp->next_);
+		}
+	}
+	
+	if (pp == 0) {
 		
-		stat->logStatInfo(SUNSET_STAT_DEQUE, getModuleAddress(), p, HDR_CMN(p)->timestamp(), "");	
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Queue::remove packet %p not in the queue ERROR", p);
+		
+		return;
 	}
 	
-	pq_->remove(p);
+	q->pq->remove(p);
+	pop(q, p);
+	
+	logQueue(SUNSET_STAT_DEQUE, p, q->cls);
 	
 	return;
 }
 
-/*! @brief This function removes a specific packet which must be in the queue.
- *  @param[in] p The packet to be removed.
+/*! @brief This function removes and erases all the packets in the queue.
  */
 
 void Sunset_Queue::reset() 
 {
-	if (pq_->length() > 1) {
+	map<int, sunset_sub_queue*>::iterator it;
+	Packet* pp = 0;
+	
+	for (int c = 0; c < SUNSET_QUEUE_CLASSES; c++) {
 		
-		Packet *pp = pq_->deque();
-		Sunset_Utilities::erasePkt(pp, getModuleAddress());
-		reset();
+		for (it = subQueues_[c].begin(); it != subQueues_[c].end(); it++) {
+			
+			while ((it->second)->pq->length() > 0) {
+				
+				pp = (it->second)->pq->deque();
+				Sunset_Utilities::erasePkt(pp, getModuleAddress());
+			}
+			
+			(it->second)->active = false;
+			(it->second)->deficit = 0;
+		}
+		
+		active_[c].clear();
+		classLen_[c] = 0;
+		classBytes_[c] = 0;
 	}
 	
+	len_ = 0;
+	bytes_ = 0;
+	
 	return;
 }
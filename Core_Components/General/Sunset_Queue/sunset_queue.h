@@ -23,18 +23,44 @@
 #define __Sunset_Queue_h__
 
 #include <queue.h>
+#include <map>
+#include <set>
+#include <list>
+#include <string>
 #include <sunset_utilities.h>
 #include <sunset_module.h>
 #include <sunset_statistics.h>
 
+#define SUNSET_QUEUE_CONTROL	0	/*!< \brief Class of the control packets, served before the data packets */
+#define SUNSET_QUEUE_DATA	1	/*!< \brief Class of the data packets */
+#define SUNSET_QUEUE_CLASSES	2
+
+using namespace std;
+
 class Sunset_Queue;
 
-/*! \brief This class implements a packet queue. */
+/*! \brief A sub-queue of the packets of a given class addressed to the same next hop. */
+
+typedef struct sunset_sub_queue {
+	
+	PacketQueue* pq;	/*!< \brief The packets of the sub-queue */
+	int nextHop;		/*!< \brief The next hop of the packets */
+	int cls;		/*!< \brief The class of the packets */
+	int deficit;		/*!< \brief The bytes the sub-queue can still send in the current round (deficit round robin) */
+	bool active;		/*!< \brief True if the sub-queue is in the round robin list of its class */
+	list<sunset_sub_queue*>::iterator pos;	/*!< \brief The position in the round robin list */
+	
+} sunset_sub_queue;
+
+/*! \brief This class implements a packet queue. The packets are stored in a sub-queue for each class (control and data) and next hop.
+ *  Control packets are served first, the next hops of a class are served in round robin (deficit round robin if quantum_ is set), 
+ *  so that packets to an unreachable or slow neighbor do not block the traffic to the other neighbors. */
 
 class Sunset_Queue : public TclObject, public Sunset_Module {
 	
 public:
 	Sunset_Queue();
+	~Sunset_Queue();
 	
 	int command(int argc, const char*const* argv);
 	
@@ -44,29 +70,66 @@ public:
 	virtual void reset();
 	
 	int limit() { return qlim_; }   		/*!< \brief It returns the maximum allowed number of packets in the queue */
-	int length() { return pq_->length(); } 		/*!< \brief The number of packets currently in underlying packet queue */
-	int byteLength() { return pq_->byteLength(); }	/*!< \brief The number of bytes currently in packet queue */	
+	int length() { return len_; } 			/*!< \brief The number of packets currently in the queue */
+	int byteLength() { return bytes_; }		/*!< \brief The number of bytes currently in the queue */	
 	
-	Packet* getHead() { return pq_->head(); } /*!< \brief Return the head of the queue */	
+	int classLength(int c) { return classLen_[c]; }		/*!< \brief The number of packets of class c currently in the queue */
+	int classByteLength(int c) { return classBytes_[c]; }	/*!< \brief The number of bytes of class c currently in the queue */
+	
+	Packet* getHead();	/*!< \brief Return the head of the queue, i.e. the packet returned by the next deque */	
 	
 	virtual void remove(Packet*);   /*!< \brief Remove packet p from  the queue */	
 	
 	virtual void start();	
 	virtual void stop();	
 	
+protected:
+	
+	virtual int getClass(Packet* p);	/*!< \brief Return the class of packet p */
+	
+	virtual int getNextHop(Packet* p);	/*!< \brief Return the key of the sub-queue of packet p in its class */
+	
 private:
+	
+	sunset_sub_queue* findSubQueue(Packet* p);
+	
+	sunset_sub_queue* getSubQueue(Packet* p);
+	
+	sunset_sub_queue* select();
+	
+	Packet* getVictim(Packet* p, sunset_sub_queue* q, sunset_sub_queue*& vq);
+	
+	void push(sunset_sub_queue* q, Packet* p, bool front);
+	
+	void pop(sunset_sub_queue* q, Packet* p);
+	
+	void logQueue(sunset_statisticType sType, Packet* p, int c);
+	
 	int drop_front_;	/*!< \brief  Drop-from-front (rather than from tail) */
 	int qib_;       	/*!< \brief  Bool: if 1 qlimBytes constraint have to be respected */
 	int qlimBytes;		/*!< \brief  The maximum allowed size of the queue in bytes (the sum of packet sizes inside the queue does not have to exceed qlimBytes value) */
 	int qlim_;		/*!< \brief  The maximum allowed number of packets in the queue */
 	int blocked_;		/*!< \brief  Is it blocked now? */
 	
-	PacketQueue *pq_;	/*!< \brief  A pointer to actual packet queue (maintained by the individual disciplines like DropTail and RED). */
+	int perNextHop_;	/*!< \brief  If 1 a sub-queue is used for each next hop, otherwise each class is a single FIFO queue */
+	int usePriority_;	/*!< \brief  If 1 the control packets are served before the data packets, otherwise all the packets are data packets */
+	int quantum_;		/*!< \brief  Bytes added to the deficit of a sub-queue at each round, 0 to serve one packet per next hop at each round */
+	int classLimit_[SUNSET_QUEUE_CLASSES];		/*!< \brief  The maximum number of packets of each class, 0 if not limited */
+	int classLimitBytes_[SUNSET_QUEUE_CLASSES];	/*!< \brief  The maximum number of bytes of each class, 0 if not limited */
+	
+	int len_;				/*!< \brief  The number of packets in the queue */
+	int bytes_;				/*!< \brief  The number of bytes in the queue */
+	int classLen_[SUNSET_QUEUE_CLASSES];	/*!< \brief  The number of packets of each class */
+	int classBytes_[SUNSET_QUEUE_CLASSES];	/*!< \brief  The number of bytes of each class */
+	
+	map<int, sunset_sub_queue*> subQueues_[SUNSET_QUEUE_CLASSES];	/*!< \brief  The sub-queues of each class, by next hop */
+	list<sunset_sub_queue*> active_[SUNSET_QUEUE_CLASSES];		/*!< \brief  The round robin list of the non empty sub-queues of each class */
+	
+	set<string> priorityTypes_;	/*!< \brief  The names of the packet types belonging to the control class */
+	map<int, int> typeClass_;	/*!< \brief  The class of each packet type, filled the first time the type is seen */
 	
 	Sunset_Statistics* stat; /*!< \brief  A pointer to the statistics module. */
         
 };
 
 #endif 
-
-
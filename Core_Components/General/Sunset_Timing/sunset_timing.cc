@@ -133,7 +133,7 @@ Sunset_Timing::Sunset_Timing() : TclObject()
 	bind("sifs_", &SIFS);
 	baudRate = baudR;
 	
-	Sunset_Debug::debugInfo(4, -1, "Sunset_Timing::Sunset_Timing()");
+	SUNSET_DEBUG_LOG(4, -1, "Sunset_Timing::Sunset_Timing()");
 }
 
 /*!
@@ -158,7 +158,7 @@ double Sunset_Timing::txtime(int size, double rate)
 
 double Sunset_Timing::overheadTime(int size)
 {
-	Sunset_Debug::debugInfo(4, -1, "Sunset_Timing::overheadTime size %d devDelay %f modemDelay %f transferTime %f", 
+	SUNSET_DEBUG_LOG(4, -1, "Sunset_Timing::overheadTime size %d devDelay %f modemDelay %f transferTime %f", 
 				size, getDeviceDelay(), getModemDelay(), transfertTime(size) );
 	return getDeviceDelay() + getModemDelay() + transfertTime(size);
 }
@@ -197,7 +197,7 @@ double Sunset_Timing::txtime(int size, sunset_rateType rate)
 {	
 	double auxRate;
 	
-	Sunset_Debug::debugInfo(4, -1, "Sunset_Timing::txtime size %d", size);
+	SUNSET_DEBUG_LOG(4, -1, "Sunset_Timing::txtime size %d", size);
 	
 	switch (rate) {
 			
@@ -213,7 +213,7 @@ double Sunset_Timing::txtime(int size, sunset_rateType rate)
 			break;
 	}
 	
-	Sunset_Debug::debugInfo(4, -1, "Sunset_Timing::txtime size %d auxRate %f", size, auxRate);
+	SUNSET_DEBUG_LOG(4, -1, "Sunset_Timing::txtime size %d auxRate %f", size, auxRate);
 	
 	return ((double)size * 8.0)/(auxRate);
 }
@@ -225,7 +225,7 @@ double Sunset_Timing::txtime(int size, sunset_rateType rate)
  */
 double Sunset_Timing::transfertTime(int size)
 {
-	Sunset_Debug::debugInfo(4, -1, "Sunset_Timing::transfertTime size %d", size);
+	SUNSET_DEBUG_LOG(4, -1, "Sunset_Timing::transfertTime size %d", size);
 	
 	return (size * BAUD_CONV) / (double)baudRate;
 }
@@ -237,7 +237,7 @@ double Sunset_Timing::transfertTime(int size)
  */
 int Sunset_Timing::getPktSize(int dataSize)
 {
-	Sunset_Debug::debugInfo(4, -1, "Sunset_Timing::getPktSize size %d", dataSize);
+	SUNSET_DEBUG_LOG(4, -1, "Sunset_Timing::getPktSize size %d", dataSize);
 	
 	return Sunset_Utilities::get_pkt_size(dataSize);
 }
@@ -251,7 +251,7 @@ int Sunset_Timing::getPktSize(int dataSize)
  */
 int Sunset_Timing::getPktSize(Packet* p)
 {
-	Sunset_Debug::debugInfo(4, -1, "Sunset_Timing::getPktSize size_pkt %d", HDR_CMN(p)->size());
+	SUNSET_DEBUG_LOG(4, -1, "Sunset_Timing::getPktSize size_pkt %d", HDR_CMN(p)->size());
 	
 	return Sunset_Utilities::get_pkt_size(p);
 }
@@ -63,7 +63,7 @@ public:
 	}
 	
 	/*! @brief The getName prints the packet header converter name. */	
-	virtual void getName() { Sunset_Debug::debugInfo(5, -1, "Sunset_Common_PktConverter"); }
+	virtual void getName() { SUNSET_DEBUG_LOG(5, -1, "Sunset_Common_PktConverter"); }
 	
 protected:
 	
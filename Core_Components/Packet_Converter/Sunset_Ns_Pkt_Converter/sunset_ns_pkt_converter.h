@@ -69,7 +69,7 @@ public:
 	int getTxTimeBits() { return TXTIME_BITS; } /*!< \brief It returns the maximum number of bits that have to be used when converting packet transmission time information inside the packet headers. */
 	
 	/*! @brief The getName prints the packet header converter name. */	
-	virtual void getName() { Sunset_Debug::debugInfo(5, -1, "Sunset_NsPktConverter"); }
+	virtual void getName() { SUNSET_DEBUG_LOG(5, -1, "Sunset_NsPktConverter"); }
 	
 protected:
 	
@@ -167,7 +167,7 @@ protected:
 	virtual int useMiniPkt(int level, Packet* p, sunset_header_type m, int& result)  { return 1; } /*!< \brief Method to check if the packet can be converted as a mini pkt for a specific packet header, extended by each packet header converter module. */
 	
 	/*! @brief The getName prints the packet converter module name. */
-	virtual void getName() { Sunset_Debug::debugInfo(5, -1, "Sunset_PktConverter"); }
+	virtual void getName() { SUNSET_DEBUG_LOG(5, -1, "Sunset_PktConverter"); }
 	
 	void setBits (char *val, char* buffer, int sizevalue, int offset); // write sizevalue bits of information from buffer+offset to val
 	
@@ -0,0 +1,265 @@
+/* SUNSET - Sapienza University Networking framework for underwater Simulation, Emulation and real-life Testing
+ *
+ * Copyright (C) 2012 Regents of UWSN Group of SENSES Lab <http://reti.dsi.uniroma1.it/SENSES_lab/>
+ *
+ * Author: Roberto Petroccia - petroccia@di.uniroma1.it
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License as published
+ * at http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANATBILITY or FITNESS FOR A PARTICULAR PURPOSE. See the Creative Commons
+ * Attribution-NonCommercial-ShareAlike 3.0 Unported License for more details.
+ *
+ * You should have received a copy of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License
+ * along with this program. If not, see <http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode>.
+ */
+
+#ifndef __Sunset_Pkt_Schema_h__
+#define __Sunset_Pkt_Schema_h__
+
+#include <string.h>
+#include <stdint.h>
+
+#include <sunset_pkt_converter.h>
+#include <sunset_bit_stream.h>
+
+/*! @brief The width classes of a converted header field. The width of a field is fixed when the field is declared or it is 
+ *  the one configured, from TCL, for the corresponding class in the packet converter. */
+
+typedef enum sunset_schema_width {
+	
+	SUNSET_SCHEMA_FIXED = -1,	// width given by the field declaration
+	SUNSET_SCHEMA_ADDR = 0,		// getAddrBits()
+	SUNSET_SCHEMA_PKT_ID = 1,	// getPktIdBits()
+	SUNSET_SCHEMA_TIME = 2,		// getTimeBits()
+	SUNSET_SCHEMA_DATA = 3,		// getDataBits()
+	SUNSET_SCHEMA_PORT = 4,		// converter specific port width
+	SUNSET_SCHEMA_NUM_WIDTHS = 5
+	
+} sunset_schema_width;
+
+#define SUNSET_SCHEMA_ALWAYS		-1	/*!< @brief Option index of the fields which are always converted. */
+#define SUNSET_SCHEMA_MAX_OPTIONS	6	/*!< @brief Maximum number of options of a schema (one specialization per option combination). */
+#define SUNSET_SCHEMA_MAX_RAW		16	/*!< @brief Maximum size (bytes) of a field copied as raw memory. */
+
+/*! @brief The widths (bits) currently configured for the different width classes. */
+
+typedef struct sunset_schema_widths {
+	
+	int bits[SUNSET_SCHEMA_NUM_WIDTHS];
+	
+	sunset_schema_widths(Sunset_PktConverter* c, int portBits = 0) 
+	{
+		bits[SUNSET_SCHEMA_ADDR] = c->getAddrBits();
+		bits[SUNSET_SCHEMA_PKT_ID] = c->getPktIdBits();
+		bits[SUNSET_SCHEMA_TIME] = c->getTimeBits();
+		bits[SUNSET_SCHEMA_DATA] = c->getDataBits();
+		bits[SUNSET_SCHEMA_PORT] = portBits;
+	}
+	
+} sunset_schema_widths;
+
+/*! @brief Base of the field descriptors. A field extends this class defining the static get/set functions used to access 
+ *  the packet header (or getRaw/setRaw when RAW is 1 and the field memory is copied as it is) and, if needed, the absent 
+ *  function called on reception when the field option is not enabled.
+ *  @param WIDTH The width class of the field.
+ *  @param BITS The field width when WIDTH is SUNSET_SCHEMA_FIXED.
+ *  @param OPTION The bit of the option mask enabling the field, SUNSET_SCHEMA_ALWAYS if the field is always converted.
+ *  @param RAW 1 if the field memory has to be copied as it is, 0 if the field value is converted.
+ */
+
+template <int WIDTH, int BITS, int OPTION = SUNSET_SCHEMA_ALWAYS, int RAW = 0> 
+struct Sunset_Schema_Field {
+	
+	enum { width = WIDTH, bits = (WIDTH == SUNSET_SCHEMA_FIXED) ? BITS : 0, option = OPTION, raw = RAW };
+	
+	static uint64_t get(Packet* p) { return 0; }
+	static void set(Packet* p, uint64_t value) { }
+	static const char* getRaw(Packet* p) { return 0; }
+	static void setRaw(Packet* p, const char* value) { }
+	static void absent(Packet* p) { }
+};
+
+/*! @brief It moves the value of a field using the compile-time width when the width is fixed. */
+
+template <int BITS> struct Sunset_Schema_Io {
+	
+	static void put(Sunset_Bit_Writer& w, uint64_t value, int size) { w.put<BITS>(value); }
+	static uint64_t get(Sunset_Bit_Reader& r, int size) { return r.get<BITS>(); }
+};
+
+template <> struct Sunset_Schema_Io<0> {
+	
+	static void put(Sunset_Bit_Writer& w, uint64_t value, int size) { w.put(value, size); }
+	static uint64_t get(Sunset_Bit_Reader& r, int size) { return r.get(size); }
+};
+
+/*! @brief The operations on a single field "F" for the option mask "MASK". All the conditions are compile-time constants, 
+ *  the disabled branches are removed by the compiler. */
+
+template <class F, int MASK> struct Sunset_Schema_Op {
+	
+	enum { enabled = (F::option < 0) || ((MASK >> (F::option < 0 ? 0 : F::option)) & 1) };
+	enum { fixedIo = (F::bits > 0 && F::bits <= SUNSET_BIT_STREAM_CHUNK) ? F::bits : 0 };
+	
+	static int size(const sunset_schema_widths& widths) 
+	{
+		if ( !enabled ) {
+			
+			return 0;
+		}
+		
+		return ((int)F::width == (int)SUNSET_SCHEMA_FIXED) ? (int)F::bits : widths.bits[(int)F::width < 0 ? 0 : (int)F::width];
+	}
+	
+	static void encode(Packet* p, Sunset_Bit_Writer& w, const sunset_schema_widths& widths) 
+	{
+		if ( !enabled ) {
+			
+			return;
+		}
+		
+		if ( F::raw ) {
+			
+			w.putBits(F::getRaw(p), size(widths));
+		}
+		else {
+			
+			Sunset_Schema_Io<fixedIo>::put(w, F::get(p), size(widths));
+		}
+	}
+	
+	static void decode(Packet* p, Sunset_Bit_Reader& r, const sunset_schema_widths& widths) 
+	{
+		char value[SUNSET_SCHEMA_MAX_RAW];
+		
+		if ( !enabled ) {
+			
+			F::absent(p);
+			
+			return;
+		}
+		
+		if ( F::raw ) {
+			
+			memset(value, 0, SUNSET_SCHEMA_MAX_RAW);
+			r.getBits(value, size(widths));
+			F::setRaw(p, value);
+		}
+		else {
+			
+			F::set(p, Sunset_Schema_Io<fixedIo>::get(r, size(widths)));
+		}
+	}
+};
+
+/*! @brief The end marker of a schema. */
+
+struct Sunset_Schema_End { };
+
+/*! @brief A schema is the ordered list of the fields (up to 10) of a converted header. The fields are written in the given 
+ *  order, a specialization of encode, decode and length is instantiated for each option mask. */
+
+template <class F1, class F2 = Sunset_Schema_End, class F3 = Sunset_Schema_End, class F4 = Sunset_Schema_End, 
+	  class F5 = Sunset_Schema_End, class F6 = Sunset_Schema_End, class F7 = Sunset_Schema_End, 
+	  class F8 = Sunset_Schema_End, class F9 = Sunset_Schema_End, class F10 = Sunset_Schema_End> 
+struct Sunset_Schema {
+	
+	typedef Sunset_Schema<F2, F3, F4, F5, F6, F7, F8, F9, F10, Sunset_Schema_End> Next;
+	
+	template <int MASK> static int length(const sunset_schema_widths& widths) 
+	{
+		return Sunset_Schema_Op<F1, MASK>::size(widths) + Next::template length<MASK>(widths);
+	}
+	
+	template <int MASK> static void encode(Packet* p, Sunset_Bit_Writer& w, const sunset_schema_widths& widths) 
+	{
+		Sunset_Schema_Op<F1, MASK>::encode(p, w, widths);
+		Next::template encode<MASK>(p, w, widths);
+	}
+	
+	template <int MASK> static void decode(Packet* p, Sunset_Bit_Reader& r, const sunset_schema_widths& widths) 
+	{
+		Sunset_Schema_Op<F1, MASK>::decode(p, r, widths);
+		Next::template decode<MASK>(p, r, widths);
+	}
+};
+
+template <> struct Sunset_Schema<Sunset_Schema_End> {
+	
+	template <int MASK> static int length(const sunset_schema_widths& widths) { return 0; }
+	template <int MASK> static void encode(Packet* p, Sunset_Bit_Writer& w, const sunset_schema_widths& widths) { }
+	template <int MASK> static void decode(Packet* p, Sunset_Bit_Reader& r, const sunset_schema_widths& widths) { }
+};
+
+/*! @brief It fills the specialization tables of a schema for all the masks from MASK down to 0. */
+
+template <class S, int MASK> struct Sunset_Schema_Table {
+	
+	typedef int (*length_fn)(const sunset_schema_widths&);
+	typedef void (*encode_fn)(Packet*, Sunset_Bit_Writer&, const sunset_schema_widths&);
+	typedef void (*decode_fn)(Packet*, Sunset_Bit_Reader&, const sunset_schema_widths&);
+	
+	static void fill(length_fn* len, encode_fn* enc, decode_fn* dec) 
+	{
+		len[MASK] = &S::template length<MASK>;
+		enc[MASK] = &S::template encode<MASK>;
+		dec[MASK] = &S::template decode<MASK>;
+		
+		Sunset_Schema_Table<S, MASK - 1>::fill(len, enc, dec);
+	}
+};
+
+template <class S> struct Sunset_Schema_Table<S, -1> {
+	
+	typedef int (*length_fn)(const sunset_schema_widths&);
+	typedef void (*encode_fn)(Packet*, Sunset_Bit_Writer&, const sunset_schema_widths&);
+	typedef void (*decode_fn)(Packet*, Sunset_Bit_Reader&, const sunset_schema_widths&);
+	
+	static void fill(length_fn* len, encode_fn* enc, decode_fn* dec) { }
+};
+
+/*! @brief This class is used by the packet header converters to convert their header information according to a schema. 
+ *  The options of a converter (e.g. use_source, use_dest) can be changed from TCL at any time, the current option mask 
+ *  selects the specialization to use, no check on the single fields is done when converting a packet.
+ *  @param S The schema.
+ *  @param NUM_OPTIONS The number of options used by the schema fields.
+ */
+
+template <class S, int NUM_OPTIONS> class Sunset_Schema_Codec {
+	
+public:
+	
+	typedef int (*length_fn)(const sunset_schema_widths&);
+	typedef void (*encode_fn)(Packet*, Sunset_Bit_Writer&, const sunset_schema_widths&);
+	typedef void (*decode_fn)(Packet*, Sunset_Bit_Reader&, const sunset_schema_widths&);
+	
+	Sunset_Schema_Codec() 
+	{
+		enum { options_check = sizeof(char[(NUM_OPTIONS >= 0 && NUM_OPTIONS <= SUNSET_SCHEMA_MAX_OPTIONS) ? 1 : -1]) };
+		
+		Sunset_Schema_Table<S, (1 << NUM_OPTIONS) - 1>::fill(len_, enc_, dec_);
+	}
+	
+	/*! @brief The length function returns the number of bits of the fields enabled in "mask". */
+	int length(int mask, const sunset_schema_widths& widths) { return len_[mask & MASK](widths); }
+	
+	/*! @brief The encode function writes the fields enabled in "mask" of packet p. */
+	void encode(int mask, Packet* p, Sunset_Bit_Writer& w, const sunset_schema_widths& widths) { enc_[mask & MASK](p, w, widths); }
+	
+	/*! @brief The decode function reads the fields enabled in "mask" into packet p, the absent function is called for the other fields. */
+	void decode(int mask, Packet* p, Sunset_Bit_Reader& r, const sunset_schema_widths& widths) { dec_[mask & MASK](p, r, widths); }
+	
+private:
+	
+	enum { MASK = (1 << NUM_OPTIONS) - 1 };
+	
+	length_fn len_[1 << NUM_OPTIONS];
+	encode_fn enc_[1 << NUM_OPTIONS];
+	decode_fn dec_[1 << NUM_OPTIONS];
+};
+
+#endif
@@ -90,7 +90,7 @@ int Sunset_Statistics::command( int argc, const char*const* argv )
 
 void Sunset_Statistics::start() 
 {	
-	Sunset_Debug::debugInfo(5, -1, "Statistics::start useStat %d", useStat);
+	SUNSET_DEBUG_LOG(5, -1, "Statistics::start useStat %d", useStat);
 }
 
 /*!
@@ -99,7 +99,7 @@ void Sunset_Statistics::start()
 
 void Sunset_Statistics::stop() 
 {	
-	Sunset_Debug::debugInfo(5, -1, "Statistics::stop useStat %d", useStat);
+	SUNSET_DEBUG_LOG(5, -1, "Statistics::stop useStat %d", useStat);
 }
 
 /*!
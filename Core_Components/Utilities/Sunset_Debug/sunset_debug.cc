@@ -21,11 +21,116 @@
 #include <sunset_debug.h>
 #include <scheduler.h>
 #include <iostream>
+#include <errno.h>
 
 using namespace std;
 
 Sunset_Debug *Sunset_Debug::instance_ = NULL;
 int Sunset_Debug::level = 0;
+int Sunset_Debug::maxLevel = 0;
+int Sunset_Debug::allNodesLevel = 0;
+int Sunset_Debug::nodeLevel[SUNSET_DEBUG_MAX_NODES];
+map<int, int> Sunset_Debug::nodeDebug;
+map<string, map<int, int> > Sunset_Debug::moduleDebug;
+
+/* Buffered output: the messages are appended to sink_buffer and written by the sink thread. 
+ * The write mutex is always taken before releasing the sink mutex to keep the order of the messages. */
+
+static pthread_mutex_t sink_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t sink_write_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t sink_cond = PTHREAD_COND_INITIALIZER;
+static string sink_buffer;
+static bool sink_async = false;
+static bool sink_stopping = false;	// set to terminate the sink thread
+static bool sink_exit_set = false;	// true once sink_exit has been registered with atexit
+static pthread_t sink_thread;
+
+static void* sink_run(void* arg)
+{
+	struct timeval now;
+	struct timespec deadline;
+	string pending;
+	bool stop = false;
+	
+	while ( true ) {
+		
+		gettimeofday(&now, NULL);
+		
+		deadline.tv_sec = now.tv_sec + (time_t)SUNSET_DEBUG_FLUSH_INTERVAL;
+		deadline.tv_nsec = now.tv_usec * 1000 + (long)((SUNSET_DEBUG_FLUSH_INTERVAL - (time_t)SUNSET_DEBUG_FLUSH_INTERVAL) * 1e9);
+		
+		if ( deadline.tv_nsec >= 1000000000L ) {
+			
+			deadline.tv_sec++;
+			deadline.tv_nsec -= 1000000000L;
+		}
+		
+		pthread_mutex_lock(&sink_mutex);
+		
+		while ( sink_buffer.size() < SUNSET_DEBUG_SINK_SIZE && !sink_stopping ) {
+			
+			if ( pthread_cond_timedwait(&sink_cond, &sink_mutex, &deadline) == ETIMEDOUT ) {
+				
+				break;
+			}
+		}
+		
+		pending.swap(sink_buffer);
+		
+		stop = sink_stopping;
+		
+		pthread_mutex_lock(&sink_write_mutex);
+		pthread_mutex_unlock(&sink_mutex);
+		
+		if ( pending.size() > 0 ) {
+			
+			fwrite(pending.data(), 1, pending.size(), stdout);
+			fflush(stdout);
+			pending.clear();
+		}
+		
+		pthread_mutex_unlock(&sink_write_mutex);
+		
+		if ( stop ) {
+			
+			break;
+		}
+	}
+	
+	return NULL;
+}
+
+/* Stop the sink thread, the messages it has not written yet are written before it terminates. 
+ * New messages are written immediately once sink_async is false. */
+
+static void sink_stop()
+{
+	pthread_mutex_lock(&sink_mutex);
+	
+	if ( !sink_async ) {
+		
+		pthread_mutex_unlock(&sink_mutex);
+		
+		return;
+	}
+	
+	sink_async = false;
+	sink_stopping = true;
+	
+	pthread_cond_signal(&sink_cond);
+	pthread_mutex_unlock(&sink_mutex);
+	
+	pthread_join(sink_thread, NULL);
+	
+	sink_stopping = false;
+}
+
+static void sink_exit()
+{
+	sink_stop();
+	
+	Sunset_Debug::flush();
+}
 
 /*!
  * 	@brief This static class is a hook class used to instantiate a C++ object from the TCL script. 
@@ -47,6 +152,8 @@ public:
 Sunset_Debug::Sunset_Debug() : TclObject()
 {
 	instance_ = this;
+	
+	updateLevels();
 }
 
 Sunset_Debug::~Sunset_Debug() 
@@ -73,8 +180,114 @@ int Sunset_Debug::command( int argc, const char*const* argv )
 		if (strcmp(argv[1], "setDebug") == 0) {
 			
 			level = atoi(argv[2]);
+			updateLevels();
+			
 			return TCL_OK;
 		}	
+		
+		/* The "setAsyncOutput" command enables (1) or disables (0) the buffered output, by default it is disabled. 
+		 * When enabled the messages are written by a background thread, error messages are written immediately. 
+		 * Disabling it, or exiting the process, writes the buffered messages and terminates the background thread. */
+		
+		if (strcmp(argv[1], "setAsyncOutput") == 0) {
+			
+			bool async = (atoi(argv[2]) != 0);
+			
+			if (async && !sink_async) {
+				
+				if (pthread_create(&sink_thread, NULL, sink_run, NULL) != 0) {
+					
+					debugInfo(-1, -1, "Sunset_Debug::command ERROR creating output thread");
+					
+					return TCL_ERROR;
+				}
+				
+				if (!sink_exit_set) {
+					
+					atexit(sink_exit);
+					sink_exit_set = true;
+				}
+				
+				pthread_mutex_lock(&sink_mutex);
+				sink_async = true;
+				pthread_mutex_unlock(&sink_mutex);
+			}
+			else if (!async && sink_async) {
+				
+				sink_stop();
+				
+				flush();
+			}
+			
+			return TCL_OK;
+		}
+	}
+	
+	if ( argc == 4 ) {
+		
+		/* The "setNodeDebug" command sets the debug level of a given node, it is used if higher than the global one. */
+		
+		if (strcmp(argv[1], "setNodeDebug") == 0) {
+			
+			int node = atoi(argv[2]);
+			
+			if (node < 0 || node >= SUNSET_DEBUG_MAX_NODES) {
+				
+				debugInfo(-1, -1, "Sunset_Debug::command setNodeDebug node %d not valid", node);
+				
+				return TCL_ERROR;
+			}
+			
+			nodeDebug[node] = atoi(argv[3]);
+			updateLevels();
+			
+			return TCL_OK;
+		}
+		
+		/* The "setModuleDebug" command sets the debug level of a given module (e.g. Sunset_Csma_Aloha) for all the nodes, 
+		 * it is used if higher than the global one. */
+		
+		if (strcmp(argv[1], "setModuleDebug") == 0) {
+			
+			(moduleDebug[string(argv[2])])[-1] = atoi(argv[3]);
+			updateLevels();
+			
+			return TCL_OK;
+		}
+	}
+	
+	if ( argc == 5 ) {
+		
+		/* The "setModuleDebug" command sets the debug level of a given module for a given node. */
+		
+		if (strcmp(argv[1], "setModuleDebug") == 0) {
+			
+			int node = atoi(argv[3]);
+			
+			if (node < 0 || node >= SUNSET_DEBUG_MAX_NODES) {
+				
+				debugInfo(-1, -1, "Sunset_Debug::command setModuleDebug node %d not valid", node);
+				
+				return TCL_ERROR;
+			}
+			
+			(moduleDebug[string(argv[2])])[node] = atoi(argv[4]);
+			updateLevels();
+			
+			return TCL_OK;
+		}
+	}
+	
+	if ( argc == 2 ) {
+		
+		/* The "flush" command writes all the buffered messages. */
+		
+		if (strcmp(argv[1], "flush") == 0) {
+			
+			flush();
+			
+			return TCL_OK;
+		}
 	}
 	
 	return TclObject::command(argc, argv);
@@ -93,22 +306,133 @@ void Sunset_Debug::debugInfo(int debugLevel, int addr, const char *fmt, ...)
 {
 	char command[SUNSET_DEBUG_MAX_SIZE];
 	
-	if (debugLevel > level) {
+	if (debugLevel > SUNSET_DEBUG_MAX_LEVEL || !isEnabled(debugLevel, addr)) {
 		
 		return;
 	}
 	
-	memset(command, '\0', SUNSET_DEBUG_MAX_SIZE);
+	if (debugLevel > level && !isModuleEnabled(debugLevel, addr, fmt)) {
+		
+		return;
+	}
 	
 	va_list ap;
 	va_start(ap, fmt);
 	vsnprintf(command, SUNSET_DEBUG_MAX_SIZE, fmt, ap);
+	va_end(ap);
 	
 	(instance())->debug_info(debugLevel, addr, command);
 	
 	return;
 }
 
+/*!
+ * 	@brief The isModuleEnabled function checks the levels defined for the node and for the module printing the message. 
+ *	The module is the class name at the beginning of the message (e.g. "Sunset_Csma_Aloha::recv ...").
+ * 	@param[in] debugLevel The debug level of the message.
+ * 	@param[in] addr The node address.
+ * 	@param[in] fmt The debug string to print.
+ *	@retval true if the message has to be printed, false otherwise.
+ */
+
+bool Sunset_Debug::isModuleEnabled(int debugLevel, int addr, const char* fmt)
+{
+	map<int, int>::iterator it;
+	map<string, map<int, int> >::iterator itm;
+	char module[SUNSET_DEBUG_MAX_MODULE];
+	int len = 0;
+	
+	it = nodeDebug.find(addr);
+	
+	if (it != nodeDebug.end() && debugLevel <= it->second) {
+		
+		return true;
+	}
+	
+	if (moduleDebug.empty()) {
+		
+		return false;
+	}
+	
+	while (*fmt == ' ') {
+		
+		fmt++;
+	}
+	
+	while (fmt[len] != '\0' && fmt[len] != ':' && fmt[len] != ' ' && len < SUNSET_DEBUG_MAX_MODULE - 1) {
+		
+		module[len] = fmt[len];
+		len++;
+	}
+	
+	module[len] = '\0';
+	
+	itm = moduleDebug.find(string(module));
+	
+	if (itm == moduleDebug.end()) {
+		
+		return false;
+	}
+	
+	it = (itm->second).find(addr);
+	
+	if (it != (itm->second).end() && debugLevel <= it->second) {
+		
+		return true;
+	}
+	
+	it = (itm->second).find(-1);
+	
+	return (it != (itm->second).end() && debugLevel <= it->second);
+}
+
+/*!
+ * 	@brief The updateLevels function computes the highest level enabled for each node, used to discard the messages before formatting them.
+ */
+
+void Sunset_Debug::updateLevels()
+{
+	map<int, int>::iterator it;
+	map<string, map<int, int> >::iterator itm;
+	
+	allNodesLevel = level;
+	
+	for (itm = moduleDebug.begin(); itm != moduleDebug.end(); itm++) {
+		
+		it = (itm->second).find(-1);
+		
+		if (it != (itm->second).end()) {
+			
+			allNodesLevel = max(allNodesLevel, it->second);
+		}
+	}
+	
+	maxLevel = allNodesLevel;
+	
+	for (int i = 0; i < SUNSET_DEBUG_MAX_NODES; i++) {
+		
+		nodeLevel[i] = allNodesLevel;
+	}
+	
+	for (it = nodeDebug.begin(); it != nodeDebug.end(); it++) {
+		
+		nodeLevel[it->first] = max(nodeLevel[it->first], it->second);
+		maxLevel = max(maxLevel, it->second);
+	}
+	
+	for (itm = moduleDebug.begin(); itm != moduleDebug.end(); itm++) {
+		
+		for (it = (itm->second).begin(); it != (itm->second).end(); it++) {
+			
+			if (it->first >= 0) {
+				
+				nodeLevel[it->first] = max(nodeLevel[it->first], it->second);
+				maxLevel = max(maxLevel, it->second);
+			}
+		}
+	}
+}
+
 /*!
  * 	@brief This is the main function of the Debug class.
  * 	@param[in] debugLevel The debug level associated to these information, if debugLevel is higher than class debug level set by the user no information are printed.
@@ -120,27 +444,19 @@ void Sunset_Debug::debug_info(int debugLevel, int addr, char * str)
 {
 	char command[SUNSET_DEBUG_MAX_SIZE];
 	
-	/* When printing the requested information we also update the scheduler clock thus printing correct timing information when running in emulation mode. */
+	/* When printing the requested information we also update the scheduler clock thus printing correct timing information when running in emulation mode. 
+	 * The level has already been checked by debugInfo. */
 	
 	Scheduler& s = Scheduler::instance();
 	
-	memset(command, '\0', SUNSET_DEBUG_MAX_SIZE);
-
 	if (&s != 0) {
 		
 		s.sync(); 
 	}
 	
-	if (debugLevel > level) {
-		
-		return;
-	}
-	
 	snprintf(command, SUNSET_DEBUG_MAX_SIZE, "%d _DEBUG_ (%6.6f) Node:%d - %s", debugLevel, NOW, addr, str);
 	
-	cout << command << endl;
-	
-	fflush(stdout);
+	output(command, debugLevel < 0);
 	
 	return;
 }
@@ -170,11 +486,79 @@ void Sunset_Debug::showInfo(char *str)
 void Sunset_Debug::show_info(char * str)
 {
 	
-	cout << str << endl;
+	output(str, false);
 	
+	return;
+}
+
+/*!
+ * 	@brief The output function writes a line on the standard output. When the buffered output is enabled the line is appended 
+ *	to the buffer written by the background thread, unless it is urgent.
+ * 	@param[in] str The string to print.
+ * 	@param[in] urgent If true the line and all the buffered messages are written immediately.
+ */
+
+void Sunset_Debug::output(const char* str, bool urgent)
+{
+	string pending;
+	
+	pthread_mutex_lock(&sink_mutex);
+	
+	if (sink_async && !urgent) {
+		
+		sink_buffer.append(str);
+		sink_buffer.append(1, '\n');
+		
+		if (sink_buffer.size() >= SUNSET_DEBUG_SINK_SIZE) {
+			
+			pthread_cond_signal(&sink_cond);
+		}
+		
+		pthread_mutex_unlock(&sink_mutex);
+		
+		return;
+	}
+	
+	pending.swap(sink_buffer);
+	
+	pthread_mutex_lock(&sink_write_mutex);
+	pthread_mutex_unlock(&sink_mutex);
+	
+	if (pending.size() > 0) {
+		
+		fwrite(pending.data(), 1, pending.size(), stdout);
+	}
+	
+	fputs(str, stdout);
+	fputc('\n', stdout);
 	fflush(stdout);
 	
-	return;
+	pthread_mutex_unlock(&sink_write_mutex);
+}
+
+/*!
+ * 	@brief The flush function writes all the buffered messages.
+ */
+
+void Sunset_Debug::flush()
+{
+	string pending;
+	
+	pthread_mutex_lock(&sink_mutex);
+	
+	pending.swap(sink_buffer);
+	
+	pthread_mutex_lock(&sink_write_mutex);
+	pthread_mutex_unlock(&sink_mutex);
+	
+	if (pending.size() > 0) {
+		
+		fwrite(pending.data(), 1, pending.size(), stdout);
+	}
+	
+	fflush(stdout);
+	
+	pthread_mutex_unlock(&sink_write_mutex);
 }
 
 
@@ -27,13 +27,37 @@
 #include <set>
 #include <stdlib.h>
 #include <sys/time.h>
+#include <pthread.h>
 #include "config.h"
 #include "packet.h"
 
 #define SUNSET_DEBUG_MAX_SIZE		2048
 
+/*! @brief Highest debug level compiled in, messages with a higher level are removed at compile time 
+ *  (e.g. CPPFLAGS=-DSUNSET_DEBUG_MAX_LEVEL=2). Error messages (level -1) are always kept. */
+#ifndef SUNSET_DEBUG_MAX_LEVEL
+#define SUNSET_DEBUG_MAX_LEVEL		100
+#endif
+
+#define SUNSET_DEBUG_MAX_NODES		256	/*!< @brief Nodes (0 - SUNSET_DEBUG_MAX_NODES-1) which can have a dedicated debug level. */
+#define SUNSET_DEBUG_MAX_MODULE		64	/*!< @brief Maximum length of a module name. */
+#define SUNSET_DEBUG_SINK_SIZE		65536	/*!< @brief Size (bytes) of the buffered output triggering a write. */
+#define SUNSET_DEBUG_FLUSH_INTERVAL	0.5	/*!< @brief Maximum time (sec) a message is kept in the buffered output. */
+
+/*! @brief The SUNSET_DEBUG_LOG macro prints a debug message. The arguments are evaluated, and the message formatted, 
+ *  only if the level is enabled for the given node. Levels above SUNSET_DEBUG_MAX_LEVEL generate no code. */
+
+#define SUNSET_DEBUG_LOG(debugLevel, addr, ...) \
+	do { \
+		if ( (debugLevel) <= SUNSET_DEBUG_MAX_LEVEL && Sunset_Debug::isEnabled((debugLevel), (addr)) ) { \
+			Sunset_Debug::debugInfo((debugLevel), (addr), __VA_ARGS__); \
+		} \
+	} while (0)
+
 /*! 
- *\brief This class is used to print debug information. The user can define the requested debug level using the TCL script. Lower levels correspond to less printed information, higher levels to more information. */
+ *\brief This class is used to print debug information. The user can define the requested debug level using the TCL script. Lower levels correspond to less printed information, higher levels to more information. 
+ * A higher level can be defined for a given node, for a given module (the class name printed at the beginning of the message, e.g. Sunset_Csma_Aloha) or for a module of a given node.
+ * The messages can be buffered and written by a background thread, error messages (level -1) are always written immediately. */
 
 class Sunset_Debug : public TclObject {
 	
@@ -59,6 +83,34 @@ public:
 	 */
 	static void debugInfo(int debugLevel, int addr, const char *fmt, ...);
 	
+	/*!
+	 * 	@brief The isEnabled function returns false if no message of the given level can be printed for the given node. It does not check the module levels.
+	 */
+	static bool isEnabled(int debugLevel, int addr) 
+	{
+		if ( debugLevel <= level ) {
+			
+			return true;
+		}
+		
+		if ( debugLevel > maxLevel ) {
+			
+			return false;
+		}
+		
+		if ( addr >= 0 && addr < SUNSET_DEBUG_MAX_NODES ) {
+			
+			return debugLevel <= nodeLevel[addr];
+		}
+		
+		return debugLevel <= allNodesLevel;
+	}
+	
+	/*!
+	 * 	@brief The flush function writes all the buffered messages.
+	 */
+	static void flush();
+	
 	/*!
 	 * 	@brief This is the function of the Debug class use to print out a message without checking the debug level or adding additional information for debug purposes. 
 	 */
@@ -76,10 +128,26 @@ protected:
 	 */
 	virtual void show_info(char *str);
 	
+	/*!
+	 * 	@brief The output function writes a line on the standard output, using the buffered output if enabled.
+	 */
+	static void output(const char* str, bool urgent);
+	
 	static Sunset_Debug* instance_;
 	
 	static int level;
 	
+private:
+	
+	static bool isModuleEnabled(int debugLevel, int addr, const char* fmt);
+	static void updateLevels();
+	
+	static int maxLevel;		// highest level enabled for any node or module
+	static int allNodesLevel;	// highest level enabled for the nodes without a dedicated level
+	static int nodeLevel[SUNSET_DEBUG_MAX_NODES];	// highest level enabled for each node
+	
+	static std::map<int, int> nodeDebug;				// node - level
+	static std::map<std::string, std::map<int, int> > moduleDebug;		// module - node (-1 for all the nodes) - level
 };
 
 #endif
@@ -27,6 +27,12 @@
 
 Sunset_Information_Dispatcher* Sunset_Information_Dispatcher::instance_ = NULL;
 
+/* A subscriber can call set() while it is notified: the external buffers replaced meanwhile are released only when the 
+ * outermost notification loop is completed, the notified values keep pointing to valid memory. */
+
+static int notify_depth = 0;
+static vector<char*> retired_values;
+
 // TIMER
 void Sunset_Information_Dispatcher_Timer::start(double time, int node, string param) 
 {
@@ -38,7 +44,7 @@ void Sunset_Information_Dispatcher_Timer::start(double time, int node, string pa
 	
 	if (busy_) {
 		
-		Sunset_Debug::debugInfo(-1, node, "INFORMATION_DISPATCHER Start timer busy ERROR");
+		SUNSET_DEBUG_LOG(-1, node, "INFORMATION_DISPATCHER Start timer busy ERROR");
 		return;
 	} 
 	
@@ -49,11 +55,11 @@ void Sunset_Information_Dispatcher_Timer::start(double time, int node, string pa
 	rtime = time;
 	
 	if (rtime < 0.0) {
-		Sunset_Debug::debugInfo(-1, node, "INFORMATION_DISPATCHER Start timer wrong time (%f) ERROR", rtime);
+		SUNSET_DEBUG_LOG(-1, node, "INFORMATION_DISPATCHER Start timer wrong time (%f) ERROR", rtime);
 		return;	
 	}
 	
-	Sunset_Debug::debugInfo(3, node, "INFORMATION_DISPATCHER Start timer");
+	SUNSET_DEBUG_LOG(3, node, "INFORMATION_DISPATCHER Start timer");
 	Sunset_Utilities::schedule(this, &intr, rtime);
 }
 
@@ -83,7 +89,7 @@ void Sunset_Information_Dispatcher_Timer::handle(Event *e)
 	stime = 0.0;
 	rtime = 0.0;
 	
-	Sunset_Debug::debugInfo(3, node_id, "INFORMATION_DISPATCHER Hanlde timer node %d parameter %s",
+	SUNSET_DEBUG_LOG(3, node_id, "INFORMATION_DISPATCHER Hanlde timer node %d parameter %s",
 				node_id, parameter.c_str());
 	
 	node_id = -1;
@@ -110,26 +116,160 @@ public:
 } class_Sunset_Information_Dispatcher;
 
 
+
+// INDEX
+Sunset_Dispatcher_Index::Sunset_Dispatcher_Index()
+{
+	size_ = SUNSET_INFO_INDEX_SIZE;
+	count_ = 0;
+	
+	keys_ = (uint64_t*) malloc (size_ * sizeof(uint64_t));
+	values_ = (int*) malloc (size_ * sizeof(int));
+	
+	if ( keys_ == NULL || values_ == NULL ) {
+	
+		SUNSET_DEBUG_LOG(-1, -1, "Sunset_Dispatcher_Index MALLOC ERROR");
+	
+		exit(1);
+	}
+	
+	memset(values_, 0xff, size_ * sizeof(int));
+}
+
+Sunset_Dispatcher_Index::~Sunset_Dispatcher_Index()
+{
+	free(keys_);
+	free(values_);
+}
+
+/*!
+ * 	@brief The find() function returns the value associated to the given key.
+ *	@param[in] key The key to look for.
+ *	@retval The value associated to key, -1 if the key is not present.
+ */
+
+int Sunset_Dispatcher_Index::find(uint64_t key)
+{
+	uint32_t pos = hash(key) & (size_ - 1);
+	
+	while ( values_[pos] != -1 ) {
+	
+		if ( keys_[pos] == key ) {
+	
+			return values_[pos];
+		}
+	
+		pos = (pos + 1) & (size_ - 1);
+	}
+	
+	return -1;
+}
+
+/*!
+ * 	@brief The insert() function adds a key which is not already present. The table is doubled when it is half full.
+ *	@param[in] key The key to add.
+ *	@param[in] value The non negative value associated to key.
+ */
+
+void Sunset_Dispatcher_Index::insert(uint64_t key, int value)
+{
+	uint32_t pos = 0;
+	
+	if ( 2 * (count_ + 1) > size_ ) {
+	
+		grow();
+	}
+	
+	pos = hash(key) & (size_ - 1);
+	
+	while ( values_[pos] != -1 ) {
+	
+		pos = (pos + 1) & (size_ - 1);
+	}
+	
+	keys_[pos] = key;
+	values_[pos] = value;
+	count_++;
+}
+
+void Sunset_Dispatcher_Index::grow()
+{
+	uint64_t* oldKeys = keys_;
+	int* oldValues = values_;
+	uint32_t oldSize = size_;
+	uint32_t pos = 0;
+	
+	size_ = size_ << 1;
+	
+	keys_ = (uint64_t*) malloc (size_ * sizeof(uint64_t));
+	values_ = (int*) malloc (size_ * sizeof(int));
+	
+	if ( keys_ == NULL || values_ == NULL ) {
+	
+		SUNSET_DEBUG_LOG(-1, -1, "Sunset_Dispatcher_Index::grow MALLOC ERROR");
+	
+		exit(1);
+	}
+	
+	memset(values_, 0xff, size_ * sizeof(int));
+	
+	for ( uint32_t i = 0; i < oldSize; i++ ) {
+	
+		if ( oldValues[i] == -1 ) {
+	
+			continue;
+		}
+	
+		pos = hash(oldKeys[i]) & (size_ - 1);
+	
+		while ( values_[pos] != -1 ) {
+	
+			pos = (pos + 1) & (size_ - 1);
+		}
+	
+		keys_[pos] = oldKeys[i];
+		values_[pos] = oldValues[i];
+	}
+	
+	free(oldKeys);
+	free(oldValues);
+}
+
+///////////////////////////////////////////////////////////////////
+
 Sunset_Information_Dispatcher::Sunset_Information_Dispatcher(): timer(this) 
 {
 	instance_ = this;
 	module_counter = 1;
+	slotCount = 0;
 	
-	Sunset_Debug::debugInfo(2, -1, "Sunset_Information_Dispatcher::Sunset_Information_Dispatcher CREATED");
+	SUNSET_DEBUG_LOG(2, -1, "Sunset_Information_Dispatcher::Sunset_Information_Dispatcher CREATED");
 }
 
 Sunset_Information_Dispatcher::~Sunset_Information_Dispatcher() 
 {
 	instance_ = NULL;
 
-	map<int, std::set<string> >::iterator it;
+	for ( int i = 0; i < slotCount; i++ ) {
 	
-	for ( it = parameters.begin(); it != parameters.end(); it++ ) {
+		if ( getSlot(i)->ext_value != 0 ) {
 		
-		parameters.erase(it);
+			free(getSlot(i)->ext_value);
+		}
+	}
+	
+	for ( int i = 0; i < (int)slotChunks.size(); i++ ) {
+	
+		free(slotChunks[i]);
+	}
+	
+	for ( int i = 0; i < (int)params.size(); i++ ) {
+	
+		delete params[i];
 	}
 	
-	parameters.clear();
+	slotChunks.clear();
+	params.clear();
 }
 
 /*!
@@ -146,7 +286,7 @@ void Sunset_Information_Dispatcher::stop()
 
 void Sunset_Information_Dispatcher::start() 
 {
-	Sunset_Debug::debugInfo(2, -1, "Sunset_Information_Dispatcher::starting the module");
+	SUNSET_DEBUG_LOG(2, -1, "Sunset_Information_Dispatcher::starting the module");
 }
 
 /*!
@@ -167,7 +307,7 @@ int Sunset_Information_Dispatcher::command(int argc, const char*const* argv)
 		
 		if (strcasecmp(argv[1], "start") == 0) {
 			
-			Sunset_Debug::debugInfo(3, -1, "Sunset_Information_Dispatcher::command start Module");
+			SUNSET_DEBUG_LOG(3, -1, "Sunset_Information_Dispatcher::command start Module");
 			start();
 			
 			return TCL_OK;
@@ -177,7 +317,7 @@ int Sunset_Information_Dispatcher::command(int argc, const char*const* argv)
 		
 		if (strcasecmp(argv[1], "stop") == 0) {
 			
-			Sunset_Debug::debugInfo(3, -1, "Sunset_Information_Dispatcher::command stop Module");
+			SUNSET_DEBUG_LOG(3, -1, "Sunset_Information_Dispatcher::command stop Module");
 			stop();
 			
 			return TCL_OK;
@@ -193,9 +333,9 @@ int Sunset_Information_Dispatcher::command(int argc, const char*const* argv)
 			string tmp(argv[3]);
 			Sunset_Utilities::toUpperString(tmp);
 			
-			parameters[my_id].insert(tmp);
+			addParam(my_id, intern(tmp));
 			
-			Sunset_Debug::debugInfo(3, my_id, "Sunset_Information_Dispatcher::command paramter added %s", argv[3]);
+			SUNSET_DEBUG_LOG(3, my_id, "Sunset_Information_Dispatcher::command paramter added %s", argv[3]);
 			
 			return TCL_OK;
 		}
@@ -209,7 +349,7 @@ int Sunset_Information_Dispatcher::command(int argc, const char*const* argv)
 			
 			TclObject::lookup(argv[3]));
 			
-			Sunset_Debug::debugInfo(3, my_id, "Sunset_Information_Dispatcher::command module registered module_id %d", module_id);	
+			SUNSET_DEBUG_LOG(3, my_id, "Sunset_Information_Dispatcher::command module registered module_id %d", module_id);	
 			
 			tcl.resultf("%f",module_id);
 			
@@ -228,7 +368,7 @@ int Sunset_Information_Dispatcher::command(int argc, const char*const* argv)
 			
 			TclObject::lookup(argv[3]));
 			
-			Sunset_Debug::debugInfo(3, my_id, "Sunset_Information_Dispatcher::command module registered module_id %d name %s", module_id, argv[4]);	
+			SUNSET_DEBUG_LOG(3, my_id, "Sunset_Information_Dispatcher::command module registered module_id %d name %s", module_id, argv[4]);	
 			
 			tcl.resultf("%f",module_id);
 			
@@ -259,7 +399,10 @@ int Sunset_Information_Dispatcher::register_module(int my_id, string s, Sunset_D
 	
 	(moduleMap[my_id])[module_counter++] = rm;
 	
-	Sunset_Debug::debugInfo(3, my_id, "Sunset_Information_Dispatcher::register_module module registered module_id %d name %s", rm.module_id, (rm.name).c_str());
+	moduleNode.resize(module_counter, -1);
+	moduleNode[rm.module_id] = my_id;
+	
+	SUNSET_DEBUG_LOG(3, my_id, "Sunset_Information_Dispatcher::register_module module registered module_id %d name %s", rm.module_id, (rm.name).c_str());
 	
 	return rm.module_id;
 	
@@ -283,12 +426,166 @@ int Sunset_Information_Dispatcher::register_module (int my_id, Sunset_Dispatched
 	
 	(moduleMap[my_id])[module_counter++] = rm;
 	
-	Sunset_Debug::debugInfo(3, my_id, "Sunset_Information_Dispatcher::register_module module registered module_id %d", rm.module_id);	
+	moduleNode.resize(module_counter, -1);
+	moduleNode[rm.module_id] = my_id;
+	
+	SUNSET_DEBUG_LOG(3, my_id, "Sunset_Information_Dispatcher::register_module module registered module_id %d", rm.module_id);	
 	
 	return rm.module_id;
 	
 }
 
+/*!
+ * 	@brief The intern() function returns the handle of a parameter name, creating it the first time the name is used.
+ *	@param[in] parameter The parameter name.
+ *	@retval handle The handle of the parameter.
+ */
+
+int Sunset_Information_Dispatcher::intern(string parameter)
+{
+	map<string, int>::iterator it = handles.find(parameter);
+	
+	if ( it != handles.end() ) {
+	
+		return it->second;
+	}
+	
+	handles[parameter] = (int)handleNames.size();
+	handleNames.push_back(parameter);
+	
+	return (int)handleNames.size() - 1;
+}
+
+/*!
+ * 	@brief The get_handle() function returns the handle of a parameter, it can be used by the modules instead of the parameter name.
+ *	@param[in] parameter The parameter name.
+ *	@retval handle The handle of the parameter, -1 if the parameter has never been defined.
+ */
+
+int Sunset_Information_Dispatcher::get_handle(string parameter)
+{
+	map<string, int>::iterator it = handles.find(parameter);
+	
+	if ( it == handles.end() ) {
+	
+		return -1;
+	}
+	
+	return it->second;
+}
+
+/*!
+ * 	@brief The getParam() function returns the parameter defined for the given node.
+ *	@param[in] my_id ID of the node.
+ *	@param[in] handle The handle of the parameter.
+ *	@retval The parameter, 0 if it has not been defined for the node.
+ */
+
+dispatched_param* Sunset_Information_Dispatcher::getParam(int my_id, int handle)
+{
+	int index = 0;
+	
+	if ( handle < 0 ) {
+	
+		return 0;
+	}
+	
+	index = paramIndex.find(((uint64_t)(uint32_t)my_id << 32) | (uint32_t)handle);
+	
+	if ( index == -1 ) {
+	
+		return 0;
+	}
+	
+	return params[index];
+}
+
+/*!
+ * 	@brief The addParam() function defines a parameter for the given node, if not already defined.
+ *	@param[in] my_id ID of the node.
+ *	@param[in] handle The handle of the parameter.
+ *	@retval The parameter.
+ */
+
+dispatched_param* Sunset_Information_Dispatcher::addParam(int my_id, int handle)
+{
+	dispatched_param* dp = getParam(my_id, handle);
+	
+	if ( dp != 0 ) {
+	
+		return dp;
+	}
+	
+	dp = new dispatched_param;
+	
+	dp->node = my_id;
+	dp->handle = handle;
+	dp->index = (int)params.size();
+	
+	params.push_back(dp);
+	
+	paramIndex.insert(((uint64_t)(uint32_t)my_id << 32) | (uint32_t)handle, dp->index);
+	
+	return dp;
+}
+
+/*!
+ * 	@brief The getSlot() function returns the slot storing the value of a parameter related to the given node.
+ *	@param[in] dp The parameter.
+ *	@param[in] node The ID of the node the value is related to.
+ *	@param[in] create If true the slot is created when not present.
+ *	@retval The slot, 0 if not present and create is false.
+ */
+
+info_slot* Sunset_Information_Dispatcher::getSlot(dispatched_param* dp, int node, bool create)
+{
+	uint64_t key = ((uint64_t)(uint32_t)dp->index << 32) | (uint32_t)node;
+	int slot = slotIndex.find(key);
+	info_slot* is = 0;
+	vector<int>::iterator it;
+	
+	if ( slot != -1 ) {
+	
+		return getSlot(slot);
+	}
+	
+	if ( !create ) {
+	
+		return 0;
+	}
+	
+	if ( slotCount == (int)slotChunks.size() * SUNSET_INFO_SLOT_CHUNK ) {
+	
+		is = (info_slot*) malloc (SUNSET_INFO_SLOT_CHUNK * sizeof(info_slot));
+	
+		if ( is == NULL ) {
+	
+			SUNSET_DEBUG_LOG(-1, -1, "Sunset_Information_Dispatcher::getSlot MALLOC ERROR");
+	
+			exit(1);
+		}
+	
+		memset(is, 0x0, SUNSET_INFO_SLOT_CHUNK * sizeof(info_slot));
+	
+		slotChunks.push_back(is);
+	}
+	
+	slot = slotCount++;
+	
+	is = getSlot(slot);
+	is->node_id = node;
+	
+	slotIndex.insert(key, slot);
+	
+	// keep the slots sorted by node ID, get() returns the values in this order
+	
+	for ( it = dp->slots.begin(); it != dp->slots.end() && getSlot(*it)->node_id < node; it++ );
+	
+	dp->slots.insert(it, slot);
+	
+	return is;
+}
+
 /*!
  * 	@brief The set() function notifies to the dispatcher that a new information has been provided by module with ID module_id.
  *	@param[in] my_id ID of the node executing the operation.
@@ -300,21 +597,46 @@ int Sunset_Information_Dispatcher::register_module (int my_id, Sunset_Dispatched
 
 int Sunset_Information_Dispatcher::set(int my_id, int module_id, notified_info ni) 
 {
-	// check if ni is correct and the requested information is provided by the dispatcher with a correct module_id
+	int handle = get_handle(ni.info_name);
 	
-	if (check(my_id, module_id, ni.info_name) == 0) {
+	if ( handle == -1 ) {
 		
-		Sunset_Debug::debugInfo(-1, my_id, "Sunset_Information_Dispatcher::set module_id %d INFO %s NOT DEFINED", module_id, (ni.info_name).c_str());
+		SUNSET_DEBUG_LOG(-1, my_id, "Sunset_Information_Dispatcher::set module_id %d INFO %s NOT DEFINED", module_id, (ni.info_name).c_str());
 		
 		// ERROR
 		return 0;
 	}
 	
-	// check if node_id has signed to provide this kind of information
+	return set(my_id, module_id, handle, ni.node_id, ni.info_value, ni.info_size, ni.info_time);
+}
 	
-	if (provided_info.find(my_id) == provided_info.end()) {
+/*!
+ * 	@brief The set() function stores a new value of the parameter with the given handle and notifies it to the subscribed modules.
+ *	The value is copied in the dispatcher storage, no memory is allocated once the slot for the value exists.
+ *	@param[in] my_id ID of the node executing the operation.
+ *	@param[in] module_id ID of the module providing the information (this is the one assigned by the information dispatcher during the registration phase).
+ *	@param[in] handle The handle of the parameter.
+ *	@param[in] node The ID of the node the information is related to.
+ *	@param[in] value The information value.
+ *	@param[in] size The information size in bytes.
+ *	@param[in] time The information timestamp.
+ *	@retval 1 Operation correctly completed.
+ *	@retval 0 Error.
+ */
 		
-		Sunset_Debug::debugInfo(-1, my_id, "Sunset_Information_Dispatcher::set node not registered to provide this  info %s", (ni.info_name).c_str());	
+int Sunset_Information_Dispatcher::set(int my_id, int module_id, int handle, int node, const void* value, size_t size, double time)
+{
+	dispatched_param* dp = getParam(my_id, handle);
+	info_slot* is = 0;
+	notified_info ni;
+	list<notified_info> linfo;
+	const char* name = (handle >= 0 && handle < (int)handleNames.size()) ? (handleNames[handle]).c_str() : "-";
+	
+	// check if ni is correct and the requested information is provided by the dispatcher with a correct module_id
+	
+	if (check(my_id, module_id, dp, handle) == 0) {
+	
+		SUNSET_DEBUG_LOG(-1, my_id, "Sunset_Information_Dispatcher::set module_id %d INFO %s NOT DEFINED", module_id, name);
 		
 		// ERROR
 		return 0;
@@ -322,73 +644,108 @@ int Sunset_Information_Dispatcher::set(int my_id, int module_id, notified_info n
 	
 	// check if module_id has signed to provide this kind of information
 	
-	if (provided_info[my_id].find(ni.info_name) == provided_info[my_id].end() ||
-	    ((provided_info[my_id])[ni.info_name]).find(module_id) == ((provided_info[my_id])[ni.info_name]).end()) {
+	if (std::find(dp->providers.begin(), dp->providers.end(), module_id) == dp->providers.end()) {
 		
-		Sunset_Debug::debugInfo(-1, my_id, "Sunset_Information_Dispatcher::set module %d not registered to provide this  info %s", module_id, (ni.info_name).c_str());	
+		SUNSET_DEBUG_LOG(-1, my_id, "Sunset_Information_Dispatcher::set module %d not registered to provide this  info %s", module_id, name);
 		
 		// ERROR
 		return 0;
 	}
 	
-	// check if an older information was stored and free the allocated memory
+	// store the provided information, the storage of the previous value is reused
 	
-	if ( node_info.find(my_id) != node_info.end() &&
-	    node_info[my_id].find(ni.info_name) != node_info[my_id].end() && 
-	    (node_info[my_id])[ni.info_name].find(ni.node_id) != (node_info[my_id])[ni.info_name].end()) {
+	is = getSlot(dp, node, true);
 		
-		if ((((node_info[my_id])[ni.info_name])[ni.node_id]).info_size != 0 ) {
+	if ( size > SUNSET_INFO_SLOT_SIZE ) {
 			
-			free((((node_info[my_id])[ni.info_name])[ni.node_id]).info_value);			      
+		if ( is->ext_size < size ) {
+	
+			if ( notify_depth > 0 ) {
+				
+				retired_values.push_back(is->ext_value);	// it can be the value being notified
+			}
+			else {
+				
+				free(is->ext_value);
+			}
+	
+			is->ext_value = (char*) malloc (size);
+	
+			if ( is->ext_value == NULL ) {
+	
+				SUNSET_DEBUG_LOG(-1, my_id, "Sunset_Information_Dispatcher::set MALLOC ERROR");
+	
+				exit(1);
+			}
+	
+			is->ext_size = size;
 		}
 		
+		is->info_value = (void*)(is->ext_value);
+	} 
+	else {
+		
+		is->info_value = (void*)(is->inline_value.data);
 	}
 	
-	// store the provided information
+	if ( size > 0 && value != 0 && value != is->info_value ) {
 	
-	(((node_info[my_id])[ni.info_name])[ni.node_id]).info_size = ni.info_size;
-
-	(((node_info[my_id])[ni.info_name])[ni.node_id]).info_value = ni.info_value;
+		memcpy(is->info_value, value, size);
+	}
 	
-	(((node_info[my_id])[ni.info_name])[ni.node_id]).info_time = ni.info_time;
+	is->info_size = size;
+	is->info_time = time;
 	
-	Sunset_Debug::debugInfo(3, my_id, "Sunset_Information_Dispatcher::set module_id %d node_id %d name %s time %f", module_id, ni.node_id, (ni.info_name).c_str(), ni.info_time);
+	SUNSET_DEBUG_LOG(3, my_id, "Sunset_Information_Dispatcher::set module_id %d node_id %d name %s time %f", module_id, node, (handleNames[handle]).c_str(), time);
 	
 	// check if some modules have to be notified about the updated information
-	if (subscribed_info.find(my_id) != subscribed_info.end() &&
-	    (subscribed_info[my_id]).find(ni.info_name) != (subscribed_info[my_id]).end()) {
-		
-		std::set<int>::iterator it = ((subscribed_info[my_id])[ni.info_name]).begin();
-		list<notified_info> linfo;
-		
-		linfo.push_back(ni);
-		
-		Sunset_Debug::debugInfo(3, my_id, "Sunset_Information_Dispatcher::set modules subscribed for %s size %d",  (ni.info_name).c_str(), ((subscribed_info[my_id])[ni.info_name]).size());
+	if ( dp->subscribers.empty() ) {
+	
+		SUNSET_DEBUG_LOG(3, my_id, "Sunset_Information_Dispatcher::set no module has subscribed %s", (handleNames[handle]).c_str());
+	
+		// OK
+		return 1;
+	}
+	
+	ni.info_name = handleNames[handle];
+	ni.node_id = node;
+	ni.info_value = is->info_value;
+	ni.info_size = size;
+	ni.info_time = time;
+	
+	linfo.push_back(ni);
+	
+	SUNSET_DEBUG_LOG(3, my_id, "Sunset_Information_Dispatcher::set modules subscribed for %s size %d",  (handleNames[handle]).c_str(), (int)dp->subscribers.size());
+	
+	// subscribers can be added while notifying, the vector is accessed by position
+	
+	notify_depth++;
+	
+	for ( int i = 0; i < (int)dp->subscribers.size(); i++ ) {
+	
+		registered_module rm = dp->subscribers[i];
+	
+		if (rm.module_id != module_id) {
+	
+			SUNSET_DEBUG_LOG(3, my_id, "Sunset_Information_Dispatcher::set notify to module_id %d name %s", (rm).module_id, (rm.name).c_str());
+	
+			// notify this information to the subscribed module
+	
+			(rm.module)->notify_info(linfo);
+		}
+		else {
+			SUNSET_DEBUG_LOG(3, my_id, "Sunset_Information_Dispatcher::set notify to module_id %d name %s NO FORWARD", (rm).module_id, (rm.name).c_str());
+		}
+	}
+	
+	if ( --notify_depth == 0 ) {
 		
-		for (; it != ((subscribed_info[my_id])[ni.info_name]).end(); it++) {
+		for ( int i = 0; i < (int)retired_values.size(); i++ ) {
 			
-			if ( moduleMap.find(my_id) != moduleMap.end() &&
-			    (moduleMap[my_id]).find(*it) != (moduleMap[my_id]).end()) {
-				
-				registered_module rm = (moduleMap[my_id])[*it];
-				
-				if (rm.module_id != module_id) {
-					
-					Sunset_Debug::debugInfo(3, my_id, "Sunset_Information_Dispatcher::set notify to module_id %d name %s", (rm).module_id, (rm.name).c_str());
-					
-					// notify this information to the subscribed module 
-					
-					(rm.module)->notify_info(linfo);			
-				}	
-				else {
-					Sunset_Debug::debugInfo(3, my_id, "Sunset_Information_Dispatcher::set notify to module_id %d name %s NO FORWARD", (rm).module_id, (rm.name).c_str());
-				}
-			}
+			free(retired_values[i]);
 		}
-	} 
-	else {
 		
-		Sunset_Debug::debugInfo(3, my_id, "Sunset_Information_Dispatcher::set no module has subscribed %s", (ni.info_name).c_str());
+		retired_values.clear();
 	}
 	
 	// OK
@@ -407,57 +764,51 @@ int Sunset_Information_Dispatcher::set(int my_id, int module_id, notified_info n
 
 int Sunset_Information_Dispatcher::get(int my_id, int module_id, string parameter, list<notified_info>& list_ni)
 {
-	map<int, stored_info >::iterator it;
+	int handle = get_handle(parameter);
+	dispatched_param* dp = getParam(my_id, handle);
+	info_slot* is = 0;
 	
 	//check if the requested parameter is provided by the dispatcher and the module_id is correct
-	if (check(my_id, module_id, parameter) == 0) {
+	if (check(my_id, module_id, dp, handle) == 0) {
 		
-		Sunset_Debug::debugInfo(0, my_id, "Sunset_Information_Dispatcher::get module_id %d INFO %s NOT DEFINED", module_id, (parameter).c_str());
+		SUNSET_DEBUG_LOG(0, my_id, "Sunset_Information_Dispatcher::get module_id %d INFO %s NOT DEFINED", module_id, (parameter).c_str());
 		
 		// ERROR	
 		return 0;
 		
 	}
 	
-	//check if the node_id has signed to request this kind of information
-	if (subscribed_info.find(my_id) == subscribed_info.end()) {
-		
-		Sunset_Debug::debugInfo(-1, my_id, "Sunset_Information_Dispatcher::get node not registered to request this  info %s", (parameter).c_str());	
-		
-		// ERROR
-		return 0;
-	}
-	
 	//check if the module_id has signed to request this kind of information
-	if ((subscribed_info[my_id]).find(parameter) == (subscribed_info[my_id]).end() || 
-	    ((subscribed_info[my_id])[parameter]).find(module_id) == ((subscribed_info[my_id])[parameter]).end()) {
-		Sunset_Debug::debugInfo(-1, my_id, "Sunset_Information_Dispatcher::get module %d not registered to request this  info %s", module_id, (parameter).c_str());
+	if (!is_subscribed(dp, module_id)) {
+		
+		SUNSET_DEBUG_LOG(-1, my_id, "Sunset_Information_Dispatcher::get module %d not registered to request this  info %s", module_id, (parameter).c_str());
 		
 		// ERROR
 		return 0;
 	}
 	
 	//check if the dispatcher has the requested information
-	if ( node_info.find(my_id) == node_info.end() || node_info[my_id].find(parameter) == node_info[my_id].end()) {
+	if ( dp->slots.empty() ) {
 		
-		Sunset_Debug::debugInfo(-1, my_id, "Sunset_Information_Dispatcher::get module_id %d INFO %s VAL NOT DEFINED", module_id, (parameter).c_str());
+		SUNSET_DEBUG_LOG(-1, my_id, "Sunset_Information_Dispatcher::get module_id %d INFO %s VAL NOT DEFINED", module_id, (parameter).c_str());
 		
 		//ERROR
 		return 0;
 		
 	}
 	
-	it = ((node_info[my_id])[parameter]).begin();
-	
 	//collect the requested information for all the different node_id (if more than one)
-	for (; it != ((node_info[my_id])[parameter]).end(); it++) {
+	for ( int i = 0; i < (int)dp->slots.size(); i++ ) {
 		
 		notified_info ni;
+	
+		is = getSlot(dp->slots[i]);
+	
 		ni.info_name = parameter;
-		ni.node_id = it->first;
-		ni.info_time = (it->second).info_time;
-		ni.info_value = (it->second).info_value;
-		ni.info_size = (it->second).info_size;
+		ni.node_id = is->node_id;
+		ni.info_time = is->info_time;
+		ni.info_value = is->info_value;
+		ni.info_size = is->info_size;
 		list_ni.push_back(ni);
 	}
 	
@@ -478,52 +829,74 @@ int Sunset_Information_Dispatcher::get(int my_id, int module_id, string paramete
 
 int Sunset_Information_Dispatcher::get(int my_id, int module_id, string parameter, int node, notified_info& ni)
 {
-	//check if the requested parameter is provided by the dispatcher and the module_id is correct
-	if (check(my_id, module_id, parameter) == 0) {
-		
-		Sunset_Debug::debugInfo(-1, my_id, "Sunset_Information_Dispatcher::get module_id %d node %d INFO %s NOT DEFINED", module_id, node, (parameter).c_str());
+	int handle = get_handle(parameter);
+	
+	if ( handle == -1 ) {
 		
-		//ERROR	
+		SUNSET_DEBUG_LOG(-1, my_id, "Sunset_Information_Dispatcher::get module_id %d node %d INFO %s NOT DEFINED", module_id, node, (parameter).c_str());
+	
+		//ERROR
 		return 0;
-		
 	}
 	
-	//check if the node_id has signed to request this kind of information
-	if (subscribed_info.find(my_id) == subscribed_info.end()) {
-		
-		Sunset_Debug::debugInfo(-1, my_id, "Sunset_Information_Dispatcher::get node not registered to request this  info %s", (parameter).c_str());	
+	return get(my_id, module_id, handle, node, ni);
+}
+
+/*!
+ * 	@brief The get() function collects the latest value of the parameter with the given handle related to the given node.
+ *	The returned value points to the dispatcher storage and it is valid until the next set() of the same value.
+ *	@param[in] my_id ID of the node executing the operation.
+ *	@param[in] module_id ID of the module requesting the information (this is the one assigned by the information dispatcher during the registration phase).
+ *	@param[in] handle The handle of the parameter the module is interesting in.
+ *	@param[in] node The ID of the node providing the information the module is interesting in.
+ *	@param[in] ni Notified info were to store the requested information.
+ *	@retval 1 Operation correctly completed.
+ *	@retval 0 Error.
+ */
+
+int Sunset_Information_Dispatcher::get(int my_id, int module_id, int handle, int node, notified_info& ni)
+{
+	dispatched_param* dp = getParam(my_id, handle);
+	info_slot* is = 0;
+	
+	//check if the requested parameter is provided by the dispatcher and the module_id is correct
+	if (check(my_id, module_id, dp, handle) == 0) {
+	
+		SUNSET_DEBUG_LOG(-1, my_id, "Sunset_Information_Dispatcher::get module_id %d node %d INFO %s NOT DEFINED", module_id, node, (handle >= 0 && handle < (int)handleNames.size()) ? (handleNames[handle]).c_str() : "-");
 		
-		// ERROR
+		//ERROR	
 		return 0;
+		
 	}
 	
 	//check if the module_id has signed to request this kind of information
-	if ((subscribed_info[my_id]).find(parameter) == (subscribed_info[my_id]).end() || 
-	    ((subscribed_info[my_id])[parameter]).find(module_id) == ((subscribed_info[my_id])[parameter]).end()) {
+	if (!is_subscribed(dp, module_id)) {
 		
-		Sunset_Debug::debugInfo(-1, my_id, "Sunset_Information_Dispatcher::get module %d not registered to request this  info %s", module_id, (parameter).c_str());
+		SUNSET_DEBUG_LOG(-1, my_id, "Sunset_Information_Dispatcher::get module %d not registered to request this  info %s", module_id, (handleNames[handle]).c_str());
 		
 		// ERROR
 		return 0;
 	}
 	
 	//check if the dispatcher has the requested information
-	if ( node_info.find(my_id) == node_info.end() || node_info[my_id].find(parameter) == node_info[my_id].end()) {
+	if ( dp->slots.empty() ) {
 		
-		Sunset_Debug::debugInfo(-1, my_id, "Sunset_Information_Dispatcher::get module_id %d INFO %s VAL NOT DEFINED", module_id, (parameter).c_str());
+		SUNSET_DEBUG_LOG(-1, my_id, "Sunset_Information_Dispatcher::get module_id %d INFO %s VAL NOT DEFINED", module_id, (handleNames[handle]).c_str());
 		
 		//ERROR
 		return 0;
 		
 	}
 	
+	//collect the requested information, an empty value is returned if nothing has been stored for node
+	
+	is = getSlot(dp, node, false);
 	
-	//collect the requested information
-	ni.info_name = parameter;
+	ni.info_name = handleNames[handle];
 	ni.node_id = node;
-	ni.info_time = ((node_info[my_id])[parameter])[node].info_time;
-	ni.info_value = ((node_info[my_id])[parameter])[node].info_value;
-	ni.info_size = ((node_info[my_id])[parameter])[node].info_size;
+	ni.info_time = (is != 0) ? is->info_time : 0.0;
+	ni.info_value = (is != 0) ? is->info_value : 0;
+	ni.info_size = (is != 0) ? is->info_size : 0;
 	
 	// OK
 	return 1;
@@ -540,30 +913,24 @@ int Sunset_Information_Dispatcher::get(int my_id, int module_id, string paramete
 
 int Sunset_Information_Dispatcher::provide(int my_id, int module_id, string parameter)
 {
-	// check if node_id is a correct one assigned by the dispatcher
-	if ( moduleMap.find(my_id) == moduleMap.end()) {
+	dispatched_param* dp = 0;
 		
-  		Sunset_Debug::debugInfo(-1, my_id, "Sunset_Information_Dispatcher::provide node name %s MODULE NOT PRESENT", module_id, parameter.c_str());	
+	// check if node_id and module_id are correct ones assigned by the dispatcher
+	if ( !is_registered(my_id, module_id) ) {
 		
-		//ERROR
-		return 0;
-		
-	}
-	
-	// check if module_id is a correct one assigned by the dispatcher
-	if ( moduleMap[my_id].find(module_id) == moduleMap[my_id].end()) {
-		
-  		Sunset_Debug::debugInfo(-1, my_id, "Sunset_Information_Dispatcher::provide module_id %d name %s MODULE NOT PRESENT", module_id, parameter.c_str());	
+  		SUNSET_DEBUG_LOG(-1, my_id, "Sunset_Information_Dispatcher::provide module_id %d name %s MODULE NOT PRESENT", module_id, parameter.c_str());	
 		
 		//ERROR
 		return 0;
 		
 	}
 	
+	dp = getParam(my_id, get_handle(parameter));
+	
 	// check if parameter is known by the dispatcher
-	if (parameters.find(my_id) == parameters.end() || parameters[my_id].find(parameter) == parameters[my_id].end()) {
+	if ( dp == 0 ) {
 		
-		Sunset_Debug::debugInfo(-1, my_id, "Sunset_Information_Dispatcher::provide module_id %d name %s NOT PRESENT", module_id, parameter.c_str());	
+		SUNSET_DEBUG_LOG(-1, my_id, "Sunset_Information_Dispatcher::provide module_id %d name %s NOT PRESENT", module_id, parameter.c_str());	
 		
 		printAddedParameters(my_id);
 		
@@ -571,11 +938,13 @@ int Sunset_Information_Dispatcher::provide(int my_id, int module_id, string para
 		return 0;
 	}
 	
-	
-	Sunset_Debug::debugInfo(3, my_id, "Sunset_Information_Dispatcher::provide module_id %d name %s ADDED", module_id, parameter.c_str());	
+	SUNSET_DEBUG_LOG(3, my_id, "Sunset_Information_Dispatcher::provide module_id %d name %s ADDED", module_id, parameter.c_str());	
 	
 	// register the provided information
-	((provided_info[my_id])[parameter]).insert(module_id);
+	if ( std::find(dp->providers.begin(), dp->providers.end(), module_id) == dp->providers.end() ) {
+	
+		dp->providers.push_back(module_id);
+	}
 	
 	//OK
 	return 1;
@@ -592,13 +961,31 @@ int Sunset_Information_Dispatcher::provide(int my_id, int module_id, string para
 
 int Sunset_Information_Dispatcher::check(int my_id, int module_id, string parameter)
 {
-	Sunset_Debug::debugInfo(3, my_id, "Sunset_Information_Dispatcher::check module_id %d name %s", module_id, parameter.c_str());
+	int handle = get_handle(parameter);
+	
+	return check(my_id, module_id, getParam(my_id, handle), handle);
+}
+
+/*!
+ * 	@brief The check() function controls if the parameter with the given handle is supported by the dispatcher.
+ *	@param[in] my_id ID of the node executing the operation.
+ *	@param[in] module_id ID of the module requesting to execute an action (set/get).
+ *	@param[in] dp The parameter defined for the node, 0 if not defined.
+ *	@param[in] handle The handle of the parameter.
+ *	@retval 1 Operation correctly completed.
+ *	@retval 0 Error.
+ */
+
+int Sunset_Information_Dispatcher::check(int my_id, int module_id, dispatched_param* dp, int handle)
+{
+	const char* name = (handle >= 0 && handle < (int)handleNames.size()) ? (handleNames[handle]).c_str() : "-";
+	
+	SUNSET_DEBUG_LOG(3, my_id, "Sunset_Information_Dispatcher::check module_id %d name %s", module_id, name);
 	
 	// check if the requested parameter is known by the dispatcher for this node
-	if (parameters.find(my_id) == parameters.end() || parameters[my_id].find(parameter) == parameters[my_id].end()) {
+	if ( dp == 0 ) {
 		
-		Sunset_Debug::debugInfo(-1, my_id, "Sunset_Information_Dispatcher::check name %s NOT PRESENT", 
-					parameter.c_str());	
+		SUNSET_DEBUG_LOG(-1, my_id, "Sunset_Information_Dispatcher::check name %s NOT PRESENT", name);
 		
 		printAddedParameters(my_id);
 		
@@ -607,9 +994,9 @@ int Sunset_Information_Dispatcher::check(int my_id, int module_id, string parame
 	}
 	
 	// check if the node_id and module_id are known by the dispatcher
-	if ( moduleMap.find(my_id) == moduleMap.end() || moduleMap[my_id].find(module_id) == moduleMap[my_id].end()) {
+	if ( !is_registered(my_id, module_id) ) {
 		
-  		Sunset_Debug::debugInfo(-1, my_id, "Sunset_Information_Dispatcher::check module_id %d NOT PRESENT", module_id);	
+  		SUNSET_DEBUG_LOG(-1, my_id, "Sunset_Information_Dispatcher::check module_id %d NOT PRESENT", module_id);	
 		
 		//ERROR
 		return 0;
@@ -617,16 +1004,20 @@ int Sunset_Information_Dispatcher::check(int my_id, int module_id, string parame
 	}
 
 	// check if the parameter is provided by the node requesting it.
-	if ( is_provided( my_id, module_id, parameter ) == 0) {
+	if ( dp->providers.empty() ) {
 		
-  		Sunset_Debug::debugInfo(-1, my_id, "Sunset_Information_Dispatcher::check parameter %s not provieded by the node %d requesting it", parameter.c_str(), my_id);
+		SUNSET_DEBUG_LOG(-1, my_id, "Sunset_Information_Dispatcher::is_provided module_id %d name %s NOT PRESENT", module_id, name);
+	
+		printAddedParameters(my_id);
+	
+  		SUNSET_DEBUG_LOG(-1, my_id, "Sunset_Information_Dispatcher::check parameter %s not provieded by the node %d requesting it", name, my_id);
 		
 		//ERROR
 		return 0;
 		
 	}
 	
-	Sunset_Debug::debugInfo(3, my_id, "Sunset_Information_Dispatcher::check module_id %d name %s OK", module_id, parameter.c_str());	
+	SUNSET_DEBUG_LOG(3, my_id, "Sunset_Information_Dispatcher::check module_id %d name %s OK", module_id, name);
 	
 	// OK
 	return 1;
@@ -644,9 +1035,9 @@ int Sunset_Information_Dispatcher::check(int my_id, int module_id, string parame
 int Sunset_Information_Dispatcher::define(int my_id, int module_id, string new_parameter)
 {
 	// check if the parameter is already known by the dispatcher. If this is the case it does not have to be defined
-	if (parameters.find(my_id) != parameters.end() && parameters[my_id].find(new_parameter) != parameters[my_id].end()) {
+	if ( getParam(my_id, get_handle(new_parameter)) != 0 ) {
 		
-		Sunset_Debug::debugInfo(-1, my_id, "Sunset_Information_Dispatcher::define module_id %d INFO %s ALREADY DEFINED", module_id, (new_parameter).c_str());
+		SUNSET_DEBUG_LOG(-1, my_id, "Sunset_Information_Dispatcher::define module_id %d INFO %s ALREADY DEFINED", module_id, (new_parameter).c_str());
 		
 		printAddedParameters(my_id);
 		
@@ -655,7 +1046,7 @@ int Sunset_Information_Dispatcher::define(int my_id, int module_id, string new_p
 	}
 	
 	// ADD the parameter
-	parameters[my_id].insert(new_parameter);
+	addParam(my_id, intern(new_parameter));
 	
 	//OK
 	return 1;
@@ -668,19 +1059,19 @@ int Sunset_Information_Dispatcher::define(int my_id, int module_id, string new_p
 
 void Sunset_Information_Dispatcher::printAddedParameters(int my_id) 
 {
-	std::set<string>::iterator it;
+	map<string, int>::iterator it;
+	int i = 1;
 	
-	if (parameters.find(my_id) == parameters.end()) {
+	// parameters are printed in name order
 		
-		return;
+	for ( it = handles.begin(); it != handles.end(); it++ ) {
 		
-	}
+		if ( getParam(my_id, it->second) == 0 ) {
 	
-	it = parameters[my_id].begin();
+			continue;
+		}
 	
-	for (int i = 1; it != parameters[my_id].end(); it++, i++) {
-		
-		Sunset_Debug::debugInfo(5, my_id, "Sunset_Information_Dispatcher::printAddedParameters id %d name %s", i, (*it).c_str());	
+		SUNSET_DEBUG_LOG(5, my_id, "Sunset_Information_Dispatcher::printAddedParameters id %d name %s", i++, (it->first).c_str());
 	}
 }
 
@@ -695,14 +1086,29 @@ void Sunset_Information_Dispatcher::printAddedParameters(int my_id)
 
 int Sunset_Information_Dispatcher::is_provided(int my_id, int module_id, string parameter)
 {
-	Sunset_Debug::debugInfo(3, my_id, "Sunset_Information_Dispatcher::is_provided module_id %d name %s", module_id, parameter.c_str());	
+	return is_provided(my_id, module_id, get_handle(parameter));
+}
+
+/*!
+ * 	@brief The is_provided() function checks if the information about the parameter with the given handle are provided by the dispatcher.
+ *	@param[in] my_id ID of the node executing the operation.
+ *	@param[in] module_id ID of the module making the request.
+ *	@param[in] handle The handle of the parameter the module is interesting in.
+ *	@retval 1 Operation correctly completed.
+ *	@retval 0 Error.
+ */
+
+int Sunset_Information_Dispatcher::is_provided(int my_id, int module_id, int handle)
+{
+	dispatched_param* dp = getParam(my_id, handle);
+	const char* name = (handle >= 0 && handle < (int)handleNames.size()) ? (handleNames[handle]).c_str() : "-";
+	
+	SUNSET_DEBUG_LOG(3, my_id, "Sunset_Information_Dispatcher::is_provided module_id %d name %s", module_id, name);
 	
 	// check if the requested parameter is provided by the dispatcher
-	if (provided_info.find(my_id) == provided_info.end() || 
-	    provided_info[my_id].find(parameter) == provided_info[my_id].end() || 
-	    ((provided_info[my_id])[parameter]).empty()) {
+	if ( dp == 0 || dp->providers.empty() ) {
 		
-		Sunset_Debug::debugInfo(-1, my_id, "Sunset_Information_Dispatcher::is_provided module_id %d name %s NOT PRESENT", module_id, parameter.c_str());	
+		SUNSET_DEBUG_LOG(-1, my_id, "Sunset_Information_Dispatcher::is_provided module_id %d name %s NOT PRESENT", module_id, name);
 		
 		printAddedParameters(my_id);
 		
@@ -710,7 +1116,7 @@ int Sunset_Information_Dispatcher::is_provided(int my_id, int module_id, string
 		return 0;
 	}
 	
-	Sunset_Debug::debugInfo(3, my_id, "Sunset_Information_Dispatcher::check is_provided %d name %s OK", module_id, parameter.c_str());	
+	SUNSET_DEBUG_LOG(3, my_id, "Sunset_Information_Dispatcher::check is_provided %d name %s OK", module_id, name);
 	
 	// OK
 	return 1;
@@ -727,25 +1133,15 @@ int Sunset_Information_Dispatcher::is_provided(int my_id, int module_id, string
 
 int Sunset_Information_Dispatcher::stop_providing(int my_id, int module_id, string parameter)
 {
-	Sunset_Debug::debugInfo(3, my_id, "Sunset_Information_Dispatcher::stop_providing module_id %d name %s", module_id, parameter.c_str());	
-	
-	// check if the requested parameter is provided by the dispatcher
-	if (provided_info.find(my_id) == provided_info.end() || 
-	    provided_info[my_id].find(parameter) == provided_info[my_id].end()) {
-		
-		Sunset_Debug::debugInfo(-1, my_id, "Sunset_Information_Dispatcher::stop_providing module_id %d name %s NOT PRESENT", module_id, parameter.c_str());	
-		
-		printAddedParameters(my_id);
-		
-		//ERROR
-		return 0;
-	}
+	dispatched_param* dp = getParam(my_id, get_handle(parameter));
+	vector<int>::iterator it;
 	
+	SUNSET_DEBUG_LOG(3, my_id, "Sunset_Information_Dispatcher::stop_providing module_id %d name %s", module_id, parameter.c_str());	
 	
 	// check if the module was providing the given parameter
-	if (((provided_info[my_id])[parameter]).find(module_id) == ((provided_info[my_id])[parameter]).end()) {
+	if ( dp == 0 || (it = std::find(dp->providers.begin(), dp->providers.end(), module_id)) == dp->providers.end() ) {
 		
-		Sunset_Debug::debugInfo(-1, my_id, "Sunset_Information_Dispatcher::stop_providing module_id %d name %s NOT PRESENT", module_id, parameter.c_str());	
+		SUNSET_DEBUG_LOG(-1, my_id, "Sunset_Information_Dispatcher::stop_providing module_id %d name %s NOT PRESENT", module_id, parameter.c_str());	
 		
 		printAddedParameters(my_id);
 		
@@ -754,14 +1150,9 @@ int Sunset_Information_Dispatcher::stop_providing(int my_id, int module_id, stri
 	}
 	
 	// remove the information from the dispatcher
-	((provided_info[my_id])[parameter]).erase(((provided_info[my_id])[parameter]).find(module_id));
-	
-	if ( ((provided_info[my_id])[parameter]).empty() ) {
-		
-		((provided_info[my_id])).erase((provided_info[my_id]).find(parameter));
-	}
+	dp->providers.erase(it);
 	
-	Sunset_Debug::debugInfo(3, my_id, "Sunset_Information_Dispatcher::stop_providing is_provided %d name %s REMOVED", module_id, parameter.c_str());	
+	SUNSET_DEBUG_LOG(3, my_id, "Sunset_Information_Dispatcher::stop_providing is_provided %d name %s REMOVED", module_id, parameter.c_str());	
 	
 	// OK
 	return 1;
@@ -778,35 +1169,31 @@ int Sunset_Information_Dispatcher::stop_providing(int my_id, int module_id, stri
 
 int Sunset_Information_Dispatcher::remove_subscription(int my_id, int module_id, string parameter)
 {
-	Sunset_Debug::debugInfo(3, my_id, "Sunset_Information_Dispatcher::remove_subscription module_id %d name %s", module_id, parameter.c_str());	
+	dispatched_param* dp = getParam(my_id, get_handle(parameter));
 	
-	// check if the requested parameter is provided by the dispatcher
-	if (subscribed_info.find(my_id) == subscribed_info.end() || 
-	    subscribed_info[my_id].find(parameter) == subscribed_info[my_id].end()) {
-		
-		Sunset_Debug::debugInfo(-1, my_id, "Sunset_Information_Dispatcher::remove_subscription module_id %d name %s NOT PRESENT", module_id, parameter.c_str());	
-		
-		//ERROR
-		return 0;
-	}
+	SUNSET_DEBUG_LOG(3, my_id, "Sunset_Information_Dispatcher::remove_subscription module_id %d name %s", module_id, parameter.c_str());	
 	
 	// check if the module was signed for the given parameter
-	if (((subscribed_info[my_id])[parameter]).find(module_id) == ((subscribed_info[my_id])[parameter]).end()) {
-		Sunset_Debug::debugInfo(-1, my_id, "Sunset_Information_Dispatcher::remove_subscription module_id %d name %s NOT PRESENT", module_id, parameter.c_str());	
+	if ( dp == 0 || !is_subscribed(dp, module_id) ) {
+		
+		SUNSET_DEBUG_LOG(-1, my_id, "Sunset_Information_Dispatcher::remove_subscription module_id %d name %s NOT PRESENT", module_id, parameter.c_str());	
 		
 		//ERROR
 		return 0;
 	}
 	
 	// remove the information from the dispatcher
-	((subscribed_info[my_id])[parameter]).erase(((subscribed_info[my_id])[parameter]).find(module_id));
-	
-	if ( ((subscribed_info[my_id])[parameter]).empty() ) {
+	for ( int i = 0; i < (int)dp->subscribers.size(); i++ ) {
 		
-		((subscribed_info[my_id])).erase((subscribed_info[my_id]).find(parameter));
+		if ( dp->subscribers[i].module_id == module_id ) {
+	
+			dp->subscribers.erase(dp->subscribers.begin() + i);
+	
+			break;
+		}
 	}
 	
-	Sunset_Debug::debugInfo(3, my_id, "Sunset_Information_Dispatcher::remove_subscription  %d name %s REMOVED", module_id, parameter.c_str());	
+	SUNSET_DEBUG_LOG(3, my_id, "Sunset_Information_Dispatcher::remove_subscription  %d name %s REMOVED", module_id, parameter.c_str());	
 	
 	return 1;
 }
@@ -822,20 +1209,25 @@ int Sunset_Information_Dispatcher::remove_subscription(int my_id, int module_id,
 
 int Sunset_Information_Dispatcher::subscribe(int my_id, int module_id, string parameter) 
 {
+	dispatched_param* dp = 0;
+	vector<registered_module>::iterator it;
+	
 	// check if the node_id and module_id are known by the dispatcher and the module_id is correct
-	if ( moduleMap.find(my_id) == moduleMap.end() || moduleMap[my_id].find(module_id) == moduleMap[my_id].end()) {
+	if ( !is_registered(my_id, module_id) ) {
 		
-  		Sunset_Debug::debugInfo(-1, my_id, "Sunset_Information_Dispatcher::subscribe module_id %d name %s MODULE NOT PRESENT", module_id, parameter.c_str());	
+  		SUNSET_DEBUG_LOG(-1, my_id, "Sunset_Information_Dispatcher::subscribe module_id %d name %s MODULE NOT PRESENT", module_id, parameter.c_str());	
 		
 		//ERROR
 		return 0;
 		
 	}
 	
+	dp = getParam(my_id, get_handle(parameter));
+	
 	// check if the requested parameter is known by the dispatcher
-	if (parameters.find(my_id) == parameters.end() || parameters[my_id].find(parameter) == parameters[my_id].end()) {
+	if ( dp == 0 ) {
 		
-		Sunset_Debug::debugInfo(-1, my_id, "Sunset_Information_Dispatcher::subscribe module_id %d name %s NOT PRESENT", module_id, parameter.c_str());	
+		SUNSET_DEBUG_LOG(-1, my_id, "Sunset_Information_Dispatcher::subscribe module_id %d name %s NOT PRESENT", module_id, parameter.c_str());	
 		
 		printAddedParameters(my_id);
 		
@@ -843,12 +1235,43 @@ int Sunset_Information_Dispatcher::subscribe(int my_id, int module_id, string pa
 		return 0;
 	}
 	
-	// register the module request
-	((subscribed_info[my_id])[parameter]).insert(module_id);
+	// register the module request, subscribers are kept sorted by module ID (notification order)
+	if ( !is_subscribed(dp, module_id) ) {
 	
-	Sunset_Debug::debugInfo(-1, my_id, "Sunset_Information_Dispatcher::subscribe module_id %d name %s", module_id, parameter.c_str());	
+		for ( it = dp->subscribers.begin(); it != dp->subscribers.end() && (*it).module_id < module_id; it++ );
+	
+		dp->subscribers.insert(it, (moduleMap[my_id])[module_id]);
+	}
+	
+	SUNSET_DEBUG_LOG(-1, my_id, "Sunset_Information_Dispatcher::subscribe module_id %d name %s", module_id, parameter.c_str());	
 	
 	//OK
 	return 1;
 }
 
+/*!
+ * 	@brief The is_registered() function checks if the module with the given ID has been registered by the given node.
+ */
+
+bool Sunset_Information_Dispatcher::is_registered(int my_id, int module_id)
+{
+	return module_id > 0 && module_id < (int)moduleNode.size() && moduleNode[module_id] == my_id;
+}
+
+/*!
+ * 	@brief The is_subscribed() function checks if the module with the given ID has subscribed to the given parameter.
+ */
+
+bool Sunset_Information_Dispatcher::is_subscribed(dispatched_param* dp, int module_id)
+{
+	for ( int i = 0; i < (int)dp->subscribers.size(); i++ ) {
+	
+		if ( dp->subscribers[i].module_id == module_id ) {
+	
+			return true;
+		}
+	}
+	
+	return false;
+}
+
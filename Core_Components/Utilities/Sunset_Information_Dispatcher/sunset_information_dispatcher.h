@@ -33,6 +33,9 @@
 #include <map>
 #include <list>
 #include <set>
+#include <vector>
+#include <algorithm>
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 #include <pthread.h>
@@ -88,16 +91,78 @@ typedef struct notified_info {
 	
 } notified_info;
 
-/*! @brief struct containing the information stored at the dispatcher. */
-typedef struct stored_info {
-	
-	void* info_value;	// information value
+#define SUNSET_INFO_SLOT_SIZE		32	/*!< @brief Size (bytes) of the values stored inside the slots, larger values use a buffer allocated once per slot. */
+#define SUNSET_INFO_SLOT_CHUNK		256	/*!< @brief Number of slots allocated at once, the slots are never moved. */
+#define SUNSET_INFO_INDEX_SIZE		256	/*!< @brief Initial size of the hash indexes, it has to be a power of two. */
 
+/*! @brief struct containing the information stored at the dispatcher for a given node, parameter and addressed node. */
+typedef struct info_slot {
+	
+	int node_id;		// node ID which the information are related to
+	
+	void* info_value;	// information value, it points to the inline value or to the external buffer
+	
 	size_t info_size;	// information size in bytes
-
+	
 	double info_time;	// information timestamp
 	
-} stored_info;
+	char* ext_value;	// buffer used for values larger than SUNSET_INFO_SLOT_SIZE
+	
+	size_t ext_size;	// size of the external buffer
+	
+	union {
+		char data[SUNSET_INFO_SLOT_SIZE];
+		double align;
+	} inline_value;
+	
+} info_slot;
+
+/*! @brief struct containing the state of a parameter defined for a node. */
+typedef struct dispatched_param {
+	
+	int node;				// node ID the parameter is defined for
+	
+	int handle;				// handle of the parameter name
+	
+	int index;				// position in the dispatcher parameter list
+	
+	vector<int> providers;			// IDs of the modules providing the parameter
+	
+	vector<registered_module> subscribers;	// modules subscribed to the parameter, sorted by module ID
+	
+	vector<int> slots;			// stored values, sorted by addressed node
+	
+} dispatched_param;
+
+/*! @brief This class implements an open addressing hash index mapping 64 bits keys to non negative integers. 
+ *  Keys are never removed. */
+
+class Sunset_Dispatcher_Index {
+	
+public:
+	
+	Sunset_Dispatcher_Index();
+	~Sunset_Dispatcher_Index();
+	
+	int find(uint64_t key);			// return the value of key, -1 if not present
+	void insert(uint64_t key, int value);	// add a key which is not present
+	
+private:
+	
+	void grow();
+	
+	static uint32_t hash(uint64_t key) 
+	{
+		key = key * 0x9E3779B97F4A7C15ULL;
+		
+		return (uint32_t)(key >> 32);
+	}
+	
+	uint64_t* keys_;
+	int* values_;	// -1 for empty positions
+	uint32_t size_;
+	uint32_t count_;
+};
 
 class Sunset_Dispatched_Module {
 	
@@ -191,6 +256,27 @@ public:
 	 */
 	int get(int my_id, int module_id, string parameter, int node, notified_info& ni);
 	
+	/*!
+	 * 	@brief The get_handle() function returns the handle of a parameter, -1 if it has never been defined. Handles 
+	 *	can be used instead of the parameter names to avoid looking up the name at each operation.
+	 */
+	int get_handle(string parameter);
+	
+	/*!
+	 * 	@brief The set() function stores a new value, related to node, of the parameter with the given handle.
+	 */
+	int set(int my_id, int module_id, int handle, int node, const void* value, size_t size, double time);
+	
+	/*!
+	 * 	@brief The get() function collects the latest value, related to node, of the parameter with the given handle.
+	 */
+	int get(int my_id, int module_id, int handle, int node, notified_info& ni);
+	
+	/*!
+	 * 	@brief The is_provided() function checks if the parameter with the given handle is provided by the dispatcher.
+	 */
+	int is_provided(int my_id, int module_id, int handle);
+	
 	/*!
 	 * 	@brief The provide() function notifies the information dispatcher that the module with ID module_id will provide information of parameter type.
 	 */
@@ -263,7 +349,7 @@ public:
 		
 		if ( *val == NULL ) {
 		
-			Sunset_Debug::debugInfo(-1, -1, "Sunset_Information_Dispatcher::get_value MALLOC ERROR");
+			SUNSET_DEBUG_LOG(-1, -1, "Sunset_Information_Dispatcher::get_value MALLOC ERROR");
 			
 			return false;
 		}
@@ -275,35 +361,27 @@ public:
 		return true;
 	}
 	
+	// The value is copied in the dispatcher slot when set() is called, val has to be valid until then
 	template <typename T>
 	bool assign_value(T *val, notified_info* info, size_t size) {
 		
-		T* temp;
-		
 		if ( (int)size == 0 ) {
 			
 			return false;
 		}
 		
-		temp = (T *)malloc(size);
-		
-		if ( temp == NULL ) {
-		
-			Sunset_Debug::debugInfo(-1, -1, "Sunset_Information_Dispatcher::assign_value MALLOC ERROR");
-			
-			return false;
-		}
-		
-		memset(temp, 0x0, size);
-		
-		memcpy(temp, val, size);
-		
-		info->info_value = (void *) temp;
+		info->info_value = (void *) val;
 		info->info_size = size;
 		
 		return true;
 	}
 	
+	template <typename T>
+	int set_value(int my_id, int module_id, int handle, int node, const T& val, double time) {
+		
+		return set(my_id, module_id, handle, node, (const void*)(&val), sizeof(T), time);
+	}
+	
 protected:
 	
 	Sunset_Information_Dispatcher_Timer timer;
@@ -329,13 +407,37 @@ protected:
 	
 	map<int, map < int, registered_module> > moduleMap; // registered modules
 	
-	map<int, map < string, map<int, stored_info > > > node_info; //it stores the node estimated value and timestamp of the information related to a given node and a parameter according to the pattern: <node_id, parameter_name, addressed_node, <value, time>> 
+	vector<int> moduleNode; // node ID of each registered module, indexed by module ID
+	
+	map<string, int> handles; // parameter names interned to handles
+	
+	vector<string> handleNames; // parameter names, indexed by handle
+	
+	vector<dispatched_param*> params; // parameters defined by the nodes
+	
+	Sunset_Dispatcher_Index paramIndex; // <node_id, handle> -> parameter
+	
+	Sunset_Dispatcher_Index slotIndex; // <parameter, addressed_node> -> slot
+	
+	vector<info_slot*> slotChunks; // slots storing the values, allocated SUNSET_INFO_SLOT_CHUNK at a time
+	
+	int slotCount;
+	
+	int intern(string parameter);
+	
+	dispatched_param* getParam(int my_id, int handle);
+	
+	dispatched_param* addParam(int my_id, int handle);
+	
+	info_slot* getSlot(int slot) { return &(slotChunks[slot / SUNSET_INFO_SLOT_CHUNK][slot % SUNSET_INFO_SLOT_CHUNK]); }
+	
+	info_slot* getSlot(dispatched_param* dp, int node, bool create);
 	
-	map<int, std::set<string> > parameters; // registered parameters
+	int check(int my_id, int module_id, dispatched_param* dp, int handle);
 	
-	map<int, map< string, std::set<int> > > provided_info; // provided information <node_id, parameter, module_IDs>
+	bool is_registered(int my_id, int module_id);
 	
-	map<int, map<string, std::set<int> > > subscribed_info; // subscribed information <node_id, parameter, module_IDs>
+	bool is_subscribed(dispatched_param* dp, int module_id);
 	
 	int module_counter;
 	
@@ -0,0 +1,369 @@
+/* SUNSET - Sapienza University Networking framework for underwater Simulation, Emulation and real-life Testing
+ *
+ * Copyright (C) 2012 Regents of UWSN Group of SENSES Lab
+ *
+ * Author: Daniele Spaccini - spaccini@di.uniroma1.it
+ * Author: Roberto Petroccia - petroccia@di.uniroma1.it
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License as published
+ * at http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANATBILITY or FITNESS FOR A PARTICULAR PURPOSE. See the Creative Commons
+ * Attribution-NonCommercial-ShareAlike 3.0 Unported License for more details.
+ *
+ * You should have received a copy of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License
+ * along with this program. If not, see <http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode>.
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include <sunset_mobility.h>
+#include <sunset_debug.h>
+
+Sunset_Position_Store* Sunset_Position_Store::instance_ = NULL;
+
+Sunset_Mobility::Sunset_Mobility()
+{
+	type = SUNSET_MOBILITY_NONE;
+	cartesian = false;
+	
+	ref.latitude = ref.longitude = ref.depth = 0.0;
+	refTime = 0.0;
+	speed = heading = vspeed = 0.0;
+	last = 0;
+}
+
+/*!
+ * 	@brief The setPosition() function sets a fixed position, the previous mobility model is discarded.
+ */
+
+void Sunset_Mobility::setPosition(node_position pos, double now)
+{
+	type = SUNSET_MOBILITY_STATIC;
+	ref = pos;
+	refTime = now;
+	waypoints.clear();
+	last = 0;
+}
+
+/*!
+ * 	@brief The setVelocity() function starts a constant velocity movement from the position of the node at time now.
+ */
+
+void Sunset_Mobility::setVelocity(double s, double h, double vs, double now)
+{
+	node_position pos;
+	
+	if ( !getPosition(now, &pos) ) {
+		
+		pos.latitude = pos.longitude = pos.depth = 0.0;
+	}
+	
+	setPosition(pos, now);
+	
+	speed = s;
+	heading = h;
+	vspeed = vs;
+	
+	if ( speed != 0.0 || vspeed != 0.0 ) {
+		
+		type = SUNSET_MOBILITY_VELOCITY;
+	}
+}
+
+/*!
+ * 	@brief The addWaypoint() function adds a waypoint to the path of the node, the node stays in the first waypoint 
+ *	before its time and in the last one after its time.
+ *	@retval false if the waypoint is older than the last added one.
+ */
+
+bool Sunset_Mobility::addWaypoint(double time, node_position pos)
+{
+	sunset_waypoint w;
+	
+	if ( type != SUNSET_MOBILITY_WAYPOINTS ) {
+		
+		waypoints.clear();
+		last = 0;
+	}
+	
+	if ( !waypoints.empty() && time < waypoints.back().time ) {
+		
+		return false;
+	}
+	
+	w.time = time;
+	w.pos = pos;
+	
+	waypoints.push_back(w);
+	
+	type = SUNSET_MOBILITY_WAYPOINTS;
+	
+	return true;
+}
+
+/*!
+ * 	@brief The loadTrace() function loads the waypoints from a trace file, each line contains "time latitude longitude depth". 
+ *	Empty lines and lines starting with '#' are skipped.
+ *	@retval false if the file cannot be read or it contains no valid waypoint.
+ */
+
+bool Sunset_Mobility::loadTrace(const char* file)
+{
+	FILE* f = fopen(file, "r");
+	char line[256];
+	sunset_waypoint w;
+	int n = 0;
+	
+	if ( f == NULL ) {
+		
+		SUNSET_DEBUG_LOG(-1, -1, "Sunset_Mobility::loadTrace cannot open %s ERROR", file);
+		
+		return false;
+	}
+	
+	waypoints.clear();
+	last = 0;
+	type = SUNSET_MOBILITY_WAYPOINTS;
+	
+	while ( fgets(line, sizeof(line), f) != NULL ) {
+		
+		n++;
+		
+		if ( line[0] == '#' || line[0] == '\n' || line[0] == '\r' ) {
+			
+			continue;
+		}
+		
+		if ( sscanf(line, "%lf %lf %lf %lf", &(w.time), &(w.pos.latitude), &(w.pos.longitude), &(w.pos.depth)) != 4 
+		    || !addWaypoint(w.time, w.pos) ) {
+			
+			SUNSET_DEBUG_LOG(-1, -1, "Sunset_Mobility::loadTrace %s line %d discarded ERROR", file, n);
+		}
+	}
+	
+	fclose(f);
+	
+	if ( waypoints.empty() ) {
+		
+		type = SUNSET_MOBILITY_NONE;
+		
+		return false;
+	}
+	
+	return true;
+}
+
+/*!
+ * 	@brief The getPosition() function computes the position of the node at time now.
+ *	@retval false if the position of the node is not defined.
+ */
+
+bool Sunset_Mobility::getPosition(double now, node_position* pos)
+{
+	double dt = 0.0;
+	double d = 0.0;
+	double a = 0.0;
+	int n = (int)waypoints.size();
+	
+	switch ( type ) {
+		
+		case SUNSET_MOBILITY_NONE:
+			
+			return false;
+			
+		case SUNSET_MOBILITY_STATIC:
+			
+			*pos = ref;
+			
+			return true;
+			
+		case SUNSET_MOBILITY_VELOCITY:
+			
+			dt = now - refTime;
+			d = speed * dt;
+			
+			if ( cartesian ) {
+				
+				pos->latitude = ref.latitude + d * cos(heading * M_PI / 180.0);
+				pos->longitude = ref.longitude + d * sin(heading * M_PI / 180.0);
+			}
+			else {
+				
+				pos->latitude = ref.latitude + (d * cos(heading * M_PI / 180.0) / SUNSET_MOBILITY_EARTH_RADIUS) * 180.0 / M_PI;
+				pos->longitude = ref.longitude + (d * sin(heading * M_PI / 180.0) 
+								  / (SUNSET_MOBILITY_EARTH_RADIUS * cos(ref.latitude * M_PI / 180.0))) * 180.0 / M_PI;
+			}
+			
+			pos->depth = ref.depth + vspeed * dt;
+			
+			return true;
+			
+		case SUNSET_MOBILITY_WAYPOINTS:
+			
+			if ( now <= waypoints[0].time ) {
+				
+				*pos = waypoints[0].pos;
+				
+				return true;
+			}
+			
+			if ( now >= waypoints[n - 1].time ) {
+				
+				*pos = waypoints[n - 1].pos;
+				
+				return true;
+			}
+			
+			// start from the segment of the last query
+			
+			if ( last >= n - 1 || waypoints[last].time > now ) {
+				
+				last = 0;
+			}
+			
+			while ( waypoints[last + 1].time < now ) {
+				
+				last++;
+			}
+			
+			dt = waypoints[last + 1].time - waypoints[last].time;
+			a = (dt > 0.0) ? (now - waypoints[last].time) / dt : 1.0;
+			
+			pos->latitude = waypoints[last].pos.latitude + a * (waypoints[last + 1].pos.latitude - waypoints[last].pos.latitude);
+			pos->longitude = waypoints[last].pos.longitude + a * (waypoints[last + 1].pos.longitude - waypoints[last].pos.longitude);
+			pos->depth = waypoints[last].pos.depth + a * (waypoints[last + 1].pos.depth - waypoints[last].pos.depth);
+			
+			return true;
+	}
+	
+	return false;
+}
+
+/*!
+ * 	@brief The getDistance() function returns the distance (m) between two positions.
+ */
+
+double Sunset_Mobility::getDistance(node_position a, node_position b, bool cartesian)
+{
+	double dx = 0.0;
+	double dy = 0.0;
+	double dz = a.depth - b.depth;
+	double h = 0.0;
+	
+	if ( cartesian ) {
+		
+		dx = a.latitude - b.latitude;
+		dy = a.longitude - b.longitude;
+		
+		return sqrt(dx * dx + dy * dy + dz * dz);
+	}
+	
+	dx = sin((b.latitude - a.latitude) * M_PI / 360.0);
+	dy = sin((b.longitude - a.longitude) * M_PI / 360.0);
+	h = dx * dx + cos(a.latitude * M_PI / 180.0) * cos(b.latitude * M_PI / 180.0) * dy * dy;
+	h = 2.0 * SUNSET_MOBILITY_EARTH_RADIUS * asin(sqrt(h > 1.0 ? 1.0 : h));
+	
+	return sqrt(h * h + dz * dz);
+}
+
+Sunset_Mobility* Sunset_Position_Store::getMobility(int node)
+{
+	if ( node < 0 ) {
+		
+		return NULL;
+	}
+	
+	if ( node >= (int)nodes.size() ) {
+		
+		nodes.resize(node + 1, NULL);
+		reported.resize(node + 1);
+		hasReported.resize(node + 1, false);
+	}
+	
+	if ( nodes[node] == NULL ) {
+		
+		nodes[node] = new Sunset_Mobility();
+		nodes[node]->setCartesian(cartesian);
+	}
+	
+	return nodes[node];
+}
+
+bool Sunset_Position_Store::hasPosition(int node)
+{
+	return node >= 0 && node < (int)nodes.size() && nodes[node] != NULL && nodes[node]->getType() != SUNSET_MOBILITY_NONE;
+}
+
+bool Sunset_Position_Store::isMoving(int node)
+{
+	return hasPosition(node) && nodes[node]->isMoving();
+}
+
+bool Sunset_Position_Store::getPosition(int node, double now, node_position* pos)
+{
+	if ( !hasPosition(node) ) {
+		
+		return false;
+	}
+	
+	return nodes[node]->getPosition(now, pos);
+}
+
+void Sunset_Position_Store::setPosition(int node, node_position pos, double now)
+{
+	Sunset_Mobility* m = getMobility(node);
+	
+	if ( m != NULL ) {
+		
+		m->setPosition(pos, now);
+	}
+}
+
+bool Sunset_Position_Store::checkMoved(int node, double now, double threshold, node_position* pos)
+{
+	if ( !getPosition(node, now, pos) ) {
+		
+		return false;
+	}
+	
+	if ( hasReported[node] && Sunset_Mobility::getDistance(reported[node], *pos, cartesian) <= threshold ) {
+		
+		return false;
+	}
+	
+	setReported(node, *pos);
+	
+	return true;
+}
+
+void Sunset_Position_Store::setReported(int node, node_position pos)
+{
+	if ( getMobility(node) == NULL ) {
+		
+		return;
+	}
+	
+	reported[node] = pos;
+	hasReported[node] = true;
+}
+
+/*!
+ * 	@brief The setCartesian() function selects x, y (m) coordinates instead of latitude and longitude for all the nodes.
+ */
+
+void Sunset_Position_Store::setCartesian(bool c)
+{
+	cartesian = c;
+	
+	for ( int i = 0; i < (int)nodes.size(); i++ ) {
+		
+		if ( nodes[i] != NULL ) {
+			
+			nodes[i]->setCartesian(c);
+		}
+	}
+}
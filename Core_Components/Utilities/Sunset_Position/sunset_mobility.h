@@ -0,0 +1,147 @@
+/* SUNSET - Sapienza University Networking framework for underwater Simulation, Emulation and real-life Testing
+ *
+ * Copyright (C) 2012 Regents of UWSN Group of SENSES Lab
+ *
+ * Author: Daniele Spaccini - spaccini@di.uniroma1.it
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License as published
+ * at http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANATBILITY or FITNESS FOR A PARTICULAR PURPOSE. See the Creative Commons
+ * Attribution-NonCommercial-ShareAlike 3.0 Unported License for more details.
+ *
+ * You should have received a copy of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License
+ * along with this program. If not, see <http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode>.
+ */
+
+
+#ifndef __Sunset_Mobility_h__
+#define __Sunset_Mobility_h__
+
+#include <stdlib.h>
+#include <vector>
+#include <sunset_information_dispatcher.h>
+
+using namespace std;
+
+#define SUNSET_MOBILITY_EARTH_RADIUS	6371000.0	/*!< @brief Earth radius (m) used for the geographic positions. */
+
+/*! @brief The mobility model of a node. */
+
+typedef enum {
+	
+	SUNSET_MOBILITY_NONE = 0,	// position not defined
+	SUNSET_MOBILITY_STATIC,		// fixed position
+	SUNSET_MOBILITY_VELOCITY,	// constant velocity from a reference position
+	SUNSET_MOBILITY_WAYPOINTS	// linear movement between timed waypoints (also used for the trace files)
+	
+} sunset_mobility_type;
+
+/*! @brief A position reached at a given time. */
+
+typedef struct sunset_waypoint {
+	
+	double time;
+	node_position pos;
+	
+} sunset_waypoint;
+
+/*! @brief This class computes the position of a node at a given time. Nothing is evaluated while the node moves: the 
+ *  position is computed only when it is requested, so a static node or a node not queried costs nothing.
+ *  Positions are latitude, longitude (degrees) and depth (m), or x, y, depth (m) when cartesian coordinates are used. 
+ *  Velocities are given as speed (m/s), heading (degrees, clockwise from north/x) and vertical speed (m/s, positive 
+ *  moving deeper).
+ */
+
+class Sunset_Mobility {
+	
+public:
+	
+	Sunset_Mobility();
+	
+	void setPosition(node_position pos, double now);		// the node stays in pos
+	void setVelocity(double speed, double heading, double vspeed, double now);	// the node moves from its position at now
+	bool addWaypoint(double time, node_position pos);		// waypoints have to be added in time order
+	bool loadTrace(const char* file);				// lines "time latitude longitude depth"
+	
+	bool getPosition(double now, node_position* pos);
+	
+	sunset_mobility_type getType() { return type; }
+	
+	bool isMoving() { return type == SUNSET_MOBILITY_VELOCITY || type == SUNSET_MOBILITY_WAYPOINTS; }
+	
+	void setCartesian(bool c) { cartesian = c; }
+	
+	static double getDistance(node_position a, node_position b, bool cartesian);
+	
+private:
+	
+	sunset_mobility_type type;
+	bool cartesian;
+	
+	node_position ref;		// position at refTime for the static and constant velocity models
+	double refTime;
+	double speed;
+	double heading;
+	double vspeed;
+	
+	vector<sunset_waypoint> waypoints;
+	int last;			// waypoint segment used by the last query, queries are usually monotonic in time
+};
+
+/*! @brief This class stores the positions of all the nodes in the process. The Sunset_Position modules and the Tcl 
+ *  scripts read and update it directly, without evaluating Tcl procedures per position query. The position of a moving 
+ *  node is reported as changed only when it has moved more than the threshold from the last reported position.
+ */
+
+class Sunset_Position_Store {
+	
+public:
+	
+	static Sunset_Position_Store* instance() {
+		
+		if ( instance_ == NULL ) {
+			
+			instance_ = new Sunset_Position_Store();
+		}
+		
+		return instance_;
+	}
+	
+	Sunset_Mobility* getMobility(int node);		// created if not existing
+	
+	bool hasPosition(int node);
+	
+	bool getPosition(int node, double now, node_position* pos);
+	
+	void setPosition(int node, node_position pos, double now);
+	
+	bool isMoving(int node);
+	
+	/*! @brief The checkMoved function returns true, and updates the last reported position, if the node has moved 
+	 *  more than the threshold since the last reported position.
+	 */
+	
+	bool checkMoved(int node, double now, double threshold, node_position* pos);
+	
+	void setReported(int node, node_position pos);
+	
+	void setCartesian(bool c);
+	
+private:
+	
+	Sunset_Position_Store() { cartesian = false; }
+	
+	static Sunset_Position_Store* instance_;
+	
+	vector<Sunset_Mobility*> nodes;		// indexed by node ID
+	vector<node_position> reported;		// last reported position, indexed by node ID
+	vector<bool> hasReported;
+	
+	bool cartesian;
+};
+
+#endif
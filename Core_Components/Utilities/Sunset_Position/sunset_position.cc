@@ -38,16 +38,126 @@ public:
 	
 } class_Sunset_Position;
 
+/*! @brief This timer checks every "moveCheckTick" if the node has moved more than "moveThreshold" since the last notified position. */
+
+class Sunset_PositionTimer : public Handler {
+	
+public:
+	
+	Sunset_PositionTimer(Sunset_Position* p) : position(p) 
+	{
+		busy_ = 0; stime = rtime = 0.0;
+	}
+	
+	virtual void handle(Event *e);
+	
+	virtual void start(double time);
+	virtual void stop(void);
+	
+	inline int busy(void) { return busy_; }
+	
+protected:
+	Sunset_Position	*position;
+	int		busy_;
+	Event		intr;
+	double		stime;	// start time
+	double		rtime;	// remaining time
+};
+
+/*! @brief Settings and movement timer of a Sunset_Position module. They are not class members since the modules derived 
+ *  from Sunset_Position in other libraries rely on the class layout.
+ */
+
+typedef struct sunset_position_state {
+	
+	int tclPosition;		// 1 if the node position is always read from and written to the Tcl procedures
+	double moveThreshold;		// distance (m) the node has to move before its position is notified again
+	double moveCheckTick;		// period (sec) of the movement check, 0 to disable it
+	Sunset_PositionTimer* moveTimer;
+	
+} sunset_position_state;
+
+static map<Sunset_Position*, sunset_position_state> position_state;	// indexed by module
+
+static sunset_position_state* getState(Sunset_Position* p)
+{
+	map<Sunset_Position*, sunset_position_state>::iterator it = position_state.find(p);
+	sunset_position_state st;
+	
+	if ( it != position_state.end() ) {
+		
+		return &(it->second);
+	}
+	
+	st.tclPosition = 0;
+	st.moveThreshold = 1.0;
+	st.moveCheckTick = 1.0;
+	st.moveTimer = new Sunset_PositionTimer(p);
+	
+	return &(position_state[p] = st);
+}
+
+void Sunset_PositionTimer::start(double time)
+{
+	Scheduler& s = Scheduler::instance();
+	
+	if (busy_) {
+		
+		stop();
+	} 
+	
+	busy_ = 1;
+	s.sync();
+	stime = s.clock();
+	rtime = time;
+	assert(rtime >= 0.0);
+	
+	Sunset_Utilities::schedule(this, &intr, rtime);
+}
+
+void Sunset_PositionTimer::stop(void)
+{
+	Scheduler& s = Scheduler::instance();
+	
+	if (busy_) {
+		
+		s.cancel(&intr);
+	}
+	
+	busy_ = 0;
+	stime = 0.0;
+	rtime = 0.0;
+}
+
+void Sunset_PositionTimer::handle(Event *e) 
+{
+	busy_ = 0;
+	stime = 0.0;
+	rtime = 0.0;
+	
+	position->checkMovement();
+}
 
 Sunset_Position::Sunset_Position()
 {
 	module_address = -1;
-		
-	Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Position::Sunset_Position CREATED");
+	sid = NULL;
+	
+	SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Position::Sunset_Position CREATED");
 }
 
 Sunset_Position::~Sunset_Position() 
 {
+	map<Sunset_Position*, sunset_position_state>::iterator it = position_state.find(this);
+	
+	if ( it != position_state.end() ) {
+		
+		it->second.moveTimer->stop();
+		
+		delete it->second.moveTimer;
+		
+		position_state.erase(it);
+	}
 }
 
 /*!
@@ -56,7 +166,10 @@ Sunset_Position::~Sunset_Position()
 
 void Sunset_Position::start() 
 {
-	Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Position::start");
+	Sunset_Position_Store* store = Sunset_Position_Store::instance();
+	sunset_position_state* st = getState(this);
+	
+	SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Position::start");
 	
 	Sunset_Module::start();
 	
@@ -66,7 +179,7 @@ void Sunset_Position::start()
 		
 		sid_id = sid->register_module(getModuleAddress(), "POSITION", this);
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Position::start sid_id %d", sid_id);
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Position::start sid_id %d", sid_id);
 
 		sid->define(getModuleAddress(), sid_id, "NODE_POSITION");
 		sid->define(getModuleAddress(), sid_id, "NODE_POSITION_REQ");
@@ -79,6 +192,12 @@ void Sunset_Position::start()
 	
 	getTclPosition();
 	
+	if ( st->moveCheckTick > 0.0 && store->isMoving(getModuleAddress()) ) {
+		
+		store->setReported(getModuleAddress(), position_info[getModuleAddress()]);
+		
+		st->moveTimer->start(st->moveCheckTick);
+	}
 }
 
 /*!
@@ -89,7 +208,9 @@ void Sunset_Position::stop()
 {
 	sid = NULL;
 	
-	Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Position::stop");
+	getState(this)->moveTimer->stop();
+	
+	SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Position::stop");
 }
 
 /*!
@@ -102,8 +223,29 @@ void Sunset_Position::stop()
 
 int Sunset_Position::command(int argc, const char*const* argv) 
 {
+	Tcl& tcl = Tcl::instance();
+	Sunset_Position_Store* store = Sunset_Position_Store::instance();
+	sunset_position_state* st = getState(this);
+	node_position pos;
+	
 	if ( argc == 2 ) {
 		
+		/* The "getPosition" command returns the current position of the node as "latitude longitude depth". */
+		
+		if (strcmp(argv[1], "getPosition") == 0) {
+			
+			if ( getTclPosition() == false ) {
+				
+				return TCL_ERROR;
+			}
+			
+			pos = position_info[getModuleAddress()];
+			
+			tcl.resultf("%f %f %f", pos.latitude, pos.longitude, pos.depth);
+			
+			return TCL_OK;
+		}
+		
 		/* The "start" command starts the Position module */
 		
 		if (strcmp(argv[1], "start") == 0) {
@@ -130,11 +272,110 @@ int Sunset_Position::command(int argc, const char*const* argv)
 			
 			module_address = atoi(argv[2]);
 			
-			Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Position::command setModuleAddress %d", getModuleAddress());
+			SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Position::command setModuleAddress %d", getModuleAddress());
 			
 			return (TCL_OK);
 		}
 		
+		/* The "setTclPosition" command, if 1, reads and writes the node position always using the Tcl procedures. */
+		
+		if (strcmp(argv[1], "setTclPosition") == 0) {
+			
+			st->tclPosition = atoi(argv[2]);
+			
+			return TCL_OK;
+		}
+		
+		/* The "setMoveThreshold" command sets the distance (m) a moving node has to cover before its position is notified again. */
+		
+		if (strcmp(argv[1], "setMoveThreshold") == 0) {
+			
+			st->moveThreshold = atof(argv[2]);
+			
+			return TCL_OK;
+		}
+		
+		/* The "setMoveCheckTick" command sets the period (sec) of the movement check, 0 disables the notifications of the moving nodes. */
+		
+		if (strcmp(argv[1], "setMoveCheckTick") == 0) {
+			
+			st->moveCheckTick = atof(argv[2]);
+			
+			return TCL_OK;
+		}
+		
+		/* The "loadTrace" command moves the node along the waypoints of a trace file ("time latitude longitude depth" lines). */
+		
+		if (strcmp(argv[1], "loadTrace") == 0) {
+			
+			if ( store->getMobility(getModuleAddress()) == NULL || !store->getMobility(getModuleAddress())->loadTrace(argv[2]) ) {
+				
+				return TCL_ERROR;
+			}
+			
+			return TCL_OK;
+		}
+		
+		/* The "setCartesian" command selects x, y (m) coordinates instead of latitude and longitude for the mobility models of all the nodes. */
+		
+		if (strcmp(argv[1], "setCartesian") == 0) {
+			
+			store->setCartesian(atoi(argv[2]) != 0);
+			
+			return TCL_OK;
+		}
+	}
+	else if ( argc == 5 ) {
+		
+		/* The "setPosition" command sets a fixed position "latitude longitude depth" for the node. */
+		
+		if (strcmp(argv[1], "setPosition") == 0) {
+			
+			pos.latitude = atof(argv[2]);
+			pos.longitude = atof(argv[3]);
+			pos.depth = atof(argv[4]);
+			
+			store->setPosition(getModuleAddress(), pos, NOW);
+			
+			return TCL_OK;
+		}
+		
+		/* The "setVelocity" command moves the node from its current position with constant "speed heading vertical_speed". */
+		
+		if (strcmp(argv[1], "setVelocity") == 0) {
+			
+			if ( store->getMobility(getModuleAddress()) == NULL ) {
+				
+				return TCL_ERROR;
+			}
+			
+			store->getMobility(getModuleAddress())->setVelocity(atof(argv[2]), atof(argv[3]), atof(argv[4]), NOW);
+			
+			if ( sid != NULL && st->moveCheckTick > 0.0 && !st->moveTimer->busy() ) {
+				
+				st->moveTimer->start(st->moveCheckTick);
+			}
+			
+			return TCL_OK;
+		}
+	}
+	else if ( argc == 6 ) {
+		
+		/* The "addWaypoint" command adds a waypoint "time latitude longitude depth" to the path of the node. */
+		
+		if (strcmp(argv[1], "addWaypoint") == 0) {
+			
+			pos.latitude = atof(argv[3]);
+			pos.longitude = atof(argv[4]);
+			pos.depth = atof(argv[5]);
+			
+			if ( store->getMobility(getModuleAddress()) == NULL || !store->getMobility(getModuleAddress())->addWaypoint(atof(argv[2]), pos) ) {
+				
+				return TCL_ERROR;
+			}
+			
+			return TCL_OK;
+		}
 	}
 	
 	return TclObject::command( argc, argv );
@@ -152,6 +393,7 @@ int Sunset_Position::notify_info(list<notified_info> linfo)
 	notified_info ni;
 	string s;
 	node_position my_pos;
+	Sunset_Position_Store* store = Sunset_Position_Store::instance();
 	
 	for (; it != linfo.end(); it++) {
 		
@@ -168,7 +410,7 @@ int Sunset_Position::notify_info(list<notified_info> linfo)
 
 			sendPosition(ni.node_id);				
 			
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Position::notify_info Received request for %d", ni.node_id);	
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Position::notify_info Received request for %d", ni.node_id);	
 			
 			continue;
 			
@@ -182,22 +424,22 @@ int Sunset_Position::notify_info(list<notified_info> linfo)
 
 			position_info[ni.node_id] = my_pos;
 			
-			if (ni.node_id == getModuleAddress()) {
+			if (ni.node_id == getModuleAddress() && !store->isMoving(getModuleAddress())) {
 				
 				if (setTclPosition() == false) {
 					
-					Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Position::notify_info position ERROR");	
+					SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Position::notify_info position ERROR");	
 					
 					return 0;
 				}
 				
 			}
 			
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Position::notify_info Received from %d position (%f, %f, %f)", ni.node_id, my_pos.latitude, my_pos.longitude, my_pos.depth);	
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Position::notify_info Received from %d position (%f, %f, %f)", ni.node_id, my_pos.latitude, my_pos.longitude, my_pos.depth);	
 		}
 	}
 	
-	Sunset_Debug::debugInfo(1, getModuleAddress(), "Sunset_Position::notify_info NOTHING TO DO");
+	SUNSET_DEBUG_LOG(1, getModuleAddress(), "Sunset_Position::notify_info NOTHING TO DO");
 	
 	return 1; 
 }
@@ -214,20 +456,27 @@ bool Sunset_Position::setTclPosition()
 	
 	if (position_info.find(getModuleAddress()) == position_info.end()) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Position::setTclPosition no info ERROR");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Position::setTclPosition no info ERROR");
 		
 		return false;
 	}
 	
 	node_position my_pos = position_info[getModuleAddress()];
 	
+	if ( !getState(this)->tclPosition ) {
+		
+		Sunset_Position_Store::instance()->setPosition(getModuleAddress(), my_pos, NOW);
+		
+		return true;
+	}
+	
 	memset(command, '\0', 100);
 	sprintf(command, "setSunsetLatitude %d %f", getModuleAddress(), my_pos.latitude);
 	ret = Tcl_GlobalEval(tcl.interp(), command);
 	
 	if (ret == TCL_ERROR) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Position::setTclPosition An error calling %s occured", command);
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Position::setTclPosition An error calling %s occured", command);
 		
 		return false;
 	}
@@ -238,7 +487,7 @@ bool Sunset_Position::setTclPosition()
 	
 	if (ret == TCL_ERROR) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Position::setTclPosition An error calling %s occured", command);
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Position::setTclPosition An error calling %s occured", command);
 		
 		return false;
 	}
@@ -250,12 +499,12 @@ bool Sunset_Position::setTclPosition()
 	
 	if (ret == TCL_ERROR) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Position::setTclPosition An error calling %s occured", command);
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Position::setTclPosition An error calling %s occured", command);
 		
 		return false;
 	}
 		
-	Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Position::setTclPosition Node Position: %f %f %f", my_pos.latitude, my_pos.longitude, my_pos.depth);
+	SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Position::setTclPosition Node Position: %f %f %f", my_pos.latitude, my_pos.longitude, my_pos.depth);
 		
 	return true;
 }
@@ -270,6 +519,15 @@ bool Sunset_Position::getTclPosition()
 	char command[50];
 	int ret = 0;
 	node_position my_pos;
+	Sunset_Position_Store* store = Sunset_Position_Store::instance();
+	int tclPosition = getState(this)->tclPosition;
+	
+	if ( !tclPosition && store->getPosition(getModuleAddress(), NOW, &my_pos) ) {
+		
+		position_info[getModuleAddress()] = my_pos;
+		
+		return true;
+	}
 	
 	memset(command, '\0', 50);
 	sprintf(command, "getSunsetLatitude %d", getModuleAddress());
@@ -277,7 +535,7 @@ bool Sunset_Position::getTclPosition()
 	
 	if (ret == TCL_ERROR) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Position::getTclPosition An error calling %s occured", command);
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Position::getTclPosition An error calling %s occured", command);
 		
 		return false;
 	}
@@ -290,7 +548,7 @@ bool Sunset_Position::getTclPosition()
 	
 	if (ret == TCL_ERROR) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Position::getTclPosition An error calling %s occured", command);
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Position::getTclPosition An error calling %s occured", command);
 		
 		return false;
 	}
@@ -303,20 +561,51 @@ bool Sunset_Position::getTclPosition()
 	
 	if (ret == TCL_ERROR) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Position::getTclPosition An error calling %s occured", command);
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Position::getTclPosition An error calling %s occured", command);
 		
 		return false;
 	}
 	
 	my_pos.depth = atof(tcl.result());
 	
-	Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Position::getTclPosition Node Position: %f %f %f", my_pos.latitude, my_pos.longitude, my_pos.depth);
+	SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Position::getTclPosition Node Position: %f %f %f", my_pos.latitude, my_pos.longitude, my_pos.depth);
 	
 	position_info[getModuleAddress()] = my_pos;
 	
+	if ( !tclPosition ) {
+		
+		store->setPosition(getModuleAddress(), my_pos, NOW);	// the Tcl procedures are not evaluated anymore
+	}
+	
 	return true;
 }
 
+/*!
+ * 	@brief The checkMovement() function notifies the node position to the subscribed modules when the node has moved more than 
+ *	"moveThreshold" since the last notification.
+ */
+
+void Sunset_Position::checkMovement()
+{
+	Sunset_Position_Store* store = Sunset_Position_Store::instance();
+	sunset_position_state* st = getState(this);
+	node_position pos;
+	
+	if ( sid == NULL || !store->isMoving(getModuleAddress()) ) {
+		
+		return;
+	}
+	
+	if ( store->checkMoved(getModuleAddress(), NOW, st->moveThreshold, &pos) ) {
+		
+		position_info[getModuleAddress()] = pos;
+		
+		sendPosition(getModuleAddress());
+	}
+	
+	st->moveTimer->start(st->moveCheckTick);
+}
+
 /*!
  * 	@brief Provide the current position of the node to the subsribed modules.
  */
@@ -324,19 +613,26 @@ bool Sunset_Position::getTclPosition()
 void Sunset_Position::sendPosition(int node)
 {
 	notified_info ni;
+	node_position aux;
 	
 	if (sid == NULL) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "  Sunset_Position::sendPosition DISPATCHER NOT DEFINED");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "  Sunset_Position::sendPosition DISPATCHER NOT DEFINED");
 		
 		return;
 	}
 	
+	if ( !getState(this)->tclPosition && Sunset_Position_Store::instance()->getPosition(node, NOW, &aux) ) {
+		
+		position_info[node] = aux;
+		
+		Sunset_Position_Store::instance()->setReported(node, aux);
+	}
+	
 	if (position_info.find(node) == position_info.end()) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Position::sendPosition no info node %d ERROR", node);
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Position::sendPosition no info node %d ERROR", node);
 		
-		node_position aux;
 		aux.latitude = 0.0;
 		aux.longitude = 0.0;
 		aux.depth = 0.0;
@@ -352,7 +648,7 @@ void Sunset_Position::sendPosition(int node)
 
 	if ( sid->assign_value(&pos, &ni, sizeof(node_position)) == false) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Position::sendPosition ERROR ASSIGINING INFO %s", (ni.info_name).c_str());
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Position::sendPosition ERROR ASSIGINING INFO %s", (ni.info_name).c_str());
 		
 		return;
 		
@@ -360,11 +656,11 @@ void Sunset_Position::sendPosition(int node)
 	
 	if ( sid->set(getModuleAddress(), sid_id, ni) == 0 ) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Position::sendPosition PROVIDING INFO %s NOT DEFINED", (ni.info_name).c_str());
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Position::sendPosition PROVIDING INFO %s NOT DEFINED", (ni.info_name).c_str());
 		
 	}
 	
-	Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Position::sendPosition Node %d Position: %f %f %f", node, pos.latitude, pos.longitude, pos.depth);
+	SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Position::sendPosition Node %d Position: %f %f %f", node, pos.latitude, pos.longitude, pos.depth);
 	
 	return;
 }
@@ -25,10 +25,16 @@
 #include <sunset_module.h>
 #include <sunset_debug.h>
 #include <sunset_information_dispatcher.h>
+#include <sunset_mobility.h>
 
 class Sunset_Position;
+class Sunset_PositionTimer;
 
 /*! @brief This class is used to interact with the other modules to collect and provide node position information. The Information Dispatcher is used for the module interaction.
+ *  Positions are kept in the Sunset_Position_Store, where a mobility model (fixed position, constant velocity, waypoints or trace file) 
+ *  computes them when requested. The Tcl procedures getSunsetLatitude/Longitude/Depth are evaluated only if "setTclPosition 1" has been 
+ *  used or if the node has no position in the store. The module settings and the movement timer are kept in sunset_position.cc and 
+ *  not as class members, since the classes derived from Sunset_Position in other libraries rely on its layout.
  */
 
 class Sunset_Position : public TclObject, public Sunset_Module {
@@ -37,6 +43,8 @@ public:
 	Sunset_Position();
 	~Sunset_Position();
 	
+	friend class Sunset_PositionTimer;
+	
 	virtual int getModuleAddress() { return module_address; }
 	virtual int command(int argc, const char*const* argv );
 	virtual int notify_info(list<notified_info>);
@@ -58,6 +66,8 @@ protected:
 	virtual bool getTclPosition();
 	virtual bool setTclPosition();
 	
+	void checkMovement();	// notify the node position if the node has moved more than the movement threshold
+	
 };
 
 #endif
@@ -0,0 +1,276 @@
+/* SUNSET - Sapienza University Networking framework for underwater Simulation, Emulation and real-life Testing
+ *
+ * Copyright (C) 2012 Regents of UWSN Group of SENSES Lab <http://reti.dsi.uniroma1.it/SENSES_lab/>
+ *
+ * Author: Roberto Petroccia - petroccia@di.uniroma1.it
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License as published
+ * at http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANATBILITY or FITNESS FOR A PARTICULAR PURPOSE. See the Creative Commons
+ * Attribution-NonCommercial-ShareAlike 3.0 Unported License for more details.
+ *
+ * You should have received a copy of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License
+ * along with this program. If not, see <http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode>.
+ */
+
+#ifndef __Sunset_Bit_Stream_h__
+#define __Sunset_Bit_Stream_h__
+
+#include <stdint.h>
+#include <string.h>
+
+#define SUNSET_BIT_STREAM_CHUNK		56	/*!< @brief Maximum number of bits moved by a single word operation. */
+
+/*! @brief This class implements the bit packing used by the packet converters. Bit "i" of a field is stored in bit 
+ *  "(offset + i) % 8" of byte "(offset + i) / 8" of the buffer, the same wire format of the former bit-by-bit 
+ *  implementation. The bytes touched by a field are loaded in a 64-bit word, updated with a shift and a mask and 
+ *  stored back, bytes outside the field are never read or written. Fields up to SUNSET_BIT_STREAM_CHUNK bits are 
+ *  moved in a single operation, the template versions are used when the field width is known at compile time.
+ */
+
+class Sunset_Bit_Stream {
+	
+public:
+	
+	/*! @brief The load function returns the "n" (<= 8) bytes starting at "p" as a little-endian word. */
+	
+	static inline uint64_t load(const unsigned char* p, int n) 
+	{
+		uint64_t w = 0;
+		
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+		if ( n == 8 ) {
+			
+			memcpy(&w, p, 8);
+			
+			return w;
+		}
+#endif
+		for ( int i = 0; i < n; i++ ) {
+			
+			w |= ((uint64_t)p[i]) << (8 * i);
+		}
+		
+		return w;
+	}
+	
+	/*! @brief The store function writes the "n" (<= 8) least significant bytes of "w" starting at "p". */
+	
+	static inline void store(unsigned char* p, uint64_t w, int n) 
+	{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+		if ( n == 8 ) {
+			
+			memcpy(p, &w, 8);
+			
+			return;
+		}
+#endif
+		for ( int i = 0; i < n; i++ ) {
+			
+			p[i] = (unsigned char)(w >> (8 * i));
+		}
+	}
+	
+	/*! @brief The readBits function returns "size" (<= SUNSET_BIT_STREAM_CHUNK) bits of "buf" starting from the "offset" position. */
+	
+	static inline uint64_t readBits(const unsigned char* buf, int offset, int size) 
+	{
+		int shift = offset & 7;
+		uint64_t w = load(buf + (offset >> 3), (shift + size + 7) >> 3);
+		
+		return (w >> shift) & ((((uint64_t)1) << size) - 1);
+	}
+	
+	/*! @brief The writeBits function writes the "size" (<= SUNSET_BIT_STREAM_CHUNK) least significant bits of "value" in "buf" 
+	 *  starting from the "offset" position. The other bits of the buffer are not modified. */
+	
+	static inline void writeBits(unsigned char* buf, int offset, uint64_t value, int size) 
+	{
+		int shift = offset & 7;
+		int n = (shift + size + 7) >> 3;
+		uint64_t mask = ((((uint64_t)1) << size) - 1) << shift;
+		unsigned char* p = buf + (offset >> 3);
+		uint64_t w = load(p, n);
+		
+		w = (w & ~mask) | ((value << shift) & mask);
+		
+		store(p, w, n);
+	}
+	
+	/*! @brief Compile-time width version of readBits. */
+	
+	template <int W> static inline uint64_t readBits(const unsigned char* buf, int offset) 
+	{
+		enum { width_check = sizeof(char[(W > 0 && W <= SUNSET_BIT_STREAM_CHUNK) ? 1 : -1]) };	// W has to be in [1, SUNSET_BIT_STREAM_CHUNK]
+		
+		return readBits(buf, offset, W);
+	}
+	
+	/*! @brief Compile-time width version of writeBits. */
+	
+	template <int W> static inline void writeBits(unsigned char* buf, int offset, uint64_t value) 
+	{
+		enum { width_check = sizeof(char[(W > 0 && W <= SUNSET_BIT_STREAM_CHUNK) ? 1 : -1]) };	// W has to be in [1, SUNSET_BIT_STREAM_CHUNK]
+		
+		writeBits(buf, offset, value, W);
+	}
+	
+	/*! @brief The copyBits function copies "size" bits of "src", starting from "srcOffset", in "dst" starting from "dstOffset". 
+	 *  The bits of "dst" outside the copied ones are not modified. Byte-aligned copies are done with memcpy. */
+	
+	static inline void copyBits(unsigned char* dst, int dstOffset, const unsigned char* src, int srcOffset, int size) 
+	{
+		int n = 0;
+		
+		if ( size <= 0 ) {
+			
+			return;
+		}
+		
+		if ( size <= SUNSET_BIT_STREAM_CHUNK ) {
+			
+			// header fields: a single word operation
+			
+			writeBits(dst, dstOffset, readBits(src, srcOffset, size), size);
+			
+			return;
+		}
+		
+		if ( ((dstOffset | srcOffset) & 7) == 0 && size >= 8 ) {
+			
+			n = size >> 3;
+			
+			memcpy(dst + (dstOffset >> 3), src + (srcOffset >> 3), n);
+			
+			n = n << 3;
+			dstOffset += n;
+			srcOffset += n;
+			size -= n;
+		}
+		
+		while ( size > 0 ) {
+			
+			n = (size < SUNSET_BIT_STREAM_CHUNK) ? size : SUNSET_BIT_STREAM_CHUNK;
+			
+			writeBits(dst, dstOffset, readBits(src, srcOffset, n), n);
+			
+			dstOffset += n;
+			srcOffset += n;
+			size -= n;
+		}
+	}
+};
+
+/*! @brief This class writes consecutive fields in a buffer using the Sunset_Bit_Stream format. */
+
+class Sunset_Bit_Writer {
+	
+public:
+	
+	Sunset_Bit_Writer(char* buffer, int offset = 0) : buf_((unsigned char*)buffer), pos_(offset) {}
+	
+	/*! @brief The put function writes the "W" least significant bits of "value". */
+	template <int W> void put(uint64_t value) 
+	{
+		Sunset_Bit_Stream::writeBits<W>(buf_, pos_, value);
+		pos_ += W;
+	}
+	
+	/*! @brief The put function writes the "size" (<= 64) least significant bits of "value". */
+	void put(uint64_t value, int size) 
+	{
+		if ( size > SUNSET_BIT_STREAM_CHUNK ) {
+			
+			Sunset_Bit_Stream::writeBits(buf_, pos_, value, 32);
+			pos_ += 32;
+			value = value >> 32;
+			size -= 32;
+		}
+		
+		if ( size > 0 ) {
+			
+			Sunset_Bit_Stream::writeBits(buf_, pos_, value, size);
+			pos_ += size;
+		}
+	}
+	
+	/*! @brief The putBits function writes "size" bits of the memory pointed by "src". */
+	void putBits(const char* src, int size) 
+	{
+		Sunset_Bit_Stream::copyBits(buf_, pos_, (const unsigned char*)src, 0, size);
+		pos_ += size;
+	}
+	
+	/*! @brief The getPosition function returns the offset (bits) of the next field. */
+	int getPosition() { return pos_; }
+	
+private:
+	
+	unsigned char* buf_;
+	int pos_;
+};
+
+/*! @brief This class reads consecutive fields from a buffer using the Sunset_Bit_Stream format. */
+
+class Sunset_Bit_Reader {
+	
+public:
+	
+	Sunset_Bit_Reader(const char* buffer, int offset = 0) : buf_((const unsigned char*)buffer), pos_(offset) {}
+	
+	/*! @brief The get function reads a field of "W" bits. */
+	template <int W> uint64_t get() 
+	{
+		uint64_t value = Sunset_Bit_Stream::readBits<W>(buf_, pos_);
+		
+		pos_ += W;
+		
+		return value;
+	}
+	
+	/*! @brief The get function reads a field of "size" (<= 64) bits. */
+	uint64_t get(int size) 
+	{
+		uint64_t value = 0;
+		int low = 0;
+		
+		if ( size > SUNSET_BIT_STREAM_CHUNK ) {
+			
+			value = Sunset_Bit_Stream::readBits(buf_, pos_, 32);
+			pos_ += 32;
+			size -= 32;
+			low = 32;
+		}
+		
+		if ( size > 0 ) {
+			
+			value |= Sunset_Bit_Stream::readBits(buf_, pos_, size) << low;
+			pos_ += size;
+		}
+		
+		return value;
+	}
+	
+	/*! @brief The getBits function reads "size" bits in the memory pointed by "dst", the bits of the last byte of "dst" 
+	 *  which are not read are not modified. */
+	void getBits(char* dst, int size) 
+	{
+		Sunset_Bit_Stream::copyBits((unsigned char*)dst, 0, buf_, pos_, size);
+		pos_ += size;
+	}
+	
+	/*! @brief The getPosition function returns the offset (bits) of the next field. */
+	int getPosition() { return pos_; }
+	
+private:
+	
+	const unsigned char* buf_;
+	int pos_;
+};
+
+#endif
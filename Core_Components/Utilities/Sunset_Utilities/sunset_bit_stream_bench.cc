@@ -0,0 +1,296 @@
+/* SUNSET - Sapienza University Networking framework for underwater Simulation, Emulation and real-life Testing
+ *
+ * Copyright (C) 2012 Regents of UWSN Group of SENSES Lab <http://reti.dsi.uniroma1.it/SENSES_lab/>
+ *
+ * Author: Roberto Petroccia - petroccia@di.uniroma1.it
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License as published
+ * at http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANATBILITY or FITNESS FOR A PARTICULAR PURPOSE. See the Creative Commons
+ * Attribution-NonCommercial-ShareAlike 3.0 Unported License for more details.
+ *
+ * You should have received a copy of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License
+ * along with this program. If not, see <http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode>.
+ */
+
+/*
+ * Micro-benchmark of the Sunset_Bit_Stream packing against the former bit-by-bit implementation of 
+ * Sunset_Utilities::setBits/getBits. It first checks that both produce the same buffers on random fields,
+ * offsets and payloads, then measures a MAC + agent header conversion and a payload copy.
+ *
+ * Build: make sunset_bit_stream_bench (or g++ -O2 sunset_bit_stream_bench.cc -o sunset_bit_stream_bench)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include "sunset_bit_stream.h"
+
+#define BENCH_BUF_SIZE		512
+#define BENCH_PAYLOAD_SIZE	64
+#define BENCH_ITERATIONS	200000
+#define BENCH_CHECKS		100000
+
+/* The former implementation, moving one bit per iteration. */
+
+static void legacySetBitsByByte(char *val, uint8_t value, int sizevalue, int offset) 
+{
+	uint8_t mask = 0;
+	uint8_t mask2 = 0;
+	int byte = 0;
+	
+	for (int i = 0; i < sizevalue; i++) {
+		
+		mask = 1 << (i);
+		mask2 = 1 << (int)(offset+i)%8;
+		
+		byte = (int)(floor (((double)offset+i)/8.0));
+		
+		if (value & mask) {
+			
+			val[byte] |= mask2;
+		} 
+		else {
+			
+			val[byte] &= ~mask2;
+		} 
+	}
+}
+
+static void legacyGetBitsByByte(char *val, uint8_t &value, int sizevalue, int offset) 
+{
+	uint8_t mask = 0;
+	uint8_t mask2 = 0;
+	int byte = 0;
+	
+	for (int c = 0; c < sizevalue; c++) {
+	 	
+	 	mask = 1 << (c);	
+		mask2 = 1 << (int)(offset+c)%8;
+		
+		byte = (int)(floor (((double)offset+c)/8.0));
+		
+		if (val[byte] & mask2) {
+			
+			value |= mask;
+		} 
+		else {
+			
+			value &= ~mask;
+		} 
+	}
+}
+
+static void legacySetBits(char *val, char* buffer, int sizevalue, int offset) 
+{
+	int numBytes = sizevalue / 8;
+	
+	for (int i = 0; i < numBytes; i++) {
+		
+		legacySetBitsByByte(val, (uint8_t)(buffer[i]), 8, offset + (i * 8));
+	}
+	
+	legacySetBitsByByte(val, (uint8_t)(buffer[numBytes]), sizevalue - (numBytes * 8), offset + (numBytes * 8));
+}
+
+static void legacyGetBits(char *val, char* buffer, int sizevalue, int offset) 
+{
+	int numBytes = sizevalue / 8;
+	
+	for (int i = 0; i < numBytes; i++) {
+		
+		legacyGetBitsByByte(val, (uint8_t&)(buffer[i]), 8, offset + (i * 8));
+	}
+	
+	legacyGetBitsByByte(val, (uint8_t&)(buffer[numBytes]), sizevalue - (numBytes * 8), offset + (numBytes * 8));
+}
+
+static void newSetBits(char *val, char* buffer, int sizevalue, int offset) 
+{
+	Sunset_Bit_Stream::copyBits((unsigned char*)val, offset, (unsigned char*)buffer, 0, sizevalue);
+}
+
+static void newGetBits(char *val, char* buffer, int sizevalue, int offset) 
+{
+	Sunset_Bit_Stream::copyBits((unsigned char*)buffer, 0, (unsigned char*)val, offset, sizevalue);
+}
+
+typedef void (*bits_function)(char*, char*, int, int);
+
+/* The fields written by the MAC and agent converters with the default sizes. */
+
+static const int header_bits[] = { 4, 2, 4, 8, 8, 16, 4, 8, 8, 16, 32 };
+static const int header_fields = sizeof(header_bits) / sizeof(int);
+
+static double now() 
+{
+	struct timespec ts;
+	
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static int check() 
+{
+	char a[BENCH_BUF_SIZE];
+	char b[BENCH_BUF_SIZE];
+	char in[BENCH_PAYLOAD_SIZE + 1];
+	char outA[BENCH_PAYLOAD_SIZE + 1];
+	char outB[BENCH_PAYLOAD_SIZE + 1];
+	
+	for (int n = 0; n < BENCH_CHECKS; n++) {
+		
+		int size = rand() % (BENCH_PAYLOAD_SIZE * 8) + 1;
+		int offset = rand() % ((BENCH_BUF_SIZE - BENCH_PAYLOAD_SIZE - 1) * 8);
+		
+		for (int i = 0; i < BENCH_BUF_SIZE; i++) {
+			
+			a[i] = b[i] = (char)rand();
+		}
+		
+		for (int i = 0; i <= BENCH_PAYLOAD_SIZE; i++) {
+			
+			in[i] = (char)rand();
+			outA[i] = outB[i] = (char)rand();
+		}
+		
+		legacySetBits(a, in, size, offset);
+		newSetBits(b, in, size, offset);
+		
+		if (memcmp(a, b, BENCH_BUF_SIZE) != 0) {
+			
+			printf("setBits mismatch size %d offset %d\n", size, offset);
+			
+			return 0;
+		}
+		
+		legacyGetBits(a, outA, size, offset);
+		newGetBits(b, outB, size, offset);
+		
+		if (memcmp(outA, outB, BENCH_PAYLOAD_SIZE + 1) != 0) {
+			
+			printf("getBits mismatch size %d offset %d\n", size, offset);
+			
+			return 0;
+		}
+	}
+	
+	return 1;
+}
+
+static double benchHeader(bits_function set, bits_function get, int& sink) 
+{
+	char buf[BENCH_BUF_SIZE];
+	uint32_t value = 0;
+	double start = now();
+	
+	memset(buf, 0, BENCH_BUF_SIZE);
+	
+	for (int n = 0; n < BENCH_ITERATIONS; n++) {
+		
+		int offset = n & 7;
+		
+		for (int i = 0; i < header_fields; i++) {
+			
+			value = (uint32_t)(n + i);
+			set(buf, (char*)&value, header_bits[i], offset);
+			offset += header_bits[i];
+		}
+		
+		offset = n & 7;
+		
+		for (int i = 0; i < header_fields; i++) {
+			
+			value = 0;
+			get(buf, (char*)&value, header_bits[i], offset);
+			offset += header_bits[i];
+			sink += value;
+		}
+	}
+	
+	return (now() - start) * 1e9 / BENCH_ITERATIONS;
+}
+
+static double benchHeaderTemplate(int& sink) 
+{
+	char buf[BENCH_BUF_SIZE];
+	double start = now();
+	
+	memset(buf, 0, BENCH_BUF_SIZE);
+	
+	for (int n = 0; n < BENCH_ITERATIONS; n++) {
+		
+		Sunset_Bit_Writer w(buf, n & 7);
+		
+		w.put<4>(n); w.put<2>(n + 1); w.put<4>(n + 2); w.put<8>(n + 3); w.put<8>(n + 4); w.put<16>(n + 5);
+		w.put<4>(n + 6); w.put<8>(n + 7); w.put<8>(n + 8); w.put<16>(n + 9); w.put<32>(n + 10);
+		
+		Sunset_Bit_Reader r(buf, n & 7);
+		
+		sink += r.get<4>(); sink += r.get<2>(); sink += r.get<4>(); sink += r.get<8>(); sink += r.get<8>(); 
+		sink += r.get<16>(); sink += r.get<4>(); sink += r.get<8>(); sink += r.get<8>(); sink += r.get<16>(); 
+		sink += r.get<32>();
+	}
+	
+	return (now() - start) * 1e9 / BENCH_ITERATIONS;
+}
+
+static double benchPayload(bits_function set, bits_function get, int& sink) 
+{
+	char buf[BENCH_BUF_SIZE];
+	char payload[BENCH_PAYLOAD_SIZE + 1];
+	double start = now();
+	
+	memset(buf, 0, BENCH_BUF_SIZE);
+	memset(payload, 1, BENCH_PAYLOAD_SIZE + 1);
+	
+	for (int n = 0; n < BENCH_ITERATIONS; n++) {
+		
+		int offset = 100 + (n & 7);	// payload after a header of a non-integer number of bytes
+		
+		set(buf, payload, BENCH_PAYLOAD_SIZE * 8, offset);
+		get(buf, payload, BENCH_PAYLOAD_SIZE * 8, offset);
+		
+		sink += payload[n % BENCH_PAYLOAD_SIZE];
+	}
+	
+	return (now() - start) * 1e9 / BENCH_ITERATIONS;
+}
+
+int main() 
+{
+	int sink = 0;
+	double legacy = 0.0;
+	double word = 0.0;
+	double tmpl = 0.0;
+	
+	srand(1);
+	
+	if (!check()) {
+		
+		return 1;
+	}
+	
+	printf("bit-exact check passed (%d random fields)\n", BENCH_CHECKS);
+	
+	legacy = benchHeader(legacySetBits, legacyGetBits, sink);
+	word = benchHeader(newSetBits, newGetBits, sink);
+	tmpl = benchHeaderTemplate(sink);
+	
+	printf("header (%d fields) write+read: bit-by-bit %.1f ns, word %.1f ns (x%.1f), template %.1f ns (x%.1f)\n", 
+		header_fields, legacy, word, legacy / word, tmpl, legacy / tmpl);
+	
+	legacy = benchPayload(legacySetBits, legacyGetBits, sink);
+	word = benchPayload(newSetBits, newGetBits, sink);
+	
+	printf("payload (%d bytes, unaligned) write+read: bit-by-bit %.1f ns, word %.1f ns (x%.1f)\n", 
+		BENCH_PAYLOAD_SIZE, legacy, word, legacy / word);
+	
+	return (sink == 42) ? 2 : 0;
+}
@@ -114,7 +114,7 @@ Sunset_Utilities::~Sunset_Utilities()
 void Sunset_Utilities::eraseData(Packet* p, int node) 
 {
 	
-	Sunset_Debug::debugInfo(4, node, "Sunset_Utilities::eraseData");
+	SUNSET_DEBUG_LOG(4, node, "Sunset_Utilities::eraseData");
 	
 	(instance())->removeData(p);
 	
@@ -131,7 +131,7 @@ void Sunset_Utilities::eraseData(Packet* p, int node)
 void Sunset_Utilities::erasePkt(Packet* p, int node) 
 {
 	
-	Sunset_Debug::debugInfo(4, node, "Sunset_Utilities::erasePkt p %p node %d", p, node);
+	SUNSET_DEBUG_LOG(4, node, "Sunset_Utilities::erasePkt p %p node %d", p, node);
 	
 	if (p == 0) {
 		
@@ -155,7 +155,7 @@ void Sunset_Utilities::erasePkt(Packet* p, int node)
 void Sunset_Utilities::copy_data(Packet* p, Packet* copy, int node) 
 {
 	
-	Sunset_Debug::debugInfo(4, node, "Sunset_Utilities::copyPkt node %d p %p", node, p);
+	SUNSET_DEBUG_LOG(4, node, "Sunset_Utilities::copyPkt node %d p %p", node, p);
 	
 	if (p == 0) {
 		
@@ -177,7 +177,7 @@ void Sunset_Utilities::copy_data(Packet* p, Packet* copy, int node)
 void Sunset_Utilities::eraseOnlyPkt(Packet* p, int node) 
 {	
 
-	Sunset_Debug::debugInfo(4, node, "Sunset_Utilities::eraseOnlyPkt p %p node %d", p, node);
+	SUNSET_DEBUG_LOG(4, node, "Sunset_Utilities::eraseOnlyPkt p %p node %d", p, node);
 
 	if (p == 0) {
 		
@@ -264,7 +264,7 @@ double Sunset_Utilities::getRealTime()
 
 void Sunset_Utilities::scheduleEvent(Handler* h, Event* e, double delay) 
 {
-	Sunset_Debug::debugInfo(4, -1, "Sunset_Utilities::scheduleEvent");
+	SUNSET_DEBUG_LOG(4, -1, "Sunset_Utilities::scheduleEvent");
 	
 	Scheduler& s = Scheduler::instance();	
 	
@@ -280,7 +280,7 @@ void Sunset_Utilities::scheduleEvent(Handler* h, Event* e, double delay)
 
 void Sunset_Utilities::schedule(Handler* h, Event* e, double delay)
 {
-	Sunset_Debug::debugInfo(4, -1, "Sunset_Utilities::schedule");
+	SUNSET_DEBUG_LOG(4, -1, "Sunset_Utilities::schedule");
 	
 	(instance())->scheduleEvent(h, e, delay);	
 	
@@ -296,28 +296,18 @@ void Sunset_Utilities::schedule(Handler* h, Event* e, double delay)
 
 void Sunset_Utilities::setBitByOff(unsigned char *val, int32_t value, int sizevalue, int offset) 
 {
-	
-	uint32_t mask = 0;
-	uint32_t mask2 = 0;
-	int byte = 0;
-	
-	for(int i = 0, j = 0; i < sizevalue; i++) {
+	if (sizevalue <= 0) {
 		
-		mask = 1 << (i);
-		mask2 = 1 << (int)(offset+i)%8;
-		
-		byte = (int)(floor (((double)offset+i)/8.0));
+		return;
+	}
+	
+	if (sizevalue > 32) {
 		
-		if(value & mask) {
-			
-			val[byte] |= mask2;
-			
-		} else {
-			
-			val[byte] &= ~mask2;
-		} 
+		sizevalue = 32;
 	}
 	
+	Sunset_Bit_Stream::writeBits(val, offset, (uint32_t)value, sizevalue);
+	
 	return;
 }
 
@@ -331,28 +321,24 @@ void Sunset_Utilities::setBitByOff(unsigned char *val, int32_t value, int sizeva
 
 void Sunset_Utilities::getBitByOff(unsigned char *val, int32_t &value, int sizevalue, int offset ) 
 {
-	
 	uint32_t mask = 0;
-	uint32_t mask2 = 0;
-	int byte = 0;
 	
-	for ( int c = 0; c < sizevalue; c++ ) {
-	 	
-	 	mask = 1 << (c);	
-		mask2 = 1 << (int)(offset+c)%8;
+	if (sizevalue <= 0) {
 		
-		byte = (int)(floor (((double)offset+c)/8.0));
+		return;
+	}
+	
+	if (sizevalue > 32) {
 		
-		if(val[byte] & mask2) {
-			
-			value |= mask;
-			
-		} else {
-			
-			value &= ~mask;
-		} 		
+		sizevalue = 32;
 	}
 	
+	// only the "sizevalue" least significant bits of value are modified
+	
+	mask = (sizevalue >= 32) ? 0xffffffff : ((((uint32_t)1) << sizevalue) - 1);
+	
+	value = (int32_t)((((uint32_t)value) & ~mask) | (((uint32_t)Sunset_Bit_Stream::readBits(val, offset, sizevalue)) & mask));
+	
 	return;
 }
 
@@ -391,58 +377,29 @@ void Sunset_Utilities::toUpperString(string data)
 
 void Sunset_Utilities::setBitsByByte(char *val, uint8_t value, int sizevalue, int offset) 
 {
-	uint8_t mask = 0;
-	uint8_t mask2 = 0;
-	int byte = 0;
-	
-	for(int i = 0, j = 0; i < sizevalue; i++) {
+	if (sizevalue <= 0) {
 		
-		mask = 1 << (i);
-		mask2 = 1 << (int)(offset+i)%8;
-		
-		byte = (int)(floor (((double)offset+i)/8.0));
-		
-		if(value & mask) {
-			
-			val[byte] |= mask2;
-			
-		} else {
-			
-			val[byte] &= ~mask2;
-		} 
+		return;
 	}
 	
+	Sunset_Bit_Stream::writeBits((unsigned char*)val, offset, value, sizevalue);
+	
 	return;
 }
 
 /*!
- * 	@brief ThgetBitsByByte function reads "sizevalue" bits of "val" starting from the "offset" position and stores them into the byte "value". SizeValue is always <= 8
+ * 	@brief The getBitsByByte function reads "sizevalue" bits of "val" starting from the "offset" position and stores them into the byte "value". SizeValue is always <= 8
  */
 
 void Sunset_Utilities::getBitsByByte(char *val, uint8_t &value, int sizevalue, int offset ) 
 {
-	uint8_t mask = 0;
-	uint8_t mask2 = 0;
-	int byte = 0;
-	
-	for ( int c = 0; c < sizevalue; c++ ) {
-	 	
-	 	mask = 1 << (c);	
-		mask2 = 1 << (int)(offset+c)%8;
-		
-		byte = (int)(floor (((double)offset+c)/8.0));
-		
-		if(val[byte] & mask2) {
-			
-			value |= mask;
-			
-		} else {
-			
-			value &= ~mask;
-		} 
+	if (sizevalue <= 0) {
 		
+		return;
 	}
 	
+	Sunset_Bit_Stream::writeBits(&value, 0, Sunset_Bit_Stream::readBits((unsigned char*)val, offset, sizevalue), sizevalue);
+	
 	return;
 }
 
@@ -452,17 +409,7 @@ void Sunset_Utilities::getBitsByByte(char *val, uint8_t &value, int sizevalue, i
 
 void Sunset_Utilities::setBits(char *val, char* buffer, int sizevalue, int offset) 
 {
-	int numBytes = (int) (floor(sizevalue / 8));
-	int aux = 0;
-	
-	for (int i = 0; i < numBytes; i++) {
-		
-		setBitsByByte(val, (uint8_t)(buffer[i]), 8, offset + (i * 8));
-	}
-	
-	aux = sizevalue - (numBytes * 8);
-	
-	setBitsByByte(val, (uint8_t)(buffer[numBytes]), aux, offset + (numBytes * 8));
+	Sunset_Bit_Stream::copyBits((unsigned char*)val, offset, (unsigned char*)buffer, 0, sizevalue);
 	
 	return;
 }
@@ -473,17 +420,7 @@ void Sunset_Utilities::setBits(char *val, char* buffer, int sizevalue, int offse
 
 void Sunset_Utilities::getBits(char *val, char* buffer, int sizevalue, int offset) 
 {
-	int numBytes = (int)(floor(sizevalue / 8));
-	int aux = 0;
-	
-	for (int i = 0; i < numBytes; i++) {
-		
-		getBitsByByte(val, (uint8_t&)(buffer[i]), 8, offset + (i * 8));
-	}
-	
-	aux = sizevalue - (numBytes * 8);
-	
-	getBitsByByte(val, (uint8_t&)(buffer[numBytes]), aux, offset + (numBytes * 8));
+	Sunset_Bit_Stream::copyBits((unsigned char*)buffer, 0, (unsigned char*)val, offset, sizevalue);
 	
 	return;
 }
@@ -505,7 +442,7 @@ int Sunset_Utilities::setPriority(int prio)
 		switch(errno)  {
 				
 			case EACCES:
-				Sunset_Debug::debugInfo(-1, -1, "Sunset_Utilities::setPriority Permission Denied! - Check the root permission");
+				SUNSET_DEBUG_LOG(-1, -1, "Sunset_Utilities::setPriority Permission Denied! - Check the root permission");
 				
 				break;
 				
@@ -519,6 +456,67 @@ int Sunset_Utilities::setPriority(int prio)
 	return res;
 }
 
+/*!
+ * 	@brief  The setRealTimePriority function sets the SCHED_FIFO policy with priority "prio" for the calling thread. 
+ *	If prio is 0 the default time-sharing policy is restored.
+ * 	@param prio The real-time priority to be set (1-99).
+ * 	@retval res The pthread_setschedparam result.
+ */
+
+int Sunset_Utilities::setRealTimePriority(int prio) 
+{
+	struct sched_param param;
+	int policy = (prio > 0) ? SCHED_FIFO : SCHED_OTHER;
+	int res;
+	
+	memset(&param, 0, sizeof(param));
+	param.sched_priority = prio;
+	
+	res = pthread_setschedparam(pthread_self(), policy, &param);
+	
+	if ( res != 0 ) {
+		
+		switch(res)  {
+				
+			case EPERM:
+				SUNSET_DEBUG_LOG(-1, -1, "Sunset_Utilities::setRealTimePriority Permission Denied! - Check the root permission");
+				
+				break;
+				
+			default:
+				SUNSET_DEBUG_LOG(-1, -1, "Sunset_Utilities::setRealTimePriority prio %d ERROR %s", prio, strerror(res));
+				
+				break;
+		}	
+	}
+	
+	return res;
+}
+
+/*!
+ * 	@brief  The setCpuAffinity function binds the calling thread to a given CPU.
+ * 	@param cpu The CPU ID.
+ * 	@retval res The pthread_setaffinity_np result.
+ */
+
+int Sunset_Utilities::setCpuAffinity(int cpu) 
+{
+	cpu_set_t set;
+	int res;
+	
+	CPU_ZERO(&set);
+	CPU_SET(cpu, &set);
+	
+	res = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &set);
+	
+	if ( res != 0 ) {
+		
+		SUNSET_DEBUG_LOG(-1, -1, "Sunset_Utilities::setCpuAffinity cpu %d ERROR %s", cpu, strerror(res));
+	}
+	
+	return res;
+}
+
 /*!
  * 	@brief  The getPriority function gets the priority of the current process.
  * 	@retval prio The priority of the current process.
@@ -643,7 +641,7 @@ int Sunset_Utilities::my_pkt_size (int size)
 int Sunset_Utilities::my_max_pkt_size()
 {
 	
-	Sunset_Debug::debugInfo(4, -1, "Sunset_Utilities::my_max_pkt_size val %d", MAX_PKT_SIZE);
+	SUNSET_DEBUG_LOG(4, -1, "Sunset_Utilities::my_max_pkt_size val %d", MAX_PKT_SIZE);
 
 	return MAX_PKT_SIZE;  
 }
@@ -656,7 +654,7 @@ void Sunset_Utilities::start()
 { 	
 	if ( instance_ == NULL ) {
 	
-		Sunset_Debug::debugInfo(-1, -1, "azzo!\n");
+		SUNSET_DEBUG_LOG(-1, -1, "azzo!\n");
 		exit(0);
 	}
 	
@@ -32,9 +32,11 @@
 #include <sys/resource.h>
 #include <errno.h>
 #include <pthread.h>
+#include <sched.h>
 
 #include "packet.h"
 #include <sunset_debug.h>
+#include "sunset_bit_stream.h"
 
 #define EPSILON_HIGH 		0.00001
 #define EPSILON_MEDIUM 		1e-3
@@ -162,7 +164,7 @@ public:
 	static void getBitByOff(unsigned char *, int32_t &, int, int);
 	
 	/*!
-	 * 	@brief This writes "sizevalue" bits of "buffer" inside "val" starting at the "offset" position. Users have to avoid the truncation of useful information. This can happen if sizeval is lower than the number of bits needed to correctly represent buffer, i.e. when negative numbers are used and the sign bit is not stored. 
+	 * 	@brief This writes "sizevalue" bits of "buffer" inside "val" starting at the "offset" position. The bits are moved using 64-bit words (see Sunset_Bit_Stream). Users have to avoid the truncation of useful information. This can happen if sizeval is lower than the number of bits needed to correctly represent buffer, i.e. when negative numbers are used and the sign bit is not stored. 
 	 */
 	static void setBits (char *val, char* buffer, int sizevalue, int offset);
 	
@@ -196,6 +198,16 @@ public:
 	static int setPriority(int );
 	static int getPriority();
 	
+	/*!
+	 * 	@brief  This function sets the real-time (SCHED_FIFO) priority "prio" for the calling thread, 0 restores the default policy.
+	 */
+	static int setRealTimePriority(int prio);
+	
+	/*!
+	 * 	@brief  This function binds the calling thread to the CPU "cpu".
+	 */
+	static int setCpuAffinity(int cpu);
+	
 	/*!
 	 * 	@brief The get_now function returns the simulation/emulation time from the beginning of the experiment. 
 	 */
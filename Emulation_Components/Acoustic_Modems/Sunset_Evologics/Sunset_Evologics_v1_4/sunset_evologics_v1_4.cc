@@ -22,7 +22,6 @@
 #include "sunset_evologics_v1_4.h"
 #include "sunset_evologics_commands.h"
 
-pthread_mutex_t mutex_evo_1_4_timer_rx;
 pthread_mutex_t mutex_evo_1_4_timer_connection;
 
 /*!
@@ -45,7 +44,8 @@ public:
 
 Sunset_Evologics_v1_4::Sunset_Evologics_v1_4()  : Sunset_Generic_Modem(), 
 connectionTimer_(this), timeoutTimer_(this), timeoutDeliv_(this), 
-timeoutBurstResp_(this), rttTimer_(this), rangingTimer_(this), rxTimer_(this)
+timeoutBurstResp_(this), rttTimer_(this), rangingTimer_(this), rxTimer_(this),
+rxChannel_(EV_BUFSIZE)
 {
 	evo_conn = 0;
 	EV_BROADCAST = 255;
@@ -55,7 +55,8 @@ timeoutBurstResp_(this), rttTimer_(this), rangingTimer_(this), rxTimer_(this)
 	EV_USE_ACK = 0;
 	tx_time = 0.0;
 	
-	pthread_mutex_init(&mutex_evo_1_4_timer_rx, NULL);
+	rxChannel_.setHandler(&rxTimer_);
+	
 	pthread_mutex_init(&mutex_evo_1_4_timer_connection, NULL);
 	
 	bind("EV_BROADCAST", &EV_BROADCAST);
@@ -83,12 +84,11 @@ timeoutBurstResp_(this), rttTimer_(this), rangingTimer_(this), rxTimer_(this)
 Sunset_Evologics_v1_4::~Sunset_Evologics_v1_4() 
 {
 	
-	pthread_mutex_destroy(&mutex_evo_1_4_timer_rx);
 	pthread_mutex_destroy(&mutex_evo_1_4_timer_connection);
 	
 	if ( close_connection() == false ) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::~Sunset_Evologics_v1_4 Cannot close socket fd");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::~Sunset_Evologics_v1_4 Cannot close socket fd");
 	}
 }
 
@@ -126,14 +126,14 @@ bool Sunset_Evologics_v1_4::startRanging()
 	
 	if (evo_conn == 0 || connectionTimer_.busy()) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::startRanging connection ERROR");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::startRanging connection ERROR");
 		
 		return false;
 	}
 	
 	if (is_ranging == false) { // the node does not support ranging
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::startRanging not set");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::startRanging not set");
 		
 		return false;
 	}
@@ -147,7 +147,7 @@ bool Sunset_Evologics_v1_4::startRanging()
 			return false;
 		}
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::startRanging running");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::startRanging running");
 		
 		return false;
 	}
@@ -181,10 +181,10 @@ int Sunset_Evologics_v1_4::command( int argc, const char * const * argv )
 				memset(socketIpAddress, '\0', EV_MAX_IP_LEN);
 				snprintf(socketIpAddress, EV_MAX_IP_LEN, "%s", argv[3]);
 				
-				Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Evologics_v1_4::command socketIpAddress %s", socketIpAddress);	
+				SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Evologics_v1_4::command socketIpAddress %s", socketIpAddress);	
 				socketPort = atoi(argv[4]);
 				
-				Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_4 socketPort %d", socketPort);
+				SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_4 socketPort %d", socketPort);
 				evo_conn = new Sunset_Evologics_Conn(socketIpAddress, socketPort);
 				
 				return TCL_OK;		      
@@ -224,7 +224,7 @@ int Sunset_Evologics_v1_4::command( int argc, const char * const * argv )
 			
 			int bAddr = atoi(argv[2]);
 			
-			Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_4 setBroadcast addr %d", bAddr);
+			SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_4 setBroadcast addr %d", bAddr);
 			
 			EV_BROADCAST = bAddr;
 			
@@ -238,13 +238,13 @@ int Sunset_Evologics_v1_4::command( int argc, const char * const * argv )
 			
 			if (range_dest < 0 || range_dest == getModuleAddress()) {
 				
-				Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4 startRanging ERROR dest %d", range_dest);
+				SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4 startRanging ERROR dest %d", range_dest);
 				
 				return TCL_OK;
 				
 			}
 			
-			Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_4 startRanging %d time %f", range_dest, rangingTime);
+			SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_4 startRanging %d time %f", range_dest, rangingTime);
 			
 			startRanging();
 			
@@ -256,7 +256,7 @@ int Sunset_Evologics_v1_4::command( int argc, const char * const * argv )
 			
 			useBurst = atoi(argv[2]);
 			
-			Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_4 useBurst %d", useBurst);
+			SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_4 useBurst %d", useBurst);
 			
 			return TCL_OK;
 		}
@@ -271,11 +271,11 @@ int Sunset_Evologics_v1_4::command( int argc, const char * const * argv )
 			
 			rangingTime = atof(argv[3]);
 			
-			Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_4 startRanging %d time %f", range_dest, rangingTime);
+			SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_4 startRanging %d time %f", range_dest, rangingTime);
 			
 			if (rangingTime <= 0.0 || range_dest < 0 || range_dest == getModuleAddress()) {
 				
-				Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4 startRanging ERROR dest %d time %f", range_dest, rangingTime);
+				SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4 startRanging ERROR dest %d time %f", range_dest, rangingTime);
 				
 				return TCL_OK;
 				
@@ -333,7 +333,7 @@ int Sunset_Evologics_v1_4::startConnection() {
 	
 	int res = connect();
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_4::startConnection res  %d", res);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_4::startConnection res  %d", res);
 	
 	return res;
 	
@@ -350,7 +350,7 @@ int Sunset_Evologics_v1_4::stopConnection() {
 	
 	listening = 0;
 	
-	Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Evologics_v1_4::stopConnection res %d", res);
+	SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Evologics_v1_4::stopConnection res %d", res);
 	
 	return res;
 }
@@ -368,7 +368,7 @@ double Sunset_Evologics_v1_4::getTransfertTime(int size)
 	
 	time = (size * 8.0) / 1000000.0;
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_4::getTransfertTime size %d time %f", size, time);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_4::getTransfertTime size %d time %f", size, time);
 	
 	return time;
 }
@@ -384,12 +384,12 @@ double Sunset_Evologics_v1_4::getTxTime(int size)
 	
 	if (dataRate < 0.0) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::getTxTime dataRate %f ERROR", dataRate);
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::getTxTime dataRate %f ERROR", dataRate);
 		//		return 1;
 		exit(1);
 	}		
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_4::getTxTime size %d dataRate %f", size, dataRate);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_4::getTxTime size %d dataRate %f", size, dataRate);
 	
 	return (size * 8.0) / dataRate;
 }
@@ -413,7 +413,7 @@ int Sunset_Evologics_v1_4::connect()
 		timeoutTimer_.stop();
 	}
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_4::connect starting connection");
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_4::connect starting connection");
 	
 	res = start_connection();
 	
@@ -423,7 +423,7 @@ int Sunset_Evologics_v1_4::connect()
 		
 	} else {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::connect Cannot connect to %s:%d", evo_conn->get_ip(), evo_conn->get_port());
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::connect Cannot connect to %s:%d", evo_conn->get_ip(), evo_conn->get_port());
 		
 		pthread_mutex_lock(&mutex_evo_1_4_timer_connection);
 		
@@ -456,15 +456,15 @@ int Sunset_Evologics_v1_4::connect()
 		}
 	}
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_4::connect connecting fd = %d", x);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_4::connect connecting fd = %d", x);
 	
 	res = start_listener();
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_4::connect connecting start_listener");
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_4::connect connecting start_listener");
 	
 	if (!res) {
 		
-		Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_4::connect CANNOT  start_listener");
+		SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_4::connect CANNOT  start_listener");
 		return 0;
 	}
 	
@@ -503,11 +503,11 @@ bool Sunset_Evologics_v1_4::modem_setting()
 				
 			case EV_SET_POWER:
 				
-				Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_4::checkSetting() setting modem power");					
+				SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_4::checkSetting() setting modem power");					
 				
 				if ( set_modem_power(setting_cmd.front().value) == false ) {
 					
-					Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::modem_setting error setting power");
+					SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::modem_setting error setting power");
 				
 					return false;
 				}
@@ -516,11 +516,11 @@ bool Sunset_Evologics_v1_4::modem_setting()
 				
 			case EV_SET_ADDR:
 				
-				Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_4::checkSetting() setting modem address");					
+				SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_4::checkSetting() setting modem address");					
 				
 				if ( set_local_address(setting_cmd.front().value) == false ) {
 					
-					Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::modem_setting error setting address");					
+					SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::modem_setting error setting address");					
 					
 					return false;
 				}
@@ -529,11 +529,11 @@ bool Sunset_Evologics_v1_4::modem_setting()
 				
 			case EV_SET_PROMISCOUS:
 				
-				Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_4::checkSetting() setting modem promiscous mode");					
+				SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_4::checkSetting() setting modem promiscous mode");					
 				
 				if ( set_promiscous_mode(setting_cmd.front().value) == false ) {
 					
-					Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::modem_setting error setting promiscous mode");					
+					SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::modem_setting error setting promiscous mode");					
 					
 					return false;
 				}
@@ -571,7 +571,7 @@ void Sunset_Evologics_v1_4::checkSetting()
 	
 	if ( modem_setting() == true ) {
 		
-		Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_4::checkSetting() all settings done");					
+		SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_4::checkSetting() all settings done");					
 		
 		setState(EV_IDLE);
 	}
@@ -664,7 +664,7 @@ bool Sunset_Evologics_v1_4::set_modem_power(int power)
 	
 	setState(EV_SETTING);
 	
-	Sunset_Debug::debugInfo(1, getModuleAddress(), "Sunset_Evologics_v1_4::set_modem_power  mando %s\n", msg);
+	SUNSET_DEBUG_LOG(1, getModuleAddress(), "Sunset_Evologics_v1_4::set_modem_power  mando %s\n", msg);
 	
 	if ( evo_conn->write_data(msg, strlen(msg)) == false ) {
 		
@@ -717,12 +717,12 @@ bool Sunset_Evologics_v1_4::start_listener()
 	
 	if ( ret ) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::start_listener Cannot create thread - exiting");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::start_listener Cannot create thread - exiting");
 		
 		return false;
 		
 	}
-	Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::start_listener  create thread - DONE");
+	SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::start_listener  create thread - DONE");
 	
 	return true;
 }
@@ -748,7 +748,7 @@ void Sunset_Evologics_v1_4::resetTx()
 {
 	int check = 0;
 	
-	Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::resetTx");
+	SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::resetTx");
 	
 	if (!pktTxList.empty()){
 		
@@ -757,7 +757,7 @@ void Sunset_Evologics_v1_4::resetTx()
 		check = 1;
 	}
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Evologics_v1_4::resetTx exit");
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Evologics_v1_4::resetTx exit");
 	
 	if (check) {
 		
@@ -776,7 +776,7 @@ void Sunset_Evologics_v1_4::resetTx()
 void Sunset_Evologics_v1_4::pktReceived(char* buffer, int len) 
 {
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_4::pktReceived sendUp");
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_4::pktReceived sendUp");
 	
 	Sunset_Generic_Modem::pktReceived(buffer, len);
 	
@@ -795,7 +795,7 @@ void Sunset_Evologics_v1_4::pktReceived(int src, int dst, char* buffer, int len)
 {
 	Packet* p;
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_4::pktReceived sendUp");
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_4::pktReceived sendUp");
 	
 	if (dst == EV_BROADCAST) {
 		
@@ -822,7 +822,7 @@ void Sunset_Evologics_v1_4::pktReceived(int src, int dst, char* buffer, int len)
 		SUNSET_HDR_CMN(p)->timestamp = (distanceToNode[src]).second;
 	}
 	
-	Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Evologics_v1_4::pktReceived sendUp");
+	SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Evologics_v1_4::pktReceived sendUp");
 	
 	pktRxList.push_back(p);
 	
@@ -853,12 +853,12 @@ char* Sunset_Evologics_v1_4::pktWrite(Packet* p, int& len)
 	
 	if( dataLen <= 0 || bufferData == NULL ) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::pktWrite no bufferData  ERROR");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::pktWrite no bufferData  ERROR");
 		
 		return NULL;
 	}
 	
-	Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::pktWrite len %d", dataLen);
+	SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::pktWrite len %d", dataLen);
 	len = dataLen;
 	
 	return bufferData;
@@ -892,7 +892,7 @@ void Sunset_Evologics_v1_4::sendDown(Packet *p)
 	
 	if (evo_conn == 0 || connectionTimer_.busy()) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::sendDown packet with connection ERROR");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::sendDown packet with connection ERROR");
 		
 		txAborted();
 		
@@ -901,7 +901,7 @@ void Sunset_Evologics_v1_4::sendDown(Packet *p)
 	
 	if (src != getModuleAddress()) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::sendDown packet with src %d ERROR", src);
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::sendDown packet with src %d ERROR", src);
 		
 		txAborted();
 		
@@ -910,7 +910,7 @@ void Sunset_Evologics_v1_4::sendDown(Packet *p)
 	
 	if (getState() == EV_RANGING) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::sendDown packet RANGING running");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::sendDown packet RANGING running");
 		
 		txAborted();
 		
@@ -922,7 +922,7 @@ void Sunset_Evologics_v1_4::sendDown(Packet *p)
 		dst = EV_BROADCAST;
 	}
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Evologics_v1_4::sendDown packet with src %d dst %d MAC_BROADCAST %d EV_BROADCAST %d", src, dst, Sunset_Address::getBroadcastAddress(), EV_BROADCAST);
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Evologics_v1_4::sendDown packet with src %d dst %d MAC_BROADCAST %d EV_BROADCAST %d", src, dst, Sunset_Address::getBroadcastAddress(), EV_BROADCAST);
 	
 	
 	if (getState() != EV_IDLE && getState() != EV_SETTING) {
@@ -938,17 +938,17 @@ void Sunset_Evologics_v1_4::sendDown(Packet *p)
 		
 		setState(EV_IDLE);
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::sendDown MALLOC ERROR");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::sendDown MALLOC ERROR");
 		
 		return;
 	}
 	
 	for (int i = 0; i < len; i++) {
 		
-		Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_4::sendDown sending DOWN(%d) = %x", i, buffer[i]);
+		SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_4::sendDown sending DOWN(%d) = %x", i, buffer[i]);
 	}
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Evologics_v1_4::sendDown packet len %d is_ranging %d buffer %s check %d", len, is_ranging, (char*)buffer, strlen(buffer));
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Evologics_v1_4::sendDown packet len %d is_ranging %d buffer %s check %d", len, is_ranging, (char*)buffer, strlen(buffer));
 	
 	if (useBurst) {
 		
@@ -958,7 +958,7 @@ void Sunset_Evologics_v1_4::sendDown(Packet *p)
 			
 			txAborted();
 			
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::sendDown cannot write BURST data to the modem ERROR");
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::sendDown cannot write BURST data to the modem ERROR");
 		}
 	}
 	else {
@@ -966,7 +966,7 @@ void Sunset_Evologics_v1_4::sendDown(Packet *p)
 			
 			if(!(send_data_im(buffer, len, dst, (char*)EV_ACK))) {
 				
-				Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::sendDown cannot write data to the modem with ACK ERROR");
+				SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::sendDown cannot write data to the modem with ACK ERROR");
 				
 				setState(EV_IDLE);
 				
@@ -977,7 +977,7 @@ void Sunset_Evologics_v1_4::sendDown(Packet *p)
 			
 			if(!(send_data_im(buffer, len, dst, (char*)EV_NO_ACK))) {
 				
-				Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::sendDown cannot write data to the modem ERROR");
+				SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::sendDown cannot write data to the modem ERROR");
 				
 				setState(EV_IDLE);
 				
@@ -986,7 +986,7 @@ void Sunset_Evologics_v1_4::sendDown(Packet *p)
 		}		
 	}	
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Evologics_v1_4::sendDown packet len %d buffer %s check %d state %d", len, (char*)buffer, strlen(buffer), getState());
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Evologics_v1_4::sendDown packet len %d buffer %s check %d state %d", len, (char*)buffer, strlen(buffer), getState());
 	
 	free(buffer);
 	
@@ -1005,11 +1005,11 @@ void Sunset_Evologics_v1_4::txDone()
 	
 	Packet* p;
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Evologics_v1_4::txDone");
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Evologics_v1_4::txDone");
 	
 	if (pktTxList.empty()) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::txDone - " "Something is wrong with tx %d ERROR", (int)(pktTxList.size()));
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::txDone - " "Something is wrong with tx %d ERROR", (int)(pktTxList.size()));
 		
 		return;
 	}
@@ -1025,7 +1025,7 @@ void Sunset_Evologics_v1_4::txDone()
 	
 	Modem2PhyEndTx(p);
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Evologics_v1_4::txDone tx %d", (int)(pktTxList.size()));
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Evologics_v1_4::txDone tx %d", (int)(pktTxList.size()));
 	
 	return;
 }
@@ -1042,7 +1042,7 @@ void Sunset_Evologics_v1_4::txAborted()
 	
 	if (pktTxList.empty()) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::txAborted - " "Something is wrong with pktList tx %d ERROR", (int)(pktTxList.size()));
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::txAborted - " "Something is wrong with pktList tx %d ERROR", (int)(pktTxList.size()));
 		
 		return;
 	}
@@ -1058,7 +1058,7 @@ void Sunset_Evologics_v1_4::txAborted()
 	
 	Modem2PhyTxAborted(p);
 	
-	Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::txAborted tx %d", (int)(pktTxList.size()));
+	SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::txAborted tx %d", (int)(pktTxList.size()));
 	
 	return;
 }
@@ -1082,26 +1082,28 @@ void Sunset_Evologics_v1_4::rxAborted()
 
 void Sunset_Evologics_v1_4::RxIterate(Sunset_Evologics_Conn *p) 
 {	
-	char recvb[EV_BUFSIZE];
+	char* recvb = 0;
+	int type = 0;
 	int len = 0;
 	
 	int check = 0;
 	
 	while(listening) {
 		
-		pair<char*, int > rp;
+		len = evo_conn->read_message(&recvb, &type, EV_BUFSIZE);
 		
-		memset(recvb, 0x0, EV_BUFSIZE);
-		
-		len = evo_conn->read_data(recvb, EV_BUFSIZE);
+		if (len == 0) {
+			
+			continue;	// timeout expired, check if the listener has been stopped
+		}
 		
-		Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Evologics_v1_4::RxIterate len %d %s", len, recvb);
+		SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Evologics_v1_4::RxIterate len %d %s", len, (len > 0) ? recvb : "");
 		
 		switch(len) {
 				
 			case EV_READ_NO_CLIENT:
 				
-				Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::RxIterate Client read 0 bytes");
+				SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::RxIterate Client read 0 bytes");
 				
 				check = 1;
 				
@@ -1109,7 +1111,7 @@ void Sunset_Evologics_v1_4::RxIterate(Sunset_Evologics_Conn *p)
 				
 			case EV_READ_ERR:
 				
-				Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::RxIterate Read error");
+				SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::RxIterate Read error");
 				
 				check = 1;
 				
@@ -1117,7 +1119,7 @@ void Sunset_Evologics_v1_4::RxIterate(Sunset_Evologics_Conn *p)
 				
 			case EV_READ_BUF_MAX:
 				
-				Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::RxIterate Buffer limit reached");
+				SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::RxIterate Buffer limit reached");
 				
 				setState(EV_IDLE);
 				
@@ -1127,40 +1129,17 @@ void Sunset_Evologics_v1_4::RxIterate(Sunset_Evologics_Conn *p)
 				break;
 		}
 		
-		Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Evologics_v1_4::RxIterate state %d IDLE %d received %s len %d", getState(), getState() == EV_IDLE, recvb, len);
+		SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Evologics_v1_4::RxIterate state %d IDLE %d received %s len %d", getState(), getState() == EV_IDLE, recvb, len);
 		
 		if (check) {
 			
 			break;			
 		}
 		
-		rp.first = (char*) malloc (len+1);
-		
-		if ( rp.first == NULL ) {
-			
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::RxIterate rp.first NULL EXIT");
-			
-			exit(1);
-		}
-		
-		rp.second = len;
-		
-		memset (rp.first, 0x0, len+1);
-		memcpy(rp.first, recvb, len);
-		
-		pthread_mutex_lock(&mutex_evo_1_4_timer_rx);
-		
-		rx_info.push_back (rp);
-		
-		pthread_mutex_unlock(&mutex_evo_1_4_timer_rx);
-		
-		if (!(rxTimer_.busy())) {
-			
-			rxTimer_.start(0.0001); // post event to notify the main thread ro process the received information	
-		}
+		rxChannel_.push(recvb, len, NOW, type); // notify the main thread to process the received information
 	}
 	
-	Sunset_Debug::debugInfo(1, getModuleAddress(), "Sunset_Evologics_v1_4::RxIterate exit");
+	SUNSET_DEBUG_LOG(1, getModuleAddress(), "Sunset_Evologics_v1_4::RxIterate exit");
 	
 	listening = 0;
 
@@ -1185,40 +1164,33 @@ void Sunset_Evologics_v1_4::RxIterate(Sunset_Evologics_Conn *p)
 
 bool Sunset_Evologics_v1_4::processRxInfo() 
 {
-	pair<char*, int > rp;
+	sunset_rx_slot* rp = 0;
 	int len = 0;
-	char recvb[EV_BUFSIZE]; 
-	
-	pthread_mutex_lock(&mutex_evo_1_4_timer_rx);
+	char recvb[EV_BUFSIZE];
+	int type = 0;
 	
-	if (rx_info.empty()) {
+	rp = rxChannel_.front();
 	
-		pthread_mutex_unlock(&mutex_evo_1_4_timer_rx);
+	if (rp == 0) {
 		
 		return false;
 	} 
 	
-	rp = rx_info.front();
-	
-	rx_info.pop_front();
-	
-	pthread_mutex_unlock(&mutex_evo_1_4_timer_rx);
-	
-	len = rp.second;
+	len = rp->len;
+	type = rp->tag;	// message type computed by the listener thread
 	
-	memset(recvb, 0x0, EV_BUFSIZE);
-	memcpy(recvb, rp.first, rp.second);    
+	memcpy(recvb, rp->data, len + 1);	// the slot data is '\0' terminated
 	
-	free(rp.first);
+	rxChannel_.pop();
 	
 	if (getState() == EV_RANGING) { 
 		
-		if ( strcmp(recvb, EV_OK) == 0 || strcmp(recvb, EV_OK2) == 0 ) {
+		if ( type == EV_MSG_OK ) {
 			
 			return true;
 		}
 		
-		if (strncmp(recvb, EV_DELIVEREDIM, strlen(EV_DELIVEREDIM)) == 0 ) { 
+		if (type == EV_MSG_DELIVEREDIM ) { 
 			
 			if (rttTimer_.busy()) {
 				
@@ -1231,11 +1203,10 @@ bool Sunset_Evologics_v1_4::processRxInfo()
 			
 		}
 		
-		if (strncmp(recvb, EV_FAILED, strlen(EV_FAILED)) == 0 ||
-		    strcmp(recvb, EV_BUSY) == 0 || strcmp(recvb, EV_ERROR_WRONG_FORMAT) == 0 ||
-		    strncmp(recvb, EV_RECVIM, strlen(EV_RECVIM)) == 0 ||
-		    strncmp(recvb, EV_RECV, strlen(EV_RECV)) == 0 ||
-		    strncmp(recvb, EV_RECV, strlen(EV_FAILEDIM)) == 0) { 
+		if (Sunset_Evologics_Parser::isFailed(type) ||
+		    type == EV_MSG_BUSY || type == EV_MSG_ERROR_WRONG_FORMAT ||
+		    Sunset_Evologics_Parser::isRecvIm(type) ||
+		    Sunset_Evologics_Parser::isRecv(type)) { 
 			
 			if (timeoutTimer_.busy()) {
 				
@@ -1249,7 +1220,7 @@ bool Sunset_Evologics_v1_4::processRxInfo()
 			
 			if (rangingTime > 0.0 && range_dest != -1 ) {
 				
-				Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_4::processRxInfo RANGING startTimer");
+				SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_4::processRxInfo RANGING startTimer");
 				
 				setState(EV_IDLE);
 				
@@ -1269,7 +1240,7 @@ bool Sunset_Evologics_v1_4::processRxInfo()
 			timeoutTimer_.stop();
 		}	
 		
-		Sunset_Debug::debugInfo(2, getModuleAddress(), "(%f) (%d) (%d) _DELAY_ %s us", Sunset_Utilities::get_epoch(), getModuleAddress(), range_dest, recvb);
+		SUNSET_DEBUG_LOG(2, getModuleAddress(), "(%f) (%d) (%d) _DELAY_ %s us", Sunset_Utilities::get_epoch(), getModuleAddress(), range_dest, recvb);
 		
 		setDelayToNode(range_dest, atof(recvb));
 		
@@ -1284,7 +1255,7 @@ bool Sunset_Evologics_v1_4::processRxInfo()
 				
 				if (rangingTime > 0.0 && range_dest != -1 ) {
 					
-					Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_4::processRxInfo RANGING startTimer");
+					SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_4::processRxInfo RANGING startTimer");
 					
 					setState(EV_IDLE);
 					
@@ -1302,7 +1273,7 @@ bool Sunset_Evologics_v1_4::processRxInfo()
 		
 	}
 	
-	if ( strcmp(recvb, EV_OK) == 0 || strcmp(recvb, EV_OK2) == 0 ) {
+	if ( type == EV_MSG_OK ) {
 		
 		/* checking if the setting command has been executed */
 		
@@ -1336,11 +1307,11 @@ bool Sunset_Evologics_v1_4::processRxInfo()
 				timeoutTimer_.stop();
 			}
 			
-			Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Evologics_v1_4::processRxInfo Sending status request");
+			SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Evologics_v1_4::processRxInfo Sending status request");
 			
 			setState(EV_WAIT_DATA_STATUS);
 			
-			Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Evologics_v1_4::processRxInfo Waiting status response");
+			SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Evologics_v1_4::processRxInfo Waiting status response");
 			
 			if (timeoutDeliv_.busy()) {
 				
@@ -1349,13 +1320,13 @@ bool Sunset_Evologics_v1_4::processRxInfo()
 			
 			if (deliveryRetry == 0 && tx_time > 0.0) {
 				
-				Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Evologics_v1_4::processRxInfo delivery timeout tx_time %f deliveryRetry %d", tx_time, deliveryRetry);
+				SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Evologics_v1_4::processRxInfo delivery timeout tx_time %f deliveryRetry %d", tx_time, deliveryRetry);
 				
 				timeoutDeliv_.start(tx_time);
 			} 
 			else {
 				
-				Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Evologics_v1_4::processRxInfo delivery timeout %f deliveryRetry %d", EV_TIMEOUT_DLV, deliveryRetry);
+				SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Evologics_v1_4::processRxInfo delivery timeout %f deliveryRetry %d", EV_TIMEOUT_DLV, deliveryRetry);
 				
 				timeoutDeliv_.start(EV_TIMEOUT_DLV);		
 			}
@@ -1380,20 +1351,20 @@ bool Sunset_Evologics_v1_4::processRxInfo()
 			return true;
 		}
 		
-	} else	if (strncmp(recvb, EV_RECVFAILED, strlen(EV_RECVFAILED)) == 0 ) { 
+	} else	if (type == EV_MSG_RECVFAILED ) { 
 		
 		if ( getState() == EV_INITIAL_STATE ) {
 			
 			return true;
 		}
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::processRxInfo EV_RECVFAILED");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::processRxInfo EV_RECVFAILED");
 		
 		rxFailed(recvb+strlen(EV_RECVFAILED)+1, len - (strlen(EV_RECVFAILED)+1));
 		
 		return true;
 		
-	} else if (strcmp(recvb, EV_BUSY) == 0 || strcmp(recvb, EV_ERROR_WRONG_FORMAT) == 0 ) {
+	} else if (type == EV_MSG_BUSY || type == EV_MSG_ERROR_WRONG_FORMAT ) {
 		
 		/* if the modem is busy or the command format is wrong.. */
 		
@@ -1414,13 +1385,13 @@ bool Sunset_Evologics_v1_4::processRxInfo()
 			return true;
 		}
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::processRxInfo Waiting status BUSY");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::processRxInfo Waiting status BUSY");
 		
 		setState(EV_IDLE);
 		
 		txAborted();
 		
-	} else if ( strncmp(recvb, EV_RECVIM, strlen(EV_RECVIM)) == 0 ) {
+	} else if ( Sunset_Evologics_Parser::isRecvIm(type) ) {
 		
 		if ( getState() == EV_INITIAL_STATE ) {
 			
@@ -1429,7 +1400,7 @@ bool Sunset_Evologics_v1_4::processRxInfo()
 		
 		if ( getState() == EV_SETTING ) {
 			
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::processRxInfo2 SETTING STATE");
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::processRxInfo2 SETTING STATE");
 			
 			return true;	
 		}
@@ -1445,7 +1416,7 @@ bool Sunset_Evologics_v1_4::processRxInfo()
 				timeoutTimer_.stop();
 			}
 			
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::processRxInfo2 TX STATE", getState());
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::processRxInfo2 TX STATE", getState());
 			
 			setState(EV_IDLE);
 			
@@ -1475,7 +1446,7 @@ bool Sunset_Evologics_v1_4::processRxInfo()
 			
 			deliveryRetry = 0;
 			
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::processRxInfo2 TX STATE", getState());
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::processRxInfo2 TX STATE", getState());
 			
 			setState(EV_IDLE);
 			
@@ -1490,7 +1461,7 @@ bool Sunset_Evologics_v1_4::processRxInfo()
 				timeoutTimer_.stop();
 			}
 			
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::processRxInfo2 TX STATE", getState());
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::processRxInfo2 TX STATE", getState());
 			
 			setState(EV_IDLE);
 			
@@ -1506,7 +1477,7 @@ bool Sunset_Evologics_v1_4::processRxInfo()
 		return true;
 	}
 	
-	else if ( strncmp(recvb, EV_RECV, strlen(EV_RECV)) == 0 ) {
+	else if ( Sunset_Evologics_Parser::isRecv(type) ) {
 		
 		if ( getState() == EV_INITIAL_STATE ) {
 			
@@ -1515,7 +1486,7 @@ bool Sunset_Evologics_v1_4::processRxInfo()
 		
 		if ( getState() == EV_SETTING ) {
 			
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::processRxInfo3 SETTING STATE");
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::processRxInfo3 SETTING STATE");
 			
 			return true;	
 		}
@@ -1530,7 +1501,7 @@ bool Sunset_Evologics_v1_4::processRxInfo()
 				timeoutTimer_.stop();
 			}
 			
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::processRxInfo3 TX STATE", getState());
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::processRxInfo3 TX STATE", getState());
 			
 			setState(EV_IDLE);
 			
@@ -1548,7 +1519,7 @@ bool Sunset_Evologics_v1_4::processRxInfo()
 				timeoutBurstResp_.stop();
 			}
 			
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::processRxInfo3 TX STATE", getState());
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::processRxInfo3 TX STATE", getState());
 			
 			setState(EV_IDLE);
 			
@@ -1562,7 +1533,7 @@ bool Sunset_Evologics_v1_4::processRxInfo()
 				timeoutDeliv_.stop();
 			}
 			
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::processRxInfo3 TX STATE", getState());
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::processRxInfo3 TX STATE", getState());
 			
 			setState(EV_IDLE);
 			
@@ -1575,13 +1546,13 @@ bool Sunset_Evologics_v1_4::processRxInfo()
 		
 		rxDoneBurst(recvb+strlen(EV_RECV)+1, len - (strlen(EV_RECV)+1));
 		
-		Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Evologics_v1_4::processRxInfo RX_DONE_BURST");
+		SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Evologics_v1_4::processRxInfo RX_DONE_BURST");
 		
 		return true;
 	}
 	else if ( getState() == EV_WAIT_DATA_STATUS && 
 	
-		strncmp(recvb, EV_DELIVERING, strlen(EV_DELIVERING)) == 0 ) {
+		type == EV_MSG_DELIVERING ) {
 		
 		if (timeoutDeliv_.busy()) {
 			
@@ -1590,13 +1561,13 @@ bool Sunset_Evologics_v1_4::processRxInfo()
 		
 		if (deliveryRetry == 0 && tx_time > 0.0) {
 			
-			Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Evologics_v1_4::processRxInfo delivery timeout tx_time %f deliveryRetry %d", tx_time, deliveryRetry);
+			SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Evologics_v1_4::processRxInfo delivery timeout tx_time %f deliveryRetry %d", tx_time, deliveryRetry);
 			
 			timeoutDeliv_.start(tx_time);
 		} 
 		else {
 			
-			Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Evologics_v1_4::processRxInfo delivery timeout %f deliveryRetry %d", EV_TIMEOUT_DLV, deliveryRetry);
+			SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Evologics_v1_4::processRxInfo delivery timeout %f deliveryRetry %d", EV_TIMEOUT_DLV, deliveryRetry);
 			
 			timeoutDeliv_.start(EV_TIMEOUT_DLV);
 		}
@@ -1604,7 +1575,7 @@ bool Sunset_Evologics_v1_4::processRxInfo()
 		
 	} else if ( getState() == EV_WAIT_DATA_STATUS && 
 		   
-		strncmp(recvb, EV_EMPTY, strlen(EV_EMPTY)) == 0 ) {	
+		type == EV_MSG_EMPTY ) {	
 		
 		if (timeoutDeliv_.busy()) {
 			
@@ -1613,7 +1584,7 @@ bool Sunset_Evologics_v1_4::processRxInfo()
 		
 		deliveryRetry = 0;
 		
-		Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Evologics_v1_4::TX_DONE IDLE");
+		SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Evologics_v1_4::TX_DONE IDLE");
 		
 		setState(EV_IDLE);
 		
@@ -1621,7 +1592,7 @@ bool Sunset_Evologics_v1_4::processRxInfo()
 		
 	} 
 	else if ( getState() == EV_WAIT_DATA_STATUS && 
-		   strncmp(recvb, EV_FAILED, strlen(EV_FAILED)) == 0 ) {	
+		   Sunset_Evologics_Parser::isFailed(type) ) {	
 		
 		if (timeoutDeliv_.busy()) {
 			
@@ -1630,74 +1601,74 @@ bool Sunset_Evologics_v1_4::processRxInfo()
 		
 		deliveryRetry = 0;
 		
-		Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Evologics_v1_4::TX_ABORTED IDLE");
+		SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Evologics_v1_4::TX_ABORTED IDLE");
 				
 		setState(EV_IDLE);				
 
 		txAborted();
 	}
 	else if ( getState() == EV_WAIT_BURST_RESP && 
-		 strncmp(recvb, EV_DELIVERED, strlen(EV_DELIVERED)) == 0 ) {
+		 Sunset_Evologics_Parser::isDelivered(type) ) {
 		
 		if (timeoutBurstResp_.busy()) {
 			
 			timeoutBurstResp_.stop();
 		}
 		
-		Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Evologics_v1_4::TX_DONE2 IDLE");
+		SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Evologics_v1_4::TX_DONE2 IDLE");
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::processRxInfo3 TX STATE", getState());
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::processRxInfo3 TX STATE", getState());
 	
 		setState(EV_IDLE);	
 	
 		txDone();
 	}
 	else if ( getState() == EV_WAIT_BURST_RESP && 
-		 strncmp(recvb, EV_FAILED, strlen(EV_FAILED)) == 0 ) {
+		 Sunset_Evologics_Parser::isFailed(type) ) {
 		
 		if (timeoutBurstResp_.busy()) {
 			
 			timeoutBurstResp_.stop();
 		}
 		
-		Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Evologics_v1_4::TX_ABORTED2 IDLE");
+		SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Evologics_v1_4::TX_ABORTED2 IDLE");
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::processRxInfo3 TX STATE", getState());
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::processRxInfo3 TX STATE", getState());
 		
 		setState(EV_IDLE);
 		
 		txAborted();
 	}
-	else if ( strncmp(recvb, EV_DELIVEREDIM, strlen(EV_DELIVEREDIM)) == 0 && EV_USE_ACK == 1) {
+	else if ( type == EV_MSG_DELIVEREDIM && EV_USE_ACK == 1) {
 		
 		if (timeoutDeliv_.busy()) {
 			
 			timeoutDeliv_.stop();
 		}
 		
-		Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Evologics_v1_4::TX_DONE IDLE");
+		SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Evologics_v1_4::TX_DONE IDLE");
 		
 		setState(EV_IDLE);
 	
 		txDone();
 		
-		Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Evologics_v1_4::processRxInfo DELIVEREDIM %s", recvb);
+		SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Evologics_v1_4::processRxInfo DELIVEREDIM %s", recvb);
 		
 	}
-	else if ( strncmp(recvb, EV_FAILEDIM, strlen(EV_FAILEDIM)) == 0 && EV_USE_ACK == 1) {
+	else if ( type == EV_MSG_FAILEDIM && EV_USE_ACK == 1) {
 		
 		if (timeoutDeliv_.busy()) {
 			
 			timeoutDeliv_.stop();
 		}
 		
-		Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Evologics_v1_4::TX_ABORTED IDLE");
+		SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Evologics_v1_4::TX_ABORTED IDLE");
 		
 		setState(EV_IDLE);
 		
 		txAborted();
 		
-		Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Evologics_v1_4::processRxInfo DELIVEREDIM %s", recvb);
+		SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Evologics_v1_4::processRxInfo DELIVEREDIM %s", recvb);
 	}
 	else {
 		
@@ -1729,7 +1700,7 @@ void Sunset_Evologics_v1_4::setDelayToNode(int node, double delay_usec)
 	
 	if (sid == NULL) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::setDelayToNode DISPATCHER NOT DEFINED");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::setDelayToNode DISPATCHER NOT DEFINED");
 		
 		return;
 	}
@@ -1741,7 +1712,7 @@ void Sunset_Evologics_v1_4::setDelayToNode(int node, double delay_usec)
 	
 	if ( sid->assign_value(&delay, &ni1, sizeof(double)) == false) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::setDelayToNode ERROR ASSIGINING INFO %s", (ni1.info_name).c_str());
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::setDelayToNode ERROR ASSIGINING INFO %s", (ni1.info_name).c_str());
 		
 		return;
 		
@@ -1749,11 +1720,11 @@ void Sunset_Evologics_v1_4::setDelayToNode(int node, double delay_usec)
 	
 	if ( sid->set(getModuleAddress(), sid_id, ni1) == 0 ) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::setDelayToNode PROVIDING INFO %s NOT DEFINED", (ni1.info_name).c_str());
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::setDelayToNode PROVIDING INFO %s NOT DEFINED", (ni1.info_name).c_str());
 		
 	}
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Evologics_v1_4::setDelayToNode node %d delay %f distance %f", node, delay, distanceToNode[node].first);
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Evologics_v1_4::setDelayToNode node %d delay %f distance %f", node, delay, distanceToNode[node].first);
 }
 
 
@@ -1769,7 +1740,7 @@ bool Sunset_Evologics_v1_4::checkDeliveryStatus()
 	
 	memset(msg, 0x0, EV_BUFSIZE);
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_4::checkDeliveryStatus");
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_4::checkDeliveryStatus");
 	
 	snprintf(msg, EV_BUFSIZE, "%s%s", ATDI, EV_EOC);
 	
@@ -1805,14 +1776,14 @@ bool Sunset_Evologics_v1_4::send_data_im(char *data, int length, int device, cha
 	
 	if ( getState() != EV_IDLE ) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::send_data_im STATE ERROR %d", getState());
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::send_data_im STATE ERROR %d", getState());
 		
 		return false;
 	}
 	
 	if (length > EV_PACKET_LENGHT_IM) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::send_data_im length %d > EV_PACKET_LENGHT_IM ERROR", length);
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::send_data_im length %d > EV_PACKET_LENGHT_IM ERROR", length);
 		
 		return false;
 	}
@@ -1821,7 +1792,7 @@ bool Sunset_Evologics_v1_4::send_data_im(char *data, int length, int device, cha
 	
 	if ( device < 1 || device > EV_BROADCAST ) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::send_data_im Wrong destination id %d", device);
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::send_data_im Wrong destination id %d", device);
 		
 		return false;	
 	}
@@ -1845,14 +1816,14 @@ bool Sunset_Evologics_v1_4::send_data_im(char *data, int length, int device, cha
 	
 	timeoutTimer_.start(EV_TIMEOUT_CMD);
 	
-	Sunset_Debug::debugInfo(1, getModuleAddress(), "Sunset_Evologics_v1_4::TX_START");
-	Sunset_Debug::debugInfo(-1, getModuleAddress(), "SEND IM (slot,%d,power,%d,size,%d) --%s,%d,%d,%s--", mac_slot, current_tx_power, length, AT_SENDIM, length, device, flag);
+	SUNSET_DEBUG_LOG(1, getModuleAddress(), "Sunset_Evologics_v1_4::TX_START");
+	SUNSET_DEBUG_LOG(-1, getModuleAddress(), "SEND IM (slot,%d,power,%d,size,%d) --%s,%d,%d,%s--", mac_slot, current_tx_power, length, AT_SENDIM, length, device, flag);
 	
 	tx_time = getTxTime(length) + EV_TX_BASIC_TIME;
 	
 	if ( evo_conn->write_data(msg, total_len) == false ) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::send_data_im error writing");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::send_data_im error writing");
 		
 		setState(EV_IDLE);
 		
@@ -1863,7 +1834,7 @@ bool Sunset_Evologics_v1_4::send_data_im(char *data, int length, int device, cha
 		return false;
 	}
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Evologics_v1_4::send_data_im exit state %d total_len %d length %d tx_time %f", getState(), total_len, length, tx_time);
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Evologics_v1_4::send_data_im exit state %d total_len %d length %d tx_time %f", getState(), total_len, length, tx_time);
 	
 	return true;
 }
@@ -1885,7 +1856,7 @@ bool Sunset_Evologics_v1_4::send_data_imRTT()
 	
 	if (getState() != EV_IDLE && getState() != EV_RANGING) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::send_data_imRTT busy");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::send_data_imRTT busy");
 		
 		if (rangingTime > 0.0) {
 			
@@ -1909,7 +1880,7 @@ bool Sunset_Evologics_v1_4::send_data_imRTT()
 	
 	if (range_dest == -1) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::send_data_imRTT range may be stopped");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::send_data_imRTT range may be stopped");
 		
 		return false;
 	}
@@ -1920,7 +1891,7 @@ bool Sunset_Evologics_v1_4::send_data_imRTT()
 		
 	if (EV_RANGING_SIZE > EV_PACKET_LENGHT_IM) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::send_data_imRTT length %d > EV_PACKET_LENGHT_IM ERROR", EV_RANGING_SIZE);
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::send_data_imRTT length %d > EV_PACKET_LENGHT_IM ERROR", EV_RANGING_SIZE);
 		
 		return false;
 	}
@@ -1929,7 +1900,7 @@ bool Sunset_Evologics_v1_4::send_data_imRTT()
 	
 	if ( range_dest < 1 || range_dest > EV_BROADCAST ) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::send_data_imRTT Wrong destination id", range_dest);
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::send_data_imRTT Wrong destination id", range_dest);
 		
 		return false;
 		
@@ -2004,7 +1975,7 @@ bool Sunset_Evologics_v1_4::sendRTT_command()
 	
 	if ( getState() != EV_RANGING ) {
 		
-		Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Evologics_v1_4::sendRTT_command STATE ERROR %d", getState());
+		SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Evologics_v1_4::sendRTT_command STATE ERROR %d", getState());
 		
 		return false;
 	}
@@ -2024,7 +1995,7 @@ bool Sunset_Evologics_v1_4::sendRTT_command()
 		return false;
 	}
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Evologics_v1_4::sendRTT_command DONE");
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Evologics_v1_4::sendRTT_command DONE");
 	
 	if (timeoutTimer_.busy()) {
 	
@@ -2059,14 +2030,14 @@ bool Sunset_Evologics_v1_4::send_data_burst(char *data, int length, int device)
 	
 	if ( getState() != EV_IDLE ) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::send_data_im STATE ERROR %d", getState());
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::send_data_im STATE ERROR %d", getState());
 		
 		return false;
 	}
 	
 	if (length > EV_PACKET_LENGHT_IM) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::send_data_im length %d > EV_PACKET_LENGHT_IM ERROR", length);
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::send_data_im length %d > EV_PACKET_LENGHT_IM ERROR", length);
 		
 		return false;
 	}
@@ -2075,7 +2046,7 @@ bool Sunset_Evologics_v1_4::send_data_burst(char *data, int length, int device)
 	
 	if ( device < 1 || device > EV_BROADCAST ) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::send_data_im Wrong destination id %d", device);
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::send_data_im Wrong destination id %d", device);
 		
 		return false;
 		
@@ -2096,7 +2067,7 @@ bool Sunset_Evologics_v1_4::send_data_burst(char *data, int length, int device)
 	
 	if ( evo_conn->write_data(msg, total_len) == false ) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::send_data_burst error writing");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::send_data_burst error writing");
 		
 		setState(EV_IDLE);		
 		
@@ -2131,7 +2102,7 @@ void Sunset_Evologics_v1_4::rxDoneIm(char *data, int len)
 	char* aux_mem;
 	if ( aux == NULL ) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneIm MALLOC ERROR");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneIm MALLOC ERROR");
 		
 		exit(1);
 	}	
@@ -2139,20 +2110,20 @@ void Sunset_Evologics_v1_4::rxDoneIm(char *data, int len)
 	memset(aux, '\0', len+1);
 	memcpy(aux, data, len);
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Evologics_v1_4::RX_DONE IM");
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Evologics_v1_4::RX_DONE IM");
 	
 	
 	// <length>,<source address>,<destination address>,<flag>,<bitrate>,<rms>,<integrity>,
 	//       <propagation time>,<velocity>,<data>
 	// ex. EV_RECVIM,4,1,3,ack,3.0,1.0,2.0,3.4,5.3,ciaocciaocc
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneIm %s len %d - lenAll %d", data, strlen(data), len);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneIm %s len %d - lenAll %d", data, strlen(data), len);
 	
 	token = strtok_r(data, ",", &aux_mem);
 	
 	if (token == NULL) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneIm  ERROR read token 1");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneIm  ERROR read token 1");
 	
 		free(aux);
 		
@@ -2163,13 +2134,13 @@ void Sunset_Evologics_v1_4::rxDoneIm(char *data, int len)
 	
 	temp_im.length = atoi(token);
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneIm temp_im.length %d", temp_im.length);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneIm temp_im.length %d", temp_im.length);
 	
 	token = strtok_r(NULL, ",", &aux_mem);
 	
 	if (token == NULL) {
 	
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneIm  ERROR read token 2");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneIm  ERROR read token 2");
 	      	
 		free(aux);
 		
@@ -2180,13 +2151,13 @@ void Sunset_Evologics_v1_4::rxDoneIm(char *data, int len)
 	
 	temp_im.source = atoi(token);
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneIm temp_im.source %d", temp_im.source);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneIm temp_im.source %d", temp_im.source);
 	
 	token = strtok_r(NULL, ",", &aux_mem);
 	
 	if (token == NULL) {
 	
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneIm  ERROR read token 3");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneIm  ERROR read token 3");
 	      	
 		free(aux);
 		
@@ -2197,13 +2168,13 @@ void Sunset_Evologics_v1_4::rxDoneIm(char *data, int len)
 	
 	temp_im.destination = atoi(token);
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneIm temp_im.destination %d", temp_im.destination);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneIm temp_im.destination %d", temp_im.destination);
 	
 	token = strtok_r(NULL, ",", &aux_mem);
 	
 	if (token == NULL) {
 	
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneIm  ERROR read token 4");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneIm  ERROR read token 4");
 	      	
 		free(aux);
 		
@@ -2214,13 +2185,13 @@ void Sunset_Evologics_v1_4::rxDoneIm(char *data, int len)
 	
 	strncpy(temp_im.flag, token, strlen(token));
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneIm temp_im.flag %s", temp_im.flag);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneIm temp_im.flag %s", temp_im.flag);
 	
 	token = strtok_r(NULL, ",", &aux_mem);
 	
 	if (token == NULL) {
 	
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneIm  ERROR read token 5");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneIm  ERROR read token 5");
 	      	
 		free(aux);
 		
@@ -2231,13 +2202,13 @@ void Sunset_Evologics_v1_4::rxDoneIm(char *data, int len)
 	
 	temp_im.bitrate = atof(token);
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneIm temp_im.bitrate %f", temp_im.bitrate);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneIm temp_im.bitrate %f", temp_im.bitrate);
 	
 	token = strtok_r(NULL, ",", &aux_mem);
 	
 	if (token == NULL) {
 	
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneIm  ERROR read token 6");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneIm  ERROR read token 6");
 	      	
 		free(aux);
 		
@@ -2248,13 +2219,13 @@ void Sunset_Evologics_v1_4::rxDoneIm(char *data, int len)
 	
 	temp_im.rms = atof(token);
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneIm temp_im.rms %f", temp_im.rms);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneIm temp_im.rms %f", temp_im.rms);
 	
 	token = strtok_r(NULL, ",", &aux_mem);
 	
 	if (token == NULL) {
 	
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneIm  ERROR read token 7");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneIm  ERROR read token 7");
 	      	
 		free(aux);
 		
@@ -2265,13 +2236,13 @@ void Sunset_Evologics_v1_4::rxDoneIm(char *data, int len)
 	
 	temp_im.integrity = atof(token);
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneIm temp_im.integrity %f", temp_im.integrity);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneIm temp_im.integrity %f", temp_im.integrity);
 	
 	token = strtok_r(NULL, ",", &aux_mem);
 	
 	if (token == NULL) {
 	
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneIm  ERROR read token 8");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneIm  ERROR read token 8");
 	      	
 		free(aux);
 		
@@ -2282,13 +2253,13 @@ void Sunset_Evologics_v1_4::rxDoneIm(char *data, int len)
 	
 	temp_im.prop_time = atof(token);
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneIm temp_im.prop_time %f", temp_im.prop_time);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneIm temp_im.prop_time %f", temp_im.prop_time);
 	
 	token = strtok_r(NULL, ",", &aux_mem);
 	
 	if (token == NULL) {
 	
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneIm  ERROR read token 9");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneIm  ERROR read token 9");
 	      	
 		free(aux);
 		
@@ -2299,23 +2270,23 @@ void Sunset_Evologics_v1_4::rxDoneIm(char *data, int len)
 	
 	temp_im.velocity = atof(token);
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneIm temp_im.velocity %f", temp_im.velocity);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneIm temp_im.velocity %f", temp_im.velocity);
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneIm beforeData len %d temp_im.length %d", 
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneIm beforeData len %d temp_im.length %d", 
 				len, temp_im.length);
 	
 	memcpy(temp_im.data, (aux + len - temp_im.length), temp_im.length);
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneIm temp_im.data %s", temp_im.data);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneIm temp_im.data %s", temp_im.data);
 	
 	for (int i = 0; i < temp_im.length; i++) {
 		
-		Sunset_Debug::debugInfo(4, getModuleAddress(), "dat(%d) = %x", i, temp_im.data[i]);
+		SUNSET_DEBUG_LOG(4, getModuleAddress(), "dat(%d) = %x", i, temp_im.data[i]);
 	}
 	
-	Sunset_Debug::debugInfo(-1, getModuleAddress(), "RX IM (slot,%d,power,%d,size,%d) --EV_RECVIM,%d,%d,%d,%s,%f,%f,%f,%f,%f--", mac_slot, current_tx_power, temp_im.length, temp_im.length, temp_im.source, temp_im.destination, temp_im.flag, temp_im.bitrate, temp_im.rms, temp_im.integrity, temp_im.prop_time, temp_im.velocity);
+	SUNSET_DEBUG_LOG(-1, getModuleAddress(), "RX IM (slot,%d,power,%d,size,%d) --EV_RECVIM,%d,%d,%d,%s,%f,%f,%f,%f,%f--", mac_slot, current_tx_power, temp_im.length, temp_im.length, temp_im.source, temp_im.destination, temp_im.flag, temp_im.bitrate, temp_im.rms, temp_im.integrity, temp_im.prop_time, temp_im.velocity);
 	
-	Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneIm Received EV_RECVIM,%d,%d,%d,%s,%f,%f,%f,%f,%f,%s ", temp_im.length, temp_im.source, temp_im.destination, temp_im.flag, temp_im.bitrate, temp_im.rms, temp_im.integrity, temp_im.prop_time, temp_im.velocity, temp_im.data);
+	SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneIm Received EV_RECVIM,%d,%d,%d,%s,%f,%f,%f,%f,%f,%s ", temp_im.length, temp_im.source, temp_im.destination, temp_im.flag, temp_im.bitrate, temp_im.rms, temp_im.integrity, temp_im.prop_time, temp_im.velocity, temp_im.data);
 	
 	if (is_ranging == false || strcmp(temp_im.flag, EV_ACK) != 0 || temp_im.length != EV_RANGING_SIZE) {
 		
@@ -2336,7 +2307,7 @@ void Sunset_Evologics_v1_4::rxDoneIm(char *data, int len)
 void Sunset_Evologics_v1_4::rxFailed(char *data, int len) 
 {
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_4::rxFailed %s len %d - lenAll %d", data, strlen(data), len);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_4::rxFailed %s len %d - lenAll %d", data, strlen(data), len);
 	
 	return;
 }
@@ -2360,7 +2331,7 @@ void Sunset_Evologics_v1_4::rxDoneBurst(char *data, int len)
 	
 	if ( aux == NULL ) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneBurst MALLOC ERROR");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneBurst MALLOC ERROR");
 		return;
 		exit(1);
 	}	
@@ -2371,59 +2342,59 @@ void Sunset_Evologics_v1_4::rxDoneBurst(char *data, int len)
 	// <length>,<source address>,<destination address>,<bitrate>,<rssi>,
 	// <integrity>,<propagation time>,<velocity>,<data>
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneBurst %s len %d - lenAll %d", data, strlen(data), len);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneBurst %s len %d - lenAll %d", data, strlen(data), len);
 	
 	token = strtok_r(data, ",", &aux_mem);
 	temp_burst.length = atoi(token);
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneBurst temp_burst.length %d", temp_burst.length);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneBurst temp_burst.length %d", temp_burst.length);
 	
 	token = strtok_r(NULL, ",", &aux_mem);
 	temp_burst.source = atoi(token);
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneBurst temp_burst.source %d", temp_burst.source);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneBurst temp_burst.source %d", temp_burst.source);
 	
 	token = strtok_r(NULL, ",", &aux_mem);
 	temp_burst.destination = atoi(token);
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneBurst temp_burst.destination %d", temp_burst.destination);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneBurst temp_burst.destination %d", temp_burst.destination);
 	
 	token = strtok_r(NULL, ",", &aux_mem);
 	temp_burst.bitrate = atof(token);
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneBurst temp_burst.bitrate %f", temp_burst.bitrate);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneBurst temp_burst.bitrate %f", temp_burst.bitrate);
 	
 	token = strtok_r(NULL, ",", &aux_mem);
 	temp_burst.rms = atof(token);
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneBurst temp_burst.rms %f", temp_burst.rms);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneBurst temp_burst.rms %f", temp_burst.rms);
 	
 	token = strtok_r(NULL, ",", &aux_mem);
 	temp_burst.integrity = atof(token);
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneBurst temp_burst.integrity %f", temp_burst.integrity);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneBurst temp_burst.integrity %f", temp_burst.integrity);
 	
 	token = strtok_r(NULL, ",", &aux_mem);
 	temp_burst.prop_time = atof(token);
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneBurst temp_burst.prop_time %f", temp_burst.prop_time);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneBurst temp_burst.prop_time %f", temp_burst.prop_time);
 	
 	token = strtok_r(NULL, ",", &aux_mem);
 	temp_burst.velocity = atof(token);
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneBurst temp_burst.velocity %f", temp_burst.velocity);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneBurst temp_burst.velocity %f", temp_burst.velocity);
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneBurst beforeData len %d temp_im.length %d", len, temp_burst.length);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneBurst beforeData len %d temp_im.length %d", len, temp_burst.length);
 	
 	memcpy(temp_burst.data, (aux + len - temp_burst.length), temp_burst.length);
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneBurst temp_burst.data %s", temp_burst.data);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneBurst temp_burst.data %s", temp_burst.data);
 	
 	for (int i = 0; i < temp_burst.length; i++) {
-		Sunset_Debug::debugInfo(4, getModuleAddress(), "dat(%d) = %x", i, temp_burst.data[i]);
+		SUNSET_DEBUG_LOG(4, getModuleAddress(), "dat(%d) = %x", i, temp_burst.data[i]);
 	}
 	
-	Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneBurst Received EV_RECV,%d,%d,%d,%f,%f,%f,%f,%f,%s ", temp_burst.length, temp_burst.source, temp_burst.destination, temp_burst.bitrate, temp_burst.rms, temp_burst.integrity, temp_burst.prop_time, temp_burst.velocity, temp_burst.data);
+	SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Evologics_v1_4::rxDoneBurst Received EV_RECV,%d,%d,%d,%f,%f,%f,%f,%f,%s ", temp_burst.length, temp_burst.source, temp_burst.destination, temp_burst.bitrate, temp_burst.rms, temp_burst.integrity, temp_burst.prop_time, temp_burst.velocity, temp_burst.data);
 	
 	pktReceived(temp_burst.source, temp_burst.destination, temp_burst.data, temp_burst.length);
 	
@@ -2457,7 +2428,7 @@ void Sunset_Evologics_v1_4::setState(int s)
 
 void Sunset_Evologics_v1_4::modemTimeout() 
 {
-	Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::modemTimeout()");
+	SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::modemTimeout()");
 	
 	if ( getState() == EV_SETTING ) {
 		
@@ -2471,7 +2442,7 @@ void Sunset_Evologics_v1_4::modemTimeout()
 	
 	if ( getState() == EV_RANGING ) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::modemTimeout() RANGING");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::modemTimeout() RANGING");
 		
 		if (rangingTime == 0.0) {
 			
@@ -2487,7 +2458,7 @@ void Sunset_Evologics_v1_4::modemTimeout()
 			
 			if (rangingTime > 0.0 && range_dest != -1 ) {
 				
-				Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_4::modemTimeout RANGING startTimer");
+				SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_4::modemTimeout RANGING startTimer");
 				
 				setState(EV_IDLE);
 				
@@ -2510,11 +2481,11 @@ void Sunset_Evologics_v1_4::modemTimeout()
 
 void Sunset_Evologics_v1_4::rttTimeout() 
 {
-	Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::rttTimeout()");
+	SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::rttTimeout()");
 	
 	if (sendRTT_command() == false) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::rttTimeout() ERROR");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::rttTimeout() ERROR");
 		
 		if (rangingTime == 0.0) {
 			
@@ -2530,7 +2501,7 @@ void Sunset_Evologics_v1_4::rttTimeout()
 			
 			if (rangingTime > 0.0 && range_dest != -1 ) {
 				
-				Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_4::rttTimeout RANGING startTimer");
+				SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_4::rttTimeout RANGING startTimer");
 				
 				setState(EV_IDLE);
 				
@@ -2553,7 +2524,7 @@ void Sunset_Evologics_RangingReply_Timer::start(double time, int dst)
 	
 	if (busy()) {
 		
-		Sunset_Debug::debugInfo(-1, modem->getModuleAddress(), "Sunset_Evologics_RangingReply_Timer::start busy ERROR");
+		SUNSET_DEBUG_LOG(-1, modem->getModuleAddress(), "Sunset_Evologics_RangingReply_Timer::start busy ERROR");
 		return;
 	} 
 	
@@ -2626,7 +2597,7 @@ void Sunset_Evologics_DeliveryStatus_Timer::handle(Event *)
 
 void Sunset_Evologics_v1_4::modemBurstMsgRespTimeout() 
 {
-	Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::modemBurstMsgRespTimeout() Data burst: No response from modem!");
+	SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::modemBurstMsgRespTimeout() Data burst: No response from modem!");
 	setState(EV_IDLE);
 	
 	txAborted();
@@ -2656,19 +2627,19 @@ void Sunset_Evologics_Rx_Timer::handle(Event *)
 	paused_ = 0;
 	stime = 0.0;
 	rtime = 0.0;
-	((Sunset_Evologics_v1_4*)modem)->processRxInfo();
-        
-	if (!(((Sunset_Evologics_v1_4*)modem)->rx_info).empty()) {
-
-		handle((Event*)0);
-		return;
-	} 
+	
+	(((Sunset_Evologics_v1_4*)modem)->rxChannel_).wakeupDone();
+	
+	while (!(((Sunset_Evologics_v1_4*)modem)->rxChannel_).empty()) {
+		
+		((Sunset_Evologics_v1_4*)modem)->processRxInfo();
+	}
 }
 
 void Sunset_Evologics_v1_4::handleConnection() 
 {
 	
-	Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::handleConnection retry");
+	SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::handleConnection retry");
 	
 	setState(EV_IDLE);
 	resetTx();
@@ -2690,7 +2661,7 @@ void Sunset_Evologics_v1_4::modemDeliveryTimeout()
 		
 		if ( deliveryRetry >= EV_TIMEOUT_DLV_MAX_RET ) {
 			
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::modemDeliveryTimeout() Max pkt status retry (%d) reached -> ABORTED ", deliveryRetry);
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::modemDeliveryTimeout() Max pkt status retry (%d) reached -> ABORTED ", deliveryRetry);
 		
 			setState(EV_IDLE);
 			
@@ -2703,7 +2674,7 @@ void Sunset_Evologics_v1_4::modemDeliveryTimeout()
 		
 		if ( checkDeliveryStatus() == false ) {
 			
-			Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Evologics_v1_4::modemDeliveryTimeout() check_delivery ");
+			SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Evologics_v1_4::modemDeliveryTimeout() check_delivery ");
 			
 			setState(EV_IDLE);
 			
@@ -2713,7 +2684,7 @@ void Sunset_Evologics_v1_4::modemDeliveryTimeout()
 			return;
 		}
 		
-		Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Evologics_v1_4::modemDeliveryTimeout() -> Retry (%d)", deliveryRetry);
+		SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Evologics_v1_4::modemDeliveryTimeout() -> Retry (%d)", deliveryRetry);
 		
 		if (timeoutDeliv_.busy()) {
 			
@@ -2722,13 +2693,13 @@ void Sunset_Evologics_v1_4::modemDeliveryTimeout()
 		
 		if (deliveryRetry == 0 && tx_time > 0.0) {
 			
-			Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Evologics_v1_4::modemDeliveryTimeout() delay tx time %f deliveryRetry %d", tx_time, deliveryRetry);
+			SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Evologics_v1_4::modemDeliveryTimeout() delay tx time %f deliveryRetry %d", tx_time, deliveryRetry);
 			
 			timeoutDeliv_.start(tx_time);
 		} 
 		else {
 			
-			Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Evologics_v1_4::modemDeliveryTimeout() delay %f deliveryRetry %d", EV_TIMEOUT_DLV, deliveryRetry);
+			SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Evologics_v1_4::modemDeliveryTimeout() delay %f deliveryRetry %d", EV_TIMEOUT_DLV, deliveryRetry);
 			
 			timeoutDeliv_.start(EV_TIMEOUT_DLV);
 		}
@@ -2762,7 +2733,7 @@ int Sunset_Evologics_v1_4::notify_info(list<notified_info> linfo)
 				
 				if (getState() != EV_IDLE) {
 				
-					Sunset_Debug::debugInfo(1, getModuleAddress(), "Sunset_Evologics_v1_4::notify_info OVERRIDE STATE to write tx power %d", val_int);
+					SUNSET_DEBUG_LOG(1, getModuleAddress(), "Sunset_Evologics_v1_4::notify_info OVERRIDE STATE to write tx power %d", val_int);
 				}
 				
 				setState(EV_SETTING);
@@ -2776,7 +2747,7 @@ int Sunset_Evologics_v1_4::notify_info(list<notified_info> linfo)
 				
 			}
 			
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::notify_info tx power %d", val_int);
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::notify_info tx power %d", val_int);
 			
 			return 1;
 		}
@@ -2789,13 +2760,13 @@ int Sunset_Evologics_v1_4::notify_info(list<notified_info> linfo)
 			
 			mac_slot = val_int;
 			
-			Sunset_Debug::debugInfo(1, getModuleAddress(), "Sunset_Evologics_v1_4::notify_info mac slot %d", val_int);
+			SUNSET_DEBUG_LOG(1, getModuleAddress(), "Sunset_Evologics_v1_4::notify_info mac slot %d", val_int);
 			
 			return 1;
 		}
 	}
 	
-	Sunset_Debug::debugInfo(1, getModuleAddress(), "Sunset_Evologics_v1_4::notify_info NOTHING TO DO");
+	SUNSET_DEBUG_LOG(1, getModuleAddress(), "Sunset_Evologics_v1_4::notify_info NOTHING TO DO");
 	
 	return Sunset_Generic_Modem::notify_info(linfo); 
 } 
@@ -2816,19 +2787,19 @@ int Sunset_Evologics_v1_4::setTxPower(int node, int tx_level, double time)
 	
 	if ( sid->assign_value(&tx_level, &ni, sizeof(int)) == false) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::setTxPower ERROR ASSIGINING INFO %s", (ni.info_name).c_str());
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::setTxPower ERROR ASSIGINING INFO %s", (ni.info_name).c_str());
 		
 		return 0;	
 	}
 	
 	if ( sid->set(getModuleAddress(), sid_id, ni) == 0 ) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_4::setTxPower PROVIDING INFO %s NOT DEFINED", (ni.info_name).c_str());
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_4::setTxPower PROVIDING INFO %s NOT DEFINED", (ni.info_name).c_str());
 		
 		return 0;
 	}
 	
-	Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Evologics_v1_4::setTxPower node %d val %d", (node), tx_level);
+	SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Evologics_v1_4::setTxPower node %d val %d", (node), tx_level);
 	
 	return 1;
 }
@@ -24,6 +24,7 @@
 #include "sunset_evologics_include.h"
 #include "sunset_evologics_connection.h"
 #include "sunset_evologics_def.h"
+#include <sunset_rx_channel.h>
 
 #define EV_ATT_REQUEST_TIME_1_4 	0.2
 
@@ -275,7 +276,7 @@ protected:
 	
 	double tx_time;
 	
-	list< pair<char*, int > > rx_info;
+	Sunset_Rx_Channel rxChannel_;	//information received by the listener thread
 	
 };
 
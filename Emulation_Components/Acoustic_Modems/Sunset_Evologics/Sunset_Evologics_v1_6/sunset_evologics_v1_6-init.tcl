@@ -14,3 +14,5 @@ Sunset_Evologics_v1.6 set is_ranging 0
 Sunset_Evologics_v1.6 set rangingTime 0
 
 Sunset_Evologics_v1.6 set EV_MULTIPATH 0
+Sunset_Evologics_v1.6 set txWindow 1
+Sunset_Evologics_v1.6 set txMaxPending 16
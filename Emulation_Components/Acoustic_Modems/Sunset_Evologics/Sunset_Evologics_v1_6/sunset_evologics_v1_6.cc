@@ -42,7 +42,8 @@ public:
 
 Sunset_Evologics_v1_6::Sunset_Evologics_v1_6()  : Sunset_Generic_Modem(), 
 connectionTimer_(this), timeoutTimer_(this), timeoutDeliv_(this), 
-timeoutBurstResp_(this), rttTimer_(this), rangingTimer_(this), rxTimer_(this)
+timeoutBurstResp_(this), rttTimer_(this), rangingTimer_(this), rxTimer_(this),
+txPumpTimer_(this), rxChannel_(EV_BUFSIZE)
 {
 	evo_conn = 0;
 	EV_BROADCAST = 255;
@@ -53,8 +54,12 @@ timeoutBurstResp_(this), rttTimer_(this), rangingTimer_(this), rxTimer_(this)
 	EV_MULTIPATH = 0;
 	already_started = 0;
 	tx_time = 0.0;
+	txWindow_ = 1;
+	txMaxPending_ = SUNSET_TX_PIPELINE_PENDING;
+	burstAcked_ = 0;
+	
+	rxChannel_.setHandler(&rxTimer_);
 	
-	pthread_mutex_init(&mutex_evo_1_6_timer_rx, NULL);
 	pthread_mutex_init(&mutex_evo_1_6_timer_connection, NULL);
 	
 	bind("EV_BROADCAST", &EV_BROADCAST);
@@ -63,6 +68,8 @@ timeoutBurstResp_(this), rttTimer_(this), rangingTimer_(this), rxTimer_(this)
 	bind("USE_EVO_BURST", &useBurst);
 	bind("is_ranging", &is_ranging);
 	bind("rangingTime", &rangingTime);
+	bind("txWindow", &txWindow_);
+	bind("txMaxPending", &txMaxPending_);
 	
 	range_dest -1;
 	
@@ -83,12 +90,11 @@ timeoutBurstResp_(this), rttTimer_(this), rangingTimer_(this), rxTimer_(this)
 Sunset_Evologics_v1_6::~Sunset_Evologics_v1_6() 
 {
 	
-	pthread_mutex_destroy(&mutex_evo_1_6_timer_rx);
 	pthread_mutex_destroy(&mutex_evo_1_6_timer_connection);
 	
 	if ( close_connection() == false ) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::~Sunset_Evologics_v1_6 Cannot close socket fd");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::~Sunset_Evologics_v1_6 Cannot close socket fd");
 	}
 }
 
@@ -101,6 +107,11 @@ void Sunset_Evologics_v1_6::start()
 	
 	Sunset_Generic_Modem::start();
 	
+	/* the modem accepts a single instant message at a time, data bursts are buffered by the modem */
+	
+	txPipe_.setWindow(useBurst ? txWindow_ : 1);
+	txPipe_.setMaxPending(txMaxPending_);
+	
 	if (sid != NULL) {
 		
 		sid_id = sid->register_module(getModuleAddress(), "EVO_MODEM_1.6", this);
@@ -126,14 +137,14 @@ bool Sunset_Evologics_v1_6::startRanging()
 	
 	if (evo_conn == 0 || connectionTimer_.busy()) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::startRanging connection ERROR");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::startRanging connection ERROR");
 		
 		return false;
 	}
 	
 	if (is_ranging == false) { // the node does not support ranging
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::startRanging not set");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::startRanging not set");
 		
 		return false;
 	}
@@ -147,7 +158,7 @@ bool Sunset_Evologics_v1_6::startRanging()
 			return false;
 		}
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::startRanging running");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::startRanging running");
 		
 		return false;
 	}
@@ -181,10 +192,10 @@ int Sunset_Evologics_v1_6::command( int argc, const char * const * argv )
 				memset(socketIpAddress, '\0', EV_MAX_IP_LEN);
 				snprintf(socketIpAddress, EV_MAX_IP_LEN, "%s", argv[3]);
 				
-				Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Evologics_v1_6::command socketIpAddress %s", socketIpAddress);	
+				SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Evologics_v1_6::command socketIpAddress %s", socketIpAddress);	
 				socketPort = atoi(argv[4]);
 				
-				Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_6 socketPort %d", socketPort);
+				SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_6 socketPort %d", socketPort);
 				evo_conn = new Sunset_Evologics_Conn(socketIpAddress, socketPort);
 				
 				return TCL_OK;		      
@@ -226,7 +237,7 @@ int Sunset_Evologics_v1_6::command( int argc, const char * const * argv )
 			
 			int bAddr = atoi(argv[2]);
 			
-			Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_6 setBroadcast addr %d", bAddr);
+			SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_6 setBroadcast addr %d", bAddr);
 			
 			EV_BROADCAST = bAddr;
 			
@@ -240,13 +251,13 @@ int Sunset_Evologics_v1_6::command( int argc, const char * const * argv )
 			
 			if (range_dest < 0 || range_dest == getModuleAddress()) {
 				
-				Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6 startRanging ERROR dest %d", range_dest);
+				SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6 startRanging ERROR dest %d", range_dest);
 				
 				return TCL_OK;
 				
 			}
 			
-			Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_6 startRanging %d time %f", range_dest, rangingTime);
+			SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_6 startRanging %d time %f", range_dest, rangingTime);
 			
 			startRanging();
 			
@@ -258,7 +269,7 @@ int Sunset_Evologics_v1_6::command( int argc, const char * const * argv )
 			
 			useBurst = atoi(argv[2]);
 			
-			Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_6 useBurst %d", useBurst);
+			SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_6 useBurst %d", useBurst);
 			
 			return TCL_OK;
 		}
@@ -273,11 +284,11 @@ int Sunset_Evologics_v1_6::command( int argc, const char * const * argv )
 			
 			rangingTime = atof(argv[3]);
 			
-			Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_6 startRanging %d time %f", range_dest, rangingTime);
+			SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_6 startRanging %d time %f", range_dest, rangingTime);
 			
 			if (rangingTime <= 0.0 || range_dest < 0 || range_dest == getModuleAddress()) {
 				
-				Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6 startRanging ERROR dest %d time %f", range_dest, rangingTime);
+				SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6 startRanging ERROR dest %d time %f", range_dest, rangingTime);
 				
 				return TCL_OK;
 				
@@ -337,7 +348,7 @@ int Sunset_Evologics_v1_6::startConnection() {
 	
 	int res = connect();
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_6::startConnection res  %d", res);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_6::startConnection res  %d", res);
 	
 	return res;
 }
@@ -353,7 +364,7 @@ int Sunset_Evologics_v1_6::stopConnection() {
 	
 	listening = 0;
 	
-	Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Evologics_v1_6::stopConnection res %d", res);
+	SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Evologics_v1_6::stopConnection res %d", res);
 	
 	return res;
 }
@@ -371,7 +382,7 @@ double Sunset_Evologics_v1_6::getTransfertTime(int size)
 	
 	time = (size * 8.0) / 1000000.0;
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_6::getTransfertTime size %d time %f", size, time);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_6::getTransfertTime size %d time %f", size, time);
 	
 	return time;
 }
@@ -387,11 +398,11 @@ double Sunset_Evologics_v1_6::getTxTime(int size)
 	
 	if (dataRate < 0.0) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::getTxTime dataRate %f ERROR", dataRate);
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::getTxTime dataRate %f ERROR", dataRate);
 		exit(1);
 	}		
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_6::getTxTime size %d dataRate %f", size, dataRate);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_6::getTxTime size %d dataRate %f", size, dataRate);
 	return (size * 8.0) / dataRate;
 	
 }
@@ -413,7 +424,7 @@ int Sunset_Evologics_v1_6::connect()
 		timeoutTimer_.stop();
 	}
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_6::connect starting connection");
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_6::connect starting connection");
 	
 	res = start_connection();
 	
@@ -423,7 +434,7 @@ int Sunset_Evologics_v1_6::connect()
 		
 	} else {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::connect Cannot connect to %s:%d", evo_conn->get_ip(), evo_conn->get_port());
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::connect Cannot connect to %s:%d", evo_conn->get_ip(), evo_conn->get_port());
 		
 		pthread_mutex_lock(&mutex_evo_1_6_timer_connection);
 		
@@ -456,15 +467,15 @@ int Sunset_Evologics_v1_6::connect()
 		}
 	}
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_6::connect connecting fd = %d", x);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_6::connect connecting fd = %d", x);
 	
 	res = start_listener();
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_6::connect connecting start_listener");
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_6::connect connecting start_listener");
 	
 	if (!res) {
 		
-		Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_6::connect CANNOT  start_listener");
+		SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_6::connect CANNOT  start_listener");
 		
 		return 0;
 	}
@@ -539,11 +550,11 @@ bool Sunset_Evologics_v1_6::modem_setting()
 				
 			case EV_SET_POWER:
 				
-				Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_6::checkSetting() setting modem power");					
+				SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_6::checkSetting() setting modem power");					
 				
 				if ( set_modem_power(setting_cmd.front().value) == false ) {
 					
-					Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::modem_setting error setting power");
+					SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::modem_setting error setting power");
 					
 					return false;
 				}
@@ -552,11 +563,11 @@ bool Sunset_Evologics_v1_6::modem_setting()
 				
 			case EV_SET_ADDR:
 				
-				Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_6::checkSetting() setting modem address");
+				SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_6::checkSetting() setting modem address");
 				
 				if ( set_local_address(setting_cmd.front().value) == false ) {
 					
-					Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::modem_setting error setting address");					
+					SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::modem_setting error setting address");					
 					return false;
 				}
 				
@@ -564,10 +575,10 @@ bool Sunset_Evologics_v1_6::modem_setting()
 				
 			case EV_SET_PROMISCOUS:
 				
-				Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_6::checkSetting() setting modem promiscous mode");					
+				SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_6::checkSetting() setting modem promiscous mode");					
 				if ( set_promiscous_mode(setting_cmd.front().value) == false ) {
 					
-					Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::modem_setting error setting promiscous mode");					
+					SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::modem_setting error setting promiscous mode");					
 					return false;
 				}
 				
@@ -604,7 +615,7 @@ void Sunset_Evologics_v1_6::checkSetting()
 	
 	if ( modem_setting() == true ) {
 		
-		Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_6::checkSetting() all settings done");					
+		SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_6::checkSetting() all settings done");					
 		
 		setState(EV_IDLE);
 	}
@@ -697,7 +708,7 @@ bool Sunset_Evologics_v1_6::set_modem_power(int power)
 	
 	setState(EV_SETTING);
 	
-	Sunset_Debug::debugInfo(1, getModuleAddress(), "Sunset_Evologics_v1_6::set_modem_power  mando %s\n", msg);
+	SUNSET_DEBUG_LOG(1, getModuleAddress(), "Sunset_Evologics_v1_6::set_modem_power  mando %s\n", msg);
 	
 	
 	if (timeoutTimer_.busy()) {
@@ -751,13 +762,13 @@ bool Sunset_Evologics_v1_6::start_listener()
 	
 	if ( ret ) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::start_listener Cannot create thread - exiting");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::start_listener Cannot create thread - exiting");
 		
 		return false;
 		
 	}
 	
-	Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::start_listener  create thread - DONE");
+	SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::start_listener  create thread - DONE");
 	
 	return true;
 }
@@ -775,29 +786,43 @@ void *thread_proxy_function_1_6(void *_tgtObject)
 
 /*!
  * 	@brief The resetTx() function clears all the information regarding the last transmission on-going. 
- *	It also stops the modem timer before the timeout.
+ *	It also stops the modem timers before the timeout. The packets in flight and the packets not yet written to the 
+ *	modem are notified as aborted to the upper layer, the oldest first. Packets sent by the upper layer while 
+ *	notified are kept for the next transmission.
  */
 
 void Sunset_Evologics_v1_6::resetTx() 
 {
-	int check = 0;
+	list<Packet*> inFlight;
+	int pending = txPipe_.pending();
 	
-	Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::resetTx");
+	SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::resetTx in flight %d pending %d", (int)(pktTxList.size()), pending);
 	
-	if (!pktTxList.empty()){
-		
-		Packet* p = getPktTxList();
-		pktTxList.pop_front();
-		check = 1;
+	if (timeoutTimer_.busy()) {
+		timeoutTimer_.stop();
 	}
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Evologics_v1_6::resetTx exit");
+	if (timeoutBurstResp_.busy()) {
+		timeoutBurstResp_.stop();
+	}
+	
+	burstAcked_ = 0;
 	
-	if (check) {
+	inFlight.swap(pktTxList);
+	
+	while (!inFlight.empty()) {
 		
-		resetTx();
+		Modem2PhyTxAborted(inFlight.front());
+		inFlight.pop_front();
 	}
 	
+	while (pending-- > 0) {
+		
+		Modem2PhyTxAborted(txPipe_.pop());
+	}
+	
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Evologics_v1_6::resetTx exit");
+	
 	return;
 }
 
@@ -810,7 +835,7 @@ void Sunset_Evologics_v1_6::resetTx()
 void Sunset_Evologics_v1_6::pktReceived(char* buffer, int len) 
 {
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_6::pktReceived sendUp");
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_6::pktReceived sendUp");
 	
 	Sunset_Generic_Modem::pktReceived(buffer, len);
 	
@@ -831,7 +856,7 @@ void Sunset_Evologics_v1_6::pktReceived(int src, int dst, char* buffer, int len)
 	
 	Packet* p;
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_6::pktReceived sendUp");
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_6::pktReceived sendUp");
 	
 	if (dst == EV_BROADCAST) {
 		
@@ -861,7 +886,7 @@ void Sunset_Evologics_v1_6::pktReceived(int src, int dst, char* buffer, int len)
 		SUNSET_HDR_CMN(p)->timestamp = (distanceToNode[src]).second;
 	}
 	
-	Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Evologics_v1_6::pktReceived sendUp");
+	SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Evologics_v1_6::pktReceived sendUp");
 	
 	pktRxList.push_back(p);
 	
@@ -892,13 +917,13 @@ char* Sunset_Evologics_v1_6::pktWrite(Packet* p, int& len)
 	
 	if( dataLen <= 0 || bufferData == NULL ) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::pktWrite no bufferData  ERROR");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::pktWrite no bufferData  ERROR");
 		
 		return NULL;
 		
 	}
 	
-	Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::pktWrite len %d", dataLen);
+	SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::pktWrite len %d", dataLen);
 	
 	len = dataLen;
 	
@@ -906,7 +931,10 @@ char* Sunset_Evologics_v1_6::pktWrite(Packet* p, int& len)
 }
 
 /*!
- * 	@brief The sendDown() function converts the ns-2 packet into a stream of bytes and sends such stream to the Evologics modem.
+ * 	@brief The sendDown() function converts the ns-2 packet into a stream of bytes and queues it in the transmission pipeline. 
+ *	The conversion is performed as soon as the packet is received, while the modem may still be transmitting the previous packets, 
+ *	the stream of bytes is written to the modem as soon as the driver is idle and a credit is available. The packet is never written 
+ *	from this function, since it can be called by the upper layer while a modem reply is being processed.
  *	@param p The packet to be sent.
  */
 
@@ -917,43 +945,32 @@ void Sunset_Evologics_v1_6::sendDown(Packet *p)
 	
 	int dst, src;
 	
-	double ref_usec = 0;
-	double delta = 0;
-	double offset = 0.0;
-	
 	pktConverter_->getSrc(p, UW_PKT_MAC, src);
 	pktConverter_->getDst(p, UW_PKT_MAC, dst);
 	
-	if (pktTxList.size() > 0) { //it should not happen - we do not buffer data, remove old packet
-
-		resetTx();	
-	}
-	
-	pktTxList.push_back(p);
-	
 	if (evo_conn == 0 || connectionTimer_.busy()) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::sendDown packet with connection ERROR");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::sendDown packet with connection ERROR");
 		
-		txAborted();
+		Modem2PhyTxAborted(p);
 		
 		return;
 	}
 	
 	if (src != getModuleAddress()) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::sendDown packet with src %d ERROR", src);
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::sendDown packet with src %d ERROR", src);
 		
-		txAborted();
+		Modem2PhyTxAborted(p);
 		
 		return;
 	}
 	
 	if (getState() == EV_RANGING) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::sendDown packet RANGING running");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::sendDown packet RANGING running");
 		
-		txAborted();
+		Modem2PhyTxAborted(p);
 		
 		return;
 		
@@ -964,79 +981,153 @@ void Sunset_Evologics_v1_6::sendDown(Packet *p)
 		dst = EV_BROADCAST;
 	}
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Evologics_v1_6::sendDown packet with src %d dst %d MAC_BROADCAST %d EV_BROADCAST %d", src, dst, Sunset_Address::getBroadcastAddress(), EV_BROADCAST);
-	
-	
-	if (getState() != EV_IDLE && getState() != EV_SETTING) {
-		
-		setState(EV_IDLE);
-	}
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Evologics_v1_6::sendDown packet with src %d dst %d MAC_BROADCAST %d EV_BROADCAST %d", src, dst, Sunset_Address::getBroadcastAddress(), EV_BROADCAST);
 	
 	buffer = (char*)(pkt2Modem(p, len));
 	
 	if ( len <= 0 || buffer == NULL ) {
 		
-		txAborted();
-		
-		setState(EV_IDLE);
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::sendDown MALLOC ERROR");
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::sendDown MALLOC ERROR");
+		Modem2PhyTxAborted(p);
 		
 		return;
 	}
 	
-	for (int i = 0; i < len; i++) {
+	if (txPipe_.push(p, buffer, len, dst) == false) {
+		
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::sendDown pipeline full (%d packets) ERROR", txPipe_.pending());
 		
-		Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_6::sendDown sending DOWN(%d) = %x", i, buffer[i]);
+		free(buffer);
+		
+		Modem2PhyTxAborted(p);
+		
+		return;
 	}
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Evologics_v1_6::sendDown packet len %d is_ranging %d buffer %s check %d", len, is_ranging, (char*)buffer, strlen(buffer));
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Evologics_v1_6::sendDown packet len %d queued pending %d in flight %d state %d", len, txPipe_.pending(), (int)(pktTxList.size()), getState());
+	
+	scheduleTxPump();
+	
+	return;
+}
+
+/*!
+ * 	@brief The txPump() function writes to the modem the packets waiting in the transmission pipeline while a credit is available. 
+ *	Instant messages are written only when the driver is idle. When using data bursts, a new burst can be written as soon 
+ *	as the previous one has been accepted by the modem, the delivery reports are received in the same order.
+ */
+
+void Sunset_Evologics_v1_6::txPump()
+{
+	sunset_tx_frame* f = 0;
+	Packet* p = 0;
+	bool res = false;
 	
-	if (useBurst) {
+	while (txPipe_.ready((int)(pktTxList.size()))) {
 		
-		if(!(send_data_burst(buffer, len, dst))) {
+		if (evo_conn == 0 || connectionTimer_.busy()) {
 			
-			setState(EV_IDLE);
+			return;
+		}
+		
+		if (getState() != EV_IDLE && !(useBurst && getState() == EV_WAIT_BURST_RESP)) {
 			
-			txAborted();
+			return;
+		}
+		
+		f = txPipe_.front();
+		p = f->p;
+		
+		pktTxList.push_back(p);
+		
+		SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Evologics_v1_6::txPump packet len %d dst %d in flight %d pending %d", f->len, f->dst, (int)(pktTxList.size()), txPipe_.pending() - 1);
+		
+		if (useBurst) {
 			
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::sendDown cannot write BURST data to the modem ERROR");
+			res = send_data_burst(f->buffer, f->len, f->dst);
 		}
-	}
-	else {
-		if (EV_USE_ACK) {
+		else {
 			
-			if(!(send_data_im(buffer, len, dst, (char*)EV_ACK))) {
-				
-				Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::sendDown cannot write data to the modem with ACK ERROR");
-				
-				setState(EV_IDLE);
-				
-				txAborted();
-			}
+			res = send_data_im(f->buffer, f->len, f->dst, (char*)(EV_USE_ACK ? EV_ACK : EV_NO_ACK));
+		}
+		
+		txPipe_.pop();
+		
+		if (res == false) {
 			
-		} else {
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::txPump cannot write data to the modem ERROR");
 			
-			if(!(send_data_im(buffer, len, dst, (char*)EV_NO_ACK))) {
-				
-				Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::sendDown cannot write data to the modem ERROR");
-				
-				setState(EV_IDLE);
-				
-				txAborted();
-			}
+			pktTxList.pop_back();
 			
-		}		
-	}	
+			setState(txIdleState());
+			
+			Modem2PhyTxAborted(p);
+		}
+	}
+}
+
+/*!
+ * 	@brief The scheduleTxPump() function schedules the writing of the next packet of the pipeline. The packet is not written 
+ *	directly from the handlers of the modem replies and of the upper layer, so that they complete their state transitions first.
+ */
+
+void Sunset_Evologics_v1_6::scheduleTxPump()
+{
+	if (txPipe_.pending() == 0 || txPumpTimer_.busy()) {
+		
+		return;
+	}
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Evologics_v1_6::sendDown packet len %d buffer %s check %d state %d", len, (char*)buffer, strlen(buffer), getState());
+	txPumpTimer_.start(0.0);
+}
+
+/*!
+ * 	@brief The txIdleState() function returns the state of the driver when no command is waiting for the modem reply: 
+ *	EV_WAIT_BURST_RESP if data bursts are waiting for the delivery report, EV_IDLE otherwise.
+ */
+
+int Sunset_Evologics_v1_6::txIdleState()
+{
+	return (burstAcked_ > 0) ? EV_WAIT_BURST_RESP : EV_IDLE;
+}
+
+/*!
+ * 	@brief The txCommandAborted() function aborts the packet whose command has been refused or not acknowledged by the modem. 
+ *	When data bursts are pipelined it is the last packet written, the bursts already accepted are still waiting for their delivery report.
+ */
+
+void Sunset_Evologics_v1_6::txCommandAborted()
+{
+	Packet* p;
 	
-	free(buffer);
+	if (burstAcked_ == 0 || (int)(pktTxList.size()) <= burstAcked_) {
+		
+		txAborted();
+		
+		setState(txIdleState());
+		
+		return;
+	}
 	
-	return;
+	if (timeoutTimer_.busy()) {
+		
+		timeoutTimer_.stop();
+	}
+	
+	p = pktTxList.back();
+	
+	pktTxList.pop_back();
+	
+	setState(txIdleState());
+	
+	Modem2PhyTxAborted(p);
+	
+	scheduleTxPump();
+	
+	SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::txCommandAborted tx %d", (int)(pktTxList.size()));
 }
 
-
 /*!
  * 	@brief The txDone() function is called when a packet transmission has been correctly completed.
  *	All the status and temporary data structures are cleared from the information 
@@ -1048,11 +1139,11 @@ void Sunset_Evologics_v1_6::txDone()
 	
 	Packet* p;
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Evologics_v1_6::txDone");
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Evologics_v1_6::txDone");
 	
 	if (pktTxList.empty()) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::txDone - " "Something is wrong with tx %d ERROR", (int)(pktTxList.size()));
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::txDone - " "Something is wrong with tx %d ERROR", (int)(pktTxList.size()));
 		
 		return;
 	}
@@ -1065,9 +1156,16 @@ void Sunset_Evologics_v1_6::txDone()
 	
 	pktTxList.pop_front();
 	
+	if (burstAcked_ > 0) {
+		
+		burstAcked_--;
+	}
+	
 	Modem2PhyEndTx(p);
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Evologics_v1_6::txDone tx %d", (int)(pktTxList.size()));
+	scheduleTxPump();
+	
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Evologics_v1_6::txDone tx %d", (int)(pktTxList.size()));
 	
 	return;
 }
@@ -1084,7 +1182,7 @@ void Sunset_Evologics_v1_6::txAborted()
 	
 	if (pktTxList.empty()) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::txAborted - " "Something is wrong with pktList tx %d ERROR", (int)(pktTxList.size()));
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::txAborted - " "Something is wrong with pktList tx %d ERROR", (int)(pktTxList.size()));
 		
 		return;
 	}
@@ -1097,9 +1195,16 @@ void Sunset_Evologics_v1_6::txAborted()
 	
 	pktTxList.pop_front();
 	
+	if (burstAcked_ > 0) {
+		
+		burstAcked_--;
+	}
+	
 	Modem2PhyTxAborted(p);
 	
-	Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::txAborted tx %d", (int)(pktTxList.size()));
+	scheduleTxPump();
+	
+	SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::txAborted tx %d", (int)(pktTxList.size()));
 	
 	return;
 }
@@ -1125,26 +1230,28 @@ void Sunset_Evologics_v1_6::rxAborted(int size)
 void Sunset_Evologics_v1_6::RxIterate(Sunset_Evologics_Conn *p) 
 {
 	
-	char recvb[EV_BUFSIZE];
+	char* recvb = 0;
+	int type = 0;
 	int len = 0;
 	
 	int check = 0;
 	
 	while(listening) {
 		
-		pair<char*, int > rp;
+		len = evo_conn->read_message(&recvb, &type, EV_BUFSIZE);
 		
-		memset(recvb, 0x0, EV_BUFSIZE);
-		
-		len = evo_conn->read_data(recvb, EV_BUFSIZE);
+		if (len == 0) {
+			
+			continue;	// timeout expired, check if the listener has been stopped
+		}
 		
-		Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Evologics_v1_6::RxIterate len %d %s", len, recvb);
+		SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Evologics_v1_6::RxIterate len %d %s", len, (len > 0) ? recvb : "");
 		
 		switch(len) {
 				
 			case EV_READ_NO_CLIENT:
 				
-				Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::RxIterate Client read 0 bytes");
+				SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::RxIterate Client read 0 bytes");
 				
 				check = 1;
 				
@@ -1152,7 +1259,7 @@ void Sunset_Evologics_v1_6::RxIterate(Sunset_Evologics_Conn *p)
 				
 			case EV_READ_ERR:
 				
-				Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::RxIterate Read error");
+				SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::RxIterate Read error");
 				
 				check = 1;
 				
@@ -1160,7 +1267,7 @@ void Sunset_Evologics_v1_6::RxIterate(Sunset_Evologics_Conn *p)
 				
 			case EV_READ_BUF_MAX:
 				
-				Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::RxIterate Buffer limit reached");
+				SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::RxIterate Buffer limit reached");
 				
 				if (getState() != EV_SETTING && getState() != EV_INITIAL_STATE) {
 					
@@ -1174,7 +1281,7 @@ void Sunset_Evologics_v1_6::RxIterate(Sunset_Evologics_Conn *p)
 				break;
 		}
 		
-		Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Evologics_v1_6::RxIterate state %d IDLE %d received %s len %d", getState(), getState() == EV_IDLE, recvb, len);
+		SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Evologics_v1_6::RxIterate state %d IDLE %d received %s len %d", getState(), getState() == EV_IDLE, recvb, len);
 		
 		if (check) {
 			
@@ -1187,36 +1294,12 @@ void Sunset_Evologics_v1_6::RxIterate(Sunset_Evologics_Conn *p)
 			
 		}
 
-		rp.first = (char*) malloc (len+1);
-		
-		if ( rp.first == NULL ) {
-			
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::RxIterate rp.first NULL EXIT");
-			
-			exit(1);
-		}
-		
-		rp.second = len;
-		
-		memset (rp.first, 0x0, len+1);
-		memcpy(rp.first, recvb, len);
-		
-		pthread_mutex_lock(&mutex_evo_1_6_timer_rx);
-		
-		rx_info.push_back (rp);
-		
-		pthread_mutex_unlock(&mutex_evo_1_6_timer_rx);
-		
-		if (!(rxTimer_.busy())) {
-			
-			rxTimer_.start(0.0001); // post event to notify the main thread ro process the received information
-			
-		}
+		rxChannel_.push(recvb, len, NOW, type); // notify the main thread to process the received information
 		
 		
 	}
 	
-	Sunset_Debug::debugInfo(1, getModuleAddress(), "Sunset_Evologics_v1_6::RxIterate exit");
+	SUNSET_DEBUG_LOG(1, getModuleAddress(), "Sunset_Evologics_v1_6::RxIterate exit");
 	
 	listening = 0;
 	already_started = 1;
@@ -1242,39 +1325,34 @@ void Sunset_Evologics_v1_6::RxIterate(Sunset_Evologics_Conn *p)
 
 bool Sunset_Evologics_v1_6::processRxInfo() 
 {
-	pair<char*, int > rp;
+	sunset_rx_slot* rp = 0;
 	int len = 0;
-	char recvb[EV_BUFSIZE]; 
+	char recvb[EV_BUFSIZE];
+	int type = 0;
 	
-	pthread_mutex_lock(&mutex_evo_1_6_timer_rx);
+	rp = rxChannel_.front();
 	
-	if (rx_info.empty()) {
-		pthread_mutex_unlock(&mutex_evo_1_6_timer_rx);
+	if (rp == 0) {
+		
 		return false;
 	} 
 	
-	rp = rx_info.front();
-	
-	rx_info.pop_front();
+	len = rp->len;
+	type = rp->tag;	// message type computed by the listener thread
 	
-	pthread_mutex_unlock(&mutex_evo_1_6_timer_rx);
+	memcpy(recvb, rp->data, len + 1);	// the slot data is '\0' terminated
 	
-	len = rp.second;
-
-	memset(recvb, 0x0, EV_BUFSIZE);
-	memcpy(recvb, rp.first, rp.second);    
-	
-	free(rp.first);
+	rxChannel_.pop();
 	
 	if (getState() == EV_RANGING) { 
 		
-		if ( strcmp(recvb, EV_OK) == 0 || strcmp(recvb, EV_OK2) == 0 ) {
+		if ( type == EV_MSG_OK ) {
 			
 			return true;
 			
 		}
 		
-		if (strncmp(recvb, EV_DELIVEREDIM, strlen(EV_DELIVEREDIM)) == 0 ) { 
+		if (type == EV_MSG_DELIVEREDIM ) { 
 			
 			if (rttTimer_.busy()) {
 	
@@ -1286,12 +1364,11 @@ bool Sunset_Evologics_v1_6::processRxInfo()
 			return true;
 		}
 		
-		if (strncmp(recvb, EV_FAILED, strlen(EV_FAILED)) == 0 ||
-		    strncmp(recvb, EV_CANCELEDIM, strlen(EV_CANCELEDIM)) == 0 ||
-		    strcmp(recvb, EV_BUSY) == 0 || strcmp(recvb, EV_ERROR_WRONG_FORMAT) == 0 ||
-		    strncmp(recvb, EV_RECVIM, strlen(EV_RECVIM)) == 0 ||
-		    strncmp(recvb, EV_RECV, strlen(EV_RECV)) == 0 ||
-		    strncmp(recvb, EV_RECV, strlen(EV_FAILEDIM)) == 0) { 
+		if (Sunset_Evologics_Parser::isFailed(type) ||
+		    type == EV_MSG_CANCELEDIM ||
+		    type == EV_MSG_BUSY || type == EV_MSG_ERROR_WRONG_FORMAT ||
+		    Sunset_Evologics_Parser::isRecvIm(type) ||
+		    Sunset_Evologics_Parser::isRecv(type)) { 
 			
 			if (timeoutTimer_.busy()) {
 				
@@ -1305,7 +1382,7 @@ bool Sunset_Evologics_v1_6::processRxInfo()
 			
 			if (rangingTime > 0.0 && range_dest != -1 ) {
 				
-				Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_6::processRxInfo RANGING startTimer");
+				SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_6::processRxInfo RANGING startTimer");
 				
 				setState(EV_IDLE);
 				
@@ -1326,7 +1403,7 @@ bool Sunset_Evologics_v1_6::processRxInfo()
 			timeoutTimer_.stop();
 		}	
 		
-		Sunset_Debug::debugInfo(2, getModuleAddress(), "(%f) (%d) (%d) _DELAY_ %s us", Sunset_Utilities::get_epoch(), getModuleAddress(), range_dest, recvb);
+		SUNSET_DEBUG_LOG(2, getModuleAddress(), "(%f) (%d) (%d) _DELAY_ %s us", Sunset_Utilities::get_epoch(), getModuleAddress(), range_dest, recvb);
 		
 		setDelayToNode(range_dest, atof(recvb));
 		
@@ -1341,7 +1418,7 @@ bool Sunset_Evologics_v1_6::processRxInfo()
 				
 				if (rangingTime > 0.0 && range_dest != -1 ) {
 					
-					Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_6::processRxInfo RANGING startTimer");
+					SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_6::processRxInfo RANGING startTimer");
 					
 					setState(EV_IDLE);
 					
@@ -1359,7 +1436,7 @@ bool Sunset_Evologics_v1_6::processRxInfo()
 		
 	}
 	
-	if ( strcmp(recvb, EV_OK) == 0 || strcmp(recvb, EV_OK2) == 0 ) {
+	if ( type == EV_MSG_OK ) {
 		
 		/* checking if the setting command has been executed */
 		
@@ -1393,11 +1470,11 @@ bool Sunset_Evologics_v1_6::processRxInfo()
 				timeoutTimer_.stop();
 			}
 			
-			Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Evologics_v1_6::processRxInfo Sending status request");
+			SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Evologics_v1_6::processRxInfo Sending status request");
 			
 			setState(EV_WAIT_DATA_STATUS);
 			
-			Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Evologics_v1_6::processRxInfo Waiting status response");
+			SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Evologics_v1_6::processRxInfo Waiting status response");
 			
 			if (timeoutDeliv_.busy()) {
 				
@@ -1406,13 +1483,13 @@ bool Sunset_Evologics_v1_6::processRxInfo()
 			
 			if (deliveryRetry == 0 && tx_time > 0.0) {
 				
-				Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Evologics_v1_6::processRxInfo delivery timeout tx_time %f deliveryRetry %d", tx_time, deliveryRetry);
+				SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Evologics_v1_6::processRxInfo delivery timeout tx_time %f deliveryRetry %d", tx_time, deliveryRetry);
 				
 				timeoutDeliv_.start(tx_time);
 			} 
 			else {
 				
-				Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Evologics_v1_6::processRxInfo delivery timeout %f deliveryRetry %d", EV_TIMEOUT_DLV, deliveryRetry);
+				SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Evologics_v1_6::processRxInfo delivery timeout %f deliveryRetry %d", EV_TIMEOUT_DLV, deliveryRetry);
 				
 				timeoutDeliv_.start(EV_TIMEOUT_DLV);
 			}
@@ -1425,39 +1502,47 @@ bool Sunset_Evologics_v1_6::processRxInfo()
 		
 		if ( getState() == EV_DATA_BURST ) {
 			
-			if (timeoutBurstResp_.busy()) {
+			if (timeoutTimer_.busy()) {
 				
-				timeoutBurstResp_.stop();
+				timeoutTimer_.stop();
+			}
+			
+			burstAcked_++;
+			
+			/* the response timer supervises the oldest burst waiting for the delivery report */
+			
+			if (!timeoutBurstResp_.busy()) {
+				
+				timeoutBurstResp_.start(EV_TIMEOUT_BURSTRESP);
 			}
 			
-			timeoutBurstResp_.start(EV_TIMEOUT_BURSTRESP);
 			setState(EV_WAIT_BURST_RESP);
 			
 			return true;
 		}
 		
-	}  else	if (strncmp(recvb, EV_CANCELEDIM, strlen(EV_CANCELEDIM)) == 0 ) { 
+	}  else	if (type == EV_MSG_CANCELEDIM ) { 
 		
 		setState(EV_IDLE);
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::processRxInfo EV_CANCELEDIM");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::processRxInfo EV_CANCELEDIM");
 		
 		return true;
 		
-	} else	if (strncmp(recvb, EV_RECVFAILED, strlen(EV_RECVFAILED)) == 0 ) { 
+	} else	if (type == EV_MSG_RECVFAILED ) { 
 		
 		if ( getState() == EV_INITIAL_STATE ) {
 			
 			return true;
 		}
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::processRxInfo EV_RECVFAILED");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::processRxInfo EV_RECVFAILED");
 		
 		rxFailed(recvb+strlen(EV_RECVFAILED)+1, len - (strlen(EV_RECVFAILED)+1));
 		
 		return true;
 		
-	} else if (strcmp(recvb, EV_BUSY) == 0 || strcmp(recvb, EV_ERROR_WRONG_FORMAT) == 0 ) {
+	} else if (type == EV_MSG_BUSY || type == EV_MSG_ERROR_WRONG_FORMAT ) {
 		
 		/* if the modem is busy or the command format is wrong.. */
 		
@@ -1478,13 +1563,11 @@ bool Sunset_Evologics_v1_6::processRxInfo()
 			return true;
 		}
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::processRxInfo Waiting status BUSY");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::processRxInfo Waiting status BUSY");
 		
-		setState(EV_IDLE);
+		txCommandAborted();
 		
-		txAborted();
-		
-	} else if ( strncmp(recvb, EV_RECVIM, strlen(EV_RECVIM)) == 0 ) {
+	} else if ( Sunset_Evologics_Parser::isRecvIm(type) ) {
 		
 		if ( getState() == EV_INITIAL_STATE ) {
 			
@@ -1493,7 +1576,7 @@ bool Sunset_Evologics_v1_6::processRxInfo()
 		
 		if ( getState() == EV_SETTING ) {
 			
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::processRxInfo2 SETTING STATE");
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::processRxInfo2 SETTING STATE");
 			
 			return true;
 		}
@@ -1508,7 +1591,7 @@ bool Sunset_Evologics_v1_6::processRxInfo()
 				timeoutTimer_.stop();
 			}
 			
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::processRxInfo2 TX STATE", getState());
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::processRxInfo2 TX STATE", getState());
 			
 			setState(EV_IDLE);
 			
@@ -1522,7 +1605,7 @@ bool Sunset_Evologics_v1_6::processRxInfo()
 		
 		if ( getState() == EV_DATA_BURST ) {
 			
-			if (timeoutBurstResp_.busy()) {
+			if (timeoutBurstResp_.busy() && burstAcked_ == 0) {
 				
 				timeoutBurstResp_.stop();
 			}
@@ -1539,11 +1622,9 @@ bool Sunset_Evologics_v1_6::processRxInfo()
 			
 			deliveryRetry = 0;
 			
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::processRxInfo2 TX STATE", getState());
-			
-			setState(EV_IDLE);
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::processRxInfo2 TX STATE", getState());
 			
-			txAborted();
+			txCommandAborted();
 			
 		}
 		
@@ -1554,7 +1635,7 @@ bool Sunset_Evologics_v1_6::processRxInfo()
 				timeoutTimer_.stop();
 			}
 			
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::processRxInfo2 TX STATE", getState());
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::processRxInfo2 TX STATE", getState());
 			
 			setState(EV_IDLE);
 			
@@ -1563,13 +1644,13 @@ bool Sunset_Evologics_v1_6::processRxInfo()
 			txAborted();
 		}
 		
-		setState(EV_IDLE);
+		setState(txIdleState());
 		rxDoneIm(recvb+strlen(EV_RECVIM)+1, len - (strlen(EV_RECVIM)+1));			
 		
 		return true;
 	}
 	
-	else if ( strncmp(recvb, EV_RECV, strlen(EV_RECV)) == 0 ) {
+	else if ( Sunset_Evologics_Parser::isRecv(type) ) {
 		
 		if ( getState() == EV_INITIAL_STATE ) {
 			
@@ -1578,7 +1659,7 @@ bool Sunset_Evologics_v1_6::processRxInfo()
 		
 		if ( getState() == EV_SETTING ) {
 			
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::processRxInfo3 SETTING STATE");
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::processRxInfo3 SETTING STATE");
 			
 			return true;
 			
@@ -1594,7 +1675,7 @@ bool Sunset_Evologics_v1_6::processRxInfo()
 				timeoutTimer_.stop();
 			}
 			
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::processRxInfo3 TX STATE", getState());
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::processRxInfo3 TX STATE", getState());
 			
 			setState(EV_IDLE);
 			
@@ -1608,16 +1689,14 @@ bool Sunset_Evologics_v1_6::processRxInfo()
 		
 		if ( getState() == EV_DATA_BURST ) {
 			
-			if (timeoutBurstResp_.busy()) {
+			if (timeoutBurstResp_.busy() && burstAcked_ == 0) {
 				
 				timeoutBurstResp_.stop();
 			}
 			
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::processRxInfo3 TX STATE", getState());
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::processRxInfo3 TX STATE", getState());
 			
-			setState(EV_IDLE);
-			
-			txAborted();
+			txCommandAborted();
 			
 		}
 		
@@ -1628,7 +1707,7 @@ bool Sunset_Evologics_v1_6::processRxInfo()
 				timeoutDeliv_.stop();
 			}
 			
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::processRxInfo3 TX STATE", getState());
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::processRxInfo3 TX STATE", getState());
 			
 			setState(EV_IDLE);
 			
@@ -1637,17 +1716,17 @@ bool Sunset_Evologics_v1_6::processRxInfo()
 			txAborted();
 		}
 		
-		setState(EV_IDLE);
+		setState(txIdleState());
 		
 		rxDoneBurst(recvb+strlen(EV_RECV)+1, len - (strlen(EV_RECV)+1));
 		
-		Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Evologics_v1_6::processRxInfo RX_DONE_BURST");
+		SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Evologics_v1_6::processRxInfo RX_DONE_BURST");
 		
 		return true;
 	}
 	
 	else if ( getState() == EV_WAIT_DATA_STATUS && 
-		 strncmp(recvb, EV_DELIVERING, strlen(EV_DELIVERING)) == 0 ) {
+		 type == EV_MSG_DELIVERING ) {
 		
 		if (timeoutDeliv_.busy()) {
 			
@@ -1656,13 +1735,13 @@ bool Sunset_Evologics_v1_6::processRxInfo()
 		
 		if (deliveryRetry == 0 && tx_time > 0.0) {
 			
-			Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Evologics_v1_6::processRxInfo delivery timeout tx_time %f deliveryRetry %d", tx_time, deliveryRetry);
+			SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Evologics_v1_6::processRxInfo delivery timeout tx_time %f deliveryRetry %d", tx_time, deliveryRetry);
 			
 			timeoutDeliv_.start(tx_time);
 		} 
 		else {
 			
-			Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Evologics_v1_6::processRxInfo delivery timeout %f deliveryRetry %d", EV_TIMEOUT_DLV, deliveryRetry);
+			SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Evologics_v1_6::processRxInfo delivery timeout %f deliveryRetry %d", EV_TIMEOUT_DLV, deliveryRetry);
 			
 			timeoutDeliv_.start(EV_TIMEOUT_DLV);
 		}
@@ -1670,7 +1749,7 @@ bool Sunset_Evologics_v1_6::processRxInfo()
 		
 	} else if ( getState() == EV_WAIT_DATA_STATUS && 
 		   
-		strncmp(recvb, EV_EMPTY, strlen(EV_EMPTY)) == 0 ) {	
+		type == EV_MSG_EMPTY ) {	
 		
 		if (timeoutDeliv_.busy()) {
 			
@@ -1679,14 +1758,14 @@ bool Sunset_Evologics_v1_6::processRxInfo()
 		
 		deliveryRetry = 0;
 		
-		Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Evologics_v1_6::TX_DONE IDLE");
+		SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Evologics_v1_6::TX_DONE IDLE");
 		
 		setState(EV_IDLE);
 		
 		txDone();
 		
 	} else if ( getState() == EV_WAIT_DATA_STATUS && 
-		   strncmp(recvb, EV_FAILED, strlen(EV_FAILED)) == 0 ) {	
+		   Sunset_Evologics_Parser::isFailed(type) ) {	
 		
 		if (timeoutDeliv_.busy()) {
 			
@@ -1695,77 +1774,95 @@ bool Sunset_Evologics_v1_6::processRxInfo()
 		
 		deliveryRetry = 0;
 		
-		Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Evologics_v1_6::TX_ABORTED IDLE");
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::processRxInfo3 TX STATE", getState());
+		SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Evologics_v1_6::TX_ABORTED IDLE");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::processRxInfo3 TX STATE", getState());
 		
 		setState(EV_IDLE);				
 		txAborted();
 	}
 	
-	else if ( getState() == EV_WAIT_BURST_RESP && 
-		 strncmp(recvb, EV_DELIVERED, strlen(EV_DELIVERED)) == 0 ) {
+	else if ( burstAcked_ > 0 && 
+		 Sunset_Evologics_Parser::isDelivered(type) ) {
+		
+		/* the delivery reports are received in the order the bursts have been written: the oldest burst is completed */
 		
 		if (timeoutBurstResp_.busy()) {
 						
 			timeoutBurstResp_.stop();
 		}
 		
-		Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Evologics_v1_6::TX_DONE2 IDLE");
+		SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Evologics_v1_6::TX_DONE2 IDLE");
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::processRxInfo3 TX STATE", getState());
-		
-		setState(EV_IDLE);	
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::processRxInfo3 TX STATE", getState());
 		
 		txDone();
+		
+		if (burstAcked_ > 0) {
+			
+			timeoutBurstResp_.start(EV_TIMEOUT_BURSTRESP);
+		}
+		
+		if (getState() != EV_DATA_BURST) {
+			
+			setState(txIdleState());
+		}
 	}
 	
-	else if ( getState() == EV_WAIT_BURST_RESP && 
-		 strncmp(recvb, EV_FAILED, strlen(EV_FAILED)) == 0 ) {
+	else if ( burstAcked_ > 0 && 
+		 Sunset_Evologics_Parser::isFailed(type) ) {
 		
 		if (timeoutBurstResp_.busy()) {
 			
 			timeoutBurstResp_.stop();
 		}
 		
-		Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Evologics_v1_6::TX_ABORTED2 IDLE");
+		SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Evologics_v1_6::TX_ABORTED2 IDLE");
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::processRxInfo3 TX STATE", getState());
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::processRxInfo3 TX STATE", getState());
 		
-		setState(EV_IDLE);
-	
 		txAborted();
+		
+		if (burstAcked_ > 0) {
+			
+			timeoutBurstResp_.start(EV_TIMEOUT_BURSTRESP);
+		}
+		
+		if (getState() != EV_DATA_BURST) {
+			
+			setState(txIdleState());
+		}
 	}
 	
-	else if ( strncmp(recvb, EV_DELIVEREDIM, strlen(EV_DELIVEREDIM)) == 0 && EV_USE_ACK == 1) {
+	else if ( type == EV_MSG_DELIVEREDIM && EV_USE_ACK == 1) {
 		
 		if (timeoutDeliv_.busy()) {
 			
 			timeoutDeliv_.stop();
 		}
 		
-		Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Evologics_v1_6::processRxInfo EV_DELIVEREDIM TX_DONE IDLE");
+		SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Evologics_v1_6::processRxInfo EV_DELIVEREDIM TX_DONE IDLE");
 		
 		setState(EV_IDLE);
 		
 		txDone();
 		
-		Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Evologics_v1_6::processRxInfo DELIVEREDIM %s", recvb);
+		SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Evologics_v1_6::processRxInfo DELIVEREDIM %s", recvb);
 		
 	}
-	else if ( strncmp(recvb, EV_FAILEDIM, strlen(EV_FAILEDIM)) == 0 && EV_USE_ACK == 1) {
+	else if ( type == EV_MSG_FAILEDIM && EV_USE_ACK == 1) {
 		
 		if (timeoutDeliv_.busy()) {
 			
 			timeoutDeliv_.stop();
 		}
 		
-		Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Evologics_v1_6::TX_ABORTED IDLE");
+		SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Evologics_v1_6::TX_ABORTED IDLE");
 		
 		setState(EV_IDLE);
 		
 		txAborted();
 		
-		Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Evologics_v1_6::processRxInfo DELIVEREDIM %s", recvb);
+		SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Evologics_v1_6::processRxInfo DELIVEREDIM %s", recvb);
 	}
 	else {
 		cout << recvb ;
@@ -1797,7 +1894,7 @@ void Sunset_Evologics_v1_6::setDelayToNode(int node, double delay_usec)
 	
 	if (sid == NULL) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::setDelayToNode DISPATCHER NOT DEFINED");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::setDelayToNode DISPATCHER NOT DEFINED");
 		
 		return;
 	}
@@ -1809,7 +1906,7 @@ void Sunset_Evologics_v1_6::setDelayToNode(int node, double delay_usec)
 	
 	if ( sid->assign_value(&delay, &ni1, sizeof(double)) == false) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::setDelayToNode ERROR ASSIGINING INFO %s", (ni1.info_name).c_str());
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::setDelayToNode ERROR ASSIGINING INFO %s", (ni1.info_name).c_str());
 		
 		return;
 		
@@ -1817,10 +1914,10 @@ void Sunset_Evologics_v1_6::setDelayToNode(int node, double delay_usec)
 	
 	if ( sid->set(getModuleAddress(), sid_id, ni1) == 0 ) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::setDelayToNode PROVIDING INFO %s NOT DEFINED", (ni1.info_name).c_str());	
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::setDelayToNode PROVIDING INFO %s NOT DEFINED", (ni1.info_name).c_str());	
 	}
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Evologics_v1_6::setDelayToNode node %d delay %f distance %f", node, delay, distanceToNode[node].first);
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Evologics_v1_6::setDelayToNode node %d delay %f distance %f", node, delay, distanceToNode[node].first);
 }
 
 
@@ -1836,7 +1933,7 @@ bool Sunset_Evologics_v1_6::checkDeliveryStatus()
 	
 	memset(msg, 0x0, EV_BUFSIZE);
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_6::checkDeliveryStatus");
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_6::checkDeliveryStatus");
 	
 	snprintf(msg, EV_BUFSIZE, "%s%s", ATDI, EV_EOC);
 	
@@ -1872,14 +1969,14 @@ bool Sunset_Evologics_v1_6::send_data_im(char *data, int length, int device, cha
 	
 	if ( getState() != EV_IDLE ) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::send_data_im STATE ERROR %d", getState());
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::send_data_im STATE ERROR %d", getState());
 		
 		return false;
 	}
 	
 	if (length > EV_PACKET_LENGHT_IM) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::send_data_im length %d > EV_PACKET_LENGHT_IM ERROR", length);
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::send_data_im length %d > EV_PACKET_LENGHT_IM ERROR", length);
 		
 		return false;
 	}
@@ -1888,7 +1985,7 @@ bool Sunset_Evologics_v1_6::send_data_im(char *data, int length, int device, cha
 	
 	if ( device < 1 || device > EV_BROADCAST ) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::send_data_im Wrong destination id %d", device);
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::send_data_im Wrong destination id %d", device);
 		
 		return false;
 		
@@ -1913,14 +2010,14 @@ bool Sunset_Evologics_v1_6::send_data_im(char *data, int length, int device, cha
 	
 	timeoutTimer_.start(EV_TIMEOUT_CMD);
 	
-	Sunset_Debug::debugInfo(1, getModuleAddress(), "Sunset_Evologics_v1_6::TX_START");
-	Sunset_Debug::debugInfo(-1, getModuleAddress(), "EVO_MODEM,%s,%d,%d,%s", AT_SENDIM, length, device, flag);
+	SUNSET_DEBUG_LOG(1, getModuleAddress(), "Sunset_Evologics_v1_6::TX_START");
+	SUNSET_DEBUG_LOG(-1, getModuleAddress(), "EVO_MODEM,%s,%d,%d,%s", AT_SENDIM, length, device, flag);
 	
 	tx_time = getTxTime(length) + EV_TX_BASIC_TIME;
 	
 	if ( evo_conn->write_data(msg, total_len) == false ) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::send_data_im error writing");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::send_data_im error writing");
 		
 		setState(EV_IDLE);
 		
@@ -1931,7 +2028,7 @@ bool Sunset_Evologics_v1_6::send_data_im(char *data, int length, int device, cha
 		return false;
 	}
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Evologics_v1_6::send_data_im exit state %d total_len %d length %d tx_time %f", getState(), total_len, length, tx_time);
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Evologics_v1_6::send_data_im exit state %d total_len %d length %d tx_time %f", getState(), total_len, length, tx_time);
 	
 	return true;
 }
@@ -1953,7 +2050,7 @@ bool Sunset_Evologics_v1_6::send_data_imRTT()
 	
 	if (getState() != EV_IDLE && getState() != EV_RANGING) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::send_data_imRTT busy");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::send_data_imRTT busy");
 		
 		if (rangingTime > 0.0) {
 			
@@ -1978,7 +2075,7 @@ bool Sunset_Evologics_v1_6::send_data_imRTT()
 	
 	if (range_dest == -1) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::send_data_imRTT range may be stopped");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::send_data_imRTT range may be stopped");
 		
 		return false;
 	}
@@ -1989,7 +2086,7 @@ bool Sunset_Evologics_v1_6::send_data_imRTT()
 	
 	if (EV_RANGING_SIZE > EV_PACKET_LENGHT_IM) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::send_data_imRTT length %d > EV_PACKET_LENGHT_IM ERROR", EV_RANGING_SIZE);
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::send_data_imRTT length %d > EV_PACKET_LENGHT_IM ERROR", EV_RANGING_SIZE);
 		
 		return false;
 	}
@@ -1998,7 +2095,7 @@ bool Sunset_Evologics_v1_6::send_data_imRTT()
 	
 	if ( range_dest < 1 || range_dest > EV_BROADCAST ) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::send_data_imRTT Wrong destination id", range_dest);
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::send_data_imRTT Wrong destination id", range_dest);
 		
 		return false;
 		
@@ -2073,7 +2170,7 @@ bool Sunset_Evologics_v1_6::sendRTT_command()
 	
 	if ( getState() != EV_RANGING ) {
 		
-		Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Evologics_v1_6::sendRTT_command STATE ERROR %d", getState());
+		SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Evologics_v1_6::sendRTT_command STATE ERROR %d", getState());
 		
 		return false;
 	}
@@ -2093,7 +2190,7 @@ bool Sunset_Evologics_v1_6::sendRTT_command()
 		return false;
 	}
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Evologics_v1_6::sendRTT_command DONE");
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Evologics_v1_6::sendRTT_command DONE");
 	
 	if (timeoutTimer_.busy()) {
 		
@@ -2126,16 +2223,16 @@ bool Sunset_Evologics_v1_6::send_data_burst(char *data, int length, int device)
 	int total_len = 0;
 	Packet* p;
 	
-	if ( getState() != EV_IDLE ) {
+	if ( getState() != EV_IDLE && getState() != EV_WAIT_BURST_RESP ) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::send_data_im STATE ERROR %d", getState());
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::send_data_im STATE ERROR %d", getState());
 		
 		return false;
 	}
 	
 	if (length > EV_PACKET_LENGHT_IM) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::send_data_im length %d > EV_PACKET_LENGHT_IM ERROR", length);
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::send_data_im length %d > EV_PACKET_LENGHT_IM ERROR", length);
 		
 		return false;
 	}
@@ -2144,7 +2241,7 @@ bool Sunset_Evologics_v1_6::send_data_burst(char *data, int length, int device)
 	
 	if ( device < 1 || device > EV_BROADCAST ) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::send_data_im Wrong destination id %d", device);
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::send_data_im Wrong destination id %d", device);
 		
 		return false;
 		
@@ -2165,9 +2262,9 @@ bool Sunset_Evologics_v1_6::send_data_burst(char *data, int length, int device)
 	
 	if ( evo_conn->write_data(msg, total_len) == false ) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::send_data_burst error writing");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::send_data_burst error writing");
 		
-		setState(EV_IDLE);		
+		setState(txIdleState());		
 		
 		return false;
 	}
@@ -2201,7 +2298,7 @@ void Sunset_Evologics_v1_6::rxDoneIm(char *data, int len)
 
 	if ( aux == NULL ) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneIm MALLOC ERROR");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneIm MALLOC ERROR");
 		
 		exit(1);
 	}	
@@ -2209,19 +2306,19 @@ void Sunset_Evologics_v1_6::rxDoneIm(char *data, int len)
 	memset(aux, '\0', len+1);
 	memcpy(aux, data, len);
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Evologics_v1_6::RX_DONE IM");
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Evologics_v1_6::RX_DONE IM");
 	
 	// <length>,<source address>,<destination address>,<flag>,<bitrate>,<rms>,<integrity>,
 	//       <propagation time>,<velocity>,<data>
 	// ex. EV_RECVIM,4,1,3,ack,3.0,1.0,2.0,3.4,5.3,ciaocciaocc
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneIm %s len %d - lenAll %d", data, strlen(data), len);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneIm %s len %d - lenAll %d", data, strlen(data), len);
 	
 	token = strtok_r(data, ",", &aux_mem);
 	
 	if (token == NULL) {
 	
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneIm  ERROR read token 1");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneIm  ERROR read token 1");
 	      	
 		free(aux);
 		
@@ -2232,13 +2329,13 @@ void Sunset_Evologics_v1_6::rxDoneIm(char *data, int len)
 	
 	temp_im.length = atoi(token);
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneIm temp_im.length %d", temp_im.length);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneIm temp_im.length %d", temp_im.length);
 	
 	token = strtok_r(NULL, ",", &aux_mem);
 	
 	if (token == NULL) {
 	
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneIm  ERROR read token 2");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneIm  ERROR read token 2");
 	      	
 		free(aux);
 
@@ -2249,13 +2346,13 @@ void Sunset_Evologics_v1_6::rxDoneIm(char *data, int len)
 	
 	temp_im.source = atoi(token);
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneIm temp_im.source %d", temp_im.source);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneIm temp_im.source %d", temp_im.source);
 	
 	token = strtok_r(NULL, ",", &aux_mem);
 
 	if (token == NULL) {
 	
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneIm  ERROR read token 3");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneIm  ERROR read token 3");
 	      	
 		free(aux);
 		
@@ -2266,13 +2363,13 @@ void Sunset_Evologics_v1_6::rxDoneIm(char *data, int len)
 	
 	temp_im.destination = atoi(token);
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneIm temp_im.destination %d", temp_im.destination);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneIm temp_im.destination %d", temp_im.destination);
 	
 	token = strtok_r(NULL, ",", &aux_mem);
 	
 	if (token == NULL) {
 	
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneIm  ERROR read token 4");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneIm  ERROR read token 4");
 	      	
 		free(aux);
 		
@@ -2283,13 +2380,13 @@ void Sunset_Evologics_v1_6::rxDoneIm(char *data, int len)
 	
 	strncpy(temp_im.flag, token, strlen(token));
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneIm temp_im.flag %s", temp_im.flag);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneIm temp_im.flag %s", temp_im.flag);
 	
 	token = strtok_r(NULL, ",", &aux_mem);
 	
 	if (token == NULL) {
 	
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneIm  ERROR read token 5");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneIm  ERROR read token 5");
 	      	
 		free(aux);
 		
@@ -2300,13 +2397,13 @@ void Sunset_Evologics_v1_6::rxDoneIm(char *data, int len)
 	
 	temp_im.bitrate = atof(token);
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneIm temp_im.bitrate %f", temp_im.bitrate);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneIm temp_im.bitrate %f", temp_im.bitrate);
 	
 	token = strtok_r(NULL, ",", &aux_mem);
 	
 	if (token == NULL) {
 	
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneIm  ERROR read token 6");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneIm  ERROR read token 6");
 	      	
 		free(aux);
 		
@@ -2317,13 +2414,13 @@ void Sunset_Evologics_v1_6::rxDoneIm(char *data, int len)
 	
 	temp_im.rms = atof(token);
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneIm temp_im.rms %f", temp_im.rms);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneIm temp_im.rms %f", temp_im.rms);
 	
 	token = strtok_r(NULL, ",", &aux_mem);
 	
 	if (token == NULL) {
 	
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneIm  ERROR read token 7");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneIm  ERROR read token 7");
 	      	
 		free(aux);
 		
@@ -2334,13 +2431,13 @@ void Sunset_Evologics_v1_6::rxDoneIm(char *data, int len)
 	
 	temp_im.integrity = atof(token);
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneIm temp_im.integrity %f", temp_im.integrity);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneIm temp_im.integrity %f", temp_im.integrity);
 	
 	token = strtok_r(NULL, ",", &aux_mem);
 	
 	if (token == NULL) {
 	
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneIm  ERROR read token 8");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneIm  ERROR read token 8");
 	      	
 		free(aux);
 		
@@ -2351,13 +2448,13 @@ void Sunset_Evologics_v1_6::rxDoneIm(char *data, int len)
 	
 	temp_im.prop_time = atof(token);
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneIm temp_im.prop_time %f", temp_im.prop_time);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneIm temp_im.prop_time %f", temp_im.prop_time);
 	
 	token = strtok_r(NULL, ",", &aux_mem);
 	
 	if (token == NULL) {
 	
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneIm  ERROR read token 9");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneIm  ERROR read token 9");
 	      	
 		free(aux);
 		
@@ -2368,22 +2465,22 @@ void Sunset_Evologics_v1_6::rxDoneIm(char *data, int len)
 	
 	temp_im.velocity = atof(token);
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneIm temp_im.velocity %f", temp_im.velocity);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneIm temp_im.velocity %f", temp_im.velocity);
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneIm beforeData len %d temp_im.length %d", len, temp_im.length);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneIm beforeData len %d temp_im.length %d", len, temp_im.length);
 	
 	memcpy(temp_im.data, (aux + len - temp_im.length), temp_im.length);
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneIm temp_im.data %s", temp_im.data);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneIm temp_im.data %s", temp_im.data);
 	
 	for (int i = 0; i < temp_im.length; i++) {
 		
-		Sunset_Debug::debugInfo(4, getModuleAddress(), "dat(%d) = %x", i, temp_im.data[i]);
+		SUNSET_DEBUG_LOG(4, getModuleAddress(), "dat(%d) = %x", i, temp_im.data[i]);
 	}
 	
-	Sunset_Debug::debugInfo(-1, getModuleAddress(), "EVO_MODEM,EV_RECVIM,%d,%d,%d,%s,%f,%f,%f,%f,%f", temp_im.length, temp_im.source, temp_im.destination, temp_im.flag, temp_im.bitrate, temp_im.rms, temp_im.integrity, temp_im.prop_time, temp_im.velocity);
+	SUNSET_DEBUG_LOG(-1, getModuleAddress(), "EVO_MODEM,EV_RECVIM,%d,%d,%d,%s,%f,%f,%f,%f,%f", temp_im.length, temp_im.source, temp_im.destination, temp_im.flag, temp_im.bitrate, temp_im.rms, temp_im.integrity, temp_im.prop_time, temp_im.velocity);
 	
-	Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneIm Received EV_RECVIM,%d,%d,%d,%s,%f,%f,%f,%f,%f,%s ", temp_im.length, temp_im.source, temp_im.destination, temp_im.flag, temp_im.bitrate, temp_im.rms, temp_im.integrity, temp_im.prop_time, temp_im.velocity, temp_im.data);
+	SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneIm Received EV_RECVIM,%d,%d,%d,%s,%f,%f,%f,%f,%f,%s ", temp_im.length, temp_im.source, temp_im.destination, temp_im.flag, temp_im.bitrate, temp_im.rms, temp_im.integrity, temp_im.prop_time, temp_im.velocity, temp_im.data);
 	
 	if (is_ranging == false || strcmp(temp_im.flag, EV_ACK) != 0 || temp_im.length != EV_RANGING_SIZE) {
 		
@@ -2409,7 +2506,7 @@ void Sunset_Evologics_v1_6::rxDoneIm(char *data, int len)
 void Sunset_Evologics_v1_6::rxFailed(char *data, int len) 
 {
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_6::rxFailed %s len %d - lenAll %d", data, strlen(data), len);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_6::rxFailed %s len %d - lenAll %d", data, strlen(data), len);
 	
 	collectMultiPathInfo(-1);
 	
@@ -2427,7 +2524,7 @@ bool Sunset_Evologics_v1_6::collectMultiPathInfo(int src)
 	
 	if ( getState() != EV_IDLE ) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::collectMultiPathInfo STATE ERROR %d", getState());
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::collectMultiPathInfo STATE ERROR %d", getState());
 		
 		return false;
 	}
@@ -2437,18 +2534,18 @@ bool Sunset_Evologics_v1_6::collectMultiPathInfo(int src)
 	snprintf(msg, EV_BUFSIZE, "%s%s", AT_MULTI_PATH,EV_EOC);
 	total_len = strlen(msg);
 	
-	Sunset_Debug::debugInfo(1, getModuleAddress(), "Sunset_Evologics_v1_6::MULTI_PATH");
+	SUNSET_DEBUG_LOG(1, getModuleAddress(), "Sunset_Evologics_v1_6::MULTI_PATH");
 	
 	cout << "MULTIPATH (slot," << mac_slot << ",power," << current_tx_power << ") " << src << " " << getModuleAddress() << endl;
 
 	if ( evo_conn->write_data(msg, total_len) == false ) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::collectMultiPathInfo error writing");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::collectMultiPathInfo error writing");
 		
 		return false;
 	}
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Evologics_v1_6::collectMultiPathInfo exit state %d total_len %d", getState(), total_len);
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Evologics_v1_6::collectMultiPathInfo exit state %d total_len %d", getState(), total_len);
 	
 	return true;
 }
@@ -2472,7 +2569,7 @@ void Sunset_Evologics_v1_6::rxDoneBurst(char *data, int len)
 	
 	if ( aux == NULL ) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneBurst MALLOC ERROR");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneBurst MALLOC ERROR");
 		return;
 		exit(1);
 	}	
@@ -2483,60 +2580,60 @@ void Sunset_Evologics_v1_6::rxDoneBurst(char *data, int len)
 	// <length>,<source address>,<destination address>,<bitrate>,<rssi>,
 	// <integrity>,<propagation time>,<velocity>,<data>
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneBurst %s len %d - lenAll %d", data, strlen(data), len);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneBurst %s len %d - lenAll %d", data, strlen(data), len);
 	
 	token = strtok_r(data, ",", &aux_mem);
 	temp_burst.length = atoi(token);
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneBurst temp_burst.length %d", temp_burst.length);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneBurst temp_burst.length %d", temp_burst.length);
 	
 	token = strtok_r(NULL, ",", &aux_mem);
 	temp_burst.source = atoi(token);
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneBurst temp_burst.source %d", temp_burst.source);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneBurst temp_burst.source %d", temp_burst.source);
 	
 	token = strtok_r(NULL, ",", &aux_mem);
 	temp_burst.destination = atoi(token);
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneBurst temp_burst.destination %d", temp_burst.destination);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneBurst temp_burst.destination %d", temp_burst.destination);
 	
 	token = strtok_r(NULL, ",", &aux_mem);
 	temp_burst.bitrate = atof(token);
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneBurst temp_burst.bitrate %f", temp_burst.bitrate);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneBurst temp_burst.bitrate %f", temp_burst.bitrate);
 	
 	token = strtok_r(NULL, ",", &aux_mem);
 	temp_burst.rms = atof(token);
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneBurst temp_burst.rms %f", temp_burst.rms);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneBurst temp_burst.rms %f", temp_burst.rms);
 	
 	token = strtok_r(NULL, ",", &aux_mem);
 	temp_burst.integrity = atof(token);
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneBurst temp_burst.integrity %f", temp_burst.integrity);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneBurst temp_burst.integrity %f", temp_burst.integrity);
 	
 	token = strtok_r(NULL, ",", &aux_mem);
 	temp_burst.prop_time = atof(token);
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneBurst temp_burst.prop_time %f", temp_burst.prop_time);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneBurst temp_burst.prop_time %f", temp_burst.prop_time);
 	
 	token = strtok_r(NULL, ",", &aux_mem);
 	temp_burst.velocity = atof(token);
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneBurst temp_burst.velocity %f", temp_burst.velocity);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneBurst temp_burst.velocity %f", temp_burst.velocity);
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneBurst beforeData len %d temp_im.length %d", len, temp_burst.length);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneBurst beforeData len %d temp_im.length %d", len, temp_burst.length);
 	
 	memcpy(temp_burst.data, (aux + len - temp_burst.length), temp_burst.length);
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneBurst temp_burst.data %s", temp_burst.data);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneBurst temp_burst.data %s", temp_burst.data);
 	
 	for (int i = 0; i < temp_burst.length; i++) {
 		
-		Sunset_Debug::debugInfo(4, getModuleAddress(), "dat(%d) = %x", i, temp_burst.data[i]);
+		SUNSET_DEBUG_LOG(4, getModuleAddress(), "dat(%d) = %x", i, temp_burst.data[i]);
 	}
 	
-	Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneBurst Received EV_RECV,%d,%d,%d,%f,%f,%f,%f,%f,%s ", temp_burst.length, temp_burst.source, temp_burst.destination, temp_burst.bitrate, temp_burst.rms, temp_burst.integrity, temp_burst.prop_time, temp_burst.velocity, temp_burst.data);
+	SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Evologics_v1_6::rxDoneBurst Received EV_RECV,%d,%d,%d,%f,%f,%f,%f,%f,%s ", temp_burst.length, temp_burst.source, temp_burst.destination, temp_burst.bitrate, temp_burst.rms, temp_burst.integrity, temp_burst.prop_time, temp_burst.velocity, temp_burst.data);
 	
 	pktReceived(temp_burst.source, temp_burst.destination, temp_burst.data, temp_burst.length);
 	
@@ -2561,6 +2658,11 @@ int Sunset_Evologics_v1_6::getState()
 void Sunset_Evologics_v1_6::setState(int s) 
 {
 	state = s;
+	
+	if (s == EV_IDLE || s == EV_WAIT_BURST_RESP) {
+		
+		scheduleTxPump();	// the driver can write the packets waiting in the pipeline
+	}
 }
 
 /*!
@@ -2569,7 +2671,7 @@ void Sunset_Evologics_v1_6::setState(int s)
 
 void Sunset_Evologics_v1_6::modemTimeout() 
 {
-	Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::modemTimeout()");
+	SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::modemTimeout()");
 	
 	if ( getState() == EV_SETTING ) {
 		
@@ -2584,7 +2686,7 @@ void Sunset_Evologics_v1_6::modemTimeout()
 	
 	if ( getState() == EV_RANGING ) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::modemTimeout() RANGING");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::modemTimeout() RANGING");
 		
 		if (rangingTime == 0.0) {
 			
@@ -2600,7 +2702,7 @@ void Sunset_Evologics_v1_6::modemTimeout()
 			
 			if (rangingTime > 0.0 && range_dest != -1 ) {
 				
-				Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_6::modemTimeout RANGING startTimer");
+				SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_6::modemTimeout RANGING startTimer");
 				
 				setState(EV_IDLE);
 				
@@ -2616,18 +2718,16 @@ void Sunset_Evologics_v1_6::modemTimeout()
 		return;
 	}
 	
-	setState(EV_IDLE);
-	
-	txAborted();
+	txCommandAborted();
 }
 
 void Sunset_Evologics_v1_6::rttTimeout() 
 {
-	Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::rttTimeout()");
+	SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::rttTimeout()");
 	
 	if (sendRTT_command() == false) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::rttTimeout() ERROR");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::rttTimeout() ERROR");
 		
 		if (rangingTime == 0.0) {
 			
@@ -2644,7 +2744,7 @@ void Sunset_Evologics_v1_6::rttTimeout()
 			
 			if (rangingTime > 0.0 && range_dest != -1 ) {
 				
-				Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Evologics_v1_6::rttTimeout RANGING startTimer");
+				SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Evologics_v1_6::rttTimeout RANGING startTimer");
 				
 				setState(EV_IDLE);
 				
@@ -2668,7 +2768,7 @@ void Sunset_Evologics_RangingReply_Timer::start(double time, int dst)
 	
 	if (busy()) {
 		
-		Sunset_Debug::debugInfo(-1, modem->getModuleAddress(), "Sunset_Evologics_RangingReply_Timer::start busy ERROR");
+		SUNSET_DEBUG_LOG(-1, modem->getModuleAddress(), "Sunset_Evologics_RangingReply_Timer::start busy ERROR");
 	
 		return;
 	} 
@@ -2743,10 +2843,19 @@ void Sunset_Evologics_DeliveryStatus_Timer::handle(Event *)
 
 void Sunset_Evologics_v1_6::modemBurstMsgRespTimeout() 
 {
-	Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::modemBurstMsgRespTimeout() Data burst: No response from modem!");
-	setState(EV_IDLE);
+	SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::modemBurstMsgRespTimeout() Data burst: No response from modem!");
 	
 	txAborted();
+	
+	if (burstAcked_ > 0) {
+		
+		timeoutBurstResp_.start(EV_TIMEOUT_BURSTRESP);
+	}
+	
+	if (getState() != EV_DATA_BURST) {
+		
+		setState(txIdleState());
+	}
 }
 
 void Sunset_Evologics_BurstMsgResp_Timer::handle(Event *) 
@@ -2759,6 +2868,16 @@ void Sunset_Evologics_BurstMsgResp_Timer::handle(Event *)
 	((Sunset_Evologics_v1_6*)modem)->modemBurstMsgRespTimeout();
 }
 
+void Sunset_Evologics_TxPump_Timer::handle(Event *) 
+{       
+	busy_ = 0;
+	paused_ = 0;
+	stime = 0.0;
+	rtime = 0.0;
+	
+	((Sunset_Evologics_v1_6*)modem)->txPump();
+}
+
 void Sunset_Evologics_Start_Connection::handle(Event *) 
 {       
 	busy_ = 0;
@@ -2776,20 +2895,18 @@ void Sunset_Evologics_Rx_Timer::handle(Event *)
 	stime = 0.0;
 	rtime = 0.0;
 	
-	((Sunset_Evologics_v1_6*)modem)->processRxInfo();
-        
-	if (!(((Sunset_Evologics_v1_6*)modem)->rx_info).empty()) {
+	(((Sunset_Evologics_v1_6*)modem)->rxChannel_).wakeupDone();
 	
-		handle((Event*)0);
+	while (!(((Sunset_Evologics_v1_6*)modem)->rxChannel_).empty()) {
 		
-		return;
-	} 
+		((Sunset_Evologics_v1_6*)modem)->processRxInfo();
+	}
 }
 
 void Sunset_Evologics_v1_6::handleConnection() 
 {
 	
-	Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::handleConnection retry");
+	SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::handleConnection retry");
 	
 	setState(EV_IDLE);
 	
@@ -2811,7 +2928,7 @@ void Sunset_Evologics_v1_6::modemDeliveryTimeout()
 		
 		if ( deliveryRetry >= EV_TIMEOUT_DLV_MAX_RET ) {
 			
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::modemDeliveryTimeout() Max pkt status retry (%d) reached -> ABORTED ", deliveryRetry);
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::modemDeliveryTimeout() Max pkt status retry (%d) reached -> ABORTED ", deliveryRetry);
 
 			setState(EV_IDLE);
 			
@@ -2824,7 +2941,7 @@ void Sunset_Evologics_v1_6::modemDeliveryTimeout()
 		
 		if ( checkDeliveryStatus() == false ) {
 			
-			Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Evologics_v1_6::modemDeliveryTimeout() check_delivery ");
+			SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Evologics_v1_6::modemDeliveryTimeout() check_delivery ");
 		
 			setState(EV_IDLE);
 			
@@ -2835,7 +2952,7 @@ void Sunset_Evologics_v1_6::modemDeliveryTimeout()
 			return;
 		}
 		
-		Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Evologics_v1_6::modemDeliveryTimeout() -> Retry (%d)", deliveryRetry);
+		SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Evologics_v1_6::modemDeliveryTimeout() -> Retry (%d)", deliveryRetry);
 		
 		if (timeoutDeliv_.busy()) {
 			
@@ -2844,13 +2961,13 @@ void Sunset_Evologics_v1_6::modemDeliveryTimeout()
 		
 		if (deliveryRetry == 0 && tx_time > 0.0) {
 			
-			Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Evologics_v1_6::modemDeliveryTimeout() delay tx time %f deliveryRetry %d", tx_time, deliveryRetry);
+			SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Evologics_v1_6::modemDeliveryTimeout() delay tx time %f deliveryRetry %d", tx_time, deliveryRetry);
 			
 			timeoutDeliv_.start(tx_time);
 		} 
 		else {
 			
-			Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Evologics_v1_6::modemDeliveryTimeout() delay %f deliveryRetry %d", EV_TIMEOUT_DLV, deliveryRetry);
+			SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Evologics_v1_6::modemDeliveryTimeout() delay %f deliveryRetry %d", EV_TIMEOUT_DLV, deliveryRetry);
 			
 			timeoutDeliv_.start(EV_TIMEOUT_DLV);	
 		}
@@ -2884,7 +3001,7 @@ int Sunset_Evologics_v1_6::notify_info(list<notified_info> linfo)
 				
 				if (getState() != EV_IDLE) {
 				
-					Sunset_Debug::debugInfo(1, getModuleAddress(), "Sunset_Evologics_v1_6::notify_info OVERRIDE STATE to write tx power %d", val_int);
+					SUNSET_DEBUG_LOG(1, getModuleAddress(), "Sunset_Evologics_v1_6::notify_info OVERRIDE STATE to write tx power %d", val_int);
 				}
 				
 				setState(EV_SETTING);
@@ -2898,7 +3015,7 @@ int Sunset_Evologics_v1_6::notify_info(list<notified_info> linfo)
 				
 			}
 			
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::notify_info tx power %d", (int)val_double);
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::notify_info tx power %d", (int)val_double);
 			
 			return 1;
 		}
@@ -2911,13 +3028,13 @@ int Sunset_Evologics_v1_6::notify_info(list<notified_info> linfo)
 			
 			mac_slot = val_int;
 			
-			Sunset_Debug::debugInfo(1, getModuleAddress(), "Sunset_Evologics_v1_6::notify_info mac slot %d", val_int);
+			SUNSET_DEBUG_LOG(1, getModuleAddress(), "Sunset_Evologics_v1_6::notify_info mac slot %d", val_int);
 			
 			return 1;
 		}
 	}
 	
-	Sunset_Debug::debugInfo(1, getModuleAddress(), "Sunset_Evologics_v1_6::notify_info NOTHING TO DO");
+	SUNSET_DEBUG_LOG(1, getModuleAddress(), "Sunset_Evologics_v1_6::notify_info NOTHING TO DO");
 	
 	return Sunset_Generic_Modem::notify_info(linfo); 
 } 
@@ -2938,19 +3055,19 @@ int Sunset_Evologics_v1_6::setTxPower(int node, int tx_level, double time)
 	
 	if ( sid->assign_value(&tx_level, &ni, sizeof(int)) == false) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::setTxPower ERROR ASSIGINING INFO %s", (ni.info_name).c_str());
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::setTxPower ERROR ASSIGINING INFO %s", (ni.info_name).c_str());
 		
 		return 0;	
 	}	
 	
 	if ( sid->set(getModuleAddress(), sid_id, ni) == 0 ) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Evologics_v1_6::setTxPower PROVIDING INFO %s NOT DEFINED", (ni.info_name).c_str());
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Evologics_v1_6::setTxPower PROVIDING INFO %s NOT DEFINED", (ni.info_name).c_str());
 	
 		return 0;
 	}
 	
-	Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Evologics_v1_6::setTxPower node %d val %d", (node), tx_level);
+	SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Evologics_v1_6::setTxPower node %d val %d", (node), tx_level);
 	
 	return 1;	
 }
\ No newline at end of file
@@ -24,6 +24,8 @@
 #include "sunset_evologics_include.h"
 #include "sunset_evologics_connection.h"
 #include "sunset_evologics_def.h"
+#include <sunset_rx_channel.h>
+#include <sunset_modem_tx_pipeline.h>
 
 #define EV_ATT_REQUEST_TIME_1_6 	0.2
 
@@ -127,6 +129,18 @@ protected:
 	
 };
 
+/*! @brief Timer used to write to the modem the next packet of the transmission pipeline. */
+
+class Sunset_Evologics_TxPump_Timer : public Sunset_Generic_ModemTimer {
+	
+public:
+	Sunset_Evologics_TxPump_Timer(Sunset_Evologics_v1_6 *m) : Sunset_Generic_ModemTimer((Sunset_Generic_Modem*)m) { }
+	
+protected:
+	virtual void handle (Event *e);
+	
+};
+
 /*! @brief This class implements the  Evologics Modem (firmware version 1.6) driver. It extends the generic modem class.
  * @see class Sunset_Generic_Modem
  */
@@ -143,6 +157,7 @@ public:
 	friend class Sunset_Evologics_RTT_Timer;		/*!< @brief Modem reply timer for reply with synchronous instant message. */
 	friend class Sunset_Evologics_Start_Connection;		/*!< @brief modem reconnection timer. */
 	friend class Sunset_Evologics_Rx_Timer;             	/*!<@brief timer call from listening thread to process received information. */
+	friend class Sunset_Evologics_TxPump_Timer;		/*!< @brief timer writing the next packet of the transmission pipeline. */
 	
 	Sunset_Evologics_v1_6();
 	~Sunset_Evologics_v1_6();
@@ -164,6 +179,7 @@ protected:
 	Sunset_Evologics_RangingReply_Timer rangingTimer_;
 	Sunset_Evologics_Start_Connection connectionTimer_;
 	Sunset_Evologics_Rx_Timer rxTimer_;
+	Sunset_Evologics_TxPump_Timer txPumpTimer_;
 	
 	virtual void checkSetting();			//control if other modem settings have to be performed
 	
@@ -182,8 +198,6 @@ protected:
 	
 	virtual bool processRxInfo();
 
-	pthread_mutex_t mutex_evo_1_6_timer_rx;
-	
 	pthread_mutex_t mutex_evo_1_6_timer_connection;
 
 
@@ -226,6 +240,11 @@ public:
 	
 	virtual void modemDeliveryTimeout();	//timeout when checking about modem delivering operation
 	virtual void modemBurstMsgRespTimeout();	//timeout on burst data transmission
+	
+	void txPump();			//write to the modem the packets waiting in the transmission pipeline
+	void scheduleTxPump();		//schedule txPump once the current event has been processed
+	void txCommandAborted();	//abort the packet whose command has not been accepted by the modem
+	int txIdleState();		//state of the driver when no command is waiting for the modem reply
 	void handleConnection();	//used to repeat connection operation in case of error
 	
 	int useBurst;			/*!< @brief if set to one data are transmitted in burst mode instead of using instan messages. */
@@ -288,7 +307,13 @@ protected:
 	
 	double tx_time;
 	
-	list< pair<char*, int > > rx_info;
+	Sunset_Rx_Channel rxChannel_;	//information received by the listener thread
+	
+	Sunset_Modem_Tx_Pipeline txPipe_;	//packets converted and waiting to be written to the modem
+	
+	int txWindow_;		//maximum number of data bursts written to the modem and not yet completed
+	int txMaxPending_;	//maximum number of packets waiting in the transmission pipeline
+	int burstAcked_;	//data bursts accepted by the modem (OK) waiting for the delivery report
 	
 };
 
@@ -34,7 +34,7 @@ Sunset_Evologics_Conn::~Sunset_Evologics_Conn() {
 
 bool Sunset_Evologics_Conn::open_connection() {
 	
-	Sunset_Debug::debugInfo(4, -1, "DRIVER_EVO connecting to %s port %d", get_ip(), get_port());
+	SUNSET_DEBUG_LOG(4, -1, "DRIVER_EVO connecting to %s port %d", get_ip(), get_port());
 	
 	return Sunset_Tcp_Client_Connection::open_connection();
 }
@@ -43,234 +43,89 @@ bool Sunset_Evologics_Conn::open_connection() {
 
 bool Sunset_Evologics_Conn::close_connection() {
 	
-	Sunset_Debug::debugInfo(4, -1, "DRIVER_EVO close_connection to %s port %ld", get_ip(), get_port());
+	SUNSET_DEBUG_LOG(4, -1, "DRIVER_EVO close_connection to %s port %ld", get_ip(), get_port());
 	
 	return Sunset_Tcp_Client_Connection::close_connection();
 }
 
 
-/*!	@brief The read_data() function reads from the TCP socket looking for packet delimiter to extract the packet received by the modem which has to be provided to the upper layers.
- *	@param buf The buffer to be read.
- *	@param maxlen The maximal length of the buffer.
- * 	@retval nbytes The number of bytes correctly read.
+/*!	@brief The read_message() function extracts the next message received by the modem. All the bytes available on the 
+ *	socket are read at once and the message is returned in place, together with its type, without copying it. 
+ *	The binary payload of the received data messages is extracted using the length declared in the message header.
+ *	@param[out] msg The pointer to the message, without the terminating "\r\n", valid until the next call.
+ *	@param[out] type The type of the message (EV_MSG_*).
+ *	@param max_len The maximum length of a message.
+ * 	@retval The length of the message, 0 if no message has been received before the timeout, EV_READ_* on error.
  */
 
-int Sunset_Evologics_Conn::read_data(char *buf, int max_len) {
-	
-	int  nbytes = 0;
-	int i = 0;
-	
-	memset(buf, 0x0, max_len);
+int Sunset_Evologics_Conn::read_message(char** msg, int* type, int max_len) 
+{
+	int len = 0;
+	int res = 0;
 	
 	if ( fd <= 0 ) {
 		
-		return -1;
-		
+		return EV_READ_NO_CLIENT;
 	}
 	
-	while ((i = read(fd, buf+nbytes, sizeof(char))) >= 0)
-	{
+	while (true) {
 		
-		Sunset_Debug::debugInfo(8, -1, " Sunset_Evologics_Conn::read_data %s - len %d(%d)", buf, nbytes, i);
+		len = parser.next(reader, max_len, msg, type);
 		
-		if ( i == 0 ) {
+		if ( len > 0 ) {
 			
-			return EV_READ_NO_CLIENT;
+			SUNSET_DEBUG_LOG(6, -1, "Sunset_Evologics_Conn::read_message %s - len %d type %d", *msg, len, *type);
 			
+			return len;
 		}
 		
-		if ( i < 0 ){
-			
-			return EV_READ_ERR;
-			
-		}
-		
-		nbytes = nbytes + i;
-		
-		if ( nbytes >= max_len ) {
+		if ( len < 0 ) {
 			
 			return EV_READ_BUF_MAX;
-			
 		}
 		
-		/* If I received a EV_RECVIMS I invoke the checkData to read all the data */
+		res = reader.fill(fd, EV_POLL_TIMEOUT);
 		
-		if ( strncmp(buf, EV_RECVIMS_COMMA, strlen(EV_RECVIMS_COMMA)) == 0  && countComma(buf) == 11  ) {
+		if ( res < 0 ) {
 			
-			int l = checkData(buf, EV_IMS_BUF);
-			Sunset_Debug::debugInfo(5, -1, " Sunset_Evologics_Conn::read_data %s - len %d(%d) l %d", buf, nbytes, i, l);
-			return l;
+			SUNSET_DEBUG_LOG(-1, -1, "Sunset_Evologics_Conn::read_message reading from %s port %d ERROR", get_ip(), get_port());
 			
-		}
-		
-		/* If I received a EV_RECVIM I invoke the checkData to read all the data */
-		
-		if ( strncmp(buf, EV_RECVIM_COMMA, strlen(EV_RECVIM_COMMA)) == 0  && countComma(buf) == 10  ) {
-			
-			int l = checkData(buf, EV_IM_BUF);
-			Sunset_Debug::debugInfo(5, -1, " Sunset_Evologics_Conn::read_data___ %s - len %d(%d) l %d", buf, nbytes, i, l);
-			return l;
-			
-		}
-		
-		/* If I received a EV_RECV I invoke the checkData to read all the data */
-		
-		if ( strncmp(buf, EV_RECV_COMMA, strlen(EV_RECV_COMMA)) == 0  && countComma(buf) == 9  ) {
-			
-			return checkData(buf, EV_BURST_BUF);
-			
-		}
-		
-		/* If I received a EV_RECVFAILED I invoke the checkData to read all the data */
-		
-		if ( strcmp(buf, EV_RECVFAILED) == 0  && strstr(buf, "\r\n") != NULL  ) {
-			
-			int buflen = strlen(buf);
-			
-			buf[buflen-2] = 0x0;
-			buf[buflen-1] = 0x0;
-			
-			return strlen(buf);
+			reader.reset();
+			parser.clear();
 			
+			return EV_READ_ERR;
 		}
 		
-		/* If I have read the "\r\n" string */
-		
-		if ( strstr(buf, "\r\n") != NULL ) {
-			
-			/* If the data starts with EV_RECVIM I'll invoke the checkData to check the 
-			 payload. Else I'll simply return the string read. */
+		if ( res == 0 ) {
 			
-       			if ( strncmp(buf, EV_RECVIM, strlen(EV_RECVIM)) == 0) {
-				
-				return checkData(buf, EV_IM_BUF);
-				
-			} else {
-				
-				int buflen = strlen(buf);
-				
-				buf[buflen-2] = 0x0;
-				buf[buflen-1] = 0x0;
-				
-				return strlen(buf);
-			}
+			return 0;
 		}
-	}
-	
-	return -1;
-}
-
-int Sunset_Evologics_Conn::countComma(char *buf) {
-	
-	int i = 0;
-	int count = 0;
-	
-	for ( i = 0; i < strlen(buf); i++ ) {
 		
-		if ( buf[i] == ',' ) {
-		
-			count++;
-		}
+		SUNSET_DEBUG_LOG(8, -1, "Sunset_Evologics_Conn::read_message read %d bytes", res);
 	}
-	
-	return count;
-	
 }
 
-/*!	@brief The checkData() function extracts the payload from the Evologics packet.
- *	@param buf The buffer containing the payload.
- *	@param type The type of packet (EV_RECVIM or EV_RECV).
- * 	@retval buflen The payload length.
+/*!	@brief The read_data() function reads from the TCP socket the next message received by the modem which has to be provided to the upper layers.
+ *	@param buf The buffer where the message is copied.
+ *	@param maxlen The maximal length of the buffer.
+ * 	@retval nbytes The number of bytes correctly read.
  */
 
-int Sunset_Evologics_Conn::checkData(char *recvb, int type) {
+int Sunset_Evologics_Conn::read_data(char *buf, int max_len) {
 	
-	char temp[EV_BUFSIZE];
-	char *tok;
+	char* msg = 0;
+	int type = 0;
 	int len = 0;
-	int i = 0;
-	int buflen = 0;
-	char* aux_mem; 
-	
-	memset(temp, 0x0, EV_BUFSIZE);
-	
-	buflen = strlen(recvb);
-	
-	strncpy(temp, recvb, strlen(recvb));
-	
-	Sunset_Debug::debugInfo(8, -1, " Sunset_BaseConnection::checkdata entering");
-	
-	tok = strtok_r(temp, ",", &aux_mem);
-	
-	int count = 8;
-	
-	if ( tok == NULL ) {
-		
-		buflen = strlen(recvb);
-		
-		return strlen(recvb);
-		
-	}
-	
-	if ( type == EV_IM_BUF ) {
-		
-		tok = strtok_r(NULL, ",", &aux_mem);
-		
-		if ( tok == NULL ) {
-			
-			buflen = strlen(recvb);
-			
-			return strlen(recvb);
-			
-		}
-		
-	}
 	
-	if ( type == EV_IMS_BUF ) {
-		
-		tok = strtok_r(NULL, ",", &aux_mem);
-		
-		if ( tok == NULL ) {
-			
-			buflen = strlen(recvb);
-			
-			return strlen(recvb);
-			
-		}
-		
-		count = 9;
-		
-	}
-
-	/* I store the length of the payload extracted from the buffer */
-	
-	len = atoi(tok);
+	len = read_message(&msg, &type, max_len);
 	
-	while( i++ < count ){
+	if ( len <= 0 ) {
 		
-		tok = strtok_r(NULL, ",", &aux_mem);
-		
-		if ( tok == NULL ) {
-			
-			Sunset_Debug::debugInfo(8, -1, " Sunset_BaseConnection::checkdata exit");
- 			
-			return strlen(recvb);
-			
-		}
+		return len;
 	}
 	
-	i = 0;
-	
-	/* I read all the "len" data + "\r\n" */
-	
-	i = read(get_fd(), recvb+buflen, len+2);
+	memcpy(buf, msg, len);
+	buf[len] = '\0';
 	
-	if ( i < 0 ) {
-
-		return i;
-	}
-	
-	
-	return buflen+len;
+	return len;
 }
-
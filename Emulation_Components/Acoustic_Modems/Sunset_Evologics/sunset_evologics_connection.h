@@ -23,11 +23,15 @@
 #define __Sunset_Evologics_Conn_h__  
 
 #include <sunset_tcp_client.h>
+#include <sunset_frame_reader.h>
+#include "sunset_evologics_parser.h"
 
 #define EV_READ_NO_CLIENT	-1
 #define EV_READ_ERR		-2
 #define EV_READ_BUF_MAX		-3
 
+#define EV_POLL_TIMEOUT		1000	/*!< @brief Maximum time (ms) waiting for data on the socket. */
+
 #define EV_CONN_NO_SOCK 	-1
 #define EV_CONN_NO_ADDR 	-2
 #define EV_CONN_NO_CONN 	-3
@@ -35,10 +39,6 @@
 #define EV_CONN_NO_TCGET 	-5
 #define EV_CONN_NO_TCSET 	-6
 
-#define EV_IM_BUF	0
-#define EV_BURST_BUF	1
-#define EV_IMS_BUF	2
-
 /*! @brief This class is used for the connection to the Evologics Modem. A TCP connection is used.
  */
 
@@ -50,12 +50,13 @@ public:
 	
 public:
 	virtual int read_data(char *recvb, int max_len);
+	int read_message(char** msg, int* type, int max_len);
 	virtual bool open_connection();
 	virtual bool close_connection();
 	
 protected:
-	virtual int checkData(char *, int);
-	int countComma(char *);
+	Sunset_Frame_Reader reader;	// buffered reader of the socket
+	Sunset_Evologics_Parser parser;	// incremental parser of the modem messages
 };
 
 #endif
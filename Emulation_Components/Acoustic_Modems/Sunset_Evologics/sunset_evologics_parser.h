@@ -0,0 +1,366 @@
+/* SUNSET - Sapienza University Networking framework for underwater Simulation, Emulation and real-life Testing
+ *
+ * Copyright (C) 2012 Regents of UWSN Group of SENSES Lab <http://reti.dsi.uniroma1.it/SENSES_lab/>
+ *
+ * Authors: Roberto Petroccia - petroccia@di.uniroma1.it
+ *          Daniele Spaccini - spaccini@di.uniroma1.it
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License as published
+ * at http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANATBILITY or FITNESS FOR A PARTICULAR PURPOSE. See the Creative Commons
+ * Attribution-NonCommercial-ShareAlike 3.0 Unported License for more details.
+ *
+ * You should have received a copy of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License
+ * along with this program. If not, see <http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode>.
+ */
+
+#ifndef __Sunset_Evologics_Parser_h__
+#define __Sunset_Evologics_Parser_h__
+
+#include <string.h>
+
+#include <sunset_frame_reader.h>
+#include "sunset_evologics_def.h"
+
+/*! @brief Types of the messages received from the Evologics modem. */
+
+enum {
+	EV_MSG_OTHER = 0,		/*!< @brief Any other message (e.g. a number returned by a query command). */
+	EV_MSG_OK,			/*!< @brief "OK" or "[*]OK". */
+	EV_MSG_BUSY,			/*!< @brief "BUSY". */
+	EV_MSG_ERROR_WRONG_FORMAT,	/*!< @brief "ERROR WRONG FORMAT". */
+	EV_MSG_CANCELEDIM,		/*!< @brief "CANCELEDIM...". */
+	EV_MSG_RECVFAILED,		/*!< @brief "RECVFAILED...". */
+	EV_MSG_RECVIMS,			/*!< @brief "RECVIMS...", synchronous instant message. */
+	EV_MSG_RECVIM,			/*!< @brief "RECVIM...", instant message. */
+	EV_MSG_RECV,			/*!< @brief "RECV,...", burst message. */
+	EV_MSG_RECV_OTHER,		/*!< @brief Any other "RECV..." notification. */
+	EV_MSG_DELIVERING,		/*!< @brief "DELIVERING...". */
+	EV_MSG_EMPTY,			/*!< @brief "EMPTY...". */
+	EV_MSG_DELIVEREDIM,		/*!< @brief "DELIVEREDIM...". */
+	EV_MSG_DELIVERED,		/*!< @brief "DELIVERED...". */
+	EV_MSG_FAILEDIM,		/*!< @brief "FAILEDIM...". */
+	EV_MSG_FAILED			/*!< @brief "FAILED...". */
+};
+
+/*! @brief This class implements the incremental parser of the message stream received from the Evologics modem. 
+ *  The messages are extracted in place from a Sunset_Frame_Reader: a line is terminated by "\r\n" while the received 
+ *  data messages (RECVIMS, RECVIM and RECV) carry a binary payload whose length is given by the first field. The scan 
+ *  state is kept across the reader fills, so each byte is examined once and the payload is never scanned. The message 
+ *  type is computed once, when the keyword is complete, and it is returned together with the message.
+ */
+
+class Sunset_Evologics_Parser {
+	
+public:
+	
+	Sunset_Evologics_Parser() { clear(); }
+	
+	/*! @brief The next function extracts the next complete message buffered by the reader. The terminating "\r\n" is 
+	 *  overwritten with '\0' and it is not included in the returned length.
+	 *  @param maxLen The maximum length of a message, longer messages are dropped.
+	 *  @param[out] msg The pointer to the message, in the reader buffer, valid until the next fill of the reader.
+	 *  @param[out] type The type of the message.
+	 *  @retval The length of the message, 0 if no complete message is available, -1 if a message longer than maxLen has been dropped.
+	 */
+	
+	int next(Sunset_Frame_Reader& reader, int maxLen, char** msg, int* type) 
+	{
+		char* b = 0;
+		int n = reader.peek(&b);
+		int len = 0;
+		char c = 0;
+		
+		if ( n < pos_ ) {
+			
+			// the reader has dropped its content
+			
+			clear();
+		}
+		
+		while ( need_ == 0 && pos_ < n ) {
+			
+			c = b[pos_];
+			
+			if ( c == ',' ) {
+				
+				comma(b);
+			}
+			else if ( c == '\r' ) {
+				
+				if ( pos_ + 1 >= n ) {
+					
+					return 0;	// wait for the next character
+				}
+				
+				if ( b[pos_ + 1] == '\n' ) {
+					
+					if ( commas_ == 0 ) {
+						
+						type_ = classify(b, pos_);
+					}
+					
+					len = pos_;
+					need_ = len + 2;
+					
+					break;
+				}
+			}
+			
+			pos_++;
+			
+			if ( pos_ >= maxLen ) {
+				
+				break;
+			}
+		}
+		
+		if ( need_ == 0 ) {
+			
+			if ( pos_ < maxLen ) {
+				
+				return 0;
+			}
+			
+			// drop what has been received so far, the rest of the message will be dropped as an unknown line
+			
+			SUNSET_DEBUG_LOG(-1, -1, "Sunset_Evologics_Parser::next message longer than %d bytes ERROR", maxLen);
+			
+			reader.take(pos_, &b);
+			clear();
+			
+			return -1;
+		}
+		
+		if ( need_ - 2 >= maxLen ) {
+			
+			// the payload does not fit: it is skipped as soon as it is available
+			
+			if ( n < need_ ) {
+				
+				return 0;
+			}
+			
+			SUNSET_DEBUG_LOG(-1, -1, "Sunset_Evologics_Parser::next message of %d bytes longer than %d ERROR", need_ - 2, maxLen);
+			
+			reader.take(need_, &b);
+			clear();
+			
+			return -1;
+		}
+		
+		if ( n < need_ ) {
+			
+			return 0;
+		}
+		
+		len = need_ - 2;
+		
+		if ( b[len] != '\r' || b[len + 1] != '\n' ) {
+			
+			SUNSET_DEBUG_LOG(-1, -1, "Sunset_Evologics_Parser::next payload of %d bytes not terminated by \\r\\n ERROR", payloadLen_);
+		}
+		
+		reader.take(need_, msg);
+		
+		(*msg)[len] = '\0';
+		*type = type_;
+		
+		clear();
+		
+		return len;
+	}
+	
+	/*! @brief The classify function returns the type of the message "buf" of "len" bytes. OK, BUSY and ERROR WRONG 
+	 *  FORMAT have to match the whole message, the other types are identified by their prefix.
+	 */
+	
+	static int classify(const char* buf, int len) 
+	{
+		if ( len <= 0 ) {
+			
+			return EV_MSG_OTHER;
+		}
+		
+		switch ( buf[0] ) {
+				
+			case 'O':
+				
+				return match(buf, len, EV_OK) ? EV_MSG_OK : EV_MSG_OTHER;
+				
+			case '[':
+				
+				return match(buf, len, EV_OK2) ? EV_MSG_OK : EV_MSG_OTHER;
+				
+			case 'B':
+				
+				return match(buf, len, EV_BUSY) ? EV_MSG_BUSY : EV_MSG_OTHER;
+				
+			case 'E':
+				
+				if ( match(buf, len, EV_ERROR_WRONG_FORMAT) ) {
+					
+					return EV_MSG_ERROR_WRONG_FORMAT;
+				}
+				
+				return prefix(buf, len, EV_EMPTY) ? EV_MSG_EMPTY : EV_MSG_OTHER;
+				
+			case 'C':
+				
+				return prefix(buf, len, EV_CANCELEDIM) ? EV_MSG_CANCELEDIM : EV_MSG_OTHER;
+				
+			case 'R':
+				
+				if ( !prefix(buf, len, EV_RECV) ) {
+					
+					return EV_MSG_OTHER;
+				}
+				
+				if ( prefix(buf, len, EV_RECVIMS) ) {
+					
+					return EV_MSG_RECVIMS;
+				}
+				
+				if ( prefix(buf, len, EV_RECVIM) ) {
+					
+					return EV_MSG_RECVIM;
+				}
+				
+				if ( prefix(buf, len, EV_RECVFAILED) ) {
+					
+					return EV_MSG_RECVFAILED;
+				}
+				
+				return (len == (int)strlen(EV_RECV) || buf[strlen(EV_RECV)] == ',') ? EV_MSG_RECV : EV_MSG_RECV_OTHER;
+				
+			case 'D':
+				
+				if ( prefix(buf, len, EV_DELIVEREDIM) ) {
+					
+					return EV_MSG_DELIVEREDIM;
+				}
+				
+				if ( prefix(buf, len, EV_DELIVERED) ) {
+					
+					return EV_MSG_DELIVERED;
+				}
+				
+				return prefix(buf, len, EV_DELIVERING) ? EV_MSG_DELIVERING : EV_MSG_OTHER;
+				
+			case 'F':
+				
+				if ( prefix(buf, len, EV_FAILEDIM) ) {
+					
+					return EV_MSG_FAILEDIM;
+				}
+				
+				return prefix(buf, len, EV_FAILED) ? EV_MSG_FAILED : EV_MSG_OTHER;
+				
+			default:
+				
+				return EV_MSG_OTHER;
+		}
+	}
+	
+	/*! @brief The isRecvIm function returns true for the types starting with "RECVIM". */
+	static bool isRecvIm(int type) { return type == EV_MSG_RECVIM || type == EV_MSG_RECVIMS; }
+	
+	/*! @brief The isRecv function returns true for the types starting with "RECV". */
+	static bool isRecv(int type) { return type >= EV_MSG_RECVFAILED && type <= EV_MSG_RECV_OTHER; }
+	
+	/*! @brief The isDelivered function returns true for the types starting with "DELIVERED". */
+	static bool isDelivered(int type) { return type == EV_MSG_DELIVERED || type == EV_MSG_DELIVEREDIM; }
+	
+	/*! @brief The isFailed function returns true for the types starting with "FAILED". */
+	static bool isFailed(int type) { return type == EV_MSG_FAILED || type == EV_MSG_FAILEDIM; }
+	
+	/*! @brief The clear function resets the scan state, it has to be called when the reader is reset. */
+	
+	void clear() 
+	{
+		pos_ = 0;
+		need_ = 0;
+		commas_ = 0;
+		dataCommas_ = 0;
+		fieldStart_ = 0;
+		payloadLen_ = 0;
+		type_ = EV_MSG_OTHER;
+	}
+	
+private:
+	
+	/*! @brief The comma function updates the scan state when the comma at position pos_ is found. */
+	
+	void comma(const char* b) 
+	{
+		commas_++;
+		
+		if ( commas_ == 1 ) {
+			
+			// the keyword is complete: only RECVIMS, RECVIM and RECV carry a binary payload after the last field
+			
+			type_ = classify(b, pos_);
+			
+			if ( type_ == EV_MSG_RECVIMS && pos_ == (int)strlen(EV_RECVIMS) ) {
+				
+				dataCommas_ = 11;
+			}
+			else if ( type_ == EV_MSG_RECVIM && pos_ == (int)strlen(EV_RECVIM) ) {
+				
+				dataCommas_ = 10;
+			}
+			else if ( type_ == EV_MSG_RECV ) {
+				
+				dataCommas_ = 9;
+			}
+		}
+		else if ( commas_ == 2 && dataCommas_ > 0 ) {
+			
+			// the first field is the payload length
+			
+			payloadLen_ = 0;
+			
+			for ( int i = fieldStart_; i < pos_ && b[i] >= '0' && b[i] <= '9'; i++ ) {
+				
+				payloadLen_ = payloadLen_ * 10 + (b[i] - '0');
+			}
+		}
+		
+		if ( dataCommas_ > 0 && commas_ == dataCommas_ ) {
+			
+			need_ = pos_ + 1 + payloadLen_ + 2;
+		}
+		
+		fieldStart_ = pos_ + 1;
+	}
+	
+	/*! @brief The match function returns true if the message is equal to "s". */
+	
+	static bool match(const char* buf, int len, const char* s) 
+	{
+		return len == (int)strlen(s) && memcmp(buf, s, len) == 0;
+	}
+	
+	/*! @brief The prefix function returns true if the message starts with "s". */
+	
+	static bool prefix(const char* buf, int len, const char* s) 
+	{
+		int l = strlen(s);
+		
+		return len >= l && memcmp(buf, s, l) == 0;
+	}
+	
+	int pos_;		// first byte of the current message not yet scanned
+	int need_;		// total length of the current message (terminator included), 0 if not known yet
+	int commas_;		// commas found in the current message
+	int dataCommas_;	// commas preceding the payload, 0 if the message has no payload
+	int fieldStart_;	// first byte of the current field
+	int payloadLen_;	// declared payload length
+	int type_;		// type of the current message
+};
+
+#endif
@@ -0,0 +1,152 @@
+/* SUNSET - Sapienza University Networking framework for underwater Simulation, Emulation and real-life Testing
+ *
+ * Copyright (C) 2012 Regents of UWSN Group of SENSES Lab <http://reti.dsi.uniroma1.it/SENSES_lab/>
+ *
+ * Author: Roberto Petroccia - petroccia@di.uniroma1.it
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License as published
+ * at http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANATBILITY or FITNESS FOR A PARTICULAR PURPOSE. See the Creative Commons
+ * Attribution-NonCommercial-ShareAlike 3.0 Unported License for more details.
+ *
+ * You should have received a copy of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License
+ * along with this program. If not, see <http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode>.
+ */
+
+
+#ifndef __Sunset_Modem_Tx_Pipeline_h__
+#define __Sunset_Modem_Tx_Pipeline_h__
+
+#include <stdlib.h>
+#include <list>
+
+#include <packet.h>
+
+#define SUNSET_TX_PIPELINE_PENDING	16	/*!< @brief Default maximum number of frames waiting to be written to the modem. */
+
+using namespace std;
+
+/*! @brief A packet already converted into the stream of bytes to be written to the modem. */
+
+typedef struct sunset_tx_frame {
+	
+	Packet* p;	// packet notified to the upper layer once the transmission is completed
+	char* buffer;	// converted packet, owned by the pipeline
+	int len;
+	int dst;	// modem destination address
+	
+} sunset_tx_frame;
+
+/*! @brief This class implements the transmission pipeline of the modem drivers. The packets received from the upper layer 
+ *  are converted as soon as they arrive, while the modem is still transmitting the previous ones, and they wait here until 
+ *  the driver can write them. The number of packets handed to the modem and not yet completed (in flight) is bounded by 
+ *  the window: a credit is consumed when a frame is written and it is returned when the modem reports the delivery or 
+ *  the failure of the oldest packet in flight. The packets in flight are kept by the driver (pktTxList) in the order 
+ *  they have been written.
+ */
+
+class Sunset_Modem_Tx_Pipeline {
+	
+public:
+	
+	Sunset_Modem_Tx_Pipeline(int window = 1, int maxPending = SUNSET_TX_PIPELINE_PENDING) 
+	{
+		setWindow(window);
+		setMaxPending(maxPending);
+	}
+	
+	~Sunset_Modem_Tx_Pipeline() 
+	{
+		while ( !pending_.empty() ) {
+			
+			pop();
+		}
+	}
+	
+	/*! @brief The setWindow function sets the maximum number of packets in flight, at least one. */
+	void setWindow(int window) { window_ = (window < 1) ? 1 : window; }
+	
+	/*! @brief The setMaxPending function sets the maximum number of frames waiting to be written, at least one. */
+	void setMaxPending(int maxPending) { maxPending_ = (maxPending < 1) ? 1 : maxPending; }
+	
+	int getWindow() { return window_; }
+	
+	/*! @brief The push function queues a converted packet, the pipeline takes the ownership of the buffer.
+	 *  @retval false If the pipeline is full, the buffer is then still owned by the caller.
+	 */
+	
+	bool push(Packet* p, char* buffer, int len, int dst) 
+	{
+		sunset_tx_frame f;
+		
+		if ( (int)pending_.size() >= maxPending_ ) {
+			
+			return false;
+		}
+		
+		f.p = p;
+		f.buffer = buffer;
+		f.len = len;
+		f.dst = dst;
+		
+		pending_.push_back(f);
+		
+		return true;
+	}
+	
+	/*! @brief The ready function returns true if a frame is waiting and a credit is available. 
+	 *  @param inFlight The number of packets handed to the modem and not yet completed.
+	 */
+	
+	bool ready(int inFlight) { return !pending_.empty() && inFlight < window_; }
+	
+	/*! @brief The front function returns the oldest frame waiting to be written, 0 if none. */
+	
+	sunset_tx_frame* front() 
+	{
+		if ( pending_.empty() ) {
+			
+			return 0;
+		}
+		
+		return &(pending_.front());
+	}
+	
+	/*! @brief The pop function removes the oldest frame, once written or dropped, and frees its buffer.
+	 *  @retval The packet of the removed frame, 0 if none.
+	 */
+	
+	Packet* pop() 
+	{
+		Packet* p = 0;
+		
+		if ( pending_.empty() ) {
+			
+			return 0;
+		}
+		
+		p = pending_.front().p;
+		
+		free(pending_.front().buffer);
+		
+		pending_.pop_front();
+		
+		return p;
+	}
+	
+	/*! @brief The pending function returns the number of frames waiting to be written. */
+	int pending() { return (int)pending_.size(); }
+	
+private:
+	
+	list<sunset_tx_frame> pending_;
+	
+	int window_;		// maximum number of packets in flight
+	int maxPending_;	// maximum number of frames waiting to be written
+};
+
+#endif
@@ -24,7 +24,6 @@
 #include <sunset_micro_modem.h>
 
 extern "C" void *ThreadStartupMicroModem_listen(void *);
-pthread_mutex_t mutex_mm_timer_rx;
 pthread_mutex_t mutex_mm_timer_connection;
 
 void Sunset_MM_TimeoutTimer::handle(Event *) 
@@ -51,6 +50,9 @@ void Sunset_MM_RecvTimer::handle(Event *)
 	paused_ = 0;
 	stime = 0.0;
 	rtime = 0.0;
+	
+	(((Sunset_MicroModem*)modem)->rxChannel_).wakeupDone();
+	
 	((Sunset_MicroModem*)modem)->recvBufferData();
 }
 
@@ -81,7 +83,7 @@ public:
 	
 } class_Sunset_MicroModem;
 
-Sunset_MicroModem::Sunset_MicroModem() : Sunset_Generic_Modem(), timeoutTimer_(this), setupTimer_(this), recvTimer_(this), reconnTimer_(this)
+Sunset_MicroModem::Sunset_MicroModem() : Sunset_Generic_Modem(), timeoutTimer_(this), setupTimer_(this), recvTimer_(this), reconnTimer_(this), rxChannel_(UMMAXMSSZ)
 {
 	modem_checkSum = 0;
 	USE_ACK = 0;
@@ -109,7 +111,7 @@ Sunset_MicroModem::Sunset_MicroModem() : Sunset_Generic_Modem(), timeoutTimer_(t
 	
 	if (USE_ASCII == USE_HEX) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_MicroModem set up USE_HEX = USE_ASCII ERROR");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_MicroModem set up USE_HEX = USE_ASCII ERROR");
 		
 		return;   //TODO: it's just to avoid exiting the simulation
 		exit(1);
@@ -117,13 +119,13 @@ Sunset_MicroModem::Sunset_MicroModem() : Sunset_Generic_Modem(), timeoutTimer_(t
 	
 	if (MODEM_RATE > 6 || MODEM_RATE < 0) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_MicroModem set up MODEM RATE %d ERROR", MODEM_RATE);
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_MicroModem set up MODEM RATE %d ERROR", MODEM_RATE);
 		
 		return;   //TODO: it's just to avoid exiting the simulation
 		exit(1);
 	}
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem use ack %d miniPkt %d rate %d hex %d ascii %d agn %d", USE_ACK, useMiniPkt, MODEM_RATE, USE_HEX, USE_ASCII, AGN_VALUE);
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem use ack %d miniPkt %d rate %d hex %d ascii %d agn %d", USE_ACK, useMiniPkt, MODEM_RATE, USE_HEX, USE_ASCII, AGN_VALUE);
 	
 	STATE = MM_S_WAIT_CMD;
 	d_status = MM_DRIVER_IDLE;
@@ -131,7 +133,7 @@ Sunset_MicroModem::Sunset_MicroModem() : Sunset_Generic_Modem(), timeoutTimer_(t
 	
 	mm_messages = new MicroModem_Messages();
 	
-	pthread_mutex_init(&mutex_mm_timer_rx, NULL);
+	rxChannel_.setHandler(&recvTimer_);
 	pthread_mutex_init(&mutex_mm_timer_connection, NULL);
 }
 
@@ -139,7 +141,6 @@ Sunset_MicroModem::~Sunset_MicroModem()
 {
 	listening = 0;
 	
-	pthread_mutex_destroy(&mutex_mm_timer_rx);
 	pthread_mutex_destroy(&mutex_mm_timer_connection);
 	
 	disconnect(mm_conn->get_fd());
@@ -161,7 +162,7 @@ int Sunset_MicroModem::command( int argc, const char * const * argv )
 			
 			modem_checkSum = atoi(argv[2]);
 			
-			Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_MicroModem::command use checkSum %ld", modem_checkSum);
+			SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_MicroModem::command use checkSum %ld", modem_checkSum);
 			
 			return TCL_OK;
 		}
@@ -170,7 +171,7 @@ int Sunset_MicroModem::command( int argc, const char * const * argv )
 			
 			mmControl = atoi(argv[2]);
 			
-			Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_MicroModem::command use mmControl %d", mmControl);
+			SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_MicroModem::command use mmControl %d", mmControl);
 			
 			return TCL_OK;
 		}
@@ -216,11 +217,11 @@ int Sunset_MicroModem::connect()
 	int x = 0;
 	listening = 0;
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_MicroModem::connect connecting to %s baudRate %ld", devName, baudRate);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_MicroModem::connect connecting to %s baudRate %ld", devName, baudRate);
 	
 	if (!devName || baudRate == 0) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_MicroModem::connect devName has not been defined ERROR");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_MicroModem::connect devName has not been defined ERROR");
 		
 		exit(1);
 	}
@@ -245,7 +246,7 @@ int Sunset_MicroModem::connect()
 		return 0;
 	}
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_MicroModem::connect connection done");
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_MicroModem::connect connection done");
 
 	listening = 1;
 	
@@ -253,12 +254,12 @@ int Sunset_MicroModem::connect()
 	
 	if ( rc != 0 ) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_MicroModem::connect initialize reading thread ERROR on %s baud %d", mm_conn->getDevName(), mm_conn->getIntBaudRate());
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_MicroModem::connect initialize reading thread ERROR on %s baud %d", mm_conn->getDevName(), mm_conn->getIntBaudRate());
 		
 		exit(1);
 	}
 	else {
-		Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_MicroModem::connect initialize reading thread to %s baud %ld DONE", mm_conn->getDevName(), mm_conn->getIntBaudRate());
+		SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_MicroModem::connect initialize reading thread to %s baud %ld DONE", mm_conn->getDevName(), mm_conn->getIntBaudRate());
 	}
 	
 	if ( mmControl == 1 ) {
@@ -268,7 +269,7 @@ int Sunset_MicroModem::connect()
 	
 	x = mm_conn->get_fd();
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_MicroModem::connect connecting fd = %d", x);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_MicroModem::connect connecting fd = %d", x);
 	
 	return x;
 }
@@ -292,14 +293,14 @@ int Sunset_MicroModem::addSetUpCmd(char* cmd, int req)
 		return 0;
 	}
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_MicroModem::addSetUpCmd %s - %d", cmd, req);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_MicroModem::addSetUpCmd %s - %d", cmd, req);
 	
 	len = strlen(cmd) + 1;	
 	msg = (char*) malloc(len * sizeof(char));
 	
 	if ( msg == NULL ) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_MicroModem::addSetUpCmd MALLOC ERROR");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_MicroModem::addSetUpCmd MALLOC ERROR");
 		exit(1);
 	}
 	
@@ -327,7 +328,7 @@ int Sunset_MicroModem::getSetUpInfo(char* buf, char* key, int* val)
 	char *pch;
 	char *aux_mem;
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_MicroModem::getSetUpInfo %s", buf);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_MicroModem::getSetUpInfo %s", buf);
 	
 	pch = strtok_r (buf,",", &aux_mem);
 	
@@ -354,7 +355,7 @@ int Sunset_MicroModem::getSetUpInfo(char* buf, char* key, int* val)
 	
 	*val = atoi(pch);
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_MicroModem::getSetUpInfo %s %d", key, *val);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_MicroModem::getSetUpInfo %s %d", key, *val);
 	
 	return 1;
 } 
@@ -397,7 +398,7 @@ int Sunset_MicroModem::checkSetUpCmd(char* buf)
 	
 	/* check cmd and value */
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_MicroModem::checkSetUpCmd %s - key %s val %d len %d - my key %s my val %d may len %d", buf, cafg.key, cafg.val, strlen(cafg.key), key, val, strlen(key));
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_MicroModem::checkSetUpCmd %s - key %s val %d len %d - my key %s my val %d may len %d", buf, cafg.key, cafg.val, strlen(cafg.key), key, val, strlen(key));
 	
 	if (strlen(cafg.key) == strlen(key) && 
 	    strncmp(cafg.key, key, strlen(cafg.key)) == 0 && cafg.val == val) {
@@ -405,7 +406,7 @@ int Sunset_MicroModem::checkSetUpCmd(char* buf)
 		if (strncmp(cafg.key, "XST", strlen(cafg.key)) == 0 &&
 		    cafg.val == 1) {
 			
-			Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_MicroModem::checkSetUpCmd set XST");
+			SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_MicroModem::checkSetUpCmd set XST");
 			
 			use_XST = 1;
 		}
@@ -413,7 +414,7 @@ int Sunset_MicroModem::checkSetUpCmd(char* buf)
 		if (strncmp(cafg.key, "CST", strlen(cafg.key)) == 0 &&
 		    cafg.val == 1) {
 			
-			Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_MicroModem::checkSetUpCmd setCST");
+			SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_MicroModem::checkSetUpCmd setCST");
 			
 			use_CST = 1;
 		}
@@ -435,11 +436,11 @@ int Sunset_MicroModem::setUpCmdDone(char* buf)
 {
 	pair<int, char*> pr;
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_MicroModem::setUpCmdDone %s", buf);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_MicroModem::setUpCmdDone %s", buf);
 	
 	if (!checkSetUpCmd(buf)) {
 		
-		Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_MicroModem::setUpCmdDone CHECK exit");
+		SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_MicroModem::setUpCmdDone CHECK exit");
 		return 0;
 	}	
 	
@@ -463,7 +464,7 @@ int Sunset_MicroModem::setUpCmdDone(char* buf)
 			d_status = MM_DRIVER_IDLE;
 		}
 		
-		Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_MicroModem::setUpCmdDone FINISH");
+		SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_MicroModem::setUpCmdDone FINISH");
 		
 		return 1;
 	}
@@ -472,7 +473,7 @@ int Sunset_MicroModem::setUpCmdDone(char* buf)
 		setupTimer_.start(0.001);
 	}
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_MicroModem::setUpCmdDone DONE move NEXT");
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_MicroModem::setUpCmdDone DONE move NEXT");
 	
 	return 1;
 }
@@ -502,7 +503,7 @@ int Sunset_MicroModem::sendSetUpCmd()
 	int ww = 0;
 	pair<int, char*> pr;
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_MicroModem::sendSetUpCmd %d", setupRetry);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_MicroModem::sendSetUpCmd %d", setupRetry);
 	
 	if (setupRetry > MAX_SETUP_RETRY && !(setupInfo.empty())) {
 		
@@ -659,13 +660,13 @@ int Sunset_MicroModem::settingModem(int hex, int ascii, int port)
 		sprintf(bRateString, "%s", "BR2");
 	}
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::settingModem before setting baudRate");	
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::settingModem before setting baudRate");	
 	
 	switch(baudRate) {
 			
 		case 2400:
 		{
-			Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_MicroModem::settingModem 2400");	
+			SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_MicroModem::settingModem 2400");	
 			mm_messages->creaPktCCCFG(buf, UMMAXMSSZ, bRateString, 0, 0);
 			
 			break;
@@ -673,7 +674,7 @@ int Sunset_MicroModem::settingModem(int hex, int ascii, int port)
 			
 		case 4800:
 		{
-			Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_MicroModem::settingModem 4800");	
+			SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_MicroModem::settingModem 4800");	
 			mm_messages->creaPktCCCFG(buf, UMMAXMSSZ, bRateString, 1, 0);
 			
 			break;
@@ -681,7 +682,7 @@ int Sunset_MicroModem::settingModem(int hex, int ascii, int port)
 			
 		case 9600:
 		{
-			Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_MicroModem::settingModem 9600");	
+			SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_MicroModem::settingModem 9600");	
 			mm_messages->creaPktCCCFG(buf, UMMAXMSSZ, bRateString, 2, 0);
 			
 			break;
@@ -689,7 +690,7 @@ int Sunset_MicroModem::settingModem(int hex, int ascii, int port)
 			
 		case 19200:
 		{
-			Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_MicroModem::settingModem 19200");	
+			SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_MicroModem::settingModem 19200");	
 			mm_messages->creaPktCCCFG(buf, UMMAXMSSZ, bRateString, 3, 0);
 			
 			break;
@@ -697,7 +698,7 @@ int Sunset_MicroModem::settingModem(int hex, int ascii, int port)
 			
 		case 38400:
 		{
-			Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_MicroModem::settingModem 38400");	
+			SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_MicroModem::settingModem 38400");	
 			mm_messages->creaPktCCCFG(buf, UMMAXMSSZ, bRateString, 4, 1);
 			
 			break;
@@ -705,7 +706,7 @@ int Sunset_MicroModem::settingModem(int hex, int ascii, int port)
 			
 		case 57600:
 		{
-			Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_MicroModem::settingModem 57600");	
+			SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_MicroModem::settingModem 57600");	
 			mm_messages->creaPktCCCFG(buf, UMMAXMSSZ, bRateString, 5, 0);
 			
 			break;
@@ -713,7 +714,7 @@ int Sunset_MicroModem::settingModem(int hex, int ascii, int port)
 			
 		case 115200:
 		{
-			Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_MicroModem::settingModem 115200");	
+			SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_MicroModem::settingModem 115200");	
 			mm_messages->creaPktCCCFG(buf, UMMAXMSSZ, bRateString, 6, 0);
 			
 			break;
@@ -783,7 +784,7 @@ int Sunset_MicroModem::isRxStatus(mm_driver_status status)
 
 void Sunset_MicroModem::modemTimeout() 
 {
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::modemTimeout d_status %d", d_status);
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::modemTimeout d_status %d", d_status);
 	
 	if (d_status == MM_DRIVER_SETUP) {
 		
@@ -807,7 +808,7 @@ void Sunset_MicroModem::modemTimeout()
 		return;
 	}
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::modemTimeout d_status %d ERROR", d_status);
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::modemTimeout d_status %d ERROR", d_status);
 	
 	exit(1);
 	return;
@@ -829,7 +830,7 @@ char* Sunset_MicroModem::pktWrite(Packet* p, int& len)
 	
 	if( bufferData == NULL ) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_MicroModem::pktWrite no bufferData ERROR");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_MicroModem::pktWrite no bufferData ERROR");
 		return NULL;
 	}
 	
@@ -859,11 +860,11 @@ void Sunset_MicroModem::sendMiniPkt(Packet *p)
 		stat->logStatInfo(SUNSET_STAT_MODEM_GET_PKT, getModuleAddress(), p, HDR_CMN(p)->timestamp(), "");	
 	}
 	
-	Sunset_Debug::debugInfo(1, getModuleAddress(), "Sunset_MicroModem::sendMiniPkt write miniPkt buff %d len %d", (char*)buffer, len);
+	SUNSET_DEBUG_LOG(1, getModuleAddress(), "Sunset_MicroModem::sendMiniPkt write miniPkt buff %d len %d", (char*)buffer, len);
 	
 	if (!writeMiniPkt(buffer, len, dst)) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_MicroModem::sendMiniPkt cannot write data over the serial port ERROR");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_MicroModem::sendMiniPkt cannot write data over the serial port ERROR");
 	}
 	
 	free(buffer);	
@@ -887,7 +888,7 @@ void Sunset_MicroModem::sendDataPkt(Packet *p)
 	
 	if (buffer == NULL) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_MicroModem::sendDataPkt cannot write data over the serial port ERROR");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_MicroModem::sendDataPkt cannot write data over the serial port ERROR");
 		
 		exit(1);
 	}
@@ -900,7 +901,7 @@ void Sunset_MicroModem::sendDataPkt(Packet *p)
 	
 	if (!writeModem(buffer, len, dst)) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_MicroModem::sendDataPkt data buffer ERROR");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_MicroModem::sendDataPkt data buffer ERROR");
 	}
 	
 	free(buffer);
@@ -920,14 +921,14 @@ void Sunset_MicroModem::sendDown(Packet *p)
 	
 	if (src != getModuleAddress()) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Modem recv sending DOWN packet with src %d ERROR", src);
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Modem recv sending DOWN packet with src %d ERROR", src);
 		
 		exit(1);
 	}
 	
 	if (d_status == MM_DRIVER_SETUP) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_MicroModem::sendDown - SETUP not yet completed ERROR");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_MicroModem::sendDown - SETUP not yet completed ERROR");
 		
 		pktTxList.push_back(p);
 		txAborted();
@@ -937,7 +938,7 @@ void Sunset_MicroModem::sendDown(Packet *p)
 	
 	if (isRxStatus(d_status)) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_MicroModem::sendDown - modem is receiving  ERROR");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_MicroModem::sendDown - modem is receiving  ERROR");
 		
 		if (Sunset_Statistics::use_stat() && stat != NULL) {
 			
@@ -945,7 +946,7 @@ void Sunset_MicroModem::sendDown(Packet *p)
 			
 		}
 		
-		Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::sendDown txAborted DATA tx %d", (int)(pktTxList.size()));
+		SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::sendDown txAborted DATA tx %d", (int)(pktTxList.size()));
 		
 		Modem2PhyTxAborted(p);
 		
@@ -959,12 +960,12 @@ void Sunset_MicroModem::sendDown(Packet *p)
 	
 	if (d_status != MM_DRIVER_IDLE || !listCycToSend.empty() || !listPktToSend.empty() || !pktTxList.empty()){
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_MicroModem::sendDown - state is not idle %d ERROR", STATE);
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_MicroModem::sendDown - state is not idle %d ERROR", STATE);
 		
 		exit(1);
 	}
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_MicroModem::sendDown pkt");
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_MicroModem::sendDown pkt");
 	
 	pktTxList.push_back(p);
 	
@@ -1035,7 +1036,7 @@ int Sunset_MicroModem::writeDataToModem(const char *  buf, const size_t len, dou
 		timeoutTimer_.stop();
 	}
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_MicroModem::writeTomodem sending: %s - len %d - check %d status %d", buf, len, ww, d_status);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_MicroModem::writeTomodem sending: %s - len %d - check %d status %d", buf, len, ww, d_status);
 	
 	if (d_status == MM_DRIVER_TX_CYC) {
 		
@@ -1099,7 +1100,7 @@ void Sunset_MicroModem::txAborted()
 		
 		if (pktTxList.empty()) {
 			
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_MicroModem::txAborted MINI_PKT- Something is wrongtx %d ERROR", (int)(pktTxList.size()));
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_MicroModem::txAborted MINI_PKT- Something is wrongtx %d ERROR", (int)(pktTxList.size()));
 			
 			d_status = MM_DRIVER_IDLE;
 			STATE = MM_S_WAIT_CMD;
@@ -1121,7 +1122,7 @@ void Sunset_MicroModem::txAborted()
 		
 		pktTxList.pop_front();
 		
-		Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::txAborted MINI_PKT cyc %d send %d tx %d", (int)(listCycToSend.size()), (int)(listPktToSend.size()), (int)(pktTxList.size()));
+		SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::txAborted MINI_PKT cyc %d send %d tx %d", (int)(listCycToSend.size()), (int)(listPktToSend.size()), (int)(pktTxList.size()));
 		
 		Modem2PhyTxAborted(p);
 		
@@ -1137,7 +1138,7 @@ void Sunset_MicroModem::txAborted()
 		
 		if (listCycToSend.empty() || listPktToSend.empty() || pktTxList.empty()) {
 			
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_MicroModem::txAborted DATA - Something is wrong with pktList cyc %d send %d tx %d ERROR", (int)(listCycToSend.size()), (int)(listPktToSend.size()), (int)(pktTxList.size()));
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_MicroModem::txAborted DATA - Something is wrong with pktList cyc %d send %d tx %d ERROR", (int)(listCycToSend.size()), (int)(listPktToSend.size()), (int)(pktTxList.size()));
 			
 			d_status = MM_DRIVER_IDLE;
 			STATE = MM_S_WAIT_CMD;
@@ -1164,7 +1165,7 @@ void Sunset_MicroModem::txAborted()
 		
 		pktTxList.pop_front();
 		
-		Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::txAborted2 DATA cyc %d send %d tx %d", (int)(listCycToSend.size()), (int)(listPktToSend.size()), (int)(pktTxList.size()));
+		SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::txAborted2 DATA cyc %d send %d tx %d", (int)(listCycToSend.size()), (int)(listPktToSend.size()), (int)(pktTxList.size()));
 		
 		Modem2PhyTxAborted(p);
 		
@@ -1175,7 +1176,7 @@ void Sunset_MicroModem::txAborted()
 		return;
 	}
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::txAborted NO TX STATUS cyc %d send %d tx %d", (int)(listCycToSend.size()), (int)(listPktToSend.size()), (int)(pktTxList.size()));
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::txAborted NO TX STATUS cyc %d send %d tx %d", (int)(listCycToSend.size()), (int)(listPktToSend.size()), (int)(pktTxList.size()));
 	
 	if (d_status == MM_DRIVER_ERROR) {
 		
@@ -1191,7 +1192,7 @@ void Sunset_MicroModem::txAborted()
 			pktTxList.pop_front();
 			Modem2PhyTxAborted(p);
 			
-			Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::txAborted NO TX STATUS cyc %d send %d tx %d", (int)(listCycToSend.size()), (int)(listPktToSend.size()), (int)(pktTxList.size()));
+			SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::txAborted NO TX STATUS cyc %d send %d tx %d", (int)(listCycToSend.size()), (int)(listPktToSend.size()), (int)(pktTxList.size()));
 			
 			clearTxInfo();
 			
@@ -1210,7 +1211,7 @@ void Sunset_MicroModem::clearTxInfo()
 {
 	int check = 0;
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::clearTxInfo start STATE %d d_status %d", STATE, d_status);
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::clearTxInfo start STATE %d d_status %d", STATE, d_status);
 	
 	if (!listCycToSend.empty()) {
 		
@@ -1253,10 +1254,10 @@ void Sunset_MicroModem::clearTxInfo()
 	
 	if (check) {
 		
-		Sunset_Debug::debugInfo(1, getModuleAddress(), "Sunset_MicroModem::clearTxInfo DONE");
+		SUNSET_DEBUG_LOG(1, getModuleAddress(), "Sunset_MicroModem::clearTxInfo DONE");
 	}
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::clearTxInfo exit");
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::clearTxInfo exit");
 	
 	if (check) {
 		
@@ -1273,7 +1274,7 @@ void Sunset_MicroModem::resetTx()
 {
 	int check = 0;
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::resetTx start STATE %d d_status %d", STATE, d_status);
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::resetTx start STATE %d d_status %d", STATE, d_status);
 	
 	if (timeoutTimer_.busy()) {
 		
@@ -1321,13 +1322,13 @@ void Sunset_MicroModem::resetTx()
 	
 	if (check) {
 		
-		Sunset_Debug::debugInfo(1, getModuleAddress(), "Sunset_MicroModem::resetTx INIT MODEM");	
+		SUNSET_DEBUG_LOG(1, getModuleAddress(), "Sunset_MicroModem::resetTx INIT MODEM");	
 	}
 	
 	STATE = MM_S_WAIT_CMD;
 	d_status = MM_DRIVER_IDLE;
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::resetTx exit STATE %d", STATE);
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::resetTx exit STATE %d", STATE);
 	
 	if (check) {
 		
@@ -1353,7 +1354,7 @@ int Sunset_MicroModem::writeMiniPkt(char* buffer, int size, int dest)
 	int ww = 0;
 	char* buf;
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::writeMiniPkt dest %d", dest);
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::writeMiniPkt dest %d", dest);
 	
 	if ((int)dest == Sunset_Address::getBroadcastAddress()) {
 		
@@ -1365,21 +1366,21 @@ int Sunset_MicroModem::writeMiniPkt(char* buffer, int size, int dest)
 	
 	if ( buf == NULL ) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_MicroModem::writeMiniPkt MALLOC ERROR");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_MicroModem::writeMiniPkt MALLOC ERROR");
 		exit(1);	
 	}
 	
 	memset(buf, '\0', sizeof(char) * (UMMAXMSSZ));
 	
-	Sunset_Debug::debugInfo(1, getModuleAddress(), "Sunset_MicroModem::writeMiniPkt dest %d state %d string %s", dest, STATE, (char*)buffer);
+	SUNSET_DEBUG_LOG(1, getModuleAddress(), "Sunset_MicroModem::writeMiniPkt dest %d state %d string %s", dest, STATE, (char*)buffer);
 	
 	mm_messages->creaPktCCMUC(buf, UMMAXMSSZ, getModuleAddress(), dest, (char*)buffer, modem_checkSum);
 	
-	Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_MicroModem::writeMiniPkt dest %d string %s", dest, buf);
+	SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_MicroModem::writeMiniPkt dest %d string %s", dest, buf);
 	
 	if (d_status != MM_DRIVER_IDLE) {
 		
-		Sunset_Debug::debugInfo(1, getModuleAddress(), "Sunset_MicroModem::writeMiniPkt dest %d state %d string %s ERROR", dest, STATE, (char*)buffer);
+		SUNSET_DEBUG_LOG(1, getModuleAddress(), "Sunset_MicroModem::writeMiniPkt dest %d state %d string %s ERROR", dest, STATE, (char*)buffer);
 		exit(1);
 	}
 	
@@ -1413,7 +1414,7 @@ int Sunset_MicroModem::writeModem(char* buffer, int size, int dest)
 	
 	if (size + PKT_MODEM_OVERHEAD > UMMAXMSSZ) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_MicroModem::writeModem TODO we have to handle "
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_MicroModem::writeModem TODO we have to handle "
 					"packet framing ERROR");
 		exit(1);
 	}
@@ -1429,7 +1430,7 @@ int Sunset_MicroModem::writeModem(char* buffer, int size, int dest)
 	
 	if (!sendData(getModuleAddress(), dest, MODEM_RATE, MM_MODEM_FLAG, MM_MODEM_FRAME, (char*)buffer, USE_ACK, modem_checkSum, nmea_type, size) == -1) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_MicroModem::writeModem write failed ERROR!");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_MicroModem::writeModem write failed ERROR!");
 		
 		return 0;
 	}
@@ -1446,7 +1447,7 @@ int Sunset_MicroModem::writeModem(char* buffer, int size, int dest)
 void Sunset_MicroModem::txDone() 
 {
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::txDone d_status %d STATE %d", d_status, STATE);
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::txDone d_status %d STATE %d", d_status, STATE);
 	
 	if (d_status == MM_DRIVER_TX_MINI_PKT || d_status == MM_DRIVER_WAIT_MINI_PKT_XST) {
 		
@@ -1454,7 +1455,7 @@ void Sunset_MicroModem::txDone()
 		
 		if (pktTxList.empty()) {
 			
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_MicroModem::txDone - Something is wrongtx %d ERROR", (int)(pktTxList.size()));
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_MicroModem::txDone - Something is wrongtx %d ERROR", (int)(pktTxList.size()));
 			
 			exit(1);
 		}
@@ -1469,7 +1470,7 @@ void Sunset_MicroModem::txDone()
 		
 		Modem2PhyEndTx(p);
 		
-		Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::txDone MINI_PKT cyc %d send %d tx %d", (int)(listCycToSend.size()), (int)(listPktToSend.size()), (int)(pktTxList.size()));
+		SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::txDone MINI_PKT cyc %d send %d tx %d", (int)(listCycToSend.size()), (int)(listPktToSend.size()), (int)(pktTxList.size()));
 		
 		STATE = MM_S_WAIT_CMD;
 		d_status = MM_DRIVER_IDLE;
@@ -1483,7 +1484,7 @@ void Sunset_MicroModem::txDone()
 		
 		if (listCycToSend.empty() || listPktToSend.empty() || pktTxList.empty()) {
 			
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_MicroModem::txDone - Something is wrong with pktList cyc %d send %d tx %d ERROR", (int)(listCycToSend.size()), (int)(listPktToSend.size()), (int)(pktTxList.size()));
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_MicroModem::txDone - Something is wrong with pktList cyc %d send %d tx %d ERROR", (int)(listCycToSend.size()), (int)(listPktToSend.size()), (int)(pktTxList.size()));
 			
 			exit(1);
 		}
@@ -1506,12 +1507,12 @@ void Sunset_MicroModem::txDone()
 		STATE = MM_S_WAIT_CMD;
 		d_status = MM_DRIVER_IDLE;
 		
-		Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::txDone cyc %d send %d tx %d", (int)(listCycToSend.size()), (int)(listPktToSend.size()), (int)(pktTxList.size()));
+		SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::txDone cyc %d send %d tx %d", (int)(listCycToSend.size()), (int)(listPktToSend.size()), (int)(pktTxList.size()));
 		
 		return;
 	}
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::txDone d_status %d STATE %d ERROR", d_status, STATE);
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::txDone d_status %d STATE %d ERROR", d_status, STATE);
 	
 	exit(1);
 }
@@ -1572,7 +1573,7 @@ void Sunset_MicroModem::rxAborted(int size)
 		return;
 	}
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::rxAborted d_status %d STATE %d ERROR", d_status, STATE);
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::rxAborted d_status %d STATE %d ERROR", d_status, STATE);
 	
 	exit(1);	
 }
@@ -1607,7 +1608,7 @@ int Sunset_MicroModem::sendData(int src, int dest, int rate, int flag, int skct,
 	
 	if (!checkConnection()) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_MicroModem::sendData but serial port device is not set ERROR");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_MicroModem::sendData but serial port device is not set ERROR");
 		
 		return 0;
 	}
@@ -1616,7 +1617,7 @@ int Sunset_MicroModem::sendData(int src, int dest, int rate, int flag, int skct,
 	
 	if ( buf == NULL ) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_MicroModem::sendData MALLOC ERROR");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_MicroModem::sendData MALLOC ERROR");
 		
 		exit(1);
 	}
@@ -1643,7 +1644,7 @@ int Sunset_MicroModem::sendData(int src, int dest, int rate, int flag, int skct,
 				
 				if (writeDataToModem(aux, strlen(aux), TIMEOUT_MM_MINI_PKT) != 1) {
 					
-					Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_MicroModem::sendData MM_SEND_CYC ERROR writing data");
+					SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_MicroModem::sendData MM_SEND_CYC ERROR writing data");
 					
 					txAborted();
 					
@@ -1653,7 +1654,7 @@ int Sunset_MicroModem::sendData(int src, int dest, int rate, int flag, int skct,
 				return 1;
 			}
 			
-			Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::sendDATA CYC d_status %d STATE %d ERROR", d_status, STATE);
+			SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::sendDATA CYC d_status %d STATE %d ERROR", d_status, STATE);
 			
 			exit(1);
 			
@@ -1668,7 +1669,7 @@ int Sunset_MicroModem::sendData(int src, int dest, int rate, int flag, int skct,
 			
 			if( d_status != MM_DRIVER_IDLE) {
 				
-				Sunset_Debug::debugInfo(2, getModuleAddress(), "sendData SEND HEX but state is not idle %d", d_status);
+				SUNSET_DEBUG_LOG(2, getModuleAddress(), "sendData SEND HEX but state is not idle %d", d_status);
 				exit(1);
 			}
 			
@@ -1679,7 +1680,7 @@ int Sunset_MicroModem::sendData(int src, int dest, int rate, int flag, int skct,
 			
 			if( bufTX == NULL ) {				
 				
-				Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_MicroModem::sendData MALLOC ERROR");
+				SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_MicroModem::sendData MALLOC ERROR");
 				txAborted();
 				
 				return 0;
@@ -1689,7 +1690,7 @@ int Sunset_MicroModem::sendData(int src, int dest, int rate, int flag, int skct,
 			
 			if( msgAux == NULL ) {
 				
-				Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_MicroModem::sendData MALLOC ERROR");
+				SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_MicroModem::sendData MALLOC ERROR");
 				
 				txAborted();
 				free(bufTX);
@@ -1701,13 +1702,13 @@ int Sunset_MicroModem::sendData(int src, int dest, int rate, int flag, int skct,
 			
 			dim = hexencode(msgAux, UMMAXMSSZ, msg, size);
 			
-			Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_MicroModem::sendData sendData dim: %ld", dim);
+			SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_MicroModem::sendData sendData dim: %ld", dim);
 			
-			Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_MicroModem::sendData sendData msgAux len %d value %s", strlen(msgAux), msgAux);
+			SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_MicroModem::sendData sendData msgAux len %d value %s", strlen(msgAux), msgAux);
 			
 			mm_messages->creaPktCCTXD(bufTX, UMMAXMSSZ, src, dest, ack, dim, msgAux, cksum);
 			
-			Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_MicroModem::sendData sendData bufTX len %d value: %s", strlen(bufTX), bufTX);
+			SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_MicroModem::sendData sendData bufTX len %d value: %s", strlen(bufTX), bufTX);
 			
 			free(msgAux);
 			
@@ -1719,14 +1720,14 @@ int Sunset_MicroModem::sendData(int src, int dest, int rate, int flag, int skct,
 			
 			if (writeDataToModem(buf, strlen(buf), TIMEOUT_MM_MINI_PKT) != 1) {
 				
-				Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_MicroModem::sendData MM_SEND_HEX ERROR writing data");
+				SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_MicroModem::sendData MM_SEND_HEX ERROR writing data");
 				
 				txAborted();
 				
 				return 0;
 			}
 			
-			Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_MicroModem::sendData sendData HEX src %d dst %d rate %d flag %d skct %d", src, dest, rate, flag, skct);
+			SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_MicroModem::sendData sendData HEX src %d dst %d rate %d flag %d skct %d", src, dest, rate, flag, skct);
 			
 			return 1;
 			
@@ -1739,7 +1740,7 @@ int Sunset_MicroModem::sendData(int src, int dest, int rate, int flag, int skct,
 			
 			if( d_status != MM_DRIVER_IDLE) {
 				
-				Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::sendData SEND ASCII but state is not idle %d", d_status);
+				SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::sendData SEND ASCII but state is not idle %d", d_status);
 				
 				exit(1);
 			}
@@ -1751,7 +1752,7 @@ int Sunset_MicroModem::sendData(int src, int dest, int rate, int flag, int skct,
 			
 			if( bufTX == NULL ) {		
 				
-				Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_MicroModem::sendData MALLOC ERROR");
+				SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_MicroModem::sendData MALLOC ERROR");
 				
 				txAborted();
 				
@@ -1760,7 +1761,7 @@ int Sunset_MicroModem::sendData(int src, int dest, int rate, int flag, int skct,
 			
 			memset(bufTX, '\0', sizeof(char) * UMMAXMSSZ);
 			
-			Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_MicroModem::sendData ASCII msgAux len %d value %s",  strlen(msg), msg);
+			SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_MicroModem::sendData ASCII msgAux len %d value %s",  strlen(msg), msg);
 			
 			mm_messages->creaPktCCTXA(bufTX, UMMAXMSSZ, src, dest, ack, strlen(msg), msg, cksum);
 			listPktToSend.push_back(bufTX);
@@ -1770,14 +1771,14 @@ int Sunset_MicroModem::sendData(int src, int dest, int rate, int flag, int skct,
 			
 			if (writeDataToModem(buf, strlen(buf), TIMEOUT_MM_MINI_PKT) != 1) {
 				
-				Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_MicroModem::sendData MM_SEND_ASCII ERROR writing data");
+				SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_MicroModem::sendData MM_SEND_ASCII ERROR writing data");
 				
 				txAborted();
 				
 				return 0;
 			}
 			
-			Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_MicroModem::sendData ASCII src %d dst %d rate %d flag %d skct %d", src, dest, rate, flag, skct);
+			SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_MicroModem::sendData ASCII src %d dst %d rate %d flag %d skct %d", src, dest, rate, flag, skct);
 			
 			return 1;
 			break;
@@ -1786,8 +1787,8 @@ int Sunset_MicroModem::sendData(int src, int dest, int rate, int flag, int skct,
 		case MM_SEND_DATA:
 		{
 			
-			Sunset_Debug::debugInfo(4, getModuleAddress(), "sendData DRQ: %d", STATE);
-			Sunset_Debug::debugInfo(1, getModuleAddress(), "sendData listPktToSend.size %d", (int)(listPktToSend.size()));
+			SUNSET_DEBUG_LOG(4, getModuleAddress(), "sendData DRQ: %d", STATE);
+			SUNSET_DEBUG_LOG(1, getModuleAddress(), "sendData listPktToSend.size %d", (int)(listPktToSend.size()));
 			
 			if( !listPktToSend.empty() )
 			{
@@ -1795,7 +1796,7 @@ int Sunset_MicroModem::sendData(int src, int dest, int rate, int flag, int skct,
 				
 				if (writeDataToModem(aux, strlen(aux), TIMEOUT_MM_DATA) != 1 ) {
 					
-					Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_MicroModem::sendData MALLOC ERROR");
+					SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_MicroModem::sendData MALLOC ERROR");
 					
 					txAborted();
 					
@@ -1806,7 +1807,7 @@ int Sunset_MicroModem::sendData(int src, int dest, int rate, int flag, int skct,
 			}
 			else {
 				
-				Sunset_Debug::debugInfo(-1, getModuleAddress(), "TODO we have to check why node has no packet in its list while trying to transmit a pkt ERROR");
+				SUNSET_DEBUG_LOG(-1, getModuleAddress(), "TODO we have to check why node has no packet in its list while trying to transmit a pkt ERROR");
 			}
 			
 			break;	
@@ -1896,7 +1897,7 @@ double Sunset_MicroModem::getCodingOverhead(int rate)
 
 double Sunset_MicroModem::getTxTime(int size) 
 {
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_MicroModem::getTxTime size %d", size);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_MicroModem::getTxTime size %d", size);
 	
 	return getTrainigTime() + (getPktSize(size)  * 8.0) / getAggregateRate(MODEM_RATE);
 }
@@ -1921,7 +1922,7 @@ double Sunset_MicroModem::getSerialTime(int size)
 
 int Sunset_MicroModem::getPktSize(int dataSize) 
 {
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_MicroModem::getPktSize dataSize %d", dataSize);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_MicroModem::getPktSize dataSize %d", dataSize);
 	
 	if (MODEM_RATE == 0) {
 		
@@ -1972,20 +1973,20 @@ char* Sunset_MicroModem::createDownCtrlPkt(Packet* p, int& len)
 	
 	if ( buffer == NULL ) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_MicroModem::createDownCtrlPkt MALLOC ERROR");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_MicroModem::createDownCtrlPkt MALLOC ERROR");
 		exit(1);
 	}
 	
 	memset(buffer, '\0', len+1);
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_MicroModem::createDownCtrlPkt total length %d", len);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_MicroModem::createDownCtrlPkt total length %d", len);
 	
 	pktConverter_->getSrc(p, UW_PKT_MAC, src);
 	pktConverter_->getDst(p, UW_PKT_MAC, dst);
 	
 	if (dst > MAX_MINI_PKT_ID) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_MicroModem::createDownCtrlPkt ERROR on dest ID %d", dst);
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_MicroModem::createDownCtrlPkt ERROR on dest ID %d", dst);
 		exit(1);
 	}
 	
@@ -2001,7 +2002,7 @@ char* Sunset_MicroModem::createDownCtrlPkt(Packet* p, int& len)
 	
 	if( msgAux == NULL ) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_MicroModem::createDownCtrlPkt MALLOC ERROR");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_MicroModem::createDownCtrlPkt MALLOC ERROR");
 		exit(1);
 	}
 	
@@ -2014,7 +2015,7 @@ char* Sunset_MicroModem::createDownCtrlPkt(Packet* p, int& len)
 	
 	free(buffer);
 	
-	Sunset_Debug::debugInfo(1, getModuleAddress(), "Sunset_MicroModem::createDownCtrlPkt  msgAux %s len %d", msgAux, len);
+	SUNSET_DEBUG_LOG(1, getModuleAddress(), "Sunset_MicroModem::createDownCtrlPkt  msgAux %s len %d", msgAux, len);
 	
 	return msgAux;    
 }
@@ -2034,13 +2035,13 @@ Packet* Sunset_MicroModem::createUpCtrlPkt(int src, char* buf)
 	int dst = 0;
 	Packet* p;
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::createUpCtrlPkt src %d", src);
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::createUpCtrlPkt src %d", src);
 	
 	ret = (char *)malloc(sizeof(char)*(5));
 	
 	if ( ret == NULL ) {
 		
-		Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::createUpCtrlPkt MALLOC ERROR");
+		SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::createUpCtrlPkt MALLOC ERROR");
 		
 		exit(1);
 	}
@@ -2056,7 +2057,7 @@ Packet* Sunset_MicroModem::createUpCtrlPkt(int src, char* buf)
 	
 	free(ret);
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_MicroModem::createUpCtrlPkt chiamo mac src %d dst %d subTpe %d", src, dst, subType);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_MicroModem::createUpCtrlPkt chiamo mac src %d dst %d subTpe %d", src, dst, subType);
 	
 	if (pktConverter_ != 0) {
 		
@@ -2068,20 +2069,20 @@ Packet* Sunset_MicroModem::createUpCtrlPkt(int src, char* buf)
 	}
 	
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_MicroModem::createUpCtrlPkt pkt %d", p);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_MicroModem::createUpCtrlPkt pkt %d", p);
 	
 	if (p != 0) {
 		
 		HDR_CMN(p)->direction() = hdr_cmn::UP;
 	}
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_MicroModem::createUpCtrlPkt created");
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_MicroModem::createUpCtrlPkt created");
 	
 	if (src == getModuleAddress()) {
 		
 		HDR_CMN(p)->error() = 1;
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_MicroModem::createUpCtrlPkt pkt with ERROR src = myId - MODEM ERROR on miniPkt");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_MicroModem::createUpCtrlPkt pkt with ERROR src = myId - MODEM ERROR on miniPkt");
 		
 		return p;
 	}
@@ -2095,31 +2096,16 @@ Packet* Sunset_MicroModem::createUpCtrlPkt(int src, char* buf)
 
 void Sunset_MicroModem::recvBufferData() 
 {
-	char* buf;
-	
-	pthread_mutex_lock(&mutex_mm_timer_rx);
+	sunset_rx_slot* rp = 0;
 	
-	if (rxDataBuffer.empty()) {
+	while ((rp = rxChannel_.front()) != 0) {
 		
-		pthread_mutex_unlock(&mutex_mm_timer_rx);
+		recvPkt(rp->data);
 		
-		return;
+		rxChannel_.pop();
 		
+		SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_MicroModem::recvBufferData DONE");
 	}
-	
-	buf = rxDataBuffer.front();
-	
-	rxDataBuffer.pop_front();
-	
-	pthread_mutex_unlock(&mutex_mm_timer_rx);
-	
-	Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_MicroModem::recvBufferData DONE buffer size remaining %d", (int)(rxDataBuffer.size()));
-	
-	recvPkt(buf);
-	
-	free(buf);
-	
-	recvBufferData();
 }
 
 /*!
@@ -2128,55 +2114,37 @@ void Sunset_MicroModem::recvBufferData()
 
 int Sunset_MicroModem::readIterate()
 {
-	char bufRead[UMMAXMSSZ] = {'\0'};
+	char* bufRead = 0;
 	int len = 0;
-	char* pkt;
 	
 	if (!checkConnection()) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_MicroModem::readIterate but serial port device is not set ERROR");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_MicroModem::readIterate but serial port device is not set ERROR");
 		
 		return -1;
 	}
 	
-	len = mm_conn->read_data(bufRead, UMMAXMSSZ); 
+	// the sentence is read in place from the connection buffer and copied only once, in the reception channel
+	
+	len = mm_conn->read_sentence(&bufRead, UMMAXMSSZ - 1); 
 	
 	if (len <= 0) {
 		
-		Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_MicroModem::readIterate NO packet correctly received, len of pkt is: %d", len);
+		SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_MicroModem::readIterate NO packet correctly received, len of pkt is: %d", len);
 		
 		return -1;
 	}
 	
-	Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_MicroModem::readIterate STATE %d d_state %d string: %s", STATE, d_status, bufRead);
+	SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_MicroModem::readIterate STATE %d d_state %d string: %.*s", STATE, d_status, len, bufRead);
 	
 	if (Sunset_Statistics::use_stat() && stat != NULL) {
 		
-		stat->logStatInfo(SUNSET_STAT_MODEM_INFO, getModuleAddress(), 0, 0, "%s", bufRead);	
-	}
-	
-	pkt = (char*) malloc (sizeof(char) * strlen(bufRead)+1);
-	
-	if ( pkt == NULL ) {
-		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_MicroModem::readIterate MALLOC ERROR");
-		exit(1);	
-	}
-	
-	memset (pkt, '\0', strlen(bufRead) + 1);
-	memcpy(pkt, bufRead, strlen(bufRead));	
-	
-	pthread_mutex_lock(&mutex_mm_timer_rx);
-	
-	rxDataBuffer.push_back(pkt);
-	
-	if (!(recvTimer_.busy())) {
-		
-		recvTimer_.start(0.0001);
+		stat->logStatInfo(SUNSET_STAT_MODEM_INFO, getModuleAddress(), 0, 0, "%.*s", len, bufRead);	
 	}
 	
-	pthread_mutex_unlock(&mutex_mm_timer_rx);
+	rxChannel_.push(bufRead, len, NOW);
 	
+	return len;
 }
 
 /*!
@@ -2192,7 +2160,7 @@ int Sunset_MicroModem::recvPkt(char * buf)
 	
 	pktType = mm_messages->NMEAPktType(buf);
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_MicroModem::recvPkt pktType %d - buf %s STATE %d status %d", pktType, buf, STATE, d_status);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_MicroModem::recvPkt pktType %d - buf %s STATE %d status %d", pktType, buf, STATE, d_status);
 	
 	switch(pktType) {
 			
@@ -2207,13 +2175,13 @@ int Sunset_MicroModem::recvPkt(char * buf)
 				
 				if (strncmp(errore.msg, "Bad checksum", strlen(errore.msg)) == 0) {
 					
-					Sunset_Debug::debugInfo(1, getModuleAddress(), "Sunset_MicroModem::recvPkt BAD CHECKSUM");
+					SUNSET_DEBUG_LOG(1, getModuleAddress(), "Sunset_MicroModem::recvPkt BAD CHECKSUM");
 					
 					break;
 				}
 				else if (strncmp(errore.msg, "DATA_TIMEOUT", strlen(errore.msg)) == 0) {
 					
-					Sunset_Debug::debugInfo(1, getModuleAddress(), "Sunset_MicroModem::recvPkt DATA Timeout");
+					SUNSET_DEBUG_LOG(1, getModuleAddress(), "Sunset_MicroModem::recvPkt DATA Timeout");
 					
 					if (isTxStatus(d_status)) {
 						
@@ -2256,7 +2224,7 @@ int Sunset_MicroModem::recvPkt(char * buf)
 				
 				if (strcmp(msg.type, "Transmit aborted") == 0) {
 					
-					Sunset_Debug::debugInfo(1, getModuleAddress(), "Sunset_MicroModem::recvPkt Transmit aborted");
+					SUNSET_DEBUG_LOG(1, getModuleAddress(), "Sunset_MicroModem::recvPkt Transmit aborted");
 					
 					if (isTxStatus(d_status)) {
 						
@@ -2272,7 +2240,7 @@ int Sunset_MicroModem::recvPkt(char * buf)
 				
 				if (strncmp(msg.type, "PACKET_TIMEOUT", strlen(msg.type)) == 0) {
 					
-					Sunset_Debug::debugInfo(1, getModuleAddress(), "Sunset_MicroModem::recvPkt Packet Timeout");
+					SUNSET_DEBUG_LOG(1, getModuleAddress(), "Sunset_MicroModem::recvPkt Packet Timeout");
 					
 					
 					if (isTxStatus(d_status)) {
@@ -2299,7 +2267,7 @@ int Sunset_MicroModem::recvPkt(char * buf)
 				
 				if (strcmp(msg.type, "Unknown minipacket type") == 0) {
 					
-					Sunset_Debug::debugInfo(1, getModuleAddress(), "Sunset_MicroModem::recvPkt Unknown minipacket type");
+					SUNSET_DEBUG_LOG(1, getModuleAddress(), "Sunset_MicroModem::recvPkt Unknown minipacket type");
 					
 					break;
 				}
@@ -2307,7 +2275,7 @@ int Sunset_MicroModem::recvPkt(char * buf)
 			
 			if (strncmp(msg.type, "BAD_CRC", strlen(msg.type)) == 0) {
 				
-				Sunset_Debug::debugInfo(1, getModuleAddress(), "Sunset_MicroModem::recvPkt BAD_CRC");
+				SUNSET_DEBUG_LOG(1, getModuleAddress(), "Sunset_MicroModem::recvPkt BAD_CRC");
 				
 				if (d_status == MM_DRIVER_SETUP) {
 					
@@ -2362,7 +2330,7 @@ int Sunset_MicroModem::recvPkt(char * buf)
 			{
 				if (strcmp(rev.ident, "INIT") == 0) {
 					
-					Sunset_Debug::debugInfo(1, getModuleAddress(), "Sunset_MicroModem::recvPkt CAREV INIT %d", d_status);
+					SUNSET_DEBUG_LOG(1, getModuleAddress(), "Sunset_MicroModem::recvPkt CAREV INIT %d", d_status);
 					
 					if (isTxStatus(d_status)) {
 						
@@ -2394,7 +2362,7 @@ int Sunset_MicroModem::recvPkt(char * buf)
 		{
 			STATE = MM_S_WAIT_CMD;
 			
-			Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_MicroModem::recvPkt NMEA_CACFG %d", d_status);
+			SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_MicroModem::recvPkt NMEA_CACFG %d", d_status);
 			
 			if (d_status == MM_DRIVER_SETUP) {
 				
@@ -2402,7 +2370,7 @@ int Sunset_MicroModem::recvPkt(char * buf)
 			}
 			else {
 				
-				Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::recvPkt CACFG d_status %d STATE %d ERROR", d_status, STATE);
+				SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::recvPkt CACFG d_status %d STATE %d ERROR", d_status, STATE);
 				
 				exit(1);
 				
@@ -2431,26 +2399,26 @@ int Sunset_MicroModem::recvPkt(char * buf)
 			
 			if (mm_messages->sscannmea(buf, pktType, &cyc) > 0) {
 				
-				Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_MicroModem::recvPkt CACYC src %d addr %d", (int)cyc.src, getModuleAddress());
+				SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_MicroModem::recvPkt CACYC src %d addr %d", (int)cyc.src, getModuleAddress());
 				
 				if ((int)cyc.src == (int)getModuleAddress()) { 
 					
-					Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_MicroModem::recvPkt CACYC for me STATE %d", STATE);
+					SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_MicroModem::recvPkt CACYC for me STATE %d", STATE);
 					
 					if(d_status == MM_DRIVER_TX_CYC && !(listCycToSend.empty())) {
 						
 						STATE = MM_S_WAIT_DRQ; 
 						
-						Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_MicroModem::recvPkt CACYC for me WAIT_DRQ");
+						SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_MicroModem::recvPkt CACYC for me WAIT_DRQ");
 					}	
 					else {
 						
-						Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_MicroModem::recvPkt CACYC for me ERROR STATE %d status %d list empty %d", STATE, d_status, listCycToSend.empty());
+						SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_MicroModem::recvPkt CACYC for me ERROR STATE %d status %d list empty %d", STATE, d_status, listCycToSend.empty());
 					}
 				}
 				else {
 					
-					Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_MicroModem::recvPkt CACYC for me WAIT_RXD");
+					SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_MicroModem::recvPkt CACYC for me WAIT_RXD");
 					
 					if (isTxStatus(d_status)) {
 						
@@ -2504,17 +2472,17 @@ int Sunset_MicroModem::recvPkt(char * buf)
 						}
 						else {
 							
-							Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::recvPkt CADRQ want ack but it is broadcast pkt src %d dst %d", drq.src, drq.dest);
+							SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::recvPkt CADRQ want ack but it is broadcast pkt src %d dst %d", drq.src, drq.dest);
 						}
 					}
 					
-					Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::recvPkt CADRQ good state MM_SEND_DATA listSize %d rqFlag %d /*wantAck*/ %d", (int)(listPktToSend.size()), drq.flag, want_ACK);
+					SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::recvPkt CADRQ good state MM_SEND_DATA listSize %d rqFlag %d /*wantAck*/ %d", (int)(listPktToSend.size()), drq.flag, want_ACK);
 					
 					sendData(0, 0, 0, 0, 0, NULL, 0, 0, MM_SEND_DATA, 0);
 					
 				} else {
 					
-					Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_MicroModem::recvPkt CADRQ wrong state %d status %d ERROR", STATE, d_status);
+					SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_MicroModem::recvPkt CADRQ wrong state %d status %d ERROR", STATE, d_status);
 				}
 			}
 			
@@ -2542,18 +2510,18 @@ int Sunset_MicroModem::recvPkt(char * buf)
 						
 					}
 					
-					Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::recvPkt CATXP d_status %d STATE %d start trasnmission", d_status, STATE);
+					SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::recvPkt CATXP d_status %d STATE %d start trasnmission", d_status, STATE);
 				}
 				else if (isRxStatus(d_status)) {
 					
-					Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::recvPkt CATXP d_status %d STATE %d ERROR", d_status, STATE);
+					SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::recvPkt CATXP d_status %d STATE %d ERROR", d_status, STATE);
 					d_status = MM_DRIVER_ERROR;
 					
 					exit(1);
 				}
 				else {
 					
-					Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::recvPkt CATXP d_status %d STATE %d modem ERROR", d_status, STATE);
+					SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::recvPkt CATXP d_status %d STATE %d modem ERROR", d_status, STATE);
 					
 					d_status = MM_DRIVER_ERROR;
 				}
@@ -2579,7 +2547,7 @@ int Sunset_MicroModem::recvPkt(char * buf)
 				
 				isTransmitting = 0;
 				
-				Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::recvPkt pkt ack %d use xst %d state %d", want_ACK, use_XST, STATE);
+				SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::recvPkt pkt ack %d use xst %d state %d", want_ACK, use_XST, STATE);
 				
 				if (d_status == MM_DRIVER_TX_DATA) {
 					
@@ -2593,18 +2561,18 @@ int Sunset_MicroModem::recvPkt(char * buf)
 							
 						}
 						
-						Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::recvPkt TX DATA COMPLETED wantAck %d useXst %d STATE %d", want_ACK, use_XST, STATE);
+						SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::recvPkt TX DATA COMPLETED wantAck %d useXst %d STATE %d", want_ACK, use_XST, STATE);
 					}
 					else {
 						
-						Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_MicroModem::recvPkt TX COMPLETED DATA PKT but no pkt ERROR");
+						SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_MicroModem::recvPkt TX COMPLETED DATA PKT but no pkt ERROR");
 						
 						exit(1);
 					}
 					
 					if (!use_XST) {
 						
-						Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::recvPkt TX COMPLETED call txDone");
+						SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::recvPkt TX COMPLETED call txDone");
 						
 						if (want_ACK) {
 							
@@ -2639,18 +2607,18 @@ int Sunset_MicroModem::recvPkt(char * buf)
 							
 						}
 						
-						Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::recvPkt TX COMPLETED MINI PKT wantAck %d", want_ACK);
+						SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::recvPkt TX COMPLETED MINI PKT wantAck %d", want_ACK);
 					}
 					else {
 						
-						Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_MicroModem::recvPkt TX COMPLETED MINI PKT but no pkt ERROR");
+						SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_MicroModem::recvPkt TX COMPLETED MINI PKT but no pkt ERROR");
 						
 						exit(1);
 					}
 					
 					if (!use_XST) {
 						
-						Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::recvPkt TX COMPLETED call txDone");
+						SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::recvPkt TX COMPLETED call txDone");
 						
 						txDone();							
 					}
@@ -2670,7 +2638,7 @@ int Sunset_MicroModem::recvPkt(char * buf)
 						
 						d_status = MM_DRIVER_WAIT_DRQ;
 						
-						Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::recvPkt TXF  TX COMPLETED CYC");
+						SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::recvPkt TXF  TX COMPLETED CYC");
 					}
 				}
 				else if (d_status == MM_DRIVER_ERROR && !use_XST) {
@@ -2685,7 +2653,7 @@ int Sunset_MicroModem::recvPkt(char * buf)
 							
 						}
 						
-						Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::recvPkt TX DATA COMPLETED ERROR wantAck %d useXst %d STATE %d", want_ACK, use_XST, STATE);
+						SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::recvPkt TX DATA COMPLETED ERROR wantAck %d useXst %d STATE %d", want_ACK, use_XST, STATE);
 						
 						txAborted();
 					}
@@ -2738,7 +2706,7 @@ int Sunset_MicroModem::recvPkt(char * buf)
 					
 					if (d_status == MM_DRIVER_TX_CYC) {
 						
-						Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_MicroModem::recvPkt XST TX COMPLETED %d should be CCCYC", STATE);
+						SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_MicroModem::recvPkt XST TX COMPLETED %d should be CCCYC", STATE);
 						
 						if (timeoutTimer_.busy()) {
 							
@@ -2749,7 +2717,7 @@ int Sunset_MicroModem::recvPkt(char * buf)
 					}
 					else if (isTxStatus(d_status)) {
 						
-						Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_MicroModem::recvPkt XST TX COMPLETED %d OK", STATE);
+						SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_MicroModem::recvPkt XST TX COMPLETED %d OK", STATE);
 						
 						txDone();
 					}
@@ -2765,14 +2733,14 @@ int Sunset_MicroModem::recvPkt(char * buf)
 								
 							}
 							
-							Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::recvPkt XST msg ERROR wantAck %d useXst %d STATE %d", want_ACK, use_XST, STATE);
+							SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::recvPkt XST msg ERROR wantAck %d useXst %d STATE %d", want_ACK, use_XST, STATE);
 							
 							txAborted();
 						}
 						
 					}
 					else {
-						Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::recvPkt CAXST d_status %d STATE %d ERROR", d_status, STATE);
+						SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::recvPkt CAXST d_status %d STATE %d ERROR", d_status, STATE);
 						exit(1);
 						
 					}
@@ -2781,19 +2749,19 @@ int Sunset_MicroModem::recvPkt(char * buf)
 					
 					if (isTxStatus(d_status) || d_status == MM_DRIVER_ERROR) {
 						
-						Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_MicroModem::recvPkt XST TX ABORTED result %d OK", xst.result);
+						SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_MicroModem::recvPkt XST TX ABORTED result %d OK", xst.result);
 						txAborted();
 					}
 					else {
 						
-						Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::recvPkt CAXST d_status %d STATE %d ERROR", d_status, STATE);
+						SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::recvPkt CAXST d_status %d STATE %d ERROR", d_status, STATE);
 						
 						exit(1);
 						
 					}
 				}
 				
-				Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::recvPkt TX COMPLETED XST result %d rate %d carrier %d txbytes %d pktType %d STATE %d", xst.result, xst.rate, xst.carrier, xst.txbytes, xst.pktype, STATE);
+				SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::recvPkt TX COMPLETED XST result %d rate %d carrier %d txbytes %d pktType %d STATE %d", xst.result, xst.rate, xst.carrier, xst.txbytes, xst.pktype, STATE);
 			}
 			
 			break;
@@ -2822,7 +2790,7 @@ int Sunset_MicroModem::recvPkt(char * buf)
 					want_ACK = 0;
 					
 					
-					Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::recvPkt NMEA_CAACK src %d dst %d", ack.src, ack.dest);
+					SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::recvPkt NMEA_CAACK src %d dst %d", ack.src, ack.dest);
 					
 					if (ack.dest == getModuleAddress()) {
 						
@@ -2830,7 +2798,7 @@ int Sunset_MicroModem::recvPkt(char * buf)
 					} 
 					else {
 						
-						Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_MicroModem::recvPkt NMEA_CAACK src %d dst %d state %d ERROR",  ack.src, ack.dest, STATE);
+						SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_MicroModem::recvPkt NMEA_CAACK src %d dst %d state %d ERROR",  ack.src, ack.dest, STATE);
 					}
 				}				
 			}
@@ -2843,7 +2811,7 @@ int Sunset_MicroModem::recvPkt(char * buf)
 			char * ret;
 			size_t dim;
 			
-			Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_MicroModem::recvPkt get hex data");
+			SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_MicroModem::recvPkt get hex data");
 			
 			if (mm_messages->sscannmea(buf, pktType, &rxd) > 0)
 			{
@@ -2878,7 +2846,7 @@ int Sunset_MicroModem::recvPkt(char * buf)
 				
 				if ( ret == NULL ) {
 					
-					Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_MicroModem::recvPkt MALLOC ERROR", dim);
+					SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_MicroModem::recvPkt MALLOC ERROR", dim);
 					exit(1);
 				}
 				
@@ -2895,7 +2863,7 @@ int Sunset_MicroModem::recvPkt(char * buf)
 					
 					bufferRx.push_back(pair);
 					
-					Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_MicroModem::recvPkt received  HEX dim %d", dim);
+					SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_MicroModem::recvPkt received  HEX dim %d", dim);
 					
 					if (d_status == MM_DRIVER_RX_DATA) {
 						
@@ -2906,7 +2874,7 @@ int Sunset_MicroModem::recvPkt(char * buf)
 						d_status = MM_DRIVER_WAIT_MINI_PKT_CST;
 					}
 					else {
-						Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::recvPkt CARXD d_status %d STATE %d ERROR", d_status, STATE);
+						SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::recvPkt CARXD d_status %d STATE %d ERROR", d_status, STATE);
 						
 						exit(1);
 					}
@@ -2934,7 +2902,7 @@ int Sunset_MicroModem::recvPkt(char * buf)
 			carxa_t rxa;	
 			char* ret;
 			
-			Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_MicroModem::recvPkt get ascii data");
+			SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_MicroModem::recvPkt get ascii data");
 			
 			if (mm_messages->sscannmea(buf, pktType, &rxa) > 0) {
 				
@@ -2968,7 +2936,7 @@ int Sunset_MicroModem::recvPkt(char * buf)
 				
 				if ( ret == NULL ) {
 					
-					Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_MicroModem::recvPkt MALLOC ERROR");
+					SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_MicroModem::recvPkt MALLOC ERROR");
 					exit(1);
 				}
 				
@@ -2984,7 +2952,7 @@ int Sunset_MicroModem::recvPkt(char * buf)
 					
 					bufferRx.push_back(pair);
 					
-					Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_MicroModem::recvPkt received  ASCII dim %d", rxa.len);
+					SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_MicroModem::recvPkt received  ASCII dim %d", rxa.len);
 					
 					if (d_status == MM_DRIVER_RX_DATA) {
 						
@@ -3081,7 +3049,7 @@ int Sunset_MicroModem::recvPkt(char * buf)
 				
 				STATE = MM_S_WAIT_CMD;
 				
-				Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_MicroModem::recvPkt received  CACST  state %d status %d",  STATE, d_status);
+				SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_MicroModem::recvPkt received  CACST  state %d status %d",  STATE, d_status);
 				
 				if (cst.mode == 0) {
 					
@@ -3105,13 +3073,13 @@ int Sunset_MicroModem::recvPkt(char * buf)
 								
 								receivedPkt = 0;
 								
-								Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::recvPkt reception CACST MINI_PKT GOOD status STATE %d status %d", STATE, d_status);
+								SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::recvPkt reception CACST MINI_PKT GOOD status STATE %d status %d", STATE, d_status);
 								
 								break;
 							}
 							else {
 								
-								Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_MicroModem::recvPkt reception CACST MINI_PKT GOOD but receivedPkt = 0 ERROR");
+								SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_MicroModem::recvPkt reception CACST MINI_PKT GOOD but receivedPkt = 0 ERROR");
 								
 								exit(1);
 							}
@@ -3120,7 +3088,7 @@ int Sunset_MicroModem::recvPkt(char * buf)
 							
 							d_status = MM_DRIVER_RX_DATA;
 							
-							Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::recvPkt reception CACST CCCYC GOOD status STATE %d status %d RECEIVING", STATE, d_status);
+							SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::recvPkt reception CACST CCCYC GOOD status STATE %d status %d RECEIVING", STATE, d_status);
 							
 							break;
 						}
@@ -3128,21 +3096,21 @@ int Sunset_MicroModem::recvPkt(char * buf)
 							
 							clearRxInfo();
 							
-							Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::recvPkt reception CACST ERROR msg MINI GOOD status STATE %d status %d", STATE, d_status);
+							SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::recvPkt reception CACST ERROR msg MINI GOOD status STATE %d status %d", STATE, d_status);
 							
 							break;
 						}
 						else {
-							Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::recvPkt reception CACST MINI_PKT GOOD ERROR status STATE %d status %d", STATE, d_status);
+							SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::recvPkt reception CACST MINI_PKT GOOD ERROR status STATE %d status %d", STATE, d_status);
 							
 							exit(1);
 						}
 						
-						Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::recvPkt reception CACST MINI_PKT GOOD status STATE %d status %d", STATE, d_status);
+						SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::recvPkt reception CACST MINI_PKT GOOD status STATE %d status %d", STATE, d_status);
 					}
 					else {
 						
-						Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::recvPkt reception CACST GOOD status %d", d_status);
+						SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::recvPkt reception CACST GOOD status %d", d_status);
 						
 						if (d_status == MM_DRIVER_WAIT_DATA_CST) {
 							
@@ -3152,7 +3120,7 @@ int Sunset_MicroModem::recvPkt(char * buf)
 							
 							if (bufferRx.empty()) {
 								
-								Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_MicroModem::recvPkt reception CACST bufferRX EMPTY ERROR");
+								SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_MicroModem::recvPkt reception CACST bufferRX EMPTY ERROR");
 								
 								exit(1);
 							}
@@ -3177,7 +3145,7 @@ int Sunset_MicroModem::recvPkt(char * buf)
 								timeoutTimer_.stop();
 							}
 							
-							Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::recvPkt reception CACST DATA GOOD status STATE %d status %d", STATE, d_status);
+							SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::recvPkt reception CACST DATA GOOD status STATE %d status %d", STATE, d_status);
 							
 							if (!(bufferRx.empty())) {
 								
@@ -3195,12 +3163,12 @@ int Sunset_MicroModem::recvPkt(char * buf)
 							
 							clearRxInfo();
 							
-							Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::recvPkt reception CACST ERROR msg DATA GOOD status STATE %d status %d", STATE, d_status);
+							SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::recvPkt reception CACST ERROR msg DATA GOOD status STATE %d status %d", STATE, d_status);
 							
 							break;
 						}
 						else {
-							Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::recvPkt reception CACST DATA GOOD ERROR status STATE %d status %d", STATE, d_status);
+							SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::recvPkt reception CACST DATA GOOD ERROR status STATE %d status %d", STATE, d_status);
 							
 							exit(1);
 						}
@@ -3208,7 +3176,7 @@ int Sunset_MicroModem::recvPkt(char * buf)
 				}
 				else {
 					
-					Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::recvPkt reception CACST with problems %d - status %d", cst.result, d_status);						
+					SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::recvPkt reception CACST with problems %d - status %d", cst.result, d_status);						
 					if (isTxStatus(d_status)) { 
 						
 						txAborted();
@@ -3219,7 +3187,7 @@ int Sunset_MicroModem::recvPkt(char * buf)
 					}		
 				}
 				
-				Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::recvPkt reception CACST rate %d src %d dst %d nfrmaes %d noise %f", cst.rate, cst.src, cst.dest, cst.nframes, cst.stddev);
+				SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::recvPkt reception CACST rate %d src %d dst %d nfrmaes %d noise %f", cst.rate, cst.src, cst.dest, cst.nframes, cst.stddev);
 			}
 			
 			break;
@@ -3245,7 +3213,7 @@ int Sunset_MicroModem::recvPkt(char * buf)
 				
 				if (d_status == MM_DRIVER_SETUP) {
 					
-					Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_MicroModem::recvPkt NMEA_CAMUA src %d dst %d state %d sttaus %d BREAK", mua.src, mua.dest, STATE, d_status);
+					SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_MicroModem::recvPkt NMEA_CAMUA src %d dst %d state %d sttaus %d BREAK", mua.src, mua.dest, STATE, d_status);
 					break;
 				}
 				
@@ -3258,7 +3226,7 @@ int Sunset_MicroModem::recvPkt(char * buf)
 					STATE = MM_S_WAIT_CMD;
 				}
 				
-				Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::recvPkt NMEA_CAMUA src %d dst %d use_CST %d", mua.src, mua.dest, use_CST);
+				SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::recvPkt NMEA_CAMUA src %d dst %d use_CST %d", mua.src, mua.dest, use_CST);
 				
 				if (d_status != MM_DRIVER_IDLE && d_status != MM_DRIVER_ERROR) {
 					
@@ -3291,7 +3259,7 @@ int Sunset_MicroModem::recvPkt(char * buf)
 						
 						timeoutTimer_.start(TIMEOUT_MM_MINI_PKT);
 						
-						Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_MicroModem::recvPkt waiting to receive a mini_pkt src %d dst %d use_CST %d receivedPkt == 0 (%d)", mua.src, mua.dest, use_CST, receivedPkt == 0);
+						SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_MicroModem::recvPkt waiting to receive a mini_pkt src %d dst %d use_CST %d receivedPkt == 0 (%d)", mua.src, mua.dest, use_CST, receivedPkt == 0);
 					}
 					else {
 						
@@ -3304,7 +3272,7 @@ int Sunset_MicroModem::recvPkt(char * buf)
 				}
 				else {
 					
-					Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_MicroModem::recvPkt NMEA_CAMUA src %d dst %d state %d sttaus %d ERROR", mua.src, mua.dest, STATE, d_status);
+					SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_MicroModem::recvPkt NMEA_CAMUA src %d dst %d state %d sttaus %d ERROR", mua.src, mua.dest, STATE, d_status);
 				}
 			}
 			
@@ -3537,7 +3505,7 @@ int Sunset_MicroModem::recvPkt(char * buf)
 void Sunset_MicroModem::rx_thread()
 {
 	
-	Sunset_Debug::debugInfo(1, getModuleAddress(), "Sunset_MicroModem::rx_thread() start");
+	SUNSET_DEBUG_LOG(1, getModuleAddress(), "Sunset_MicroModem::rx_thread() start");
 	
 	while(listening == 1) {
 		
@@ -3562,7 +3530,7 @@ void Sunset_MicroModem::rx_thread()
 	reconnTimer_.start(0.01);
 	pthread_mutex_unlock(&mutex_mm_timer_connection);
 	
-	Sunset_Debug::debugInfo(1, getModuleAddress(), "Sunset_MicroModem::rx_thread() exit");
+	SUNSET_DEBUG_LOG(1, getModuleAddress(), "Sunset_MicroModem::rx_thread() exit");
 	
 	pthread_exit(NULL);
 }
@@ -24,6 +24,7 @@
 #include <sunset_micro_modem_messages.h>
 #include <sunset_generic_modem.h>
 #include <sunset_micro_modem_connection.h>
+#include <sunset_rx_channel.h>
 
 #define MM_MODEM_PORT		1	//Communication port on modem side
 #define MM_MODEM_FLAG		0	//DRQ flag for communication set-up (initialization part of each communication host-modem)
@@ -198,7 +199,7 @@ protected:
 	Sunset_MM_RecvTimer recvTimer_;
 	Sunset_MM_ReconnTimer reconnTimer_;
 	
-	list<char*> rxDataBuffer;
+	Sunset_Rx_Channel rxChannel_;	/* Messages received by the listener thread */
 	Sunset_MicroModem_Conn * mm_conn;
 	char modemVersion[UMMAXVRSZ];
 	list<pair<int, char*> > setupInfo; /* int = msg has to be necessary confirmed - char* msg to send  */
@@ -17,8 +17,6 @@
  * along with this program. If not, see <http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode>.
  */
 
-#include <poll.h>
-
 #include <sunset_micro_modem_connection.h>
 
 Sunset_MicroModem_Conn::Sunset_MicroModem_Conn(const char *devName,  int rate) : Sunset_Serial_Connection(devName, rate)
@@ -33,7 +31,7 @@ Sunset_MicroModem_Conn::~Sunset_MicroModem_Conn() {
 
 bool Sunset_MicroModem_Conn::open_connection() {
 	
-	Sunset_Debug::debugInfo(4, -1, "Sunset_MicroModem_Conn::open_connection connecting to %s baudRate %ld", serialDev, baudRate);
+	SUNSET_DEBUG_LOG(4, -1, "Sunset_MicroModem_Conn::open_connection connecting to %s baudRate %ld", serialDev, baudRate);
 	
 	return Sunset_Serial_Connection::open_connection();
 }
@@ -42,322 +40,77 @@ bool Sunset_MicroModem_Conn::open_connection() {
 
 bool Sunset_MicroModem_Conn::close_connection() {
 	
-	Sunset_Debug::debugInfo(4, -1, "Sunset_MicroModem_Conn::close_connection close_connection to %s baudRate %ld", serialDev, baudRate);
+	SUNSET_DEBUG_LOG(4, -1, "Sunset_MicroModem_Conn::close_connection close_connection to %s baudRate %ld", serialDev, baudRate);
 	
 	return Sunset_Serial_Connection::close_connection();
 }
 
-/*! 	@brief The um_poll function polls serial device to check for non-blocking read. 
- *	@param dev The device to be polled.
- * 	@retval > 0  if device is ready to be read.
+/*!	@brief The read_sentence function extracts the next NMEA sentence received by the modem. All the bytes available on the 
+ *	serial line are read at once, the sentence is returned in place without copying it.
+ *	@param[out] sentence The pointer to the sentence ("$...\r\n"), valid until the next call.
+ *	@param max_len The maximum length of a sentence.
+ * 	@retval The length of the sentence, 0 if no sentence has been received before the timeout, -1 on error.
  */
 
-int Sunset_MicroModem_Conn::um_poll(int dev)
+int Sunset_MicroModem_Conn::read_sentence(char** sentence, int max_len) 
 {
-	int ret;
-	struct pollfd pfd;
-	
-	pfd.fd      = dev;
-	pfd.events  = POLLIN;
-	pfd.revents = 0;
-	
-	//	poll works as select ... wait I/O on array of descpritor (first argument), 
-	//	size of the array (second argument), timeout (third argument)
-	
-	ret = poll(&pfd, 1, 100000); 
+	int len = 0;
+	int res = 0;
 	
-	if (0 > ret) {
+	while (true) {
+		
+		len = reader.nextSentence('$', max_len, sentence);
+		
+		if (len > 0) {
+			
+			SUNSET_DEBUG_LOG(6, -1, "Sunset_MicroModem_Conn::read_sentence %.*s", len, *sentence);
+			
+			return len;
+		}
+		
+		res = reader.fill(fd, MM_POLL_TIMEOUT);
+		
+		if (res < 0) {
+			
+			SUNSET_DEBUG_LOG(-1, -1, "Sunset_MicroModem_Conn::read_sentence reading from %s ERROR", serialDev);
+			
+			return -1;
+		}
 		
-		perror("poll");
+		if (res == 0) {
+			
+			return 0;
+		}
 		
-		return -1;
+		SUNSET_DEBUG_LOG(6, -1, "Sunset_MicroModem_Conn::read_sentence read %d bytes", res);
 	}
-	
-	if (POLLIN & pfd.revents) 
-		return 1;
-	
-	return 0;
 }
 
-
-/*!	@brief The read_data function reads from the serial line looking for packet delimiter 
- *	to extract the packet received by the modem which ahs to be provided to the upper layers.
- *	@param buf The buffer to be read.
+/*!	@brief The read_data function reads from the serial line the next packet received by the modem which has to be 
+ *	provided to the upper layers.
+ *	@param buf The buffer where the packet is copied.
  *	@param maxlen The maximal length of the buffer.
  * 	@retval The number of bytes correctly read.
  */
 
 int Sunset_MicroModem_Conn::read_data(char * buf, int max_len) 
 {
-	int i = 0;
-  	char ch;
-	int start = 0;
-	int res = 0;
+	char* sentence = 0;
+	int len = 0;
 	
-	while (um_poll(fd)) {
-		
-		res = read (fd, &ch, 1);
+	len = read_sentence(&sentence, max_len);
+	
+	if (len <= 0) {
 		
-		Sunset_Debug::debugInfo(6, -1, "Sunset_MicroModem_Conn::read_data start char i = %d - %d (%x)", i, ch, ch);
+		return 0;
+	}
+	
+	memcpy(buf, sentence, len);
+	
+	if (len < max_len) {
 		
-		if (ch == '$') {
-			
-			if (!start) {
-				
-				i = 0;
-			}
-			
-			buf[i++] = ch;
-			
-			Sunset_Debug::debugInfo(6, -1, "Sunset_MicroModem_Conn::read_data start");
-			
-			if (start) {
-				
-				buf[i++] = '\0';
-				
-				Sunset_Debug::debugInfo(-1, -1, "Sunset_MicroModem_Conn::read_data set start to 1 twice ERROR %s", buf);
-				
-				start = 0;
-				i = 0;
-				
-				buf[i++] = ch;
-			}
-			
-			start = 1;
-		}
-		else if(ch == '\r') {
-			
-			if ( i >= max_len ) {
-				
-				Sunset_Debug::debugInfo(-1, -1, "Sunset_MicroModem_Conn::read_data too many characters have been read 1 ERROR");
-				
-				return 0;
-			}
-			
-			buf[i++]=ch;
-			
-			res = read (fd, &ch, 1);
-			
-			Sunset_Debug::debugInfo(6, -1, "Sunset_MicroModem_Conn::read_data start char i = %d - %d (%x)", i, ch, ch);
-			
-			if(ch == '\n')  { /* end packet */
-				
-				if (i >= max_len) {
-					
-					Sunset_Debug::debugInfo(-1, -1, "Sunset_MicroModem_Conn::read_data too many characters have been read 2 ERROR");
-					
-					return 0;
-				}
-				
-				buf[i++] = ch;
-				
-				if (!start) {
-					
-					Sunset_Debug::debugInfo(-1, -1, "Sunset_MicroModem_Conn::read_data set end with no start1 ERROR");
-					
-					return 0;
-				}
-				else {
-					
-					start = 0;
-				}
-				
-				return i;
-			}
-			else if(ch == '\r') {
-				
-				if (i >= max_len) {
-					
-					Sunset_Debug::debugInfo(-1, -1, "Sunset_MicroModem_Conn::read_data too many characters have been read 3 ERROR");
-					
-					return 0;
-				}
-				
-				buf[i++] = '\n';
-				
-				if (!start) {
-					
-					Sunset_Debug::debugInfo(-1, -1, "Sunset_MicroModem_Conn::read_data set end with no start2 ERROR");
-					
-					return 0;
-				}
-				else {
-					
-					start = 0;
-				}
-				
-				return i;
-			}
-			else if (ch == '$') {
-				
-				if (!start) {
-					
-					i = 0;
-				}
-				
-				buf[i++] = ch;
-				
-				Sunset_Debug::debugInfo(6, -1, "Sunset_MicroModem_Conn::read_data start2");
-				
-				if (start) {
-					
-					buf[i++] = '\0';
-					
-					Sunset_Debug::debugInfo(-1, -1, "Sunset_MicroModem_Conn::read_data set start2 to 1 twice ERROR %s", buf);
-					
-					start = 0;
-					i = 0;
-					
-					buf[i++] = ch;
-				}
-				
-				start = 1;
-			}
-			else {
-				if (i >= max_len) {
-					
-					Sunset_Debug::debugInfo(-1, -1, "Sunset_MicroModem_Conn::read_data too many characters have been read 4 ERROR");
-					
-					return 0;
-				}
-				
-				buf[i++] = ch;
-			}
-			
-			
-		}
-		else if(ch == '\n') {
-			
-			if (i >= max_len) {
-				
-				Sunset_Debug::debugInfo(-1, -1, "Sunset_MicroModem_Conn::read_data too many characters have been read 5 ERROR");
-				
-				return 0;
-			}
-			
-			buf[i++]=ch;
-			
-			res = read (fd, &ch, 1);
-			
-			Sunset_Debug::debugInfo(6, -1, "Sunset_MicroModem_Conn::read_data start char i = %d - %d (%x)", i, ch, ch);
-			
-			if(ch == '\n') { /* end packet */
-				
-				if (i >= max_len) {
-					
-					Sunset_Debug::debugInfo(-1, -1, "Sunset_MicroModem_Conn::read_data too many characters have been read 6 ERROR");
-					
-					return 0;
-				}
-				
-				buf[i++] = ch;
-				
-				if (i-2 > 0) {
-					
-					buf[i-2] = '\r';
-					
-					if (!start) {
-						
-						Sunset_Debug::debugInfo(-1, -1, "Sunset_MicroModem_Conn::read_data set end with no start1 ERROR");
-						
-						return 0;
-					}
-					else {
-						
-						start = 0;
-					}
-					
-					return i;
-				}
-				
-				Sunset_Debug::debugInfo(-1, -1, "Sunset_MicroModem_Conn::read_data ERROR on indexes!!!");
-				
-				start = 0;
-				
-				return 0;
-			}
-			else if(ch == '\r') {
-				
-				if (i >= max_len) {
-					
-					Sunset_Debug::debugInfo(-1, -1, "Sunset_MicroModem_Conn::read_data too many characters have been read 7 ERROR");
-					
-					return 0;
-				}
-				
-				buf[i++] = '\n';
-				
-				if (i-2 > 0) {
-					
-					buf[i-2] = '\r';
-					
-					if (!start) {
-						
-						Sunset_Debug::debugInfo(-1, -1, "Sunset_MicroModem_Conn::read_data set end with no start1 ERROR");
-						
-						return 0;
-					}
-					else {
-						
-						start = 0;
-					}
-					
-					return i;
-				}
-				
-				Sunset_Debug::debugInfo(-1, -1, "Sunset_MicroModem_Conn::read_data ERROR on indexes 2!!!");
-				
-				start = 0;
-				
-				return 0;
-			}
-			else if (ch == '$') {
-				
-				if (!start) {
-					
-					i = 0;
-				}
-				
-				buf[i++] = ch;
-				
-				Sunset_Debug::debugInfo(6, -1, "Sunset_MicroModem_Conn::read_data start3");
-				
-				if (start) {
-					
-					buf[i++] = '\0';
-					Sunset_Debug::debugInfo(-1, -1, "Sunset_MicroModem_Conn::read_data set start3 to 1 twice ERROR %s", buf);
-					
-					start = 0;
-					i = 0;
-					
-					buf[i++] = ch;
-				}
-				
-				start = 1;
-			}
-			else {
-				if (i >= max_len) {
-					
-					Sunset_Debug::debugInfo(-1, -1, "Sunset_MicroModem_Conn::read_data too many characters have been read 8 ERROR");
-					
-					return 0;
-				}
-				
-				buf[i++] = ch;
-			}
-		}
-		else
-		{
-			if (i >= max_len) {
-				
-				Sunset_Debug::debugInfo(-1, -1, "Sunset_MicroModem_Conn::read_data too many characters have been read 9 ERROR");
-				
-				return 0;
-			}
-			
-			buf[i++] = ch;
-		}
+		buf[len] = '\0';
 	}
 	
-	return i;
+	return len;
 }
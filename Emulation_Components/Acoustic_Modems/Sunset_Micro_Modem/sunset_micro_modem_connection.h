@@ -22,8 +22,10 @@
 #define __Sunset_MicroModem_Conn_h__  
 
 #include <sunset_serial.h>
+#include <sunset_frame_reader.h>
 
 #define MM_TIMEOUT_CONNECTION 5
+#define MM_POLL_TIMEOUT	100000	/*!< @brief Maximum time (ms) waiting for data on the serial line. */
 
 
 /*! @brief This class is used for the connection to the Micro-Modem. A serial line connection is used.
@@ -39,11 +41,12 @@ public:
 	
 public:
 	int read_data(char *recvb, int max_len);
+	int read_sentence(char** sentence, int max_len);
 	virtual bool open_connection();
 	virtual bool close_connection();
 	
 protected:
-	int um_poll(int dev);
+	Sunset_Frame_Reader reader;	// buffered reader extracting the NMEA sentences
 };
 
 #endif
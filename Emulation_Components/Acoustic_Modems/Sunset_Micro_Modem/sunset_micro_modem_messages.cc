@@ -43,7 +43,7 @@ void MicroModem_Messages::calculateCheckSum(char *buf)
 	char checksum [3] = {'\0'};
 	long chksum = 0;
 	
-	Sunset_Debug::debugInfo(10, -1, "MicroModem_Messages::calculateCheckSum");
+	SUNSET_DEBUG_LOG(10, -1, "MicroModem_Messages::calculateCheckSum");
 	
 	buf[strlen(buf)-2] = '*';
 	buf[strlen(buf)-1] = '\0';
@@ -506,11 +506,11 @@ int MicroModem_Messages::NMEAPktType(char* buf)
 {
 	int aux = 0;
 	
-	Sunset_Debug::debugInfo(5, -1, "MicroModem_Messages::NMEAPktType %s %s", buf, buf+1);
+	SUNSET_DEBUG_LOG(5, -1, "MicroModem_Messages::NMEAPktType %s %s", buf, buf+1);
 	
 	aux = um_hash_nmea(buf+1);
 	
-	Sunset_Debug::debugInfo(5, -1, "MicroModem_Messages::NMEAPktType aux %d", aux);
+	SUNSET_DEBUG_LOG(5, -1, "MicroModem_Messages::NMEAPktType aux %d", aux);
 	
 	return aux;	    
 }
@@ -0,0 +1,9 @@
+static char code[] = "\n\
+\n\
+Scheduler/Sunset_RealTime/Monotonic set spinWindow_ 0.0002;	# time (sec) spent spinning before an event deadline instead of sleeping\n\
+Scheduler/Sunset_RealTime/Monotonic set wallStep_ 0.1;		# difference (sec) between wall-clock and monotonic time compensated as a wall-clock step\n\
+Scheduler/Sunset_RealTime/Monotonic set cpu_ -1;			# CPU the scheduler thread is bound to, -1 if not bound\n\
+Scheduler/Sunset_RealTime/Monotonic set fifoPriority_ 0;		# SCHED_FIFO priority of the scheduler thread (1-99), 0 to keep the default policy\n\
+";
+#include "tclcl.h"
+EmbeddedTcl Sunset_Monotonic_Scheduler_TclCode(code);
@@ -0,0 +1,8 @@
+#include <tclcl.h>
+
+extern EmbeddedTcl Sunset_Monotonic_Scheduler_TclCode;
+
+extern "C" int Sunset_emulation_monotonic_scheduler_Init() {
+    Sunset_Monotonic_Scheduler_TclCode.load();
+    return 0;
+}
@@ -0,0 +1,6 @@
+# Dummy Initialization
+
+Scheduler/Sunset_RealTime/Monotonic set spinWindow_ 0.0002;	# time (sec) spent spinning before an event deadline instead of sleeping
+Scheduler/Sunset_RealTime/Monotonic set wallStep_ 0.1;		# difference (sec) between wall-clock and monotonic time compensated as a wall-clock step
+Scheduler/Sunset_RealTime/Monotonic set cpu_ -1;			# CPU the scheduler thread is bound to, -1 if not bound
+Scheduler/Sunset_RealTime/Monotonic set fifoPriority_ 0;		# SCHED_FIFO priority of the scheduler thread (1-99), 0 to keep the default policy
@@ -0,0 +1,255 @@
+/* SUNSET - Sapienza University Networking framework for underwater Simulation, Emulation and real-life Testing
+ *
+ * Copyright (C) 2012 Regents of UWSN Group of SENSES Lab <http://reti.dsi.uniroma1.it/SENSES_lab/>
+ *
+ * Author: Roberto Petroccia - petroccia@di.uniroma1.it
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License as published
+ * at http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANATBILITY or FITNESS FOR A PARTICULAR PURPOSE. See the Creative Commons
+ * Attribution-NonCommercial-ShareAlike 3.0 Unported License for more details.
+ *
+ * You should have received a copy of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License
+ * along with this program. If not, see <http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode>.
+ */
+
+#include "sunset_monotonic_scheduler.h"
+
+static class Sunset_MonotonicSchedulerClass : public TclClass {
+public:
+
+	Sunset_MonotonicSchedulerClass() : TclClass("Scheduler/Sunset_RealTime/Monotonic") {}
+
+	TclObject* create(int, const char*const*) {
+
+		return (new Sunset_MonotonicScheduler);
+	}
+
+} class_Sunset_MonotonicScheduler;
+
+/*!
+ * 	@brief The constructor binds the real-time settings and sets the monotonic clock of the condition variable signalled by schedule().
+ */
+
+Sunset_MonotonicScheduler::Sunset_MonotonicScheduler() : Sunset_RealTimeScheduler()
+{
+	spinWindow_ = SUNSET_RT_SPIN_WINDOW;
+	wallStep_ = SUNSET_RT_WALL_STEP;
+	cpu_ = -1;
+	fifoPriority_ = 0;
+	lateEvents_ = 0;
+
+	bind("spinWindow_", &spinWindow_);
+	bind("wallStep_", &wallStep_);
+	bind("cpu_", &cpu_);
+	bind("fifoPriority_", &fifoPriority_);
+
+	// no thread is waiting on the condition variable yet, it can be initialized again on the monotonic clock
+
+	pthread_cond_destroy(&cond_mutex);
+	rtClock_.initCondition(&cond_mutex);
+
+	rtClock_.reset(getNOW());
+}
+
+Sunset_MonotonicScheduler::~Sunset_MonotonicScheduler()
+{
+}
+
+/*!
+ * 	@brief The reset() function resets the emulation start time, as done by Sunset_RealTimeScheduler, and aligns the monotonic time base to it.
+ */
+
+void Sunset_MonotonicScheduler::reset()
+{
+	Sunset_RealTimeScheduler::reset();
+
+	rtClock_.reset(getNOW());
+
+	clock_ = rtClock_.now();
+}
+
+/*!
+ * 	@brief The sync() function sets the scheduler clock to the monotonic emulation time.
+ */
+
+void Sunset_MonotonicScheduler::sync()
+{
+	clock_ = rtClock_.now();
+}
+
+/*!
+ * 	@brief The configureThread() function applies the real-time settings to the scheduler thread: spin window, wall-clock step threshold,
+ *	CPU pinning and SCHED_FIFO priority.
+ */
+
+void Sunset_MonotonicScheduler::configureThread()
+{
+	rtClock_.setSpinWindow(spinWindow_);
+	rtClock_.setStepThreshold(wallStep_);
+
+	if ( cpu_ >= 0 ) {
+
+		Sunset_Utilities::setCpuAffinity(cpu_);
+	}
+
+	if ( fifoPriority_ > 0 ) {
+
+		Sunset_Utilities::setRealTimePriority(fifoPriority_);
+	}
+
+	SUNSET_DEBUG_LOG(1, -1, "Sunset_MonotonicScheduler::configureThread spinWindow %f wallStep %f cpu %d fifoPriority %d", spinWindow_, wallStep_, cpu_, fifoPriority_);
+}
+
+/*!
+ * 	@brief The checkWallClock() function compensates the wall-clock steps. getNOW() and getEpoch() are computed from the wall-clock,
+ *	when it is moved the emulation start time is moved by the same step so that getNOW() keeps following the monotonic time.
+ */
+
+void Sunset_MonotonicScheduler::checkWallClock()
+{
+	double step = rtClock_.checkStep(getNOW());
+
+	if ( step == 0.0 ) {
+
+		return;
+	}
+
+	pthread_mutex_lock(&current_time_mutex);
+
+	start_ += step;
+
+	pthread_mutex_unlock(&current_time_mutex);
+
+	SUNSET_DEBUG_LOG(1, -1, "Sunset_MonotonicScheduler::checkWallClock wall-clock step %f sec compensated", step);
+}
+
+/*!
+ * 	@brief The updateCurrentTime() function updates the wall-clock time used by tod(), which sets the clock of the events scheduled by the
+ *	other threads using schedule().
+ */
+
+void Sunset_MonotonicScheduler::updateCurrentTime()
+{
+	pthread_mutex_lock(&current_time_mutex);
+
+	clock_gettime(CLOCK_REALTIME, &current_time);
+
+	pthread_mutex_unlock(&current_time_mutex);
+}
+
+/*!
+ * 	@brief The run() function executes the events at their time. The event queue is accessed with sched_mutex locked, which is the mutex
+ *	used by schedule() when signalling a new event, and it is released when an event is dispatched. The scheduler waits for the next
+ *	event, or for a new one, on the monotonic condition variable until spinWindow_ before its time and then spins. An event scheduled
+ *	while spinning is dispatched at most spinWindow_ late.
+ */
+
+void Sunset_MonotonicScheduler::run()
+{
+	Event* p = 0;
+	double late = 0.0;
+
+	instance_ = this;
+
+	configureThread();
+
+	while ( !halted_ ) {
+
+		checkWallClock();
+		updateCurrentTime();
+
+		pthread_mutex_lock(&sched_mutex);
+
+		clock_ = rtClock_.now();
+		p = (Event*)head();
+
+		if ( p == 0 ) {
+
+			rtClock_.waitUntil(clock_ + SUNSET_RT_IDLE_WAIT, &cond_mutex, &sched_mutex);
+
+			pthread_mutex_unlock(&sched_mutex);
+
+			continue;
+		}
+
+		if ( p->time_ > clock_ ) {
+
+			// a new event can be scheduled before p, the queue is checked again after the wait
+
+			rtClock_.waitUntil(p->time_, &cond_mutex, &sched_mutex);
+
+			pthread_mutex_unlock(&sched_mutex);
+
+			continue;
+		}
+
+		p = deque();
+
+		pthread_mutex_unlock(&sched_mutex);
+
+		clock_ = rtClock_.now();
+		late = clock_ - p->time_;
+
+		rtClock_.recordLateness(late);
+
+		if ( late > slop_ ) {
+
+			lateEvents_++;
+
+			SUNSET_DEBUG_LOG(3, -1, "Sunset_MonotonicScheduler::run event %f dispatched at %f, %f sec late", p->time_, clock_, late);
+		}
+
+		dispatch(p, clock_);
+	}
+
+	SUNSET_DEBUG_LOG(1, -1, "Sunset_MonotonicScheduler::run dispatched %ld mean lateness %f max lateness %f late %ld wall-clock steps %ld",
+			 rtClock_.getDispatched(), rtClock_.getMeanLateness(), rtClock_.getMaxLateness(), lateEvents_, rtClock_.getWallSteps());
+}
+
+/*!
+ * 	@brief The command() function is a TCL hook for all the classes in ns-2 which allows C++ functions to be called from a TCL script
+ *	@param[in] argc argc is a count of the arguments supplied to the command function.
+ *	@param[in] argv argv is an array of pointers to the strings which are those arguments.
+ *	@retval TCL_OK the command has been correctly executed.
+ *	@retval TCL_ERROR the command has NOT been correctly executed.
+ */
+
+int Sunset_MonotonicScheduler::command(int argc, const char*const* argv)
+{
+	Tcl& tcl = Tcl::instance();
+	char buf[SUNSET_RT_STATS_LEN];
+
+	if ( argc == 2 ) {
+
+		/* The "getLatenessStats" command returns the events dispatched later than maxslop_, the wall-clock steps compensated,
+		 * the number of dispatched events, the mean and maximum dispatch lateness (sec) and the lateness histogram: bin 0 counts
+		 * the events up to 1 us late and bin i the ones later than 2^(i-1) us and up to 2^i us.
+		 */
+
+		if ( strcasecmp(argv[1], "getLatenessStats") == 0 ) {
+
+			rtClock_.printLateness(buf, SUNSET_RT_STATS_LEN);
+
+			tcl.resultf("%ld %ld %s", lateEvents_, rtClock_.getWallSteps(), buf);
+
+			return TCL_OK;
+		}
+
+		/* The "clearLatenessStats" command clears the lateness histogram. */
+
+		if ( strcasecmp(argv[1], "clearLatenessStats") == 0 ) {
+
+			rtClock_.clearLateness();
+			lateEvents_ = 0;
+
+			return TCL_OK;
+		}
+	}
+
+	return Sunset_RealTimeScheduler::command(argc, argv);
+}
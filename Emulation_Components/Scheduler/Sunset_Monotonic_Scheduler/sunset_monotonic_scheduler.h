@@ -0,0 +1,69 @@
+/* SUNSET - Sapienza University Networking framework for underwater Simulation, Emulation and real-life Testing
+ *
+ * Copyright (C) 2012 Regents of UWSN Group of SENSES Lab <http://reti.dsi.uniroma1.it/SENSES_lab/>
+ *
+ * Author: Roberto Petroccia - petroccia@di.uniroma1.it
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License as published
+ * at http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANATBILITY or FITNESS FOR A PARTICULAR PURPOSE. See the Creative Commons
+ * Attribution-NonCommercial-ShareAlike 3.0 Unported License for more details.
+ *
+ * You should have received a copy of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License
+ * along with this program. If not, see <http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode>.
+ */
+
+#ifndef __Sunset_MonotonicScheduler_h__
+#define __Sunset_MonotonicScheduler_h__
+
+#include <sunset_real_time_scheduler.h>
+#include <sunset_rt_clock.h>
+
+#define SUNSET_RT_IDLE_WAIT	30.0	/*!< @brief Time (sec) waited when no events are scheduled, as done by Sunset_RealTimeScheduler. */
+#define SUNSET_RT_STATS_LEN	512	/*!< @brief Size of the buffer returned by the "getLatenessStats" command. */
+
+/*! @brief This class implements the real-time scheduler on a CLOCK_MONOTONIC time base. It is created as Scheduler/Sunset_RealTime/Monotonic
+ *  and keeps the Sunset_RealTimeScheduler interface used by the other emulation modules, only the event loop is replaced.
+ *  The scheduler thread sleeps on a monotonic condition variable until spinWindow_ before the next event and then spins, it can be bound
+ *  to a CPU and run with the SCHED_FIFO policy. The wall-clock steps are compensated moving the emulation start time, so that the
+ *  emulation time read by the modules (getNOW) keeps following the monotonic time. The lateness of each dispatched event is collected in
+ *  a logarithmic histogram.
+ */
+
+class Sunset_MonotonicScheduler : public Sunset_RealTimeScheduler {
+
+public:
+
+	Sunset_MonotonicScheduler();
+	~Sunset_MonotonicScheduler();
+
+	virtual int command(int argc, const char*const* argv);
+
+	virtual void run();
+	virtual void reset();
+	virtual void sync();
+
+	/*! @brief The getClock function returns the monotonic time base of the scheduler, with the dispatch lateness histogram. */
+	Sunset_RT_Clock& getClock() { return rtClock_; }
+
+protected:
+
+	void configureThread();
+	void checkWallClock();
+	void updateCurrentTime();
+
+	Sunset_RT_Clock rtClock_;	// monotonic time base and dispatch lateness histogram
+
+	double spinWindow_;		// time (sec) spent spinning before a deadline
+	double wallStep_;		// difference (sec) between wall-clock and monotonic time compensated as a wall-clock step
+	int cpu_;			// CPU the scheduler thread is bound to, -1 if not bound
+	int fifoPriority_;		// SCHED_FIFO priority of the scheduler thread, 0 to keep the default policy
+
+	long lateEvents_;		// events dispatched later than maxslop_
+};
+
+#endif
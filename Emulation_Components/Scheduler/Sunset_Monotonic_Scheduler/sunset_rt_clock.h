@@ -0,0 +1,239 @@
+/* SUNSET - Sapienza University Networking framework for underwater Simulation, Emulation and real-life Testing
+ *
+ * Copyright (C) 2012 Regents of UWSN Group of SENSES Lab <http://reti.dsi.uniroma1.it/SENSES_lab/>
+ *
+ * Author: Roberto Petroccia - petroccia@di.uniroma1.it
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License as published
+ * at http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANATBILITY or FITNESS FOR A PARTICULAR PURPOSE. See the Creative Commons
+ * Attribution-NonCommercial-ShareAlike 3.0 Unported License for more details.
+ *
+ * You should have received a copy of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License
+ * along with this program. If not, see <http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode>.
+ */
+
+#ifndef __Sunset_RT_Clock_h__
+#define __Sunset_RT_Clock_h__
+
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <math.h>
+#include <time.h>
+
+#define SUNSET_RT_LATENESS_BINS		24	/*!< @brief Bins of the lateness histogram, bin 0 counts the dispatches up to 1 us late and bin i the ones later than 2^(i-1) us and up to 2^i us. */
+#define SUNSET_RT_SPIN_WINDOW		0.0002	/*!< @brief Default time (sec) spent spinning before a deadline instead of sleeping. */
+#define SUNSET_RT_WALL_STEP		0.1	/*!< @brief Default difference (sec) between wall-clock and monotonic time reported as a wall-clock step. */
+
+/*! @brief This class implements the time base of Sunset_MonotonicScheduler. The time is read from CLOCK_MONOTONIC, which is not moved by
+ *  wall-clock steps (NTP, GPS or manual adjustments). The waits sleep on a condition variable until a short spin window before the
+ *  deadline and then spin, and the lateness of the dispatched events is collected in a logarithmic histogram.
+ *  It does not depend on ns-2, the scheduler keeps the ns-2 event queue and uses this class only for the time.
+ */
+
+class Sunset_RT_Clock {
+
+public:
+
+	Sunset_RT_Clock()
+	{
+		spin_ = SUNSET_RT_SPIN_WINDOW;
+		stepThreshold_ = SUNSET_RT_WALL_STEP;
+		condClock_ = CLOCK_REALTIME;
+		wallSteps_ = 0;
+
+		reset(0.0);
+		clearLateness();
+	}
+
+	/*! @brief The reset function sets the current time to t0. */
+
+	void reset(double t0)
+	{
+		clock_gettime(CLOCK_MONOTONIC, &origin_);
+
+		t0_ = t0;
+	}
+
+	/*! @brief The now function returns the current time: the time set by the last reset plus the seconds elapsed since then according to CLOCK_MONOTONIC. */
+
+	double now()
+	{
+		struct timespec ts;
+
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+
+		return t0_ + (ts.tv_sec - origin_.tv_sec) + (ts.tv_nsec - origin_.tv_nsec) * 1e-9;
+	}
+
+	/*! @brief The checkStep function compares a time read from the wall-clock with the monotonic time.
+	 *  @param wall The wall-clock time, on the same origin of now().
+	 *  @retval The wall-clock step (sec) if the difference is larger than the step threshold, 0 otherwise.
+	 */
+
+	double checkStep(double wall)
+	{
+		double diff = wall - now();
+
+		if ( fabs(diff) <= stepThreshold_ ) {
+
+			return 0.0;
+		}
+
+		wallSteps_++;
+
+		return diff;
+	}
+
+	/*! @brief The initCondition function initializes a condition variable waiting on CLOCK_MONOTONIC, to be used by waitUntil.
+	 *  If the monotonic clock cannot be set the condition variable waits on the wall-clock.
+	 */
+
+	void initCondition(pthread_cond_t* c)
+	{
+		pthread_condattr_t attr;
+
+		pthread_condattr_init(&attr);
+
+		if ( pthread_condattr_setclock(&attr, CLOCK_MONOTONIC) == 0 ) {
+
+			condClock_ = CLOCK_MONOTONIC;
+		}
+		else {
+
+			condClock_ = CLOCK_REALTIME;
+		}
+
+		pthread_cond_init(c, &attr);
+		pthread_condattr_destroy(&attr);
+	}
+
+	/*! @brief The waitUntil function waits on condition c, with mutex m locked by the caller, until time t (as returned by now()).
+	 *  The thread sleeps until the spin window before t and then spins with the mutex released, the mutex is locked again on return.
+	 *  @retval 1 If the condition has been signalled before t (i.e. a new event has been scheduled), 0 if t has been reached.
+	 */
+
+	int waitUntil(double t, pthread_cond_t* c, pthread_mutex_t* m)
+	{
+		struct timespec abs;
+		double left = t - spin_ - now();
+		int res = 0;
+
+		if ( left > 0.0 ) {
+
+			// the deadline is expressed on the clock of the condition variable
+
+			clock_gettime(condClock_, &abs);
+			addTime(&abs, left);
+
+			res = pthread_cond_timedwait(c, m, &abs);
+
+			if ( res != ETIMEDOUT || t - now() > spin_ ) {
+
+				return 1;
+			}
+		}
+
+		pthread_mutex_unlock(m);
+
+		while ( now() < t ) { }
+
+		pthread_mutex_lock(m);
+
+		return 0;
+	}
+
+	/*! @brief The recordLateness function adds to the histogram the lateness (sec) of a dispatched event. */
+
+	void recordLateness(double late)
+	{
+		double us = 0.0;
+		int bin = 0;
+
+		if ( late < 0.0 ) {
+
+			late = 0.0;
+		}
+
+		us = late * 1e6;
+
+		while ( bin < SUNSET_RT_LATENESS_BINS - 1 && us > (double)(1 << bin) ) {
+
+			bin++;
+		}
+
+		lateness_[bin]++;
+		dispatched_++;
+		sumLateness_ += late;
+
+		if ( late > maxLateness_ ) {
+
+			maxLateness_ = late;
+		}
+	}
+
+	/*! @brief The clearLateness function clears the lateness histogram. */
+
+	void clearLateness()
+	{
+		memset(lateness_, 0, sizeof(lateness_));
+		dispatched_ = 0;
+		sumLateness_ = 0.0;
+		maxLateness_ = 0.0;
+	}
+
+	/*! @brief The printLateness function writes in buf the number of dispatched events, the mean and maximum lateness (sec) and the histogram bins. */
+
+	int printLateness(char* buf, int len)
+	{
+		int n = snprintf(buf, len, "%ld %f %f", dispatched_, (dispatched_ > 0) ? sumLateness_ / dispatched_ : 0.0, maxLateness_);
+
+		for ( int i = 0; i < SUNSET_RT_LATENESS_BINS && n < len; i++ ) {
+
+			n += snprintf(buf + n, len - n, " %ld", lateness_[i]);
+		}
+
+		return n;
+	}
+
+	void setSpinWindow(double s) { spin_ = (s > 0.0) ? s : 0.0; }
+	void setStepThreshold(double s) { stepThreshold_ = s; }
+
+	long getDispatched() { return dispatched_; }
+	double getMeanLateness() { return (dispatched_ > 0) ? sumLateness_ / dispatched_ : 0.0; }
+	double getMaxLateness() { return maxLateness_; }
+	long getLateness(int bin) { return lateness_[bin]; }
+	long getWallSteps() { return wallSteps_; }
+
+private:
+
+	static void addTime(struct timespec* ts, double s)
+	{
+		time_t sec = (time_t)s;
+		long nsec = ts->tv_nsec + (long)((s - sec) * 1e9);
+
+		ts->tv_sec += sec + nsec / 1000000000L;
+		ts->tv_nsec = nsec % 1000000000L;
+	}
+
+	struct timespec origin_;	// monotonic time of the last reset
+	double t0_;			// time set by the last reset
+	long wallSteps_;		// number of wall-clock steps detected
+
+	double spin_;			// spin window before a deadline (sec)
+	double stepThreshold_;		// minimum difference reported as a wall-clock step (sec)
+	clockid_t condClock_;		// clock of the condition variable used by waitUntil
+
+	long lateness_[SUNSET_RT_LATENESS_BINS];
+	long dispatched_;
+	double sumLateness_;
+	double maxLateness_;
+};
+
+#endif
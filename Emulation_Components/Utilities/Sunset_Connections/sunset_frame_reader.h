@@ -0,0 +1,332 @@
+/* SUNSET - Sapienza University Networking framework for underwater Simulation, Emulation and real-life Testing
+ *
+ * Copyright (C) 2012 Regents of UWSN Group of SENSES Lab <http://reti.dsi.uniroma1.it/SENSES_lab/>
+ *
+ * Author: Roberto Petroccia - petroccia@di.uniroma1.it
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License as published
+ * at http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANATBILITY or FITNESS FOR A PARTICULAR PURPOSE. See the Creative Commons
+ * Attribution-NonCommercial-ShareAlike 3.0 Unported License for more details.
+ *
+ * You should have received a copy of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License
+ * along with this program. If not, see <http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode>.
+ */
+
+#ifndef __Sunset_Frame_Reader_h__
+#define __Sunset_Frame_Reader_h__
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <poll.h>
+
+#include <sunset_debug.h>
+
+#define SUNSET_FRAME_READER_SIZE	32768	/*!< @brief Default size (bytes) of the reader buffer. */
+
+/*! @brief This class implements the buffered reader used by the connections exchanging framed messages with the 
+ *  external devices (e.g. NMEA sentences or AT lines). All the bytes available on the file descriptor are read with a 
+ *  single read call and the complete frames are extracted in place: the returned frames point inside the reader 
+ *  buffer and they are valid until the next call to fill().
+ */
+
+class Sunset_Frame_Reader {
+	
+public:
+	
+	Sunset_Frame_Reader(int size = SUNSET_FRAME_READER_SIZE)
+	{
+		size_ = size;
+		start_ = end_ = scan_ = 0;
+		
+		buf_ = (char*) malloc (size_ + 1);
+		
+		if ( buf_ == NULL ) {
+			
+			SUNSET_DEBUG_LOG(-1, -1, "Sunset_Frame_Reader MALLOC ERROR");
+			
+			exit(1);
+		}
+	}
+	
+	~Sunset_Frame_Reader() 
+	{
+		free(buf_);
+	}
+	
+	/*! @brief The fill function waits up to "timeout" ms for data on "fd" and reads all the available bytes. The frames 
+	 *  previously returned are no longer valid after this call.
+	 *  @retval The number of bytes read, 0 if the timeout expired, -1 on error or if the connection has been closed.
+	 */
+	
+	int fill(int fd, int timeout) 
+	{
+		struct pollfd pfd;
+		int ret = 0;
+		
+		compact();
+		
+		if ( end_ >= size_ ) {
+			
+			// a frame longer than the buffer: drop it
+			
+			SUNSET_DEBUG_LOG(-1, -1, "Sunset_Frame_Reader::fill buffer full (%d bytes) without a complete frame ERROR", size_);
+			
+			reset();
+		}
+		
+		pfd.fd = fd;
+		pfd.events = POLLIN;
+		pfd.revents = 0;
+		
+		ret = poll(&pfd, 1, timeout);
+		
+		if ( ret < 0 ) {
+			
+			return (errno == EINTR) ? 0 : -1;
+		}
+		
+		if ( ret == 0 || !(pfd.revents & POLLIN) ) {
+			
+			return (pfd.revents & (POLLERR | POLLHUP | POLLNVAL)) ? -1 : 0;
+		}
+		
+		ret = read(fd, buf_ + end_, size_ - end_);
+		
+		if ( ret < 0 ) {
+			
+			return (errno == EINTR || errno == EAGAIN) ? 0 : -1;
+		}
+		
+		if ( ret == 0 ) {
+			
+			return -1;
+		}
+		
+		end_ += ret;
+		
+		return ret;
+	}
+	
+	/*! @brief The nextSentence function extracts the next sentence starting with "startChar" and terminated by two 
+	 *  end of line characters ('\r' or '\n'). The terminator is rewritten as "\r\n". The bytes preceding the start 
+	 *  character are discarded, a sentence interrupted by a new start character is dropped.
+	 *  @param startChar The character starting a sentence.
+	 *  @param maxLen The maximum length of a sentence, longer sentences are dropped.
+	 *  @param[out] sentence The pointer to the sentence, in the reader buffer.
+	 *  @retval The length of the sentence (terminator included), 0 if no complete sentence is available.
+	 */
+	
+	int nextSentence(char startChar, int maxLen, char** sentence) 
+	{
+		int len = 0;
+		char c = 0;
+		
+		while ( true ) {
+			
+			// look for the start of the sentence
+			
+			while ( start_ < end_ && buf_[start_] != startChar ) {
+				
+				start_++;
+			}
+			
+			if ( start_ >= end_ ) {
+				
+				scan_ = start_;
+				
+				return 0;
+			}
+			
+			if ( scan_ <= start_ ) {
+				
+				scan_ = start_ + 1;
+			}
+			
+			while ( scan_ < end_ ) {
+				
+				c = buf_[scan_];
+				
+				if ( c == startChar ) {
+					
+					SUNSET_DEBUG_LOG(-1, -1, "Sunset_Frame_Reader::nextSentence new start before the end of the sentence ERROR %.*s", scan_ - start_, buf_ + start_);
+					
+					start_ = scan_;
+					scan_ = start_ + 1;
+					
+					continue;
+				}
+				
+				if ( scan_ + 2 - start_ > maxLen ) {
+					
+					break;
+				}
+				
+				if ( c == '\r' || c == '\n' ) {
+					
+					if ( scan_ + 1 >= end_ ) {
+						
+						return 0;	// wait for the next character
+					}
+					
+					if ( buf_[scan_ + 1] == '\r' || buf_[scan_ + 1] == '\n' ) {
+						
+						break;
+					}
+				}
+				
+				scan_++;
+			}
+			
+			if ( scan_ >= end_ ) {
+				
+				return 0;
+			}
+			
+			if ( scan_ + 2 - start_ > maxLen ) {
+				
+				// the rest of the sentence is discarded while looking for the next start character
+				
+				SUNSET_DEBUG_LOG(-1, -1, "Sunset_Frame_Reader::nextSentence sentence longer than %d bytes ERROR", maxLen);
+				
+				start_ = scan_;
+				
+				continue;
+			}
+			
+			len = scan_ + 2 - start_;
+			
+			buf_[scan_] = '\r';
+			buf_[scan_ + 1] = '\n';
+			
+			*sentence = buf_ + start_;
+			
+			start_ = scan_ + 2;
+			scan_ = start_;
+			
+			return len;
+		}
+	}
+	
+	/*! @brief The nextLine function extracts the next line terminated by "\r\n".
+	 *  @param maxLen The maximum length of a line, longer lines are dropped.
+	 *  @param[out] line The pointer to the line, in the reader buffer.
+	 *  @retval The length of the line (terminator included), 0 if no complete line is available.
+	 */
+	
+	int nextLine(int maxLen, char** line) 
+	{
+		int len = 0;
+		
+		while ( true ) {
+			
+			if ( scan_ < start_ ) {
+				
+				scan_ = start_;
+			}
+			
+			while ( scan_ + 1 < end_ && !(buf_[scan_] == '\r' && buf_[scan_ + 1] == '\n') ) {
+				
+				scan_++;
+			}
+			
+			if ( scan_ + 1 >= end_ ) {
+				
+				return 0;
+			}
+			
+			len = scan_ + 2 - start_;
+			
+			*line = buf_ + start_;
+			
+			start_ = scan_ + 2;
+			scan_ = start_;
+			
+			if ( len > maxLen ) {
+				
+				SUNSET_DEBUG_LOG(-1, -1, "Sunset_Frame_Reader::nextLine line too long (%d > %d) ERROR", len, maxLen);
+				
+				continue;
+			}
+			
+			return len;
+		}
+	}
+	
+	/*! @brief The take function extracts the next "n" bytes, it is used for binary fields whose length is given by the 
+	 *  previous information.
+	 *  @param[out] bytes The pointer to the bytes, in the reader buffer.
+	 *  @retval n if the bytes are available, 0 otherwise.
+	 */
+	
+	int take(int n, char** bytes) 
+	{
+		if ( n <= 0 || end_ - start_ < n ) {
+			
+			return 0;
+		}
+		
+		*bytes = buf_ + start_;
+		
+		start_ += n;
+		scan_ = start_;
+		
+		return n;
+	}
+	
+	/*! @brief The peek function returns the buffered bytes which have not been extracted yet. */
+	
+	int peek(char** bytes) 
+	{
+		*bytes = buf_ + start_;
+		
+		return end_ - start_;
+	}
+	
+	/*! @brief The available function returns the number of bytes which have not been extracted yet. */
+	int available() { return end_ - start_; }
+	
+	/*! @brief The reset function drops all the buffered bytes. */
+	void reset() { start_ = end_ = scan_ = 0; }
+	
+private:
+	
+	/*! @brief The compact function moves the bytes not extracted yet at the beginning of the buffer. */
+	
+	void compact() 
+	{
+		if ( start_ == 0 ) {
+			
+			return;
+		}
+		
+		if ( start_ < end_ ) {
+			
+			memmove(buf_, buf_ + start_, end_ - start_);
+		}
+		
+		end_ -= start_;
+		scan_ -= start_;
+		start_ = 0;
+		
+		if ( scan_ < 0 ) {
+			
+			scan_ = 0;
+		}
+	}
+	
+	char* buf_;
+	int size_;
+	
+	int start_;	// first byte not extracted
+	int end_;	// first free byte
+	int scan_;	// first byte not yet scanned for the end of the current frame
+};
+
+#endif
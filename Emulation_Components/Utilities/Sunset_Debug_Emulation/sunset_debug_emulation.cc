@@ -124,9 +124,8 @@ void Sunset_Debug_Emulation::debug_info(int debug_emulationLevel, int addr, char
 	double aux_time = 0.0;
 	char command[SUNSET_DEBUG_MAX_SIZE];
 	
-	memset(command, '\0', SUNSET_DEBUG_MAX_SIZE);
-	
-	/* When printing the requested information we also update the scheduler clock thus printing correct timing information when running in emulation mode. */
+	/* When printing the requested information we also update the scheduler clock thus printing correct timing information when running in emulation mode. 
+	 * The level has already been checked by debugInfo. */
 	
 	Scheduler& s = Scheduler::instance();
 	
@@ -139,11 +138,6 @@ void Sunset_Debug_Emulation::debug_info(int debug_emulationLevel, int addr, char
 		pthread_mutex_unlock(&mutex_debug_event);
 	}
 	
-	if (debug_emulationLevel > level) {
-		
-		return;
-	}
-	
 	time = Sunset_Debug_Emulation::getClock();
 	aux_time = max(NOW, time - start_time);
 	
@@ -152,14 +146,9 @@ void Sunset_Debug_Emulation::debug_info(int debug_emulationLevel, int addr, char
 		aux_time = NOW;
 	}
 	
-	sprintf(command, "%d _DEBUG_ (%6.6f) (%f) Node:%d - %s", debug_emulationLevel, aux_time, time, addr, str);
-	
-	pthread_mutex_lock(&mutex_debug_event);
+	snprintf(command, SUNSET_DEBUG_MAX_SIZE, "%d _DEBUG_ (%6.6f) (%f) Node:%d - %s", debug_emulationLevel, aux_time, time, addr, str);
 	
-	cout << command << endl;
-	fflush(stdout);
-	
-	pthread_mutex_unlock(&mutex_debug_event);
+	output(command, debug_emulationLevel < 0);
 	
 	return;
 }
@@ -172,13 +161,7 @@ void Sunset_Debug_Emulation::debug_info(int debug_emulationLevel, int addr, char
 void Sunset_Debug_Emulation::show_info(char * str)
 {
 	
-	pthread_mutex_lock(&mutex_debug_event);
-	
-	cout << str << endl;
-	
-	fflush(stdout);
-	
-	pthread_mutex_unlock(&mutex_debug_event);
+	output(str, false);
 	
 	return;
 }
@@ -0,0 +1,220 @@
+/* SUNSET - Sapienza University Networking framework for underwater Simulation, Emulation and real-life Testing
+ *
+ * Copyright (C) 2012 Regents of UWSN Group of SENSES Lab <http://reti.dsi.uniroma1.it/SENSES_lab/>
+ *
+ * Author: Roberto Petroccia - petroccia@di.uniroma1.it
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License as published
+ * at http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANATBILITY or FITNESS FOR A PARTICULAR PURPOSE. See the Creative Commons
+ * Attribution-NonCommercial-ShareAlike 3.0 Unported License for more details.
+ *
+ * You should have received a copy of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License
+ * along with this program. If not, see <http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode>.
+ */
+
+#ifndef __Sunset_Rx_Channel_h__
+#define __Sunset_Rx_Channel_h__
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <scheduler.h>
+#include <sunset_utilities.h>
+#include <sunset_debug.h>
+
+#define SUNSET_RX_CHANNEL_SLOTS		64	/*!< @brief Default number of slots, it has to be a power of two. */
+
+/*! @brief A slot of the reception channel. The data buffer is allocated once when the channel is created. */
+
+typedef struct sunset_rx_slot {
+
+	char* data;
+	int len;
+	double time;
+	int tag;	// message type set by the producer, 0 if not used
+
+} sunset_rx_slot;
+
+/*! @brief This class implements a bounded single-producer/single-consumer channel used by the modem listener threads
+ *  to hand over the received information to the main thread. The slots are preallocated and the producer never blocks.
+ *  The main thread is woken up posting a single event to the scheduler when the channel moves from empty to non-empty,
+ *  the consumer then drains all the available slots.
+ */
+
+class Sunset_Rx_Channel {
+
+public:
+
+	Sunset_Rx_Channel(int slotSize, int numSlots = SUNSET_RX_CHANNEL_SLOTS)
+	{
+		int n = 1;
+
+		while ( n < numSlots ) {
+
+			n = n << 1;
+		}
+
+		size_ = n;
+		mask_ = n - 1;
+		slotSize_ = slotSize;
+		head_ = tail_ = 0;
+		wakePending_ = 0;
+		overruns_ = 0;
+		handler_ = 0;
+
+		buffer_ = (char*) malloc (size_ * (slotSize_ + 1));
+		slots_ = (sunset_rx_slot*) malloc (size_ * sizeof(sunset_rx_slot));
+
+		if ( buffer_ == NULL || slots_ == NULL ) {
+
+			SUNSET_DEBUG_LOG(-1, -1, "Sunset_Rx_Channel MALLOC ERROR");
+
+			exit(1);
+		}
+
+		for ( int i = 0; i < size_; i++ ) {
+
+			slots_[i].data = buffer_ + i * (slotSize_ + 1);
+			slots_[i].len = 0;
+			slots_[i].time = 0.0;
+			slots_[i].tag = 0;
+		}
+	}
+
+	~Sunset_Rx_Channel()
+	{
+		free(slots_);
+		free(buffer_);
+	}
+
+	/*! @brief The setHandler function sets the handler invoked, in the main thread, when new information is available. */
+	void setHandler(Handler* h) { handler_ = h; }
+
+	/*! @brief The push function is called by the listener thread to store "len" bytes of "buf".
+	 *  The tag allows the listener thread to hand over the message type it has already parsed.
+	 *  @retval false If the channel is full and the information has been dropped.
+	 */
+
+	bool push(const char* buf, int len, double time = 0.0, int tag = 0)
+	{
+		unsigned int head = head_;
+		sunset_rx_slot* s = 0;
+
+		if ( head - tail_ >= (unsigned int)size_ ) {
+
+			overruns_++;
+
+			SUNSET_DEBUG_LOG(-1, -1, "Sunset_Rx_Channel::push channel full - dropping %d bytes overruns %d", len, overruns_);
+
+			wakeup();
+
+			return false;
+		}
+
+		if ( len > slotSize_ ) {
+
+			len = slotSize_;
+		}
+
+		s = &(slots_[head & mask_]);
+
+		memcpy(s->data, buf, len);
+		s->data[len] = '\0';
+		s->len = len;
+		s->time = time;
+		s->tag = tag;
+
+		__sync_synchronize();	// slot content has to be visible before publishing it
+
+		head_ = head + 1;
+
+		wakeup();
+
+		return true;
+	}
+
+	/*! @brief The front function returns the oldest slot, 0 if the channel is empty. The slot is valid until pop is called. */
+
+	sunset_rx_slot* front()
+	{
+		if ( empty() ) {
+
+			return 0;
+		}
+
+		__sync_synchronize();
+
+		return &(slots_[tail_ & mask_]);
+	}
+
+	/*! @brief The pop function releases the oldest slot to the listener thread. */
+
+	void pop()
+	{
+		if ( empty() ) {
+
+			return;
+		}
+
+		__sync_synchronize();	// slot content has been consumed before releasing it
+
+		tail_ = tail_ + 1;
+	}
+
+	/*! @brief The empty function returns true if no information is waiting in the channel. */
+	bool empty() { return head_ == tail_; }
+
+	/*! @brief The wakeupDone function has to be called by the handler before draining the channel,
+	 *  information pushed afterwards will post a new event.
+	 */
+
+	void wakeupDone()
+	{
+		wakePending_ = 0;
+
+		__sync_synchronize();
+	}
+
+	/*! @brief The getOverruns function returns the number of messages dropped because the channel was full. */
+	int getOverruns() { return overruns_; }
+
+private:
+
+	/*! @brief The wakeup function posts a single event to the scheduler if no notification is pending. */
+
+	void wakeup()
+	{
+		if ( handler_ == 0 ) {
+
+			return;
+		}
+
+		if ( __sync_bool_compare_and_swap(&wakePending_, 0, 1) ) {
+
+			Sunset_Utilities::schedule(handler_, &wakeEvent_, 0.0);
+		}
+	}
+
+	sunset_rx_slot* slots_;
+	char* buffer_;
+
+	int size_;
+	unsigned int mask_;
+	int slotSize_;
+
+	volatile unsigned int head_;	// written only by the producer
+	volatile unsigned int tail_;	// written only by the consumer
+	volatile int wakePending_;	// 1 if an event has been posted and not yet handled
+
+	int overruns_;
+
+	Handler* handler_;
+	Event wakeEvent_;
+};
+
+#endif
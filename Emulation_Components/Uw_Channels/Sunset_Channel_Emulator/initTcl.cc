@@ -0,0 +1,10 @@
+static char code[] = "\n\
+Module/Sunset_Channel_Emulator_Server set defPropDelay 		1\n\
+Module/Sunset_Channel_Emulator_Server set socketPort 		8000\n\
+Module/Sunset_Channel_Emulator_Server set socketPortPos	8001\n\
+Module/Sunset_Channel_Emulator_Server set bitRate 		0\n\
+Module/Sunset_Channel_Emulator_Server set numWorkers 		0\n\
+Module/Sunset_Channel_Emulator_Server set cartesian 		0\n\
+";
+#include "tclcl.h"
+EmbeddedTcl Sunset_Channel_Emulator_Server_TclCode(code);
@@ -0,0 +1,8 @@
+#include <tclcl.h>
+
+extern EmbeddedTcl Sunset_Channel_Emulator_Server_TclCode;
+
+extern "C" int Sunset_emulation_channel_emulator_server_Init() {
+    Sunset_Channel_Emulator_Server_TclCode.load();
+    return 0;
+}
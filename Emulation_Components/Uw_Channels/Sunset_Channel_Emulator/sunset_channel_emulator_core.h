@@ -0,0 +1,1353 @@
+/* SUNSET - Sapienza University Networking framework for underwater Simulation, Emulation and real-life Testing
+ *
+ * Copyright (C) 2012 Regents of UWSN Group of SENSES Lab <http://reti.dsi.uniroma1.it/SENSES_lab/>
+ *
+ * Author: Daniele Spaccini - spaccini@di.uniroma1.it
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License as published
+ * at http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANATBILITY or FITNESS FOR A PARTICULAR PURPOSE. See the Creative Commons
+ * Attribution-NonCommercial-ShareAlike 3.0 Unported License for more details.
+ *
+ * You should have received a copy of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License
+ * along with this program. If not, see <http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode>.
+ */
+
+#ifndef __Sunset_Channel_Emulator_Core_h__
+#define __Sunset_Channel_Emulator_Core_h__
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/time.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <vector>
+
+#include <sunset_debug.h>
+#include <sunset_information_dispatcher.h>
+#include <sunset_channel_emulator_workers.h>
+
+using namespace std;
+
+#define SUNSET_EMU_WHEEL_SIZE		4096	/*!< @brief Number of buckets of the timer wheel, it has to be a power of two. */
+#define SUNSET_EMU_WHEEL_RESOLUTION	0.001	/*!< @brief Duration (sec) of a timer wheel bucket. */
+#define SUNSET_EMU_MAX_EVENTS		256	/*!< @brief Maximum number of events returned by a single epoll_wait call. */
+#define SUNSET_EMU_BUF_SIZE		32768	/*!< @brief Initial size (bytes) of the connection buffers. */
+#define SUNSET_EMU_SOUND_SPEED		1500.0	/*!< @brief Sound speed (m/s) used to compute the propagation delays. */
+#define SUNSET_EMU_EARTH_RADIUS		6371000.0	/*!< @brief Earth radius (m) used to compute the distance between geographic positions. */
+#define SUNSET_EMU_MIN_NODES		16	/*!< @brief Initial number of nodes of the delay matrix, it is doubled when needed. */
+#define SUNSET_EMU_MSG_START		'*'	/*!< @brief The messages of the emulator modems start with two of these characters. */
+#define SUNSET_EMU_MSG_END		'#'	/*!< @brief The messages of the emulator modems end with two of these characters. */
+#define SUNSET_EMU_MSG_HDR_SIZE		(2 + 2 * (int)sizeof(int))	/*!< @brief Start marker, source and destination of a modem message. */
+#define SUNSET_EMU_MSG_MAX_SIZE		0x7fff	/*!< @brief Maximum length of a modem message, longer data without end marker are discarded. */
+#define SUNSET_EMU_POS_MSG_SIZE		((int)sizeof(int) + 3 * (int)sizeof(double))	/*!< @brief Node ID, latitude, longitude and depth of a position message. */
+
+/*! @brief A packet transmitted on the emulated channel. It is stored once and shared by all the scheduled deliveries. */
+
+typedef struct sunset_emu_payload {
+	
+	int refs;	// deliveries still referring to the payload
+	int src;	// transmitting node
+	double time;	// transmission time
+	int len;
+	char data[1];
+	
+} sunset_emu_payload;
+
+/*! @brief A payload delivery scheduled on the timer wheel. */
+
+typedef struct sunset_emu_delivery {
+	
+	long tick;	// delivery time in wheel ticks
+	int dst;	// receiving node
+	sunset_emu_payload* payload;
+	struct sunset_emu_delivery* next;
+	
+} sunset_emu_delivery;
+
+/*! @brief An emulator connection, the buffers grow when needed and are never shrunk. */
+
+typedef struct sunset_emu_conn {
+	
+	int fd;
+	int node;		// node ID, -1 until the node has been identified
+	bool position;		// true for the connections on the position port
+	
+	char* in;		// received data not yet processed
+	int inLen;
+	int inSize;
+	
+	char* out;		// data not yet accepted by the socket
+	int outLen;
+	int outSize;
+	
+} sunset_emu_conn;
+
+/*! @brief This class implements a timer wheel keyed by delivery time. Deliveries are hashed in the bucket of their 
+ *  tick, deliveries further than a wheel revolution stay in their bucket until their tick is reached. Deliveries 
+ *  are allocated from a free list and never released to the system while the wheel exists.
+ */
+
+class Sunset_Channel_Emulator_Wheel {
+	
+public:
+	
+	Sunset_Channel_Emulator_Wheel()
+	{
+		memset(buckets_, 0x0, sizeof(buckets_));
+		free_ = 0;
+		count_ = 0;
+		current_ = -1;
+	}
+	
+	~Sunset_Channel_Emulator_Wheel()
+	{
+		sunset_emu_delivery* d = 0;
+		
+		for ( int i = 0; i < SUNSET_EMU_WHEEL_SIZE; i++ ) {
+			
+			while ( buckets_[i] != 0 ) {
+				
+				d = buckets_[i];
+				buckets_[i] = d->next;
+				free(d);
+			}
+		}
+		
+		while ( free_ != 0 ) {
+			
+			d = free_;
+			free_ = d->next;
+			free(d);
+		}
+	}
+	
+	static long toTick(double time) { return (long)(time / SUNSET_EMU_WHEEL_RESOLUTION); }
+	
+	static double toTime(long tick) { return tick * SUNSET_EMU_WHEEL_RESOLUTION; }
+	
+	/*! @brief The alloc function returns a delivery from the free list. */
+	
+	sunset_emu_delivery* alloc()
+	{
+		sunset_emu_delivery* d = free_;
+		
+		if ( d != 0 ) {
+			
+			free_ = d->next;
+			
+			return d;
+		}
+		
+		d = (sunset_emu_delivery*) malloc (sizeof(sunset_emu_delivery));
+		
+		if ( d == NULL ) {
+			
+			SUNSET_DEBUG_LOG(-1, -1, "Sunset_Channel_Emulator_Wheel::alloc MALLOC ERROR");
+			
+			exit(1);
+		}
+		
+		return d;
+	}
+	
+	/*! @brief The release function returns a delivery to the free list. */
+	
+	void release(sunset_emu_delivery* d)
+	{
+		d->next = free_;
+		free_ = d;
+	}
+	
+	/*! @brief The insert function schedules a delivery, deliveries in the past are handled at the next expire() call. */
+	
+	void insert(sunset_emu_delivery* d)
+	{
+		if ( current_ != -1 && d->tick < current_ ) {
+			
+			d->tick = current_;
+		}
+		
+		d->next = buckets_[d->tick & (SUNSET_EMU_WHEEL_SIZE - 1)];
+		buckets_[d->tick & (SUNSET_EMU_WHEEL_SIZE - 1)] = d;
+		count_++;
+	}
+	
+	/*! @brief The expire function moves to the expired list all the deliveries with tick lower or equal than now. 
+	 *  @retval The expired list, in no specific order.
+	 */
+	
+	sunset_emu_delivery* expire(long now)
+	{
+		sunset_emu_delivery* expired = 0;
+		long last = now;
+		
+		if ( count_ == 0 ) {
+			
+			current_ = now;
+			
+			return 0;
+		}
+		
+		if ( current_ == -1 || now - current_ >= SUNSET_EMU_WHEEL_SIZE ) {
+			
+			current_ = now - SUNSET_EMU_WHEEL_SIZE + 1;	// all the buckets have to be checked
+		}
+		
+		for ( long t = current_; t <= last; t++ ) {
+			
+			sunset_emu_delivery** p = &(buckets_[t & (SUNSET_EMU_WHEEL_SIZE - 1)]);
+			
+			while ( *p != 0 ) {
+				
+				if ( (*p)->tick <= now ) {
+					
+					sunset_emu_delivery* d = *p;
+					
+					*p = d->next;
+					d->next = expired;
+					expired = d;
+					count_--;
+				}
+				else {
+					
+					p = &((*p)->next);
+				}
+			}
+		}
+		
+		current_ = now + 1;
+		
+		return expired;
+	}
+	
+	/*! @brief The next function returns the tick of the earliest scheduled delivery, -1 if the wheel is empty. */
+	
+	long next()
+	{
+		long best = -1;
+		
+		if ( count_ == 0 ) {
+			
+			return -1;
+		}
+		
+		for ( long t = current_; t < current_ + SUNSET_EMU_WHEEL_SIZE; t++ ) {
+			
+			for ( sunset_emu_delivery* d = buckets_[t & (SUNSET_EMU_WHEEL_SIZE - 1)]; d != 0; d = d->next ) {
+				
+				if ( d->tick <= t ) {
+					
+					return t;
+				}
+			}
+		}
+		
+		// only deliveries further than a wheel revolution are scheduled
+		
+		for ( int i = 0; i < SUNSET_EMU_WHEEL_SIZE; i++ ) {
+			
+			for ( sunset_emu_delivery* d = buckets_[i]; d != 0; d = d->next ) {
+				
+				if ( best == -1 || d->tick < best ) {
+					
+					best = d->tick;
+				}
+			}
+		}
+		
+		return best;
+	}
+	
+	/*! @brief The clear function removes all the scheduled deliveries. 
+	 *  @retval The removed list, the payloads are not owned by the wheel and have to be released by the caller.
+	 */
+	
+	sunset_emu_delivery* clear()
+	{
+		sunset_emu_delivery* removed = 0;
+		sunset_emu_delivery* d = 0;
+		
+		for ( int i = 0; i < SUNSET_EMU_WHEEL_SIZE; i++ ) {
+			
+			while ( buckets_[i] != 0 ) {
+				
+				d = buckets_[i];
+				buckets_[i] = d->next;
+				d->next = removed;
+				removed = d;
+			}
+		}
+		
+		count_ = 0;
+		current_ = -1;
+		
+		return removed;
+	}
+	
+	int size() { return count_; }
+	
+private:
+	
+	sunset_emu_delivery* buckets_[SUNSET_EMU_WHEEL_SIZE];
+	sunset_emu_delivery* free_;
+	int count_;
+	long current_;	// first tick not yet expired, -1 before the first expire() call
+};
+
+/*! @brief This class implements the core of the channel emulator. All the sockets are handled by a single reactor thread 
+ *  using epoll; the packets received from a node are stored once and scheduled for delivery to all the other connected 
+ *  nodes on a timer wheel keyed by delivery time. The propagation delays are kept in an all-pairs matrix: the node 
+ *  positions are converted once to Cartesian (ECEF) coordinates, a position update recomputes only the row and the 
+ *  column of the node and a transmission reads the row of the transmitter. Full rebuilds are split on a worker pool.
+ *  Nodes and connections are kept in vectors indexed by node ID and socket, no map is accessed per packet.
+ *  The default protocol is the one of the emulator modem clients and of the legacy Sunset_Channel_Emulator: a node first 
+ *  sends its ID as a raw int, then each transmitted packet is sent as "**", the source and the destination as raw ints, 
+ *  the hex encoded payload and "##". The messages are forwarded to the receivers as they have been transmitted. On the 
+ *  position port each message contains the node ID as a raw int followed by the latitude, the longitude and the depth 
+ *  as raw doubles. Integers and doubles are in host byte order. Coalesced and split reads are handled by frame(); the 
+ *  frame(), receive() and deliver() functions can be redefined to change the protocol.
+ */
+
+class Sunset_Channel_Emulator_Core {
+	
+public:
+	
+	Sunset_Channel_Emulator_Core()
+	{
+		epollFd_ = -1;
+		wakeFd_[0] = wakeFd_[1] = -1;
+		running_ = false;
+		stopping_ = false;
+		defPropDelay_ = 1.0;
+		bitRate_ = 0.0;
+		cartesian_ = false;
+		numWorkers_ = 0;
+		numNodes_ = 0;
+		matrixDirty_ = false;
+		
+		pthread_mutex_init(&posMutex_, NULL);
+	}
+	
+	virtual ~Sunset_Channel_Emulator_Core()
+	{
+		stop();
+		
+		for ( int i = 0; i < (int)conns_.size(); i++ ) {
+			
+			if ( conns_[i] != 0 ) {
+				
+				closeConn(conns_[i]);
+			}
+		}
+		
+		for ( int i = 0; i < (int)listenFds_.size(); i++ ) {
+			
+			close(listenFds_[i]);
+		}
+		
+		if ( epollFd_ != -1 ) {
+			
+			close(epollFd_);
+			close(wakeFd_[0]);
+			close(wakeFd_[1]);
+		}
+		
+		pthread_mutex_destroy(&posMutex_);
+	}
+	
+	void setBitRate(double b) { bitRate_ = b; }		// when > 0 the transmission time is added to the delays
+	void setNumWorkers(int n) { numWorkers_ = n; }		// number of threads used to rebuild the delay matrix
+	
+	/*! @brief The setDefPropDelay function sets the delay used when the node positions are unknown. */
+	
+	void setDefPropDelay(double d)
+	{
+		pthread_mutex_lock(&posMutex_);
+		
+		defPropDelay_ = d;
+		matrixDirty_ = true;
+		
+		pthread_mutex_unlock(&posMutex_);
+	}
+	
+	/*! @brief The setCartesian function selects x, y (m) positions instead of latitude and longitude. */
+	
+	void setCartesian(bool c)
+	{
+		pthread_mutex_lock(&posMutex_);
+		
+		cartesian_ = c;
+		matrixDirty_ = true;
+		
+		pthread_mutex_unlock(&posMutex_);
+	}
+	
+	/*! @brief The listen function opens a listening socket on the given port. 
+	 *  @param position True if the port receives node positions.
+	 *  @retval false If the socket cannot be opened.
+	 */
+	
+	bool listen(int port, bool position)
+	{
+		struct sockaddr_in addr;
+		int fd = 0;
+		int on = 1;
+		
+		if ( !init() ) {
+			
+			return false;
+		}
+		
+		fd = socket(AF_INET, SOCK_STREAM, 0);
+		
+		if ( fd < 0 ) {
+			
+			SUNSET_DEBUG_LOG(-1, -1, "Sunset_Channel_Emulator_Core::listen port %d socket ERROR %s", port, strerror(errno));
+			
+			return false;
+		}
+		
+		setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+		
+		memset(&addr, 0x0, sizeof(addr));
+		addr.sin_family = AF_INET;
+		addr.sin_addr.s_addr = htonl(INADDR_ANY);
+		addr.sin_port = htons(port);
+		
+		if ( bind(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0 || ::listen(fd, SOMAXCONN) < 0 ) {
+			
+			SUNSET_DEBUG_LOG(-1, -1, "Sunset_Channel_Emulator_Core::listen port %d bind ERROR %s", port, strerror(errno));
+			
+			close(fd);
+			
+			return false;
+		}
+		
+		setNonBlocking(fd);
+		
+		listenFds_.push_back(fd);
+		listenPosition_.push_back(position);
+		
+		return addFd(fd, EPOLLIN);
+	}
+	
+	/*! @brief The start function starts the worker pool and the reactor thread. */
+	
+	bool start()
+	{
+		if ( running_ ) {
+			
+			return true;
+		}
+		
+		if ( !init() ) {
+			
+			return false;
+		}
+		
+		workers_.start(numWorkers_);
+		
+		stopping_ = false;
+		
+		if ( pthread_create(&thread_, NULL, Sunset_Channel_Emulator_Core::reactorThread, (void*)this) != 0 ) {
+			
+			SUNSET_DEBUG_LOG(-1, -1, "Sunset_Channel_Emulator_Core::start ERROR creating reactor thread");
+			
+			workers_.stop();
+			
+			return false;
+		}
+		
+		running_ = true;
+		
+		return true;
+	}
+	
+	/*! @brief The stop function stops the reactor thread and the worker pool, pending deliveries and their payloads are 
+	 *  released.
+	 */
+	
+	void stop()
+	{
+		char c = 0;
+		
+		if ( !running_ ) {
+			
+			return;
+		}
+		
+		stopping_ = true;
+		
+		if ( write(wakeFd_[1], &c, 1) < 0 ) {
+			
+			SUNSET_DEBUG_LOG(-1, -1, "Sunset_Channel_Emulator_Core::stop wake up ERROR %s", strerror(errno));
+		}
+		
+		pthread_join(thread_, NULL);
+		
+		workers_.stop();
+		
+		discardPending();
+		
+		running_ = false;
+	}
+	
+	/*! @brief The getPending function returns the number of scheduled deliveries, it can be called only when the core 
+	 *  is not running.
+	 */
+	
+	int getPending() { return running_ ? -1 : wheel_.size(); }
+	
+	/*! @brief The setPosition function updates the position of a node and its row and column of the delay matrix, it 
+	 *  can be called from any thread.
+	 */
+	
+	void setPosition(int node, node_position pos)
+	{
+		if ( node < 0 ) {
+			
+			return;
+		}
+		
+		pthread_mutex_lock(&posMutex_);
+		
+		resizeMatrix(node + 1);
+		
+		positions_[node] = pos;
+		hasPosition_[node] = 1;
+		
+		toCartesian(pos, &(px_[node]), &(py_[node]), &(pz_[node]));
+		
+		if ( !matrixDirty_ ) {
+			
+			updateNode(node);
+		}
+		
+		pthread_mutex_unlock(&posMutex_);
+	}
+	
+	/*! @brief The transmit function emulates the transmission of a packet from src to all the other connected nodes. 
+	 *  It has to be called from the reactor thread.
+	 */
+	
+	void transmit(int src, const char* data, int len, double now)
+	{
+		sunset_emu_payload* p = 0;
+		sunset_emu_delivery* d = 0;
+		int n = 0;
+		
+		receivers_.clear();
+		
+		for ( int i = 0; i < (int)nodeConns_.size(); i++ ) {
+			
+			if ( nodeConns_[i] != 0 && i != src ) {
+				
+				receivers_.push_back(i);
+			}
+		}
+		
+		n = (int)receivers_.size();
+		
+		if ( n == 0 ) {
+			
+			return;
+		}
+		
+		p = (sunset_emu_payload*) malloc (sizeof(sunset_emu_payload) + len);
+		
+		if ( p == NULL ) {
+			
+			SUNSET_DEBUG_LOG(-1, src, "Sunset_Channel_Emulator_Core::transmit MALLOC ERROR");
+			
+			exit(1);
+		}
+		
+		p->refs = n;
+		p->src = src;
+		p->time = now;
+		p->len = len;
+		memcpy(p->data, data, len);
+		
+		delays_.resize(n);
+		
+		pthread_mutex_lock(&posMutex_);
+		
+		if ( matrixDirty_ ) {
+			
+			rebuildMatrix();
+		}
+		
+		if ( src < numNodes_ ) {
+			
+			const float* row = &(delayMatrix_[(size_t)src * numNodes_]);
+			
+			for ( int i = 0; i < n; i++ ) {
+				
+				delays_[i] = (receivers_[i] < numNodes_) ? row[receivers_[i]] : defPropDelay_;
+			}
+		}
+		else {
+			
+			for ( int i = 0; i < n; i++ ) {
+				
+				delays_[i] = defPropDelay_;
+			}
+		}
+		
+		pthread_mutex_unlock(&posMutex_);
+		
+		for ( int i = 0; i < n; i++ ) {
+			
+			d = wheel_.alloc();
+			
+			d->tick = Sunset_Channel_Emulator_Wheel::toTick(now + delays_[i] + (bitRate_ > 0.0 ? len * 8.0 / bitRate_ : 0.0));
+			d->dst = receivers_[i];
+			d->payload = p;
+			
+			wheel_.insert(d);
+		}
+		
+		SUNSET_DEBUG_LOG(4, src, "Sunset_Channel_Emulator_Core::transmit len %d receivers %d scheduled %d", len, n, wheel_.size());
+	}
+	
+	/*! @brief The getLinkDelay function returns the propagation delay from src to dst stored in the delay matrix. */
+	
+	double getLinkDelay(int src, int dst)
+	{
+		double d = defPropDelay_;
+		
+		pthread_mutex_lock(&posMutex_);
+		
+		if ( matrixDirty_ ) {
+			
+			rebuildMatrix();
+		}
+		
+		if ( src >= 0 && dst >= 0 && src < numNodes_ && dst < numNodes_ ) {
+			
+			d = delayMatrix_[(size_t)src * numNodes_ + dst];
+		}
+		
+		pthread_mutex_unlock(&posMutex_);
+		
+		return d;
+	}
+	
+	/*! @brief The getDistance function returns the surface (haversine) distance between two positions combined with 
+	 *  their depth difference (m). The delay matrix uses the straight line distance between the ECEF coordinates, the 
+	 *  difference is of a few millimeters at the acoustic ranges.
+	 */
+	
+	double getDistance(node_position a, node_position b)
+	{
+		double dx = 0.0;
+		double dy = 0.0;
+		double dz = a.depth - b.depth;
+		double h = 0.0;
+		
+		if ( cartesian_ ) {
+			
+			dx = a.latitude - b.latitude;
+			dy = a.longitude - b.longitude;
+			
+			return sqrt(dx * dx + dy * dy + dz * dz);
+		}
+		
+		// haversine distance on the surface, combined with the depth difference
+		
+		dx = sin((b.latitude - a.latitude) * M_PI / 360.0);
+		dy = sin((b.longitude - a.longitude) * M_PI / 360.0);
+		h = dx * dx + cos(a.latitude * M_PI / 180.0) * cos(b.latitude * M_PI / 180.0) * dy * dy;
+		h = 2.0 * SUNSET_EMU_EARTH_RADIUS * asin(sqrt(h > 1.0 ? 1.0 : h));
+		
+		return sqrt(h * h + dz * dz);
+	}
+	
+	static double now()
+	{
+		struct timeval tv;
+		
+		gettimeofday(&tv, NULL);
+		
+		return tv.tv_sec + tv.tv_usec / 1e6;
+	}
+	
+protected:
+	
+	/*! @brief The frame function returns the length of the next complete message in data, 0 if more data is needed. 
+	 *  Node IDs and positions have a fixed length, the modem messages are delimited by their start and end markers. 
+	 *  Data not starting with the start marker are returned as a message up to the next marker and are discarded by 
+	 *  receive().
+	 */
+	
+	virtual int frame(sunset_emu_conn* c, const char* data, int len)
+	{
+		int i = 0;
+		
+		if ( c->position ) {
+			
+			return (len >= SUNSET_EMU_POS_MSG_SIZE) ? SUNSET_EMU_POS_MSG_SIZE : 0;
+		}
+		
+		if ( c->node == -1 ) {
+			
+			return (len >= (int)sizeof(int)) ? (int)sizeof(int) : 0;
+		}
+		
+		if ( data[0] != SUNSET_EMU_MSG_START || (len > 1 && data[1] != SUNSET_EMU_MSG_START) ) {
+			
+			for ( i = 1; i < len && data[i] != SUNSET_EMU_MSG_START; i++ );
+			
+			return i;
+		}
+		
+		// source and destination are raw ints and can contain the end marker, the search starts from the payload
+		
+		for ( i = SUNSET_EMU_MSG_HDR_SIZE; i + 1 < len; i++ ) {
+			
+			if ( data[i] == SUNSET_EMU_MSG_END && data[i + 1] == SUNSET_EMU_MSG_END ) {
+				
+				return i + 2;
+			}
+		}
+		
+		return (len > SUNSET_EMU_MSG_MAX_SIZE) ? len : 0;
+	}
+	
+	/*! @brief The receive function handles a message received on a connection. */
+	
+	virtual void receive(sunset_emu_conn* c, char* msg, int len, double now)
+	{
+		node_position pos;
+		int node = 0;
+		
+		if ( c->position ) {
+			
+			memcpy(&node, msg, sizeof(int));
+			memcpy(&(pos.latitude), msg + sizeof(int), sizeof(double));
+			memcpy(&(pos.longitude), msg + sizeof(int) + sizeof(double), sizeof(double));
+			memcpy(&(pos.depth), msg + sizeof(int) + 2 * sizeof(double), sizeof(double));
+			
+			setPosition(node, pos);
+			
+			return;
+		}
+		
+		if ( c->node == -1 ) {
+			
+			memcpy(&node, msg, sizeof(int));
+			
+			identify(c, node);
+			
+			return;
+		}
+		
+		if ( len < SUNSET_EMU_MSG_HDR_SIZE + 2 || msg[0] != SUNSET_EMU_MSG_START || msg[len - 1] != SUNSET_EMU_MSG_END ) {
+			
+			SUNSET_DEBUG_LOG(-1, c->node, "Sunset_Channel_Emulator_Core::receive node %d wrong message len %d discarded", c->node, len);
+			
+			return;
+		}
+		
+		transmit(c->node, msg, len, now);
+	}
+	
+	/*! @brief The deliver function sends a payload to the receiving connection as it has been transmitted. */
+	
+	virtual void deliver(sunset_emu_conn* c, sunset_emu_payload* p)
+	{
+		send(c, p->data, p->len);
+	}
+	
+	/*! @brief The identify function associates a connection to a node ID, an older connection of the node is closed. */
+	
+	void identify(sunset_emu_conn* c, int node)
+	{
+		if ( node < 0 ) {
+			
+			SUNSET_DEBUG_LOG(-1, -1, "Sunset_Channel_Emulator_Core::identify wrong node ID %d fd %d", node, c->fd);
+			
+			return;
+		}
+		
+		if ( node >= (int)nodeConns_.size() ) {
+			
+			nodeConns_.resize(node + 1, 0);
+		}
+		
+		if ( nodeConns_[node] != 0 && nodeConns_[node] != c ) {
+			
+			SUNSET_DEBUG_LOG(-1, node, "Sunset_Channel_Emulator_Core::identify node %d reconnected, closing fd %d", node, nodeConns_[node]->fd);
+			
+			closeConn(nodeConns_[node]);
+		}
+		
+		c->node = node;
+		nodeConns_[node] = c;
+		
+		SUNSET_DEBUG_LOG(1, node, "Sunset_Channel_Emulator_Core::identify node %d fd %d", node, c->fd);
+	}
+	
+	/*! @brief The send function writes data on a connection, data not accepted by the socket are buffered and sent 
+	 *  when the socket becomes writable.
+	 */
+	
+	void send(sunset_emu_conn* c, const char* data, int len)
+	{
+		int w = 0;
+		
+		if ( c->outLen == 0 ) {
+			
+			w = ::send(c->fd, data, len, MSG_NOSIGNAL);
+			
+			if ( w < 0 ) {
+				
+				if ( errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR ) {
+					
+					SUNSET_DEBUG_LOG(-1, c->node, "Sunset_Channel_Emulator_Core::send fd %d ERROR %s", c->fd, strerror(errno));
+					
+					return;
+				}
+				
+				w = 0;
+			}
+			
+			if ( w == len ) {
+				
+				return;
+			}
+			
+			modFd(c->fd, EPOLLIN | EPOLLOUT);
+		}
+		
+		append(&(c->out), &(c->outLen), &(c->outSize), data + w, len - w);
+	}
+	
+	vector<sunset_emu_conn*> conns_;	// connections indexed by socket
+	vector<sunset_emu_conn*> nodeConns_;	// connections indexed by node ID
+	
+private:
+	
+	bool init()
+	{
+		if ( epollFd_ != -1 ) {
+			
+			return true;
+		}
+		
+		epollFd_ = epoll_create(SUNSET_EMU_MAX_EVENTS);
+		
+		if ( epollFd_ < 0 || pipe(wakeFd_) < 0 ) {
+			
+			SUNSET_DEBUG_LOG(-1, -1, "Sunset_Channel_Emulator_Core::init ERROR %s", strerror(errno));
+			
+			epollFd_ = -1;
+			
+			return false;
+		}
+		
+		setNonBlocking(wakeFd_[0]);
+		
+		return addFd(wakeFd_[0], EPOLLIN);
+	}
+	
+	static void setNonBlocking(int fd)
+	{
+		fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+	}
+	
+	bool addFd(int fd, unsigned int events)
+	{
+		struct epoll_event ev;
+		
+		memset(&ev, 0x0, sizeof(ev));
+		ev.events = events;
+		ev.data.fd = fd;
+		
+		if ( epoll_ctl(epollFd_, EPOLL_CTL_ADD, fd, &ev) < 0 ) {
+			
+			SUNSET_DEBUG_LOG(-1, -1, "Sunset_Channel_Emulator_Core::addFd fd %d ERROR %s", fd, strerror(errno));
+			
+			return false;
+		}
+		
+		return true;
+	}
+	
+	void modFd(int fd, unsigned int events)
+	{
+		struct epoll_event ev;
+		
+		memset(&ev, 0x0, sizeof(ev));
+		ev.events = events;
+		ev.data.fd = fd;
+		
+		epoll_ctl(epollFd_, EPOLL_CTL_MOD, fd, &ev);
+	}
+	
+	static void append(char** buf, int* len, int* size, const char* data, int n)
+	{
+		if ( *len + n > *size ) {
+			
+			int newSize = (*size == 0) ? SUNSET_EMU_BUF_SIZE : *size;
+			
+			while ( newSize < *len + n ) {
+				
+				newSize = newSize << 1;
+			}
+			
+			*buf = (char*) realloc (*buf, newSize);
+			
+			if ( *buf == NULL ) {
+				
+				SUNSET_DEBUG_LOG(-1, -1, "Sunset_Channel_Emulator_Core::append MALLOC ERROR");
+				
+				exit(1);
+			}
+			
+			*size = newSize;
+		}
+		
+		memcpy(*buf + *len, data, n);
+		*len += n;
+	}
+	
+	/*! @brief The toCartesian function converts a position to the coordinates (m) used by the delay matrix: ECEF for 
+	 *  latitude, longitude and depth on a spherical Earth, x, y and depth otherwise.
+	 */
+	
+	void toCartesian(node_position pos, double* x, double* y, double* z)
+	{
+		double r = SUNSET_EMU_EARTH_RADIUS - pos.depth;
+		double lat = pos.latitude * M_PI / 180.0;
+		double lon = pos.longitude * M_PI / 180.0;
+		
+		if ( cartesian_ ) {
+			
+			*x = pos.latitude;
+			*y = pos.longitude;
+			*z = pos.depth;
+			
+			return;
+		}
+		
+		*x = r * cos(lat) * cos(lon);
+		*y = r * cos(lat) * sin(lon);
+		*z = r * sin(lat);
+	}
+	
+	/*! @brief The resizeMatrix function grows the delay matrix to at least n nodes, the new links get the default delay. 
+	 *  It has to be called holding posMutex_.
+	 */
+	
+	void resizeMatrix(int n)
+	{
+		vector<float> m;
+		int size = (numNodes_ == 0) ? SUNSET_EMU_MIN_NODES : numNodes_;
+		
+		if ( n <= numNodes_ ) {
+			
+			return;
+		}
+		
+		while ( size < n ) {
+			
+			size = size << 1;
+		}
+		
+		m.assign((size_t)size * size, (float)defPropDelay_);
+		
+		for ( int i = 0; i < numNodes_; i++ ) {
+			
+			memcpy(&(m[(size_t)i * size]), &(delayMatrix_[(size_t)i * numNodes_]), numNodes_ * sizeof(float));
+		}
+		
+		delayMatrix_.swap(m);
+		
+		positions_.resize(size);
+		hasPosition_.resize(size, 0);
+		px_.resize(size, 0.0);
+		py_.resize(size, 0.0);
+		pz_.resize(size, 0.0);
+		
+		numNodes_ = size;
+	}
+	
+	/*! @brief The computeRow function computes the delays from node to all the other nodes. The loop reads the 
+	 *  coordinate arrays sequentially and has no branch nor call, so that it can be vectorized by the compiler.
+	 */
+	
+	void computeRow(int node)
+	{
+		float* row = &(delayMatrix_[(size_t)node * numNodes_]);
+		const double* x = &(px_[0]);
+		const double* y = &(py_[0]);
+		const double* z = &(pz_[0]);
+		const unsigned char* known = &(hasPosition_[0]);
+		double nx = px_[node];
+		double ny = py_[node];
+		double nz = pz_[node];
+		double def = defPropDelay_;
+		double dx = 0.0;
+		double dy = 0.0;
+		double dz = 0.0;
+		double d = 0.0;
+		int n = numNodes_;
+		
+		if ( !hasPosition_[node] ) {
+			
+			for ( int j = 0; j < n; j++ ) {
+				
+				row[j] = (float)def;
+			}
+			
+			return;
+		}
+		
+		for ( int j = 0; j < n; j++ ) {
+			
+			dx = x[j] - nx;
+			dy = y[j] - ny;
+			dz = z[j] - nz;
+			d = sqrt(dx * dx + dy * dy + dz * dz) * (1.0 / SUNSET_EMU_SOUND_SPEED);
+			
+			row[j] = (float)(known[j] ? d : def);
+		}
+	}
+	
+	/*! @brief The updateNode function recomputes the row of a node and copies it to its column, the delays are symmetric. */
+	
+	void updateNode(int node)
+	{
+		const float* row = 0;
+		
+		computeRow(node);
+		
+		row = &(delayMatrix_[(size_t)node * numNodes_]);
+		
+		for ( int j = 0; j < numNodes_; j++ ) {
+			
+			delayMatrix_[(size_t)j * numNodes_ + node] = row[j];
+		}
+	}
+	
+	/*! @brief The rebuildMatrix function recomputes all the delays after a change of the default delay or of the 
+	 *  coordinate system, the rows are split on the worker pool. It has to be called holding posMutex_.
+	 */
+	
+	void rebuildMatrix()
+	{
+		for ( int i = 0; i < numNodes_; i++ ) {
+			
+			if ( hasPosition_[i] ) {
+				
+				toCartesian(positions_[i], &(px_[i]), &(py_[i]), &(pz_[i]));
+			}
+		}
+		
+		workers_.run(Sunset_Channel_Emulator_Core::rowJob, (void*)this, numNodes_);
+		
+		matrixDirty_ = false;
+	}
+	
+	static void rowJob(void* ctx, int begin, int end)
+	{
+		Sunset_Channel_Emulator_Core* core = (Sunset_Channel_Emulator_Core*)ctx;
+		
+		for ( int i = begin; i < end; i++ ) {
+			
+			core->computeRow(i);
+		}
+	}
+	
+	static void* reactorThread(void* arg)
+	{
+		((Sunset_Channel_Emulator_Core*)arg)->run();
+		
+		return NULL;
+	}
+	
+	/*! @brief The run function is the reactor loop: it waits for socket events until the next scheduled delivery. */
+	
+	void run()
+	{
+		struct epoll_event events[SUNSET_EMU_MAX_EVENTS];
+		int n = 0;
+		int timeout = -1;
+		long next = 0;
+		double t = 0.0;
+		
+		wheel_.expire(Sunset_Channel_Emulator_Wheel::toTick(now()));
+		
+		while ( !stopping_ ) {
+			
+			next = wheel_.next();
+			timeout = -1;
+			
+			if ( next != -1 ) {
+				
+				t = Sunset_Channel_Emulator_Wheel::toTime(next) - now();
+				timeout = (t <= 0.0) ? 0 : (int)ceil(t * 1000.0);
+			}
+			
+			n = epoll_wait(epollFd_, events, SUNSET_EMU_MAX_EVENTS, timeout);
+			
+			if ( n < 0 && errno != EINTR ) {
+				
+				SUNSET_DEBUG_LOG(-1, -1, "Sunset_Channel_Emulator_Core::run epoll ERROR %s", strerror(errno));
+				
+				break;
+			}
+			
+			for ( int i = 0; i < n; i++ ) {
+				
+				handleEvent(events[i].data.fd, events[i].events);
+			}
+			
+			deliverExpired();
+		}
+	}
+	
+	void handleEvent(int fd, unsigned int events)
+	{
+		sunset_emu_conn* c = 0;
+		char drain[64];
+		
+		if ( fd == wakeFd_[0] ) {
+			
+			while ( read(fd, drain, sizeof(drain)) > 0 );
+			
+			return;
+		}
+		
+		for ( int i = 0; i < (int)listenFds_.size(); i++ ) {
+			
+			if ( listenFds_[i] == fd ) {
+				
+				acceptConns(fd, listenPosition_[i]);
+				
+				return;
+			}
+		}
+		
+		if ( fd >= (int)conns_.size() || conns_[fd] == 0 ) {
+			
+			return;
+		}
+		
+		c = conns_[fd];
+		
+		if ( events & EPOLLOUT ) {
+			
+			flushConn(c);
+		}
+		
+		if ( events & (EPOLLIN | EPOLLHUP | EPOLLERR) ) {
+			
+			readConn(c);
+		}
+	}
+	
+	void acceptConns(int fd, bool position)
+	{
+		sunset_emu_conn* c = 0;
+		int cfd = 0;
+		int on = 1;
+		
+		while ( (cfd = accept(fd, NULL, NULL)) >= 0 ) {
+			
+			setNonBlocking(cfd);
+			setsockopt(cfd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+			
+			c = (sunset_emu_conn*) malloc (sizeof(sunset_emu_conn));
+			
+			if ( c == NULL ) {
+				
+				SUNSET_DEBUG_LOG(-1, -1, "Sunset_Channel_Emulator_Core::acceptConns MALLOC ERROR");
+				
+				exit(1);
+			}
+			
+			memset(c, 0x0, sizeof(sunset_emu_conn));
+			c->fd = cfd;
+			c->node = -1;
+			c->position = position;
+			
+			if ( cfd >= (int)conns_.size() ) {
+				
+				conns_.resize(cfd + 1, 0);
+			}
+			
+			conns_[cfd] = c;
+			
+			addFd(cfd, EPOLLIN);
+			
+			SUNSET_DEBUG_LOG(1, -1, "Sunset_Channel_Emulator_Core::acceptConns new %s connection fd %d", position ? "position" : "node", cfd);
+		}
+	}
+	
+	void readConn(sunset_emu_conn* c)
+	{
+		char buf[SUNSET_EMU_BUF_SIZE];
+		double t = now();
+		int r = 0;
+		int len = 0;
+		int off = 0;
+		int fd = c->fd;
+		
+		while ( (r = read(c->fd, buf, sizeof(buf))) > 0 ) {
+			
+			append(&(c->in), &(c->inLen), &(c->inSize), buf, r);
+			
+			off = 0;
+			
+			while ( c->inLen - off > 0 && (len = frame(c, c->in + off, c->inLen - off)) > 0 ) {
+				
+				receive(c, c->in + off, len, t);
+				
+				off += len;
+				
+				if ( conns_[fd] != c ) {
+					
+					return;		// the connection has been closed while handling the message
+				}
+			}
+			
+			if ( off > 0 ) {
+				
+				memmove(c->in, c->in + off, c->inLen - off);
+				c->inLen -= off;
+			}
+		}
+		
+		if ( r == 0 || (r < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) ) {
+			
+			SUNSET_DEBUG_LOG(1, c->node, "Sunset_Channel_Emulator_Core::readConn node %d fd %d closed", c->node, c->fd);
+			
+			closeConn(c);
+		}
+	}
+	
+	void flushConn(sunset_emu_conn* c)
+	{
+		int w = ::send(c->fd, c->out, c->outLen, MSG_NOSIGNAL);
+		
+		if ( w < 0 ) {
+			
+			return;
+		}
+		
+		memmove(c->out, c->out + w, c->outLen - w);
+		c->outLen -= w;
+		
+		if ( c->outLen == 0 ) {
+			
+			modFd(c->fd, EPOLLIN);
+		}
+	}
+	
+	void closeConn(sunset_emu_conn* c)
+	{
+		epoll_ctl(epollFd_, EPOLL_CTL_DEL, c->fd, NULL);
+		close(c->fd);
+		
+		if ( c->node >= 0 && c->node < (int)nodeConns_.size() && nodeConns_[c->node] == c ) {
+			
+			nodeConns_[c->node] = 0;
+		}
+		
+		conns_[c->fd] = 0;
+		
+		free(c->in);
+		free(c->out);
+		free(c);
+	}
+	
+	/*! @brief The discardPending function releases the deliveries still scheduled and the payloads they refer to. */
+	
+	void discardPending()
+	{
+		sunset_emu_delivery* d = wheel_.clear();
+		sunset_emu_delivery* next = 0;
+		
+		for ( ; d != 0; d = next ) {
+			
+			next = d->next;
+			
+			if ( --(d->payload->refs) == 0 ) {
+				
+				free(d->payload);
+			}
+			
+			wheel_.release(d);
+		}
+	}
+	
+	void deliverExpired()
+	{
+		sunset_emu_delivery* d = wheel_.expire(Sunset_Channel_Emulator_Wheel::toTick(now()));
+		sunset_emu_delivery* next = 0;
+		
+		for ( ; d != 0; d = next ) {
+			
+			next = d->next;
+			
+			if ( d->dst < (int)nodeConns_.size() && nodeConns_[d->dst] != 0 ) {
+				
+				deliver(nodeConns_[d->dst], d->payload);
+			}
+			
+			if ( --(d->payload->refs) == 0 ) {
+				
+				free(d->payload);
+			}
+			
+			wheel_.release(d);
+		}
+	}
+	
+	int epollFd_;
+	int wakeFd_[2];			// pipe used to wake up the reactor on stop
+	vector<int> listenFds_;
+	vector<bool> listenPosition_;
+	
+	pthread_t thread_;
+	volatile bool running_;
+	volatile bool stopping_;
+	
+	Sunset_Channel_Emulator_Wheel wheel_;
+	Sunset_Channel_Emulator_Workers workers_;
+	int numWorkers_;
+	
+	pthread_mutex_t posMutex_;		// positions and delay matrix can be updated from other threads
+	vector<node_position> positions_;	// indexed by node ID
+	vector<unsigned char> hasPosition_;
+	vector<double> px_;			// Cartesian coordinates (m) indexed by node ID
+	vector<double> py_;
+	vector<double> pz_;
+	vector<float> delayMatrix_;		// numNodes_ x numNodes_ propagation delays (sec), row major
+	int numNodes_;
+	bool matrixDirty_;			// true if the matrix has to be rebuilt before being read
+	
+	vector<int> receivers_;		// receivers of the packet being transmitted
+	vector<double> delays_;		// delays of receivers_
+	
+	double defPropDelay_;
+	double bitRate_;
+	bool cartesian_;
+};
+
+#endif
@@ -0,0 +1,7 @@
+# Dummy Initialization
+Module/Sunset_Channel_Emulator_Server set defPropDelay 		1
+Module/Sunset_Channel_Emulator_Server set socketPort 		8000
+Module/Sunset_Channel_Emulator_Server set socketPortPos	8001
+Module/Sunset_Channel_Emulator_Server set bitRate 		0
+Module/Sunset_Channel_Emulator_Server set numWorkers 		0
+Module/Sunset_Channel_Emulator_Server set cartesian 		0
@@ -0,0 +1,258 @@
+/* SUNSET - Sapienza University Networking framework for underwater Simulation, Emulation and real-life Testing
+ *
+ * Copyright (C) 2012 Regents of UWSN Group of SENSES Lab <http://reti.dsi.uniroma1.it/SENSES_lab/>
+ *
+ * Author: Daniele Spaccini - spaccini@di.uniroma1.it
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License as published
+ * at http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANATBILITY or FITNESS FOR A PARTICULAR PURPOSE. See the Creative Commons
+ * Attribution-NonCommercial-ShareAlike 3.0 Unported License for more details.
+ *
+ * You should have received a copy of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License
+ * along with this program. If not, see <http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode>.
+ */
+
+#include "sunset_channel_emulator_server.h"
+
+static class Sunset_Channel_Emulator_ServerClass : public TclClass {
+public:
+
+	Sunset_Channel_Emulator_ServerClass() : TclClass("Module/Sunset_Channel_Emulator_Server") {}
+
+	TclObject* create(int, const char*const*) {
+
+		return (new Sunset_Channel_Emulator_Server);
+	}
+
+} class_Sunset_Channel_Emulator_Server;
+
+Sunset_Channel_Emulator_Server::Sunset_Channel_Emulator_Server()
+{
+	socketPort = 8000;
+	socketPortPos = 8001;
+	posEmu = 0;
+	defPropDelay = 1.0;
+	bitRate = 0.0;
+	numWorkers = 0;
+	cartesian = 0;
+	running = false;
+
+	bind("defPropDelay", &defPropDelay);
+	bind("socketPort", &socketPort);
+	bind("socketPortPos", &socketPortPos);
+	bind("bitRate", &bitRate);
+	bind("numWorkers", &numWorkers);
+	bind("cartesian", &cartesian);
+}
+
+Sunset_Channel_Emulator_Server::~Sunset_Channel_Emulator_Server()
+{
+	stop();
+}
+
+/*!
+ * 	@brief The start() function opens the server ports and starts the core reactor thread. If the channel port cannot be
+ *	opened another node is already running the channel emulator and this node only connects to it as a client.
+ */
+
+void Sunset_Channel_Emulator_Server::start()
+{
+	Sunset_Module::start();
+
+	if ( running ) {
+
+		return;
+	}
+
+	core.setDefPropDelay(defPropDelay);
+	core.setBitRate(bitRate);
+	core.setNumWorkers(numWorkers);
+	core.setCartesian(cartesian == 1);
+
+	if ( !core.listen(socketPort, false) ) {
+
+		SUNSET_DEBUG_LOG(1, getModuleAddress(), "Sunset_Channel_Emulator_Server::start port %d not available, channel emulator already running", socketPort);
+
+		return;
+	}
+
+	if ( posEmu == 1 && !core.listen(socketPortPos, true) ) {
+
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Channel_Emulator_Server::start position port %d ERROR", socketPortPos);
+	}
+
+	if ( !core.start() ) {
+
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Channel_Emulator_Server::start ERROR");
+
+		exit(1);
+	}
+
+	running = true;
+
+	SUNSET_DEBUG_LOG(1, getModuleAddress(), "Sunset_Channel_Emulator_Server::start port %d position port %d workers %d", socketPort, socketPortPos, numWorkers);
+}
+
+/*!
+ * 	@brief The stop() function stops the core reactor thread and its worker pool.
+ */
+
+void Sunset_Channel_Emulator_Server::stop()
+{
+	if ( !running ) {
+
+		return;
+	}
+
+	Sunset_Module::stop();
+
+	core.stop();
+
+	running = false;
+}
+
+/*!
+ * 	@brief The command() function is a TCL hook for all the classes in ns-2 which allows C++ functions to be called from a TCL script
+ *	@param[in] argc argc is a count of the arguments supplied to the command function.
+ *	@param[in] argv argv is an array of pointers to the strings which are those arguments.
+ *	@retval TCL_OK the command has been correctly executed.
+ *	@retval TCL_ERROR the command has NOT been correctly executed.
+ */
+
+int Sunset_Channel_Emulator_Server::command(int argc, const char*const* argv)
+{
+	Tcl& tcl = Tcl::instance();
+	node_position pos;
+
+	if ( argc == 2 ) {
+
+		/* The "start" command opens the server ports and starts the reactor thread. */
+
+		if ( strcasecmp(argv[1], "start") == 0 ) {
+
+			start();
+
+			return TCL_OK;
+		}
+
+		/* The "stop" command stops the reactor thread. */
+
+		if ( strcasecmp(argv[1], "stop") == 0 ) {
+
+			stop();
+
+			return TCL_OK;
+		}
+	}
+	else if ( argc == 3 ) {
+
+		/* The "setModuleAddress" command sets the address of the channel emulator module. */
+
+		if ( strcasecmp(argv[1], "setModuleAddress") == 0 ) {
+
+			module_address = atoi(argv[2]);
+
+			return TCL_OK;
+		}
+
+		/* The "setChannelPort" command sets the port the nodes connect to. */
+
+		if ( strcasecmp(argv[1], "setChannelPort") == 0 ) {
+
+			socketPort = atoi(argv[2]);
+
+			return TCL_OK;
+		}
+
+		/* The "setPositionPort" command sets the port the node positions are received on. */
+
+		if ( strcasecmp(argv[1], "setPositionPort") == 0 ) {
+
+			socketPortPos = atoi(argv[2]);
+
+			return TCL_OK;
+		}
+
+		/* The "positionEmulation" command enables the reception of the node positions. */
+
+		if ( strcasecmp(argv[1], "positionEmulation") == 0 ) {
+
+			posEmu = atoi(argv[2]);
+
+			return TCL_OK;
+		}
+
+		/* The "setDefPropDelay" command sets the delay used when the node positions are unknown. */
+
+		if ( strcasecmp(argv[1], "setDefPropDelay") == 0 ) {
+
+			defPropDelay = atof(argv[2]);
+
+			core.setDefPropDelay(defPropDelay);
+
+			return TCL_OK;
+		}
+
+		/* The "setBitRate" command adds the transmission time at the given bit rate to the propagation delays. */
+
+		if ( strcasecmp(argv[1], "setBitRate") == 0 ) {
+
+			bitRate = atof(argv[2]);
+
+			return TCL_OK;
+		}
+
+		/* The "setNumWorkers" command sets the number of threads used to rebuild the delay matrix. */
+
+		if ( strcasecmp(argv[1], "setNumWorkers") == 0 ) {
+
+			numWorkers = atoi(argv[2]);
+
+			return TCL_OK;
+		}
+
+		/* The "setCartesian" command selects x, y (m) positions instead of latitude and longitude. */
+
+		if ( strcasecmp(argv[1], "setCartesian") == 0 ) {
+
+			cartesian = atoi(argv[2]);
+
+			core.setCartesian(cartesian == 1);
+
+			return TCL_OK;
+		}
+	}
+	else if ( argc == 4 ) {
+
+		/* The "getLinkDelay" command returns the propagation delay between two nodes. */
+
+		if ( strcasecmp(argv[1], "getLinkDelay") == 0 ) {
+
+			tcl.resultf("%f", core.getLinkDelay(atoi(argv[2]), atoi(argv[3])));
+
+			return TCL_OK;
+		}
+	}
+	else if ( argc == 6 ) {
+
+		/* The "setPosition" command sets the position of a node: node_id latitude longitude depth. */
+
+		if ( strcasecmp(argv[1], "setPosition") == 0 ) {
+
+			pos.latitude = atof(argv[3]);
+			pos.longitude = atof(argv[4]);
+			pos.depth = atof(argv[5]);
+
+			core.setPosition(atoi(argv[2]), pos);
+
+			return TCL_OK;
+		}
+	}
+
+	return TclObject::command(argc, argv);
+}
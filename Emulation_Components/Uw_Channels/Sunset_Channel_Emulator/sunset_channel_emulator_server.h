@@ -0,0 +1,70 @@
+/* SUNSET - Sapienza University Networking framework for underwater Simulation, Emulation and real-life Testing
+ *
+ * Copyright (C) 2012 Regents of UWSN Group of SENSES Lab <http://reti.dsi.uniroma1.it/SENSES_lab/>
+ *
+ * Author: Daniele Spaccini - spaccini@di.uniroma1.it
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License as published
+ * at http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANATBILITY or FITNESS FOR A PARTICULAR PURPOSE. See the Creative Commons
+ * Attribution-NonCommercial-ShareAlike 3.0 Unported License for more details.
+ *
+ * You should have received a copy of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License
+ * along with this program. If not, see <http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode>.
+ */
+
+#ifndef __Sunset_Channel_Emulator_Server_h__
+#define __Sunset_Channel_Emulator_Server_h__
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <module.h>
+#include <node-core.h>
+#include <sunset_module.h>
+
+#include <sunset_channel_emulator_core.h>
+
+/*! @brief This class exposes the Sunset_Channel_Emulator_Core to the TCL scripts. It accepts the commands of the
+ *  Sunset_Channel_Emulator module so that the emulation scripts can select it by changing only the created class.
+ *  All the sockets are handled by the core reactor thread and the delay matrix rebuilds are split on the core worker
+ *  pool. As for Sunset_Channel_Emulator, the first node creates the server and the other nodes, which cannot listen
+ *  on the same ports, connect to the instance already running.
+ */
+
+class Sunset_Channel_Emulator_Server : public Sunset_Module, public TclObject {
+
+public:
+
+	Sunset_Channel_Emulator_Server();
+	~Sunset_Channel_Emulator_Server();
+
+	virtual int command(int argc, const char*const* argv);
+
+	virtual void start();
+	virtual void stop();
+
+	/*! @brief Returns true if this node is running the channel emulator server. */
+
+	bool isRunning() { return running; }
+
+protected:
+
+	Sunset_Channel_Emulator_Core core;	/*!< \brief  Reactor, timer wheel, delay matrix and worker pool. */
+
+	int socketPort;		/*!< \brief  Channel emulator server port. */
+	int socketPortPos;	/*!< \brief  Positions server port. */
+	int posEmu;		/*!< \brief  1, if the node positions are received on socketPortPos */
+	double defPropDelay;	/*!< \brief  Default propagation delay (sec) */
+	double bitRate;		/*!< \brief  If > 0 the transmission time is added to the propagation delay */
+	int numWorkers;		/*!< \brief  Number of worker threads used to rebuild the delay matrix */
+	int cartesian;		/*!< \brief  1, if the positions are x, y (m) instead of latitude and longitude */
+
+	bool running;
+};
+
+#endif
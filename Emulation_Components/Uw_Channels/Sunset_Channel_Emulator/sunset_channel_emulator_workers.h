@@ -0,0 +1,246 @@
+/* SUNSET - Sapienza University Networking framework for underwater Simulation, Emulation and real-life Testing
+ *
+ * Copyright (C) 2012 Regents of UWSN Group of SENSES Lab <http://reti.dsi.uniroma1.it/SENSES_lab/>
+ *
+ * Author: Daniele Spaccini - spaccini@di.uniroma1.it
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License as published
+ * at http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANATBILITY or FITNESS FOR A PARTICULAR PURPOSE. See the Creative Commons
+ * Attribution-NonCommercial-ShareAlike 3.0 Unported License for more details.
+ *
+ * You should have received a copy of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License
+ * along with this program. If not, see <http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode>.
+ */
+
+#ifndef __Sunset_Channel_Emulator_Workers_h__
+#define __Sunset_Channel_Emulator_Workers_h__
+
+#include <stdlib.h>
+#include <pthread.h>
+
+#include <sunset_debug.h>
+
+#define SUNSET_EMU_MAX_WORKERS		16	/*!< @brief Maximum number of worker threads. */
+#define SUNSET_EMU_MIN_CHUNK		32	/*!< @brief Minimum number of items assigned to a worker, smaller jobs are executed by the calling thread. */
+
+/*! @brief Function executed on the items [begin, end) of a job. */
+typedef void (*sunset_emu_job_fn)(void* ctx, int begin, int end);
+
+/*! @brief This class implements the worker pool used by the channel emulator to compute in parallel the per-link 
+ *  information (delay matrix rows, ...). The calling thread splits the job in chunks, executes the first 
+ *  one and waits for the workers to complete the others. Only one job at a time is executed.
+ */
+
+class Sunset_Channel_Emulator_Workers {
+	
+public:
+	
+	Sunset_Channel_Emulator_Workers()
+	{
+		numWorkers_ = 0;
+		stopping_ = false;
+		generation_ = 0;
+		pending_ = 0;
+		fn_ = 0;
+		ctx_ = 0;
+		count_ = 0;
+		chunk_ = 0;
+		
+		pthread_mutex_init(&mutex_, NULL);
+		pthread_cond_init(&work_, NULL);
+		pthread_cond_init(&done_, NULL);
+	}
+	
+	~Sunset_Channel_Emulator_Workers()
+	{
+		stop();
+		
+		pthread_cond_destroy(&done_);
+		pthread_cond_destroy(&work_);
+		pthread_mutex_destroy(&mutex_);
+	}
+	
+	/*! @brief The start function creates the worker threads. With 0 workers the jobs are executed by the calling thread. */
+	
+	bool start(int numWorkers)
+	{
+		if ( numWorkers > SUNSET_EMU_MAX_WORKERS ) {
+			
+			numWorkers = SUNSET_EMU_MAX_WORKERS;
+		}
+		
+		stopping_ = false;
+		
+		for ( numWorkers_ = 0; numWorkers_ < numWorkers; numWorkers_++ ) {
+			
+			args_[numWorkers_].pool = this;
+			args_[numWorkers_].index = numWorkers_ + 1;	// chunk 0 is executed by the calling thread
+			args_[numWorkers_].generation = generation_;	// jobs submitted before the worker runs are not missed
+			
+			if ( pthread_create(&threads_[numWorkers_], NULL, Sunset_Channel_Emulator_Workers::workerThread, (void*)(&args_[numWorkers_])) != 0 ) {
+				
+				SUNSET_DEBUG_LOG(-1, -1, "Sunset_Channel_Emulator_Workers::start ERROR creating worker %d", numWorkers_);
+				
+				return false;
+			}
+		}
+		
+		return true;
+	}
+	
+	/*! @brief The stop function terminates the worker threads. */
+	
+	void stop()
+	{
+		pthread_mutex_lock(&mutex_);
+		
+		stopping_ = true;
+		pthread_cond_broadcast(&work_);
+		
+		pthread_mutex_unlock(&mutex_);
+		
+		for ( int i = 0; i < numWorkers_; i++ ) {
+			
+			pthread_join(threads_[i], NULL);
+		}
+		
+		numWorkers_ = 0;
+	}
+	
+	/*! @brief The run function executes fn on the items [0, count) and returns when all of them have been processed. */
+	
+	void run(sunset_emu_job_fn fn, void* ctx, int count)
+	{
+		int chunks = count / SUNSET_EMU_MIN_CHUNK;
+		
+		if ( chunks > numWorkers_ + 1 ) {
+			
+			chunks = numWorkers_ + 1;
+		}
+		
+		if ( chunks <= 1 ) {
+			
+			fn(ctx, 0, count);
+			
+			return;
+		}
+		
+		pthread_mutex_lock(&mutex_);
+		
+		fn_ = fn;
+		ctx_ = ctx;
+		count_ = count;
+		chunk_ = (count + chunks - 1) / chunks;
+		pending_ = chunks - 1;
+		generation_++;
+		
+		pthread_cond_broadcast(&work_);
+		
+		pthread_mutex_unlock(&mutex_);
+		
+		fn(ctx, 0, chunk_);
+		
+		pthread_mutex_lock(&mutex_);
+		
+		while ( pending_ > 0 ) {
+			
+			pthread_cond_wait(&done_, &mutex_);
+		}
+		
+		pthread_mutex_unlock(&mutex_);
+	}
+	
+	int getNumWorkers() { return numWorkers_; }
+	
+private:
+	
+	typedef struct worker_arg {
+		
+		Sunset_Channel_Emulator_Workers* pool;
+		int index;
+		unsigned int generation;	// last job generation when the worker has been created
+		
+	} worker_arg;
+	
+	static void* workerThread(void* arg)
+	{
+		worker_arg* wa = (worker_arg*)arg;
+		
+		wa->pool->work(wa->index, wa->generation);
+		
+		return NULL;
+	}
+	
+	void work(int index, unsigned int seen)
+	{
+		int begin = 0;
+		int end = 0;
+		
+		pthread_mutex_lock(&mutex_);
+		
+		while ( true ) {
+			
+			while ( generation_ == seen && !stopping_ ) {
+				
+				pthread_cond_wait(&work_, &mutex_);
+			}
+			
+			if ( stopping_ ) {
+				
+				break;
+			}
+			
+			seen = generation_;
+			
+			begin = index * chunk_;
+			end = begin + chunk_;
+			
+			if ( end > count_ ) {
+				
+				end = count_;
+			}
+			
+			if ( begin >= count_ ) {
+				
+				continue;	// fewer chunks than workers, this worker is not counted in pending_
+			}
+			
+			pthread_mutex_unlock(&mutex_);
+			
+			fn_(ctx_, begin, end);
+			
+			pthread_mutex_lock(&mutex_);
+			
+			if ( --pending_ == 0 ) {
+				
+				pthread_cond_signal(&done_);
+			}
+		}
+		
+		pthread_mutex_unlock(&mutex_);
+	}
+	
+	pthread_t threads_[SUNSET_EMU_MAX_WORKERS];
+	worker_arg args_[SUNSET_EMU_MAX_WORKERS];
+	int numWorkers_;
+	
+	pthread_mutex_t mutex_;
+	pthread_cond_t work_;		// signaled when a new job is available
+	pthread_cond_t done_;		// signaled when the last chunk of a job is completed
+	
+	bool stopping_;
+	unsigned int generation_;	// incremented for each job
+	int pending_;			// chunks not yet completed by the workers
+	
+	sunset_emu_job_fn fn_;
+	void* ctx_;
+	int count_;
+	int chunk_;
+};
+
+#endif
@@ -22,6 +22,47 @@
 #include <sunset_agt_pkt_converter.h>
 #include <ip.h>
 
+/*! @brief The fields of the converted agent header, in the order they are written after the packet header converter ID. 
+ *  When the payload is converted, it is written after these fields. */
+
+struct Agt_Control : Sunset_Schema_Field<SUNSET_SCHEMA_FIXED, (int)sizeof(struct sunset_agt_control) * 8, SUNSET_SCHEMA_ALWAYS, 1> {
+	
+	static const char* getRaw(Packet* p) { return (const char*)(&(HDR_SUNSET_AGT(p)->ac)); }
+	static void setRaw(Packet* p, const char* v) { memcpy(&(HDR_SUNSET_AGT(p)->ac), v, sizeof(struct sunset_agt_control)); }
+};
+
+struct Agt_Src : Sunset_Schema_Field<SUNSET_SCHEMA_ADDR, 0, SUNSET_AGT_USE_SOURCE> {
+	
+	static uint64_t get(Packet* p) { return (uint32_t)HDR_SUNSET_AGT(p)->srcId(); }
+	static void set(Packet* p, uint64_t v) { HDR_SUNSET_AGT(p)->srcId() = (int)v; HDR_IP(p)->saddr() = (int)v; }
+	static void absent(Packet* p) { HDR_SUNSET_AGT(p)->srcId() = 0; }
+};
+
+struct Agt_Dst : Sunset_Schema_Field<SUNSET_SCHEMA_ADDR, 0, SUNSET_AGT_USE_DEST> {
+	
+	static uint64_t get(Packet* p) { return (uint32_t)HDR_SUNSET_AGT(p)->dstId(); }
+	static void set(Packet* p, uint64_t v) { HDR_SUNSET_AGT(p)->dstId() = (int)v; HDR_IP(p)->daddr() = (int)v; }
+	static void absent(Packet* p) { HDR_SUNSET_AGT(p)->dstId() = 0; }
+};
+
+struct Agt_PktId : Sunset_Schema_Field<SUNSET_SCHEMA_PKT_ID, 0, SUNSET_AGT_USE_PKT_ID> {
+	
+	static uint64_t get(Packet* p) { return (uint32_t)HDR_SUNSET_AGT(p)->pktId(); }
+	static void set(Packet* p, uint64_t v) { HDR_SUNSET_AGT(p)->pktId() = (int)v; }
+	static void absent(Packet* p) { HDR_SUNSET_AGT(p)->pktId() = HDR_CMN(p)->uid(); }
+};
+
+struct Agt_DataSize : Sunset_Schema_Field<SUNSET_SCHEMA_DATA, 0, SUNSET_AGT_USE_DATA> {
+	
+	static uint64_t get(Packet* p) { return (uint32_t)HDR_SUNSET_AGT(p)->dataSize(); }
+	static void set(Packet* p, uint64_t v) { HDR_SUNSET_AGT(p)->dataSize() = (int)v; }
+	static void absent(Packet* p) { HDR_SUNSET_AGT(p)->dataSize() = 0; }
+};
+
+typedef Sunset_Schema<Agt_Control, Agt_Src, Agt_Dst, Agt_PktId, Agt_DataSize> Sunset_Agt_Schema;
+
+static Sunset_Schema_Codec<Sunset_Agt_Schema, SUNSET_AGT_NUM_OPTIONS> agtSchema;
+
 /*!
  * 	@brief This static class is a hook class used to instantiate a C++ object from the TCL script. 
  *	It also allows to define parameter values using the bind function in the class constructor.
@@ -50,7 +91,7 @@ Sunset_AgtPktConverter::Sunset_AgtPktConverter()
 	bind("use_pktId", &use_pktId);
 	bind("use_data", &use_data);
 	
-	Sunset_Debug::debugInfo(-1, -1, "Sunset_AgtPktConverter CREATED");
+	SUNSET_DEBUG_LOG(-1, -1, "Sunset_AgtPktConverter CREATED");
 }
 
 /*!
@@ -143,7 +184,7 @@ int Sunset_AgtPktConverter::checkPktLevel(Packet* p)
 					return 1;
 					
 				default:
-					Sunset_Debug::debugInfo(3, -1, "Sunset_Agent::getBufferInfoLength DATA type %d subtype %d", type, subtype);
+					SUNSET_DEBUG_LOG(3, -1, "Sunset_Agent::getBufferInfoLength DATA type %d subtype %d", type, subtype);
 					
 					return 0;
 			}
@@ -152,12 +193,12 @@ int Sunset_AgtPktConverter::checkPktLevel(Packet* p)
 			
 		default:
 			
-			Sunset_Debug::debugInfo(3, -1, "Sunset_Agent::getBufferInfoLength default type %d", type);
+			SUNSET_DEBUG_LOG(3, -1, "Sunset_Agent::getBufferInfoLength default type %d", type);
 			
 			return 0;
 	}
 	
-	Sunset_Debug::debugInfo(5, -1, "Sunset_AgtPktConverter::checkPktLevel");
+	SUNSET_DEBUG_LOG(5, -1, "Sunset_AgtPktConverter::checkPktLevel");
 	
 	return 0;
 }
@@ -174,9 +215,9 @@ void Sunset_AgtPktConverter::erasePkt(int level, Packet* p)
 		
 		if (use_data && HDR_SUNSET_AGT(p)->getData() != NULL) {	
 			
-			//remove the memory allocated for the packet payload
+			//release the packet payload, the buffer is reused when no other packet copy references it
 			
-			free(HDR_SUNSET_AGT(p)->getData());
+			Sunset_Agent_Payload::release(HDR_SUNSET_AGT(p)->getData());
 			
 			HDR_SUNSET_AGT(p)->data = NULL;
 		}
@@ -191,33 +232,13 @@ int Sunset_AgtPktConverter::getHeaderSizeBits()
 { 
 	int len = 0;
 	
-	len += ((int)(sizeof(struct sunset_agt_control))) * 8; //control information in the agent header
+	len += getLevelIdBits(); // information about the packet header converter ID has to be always added to allow for correct conversion
 	
 	// According to the used header values, the corresponding number of bits needed during the conversion process is computed 
 	
-	if (use_source) {  
-		
-		len += getAddrBits(); //source id
-	}
-	
-	if (use_dest) {
-		
-		len += getAddrBits(); //dest id
-	}
-	
-	if (use_pktId) {
-		
-		len += getPktIdBits(); // packet id
-	}
-	
-	if (use_data) {
-		
-		len += getDataBits(); //source id
-	}
-	
-	len += getLevelIdBits(); // information about the packet header converter ID has to be always added to allow for correct conversion
+	len += agtSchema.length(getSchemaOptions(), sunset_schema_widths(this));
 	
-	Sunset_Debug::debugInfo(3, -1,  "Sunset_AgtPktConverter::getHeaderSizeBits length %d", len);
+	SUNSET_DEBUG_LOG(3, -1,  "Sunset_AgtPktConverter::getHeaderSizeBits length %d", len);
 	
 	return len;	
 }
@@ -232,36 +253,16 @@ int Sunset_AgtPktConverter::getConvertedInfoLength(Packet* p)
 {
 	int len = 0;
 	
-	len += ((int)sizeof(struct sunset_agt_control)) * 8; //control information in the agent header
-	len += getLevelIdBits(); // packet header converter ID bits
-	
-	// According to the used header values, the corresponding number of bits needed during the conversion process is computed 
-	
-	if (use_source) {
-		
-		len += getAddrBits(); //source id
-	}
-	
-	if (use_dest) {
-		
-		len += getAddrBits(); //dest id
-	}
-	
-	if (use_pktId) {
-		
-		len += getPktIdBits(); 
-	}
+	len += getHeaderSizeBits(); // packet header converter ID and agent header fields
 	
 	if (use_data) {
 		
-		len += getDataBits(); /* bits to store the size of the payload */
-		
-		Sunset_Debug::debugInfo(3, -1, "Sunset_AgtPktConverter::getConvertedInfoLength data %d dataSizeB %d", len, HDR_SUNSET_AGT(p)->dataSize() * 8);
+		SUNSET_DEBUG_LOG(3, -1, "Sunset_AgtPktConverter::getConvertedInfoLength data %d dataSizeB %d", len, HDR_SUNSET_AGT(p)->dataSize() * 8);
 		
 		len += HDR_SUNSET_AGT(p)->dataSize() * 8; /* data payload */
 	}
 	
-	Sunset_Debug::debugInfo(3, -1, "Sunset_AgtPktConverter::getConvertedInfoLength lengthBit %d lenghtByte %d data %d", len, (int)ceil((double)len/8.0), HDR_SUNSET_AGT(p)->dataSize());
+	SUNSET_DEBUG_LOG(3, -1, "Sunset_AgtPktConverter::getConvertedInfoLength lengthBit %d lenghtByte %d data %d", len, (int)ceil((double)len/8.0), HDR_SUNSET_AGT(p)->dataSize());
 	
 	return len;
 }
@@ -279,6 +280,7 @@ int Sunset_AgtPktConverter::pkt2Buffer(int level, Packet* p, char* buffer, int o
 {
 	int aux = 0;
 	int size = 0;
+	Sunset_Bit_Writer w(buffer, offset);
 	
 	aux = getConvertedInfoLength(p); // get the number of bits that have to be written by this packet header converter
 	
@@ -286,65 +288,42 @@ int Sunset_AgtPktConverter::pkt2Buffer(int level, Packet* p, char* buffer, int o
 		return 0;
 	}
 	
-	size = getLevelIdBits(); 
-	
 	// information about the packet header converter ID has to be always written to allow for correct conversion
 	
-	setBits(buffer, (char *)(&(level)), size, offset);
-	setBits(buffer, (char *)(&(HDR_SUNSET_AGT(p)->ac)), (int)((sizeof(sunset_agt_control)) * 8), offset + size);
-	
-	size += (int)((sizeof(sunset_agt_control)) * 8);
+	w.put((uint32_t)level, getLevelIdBits());
 	
 	// According to the used header values, the corresponding number of bits needed during the conversion process is written 
 	
-	if (use_source) {
-		
-		setBits(buffer, (char *)(&(HDR_SUNSET_AGT(p)->srcId())), getAddrBits(), offset + size);
-		size += getAddrBits();
-	}
-	
-	if (use_dest) {
-		
-		setBits(buffer, (char *)(&(HDR_SUNSET_AGT(p)->dstId())), getAddrBits(), offset + size);
-		size += getAddrBits();
-	}
-	
-	if (use_pktId) {
-		
-		setBits(buffer, (char *)(&(HDR_SUNSET_AGT(p)->pktId())), getPktIdBits(), offset + size);
-		size += getPktIdBits();
-	}
+	agtSchema.encode(getSchemaOptions(), p, w, sunset_schema_widths(this));
 	
 	if (use_data) {
 		
-		setBits(buffer, (char *)(&(HDR_SUNSET_AGT(p)->dataSize())), getDataBits(), offset + size);
-		size += getDataBits();
-		
 		if ((HDR_SUNSET_AGT(p)->dataSize()) > 0) {
-			setBits(buffer, (HDR_SUNSET_AGT(p)->getData()), (HDR_SUNSET_AGT(p)->dataSize() * 8), offset + size);
-			size += (HDR_SUNSET_AGT(p)->dataSize() * 8);
+			
+			w.putBits(HDR_SUNSET_AGT(p)->getData(), HDR_SUNSET_AGT(p)->dataSize() * 8);
 
-			Sunset_Debug::debugInfo(5, -1, "Sunset_AgtPktConverter::pkt2Buffer AGENT data len %d msg:%s", (HDR_SUNSET_AGT(p)->dataSize()), HDR_SUNSET_AGT(p)->data);
+			SUNSET_DEBUG_LOG(5, -1, "Sunset_AgtPktConverter::pkt2Buffer AGENT data len %d msg:%s", (HDR_SUNSET_AGT(p)->dataSize()), HDR_SUNSET_AGT(p)->data);
 		}
 		else {
 			
-			Sunset_Debug::debugInfo(5, -1, "Sunset_AgtPktConverter::pkt2Buffer AGENT data NO DATA");
+			SUNSET_DEBUG_LOG(5, -1, "Sunset_AgtPktConverter::pkt2Buffer AGENT data NO DATA");
 		}
 	}
 	
+	size = w.getPosition() - offset;
+	
 	// if less bits are written w.r.t. the ones computed using the getConvertedInfoLength an error occurrs and 0 bits are added to the packet
 	if (aux != size) {
 		
-		Sunset_Debug::debugInfo(-1, -1, "Sunset_AgtPktConverter::pkt2Buffer buffer filled ERROR aux %d size %d bits", aux, size);
+		SUNSET_DEBUG_LOG(-1, -1, "Sunset_AgtPktConverter::pkt2Buffer buffer filled ERROR aux %d size %d bits", aux, size);
 		
 		return 0;
-		exit(1);
 	}
 	
-	Sunset_Debug::debugInfo(5, -1, "Sunset_AgtPktConverter::pkt2Buffer type %d subtype %d version %d src %d dst %d pktId %d dataSize %d", HDR_SUNSET_AGT(p)->ac.ac_type, HDR_SUNSET_AGT(p)->ac.ac_subtype, HDR_SUNSET_AGT(p)->ac.ac_protocol_version, HDR_SUNSET_AGT(p)->srcId(), HDR_SUNSET_AGT(p)->dstId(), HDR_SUNSET_AGT(p)->pktId(), HDR_SUNSET_AGT(p)->dataSize());
+	SUNSET_DEBUG_LOG(5, -1, "Sunset_AgtPktConverter::pkt2Buffer type %d subtype %d version %d src %d dst %d pktId %d dataSize %d", HDR_SUNSET_AGT(p)->ac.ac_type, HDR_SUNSET_AGT(p)->ac.ac_subtype, HDR_SUNSET_AGT(p)->ac.ac_protocol_version, HDR_SUNSET_AGT(p)->srcId(), HDR_SUNSET_AGT(p)->dstId(), HDR_SUNSET_AGT(p)->pktId(), HDR_SUNSET_AGT(p)->dataSize());
 	
-	Sunset_Debug::debugInfo(5, -1, "AGENT data %s", HDR_SUNSET_AGT(p)->data);
-	Sunset_Debug::debugInfo(5, -1, "Sunset_AgtPktConverter::pkt2Buffer buffer filled size %d bits", size);
+	SUNSET_DEBUG_LOG(5, -1, "AGENT data %s", HDR_SUNSET_AGT(p)->data);
+	SUNSET_DEBUG_LOG(5, -1, "Sunset_AgtPktConverter::pkt2Buffer buffer filled size %d bits", size);
 	
 	return size;
 }
@@ -362,21 +341,21 @@ int Sunset_AgtPktConverter::pkt2Buffer(int level, Packet* p, char* buffer, int o
 int Sunset_AgtPktConverter::buffer2Pkt(int level, Packet* p, char* buffer, int offset, int bits) 
 {
 	int length = 0;
-	struct hdr_ip* iph = HDR_IP(p);
 	int size = getLevelIdBits();
 	int info_level = 0;
+	Sunset_Bit_Reader r(buffer, offset);
 	
 	// check if there are enough bits to read the packet header converter ID
 	if (bits < size) {
 		
-		Sunset_Debug::debugInfo(5, -1, "Sunset_AgtPktConverter::buffer2Pkt check bits1 bits %d size %d", bits, size);
+		SUNSET_DEBUG_LOG(5, -1, "Sunset_AgtPktConverter::buffer2Pkt check bits1 bits %d size %d", bits, size);
 		
 		return 0;
 	}
 	
 	// read the packet header converter ID
 	
-	getBits(buffer, (char *)(&(info_level)), size, offset);
+	info_level = (int)r.get(size);
 	
 	// check if the packet header converter ID corresponds to my ID
 	
@@ -389,91 +368,39 @@ int Sunset_AgtPktConverter::buffer2Pkt(int level, Packet* p, char* buffer, int o
 	
 	if (bits < getHeaderSizeBits()) {
 		
-		Sunset_Debug::debugInfo(5, -1, "Sunset_AgtPktConverter::buffer2Pkt check bits2 bits %d size %d", bits, getHeaderSizeBits());
+		SUNSET_DEBUG_LOG(5, -1, "Sunset_AgtPktConverter::buffer2Pkt check bits2 bits %d size %d", bits, getHeaderSizeBits());
 		
 		return -1;
 	}
 	
-	HDR_SUNSET_AGT(p)->srcId() = 0;
-	HDR_SUNSET_AGT(p)->dstId() = 0;
-	HDR_SUNSET_AGT(p)->pktId() = 0;
-	HDR_SUNSET_AGT(p)->dataSize() = 0;
-	
-	getBits(buffer, (char *)(&(HDR_SUNSET_AGT(p)->ac)), (int)((sizeof(sunset_agt_control)) * 8), offset + size);
-	size += (int)((sizeof(sunset_agt_control)) * 8);
-	
-	// According to the used header values, the corresponding number of bits needed during the conversion process is written 
+	// According to the used header values, the corresponding number of bits needed during the conversion process is read 
 	
-	if (use_source) {
-		
-		int srcId = 0;
-		
-		getBits(buffer, (char *)(&(srcId)), getAddrBits(), offset + size);
-		size += getAddrBits();
-		
-		HDR_SUNSET_AGT(p)->srcId() = srcId;
-		iph->saddr() = HDR_SUNSET_AGT(p)->srcId();
-	}
-	
-	if (use_dest) {
-		
-		int dstId = 0;
-		
-		getBits(buffer, (char *)(&(dstId)), getAddrBits(), offset + size);
-		size += getAddrBits();
-		
-		HDR_SUNSET_AGT(p)->dstId() = dstId;
-		iph->daddr() = HDR_SUNSET_AGT(p)->dstId();
-	}
-	
-	if (use_pktId) {
-		
-		int pktId = 0;
-		
-		getBits(buffer, (char *)(&(pktId)), getPktIdBits(), offset + size);
-		size += getPktIdBits();
-		
-		HDR_SUNSET_AGT(p)->pktId() = pktId;
-	}
-	
-	else {
-	
-		HDR_SUNSET_AGT(p)->pktId() = HDR_CMN(p)->uid();
-	}
+	agtSchema.decode(getSchemaOptions(), p, r, sunset_schema_widths(this));
 	
 	if (use_data) {
 		
-		int dataSize = 0;
-		
-		getBits(buffer, (char *)(&(dataSize)), getDataBits(), offset + size);
-		size += getDataBits();
-		
-		HDR_SUNSET_AGT(p)->dataSize() = dataSize;
 		length += (HDR_SUNSET_AGT(p)->dataSize());
 		
 		HDR_CMN(p)->size() += length;
 		
 		if ((HDR_SUNSET_AGT(p)->dataSize()) > 0 ) {
 			
-			HDR_SUNSET_AGT(p)->data = (char*)(malloc((int)(HDR_SUNSET_AGT(p)->dataSize()) + 1));
+			HDR_SUNSET_AGT(p)->data = Sunset_Agent_Payload::alloc((int)(HDR_SUNSET_AGT(p)->dataSize()));
 			
-			memset(HDR_SUNSET_AGT(p)->data, '\0', (int)(HDR_SUNSET_AGT(p)->dataSize() + 1));
+			r.getBits(HDR_SUNSET_AGT(p)->data, HDR_SUNSET_AGT(p)->dataSize() * 8);
 			
-			getBits(buffer, (HDR_SUNSET_AGT(p)->data), HDR_SUNSET_AGT(p)->dataSize() * 8, offset + size);
-			size += HDR_SUNSET_AGT(p)->dataSize() * 8;
-			
-			//HDR_SUNSET_AGT(p)->getData() = HDR_SUNSET_AGT(p)->data;
-			
-			Sunset_Debug::debugInfo(5, -1, "Sunset_AgtPktConverter::buffer2Pkt AGENT data len %d msg:%s", (HDR_SUNSET_AGT(p)->dataSize()), HDR_SUNSET_AGT(p)->data);
+			SUNSET_DEBUG_LOG(5, -1, "Sunset_AgtPktConverter::buffer2Pkt AGENT data len %d msg:%s", (HDR_SUNSET_AGT(p)->dataSize()), HDR_SUNSET_AGT(p)->data);
 		}
 		else {
 			
-			Sunset_Debug::debugInfo(5, -1, "Sunset_AgtPktConverter::buffer2Pkt AGENT data NO DATA");
+			SUNSET_DEBUG_LOG(5, -1, "Sunset_AgtPktConverter::buffer2Pkt AGENT data NO DATA");
 		}
 	}
 	
-	Sunset_Debug::debugInfo(5, -1, "Sunset_AgtPktConverter::buffer2Pkt type %d subtype %d version %d src %d dst %d pktId %d dataSize %d length %d", HDR_SUNSET_AGT(p)->ac.ac_type, HDR_SUNSET_AGT(p)->ac.ac_subtype, HDR_SUNSET_AGT(p)->ac.ac_protocol_version, HDR_SUNSET_AGT(p)->srcId(), HDR_SUNSET_AGT(p)->dstId(), HDR_SUNSET_AGT(p)->pktId(), HDR_SUNSET_AGT(p)->dataSize(), length);
-	Sunset_Debug::debugInfo(5, -1, "Sunset_AgtPktConverter::buffer2Pkt agent info for the packet have been set length %d", length);
+	size = r.getPosition() - offset;
+	
+	SUNSET_DEBUG_LOG(5, -1, "Sunset_AgtPktConverter::buffer2Pkt type %d subtype %d version %d src %d dst %d pktId %d dataSize %d length %d", HDR_SUNSET_AGT(p)->ac.ac_type, HDR_SUNSET_AGT(p)->ac.ac_subtype, HDR_SUNSET_AGT(p)->ac.ac_protocol_version, HDR_SUNSET_AGT(p)->srcId(), HDR_SUNSET_AGT(p)->dstId(), HDR_SUNSET_AGT(p)->pktId(), HDR_SUNSET_AGT(p)->dataSize(), length);
+	SUNSET_DEBUG_LOG(5, -1, "Sunset_AgtPktConverter::buffer2Pkt agent info for the packet have been set length %d", length);
 	
 	return size;
 }
@@ -573,7 +500,7 @@ int Sunset_AgtPktConverter::getPktType(int level, Packet* p, sunset_header_type
 }
 
 /*!
- * 	@brief The data_copy function copies packet p information in packet copy allocating additional memory for the packet payload. 
+ * 	@brief The data_copy function copies packet p information in packet copy, the payload buffer is shared between the two packets. 
  * 	@param p The packet to copy.
  * 	@param copy The copied packet.
  */
@@ -587,14 +514,14 @@ int Sunset_AgtPktConverter::data_copy(int  level, Packet *p, Packet* copy)
 		
 		if (length > 0) {
 			
-			HDR_SUNSET_AGT(copy)->data = (char*)(malloc( length + 1));		
-			memset(HDR_SUNSET_AGT(copy)->data, '\0', length + 1);
-			memcpy(HDR_SUNSET_AGT(copy)->data, HDR_SUNSET_AGT(p)->data, length); 
+			// the copy shares the payload of the original packet, it is duplicated only if modified (see getWritableData)
+			
+			HDR_SUNSET_AGT(copy)->data = Sunset_Agent_Payload::share(HDR_SUNSET_AGT(p)->data);
 			
-			Sunset_Debug::debugInfo(5, -1, "AGENT pkt_copy data %s len %d", HDR_SUNSET_AGT(copy)->data, length);
+			SUNSET_DEBUG_LOG(5, -1, "AGENT pkt_copy data %s len %d", HDR_SUNSET_AGT(copy)->data, length);
 		}
 		else {
-			Sunset_Debug::debugInfo(5, -1, "AGENT pkt_copy ERROR");		
+			SUNSET_DEBUG_LOG(5, -1, "AGENT pkt_copy ERROR");		
 			
 			return 0;
 		}
@@ -612,5 +539,5 @@ void Sunset_AgtPktConverter::start()
 	Sunset_PktConverter::start();
 	assignNsPktType(PT_SUNSET_AGT);
 
-	Sunset_Debug::debugInfo(5, -1, "Sunset_AgtPktConverter::start");
+	SUNSET_DEBUG_LOG(5, -1, "Sunset_AgtPktConverter::start");
 }
\ No newline at end of file
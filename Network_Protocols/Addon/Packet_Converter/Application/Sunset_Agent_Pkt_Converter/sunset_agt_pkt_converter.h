@@ -23,6 +23,13 @@
 
 #include <sunset_agent_pkt.h>
 #include <sunset_pkt_converter.h>
+#include <sunset_pkt_schema.h>
+
+#define SUNSET_AGT_USE_SOURCE		0	/*!< @brief Schema option converting the agent source ID. */
+#define SUNSET_AGT_USE_DEST		1	/*!< @brief Schema option converting the agent destination ID. */
+#define SUNSET_AGT_USE_PKT_ID		2	/*!< @brief Schema option converting the agent packet ID. */
+#define SUNSET_AGT_USE_DATA		3	/*!< @brief Schema option converting the agent payload size (the payload follows the header). */
+#define SUNSET_AGT_NUM_OPTIONS		4
 
 /*!< \brief This class is responsable for the conversion of the Agent header information into a stream of bytes. */
 
@@ -47,7 +54,7 @@ public:
 	virtual void erasePkt(int level, Packet* p);
 	
 	/*! @brief The getName prints the packet header converter name.*/
-	virtual void getName() { Sunset_Debug::debugInfo(3, -1, "Sunset_AgtPktConverter"); }
+	virtual void getName() { SUNSET_DEBUG_LOG(3, -1, "Sunset_AgtPktConverter"); }
 	
 	int data_copy(int level, Packet *p, Packet* copy);
 	
@@ -67,6 +74,9 @@ public:
 	
 protected:
 	
+	/*! @brief The getSchemaOptions function returns the mask of the optional fields currently converted. */
+	int getSchemaOptions() { return (use_source ? (1 << SUNSET_AGT_USE_SOURCE) : 0) | (use_dest ? (1 << SUNSET_AGT_USE_DEST) : 0) | (use_pktId ? (1 << SUNSET_AGT_USE_PKT_ID) : 0) | (use_data ? (1 << SUNSET_AGT_USE_DATA) : 0); }
+	
 	int use_source;
 	int use_dest;
 	int use_pktId;
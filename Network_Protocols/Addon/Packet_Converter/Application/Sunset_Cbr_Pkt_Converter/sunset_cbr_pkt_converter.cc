@@ -20,6 +20,57 @@
 #include <sunset_cbr_pkt_converter.h>
 #include <ip.h>
 
+/*! @brief The fields of the converted CBR header, in the order they are written after the packet header converter ID. */
+
+struct Cbr_Saddr : Sunset_Schema_Field<SUNSET_SCHEMA_ADDR, 0> {
+	
+	static uint64_t get(Packet* p) { return (uint32_t)HDR_IP(p)->saddr(); }
+	static void set(Packet* p, uint64_t v) { HDR_IP(p)->saddr() = (nsaddr_t)v; }
+};
+
+struct Cbr_Daddr : Sunset_Schema_Field<SUNSET_SCHEMA_ADDR, 0> {
+	
+	static uint64_t get(Packet* p) { return (uint32_t)HDR_IP(p)->daddr(); }
+	static void set(Packet* p, uint64_t v) { HDR_IP(p)->daddr() = (nsaddr_t)v; }
+};
+
+struct Cbr_Uid : Sunset_Schema_Field<SUNSET_SCHEMA_PKT_ID, 0> {
+	
+	static uint64_t get(Packet* p) { return (uint32_t)HDR_CMN(p)->uid(); }
+	static void set(Packet* p, uint64_t v) { HDR_CMN(p)->uid() = (int)v; }
+};
+
+struct Cbr_Sn : Sunset_Schema_Field<SUNSET_SCHEMA_PKT_ID, 0> {
+	
+	static uint64_t get(Packet* p) { return (uint32_t)HDR_CBR(p)->sn; }
+	static void set(Packet* p, uint64_t v) { HDR_CBR(p)->sn = (int)v; }
+};
+
+struct Cbr_Dport : Sunset_Schema_Field<SUNSET_SCHEMA_PORT, 0> {
+	
+	static uint64_t get(Packet* p) { return (uint32_t)HDR_IP(p)->dport(); }
+	static void set(Packet* p, uint64_t v) { HDR_IP(p)->dport() = (nsaddr_t)v; }
+};
+
+struct Cbr_Sport : Sunset_Schema_Field<SUNSET_SCHEMA_PORT, 0> {
+	
+	static uint64_t get(Packet* p) { return (uint32_t)HDR_IP(p)->sport(); }
+	static void set(Packet* p, uint64_t v) { HDR_IP(p)->sport() = (nsaddr_t)v; }
+};
+
+// the timestamp is converted copying the memory of the double value
+
+struct Cbr_Ts : Sunset_Schema_Field<SUNSET_SCHEMA_TIME, 0, SUNSET_CBR_USE_TIMESTAMP, 1> {
+	
+	static const char* getRaw(Packet* p) { return (const char*)(&(HDR_CBR(p)->ts)); }
+	static void setRaw(Packet* p, const char* v) { double ts = 0.0; memcpy(&ts, v, sizeof(double)); HDR_CBR(p)->ts = ts; }
+	static void absent(Packet* p) { HDR_CBR(p)->ts = 0.0; }
+};
+
+typedef Sunset_Schema<Cbr_Saddr, Cbr_Daddr, Cbr_Uid, Cbr_Sn, Cbr_Dport, Cbr_Sport, Cbr_Ts> Sunset_Cbr_Schema;
+
+static Sunset_Schema_Codec<Sunset_Cbr_Schema, SUNSET_CBR_NUM_OPTIONS> cbrSchema;
+
 /*!
  * 	@brief This static class is a hook class used to instantiate a C++ object from the TCL script. 
  *	It also allows to define parameter values using the bind function in the class constructor.
@@ -46,7 +97,7 @@ Sunset_CbrPktConverter::Sunset_CbrPktConverter()
 	bind("use_timestamp", &use_timestamp);
 	bind("PORT_BITS", &PORT_BITS);
 	
-	Sunset_Debug::debugInfo(-1, -1, "Sunset_CbrPktConverter CREATO");
+	SUNSET_DEBUG_LOG(-1, -1, "Sunset_CbrPktConverter CREATO");
 }
 
 /*!
@@ -100,7 +151,7 @@ int Sunset_CbrPktConverter::checkPktLevel(Packet* p)
 		return 1;
 	}
 	
- 	Sunset_Debug::debugInfo(5, -1, "Sunset_CbrPktConverter::checkPktLevel");
+ 	SUNSET_DEBUG_LOG(5, -1, "Sunset_CbrPktConverter::checkPktLevel");
 	
 	return 0;
 }
@@ -125,26 +176,13 @@ int Sunset_CbrPktConverter::getConvertedInfoLength(Packet* p)
 {
 	int len = 0;
 	
-	len += getAddrBits(); //source id
-	
-	len += getAddrBits(); //dest id
-	
-	len += getPktIdBits(); // common header id
+	// source and destination IDs, common header ID, sequence number, destination and source port numbers and, if used, timestamp
 	
-	len += getPktIdBits(); // sequence number
-	
-	len += getPortBits(); // src port number
-	
-	len += getPortBits(); // dst port number
-	
-	if (use_timestamp) {
-		
-		len += getTimeBits(); //timestamp 
-	}
+	len += cbrSchema.length(getSchemaOptions(), sunset_schema_widths(this, getPortBits()));
 	
 	len += getLevelIdBits(); // information about the packet header converter ID has to be always added to allow for correct conversion
 	
-	Sunset_Debug::debugInfo(3, -1, "Sunset_CbrPktConverter::getConvertedInfoLength lengthBit %d lenghtByte %d", len, (int)ceil((double)len/8.0));
+	SUNSET_DEBUG_LOG(3, -1, "Sunset_CbrPktConverter::getConvertedInfoLength lengthBit %d lenghtByte %d", len, (int)ceil((double)len/8.0));
 	
 	return len;
 }
@@ -162,10 +200,7 @@ int Sunset_CbrPktConverter::pkt2Buffer(int level, Packet* p, char* buffer, int o
 {
 	int aux = 0;
 	int size = 0;
-	
-	hdr_cmn* ch = hdr_cmn::access(p);
-	hdr_ip* iph = hdr_ip::access(p);
-	hdr_cbr* cbrh = HDR_CBR(p);
+	Sunset_Bit_Writer w(buffer, offset);
 	
 	aux = getConvertedInfoLength(p); // get the number of bits that have to be written by this packet header converter
 	
@@ -173,46 +208,23 @@ int Sunset_CbrPktConverter::pkt2Buffer(int level, Packet* p, char* buffer, int o
 		return 0;
 	}
 	
-	size = getLevelIdBits(); 
-	
 	// information about the packet header converter ID has to be always written to allow for correct conversion
 	
-	setBits(buffer, (char *)(&(level)), size, offset);
-	
-	setBits(buffer, (char *)(&(iph->saddr())), getAddrBits(), offset + size);
-	size += getAddrBits();
-	
-	setBits(buffer, (char *)(&(iph->daddr())), getAddrBits(), offset + size);
-	size += getAddrBits();
+	w.put((uint32_t)level, getLevelIdBits());
 	
-	setBits(buffer, (char *)(&(ch->uid())), getPktIdBits(), offset + size);
-	size += getPktIdBits();
+	cbrSchema.encode(getSchemaOptions(), p, w, sunset_schema_widths(this, getPortBits()));
 	
-	setBits(buffer, (char *)(&(cbrh->sn)), getPktIdBits(), offset + size);
-	size += getPktIdBits();
-	
-	setBits(buffer, (char *)(&(iph->dport())), getPortBits(), offset + size);
-	size += getPortBits();
-	
-	setBits(buffer, (char *)(&(iph->sport())), getPortBits(), offset + size);
-	size += getPortBits();
-	
-	if (use_timestamp) {
-		
-		setBits(buffer, (char *)(&(cbrh->ts)), getTimeBits(), offset + size);
-		size += getTimeBits();
-	}
+	size = w.getPosition() - offset;
 	
 	// if less bits are written w.r.t. the ones computed using the getConvertedInfoLength an error occurrs and 0 bits are added to the packet
 	if (aux != size) {
 		
-		Sunset_Debug::debugInfo(-1, -1, "Sunset_CbrPktConverter::pkt2Buffer buffer filled ERROR aux %d size %d bits", aux, size);
+		SUNSET_DEBUG_LOG(-1, -1, "Sunset_CbrPktConverter::pkt2Buffer buffer filled ERROR aux %d size %d bits", aux, size);
 		
 		return 0;
-		exit(1);
 	}
 	
-	Sunset_Debug::debugInfo(5, -1, "Sunset_CbrPktConverter::pkt2Buffer buffer filled size %d bits", size);
+	SUNSET_DEBUG_LOG(5, -1, "Sunset_CbrPktConverter::pkt2Buffer buffer filled size %d bits", size);
 	
 	return size;
 }
@@ -229,27 +241,21 @@ int Sunset_CbrPktConverter::pkt2Buffer(int level, Packet* p, char* buffer, int o
 
 int Sunset_CbrPktConverter::buffer2Pkt(int level, Packet* p, char* buffer, int offset, int bits) 
 {
-	int length = 0;
-	hdr_cmn* ch = hdr_cmn::access(p);
-	hdr_ip* iph = hdr_ip::access(p);
-	hdr_cbr* cbrh = HDR_CBR(p);
 	int size = getLevelIdBits();
 	int info_level = 0;
-	nsaddr_t temp = 0;
-	int temp1 = 0;
-	double temp2 = 0.0;
+	Sunset_Bit_Reader r(buffer, offset);
 	
 	// check if there are enough bits to read the packet header converter ID
 	if (bits < size) {
 		
-		Sunset_Debug::debugInfo(5, -1, "Sunset_CbrPktConverter::buffer2Pkt check bits1 bits %d size %d", bits, size);
+		SUNSET_DEBUG_LOG(5, -1, "Sunset_CbrPktConverter::buffer2Pkt check bits1 bits %d size %d", bits, size);
 		
 		return 0;
 	}
 	
 	// read the packet header converter ID
 	
-	getBits(buffer, (char *)(&(info_level)), size, offset);
+	info_level = (int)r.get(size);
 	
 	// check if the packet header converter ID corresponds to my ID
 	
@@ -262,65 +268,16 @@ int Sunset_CbrPktConverter::buffer2Pkt(int level, Packet* p, char* buffer, int o
 	
 	if (bits < getHeaderSizeBits()) {
 		
-		Sunset_Debug::debugInfo(5, -1, "Sunset_CbrPktConverter::buffer2Pkt check bits2 bits %d size %d", bits, getHeaderSizeBits());
+		SUNSET_DEBUG_LOG(5, -1, "Sunset_CbrPktConverter::buffer2Pkt check bits2 bits %d size %d", bits, getHeaderSizeBits());
 		
 		return -1;
 	}
 	
-	iph->saddr() = 0;
-	iph->daddr() = 0;
-	cbrh->sn = 0;
-	iph->sport() = 0;
-	iph->dport() = 0;
-	cbrh->ts = 0.0;
-	ch->uid() = 0;
-	
-	temp = 0;
-	getBits(buffer, (char *)(&(temp)), getAddrBits(), offset + size);
-	size += getAddrBits();
-	
-	iph->saddr() = temp;
-	
-	temp = 0;
-	getBits(buffer, (char *)(&(temp)), getAddrBits(), offset + size);
-	size += getAddrBits();
+	cbrSchema.decode(getSchemaOptions(), p, r, sunset_schema_widths(this, getPortBits()));
 	
-	iph->daddr() = temp;
-	
-	temp1 = 0;
-	getBits(buffer, (char *)(&(temp1)), getPktIdBits(), offset + size);
-	size += getPktIdBits();
-	
-	ch->uid() = temp1;
-	
-	temp1 = 0;
-	getBits(buffer, (char *)(&(temp1)), getPktIdBits(), offset + size);
-	size += getPktIdBits();
-	
-	cbrh->sn = temp1;
-	
-	temp = 0;
-	getBits(buffer, (char *)(&(temp)), getPortBits(), offset + size);
-	size += getPortBits();
-	
-	iph->dport() = temp;
-	
-	temp = 0;
-	getBits(buffer, (char *)(&(temp)), getPortBits(), offset + size);
-	size += getPortBits();
-	
-	iph->sport() = temp;
-	
-	if (use_timestamp) {
-		
-		temp2 = 0.0;
-		getBits(buffer, (char *)(&(temp2)), getTimeBits(), offset + size);
-		size += getTimeBits();
-		
-		cbrh->ts = temp2;
-	}
+	size = r.getPosition() - offset;
 	
-	Sunset_Debug::debugInfo(5, -1, "Sunset_CbrPktConverter::buffer2Pkt cbr info for the packet have been set length %d", length);
+	SUNSET_DEBUG_LOG(5, -1, "Sunset_CbrPktConverter::buffer2Pkt cbr info for the packet have been set length %d", size);
 	
 	return size;
 }
@@ -374,6 +331,6 @@ void Sunset_CbrPktConverter::start()
 {	
 	Sunset_PktConverter::start();
 	assignNsPktType(PT_MCBR);
-	Sunset_Debug::debugInfo(5, -1, "Sunset_CbrPktConverter::start");
+	SUNSET_DEBUG_LOG(5, -1, "Sunset_CbrPktConverter::start");
 }
 
@@ -22,6 +22,10 @@
 
 #include <cbr-module.h>
 #include <sunset_pkt_converter.h>
+#include <sunset_pkt_schema.h>
+
+#define SUNSET_CBR_USE_TIMESTAMP	0	/*!< @brief Schema option converting the CBR timestamp. */
+#define SUNSET_CBR_NUM_OPTIONS		1
 
 /*!< \brief This class is responsable for the conversion of the CBR header information into a stream of bytes. */
 
@@ -60,7 +64,7 @@ public:
 	virtual int getDst(int level, Packet* p, sunset_header_type m, int& dst);
 	
 	/*! @brief The getName prints the packet header converter name.*/
-	virtual void getName() { Sunset_Debug::debugInfo(3, -1, "Sunset_CbrPktConverter"); }
+	virtual void getName() { SUNSET_DEBUG_LOG(3, -1, "Sunset_CbrPktConverter"); }
 	
 	/*! @brief The getPortBits returns the maximum number of bits to express the portNumber information. */
 	int getPortBits() { return PORT_BITS; }
@@ -69,6 +73,9 @@ public:
 	
 protected:
 	
+	/*! @brief The getSchemaOptions function returns the mask of the optional fields currently converted. */
+	int getSchemaOptions() { return (use_timestamp ? (1 << SUNSET_CBR_USE_TIMESTAMP) : 0); }
+	
 	int use_timestamp;
 	
 	int PORT_BITS;
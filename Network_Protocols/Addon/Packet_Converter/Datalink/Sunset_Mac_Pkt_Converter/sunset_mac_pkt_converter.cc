@@ -21,6 +21,44 @@
 
 #include <sunset_mac_pkt_converter.h>
 
+/*! @brief The fields of the converted MAC header, in the order they are written after the packet header converter ID. */
+
+struct Mac_Type : Sunset_Schema_Field<SUNSET_SCHEMA_FIXED, SUNSET_MAC_TYPE_BITS> {
+	
+	static uint64_t get(Packet* p) { return HDR_SUNSET_MAC(p)->dh_fc.fc_type; }
+	static void set(Packet* p, uint64_t v) { HDR_SUNSET_MAC(p)->dh_fc.fc_type = (u_char)v; }
+};
+
+struct Mac_Subtype : Sunset_Schema_Field<SUNSET_SCHEMA_FIXED, SUNSET_MAC_SUBTYPE_BITS> {
+	
+	static uint64_t get(Packet* p) { return HDR_SUNSET_MAC(p)->dh_fc.fc_subtype; }
+	static void set(Packet* p, uint64_t v) { HDR_SUNSET_MAC(p)->dh_fc.fc_subtype = (u_char)v; }
+};
+
+struct Mac_Src : Sunset_Schema_Field<SUNSET_SCHEMA_ADDR, 0, SUNSET_MAC_USE_SOURCE> {
+	
+	static uint64_t get(Packet* p) { return (uint32_t)HDR_SUNSET_MAC(p)->src; }
+	static void set(Packet* p, uint64_t v) { HDR_SUNSET_MAC(p)->src = (int)v; }
+	static void absent(Packet* p) { HDR_SUNSET_MAC(p)->src = 0; }
+};
+
+struct Mac_Dst : Sunset_Schema_Field<SUNSET_SCHEMA_ADDR, 0, SUNSET_MAC_USE_DEST> {
+	
+	static uint64_t get(Packet* p) { return (uint32_t)HDR_SUNSET_MAC(p)->dst; }
+	static void set(Packet* p, uint64_t v) { HDR_SUNSET_MAC(p)->dst = (int)v; }
+	static void absent(Packet* p) { HDR_SUNSET_MAC(p)->dst = 0; }
+};
+
+struct Mac_PktId : Sunset_Schema_Field<SUNSET_SCHEMA_PKT_ID, 0, SUNSET_MAC_USE_PKT_ID> {
+	
+	static uint64_t get(Packet* p) { return HDR_SUNSET_MAC(p)->pktId; }
+	static void set(Packet* p, uint64_t v) { HDR_SUNSET_MAC(p)->pktId = (u_int16_t)v; }
+};
+
+typedef Sunset_Schema<Mac_Type, Mac_Subtype, Mac_Src, Mac_Dst, Mac_PktId> Sunset_Mac_Schema;
+
+static Sunset_Schema_Codec<Sunset_Mac_Schema, SUNSET_MAC_NUM_OPTIONS> macSchema;
+
 /*!
  * 	@brief This static class is a hook class used to instantiate a C++ object from the TCL script. 
  *	It also allows to define parameter values using the bind function in the class constructor.
@@ -44,14 +82,14 @@ Sunset_MacPktConverter::Sunset_MacPktConverter()
 	use_dest = 0;
 	use_pktId = 0;
 	
-	TYPE_BITS = 2; 		//set according to MAC packet header
-	SUBTYPE_BITS = 4;	//set according to MAC packet header
+	TYPE_BITS = SUNSET_MAC_TYPE_BITS;
+	SUBTYPE_BITS = SUNSET_MAC_SUBTYPE_BITS;
 	
 	bind("use_source", &use_source);
 	bind("use_pktId", &use_pktId);
 	bind("use_dest", &use_dest);
 	
-	Sunset_Debug::debugInfo(5, -1, "Sunset_MacPktConverter CREATED");
+	SUNSET_DEBUG_LOG(5, -1, "Sunset_MacPktConverter CREATED");
 }
 
 /*!
@@ -67,7 +105,7 @@ int Sunset_MacPktConverter::checkPktLevel(Packet* p)
 	u_int8_t  type = mh->dh_fc.fc_type;
 	u_int8_t  subtype = mh->dh_fc.fc_subtype;
 	
-	Sunset_Debug::debugInfo(5, -1, "Sunset_MacPktConverter::checkPktLevel");
+	SUNSET_DEBUG_LOG(5, -1, "Sunset_MacPktConverter::checkPktLevel");
 	
 	/* I check if the type and subtype of the packet are MAC types */
 	
@@ -100,7 +138,7 @@ int Sunset_MacPktConverter::command( int argc, const char*const* argv )
 			
 			use_source = atoi(argv[2]);
 			
-			Sunset_Debug::debugInfo(5, -1, "Sunset_MacPktConverter::command use_source %d", use_source);
+			SUNSET_DEBUG_LOG(5, -1, "Sunset_MacPktConverter::command use_source %d", use_source);
 			
 			return TCL_OK;
 		}
@@ -111,7 +149,7 @@ int Sunset_MacPktConverter::command( int argc, const char*const* argv )
 			
 			use_dest = atoi(argv[2]);
 			
-			Sunset_Debug::debugInfo(5, -1, "Sunset_MacPktConverter::command use_dest %d", use_dest);
+			SUNSET_DEBUG_LOG(5, -1, "Sunset_MacPktConverter::command use_dest %d", use_dest);
 
 			return TCL_OK;
 		}
@@ -122,7 +160,7 @@ int Sunset_MacPktConverter::command( int argc, const char*const* argv )
 			
 			use_pktId = atoi(argv[2]);
 			
-			Sunset_Debug::debugInfo(5, -1, "Sunset_MacPktConverter::command use_pktId %d", use_pktId);
+			SUNSET_DEBUG_LOG(5, -1, "Sunset_MacPktConverter::command use_pktId %d", use_pktId);
 
 			return TCL_OK;
 		}
@@ -153,28 +191,11 @@ int Sunset_MacPktConverter::getConvertedInfoLength(Packet* p)
 	
 	len += getLevelIdBits(); // packet header converter ID bits
 	
-	//control information in the mac packet header
-	len += TYPE_BITS;
-	len += SUBTYPE_BITS;
-	
 	// According to the used header values, the corresponding number of bits needed during the conversion process is computed 
 	
-	if (use_source) {
-		
-		len += getAddrBits(); //source id
-	}
+	len += macSchema.length(getSchemaOptions(), sunset_schema_widths(this));
 	
-	if (use_dest) {
-		
-		len += getAddrBits(); //dest id
-	}
-	
-	if (use_pktId) {
-		
-		len += getPktIdBits(); //pkt id
-	}
-	
-	Sunset_Debug::debugInfo(5, -1, "Sunset_MacPktConverter::getConvertedInfoLength size %d", len);
+	SUNSET_DEBUG_LOG(5, -1, "Sunset_MacPktConverter::getConvertedInfoLength size %d", len);
 	
 	return len;
 }
@@ -206,7 +227,7 @@ int Sunset_MacPktConverter::checkPktSubType(int pkt_sub_type)
 			return 1;
 			
 		default:
-			Sunset_Debug::debugInfo(-1, -1, "Sunset_MacPktConverter::checkPktSubType invalid MAC Control Subtype %d ERROR", pkt_sub_type);
+			SUNSET_DEBUG_LOG(-1, -1, "Sunset_MacPktConverter::checkPktSubType invalid MAC Control Subtype %d ERROR", pkt_sub_type);
 			
 			return 0;   //TODO: it's just to avoid exiting the simulation
 	}
@@ -254,14 +275,14 @@ int Sunset_MacPktConverter::createMiniPkt(int level, Packet* p, sunset_header_ty
 	
 	if (src > maxId || dst > maxId) {
 		
-		Sunset_Debug::debugInfo(-1, -1, "Sunset_MacPktConverter::createMiniPkt ERROR src %d dst %d maxId %d", src, dst, maxId);
+		SUNSET_DEBUG_LOG(-1, -1, "Sunset_MacPktConverter::createMiniPkt ERROR src %d dst %d maxId %d", src, dst, maxId);
 		
 		ch->error() = 1;
 	}
 	
 	if (checkPktSubType(pkt_sub_type) != 1) {
 		
-		Sunset_Debug::debugInfo(-1, -1, "Sunset_MacPktConverter::createMiniPkt ERROR pkt_sub_type %d", pkt_sub_type);	
+		SUNSET_DEBUG_LOG(-1, -1, "Sunset_MacPktConverter::createMiniPkt ERROR pkt_sub_type %d", pkt_sub_type);	
 		
 		ch->error() = 1;
 	}
@@ -290,7 +311,7 @@ int Sunset_MacPktConverter::createMiniPkt(int level, Packet* p, sunset_header_ty
 	/* calculate ack duration */
  	dh->dh_duration = 0;	
 	
-	Sunset_Debug::debugInfo(2, -1, "Sunset_MacPktConverter::createMiniPkt");
+	SUNSET_DEBUG_LOG(2, -1, "Sunset_MacPktConverter::createMiniPkt");
 	
 	return 1;
 }
@@ -408,6 +429,7 @@ int Sunset_MacPktConverter::pkt2Buffer(int level, Packet* p, char* buffer, int o
 {
 	int aux = 0;
 	int size = 0;
+	Sunset_Bit_Writer w(buffer, offset);
 	
 	aux = getConvertedInfoLength(p); // get the number of bits that have to be written by this packet header converter
 	
@@ -416,51 +438,26 @@ int Sunset_MacPktConverter::pkt2Buffer(int level, Packet* p, char* buffer, int o
 		return 0;
 	}
 	
-	u_int8_t type = HDR_SUNSET_MAC(p)->dh_fc.fc_type;
-	u_int8_t subtype = HDR_SUNSET_MAC(p)->dh_fc.fc_subtype;
-	
-	size = getLevelIdBits();
-	
 	// information about the packet header converter ID has to be always written to allow for correct conversion
 	
-	setBits(buffer, (char *)(&(level)), size, offset);
-	
-	setBits(buffer, (char *)(&type), TYPE_BITS, offset + size);
-	size += TYPE_BITS;
-	
-	setBits(buffer, (char *)(&subtype), SUBTYPE_BITS, offset + size);
-	size += SUBTYPE_BITS;
+	w.put((uint32_t)level, getLevelIdBits());
 	
 	// According to the used header values, the corresponding number of bits needed during the conversion process is written 
 	
-	if (use_source) {
-		
-		setBits(buffer, (char *)(&(HDR_SUNSET_MAC(p)->src)), getAddrBits(), offset + size);
-		size += getAddrBits();
-	}
-	
-	if (use_dest) {
-		
-		setBits(buffer, (char *)(&(HDR_SUNSET_MAC(p)->dst)), getAddrBits(), offset + size);
-		size += getAddrBits();
-	}
+	macSchema.encode(getSchemaOptions(), p, w, sunset_schema_widths(this));
 	
-	if (use_pktId) {
-		
-		setBits(buffer, (char *)(&(HDR_SUNSET_MAC(p)->pktId)), getPktIdBits(), offset + size);
-		size += getPktIdBits();
-	}
+	size = w.getPosition() - offset;
 	
 	// if less bits are written w.r.t. the ones computed using the getConvertedInfoLength an error occurrs and 0 bits are added to the packet
 	if (aux != size) {
 		
-		Sunset_Debug::debugInfo(-1, -1, "Sunset_AgtPktConverter::pkt2Buffer buffer filled ERROR aux %d size %d bits", aux, size);
+		SUNSET_DEBUG_LOG(-1, -1, "Sunset_MacPktConverter::pkt2Buffer buffer filled ERROR aux %d size %d bits", aux, size);
+		
 		return -1;
-		exit(1);
 	}
 	
-	Sunset_Debug::debugInfo(5, -1, "Sunset_MacPktConverter::pkt2Buffer buffer filled size %d bits", size);
-	Sunset_Debug::debugInfo(3, -1, "Sunset_MacPktConverter::pkt2Buffer MAC type %d subtype %d version %d duration %d src %d dst %d", HDR_SUNSET_MAC(p)->dh_fc.fc_type, HDR_SUNSET_MAC(p)->dh_fc.fc_subtype, HDR_SUNSET_MAC(p)->dh_fc.fc_protocol_version, HDR_SUNSET_MAC(p)->dh_duration, HDR_SUNSET_MAC(p)->src, HDR_SUNSET_MAC(p)->dst, HDR_SUNSET_MAC(p)->pktId);
+	SUNSET_DEBUG_LOG(5, -1, "Sunset_MacPktConverter::pkt2Buffer buffer filled size %d bits", size);
+	SUNSET_DEBUG_LOG(3, -1, "Sunset_MacPktConverter::pkt2Buffer MAC type %d subtype %d version %d duration %d src %d dst %d", HDR_SUNSET_MAC(p)->dh_fc.fc_type, HDR_SUNSET_MAC(p)->dh_fc.fc_subtype, HDR_SUNSET_MAC(p)->dh_fc.fc_protocol_version, HDR_SUNSET_MAC(p)->dh_duration, HDR_SUNSET_MAC(p)->src, HDR_SUNSET_MAC(p)->dst, HDR_SUNSET_MAC(p)->pktId);
 	
 	return size;
 }
@@ -479,24 +476,25 @@ int Sunset_MacPktConverter::buffer2Pkt(int level, Packet* p, char* buffer, int o
 {
 	int info_level = 0;
 	int size = getLevelIdBits();
+	Sunset_Bit_Reader r(buffer, offset);
 	
 	// check if there are enough bits to read the packet header converter ID
 	
 	if (bits < size) {
 		
-		Sunset_Debug::debugInfo(5, -1, "Sunset_MacPktConverter::buffer2Pkt check bits1 bits %d size %d", bits, size);
+		SUNSET_DEBUG_LOG(5, -1, "Sunset_MacPktConverter::buffer2Pkt check bits1 bits %d size %d", bits, size);
 		return 0;
 	}
 	
 	// read the packet header converter ID
 	
-	getBits(buffer, (char *)(&(info_level)), size, offset);
+	info_level = (int)r.get(size);
 	
 	// check if the packet header converter ID corresponds to my ID
 	
 	if (info_level != level) {
 		
-		Sunset_Debug::debugInfo(5, -1, "Sunset_MacPktConverter::buffer2Pkt info_level %d level %d level_bits %d", 
+		SUNSET_DEBUG_LOG(5, -1, "Sunset_MacPktConverter::buffer2Pkt info_level %d level %d level_bits %d", 
 					info_level, level, getLevelIdBits());
 
 		return 0;
@@ -506,49 +504,19 @@ int Sunset_MacPktConverter::buffer2Pkt(int level, Packet* p, char* buffer, int o
 	
 	if (bits < getHeaderSizeBits()) {
 		
-		Sunset_Debug::debugInfo(5, -1, "Sunset_MacPktConverter::buffer2Pkt check bits2 bits %d size %d", bits, getHeaderSizeBits());
+		SUNSET_DEBUG_LOG(5, -1, "Sunset_MacPktConverter::buffer2Pkt check bits2 bits %d size %d", bits, getHeaderSizeBits());
 		
 		return -1;
 	}
 	
-	HDR_SUNSET_MAC(p)->src = 0;
-	HDR_SUNSET_MAC(p)->dst = 0;
-	
-	u_int8_t type = 0;
-	HDR_SUNSET_MAC(p)->dh_fc.fc_type = 0;
-	u_int8_t subtype = 0;
-	HDR_SUNSET_MAC(p)->dh_fc.fc_subtype = 0;
+	// According to the used header values, the corresponding number of bits needed during the conversion process is read 
 	
-	getBits(buffer, (char *)(&type), TYPE_BITS, offset + size);
-	size += TYPE_BITS;
-	HDR_SUNSET_MAC(p)->dh_fc.fc_type = type;
+	macSchema.decode(getSchemaOptions(), p, r, sunset_schema_widths(this));
 	
-	getBits(buffer, (char *)(&subtype), SUBTYPE_BITS, offset + size);
-	size += SUBTYPE_BITS;
-	HDR_SUNSET_MAC(p)->dh_fc.fc_subtype = subtype;
-	
-	// According to the used header values, the corresponding number of bits needed during the conversion process is written 
-	
-	if (use_source) {
-		
-		getBits(buffer, (char *)(&(HDR_SUNSET_MAC(p)->src)), getAddrBits(), offset + size);
-		size += getAddrBits();
-	}
-	
-	if (use_dest) {
-		
-		getBits(buffer, (char *)(&(HDR_SUNSET_MAC(p)->dst)), getAddrBits(), offset + size);
-		size += getAddrBits();
-	}
-	
-	if (use_pktId) {
-		
-		getBits(buffer, (char *)(&(HDR_SUNSET_MAC(p)->pktId)), getPktIdBits(), offset + size);
-		size += getPktIdBits();
-	}
+	size = r.getPosition() - offset;
 	
-	Sunset_Debug::debugInfo(3, -1, "Sunset_MacPktConverter::buffer2PktMAC type %d subtype %d version %d duration %d src %d dst %d", HDR_SUNSET_MAC(p)->dh_fc.fc_type, HDR_SUNSET_MAC(p)->dh_fc.fc_subtype, HDR_SUNSET_MAC(p)->dh_fc.fc_protocol_version, HDR_SUNSET_MAC(p)->dh_duration, HDR_SUNSET_MAC(p)->src, HDR_SUNSET_MAC(p)->dst, HDR_SUNSET_MAC(p)->pktId);
-	Sunset_Debug::debugInfo(5, -1, "Sunset_MacPktConverter::buffer2Pkt agent info for the packet have been set %d Bits", size);
+	SUNSET_DEBUG_LOG(3, -1, "Sunset_MacPktConverter::buffer2PktMAC type %d subtype %d version %d duration %d src %d dst %d", HDR_SUNSET_MAC(p)->dh_fc.fc_type, HDR_SUNSET_MAC(p)->dh_fc.fc_subtype, HDR_SUNSET_MAC(p)->dh_fc.fc_protocol_version, HDR_SUNSET_MAC(p)->dh_duration, HDR_SUNSET_MAC(p)->src, HDR_SUNSET_MAC(p)->dst, HDR_SUNSET_MAC(p)->pktId);
+	SUNSET_DEBUG_LOG(5, -1, "Sunset_MacPktConverter::buffer2Pkt agent info for the packet have been set %d Bits", size);
 	
 	return size;
 }
@@ -575,8 +543,8 @@ int Sunset_MacPktConverter::buffer2Pkt(int level, int src, int dst, Packet* p, c
 	HDR_SUNSET_MAC(p)->src = src;
 	HDR_SUNSET_MAC(p)->dst = dst;
 	
-	Sunset_Debug::debugInfo(5, -1, "Sunset_MacPktConverter::buffer2PktMAC_2 type %d subtype %d version %d duration %d src %d dst %d", HDR_SUNSET_MAC(p)->dh_fc.fc_type, HDR_SUNSET_MAC(p)->dh_fc.fc_subtype, HDR_SUNSET_MAC(p)->dh_fc.fc_protocol_version, HDR_SUNSET_MAC(p)->dh_duration, HDR_SUNSET_MAC(p)->src, HDR_SUNSET_MAC(p)->dst);
-	Sunset_Debug::debugInfo(5, -1, "Sunset_MacPktConverter::buffer2PktMAC_2 agent info for the packet have been set %d Bits", size);
+	SUNSET_DEBUG_LOG(5, -1, "Sunset_MacPktConverter::buffer2PktMAC_2 type %d subtype %d version %d duration %d src %d dst %d", HDR_SUNSET_MAC(p)->dh_fc.fc_type, HDR_SUNSET_MAC(p)->dh_fc.fc_subtype, HDR_SUNSET_MAC(p)->dh_fc.fc_protocol_version, HDR_SUNSET_MAC(p)->dh_duration, HDR_SUNSET_MAC(p)->src, HDR_SUNSET_MAC(p)->dst);
+	SUNSET_DEBUG_LOG(5, -1, "Sunset_MacPktConverter::buffer2PktMAC_2 agent info for the packet have been set %d Bits", size);
 	
 	return size;
 }
@@ -669,6 +637,6 @@ void Sunset_MacPktConverter::start()
 {	
 	Sunset_PktConverter::start();
 	assignNsPktType(PT_SUNSET_MAC);
-	Sunset_Debug::debugInfo(5, -1, "Sunset_MacPktConverter::start");
+	SUNSET_DEBUG_LOG(5, -1, "Sunset_MacPktConverter::start");
 }
 
@@ -23,8 +23,17 @@
 #define __Sunset_MacPktConverter_h__
 
 #include <sunset_pkt_converter.h>
+#include <sunset_pkt_schema.h>
 #include <sunset_mac_pkt.h>
 
+#define SUNSET_MAC_TYPE_BITS		2	/*!< @brief Bits of the MAC packet type, set according to MAC packet header. */
+#define SUNSET_MAC_SUBTYPE_BITS		4	/*!< @brief Bits of the MAC packet subtype, set according to MAC packet header. */
+
+#define SUNSET_MAC_USE_SOURCE		0	/*!< @brief Schema option converting the MAC source ID. */
+#define SUNSET_MAC_USE_DEST		1	/*!< @brief Schema option converting the MAC destination ID. */
+#define SUNSET_MAC_USE_PKT_ID		2	/*!< @brief Schema option converting the MAC packet ID. */
+#define SUNSET_MAC_NUM_OPTIONS		3
+
 /*!< \brief This class extends the packet converter class and it is responsable for the conversion of the MAC headers information into a stream of bytes for the external devices and vice versa. */
 
 class Sunset_MacPktConverter : public Sunset_PktConverter {
@@ -52,13 +61,17 @@ public:
 	virtual int getPktType(int level, Packet* p, sunset_header_type m, int& type);
 	
 	/*! @brief The getName prints the packet header converter name.*/
-	virtual void getName() { Sunset_Debug::debugInfo(5, -1, "Sunset_MacPktConverter"); }
+	virtual void getName() { SUNSET_DEBUG_LOG(5, -1, "Sunset_MacPktConverter"); }
 	
 	virtual void start(); //initialize module variable and interaction with othe modules
 	
 protected:
 	
 	virtual int checkPktSubType(int pkt_sub_type);
+	
+	/*! @brief The getSchemaOptions function returns the mask of the optional fields currently converted. */
+	int getSchemaOptions() { return (use_source ? (1 << SUNSET_MAC_USE_SOURCE) : 0) | (use_dest ? (1 << SUNSET_MAC_USE_DEST) : 0) | (use_pktId ? (1 << SUNSET_MAC_USE_PKT_ID) : 0); }
+	
 	int use_source;
 	int use_dest;
 	int use_pktId;
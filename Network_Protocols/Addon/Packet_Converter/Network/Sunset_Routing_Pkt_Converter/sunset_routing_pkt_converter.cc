@@ -47,7 +47,7 @@ public:
 
 int Sunset_RtgPktConverter::getHeaderSizeBits() 
 { 
-	Sunset_Debug::debugInfo(5, -1, "Sunset_RtgPktConverter::getHeaderSizeBits return 0");
+	SUNSET_DEBUG_LOG(5, -1, "Sunset_RtgPktConverter::getHeaderSizeBits return 0");
 	
 	return 0; 
 }
@@ -128,5 +128,5 @@ void Sunset_RtgPktConverter::start()
 {	
 	Sunset_PktConverter::start();
 	assignNsPktType(PT_SUNSET_RTG);
-	Sunset_Debug::debugInfo(5, -1, "Sunset_RtgPktConverter::start");
+	SUNSET_DEBUG_LOG(5, -1, "Sunset_RtgPktConverter::start");
 }
@@ -40,7 +40,7 @@ public:
 	virtual int buffer2Pkt(int level, int src, int dst, Packet* p, char* buffer, int offset, int bits);
 	
 	/*! @brief The getName prints the packet header converter name. */
-	virtual void getName() { Sunset_Debug::debugInfo(5, -1, "Sunset_RtgPktConverter"); }
+	virtual void getName() { SUNSET_DEBUG_LOG(5, -1, "Sunset_RtgPktConverter"); }
 	
 	virtual void start(); //initialize module variable and interaction with othe modules
 	
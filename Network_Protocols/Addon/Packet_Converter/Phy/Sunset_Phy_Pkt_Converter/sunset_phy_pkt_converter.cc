@@ -43,7 +43,7 @@ public:
 
 int Sunset_PhyPktConverter::getHeaderSizeBits() 
 { 
-    	Sunset_Debug::debugInfo(5, -1, "Sunset_PhyPktConverter::getHeaderSizeBits return 0");
+    	SUNSET_DEBUG_LOG(5, -1, "Sunset_PhyPktConverter::getHeaderSizeBits return 0");
 	
 	return 0; 
 };
@@ -1,3 +1,6 @@
 # Dummy Initialization
 
-Sunset_Protocol_Statistics set binaryOutput_ 0
\ No newline at end of file
+Sunset_Protocol_Statistics set binaryOutput_ 0
+Sunset_Protocol_Statistics set asyncLog_ 1
+Sunset_Protocol_Statistics set flushSize_ 65536
+Sunset_Protocol_Statistics set flushInterval_ 1.0
@@ -51,6 +51,9 @@ Sunset_Protocol_Statistics::Sunset_Protocol_Statistics() : Sunset_Statistics()
 	start_traffic = 0.0;
 	run_id = 0;
 	binaryOutput = 0;
+	asyncLog = 1;
+	flushSize = STAT_WRITER_BLOCK_SIZE;
+	flushInterval = STAT_WRITER_FLUSH_INTERVAL;
 	
 	stop_time = 0.0;
 	start_time = 0.0;
@@ -58,6 +61,40 @@ Sunset_Protocol_Statistics::Sunset_Protocol_Statistics() : Sunset_Statistics()
 	max_node_id = 0;
 	
 	bind("binaryOutput_", &binaryOutput);
+	bind("asyncLog_", &asyncLog);
+	bind("flushSize_", &flushSize);
+	bind("flushInterval_", &flushInterval);
+}
+
+/*!
+ * 	@brief The getExportFormat function converts the format name used in the TCL script ("csv", "json" or "dict") 
+ *	into the corresponding sunset_statExportFormat value.
+ *	@retval true If the format is supported, false otherwise.
+ */
+static bool getExportFormat(const char* name, sunset_statExportFormat& format) 
+{
+	if (strcmp(name, "csv") == 0) {
+		
+		format = SUNSET_STAT_EXPORT_CSV;
+		
+		return true;
+	}
+	
+	if (strcmp(name, "json") == 0) {
+		
+		format = SUNSET_STAT_EXPORT_JSON;
+		
+		return true;
+	}
+	
+	if (strcmp(name, "dict") == 0) {
+		
+		format = SUNSET_STAT_EXPORT_DICT;
+		
+		return true;
+	}
+	
+	return false;
 }
 
 /*!
@@ -284,6 +321,28 @@ int Sunset_Protocol_Statistics::command( int argc, const char*const* argv )
 	}
 	else if ( argc == 3 ) {
 		
+		/* The "exportMetrics" command returns all the per-link and per-node metrics computed in a single pass, 
+		 * using the given format (csv, json or dict). With dict the result can be directly used with the Tcl dict commands. */
+		
+		if (strcmp(argv[1], "exportMetrics") == 0) {
+			
+			sunset_statExportFormat format;
+			string out;
+			
+			if (!getExportFormat(argv[2], format)) {
+				
+				tcl.resultf("exportMetrics: unknown format %s (csv, json or dict)", argv[2]);
+				
+				return TCL_ERROR;
+			}
+			
+			exportMetrics(format, out);
+			
+			Tcl_SetResult(tcl.interp(), (char*)out.c_str(), TCL_VOLATILE);
+			
+			return TCL_OK;
+		}
+		
 		if (strcmp(argv[1], "setOutputFile") == 0) {
 		
 			memset(fileOut, '\0', FILE_NAME);
@@ -335,6 +394,27 @@ int Sunset_Protocol_Statistics::command( int argc, const char*const* argv )
 			return TCL_OK;
 		}
 		
+		if (strcmp(argv[1], "setAsyncLog") == 0) {
+			
+			asyncLog = atoi(argv[2]);
+			
+			return TCL_OK;
+		}
+		
+		if (strcmp(argv[1], "setFlushSize") == 0) {
+			
+			flushSize = atoi(argv[2]);
+			
+			return TCL_OK;
+		}
+		
+		if (strcmp(argv[1], "setFlushInterval") == 0) {
+			
+			flushInterval = atof(argv[2]);
+			
+			return TCL_OK;
+		}
+		
 		if (strcmp(argv[1], "setTotalEnergy") == 0) {
 		
 			totalEnergy = atof(argv[2]);
@@ -441,6 +521,39 @@ int Sunset_Protocol_Statistics::command( int argc, const char*const* argv )
 	}
 	else if ( argc == 4 ) {
 		
+		/* The "exportMetrics" command writes all the per-link and per-node metrics, computed in a single pass, 
+		 * in the given file using the given format (csv, json or dict). */
+		
+		if (strcmp(argv[1], "exportMetrics") == 0) {
+			
+			sunset_statExportFormat format;
+			ofstream exportFile;
+			string out;
+			
+			if (!getExportFormat(argv[2], format)) {
+				
+				tcl.resultf("exportMetrics: unknown format %s (csv, json or dict)", argv[2]);
+				
+				return TCL_ERROR;
+			}
+			
+			exportFile.open(argv[3], ios::out | ios::trunc);
+			
+			if (!exportFile.is_open()) {
+				
+				SUNSET_DEBUG_LOG(-1, -1, "Sunset_Protocol_Statistics::exportMetrics ERROR opening file %s", argv[3]);
+				
+				return TCL_ERROR;
+			}
+			
+			exportMetrics(format, out);
+			
+			exportFile.write(out.c_str(), out.size());
+			exportFile.close();
+			
+			return TCL_OK;
+		}
+		
 		int src = atoi(argv[2]);
 		int dst = atoi(argv[3]);
 
@@ -614,12 +727,24 @@ void Sunset_Protocol_Statistics::start()
 	
 	if (!outFile.is_open()) {
 		
-		Sunset_Debug::debugInfo(-1, -1, "Sunset_Protocol_Statistics::start outputFile %s cannot be opened ERROR", fileOut);
+		SUNSET_DEBUG_LOG(-1, -1, "Sunset_Protocol_Statistics::start outputFile %s cannot be opened ERROR", fileOut);
 
 		return;
 	}
 	
-	Sunset_Debug::debugInfo(-1, -1, "Sunset_Protocol_Statistics::start useStat %d path %s", useStat, fileOut);
+	SUNSET_DEBUG_LOG(-1, -1, "Sunset_Protocol_Statistics::start useStat %d path %s", useStat, fileOut);
+	
+	if (binaryOutput) {
+		
+		char header[SUNSET_TRACE_FILE_HEADER_SIZE];
+		
+		outFile.write(header, Sunset_Trace_Encoder::encodeFileHeader(header));
+	}
+	
+	if (asyncLog) {
+		
+		statWriter.start(&outFile, flushSize, flushInterval);
+	}
 	
 	if (Sunset_Utilities::isSimulation()) {
 
@@ -641,6 +766,13 @@ void Sunset_Protocol_Statistics::stop()
 		return;
 	}
 	
+	if (binaryOutput && outFile.is_open()) {
+		
+		writeTraceMeta();
+	}
+	
+	statWriter.stop();	// write all the pending records
+	
 	if (Sunset_Utilities::isEmulation()) {
 		
 		return;
@@ -648,13 +780,13 @@ void Sunset_Protocol_Statistics::stop()
 	
 	if (!outFile.is_open()) {
 		
-		Sunset_Debug::debugInfo(-1, -1,"Sunset_Protocol_Statistics::stop outputFile %s was not opened ERROR", fileOut);
+		SUNSET_DEBUG_LOG(-1, -1,"Sunset_Protocol_Statistics::stop outputFile %s was not opened ERROR", fileOut);
 		
 		return;
 	}
 
 	outFile.close();
-	Sunset_Debug::debugInfo(5, -1, "Sunset_Protocol_Statistics::stop useStat %d path %s isOpen %d", useStat, fileOut, outFile.is_open());
+	SUNSET_DEBUG_LOG(5, -1, "Sunset_Protocol_Statistics::stop useStat %d path %s isOpen %d", useStat, fileOut, outFile.is_open());
 	
 	if (Sunset_Utilities::isSimulation()) {
 		
@@ -724,7 +856,7 @@ sunset_statisticPktType Sunset_Protocol_Statistics::pktType(Packet *p)
 						break;
 					
 					default:
-						Sunset_Debug::debugInfo(-1, -1, "Sunset_Protocol_Statistics::pktType recvTimer2:Invalid MAC Control Subtype %x ERROR", subtype);
+						SUNSET_DEBUG_LOG(-1, -1, "Sunset_Protocol_Statistics::pktType recvTimer2:Invalid MAC Control Subtype %x ERROR", subtype);
 						
 						return SUNSET_STAT_NONE;
 				}
@@ -735,7 +867,7 @@ sunset_statisticPktType Sunset_Protocol_Statistics::pktType(Packet *p)
 				return SUNSET_STAT_DATA;
 			
 			default:
-				Sunset_Debug::debugInfo(-1, -1, "Sunset_Protocol_Statistics::pktType recvTimer3:Invalid MAC Control Subtype %x ERROR", subtype);
+				SUNSET_DEBUG_LOG(-1, -1, "Sunset_Protocol_Statistics::pktType recvTimer3:Invalid MAC Control Subtype %x ERROR", subtype);
 				
 				return SUNSET_STAT_NONE;
 		}
@@ -750,12 +882,12 @@ sunset_statisticPktType Sunset_Protocol_Statistics::pktType(Packet *p)
 	}
 	else if (pType == -1) {
 		
-		Sunset_Debug::debugInfo(-1, -1, "Sunset_Protocol_Statistics::pktType STAT_NONE pkt");
+		SUNSET_DEBUG_LOG(-1, -1, "Sunset_Protocol_Statistics::pktType STAT_NONE pkt");
 		
 		return SUNSET_STAT_NONE;
 	}
 	else {
-		Sunset_Debug::debugInfo(-1, -1, "Sunset_Protocol_Statistics::pktType recvTimer4:Invalid MAC Control Subtype %x ERROR", pType);
+		SUNSET_DEBUG_LOG(-1, -1, "Sunset_Protocol_Statistics::pktType recvTimer4:Invalid MAC Control Subtype %x ERROR", pType);
 		
 		return SUNSET_STAT_NONE;
 	}
@@ -776,7 +908,6 @@ sunset_statisticPktType Sunset_Protocol_Statistics::pktType(Packet *p)
  */
 void Sunset_Protocol_Statistics::logStatInfo(sunset_statisticType sType, u_int16_t node, Packet*p, double time, const char *fmt, ...) 
 {
-	char command[STAT_MAX_BUF];
 	sunset_statisticPktType spktType = SUNSET_STAT_NONE;
 	int agt_src = 0;
 	int agt_dst = 0;
@@ -792,8 +923,6 @@ void Sunset_Protocol_Statistics::logStatInfo(sunset_statisticType sType, u_int16
 
 	Tcl& tcl = Tcl::instance();
 
-	memset(command, '\0', STAT_MAX_BUF);
-	
 	if (!useStat) {
 		
 		return;
@@ -818,6 +947,8 @@ void Sunset_Protocol_Statistics::logStatInfo(sunset_statisticType sType, u_int16
 		}		
 	}
 	
+	memset(&st, 0, sizeof(statInfo));
+	
 	switch ( sType ) {
 			
 		case SUNSET_STAT_ENERGY_TX: 
@@ -831,6 +962,19 @@ void Sunset_Protocol_Statistics::logStatInfo(sunset_statisticType sType, u_int16
 			
 			setTxDuration(node, watt, txPower, sec);
 			
+			if (binaryOutput) {
+				
+				double energy[SUNSET_TRACE_ENERGY_VALUES] = {watt, txPower, sec};
+				
+				st.sType = sType;
+				st.spktType = SUNSET_STAT_NONE;
+				st.realTime = Sunset_Utilities::get_epoch();
+				st.time = time;
+				st.node = node;
+				
+				logTraceRecord(st, 0, 0, energy);
+			}
+			
 			return;
 		}
 			
@@ -844,6 +988,19 @@ void Sunset_Protocol_Statistics::logStatInfo(sunset_statisticType sType, u_int16
 			
 			setRxDuration(node, rxPower, sec);
 			
+			if (binaryOutput) {
+				
+				double energy[SUNSET_TRACE_ENERGY_VALUES] = {rxPower, sec, 0.0};
+				
+				st.sType = sType;
+				st.spktType = SUNSET_STAT_NONE;
+				st.realTime = Sunset_Utilities::get_epoch();
+				st.time = time;
+				st.node = node;
+				
+				logTraceRecord(st, 0, 0, energy);
+			}
+			
 			return;
 		}
 			
@@ -857,6 +1014,19 @@ void Sunset_Protocol_Statistics::logStatInfo(sunset_statisticType sType, u_int16
 			
 			setIdleDuration(node, idlePower, sec);
 			
+			if (binaryOutput) {
+				
+				double energy[SUNSET_TRACE_ENERGY_VALUES] = {idlePower, sec, 0.0};
+				
+				st.sType = sType;
+				st.spktType = SUNSET_STAT_NONE;
+				st.realTime = Sunset_Utilities::get_epoch();
+				st.time = time;
+				st.node = node;
+				
+				logTraceRecord(st, 0, 0, energy);
+			}
+			
 			return;
 		}
 			
@@ -905,57 +1075,149 @@ void Sunset_Protocol_Statistics::logStatInfo(sunset_statisticType sType, u_int16
 		
 		va_list ap;
 		va_start(ap, fmt);
-		char* stPtr;
+		char* buf = 0;
+		int len = 0;
 		int size = 0;
 		
+		/* The record is formatted directly in the buffer of the calling thread, the writer thread
+		 * takes care of writing it on file. No lock is taken on the file and no memory is allocated. */
+		
 		if (binaryOutput) {
 			
-			int len = 0;
-			
-			vsprintf(command, fmt, ap);
+			char info[STAT_MAX_BUF];
 			
-			len = strlen(command);
-			size = (int)(sizeof(statInfo) + sizeof(int));
-			stPtr = (char*)malloc(size);
+			len = vsnprintf(info, STAT_MAX_BUF, fmt, ap);
 			
-			if ( stPtr == NULL ) {
+			if ( len < 0 ) {
 				
-				Sunset_Debug::debugInfo(-1, -1, "Sunset_Protocol_Statistics::logStatInfo MALLOC ERROR");
+				len = 0;
+			}
+			
+			if ( len > STAT_MAX_BUF - 1 ) {
 				
-				return;
+				len = STAT_MAX_BUF - 1;
 			}
 			
-			memset(stPtr, '\0', size);
-			memcpy(stPtr, (&size), sizeof(int)); 
-			memcpy(&(stPtr[sizeof(int)]), (char*)(&st), sizeof(statInfo)); 
+			va_end(ap);
+			
+			logTraceRecord(st, info, len, 0);
 		}
 		else {
-			sprintf(command, "%d %d %d %d %d %6.4f %d %d %d %d %d %6.4f %6.4f %6.4f", 
+			buf = statWriter.begin(STAT_MAX_BUF);
+			
+			size = snprintf(buf, STAT_MAX_BUF, "%d %d %d %d %d %6.4f %d %d %d %d %d %6.4f %6.4f %6.4f", 
 				(int)sType, agt_src, agt_dst, agt_pktId, spktType, realTime, node, src, dst, pkt_size, num_hop, time, rssi, lq);
 			
-			vsprintf(command + strlen(command), fmt, ap);
-			sprintf(command + strlen(command), "\n");
-		}
-		
-		if (Sunset_Utilities::isEmulation()) {
+			len = vsnprintf(buf + size, STAT_MAX_BUF - size - 1, fmt, ap);
 			
-			pthread_mutex_lock(&mutex_stat);
-		}
-		
-		outFile.write(stPtr, size);
-		outFile.write(command, (int)(strlen(command)));
-		
-		if (Sunset_Utilities::isEmulation()) {
+			if ( len < 0 ) {
+				
+				len = 0;
+			}
+			
+			if ( len > STAT_MAX_BUF - size - 2 ) {
+				
+				len = STAT_MAX_BUF - size - 2;
+			}
+			
+			buf[size + len] = '\n';
+			len++;
+			
+			va_end(ap);
 			
-			pthread_mutex_unlock(&mutex_stat);	
+			statWriter.end(size + len);
 		}
-		
-		outFile.flush();
 	}
 	
 	update_data(st);
 }
 
+/*!
+ * 	@brief The logTraceRecord function adds a record to the binary trace chunk, the chunk is encoded and handed to the
+ *		writer when full.
+ *	@param st The statistics information of the record.
+ *	@param info The additional information of the record, if any.
+ *	@param infoLen The length of the additional information.
+ *	@param energy The values of an energy record, 0 for the other records.
+ */
+
+void Sunset_Protocol_Statistics::logTraceRecord(statInfo& st, const char* info, int infoLen, const double* energy) 
+{
+	sunset_trace_record r;
+	
+	r.stat_type = (int)st.sType;
+	r.pkt_type = (int)st.spktType;
+	r.real_time = st.realTime;
+	r.time = st.time;
+	r.node = st.node;
+	r.src = st.src;
+	r.dst = st.dst;
+	r.agt_src = st.agt_src;
+	r.agt_dst = st.agt_dst;
+	r.agt_pkt_id = st.agt_pktId;
+	r.pkt_size = st.pkt_size;
+	r.num_hop = st.num_hop;
+	r.rssi = st.rssi;
+	r.link_quality = st.link_quality;
+	
+	pthread_mutex_lock(&mutex_stat);
+	
+	traceEncoder.add(r, info, infoLen, energy);
+	
+	if (traceEncoder.full()) {
+		
+		writeTraceChunk();
+	}
+	
+	pthread_mutex_unlock(&mutex_stat);
+}
+
+/*!
+ * 	@brief The writeTraceChunk function encodes the current chunk in the writer buffer. mutex_stat has to be held.
+ */
+
+void Sunset_Protocol_Statistics::writeTraceChunk() 
+{
+	char* buf = 0;
+	
+	if (traceEncoder.empty()) {
+		
+		return;
+	}
+	
+	buf = statWriter.begin(traceEncoder.maxEncodedSize());
+	
+	statWriter.end(traceEncoder.encode(buf));
+}
+
+/*!
+ * 	@brief The writeTraceMeta function writes the last chunk and the experiment information needed to process the binary trace.
+ */
+
+void Sunset_Protocol_Statistics::writeTraceMeta() 
+{
+	sunset_trace_meta meta;
+	char* buf = 0;
+	
+	meta.start_time = start_time;
+	meta.stop_time = Sunset_Utilities::get_now();
+	meta.start_traffic = start_traffic;
+	meta.preamble_size = preamble_size;
+	meta.max_node_id = max_node_id;
+	meta.broadcast = Sunset_Address::getBroadcastAddress();
+	meta.total_energy = totalEnergy;
+	meta.run_id = run_id;
+	
+	pthread_mutex_lock(&mutex_stat);
+	
+	writeTraceChunk();
+	
+	buf = statWriter.begin(Sunset_Trace_Encoder::maxMetaSize());
+	statWriter.end(Sunset_Trace_Encoder::encodeMeta(buf, meta));
+	
+	pthread_mutex_unlock(&mutex_stat);
+}
+
 
 /*!
  * 	@brief The update_data function updates the different data structures according to the statistics data 
@@ -1038,10 +1300,20 @@ void Sunset_Protocol_Statistics::processCreateData(statInfo st)
 	int size = st.pkt_size;
 	int pkt_id = st.agt_pktId;
 	
+	if (st.spktType == SUNSET_STAT_DATA) {
+		
+		updateGeneratedInfo(node, pkt_id, -1); // remove the previous contribution of this packet, if any
+	}
+	
 	((pkt_size_info[st.spktType])[node])[pkt_id] = size;
 	((pkt_dest_info[st.spktType])[node])[pkt_id] = dest;
 	(((pkt_sent[st.spktType])[node])[pkt_id]).push_back(time);
 	
+	if (st.spktType == SUNSET_STAT_DATA) {
+		
+		updateGeneratedInfo(node, pkt_id, 1);
+	}
+	
 	Sunset_Trace::print_info("stat - (%f) Node:%d - AGT_TX node %d  destination %d size %d id %d len %d\n", time, node, node, dest, size, pkt_id, (((pkt_sent[st.spktType])[node])[pkt_id]).size());
 
 }
@@ -1059,6 +1331,7 @@ void Sunset_Protocol_Statistics::processRecvData(statInfo st)
 	int size = st.pkt_size;
 	int pkt_id = st.agt_pktId;
 	int num_hop = st.num_hop;
+	bool duplicated = false;
 	
 	if (pkt_recv.find(st.spktType) != pkt_recv.end() && 
 	    pkt_recv[st.spktType].find(node) != pkt_recv[st.spktType].end() &&
@@ -1066,6 +1339,7 @@ void Sunset_Protocol_Statistics::processRecvData(statInfo st)
 	    ((pkt_recv[st.spktType])[node])[src].find(pkt_id) != ((pkt_recv[st.spktType])[node])[src].end()) {
 		
 		(((avg_num_hop_dup[st.spktType])[node])[src])[pkt_id].push_back(num_hop);        
+		duplicated = true;
 	}
 	else {
 		
@@ -1073,6 +1347,11 @@ void Sunset_Protocol_Statistics::processRecvData(statInfo st)
 	}
 	
 	((((pkt_recv[st.spktType])[node])[src])[pkt_id]).push_back(time);
+	
+	if (st.spktType == SUNSET_STAT_DATA) {
+		
+		updateDeliveredInfo(src, node, pkt_id, num_hop, time, duplicated);
+	}
 	Sunset_Trace::print_info("stat - (%f) Node:%d - AGT_RX source %d destination %d size %d id %d len %d time %f\n", time, node, src, node, size, pkt_id, ((((pkt_recv[st.spktType])[node])[src])[pkt_id]).size(), st.realTime);
 }
 
@@ -1093,6 +1372,14 @@ void Sunset_Protocol_Statistics::processNewMacData(statInfo st)
 	int size = st.pkt_size - preamble_size; //remove preamble size since it is due to modem coding/decoding and training time are not bytes transmitted in water
 
 	((((mac_new_pkt[st.spktType])[node])[dst])[size]).push_back(time);
+	
+	if (st.spktType == SUNSET_STAT_DATA) {
+		
+		stat_link_info& info = (link_info[node])[dst];
+		
+		info.mac_data_new_++;
+		info.mac_data_new_bytes_ += size;
+	}
 }
 
 /*!
@@ -1126,6 +1413,19 @@ void Sunset_Protocol_Statistics::processMacDiscard(statInfo st)
 	int size = st.pkt_size - preamble_size; // remove preamble size since it is due to modem coding/decoding and training time are not bytes transmitted in water
 	
 	((((mac_pkt_discard[st.spktType])[node])[dst])[size]).push_back(time);
+	
+	stat_link_info& info = (link_info[node])[dst];
+	
+	if (st.spktType == SUNSET_STAT_DATA) {
+		
+		info.mac_data_discarded_++;
+		info.mac_data_discarded_bytes_ += size;
+	}
+	else {
+		
+		info.mac_ctrl_discarded_++;
+		info.mac_ctrl_discarded_bytes_ += size;
+	}
 }
 
 /*!
@@ -1142,6 +1442,19 @@ void Sunset_Protocol_Statistics::processTxDone(statInfo st)
 	int size = st.pkt_size - preamble_size; // remove preamble size since it is due to modem coding/decoding and training time are not bytes transmitted in water
 	
 	((((tx_done[st.spktType])[node])[dst])[size]).push_back(time);
+	
+	stat_link_info& info = (link_info[node])[dst];
+	
+	if (st.spktType == SUNSET_STAT_DATA) {
+		
+		info.mac_data_tx_++;
+		info.mac_data_tx_bytes_ += size;
+	}
+	else {
+		
+		info.mac_ctrl_tx_++;
+		info.mac_ctrl_tx_bytes_ += size;
+	}
 }
 
 
@@ -1182,6 +1495,27 @@ void Sunset_Protocol_Statistics::processMacRecv(statInfo st)
 	p_info.second = lq;
 	
 	(((((mac_pkt_recv[st.spktType])[node])[src])[dst])[size]).push_back(p_info);
+	
+	/* a reception is accounted to the src-dst link when it occurs at the destination node or when 
+	 * the packet is broadcast, in this case all the receivers are considered */
+	
+	if (node != dst && dst != Sunset_Address::getBroadcastAddress()) {
+		
+		return;
+	}
+	
+	stat_link_info& info = (link_info[src])[dst];
+	
+	if (st.spktType == SUNSET_STAT_DATA) {
+		
+		info.mac_data_rx_++;
+		info.mac_data_rx_bytes_ += size;
+	}
+	else {
+		
+		info.mac_ctrl_rx_++;
+		info.mac_ctrl_rx_bytes_ += size;
+	}
 }
 
 /*!
@@ -1215,166 +1549,224 @@ void Sunset_Protocol_Statistics::processQueueLength(statInfo st, int x)
 }
 
 /*!
- * 	@brief The getGeneratedPacket() function returns the number of packet generated by the src node to the dst node. 
- *	@param src The source node generating data.
- *	@param dst The destination node. 
- *	@retval generated_pkt The number of packet generated by the src node to the dst node.
+ * 	@brief The updateGeneratedInfo function adds (or removes) the contribution of a data packet generated at the application layer
+ *		to the aggregated information of the link between the source and the packet destination.
+ *	@param src The node generating the packet.
+ *	@param pkt_id The ID of the packet.
+ *	@param sign 1 to add the contribution of the packet, -1 to remove it.
  */
-
-int Sunset_Protocol_Statistics::getGeneratedPacket(int src, int dst) 
+void Sunset_Protocol_Statistics::updateGeneratedInfo(int src, int pkt_id, int sign) 
 {
-	int node_src = -1;
-	int node_dst = -1;
-	sunset_statisticPktType spktType = SUNSET_STAT_NONE;
-	int pkt_id = -1;
-	int tot_pkt_sent = 0;
-	int count = -1;
+	map <int, list <double> >& sent = (pkt_sent[SUNSET_STAT_DATA])[src];
+	map <int, list <double> >::iterator it = sent.find(pkt_id);
+	map <int, int >& dest_info = (pkt_dest_info[SUNSET_STAT_DATA])[src];
+	map <int, int >::iterator it1 = dest_info.find(pkt_id);
+	map <int, int >& size_info = (pkt_size_info[SUNSET_STAT_DATA])[src];
+	map <int, int >::iterator it2 = size_info.find(pkt_id);
+	int count = 0;
 	
-	map < sunset_statisticPktType, map <int, map <int, list <double> > > >::iterator it;
-	map <int, map <int, list <double> > >::iterator it1;
-	map <int, list <double> >::iterator it2;
-	map < sunset_statisticPktType, map <int, map <int, map <int, list <double> > > > >::iterator it3;
-	map <int, map <int, map <int, list <double> > > >::iterator it4;
+	if (it == sent.end() || it1 == dest_info.end()) {
+		
+		return;
+	}
 	
-	it = pkt_sent.begin();
+	count = (it->second).size();
 	
-	for (; it != pkt_sent.end(); it++) {
+	stat_link_info& info = (link_info[src])[it1->second];
+	
+	info.pkt_generated_ += sign * count;
+	
+	// packets generated more than once are not considered for the generated bytes
+	if (count == 1 && it2 != size_info.end()) {
 		
-		spktType = it->first;
+		info.bytes_generated_ += sign * it2->second;
+	}
+}
+
+/*!
+ * 	@brief The updateDeliveredInfo function updates the aggregated information of the link between the source and the destination
+ *		when a data packet is received at the application layer.
+ *	@param src The node which generated the packet.
+ *	@param dst The node receiving the packet.
+ *	@param pkt_id The ID of the packet.
+ *	@param num_hop The number of hops traversed by the packet.
+ *	@param time The reception time.
+ *	@param duplicated True if the packet has been already received.
+ */
+void Sunset_Protocol_Statistics::updateDeliveredInfo(int src, int dst, int pkt_id, int num_hop, double time, bool duplicated) 
+{
+	stat_link_info& info = (link_info[src])[dst];
+	map <int, int >& size_info = (pkt_size_info[SUNSET_STAT_DATA])[src];
+	map <int, int >::iterator it = size_info.find(pkt_id);
+	map <int, list <double> >& sent = (pkt_sent[SUNSET_STAT_DATA])[src];
+	map <int, list <double> >::iterator it1 = sent.find(pkt_id);
+	double delay = -1.0;
+	
+	if (it1 != sent.end() && !(it1->second).empty()) {
 		
-		if (spktType != SUNSET_STAT_DATA) {
+		delay = time - (it1->second).front();
 		
-			continue;
+		if (delay < 0.0) {
 			
+			SUNSET_DEBUG_LOG(-1, -1, "Sunset_Protocol_Statistics::updateDeliveredInfo latency node %d src %d pkt_id %d tx_time %f rx_time %f possible ERROR", dst, src, pkt_id, (it1->second).front(), time);
 		}
+	}
+	
+	if (!duplicated) {
 		
-		it1 = (it->second).begin();
+		info.pkt_delivered_++;
 		
-		for (; it1 != (it->second).end(); it1++) {
-			
-			node_src = it1->first;
-			
-			if (node_src != src) {
-
-				continue;
+		if (it != size_info.end()) {
 			
-			}
-			
-			it2 = (it1->second).begin();
+			info.bytes_delivered_ += it->second;
+		}
+		
+		info.hops_ += num_hop;
+		info.hops_count_++;
+		info.routes_.insert(num_hop);
+		
+		if (info.max_hops_ < num_hop) {
 			
-			for (; it2 != (it1->second).end(); it2++) {
+			info.max_hops_ = num_hop;
+		}
+		
+		if (delay >= 0.0) {
 			
-				pkt_id = it2->first;
-
-				if (pkt_dest_info.find(spktType) == pkt_dest_info.end() ||
-				    (pkt_dest_info[spktType]).find(node_src) == (pkt_dest_info[spktType]).end() ||
-				    (pkt_dest_info[spktType])[node_src].find(pkt_id) == (pkt_dest_info[spktType])[node_src].end()) {
-				
-					Sunset_Debug::debugInfo(-1, -1, "Sunset_Protocol_Statistics::getGeneratedPacket dest node %d pkt_id %d possible ERROR", node_src, pkt_id);
-					
-					continue;
-				}
-
-				node_dst = ((pkt_dest_info[spktType])[node_src])[pkt_id];
-
-				if (node_dst != dst) {
-
-					continue;
-				
-				}
-				
-				count = (it2->second).size();
-				tot_pkt_sent += count;
-				
-				if (count > 1) {
-					
-					Sunset_Debug::debugInfo(-1, -1, "Sunset_Protocol_Statistics::getGeneratedPacket node %d pkt_id %d count %d possible ERROR", node_src, pkt_id, count);
-					
-					continue;
-				}
-			}
+			info.delay_ += delay;
+			info.delay_count_++;
 		}
+		
+		return;
 	}
 	
+	info.pkt_delivered_dup_++;
+	
+	if (it != size_info.end()) {
+		
+		info.bytes_delivered_dup_ += it->second;
+	}
+	
+	// only the first duplicated reception of a packet is considered for the route length
+	if ((((avg_num_hop_dup[SUNSET_STAT_DATA])[dst])[src])[pkt_id].size() == 1) {
+		
+		info.hops_dup_ += num_hop;
+		info.hops_dup_count_++;
+		info.routes_dup_.insert(num_hop);
+		
+		if (info.max_hops_dup_ < num_hop) {
+			
+			info.max_hops_dup_ = num_hop;
+		}
+	}
+	
+	if (delay >= 0.0) {
+		
+		info.delay_dup_ += delay;
+		info.delay_dup_count_++;
+	}
+}
 
-	return tot_pkt_sent;
-}
-
-/*!
- * 	@brief The getDeliveredPacket() function returns the number of packet delivered by the src node to the dst node. 
- *	@param src The source node generating data.
- *	@param dst The destination node receiving the data. 
- *	@retval delivered_pkt The number of packet delivered by the src node to the dst node.
- */
-
-int Sunset_Protocol_Statistics::getDeliveredPacket(int src, int dst) 
+/*!
+ * 	@brief The findLinkInfo function returns the aggregated information of the link between src and dst.
+ *	@param src The source node.
+ *	@param dst The destination node.
+ *	@retval info The aggregated information, 0 if no information has been collected for the link.
+ */
+stat_link_info* Sunset_Protocol_Statistics::findLinkInfo(int src, int dst) 
 {
-	int node_src = -1;
-	int node_dst = -1;
-	sunset_statisticPktType spktType = SUNSET_STAT_NONE;
-	int pkt_id = -1;
-	int tot_pkt_received = 0;
-	int count = -1;
+	map <int, map <int, stat_link_info> >::iterator it = link_info.find(src);
+	map <int, stat_link_info>::iterator it1;
 	
-	map <int, map <int, list <double> > >::iterator it1;
-	map <int, list <double> >::iterator it2;
-	map < sunset_statisticPktType, map <int, map <int, map <int, list <double> > > > >::iterator it3;
-	map <int, map <int, map <int, list <double> > > >::iterator it4;
+	if (it == link_info.end()) {
+		
+		return 0;
+	}
 	
-	it3 = pkt_recv.begin();
+	it1 = (it->second).find(dst);
 	
-	for (; it3 != pkt_recv.end(); it3++) {
+	if (it1 == (it->second).end()) {
 		
-		spktType = it3->first;
+		return 0;
+	}
+	
+	return &(it1->second);
+}
+
+/*!
+ * 	@brief The isReportedDestination function returns true if the dst node is considered when computing the network
+ *		metrics for the src node: all the nodes up to max_node_id, excluding the source, and optionally the broadcast address.
+ *	@param src The source node.
+ *	@param dst The destination node.
+ *	@param broadcast True if the broadcast address has to be considered.
+ */
+bool Sunset_Protocol_Statistics::isReportedDestination(int src, int dst, bool broadcast) 
+{
+	int bcast = Sunset_Address::getBroadcastAddress();
+	
+	if (dst >= 0 && dst <= max_node_id) {
 		
-		if (spktType != SUNSET_STAT_DATA) {
+		return dst != src;
+	}
+	
+	return broadcast && dst == bcast && (bcast > max_node_id || bcast < 0);
+}
+
+/*!
+ * 	@brief The isReportedLink function returns true if the link between src and dst is considered when computing the network metrics.
+ *	@param src The source node.
+ *	@param dst The destination node.
+ *	@param broadcast True if the links to the broadcast address have to be considered.
+ */
+bool Sunset_Protocol_Statistics::isReportedLink(int src, int dst, bool broadcast) 
+{
+	if (src < 0 || src > max_node_id) {
 		
-			continue;
-			
-		}
+		return false;
+	}
+	
+	return isReportedDestination(src, dst, broadcast);
+}
 
-		it4 = (it3->second).begin();
+/*!
+ * 	@brief The getGeneratedPacket() function returns the number of packet generated by the src node to the dst node. 
+ *	@param src The source node generating data.
+ *	@param dst The destination node. 
+ *	@retval generated_pkt The number of packet generated by the src node to the dst node.
+ */
+
+int Sunset_Protocol_Statistics::getGeneratedPacket(int src, int dst) 
+{
+	stat_link_info* info = findLinkInfo(src, dst);
+	
+	if (info == 0) {
 		
-		for (; it4 != (it3->second).end(); it4++) {
-			
-			node_dst = it4->first;
-			
-			if (node_dst != dst) {
-			
-				continue;
-				
-			}
-			
-			it1 = (it4->second).begin();
-			
-			for (; it1 != (it4->second).end(); it1++) {
-			
-				node_src = it1->first;
-				
-				if (node_src != src) {
-				
-					continue;
-				
-				}
-				
-				it2 = (it1->second).begin();
-				
-				for (; it2 != (it1->second).end(); it2++) {
-					
-					pkt_id = it2->first;
-					count = (it2->second).size();
-					
-					tot_pkt_received++;
-										
-				}
-			}
-		}
+		return 0;
 	}
 	
-	return tot_pkt_received;
+	return info->pkt_generated_;
+}
+
+
+/*!
+ * 	@brief The getDeliveredPacket() function returns the number of packet delivered by the src node to the dst node. 
+ *	@param src The source node generating data.
+ *	@param dst The destination node receiving the data. 
+ *	@retval delivered_pkt The number of packet delivered by the src node to the dst node.
+ */
 
+int Sunset_Protocol_Statistics::getDeliveredPacket(int src, int dst) 
+{
+	stat_link_info* info = findLinkInfo(src, dst);
+	
+	if (info == 0) {
+		
+		return 0;
+	}
+	
+	return info->pkt_delivered_;
 }
 
+
 /*!
  * 	@brief The getDeliveredDuplicatedPacket() function returns the number of duplicated packet delivered by the src node to the dst node. 
  *	@param src The source node generating data.
@@ -1384,76 +1776,17 @@ int Sunset_Protocol_Statistics::getDeliveredPacket(int src, int dst)
 
 int Sunset_Protocol_Statistics::getDeliveredDuplicatedPacket(int src, int dst) 
 {
-	int node_src = -1;
-	int node_dst = -1;
-	sunset_statisticPktType spktType = SUNSET_STAT_NONE;
-	int pkt_id = -1;
-	int pkt_received_dup = 0;
-	int count = -1;
-	
-	map <int, map <int, list <double> > >::iterator it1;
-	map <int, list <double> >::iterator it2;
-	map < sunset_statisticPktType, map <int, map <int, map <int, list <double> > > > >::iterator it3;
-	map <int, map <int, map <int, list <double> > > >::iterator it4;
-	
-	it3 = pkt_recv.begin();
+	stat_link_info* info = findLinkInfo(src, dst);
 	
-	for (; it3 != pkt_recv.end(); it3++) {
-		
-		spktType = it3->first;
+	if (info == 0) {
 		
-		if (spktType != SUNSET_STAT_DATA) {
-		
-			continue;
-			
-		}
-
-		it4 = (it3->second).begin();
-		
-		for (; it4 != (it3->second).end(); it4++) {
-			
-			node_dst = it4->first;
-			
-			if (node_dst != dst) {
-			
-				continue;
-			
-			}
-			
-			it1 = (it4->second).begin();
-			
-			for (; it1 != (it4->second).end(); it1++) {
-			
-				node_src = it1->first;
-
-				if (node_src != src) {
-				
-					continue;
-				
-				}
-				
-				it2 = (it1->second).begin();
-				
-				for (; it2 != (it1->second).end(); it2++) {
-					
-					pkt_id = it2->first;
-					
-					count = (it2->second).size();
-										
-					if (count > 1) {
-					
-						pkt_received_dup += count - 1;
-					}
-					
-				}
-			}
-		}
+		return 0;
 	}
 	
-	return pkt_received_dup;
-	
+	return info->pkt_delivered_dup_;
 }
 
+
 /*!
  * 	@brief The getGeneratedBytes() function returns the number of bytes generated by the src node to the dst node. 
  *	@param src The source node generating data.
@@ -1463,93 +1796,17 @@ int Sunset_Protocol_Statistics::getDeliveredDuplicatedPacket(int src, int dst)
 
 int Sunset_Protocol_Statistics::getGeneratedBytes(int src, int dst) 
 {
-	int node_src = -1;
-	int node_dst = -1;
-	sunset_statisticPktType spktType = SUNSET_STAT_NONE;
-	int pkt_id = -1;
-	int tot_bytes_sent = 0;
-	int count = -1;
+	stat_link_info* info = findLinkInfo(src, dst);
 	
-	map < sunset_statisticPktType, map <int, map <int, list <double> > > >::iterator it;
-	map <int, map <int, list <double> > >::iterator it1;
-	map <int, list <double> >::iterator it2;
-	map < sunset_statisticPktType, map <int, map <int, map <int, list <double> > > > >::iterator it3;
-	map <int, map <int, map <int, list <double> > > >::iterator it4;
-	
-	it = pkt_sent.begin();
-	
-	for (; it != pkt_sent.end(); it++) {
-		
-		spktType = it->first;
-		
-		if (spktType != SUNSET_STAT_DATA) {
-		
-			continue;
-			
-		}
-
-		it1 = (it->second).begin();
+	if (info == 0) {
 		
-		for (; it1 != (it->second).end(); it1++) {
-			
-			node_src = it1->first;
-			
-			if (node_src != src) {
-
-				continue;
-			
-			}
-			
-			it2 = (it1->second).begin();
-			
-			for (; it2 != (it1->second).end(); it2++) {
-			
-				pkt_id = it2->first;
-
-				if (pkt_dest_info.find(spktType) == pkt_dest_info.end() ||
-				    (pkt_dest_info[spktType]).find(node_src) == (pkt_dest_info[spktType]).end() ||
-				    (pkt_dest_info[spktType])[node_src].find(pkt_id) == (pkt_dest_info[spktType])[node_src].end()) {
-				
-					Sunset_Debug::debugInfo(-1, -1, "Sunset_Protocol_Statistics::getGeneratedPacket dest node %d pkt_id %d possible ERROR", node_src, pkt_id);
-					
-					continue;
-				}
-
-				node_dst = ((pkt_dest_info[spktType])[node_src])[pkt_id];
-
-				if (node_dst != dst) {
-
-					continue;
-				
-				}
-				
-				count = (it2->second).size();
-				
-				if (count > 1) {
-					
-					Sunset_Debug::debugInfo(-1, -1, "Sunset_Protocol_Statistics::getGeneratedPacket node %d pkt_id %d count %d possible ERROR", node_src, pkt_id, count);
-					
-					continue;
-				}
-				
-				if (pkt_size_info.find(spktType) == pkt_size_info.end() ||
-				    (pkt_size_info[spktType]).find(node_src) == (pkt_size_info[spktType]).end() ||
-				    (pkt_size_info[spktType])[node_src].find(pkt_id) == (pkt_size_info[spktType])[node_src].end()) {
-				
-					Sunset_Debug::debugInfo(-1, -1, "Sunset_Protocol_Statistics::getGeneratedPacket size node_src %d pkt_id %d possible ERROR", node_src, pkt_id);
-					
-					continue;
-				}
-				
-				tot_bytes_sent += count * ((pkt_size_info[spktType])[node_src])[pkt_id];
-			}
-		}
+		return 0;
 	}
 	
-	return tot_bytes_sent;
-	
+	return info->bytes_generated_;
 }
 
+
 /*!
  * 	@brief The getDeliveredBytes() function returns the number of bytes delivered by the src node to the dst node. 
  *	@param src The source node generating data.
@@ -1559,1813 +1816,449 @@ int Sunset_Protocol_Statistics::getGeneratedBytes(int src, int dst)
 
 int Sunset_Protocol_Statistics::getDeliveredBytes(int src, int dst) 
 {
-	int node_src = -1;
-	int node_dst = -1;
-	sunset_statisticPktType spktType = SUNSET_STAT_NONE;
-	int pkt_id = -1;
-	int tot_bytes_delivered = 0;
-	int count = -1;
-	
-	map <int, map <int, list <double> > >::iterator it1;
-	map <int, list <double> >::iterator it2;
-	map < sunset_statisticPktType, map <int, map <int, map <int, list <double> > > > >::iterator it3;
-	map <int, map <int, map <int, list <double> > > >::iterator it4;
-	
-	it3 = pkt_recv.begin();
+	stat_link_info* info = findLinkInfo(src, dst);
 	
-	for (; it3 != pkt_recv.end(); it3++) {
-		
-		spktType = it3->first;
-		
-		if (spktType != SUNSET_STAT_DATA) {
+	if (info == 0) {
 		
-			continue;
-			
-		}
+		return 0;
+	}
+	
+	return info->bytes_delivered_;
+}
 
-		it4 = (it3->second).begin();
+
+/*!
+ * 	@brief The getDeliveredDuplicatedBytes() function returns the number of duplicated bytes delivered by the src node to the dst node. 
+ *	@param src The source node generating data.
+ *	@param dst The destination node receiving the data. 
+ *	@retval result The number of deplicated bytes delivered by the src node to the dst node.
+ */
+int Sunset_Protocol_Statistics::getDeliveredDuplicatedBytes(int src, int dst) 
+{
+	stat_link_info* info = findLinkInfo(src, dst);
+	
+	if (info == 0) {
 		
-		for (; it4 != (it3->second).end(); it4++) {
-			
-			node_dst = it4->first;
+		return 0;
+	}
+	
+	return info->bytes_delivered_dup_;
+}
 
-			if (node_dst != dst) {
-			
-				continue;
-			
-			}
 
-			it1 = (it4->second).begin();
-			
-			for (; it1 != (it4->second).end(); it1++) {
-			
-				node_src = it1->first;
-
-				if (node_src != src) {
-				
-					continue;
-				
-				}
-
-				it2 = (it1->second).begin();
-				
-				for (; it2 != (it1->second).end(); it2++) {
-					
-					pkt_id = it2->first;
-
-					count = (it2->second).size();
-					
-					if (pkt_size_info.find(spktType) == pkt_size_info.end() ||
-					    (pkt_size_info[spktType]).find(src) == (pkt_size_info[spktType]).end() 
-					    || (pkt_size_info[spktType])[src].find(pkt_id) == (pkt_size_info[spktType])[src].end()) {
-						
-						Sunset_Debug::debugInfo(-1, -1, "Sunset_Protocol_Statistics::getDeliveredBytes size node %d pkt_id %d possible ERROR", src, pkt_id);
-						
-						continue;
-					}
-					
-					tot_bytes_delivered += ((pkt_size_info[spktType])[src])[pkt_id];
-					
-				}
-			}
-		}
+/*!
+ * 	@brief The getRouteLength() function returns the average route length traversed by packets delivered by the src node to the dst node. 
+ *	@param src The source node generating data.
+ *	@param dst The destination node receiving the data. 
+ *	@retval result The average route length traversed by packets delivered by the src node to the dst node.
+ */
+double Sunset_Protocol_Statistics::getRouteLength(int src, int dst) 
+{
+	stat_link_info* info = findLinkInfo(src, dst);
+	
+	if (info == 0 || info->hops_count_ <= 0) {
+		
+		return 0.0;
 	}
 	
-	return tot_bytes_delivered;
+	return info->hops_ / (double)(info->hops_count_);
 }
 
+
 /*!
- * 	@brief The getDeliveredDuplicatedBytes() function returns the number of duplicated bytes delivered by the src node to the dst node. 
+ * 	@brief The getDuplicatedRouteLength() function returns the average route length traversed by duplicated packets delivered by the src node to the dst node. 
  *	@param src The source node generating data.
  *	@param dst The destination node receiving the data. 
- *	@retval result The number of deplicated bytes delivered by the src node to the dst node.
+ *	@retval result The average route length traversed by duplicated packets delivered by the src node to the dst node.
  */
-int Sunset_Protocol_Statistics::getDeliveredDuplicatedBytes(int src, int dst) 
+
+double Sunset_Protocol_Statistics::getDuplicatedRouteLength(int src, int dst) 
 {
-	int node_src = -1;
-	int node_dst = -1;
-	sunset_statisticPktType spktType = SUNSET_STAT_NONE;
-	int pkt_id = -1;
-	int tot_bytes_delivered_dup = 0;
-	int count = -1;
-	
-	map <int, map <int, list <double> > >::iterator it1;
-	map <int, list <double> >::iterator it2;
-	map < sunset_statisticPktType, map <int, map <int, map <int, list <double> > > > >::iterator it3;
-	map <int, map <int, map <int, list <double> > > >::iterator it4;
-	
-	it3 = pkt_recv.begin();
+	stat_link_info* info = findLinkInfo(src, dst);
 	
-	for (; it3 != pkt_recv.end(); it3++) {
-		
-		spktType = it3->first;
-		
-		if (spktType != SUNSET_STAT_DATA) {
+	if (info == 0 || info->hops_dup_count_ <= 0) {
 		
-			continue;
-			
-		}
-
-		it4 = (it3->second).begin();
-		
-		for (; it4 != (it3->second).end(); it4++) {
-			
-			node_dst = it4->first;
-
-			if (node_dst != dst) {
-			
-				continue;
-			
-			}
-
-			it1 = (it4->second).begin();
-			
-			for (; it1 != (it4->second).end(); it1++) {
-			
-				node_src = it1->first;
-
-				if (node_src != src) {
-				
-					continue;
-				
-				}
+		return 0.0;
+	}
+	
+	return info->hops_dup_ / (double)(info->hops_dup_count_);
+}
 
-				it2 = (it1->second).begin();
-				
-				for (; it2 != (it1->second).end(); it2++) {
-					
-					pkt_id = it2->first;
 
-					count = (it2->second).size();
-					
-					if (count > 1) {
-					
-						if (pkt_size_info.find(spktType) == pkt_size_info.end() ||
-						(pkt_size_info[spktType]).find(src) == (pkt_size_info[spktType]).end() 
-						|| (pkt_size_info[spktType])[src].find(pkt_id) == (pkt_size_info[spktType])[src].end()) {
-							
-							Sunset_Debug::debugInfo(-1, -1, "Sunset_Protocol_Statistics::getDeliveredBytes size node %d pkt_id %d possible ERROR", node_dst, pkt_id);
-							
-							continue;
-						}
+/*!
+ * 	@brief The getMaxRouteLength() function returns the maximal route length traversed by packets delivered by the src node to the dst node. 
+ *	@param src The source node generating data.
+ *	@param dst The destination node receiving the data. 
+ *	@retval result The maximal route length traversed by packets delivered by the src node to the dst node.
+ */
 
-						tot_bytes_delivered_dup += (count - 1) * ((pkt_size_info[spktType])[src])[pkt_id];
-					}
-					
-				}
-			}
-		}
+int Sunset_Protocol_Statistics::getMaxRouteLength(int src, int dst)
+{
+	stat_link_info* info = findLinkInfo(src, dst);
+	
+	if (info == 0) {
+		
+		return -1;
 	}
 	
-	return tot_bytes_delivered_dup;
+	return info->max_hops_;
 }
 
+
 /*!
- * 	@brief The getRouteLength() function returns the average route length traversed by packets delivered by the src node to the dst node. 
+ * 	@brief The getMaxDuplicatedRouteLength() function returns the maximal duplicated route length traversed by packets delivered by the src node to the dst node. 
  *	@param src The source node generating data.
  *	@param dst The destination node receiving the data. 
- *	@retval result The average route length traversed by packets delivered by the src node to the dst node.
+ *	@retval result The maximal duplicated route length traversed by packets delivered by the src node to the dst node.
  */
-double Sunset_Protocol_Statistics::getRouteLength(int src, int dst) 
+int Sunset_Protocol_Statistics::getMaxDuplicatedRouteLength(int src, int dst)
 {
-	int node_src = -1;
-	int node_dst = -1;
-	sunset_statisticPktType spktType = SUNSET_STAT_NONE;
-	int pkt_id = -1;
-	double num_hop = 0.0;
-	int count = 0;
+	stat_link_info* info = findLinkInfo(src, dst);
 	
-	map < sunset_statisticPktType, map <int, map <int, map <int, list <int> > > > >::iterator it;
-	map <int, map <int, map <int, list <int> > > >::iterator it1;
-	map <int, map <int, list <int> > >::iterator it2;
-	map <int, list <int> >::iterator it3;
-	list <int>::iterator it4;
+	if (info == 0) {
 		
-	it = avg_num_hop.begin();
-	
-	for (; it != avg_num_hop.end(); it++) {
+		return -1;
+	}
 	
-		spktType = it->first;
+	return info->max_hops_dup_;
+}
 
-		if (spktType != SUNSET_STAT_DATA) {
-		
-			continue;
-			
-		}
 
-		it1 = (it->second).begin();
-		
-		for (; it1 != (it->second).end(); it1++) {
+/*!
+ * 	@brief The getNumRoutes() function returns the number of different routes traversed by packets delivered by the src node to the dst node. 
+ *	@param src The source node generating data.
+ *	@param dst The destination node receiving the data. 
+ *	@retval result The number of different routes traversed by packets delivered by the src node to the dst node.
+ */
+
+int Sunset_Protocol_Statistics::getNumRoutes(int src, int dst)
+{
+	stat_link_info* info = findLinkInfo(src, dst);
+	
+	if (info == 0) {
 		
-			node_dst = it1->first;
-			
-			if (node_dst != dst) {
-			
-				continue;
-				
-			}
-			
-			it2 = (it1->second).begin();
-			
-			for (; it2 != (it1->second).end(); it2++) {
-			
-				node_src = it2->first;
-				
-				if (node_src != src) {
-				
-					continue;
-					
-				}
-				
-				it3 = (it2->second).begin();
-				
-				for (; it3 != (it2->second).end(); it3++) {
-				
-					pkt_id = it3->first;
-					it4 = (it3->second).begin();
-					
-					if (it4 != (it3->second).end()) {
-					
-						num_hop += *it4;
-						count++;
-						
-					}
-				}
-				
-				if (count > 0) {
-					
-					num_hop = num_hop / (double)count;
-				}
-				else {
-					num_hop = 0.0;
-				}
-				
-			}
-		}
-	}    
+		return 0;
+	}
 	
-	return num_hop;
+	return (int)(info->routes_.size());
 }
 
+
 /*!
- * 	@brief The getDuplicatedRouteLength() function returns the average route length traversed by duplicated packets delivered by the src node to the dst node. 
+ * 	@brief The getDuplicatedNumRoutes() function returns the number of different routes traversed by duplicated packets delivered by the src node to the dst node. 
  *	@param src The source node generating data.
  *	@param dst The destination node receiving the data. 
- *	@retval result The average route length traversed by duplicated packets delivered by the src node to the dst node.
+ *	@retval result The number of different routes traversed by duplicated packets delivered by the src node to the dst node.
  */
-
-double Sunset_Protocol_Statistics::getDuplicatedRouteLength(int src, int dst) 
+int Sunset_Protocol_Statistics::getDuplicatedNumRoutes (int src, int dst)
 {
-	int node_src = -1;
-	int node_dst = -1;
-	sunset_statisticPktType spktType = SUNSET_STAT_NONE;
-	int pkt_id = -1;
-	double num_hop = 0.0;
-	int count = 0;
+	stat_link_info* info = findLinkInfo(src, dst);
 	
-	map < sunset_statisticPktType, map <int, map <int, map <int, list <int> > > > >::iterator it;
-	map <int, map <int, map <int, list <int> > > >::iterator it1;
-	map <int, map <int, list <int> > >::iterator it2;
-	map <int, list <int> >::iterator it3;
-	list <int>::iterator it4;
+	if (info == 0) {
 		
-	it = avg_num_hop_dup.begin();
-	
-	for (; it != avg_num_hop_dup.end(); it++) {
+		return 0;
+	}
 	
-		spktType = it->first;
+	return (int)(info->routes_dup_.size());
+}
 
-		if (spktType != SUNSET_STAT_DATA) {
-		
-			continue;
-			
-		}
 
-		it1 = (it->second).begin();
-		
-		for (; it1 != (it->second).end(); it1++) {
+/*!
+ * 	@brief The getPacketLatency() function returns the average end-to-end for packets delivered by the src node to the dst node. 
+ *	@param src The source node generating data.
+ *	@param dst The destination node receiving the data. 
+ *	@retval result The average end-to-end for packets delivered by the src node to the dst node.
+ */
+
+double Sunset_Protocol_Statistics::getPacketLatency(int src, int dst) 
+{
+	stat_link_info* info = findLinkInfo(src, dst);
+	
+	if (info == 0 || info->delay_count_ <= 0) {
 		
-			node_dst = it1->first;
-			
-			if (node_dst != dst) {
-			
-				continue;
-				
-			}
-			
-			it2 = (it1->second).begin();
-			
-			for (; it2 != (it1->second).end(); it2++) {
-			
-				node_src = it2->first;
-				
-				if (node_src != src) {
-				
-					continue;
-					
-				}
-				
-				it3 = (it2->second).begin();
-				
-				for (; it3 != (it2->second).end(); it3++) {
-				
-					pkt_id = it3->first;
-					it4 = (it3->second).begin();
-					
-					if (it4 != (it3->second).end()) {
-					
-						num_hop += *it4;
-						count++;
-						
-					}
-				}
-				
-				if (count > 0) {
-					
-					num_hop = num_hop / (double)count;
-				}
-				else {
-					num_hop = 0.0;
-				}
-				
-			}
-		}
-	}    
+		return 0.0;
+	}
 	
-	return num_hop;
+	return info->delay_ / (double)(info->delay_count_);
 }
 
+
 /*!
- * 	@brief The getMaxRouteLength() function returns the maximal route length traversed by packets delivered by the src node to the dst node. 
+ * 	@brief The getDuplicatedPacketLatency() function returns the average end-to-end for duplicated packets delivered by the src node to the dst node. 
  *	@param src The source node generating data.
  *	@param dst The destination node receiving the data. 
- *	@retval result The maximal route length traversed by packets delivered by the src node to the dst node.
+ *	@retval result The average end-to-end for duplicated packets delivered by the src node to the dst node.
  */
 
-int Sunset_Protocol_Statistics::getMaxRouteLength(int src, int dst)
+double Sunset_Protocol_Statistics::getDuplicatedPacketLatency(int src, int dst) 
 {
-	int node_src = -1;
-	int node_dst = -1;
-	sunset_statisticPktType spktType = SUNSET_STAT_NONE;
-	int pkt_id = -1;
-	int max_num_hop = -1;
+	stat_link_info* info = findLinkInfo(src, dst);
 	
-	map < sunset_statisticPktType, map <int, map <int, map <int, list <int> > > > >::iterator it;
-	map <int, map <int, map <int, list <int> > > >::iterator it1;
-	map <int, map <int, list <int> > >::iterator it2;
-	map <int, list <int> >::iterator it3;
-	list <int>::iterator it4;
+	if (info == 0 || info->delay_dup_count_ <= 0) {
 		
-	it = avg_num_hop.begin();
-	
-	for (; it != avg_num_hop.end(); it++) {
+		return 0.0;
+	}
 	
-		spktType = it->first;
+	return info->delay_dup_ / (double)(info->delay_dup_count_);
+}
 
-		if (spktType != SUNSET_STAT_DATA) {
-		
-			continue;
-			
-		}
-
-		it1 = (it->second).begin();
-		
-		for (; it1 != (it->second).end(); it1++) {
-		
-			node_dst = it1->first;
-			
-			if (node_dst != dst) {
-			
-				continue;
-				
-			}
-			
-			it2 = (it1->second).begin();
-			
-			for (; it2 != (it1->second).end(); it2++) {
-			
-				node_src = it2->first;
-				
-				if (node_src != src) {
-				
-					continue;
-					
-				}
-				
-				it3 = (it2->second).begin();
-				
-				for (; it3 != (it2->second).end(); it3++) {
-				
-					pkt_id = it3->first;
-					it4 = (it3->second).begin();
-					
-					if (it4 != (it3->second).end()) {
-					
-						if (max_num_hop < *it4 ) {
-							
-							max_num_hop = *it4;
-							
-						}
-					}
-				}
-				
-			}
-		}
-	}    
-	
-	return max_num_hop;
-}
-
-/*!
- * 	@brief The getMaxDuplicatedRouteLength() function returns the maximal duplicated route length traversed by packets delivered by the src node to the dst node. 
- *	@param src The source node generating data.
- *	@param dst The destination node receiving the data. 
- *	@retval result The maximal duplicated route length traversed by packets delivered by the src node to the dst node.
- */
-int Sunset_Protocol_Statistics::getMaxDuplicatedRouteLength(int src, int dst)
-{
-	int node_src = -1;
-	int node_dst = -1;
-	sunset_statisticPktType spktType = SUNSET_STAT_NONE;
-	int pkt_id = -1;
-	int max_num_hop = -1;
-	
-	map < sunset_statisticPktType, map <int, map <int, map <int, list <int> > > > >::iterator it;
-	map <int, map <int, map <int, list <int> > > >::iterator it1;
-	map <int, map <int, list <int> > >::iterator it2;
-	map <int, list <int> >::iterator it3;
-	list <int>::iterator it4;
-		
-	it = avg_num_hop_dup.begin();
-	
-	for (; it != avg_num_hop_dup.end(); it++) {
-	
-		spktType = it->first;
-
-		if (spktType != SUNSET_STAT_DATA) {
-		
-			continue;
-			
-		}
-
-		it1 = (it->second).begin();
-		
-		for (; it1 != (it->second).end(); it1++) {
-		
-			node_dst = it1->first;
-			
-			if (node_dst != dst) {
-			
-				continue;
-				
-			}
-			
-			it2 = (it1->second).begin();
-			
-			for (; it2 != (it1->second).end(); it2++) {
-			
-				node_src = it2->first;
-				
-				if (node_src != src) {
-				
-					continue;
-					
-				}
-				
-				it3 = (it2->second).begin();
-				
-				for (; it3 != (it2->second).end(); it3++) {
-				
-					pkt_id = it3->first;
-					it4 = (it3->second).begin();
-					
-					if (it4 != (it3->second).end()) {
-					
-						if (max_num_hop < *it4 ) {
-							
-							max_num_hop = *it4;
-							
-						}
-					}
-				}
-				
-			}
-		}
-	}    
-	
-	return max_num_hop;
-}
-
-/*!
- * 	@brief The getNumRoutes() function returns the number of different routes traversed by packets delivered by the src node to the dst node. 
- *	@param src The source node generating data.
- *	@param dst The destination node receiving the data. 
- *	@retval result The number of different routes traversed by packets delivered by the src node to the dst node.
- */
-
-int Sunset_Protocol_Statistics::getNumRoutes(int src, int dst)
-{
-	int node_src = -1;
-	int node_dst = -1;
-	sunset_statisticPktType spktType = SUNSET_STAT_NONE;
-	int pkt_id = -1;
-	set<int> num_path;
-	
-	map < sunset_statisticPktType, map <int, map <int, map <int, list <int> > > > >::iterator it;
-	map <int, map <int, map <int, list <int> > > >::iterator it1;
-	map <int, map <int, list <int> > >::iterator it2;
-	map <int, list <int> >::iterator it3;
-	list <int>::iterator it4;
-		
-	it = avg_num_hop.begin();
-	
-	for (; it != avg_num_hop.end(); it++) {
-	
-		spktType = it->first;
-
-		if (spktType != SUNSET_STAT_DATA) {
-		
-			continue;
-			
-		}
-
-		it1 = (it->second).begin();
-		
-		for (; it1 != (it->second).end(); it1++) {
-		
-			node_dst = it1->first;
-			
-			if (node_dst != dst) {
-			
-				continue;
-				
-			}
-			
-			it2 = (it1->second).begin();
-			
-			for (; it2 != (it1->second).end(); it2++) {
-			
-				node_src = it2->first;
-				
-				if (node_src != src) {
-				
-					continue;
-					
-				}
-				
-				it3 = (it2->second).begin();
-				
-				for (; it3 != (it2->second).end(); it3++) {
-				
-					pkt_id = it3->first;
-					it4 = (it3->second).begin();
-					
-					if (it4 != (it3->second).end()) {
-					
-						num_path.insert(*it4);
-
-					}
-				}
-				
-			}
-		}
-	}    
-	
-	if (num_path.empty()) {
-		
-		return 0;
-	}
-	
-	return (int)(num_path.size());
-}
-
-/*!
- * 	@brief The getDuplicatedNumRoutes() function returns the number of different routes traversed by duplicated packets delivered by the src node to the dst node. 
- *	@param src The source node generating data.
- *	@param dst The destination node receiving the data. 
- *	@retval result The number of different routes traversed by duplicated packets delivered by the src node to the dst node.
- */
-int Sunset_Protocol_Statistics::getDuplicatedNumRoutes (int src, int dst)
-{
-	int node_src = -1;
-	int node_dst = -1;
-	sunset_statisticPktType spktType = SUNSET_STAT_NONE;
-	int pkt_id = -1;
-	set<int> num_path;
-	
-	map < sunset_statisticPktType, map <int, map <int, map <int, list <int> > > > >::iterator it;
-	map <int, map <int, map <int, list <int> > > >::iterator it1;
-	map <int, map <int, list <int> > >::iterator it2;
-	map <int, list <int> >::iterator it3;
-	list <int>::iterator it4;
-		
-	it = avg_num_hop_dup.begin();
-	
-	for (; it != avg_num_hop_dup.end(); it++) {
-	
-		spktType = it->first;
-
-		if (spktType != SUNSET_STAT_DATA) {
-		
-			continue;
-			
-		}
-
-		it1 = (it->second).begin();
-		
-		for (; it1 != (it->second).end(); it1++) {
-		
-			node_dst = it1->first;
-			
-			if (node_dst != dst) {
-			
-				continue;
-				
-			}
-			
-			it2 = (it1->second).begin();
-			
-			for (; it2 != (it1->second).end(); it2++) {
-			
-				node_src = it2->first;
-				
-				if (node_src != src) {
-				
-					continue;
-					
-				}
-				
-				it3 = (it2->second).begin();
-				
-				for (; it3 != (it2->second).end(); it3++) {
-				
-					pkt_id = it3->first;
-					it4 = (it3->second).begin();
-					
-					if (it4 != (it3->second).end()) {
-					
-						num_path.insert(*it4);
-
-					}
-				}
-				
-			}
-		}
-	}    
-	
-	if (num_path.empty()) {
-		
-		return 0;
-	}
-	
-	return (int)(num_path.size());
-}
-
-/*!
- * 	@brief The getPacketLatency() function returns the average end-to-end for packets delivered by the src node to the dst node. 
- *	@param src The source node generating data.
- *	@param dst The destination node receiving the data. 
- *	@retval result The average end-to-end for packets delivered by the src node to the dst node.
- */
-
-double Sunset_Protocol_Statistics::getPacketLatency(int src, int dst) 
-{
-	int node_src = -1;
-	int node_dst = -1;
-	sunset_statisticPktType spktType = SUNSET_STAT_NONE;
-	int pkt_id = -1;
-	int num_pkt = 0;
-	double tot_delay = 0.0;
-	
-	map < sunset_statisticPktType, map <int, map <int, map <int, list <double> > > > >::iterator it;
-	map <int, map <int, map <int, list <double> > > >::iterator it1;
-	map <int, map <int, list <double> > >::iterator it2;
-	map <int, list <double> >::iterator it3;
-	
-	it = pkt_recv.begin();
-	
-	for (; it != pkt_recv.end(); it++) {
-	
-		spktType = it->first;
-
-		if (spktType != SUNSET_STAT_DATA) {
-		
-			continue;
-			
-		}
-
-		it1 = (it->second).begin();
-		
-		for (; it1 != (it->second).end(); it1++) {
-		
-			node_dst = it1->first;
-			
-			if (node_dst != dst) {
-			
-				continue;
-			
-			}
-			
-			it2 = (it1->second).begin();
-			
-			for (; it2 != (it1->second).end(); it2++) {
-			
-				node_src = it2->first;
-				
-				if (node_src != src) {
-				
-					continue;
-				
-				}
-				
-				it3 = (it2->second).begin();
-				
-				for (; it3 != (it2->second).end(); it3++) {
-				
-					pkt_id = it3->first;
-					
-					if (pkt_sent.find(spktType) != pkt_sent.end() &&
-					    (pkt_sent[spktType]).find(src) != (pkt_sent[spktType]).end() &&
-					    (pkt_sent[spktType])[src].find(pkt_id) != (pkt_sent[spktType])[src].end()) {
-					
-						double rx_time = *((it3->second).begin());
-						double tx_time = *((((pkt_sent[spktType])[src])[pkt_id]).begin());
-						
-						if (rx_time - tx_time < 0.0) {
-						
-							Sunset_Debug::debugInfo(-1, -1, "Sunset_Protocol_Statistics::getPacketLatency latency node %d src %d pkt_id %d tx_time %f rx_time %f possible ERROR", dst, src, pkt_id, tx_time, rx_time);
-							
-							continue;
-						} 
-						
-						tot_delay += rx_time - tx_time;
-						
-						num_pkt++;
-					}
-				}
-			}
-		}
-	}
-	
-	if (num_pkt > 0) {
-		
-		tot_delay = tot_delay/num_pkt;
-	}
-	else {
-		
-		tot_delay = 0.0;
-	}
-	
-	return tot_delay;
-	
-}
-
-/*!
- * 	@brief The getDuplicatedPacketLatency() function returns the average end-to-end for duplicated packets delivered by the src node to the dst node. 
- *	@param src The source node generating data.
- *	@param dst The destination node receiving the data. 
- *	@retval result The average end-to-end for duplicated packets delivered by the src node to the dst node.
- */
-
-double Sunset_Protocol_Statistics::getDuplicatedPacketLatency(int src, int dst) 
-{
-	int node_src = -1;
-	int node_dst = -1;
-	sunset_statisticPktType spktType = SUNSET_STAT_NONE;
-	int pkt_id = -1;
-	int num_pkt = 0;
-	double tot_delay = 0.0;
-	
-	int count = 0;
-	
-	map < sunset_statisticPktType, map <int, map <int, map <int, list <double> > > > >::iterator it;
-	map <int, map <int, map <int, list <double> > > >::iterator it1;
-	map <int, map <int, list <double> > >::iterator it2;
-	map <int, list <double> >::iterator it3;
-	list <double>::iterator it4;
-	
-	
-	it = pkt_recv.begin();
-	
-	for (; it != pkt_recv.end(); it++) {
-	
-		spktType = it->first;
-
-		if (spktType != SUNSET_STAT_DATA) {
-		
-			continue;
-			
-		}
-
-		it1 = (it->second).begin();
-		
-		for (; it1 != (it->second).end(); it1++) {
-		
-			node_dst = it1->first;
-			
-			if (node_dst != dst) {
-			
-				continue;
-			
-			}
-			
-			it2 = (it1->second).begin();
-			
-			for (; it2 != (it1->second).end(); it2++) {
-			
-				node_src = it2->first;
-				
-				if (node_src != src) {
-				
-					continue;
-				
-				}
-				
-				it3 = (it2->second).begin();
-				
-				for (; it3 != (it2->second).end(); it3++) {
-				
-					pkt_id = it3->first;
-
-					count = (it3->second).size();
-					
-					if (count > 1) {
-						
-						if (pkt_sent.find(spktType) == pkt_sent.end() ||
-							(pkt_sent[spktType]).find(src) == (pkt_sent[spktType]).end() ||
-							(pkt_sent[spktType])[src].find(pkt_id) == (pkt_sent[spktType])[src].end()) {
-						
-							Sunset_Debug::debugInfo(-1, -1, "Sunset_Protocol_Statistics::getDuplicatedPacketLatency latency node %d src %d pkt_id %d tx_time possible ERROR", dst, src, pkt_id);
-
-							continue;
-						}
-
-						double tx_time = *((((pkt_sent[spktType])[src])[pkt_id]).begin());
-						
-						it4 = (it3->second).begin();
-						
-						it4++; //skip first packet which is not a duplicated
-				
-						for (; it4 != (it3->second).end(); it4++) {
-						
-							double rx_time = *it4;
-							
-							if (rx_time - tx_time < 0.0) {
-							
-								Sunset_Debug::debugInfo(-1, -1, "Sunset_Protocol_Statistics::getDuplicatedPacketLatency latency node %d src %d pkt_id %d tx_time %f rx_time %f possible ERROR", dst, src, pkt_id, tx_time, rx_time);
-								
-								continue;
-							} 
-							
-							tot_delay += rx_time - tx_time;
-							
-							num_pkt++;
-						}
-					}
-				}
-			}
-		}
-	}
-	
-	if (num_pkt > 0) {
-		
-		tot_delay = tot_delay/num_pkt;
-	}
-	else {
-		
-		tot_delay = 0.0;
-	}
-	
-	return tot_delay;
-	
-}
-
-/*!
- * 	@brief The getExperimentTime() function returns the experiment duration in seconds. 
- *	@retval result The the experiment duration in seconds.
- */
-
-double Sunset_Protocol_Statistics::getExperimentTime() 
-{
-	if (stop_time == 0.0 && start_time == 0.0 && start_traffic == 0.0) {
-		return -1;
-	}
-	
-	if (stop_time == 0) {
-	
-		return Sunset_Utilities::get_now() - start_traffic;
-	}
-	
-	return stop_time - start_traffic;
-}
-
-/*!
- * 	@brief The getCreatedMacDataPacket() function returns the number of data packets received at the MAC layer, generated at the upper layer to be transmitted on the link from the src node to the dst node. 
- *	@param src The source node of the link.
- *	@param dst The destination of the link. 
- *	@retval result The number of data packets received at the MAC layer for transmission from the src node to the destination node.
- */
-int Sunset_Protocol_Statistics::getCreatedMacDataPacket(int src, int dst) 
-{
-	int node_src = -1;
-	int node_dst = -1;
-	sunset_statisticPktType spktType = SUNSET_STAT_NONE;
-	int size = -1;
-	int mac_data_new = 0;
-	map < sunset_statisticPktType, map <int, map <int, map <int, list <double> > > > >::iterator it;
-	map <int, map <int, map <int, list <double> > > >::iterator it1;
-	map <int, map <int, list <double> > >::iterator it2;
-	map <int, list <double> >::iterator it3;
-	
-	it = (mac_new_pkt).begin();
-	
-	for (; it != (mac_new_pkt).end(); it++) {
-	
-		spktType = it->first;
-
-		if (spktType != SUNSET_STAT_DATA) {
-		
-			continue;
-			
-		}
-		it1 = (it->second).begin();
-		
-		for (; it1 != (it->second).end(); it1++) {
-		
-			node_src = it1->first;
-			
-		        if (node_src != src) {
-			
-				continue;
-			
-			}         
-			
-			it2 = (it1->second).begin();
-			
-			for (; it2 != (it1->second).end(); it2++) {
-			
-				node_dst = it2->first;
-
-				if (node_dst != dst) {
-				
-					continue;
-				
-				}         
-				
-				it3 = (it2->second).begin();
-				
-				for (; it3 != (it2->second).end(); it3++) {
-				
-					if (spktType == SUNSET_STAT_DATA) {
-					
-						mac_data_new += (it3->second).size();
-					}
-				}
-			}
-		}
-	}
-	
-	return mac_data_new;
-}
-
-/*!
- * 	@brief The getMacDataPacketTransmissions() function returns the number of data packets transmitted at the MAC layer, from the src node to the dst node. 
- *	@param src The source node of the link.
- *	@param dst The destination of the link. 
- *	@retval result The number of data packets transmitted by the src node to the destination node.
- */
-int Sunset_Protocol_Statistics::getMacDataPacketTransmissions(int src, int dst) 
-{
-	int node_src = -1;
-	int node_dst = -1;
-	sunset_statisticPktType spktType = SUNSET_STAT_NONE;
-	int size = -1;
-	int mac_data_tx = 0;
-	map < sunset_statisticPktType, map <int, map <int, map <int, list <double> > > > >::iterator it;
-	map <int, map <int, map <int, list <double> > > >::iterator it1;
-	map <int, map <int, list <double> > >::iterator it2;
-	map <int, list <double> >::iterator it3;
-	
-	it = (tx_done).begin();
-	
-	for (; it != (tx_done).end(); it++) {
-	
-		spktType = it->first;
-
-		if (spktType != SUNSET_STAT_DATA) {
-		
-			continue;
-			
-		}
-
-		it1 = (it->second).begin();
-		
-		for (; it1 != (it->second).end(); it1++) {
-		
-			node_src = it1->first;
-			
-		        if (node_src != src) {
-			
-				continue;
-			
-			}         
-			
-			it2 = (it1->second).begin();
-			
-			for (; it2 != (it1->second).end(); it2++) {
-			
-				node_dst = it2->first;
-
-				if (node_dst != dst) {
-				
-					continue;
-				
-				}         
-				
-				it3 = (it2->second).begin();
-				
-				for (; it3 != (it2->second).end(); it3++) {
-				
-					if (spktType == SUNSET_STAT_DATA) {
-					
-						mac_data_tx += (it3->second).size();
-					}
-				}
-			}
-		}
-	}
-	
-	return mac_data_tx;
-}
-
-/*!
- * 	@brief The getMacDataPacketReceptions() function returns the number of data packets received at the MAC layer, transmitted on the link from the src node to the dst node. 
- *	@param src The source node of the link.
- *	@param dst The destination of the link. 
- *	@retval result The number of data packets received at the MAC layer on the link from the src node to the destination node.
- */
-int Sunset_Protocol_Statistics::getMacDataPacketReceptions(int src, int dst) 
-{
-	int node = -1;
-	int node_src = -1;
-	int node_dst = -1;
-	sunset_statisticPktType spktType = SUNSET_STAT_NONE;
-	int size = -1;
-	int pkt_received = 0;
-	
-	map < sunset_statisticPktType, map <int, map <int, map <int, map <int, list < pair<double, double> > > > > > > ::iterator it;
-	map <int, map <int, map <int, map <int, list < pair<double, double> > > > > >::iterator it1;
-	map <int, map <int, map <int, list < pair<double, double> > > > >::iterator it2;
-	map <int, map <int, list < pair<double, double> > > >::iterator it3;
-	map <int, list < pair<double, double> > >::iterator it4;
-	
-	it = mac_pkt_recv.begin();
-	
-	for (; it != mac_pkt_recv.end(); it++) {
-	
-		spktType = it->first;
-
-		if (spktType != SUNSET_STAT_DATA) {
-		
-			continue;
-			
-		}
-		
-		it1 = (it->second).begin();
-		
-		for (; it1 != (it->second).end(); it1++) {
-		
-			node = it1->first;
-			
-			if (node != dst && dst != Sunset_Address::getBroadcastAddress()) { //TODO check if broadcast has to be added
-			
-				continue;
-				
-			}
-			
-			it2 = (it1->second).begin();
-			
-			for (; it2 != (it1->second).end(); it2++) {
-			
-				node_src = it2->first;
-
-				if (node_src != src) {
-				
-					continue;
-					
-				}
-				
-				it3 = (it2->second).begin();
-				
-				for (; it3 != (it2->second).end(); it3++) {
-				
-					node_dst = it3->first;
-
-					if (node_dst != dst) { //TODO check if broadcast has to be added
-					
-						continue;
-						
-					}
-					
-					it4 = (it3->second).begin();
-					
-					for (; it4 != (it3->second).end(); it4++) {
-						
-						pkt_received += (it4->second).size(); 
-						
-					}
-				}
-			}
-		}
-	}
-
-	return pkt_received;
-}
-
-/*!
- * 	@brief The getCreatedMacDataBytes() function returns the number of data bytes received at the MAC layer, generated at the upper layer to be transmitted on the link from the src node to the dst node. 
- *	@param src The source node of the link.
- *	@param dst The destination of the link. 
- *	@retval result The number of data bytes received at the MAC layer for transmission from the src node to the destination node.
- */
-
-int Sunset_Protocol_Statistics::getCreatedMacDataBytes(int src, int dst) 
-{
-	int node_src = -1;
-	int node_dst = -1;
-	sunset_statisticPktType spktType = SUNSET_STAT_NONE;
-	int size = -1;
-	int mac_data_new = 0;
-	map < sunset_statisticPktType, map <int, map <int, map <int, list <double> > > > >::iterator it;
-	map <int, map <int, map <int, list <double> > > >::iterator it1;
-	map <int, map <int, list <double> > >::iterator it2;
-	map <int, list <double> >::iterator it3;
-	
-	it = (mac_new_pkt).begin();
-	
-	for (; it != (mac_new_pkt).end(); it++) {
-	
-		spktType = it->first;
-
-		if (spktType != SUNSET_STAT_DATA) {
-		
-			continue;
-			
-		}
-		it1 = (it->second).begin();
-		
-		for (; it1 != (it->second).end(); it1++) {
-		
-			node_src = it1->first;
-			
-		        if (node_src != src) {
-			
-				continue;
-			
-			}         
-			
-			it2 = (it1->second).begin();
-			
-			for (; it2 != (it1->second).end(); it2++) {
-			
-				node_dst = it2->first;
-
-				if (node_dst != dst) {
-				
-					continue;
-				
-				}         
-				
-				it3 = (it2->second).begin();
-				
-				for (; it3 != (it2->second).end(); it3++) {
-				
-					if (spktType == SUNSET_STAT_DATA) {
-					
-						mac_data_new += (it3->first) * (it3->second).size();
-					}
-				}
-			}
-		}
-	}
-	
-	return mac_data_new;
-}
 
 /*!
- * 	@brief The getMacDataBytesTransmissions() function returns the number of data bytes transmitted at the MAC layer, from the src node to the dst node. 
- *	@param src The source node of the link.
- *	@param dst The destination of the link. 
- *	@retval result The number of data bytes transmitted by the src node to the destination node.
+ * 	@brief The getExperimentTime() function returns the experiment duration in seconds. 
+ *	@retval result The the experiment duration in seconds.
  */
 
-int Sunset_Protocol_Statistics::getMacDataBytesTransmissions(int src, int dst) 
+double Sunset_Protocol_Statistics::getExperimentTime() 
 {
-	int node_src = -1;
-	int node_dst = -1;
-	sunset_statisticPktType spktType = SUNSET_STAT_NONE;
-	int size = -1;
-	int mac_data_tx = 0;
-	map < sunset_statisticPktType, map <int, map <int, map <int, list <double> > > > >::iterator it;
-	map <int, map <int, map <int, list <double> > > >::iterator it1;
-	map <int, map <int, list <double> > >::iterator it2;
-	map <int, list <double> >::iterator it3;
-	
-	it = (tx_done).begin();
-	
-	for (; it != (tx_done).end(); it++) {
-	
-		spktType = it->first;
-
-		if (spktType != SUNSET_STAT_DATA) {
-		
-			continue;
-			
-		}
-
-		it1 = (it->second).begin();
-		
-		for (; it1 != (it->second).end(); it1++) {
-		
-			node_src = it1->first;
-			
-		        if (node_src != src) {
-			
-				continue;
-			
-			}         
-			
-			it2 = (it1->second).begin();
-			
-			for (; it2 != (it1->second).end(); it2++) {
-			
-				node_dst = it2->first;
-
-				if (node_dst != dst) {
-				
-					continue;
-				
-				}         
-				
-				it3 = (it2->second).begin();
-				
-				for (; it3 != (it2->second).end(); it3++) {
-				
-					if (spktType == SUNSET_STAT_DATA) {
-					
-						mac_data_tx += it3->first * (it3->second).size();
-					}
-				}
-			}
-		}
+	if (stop_time == 0.0 && start_time == 0.0 && start_traffic == 0.0) {
+		return -1;
 	}
 	
-	return mac_data_tx;
-}
-
-/*!
- * 	@brief The getMacDataBytesReceptions() function returns the number of data bytes received at the MAC layer, transmitted on the link from the src node to the dst node. 
- *	@param src The source node of the link.
- *	@param dst The destination of the link. 
- *	@retval result The number of data bytes received at the MAC layer on the link from the src node to the destination node.
- */
-
-int Sunset_Protocol_Statistics::getMacDataBytesReceptions(int src, int dst) 
-{
-	int node = -1;
-	int node_src = -1;
-	int node_dst = -1;
-	sunset_statisticPktType spktType = SUNSET_STAT_NONE;
-	int size = -1;
-	int pkt_received = 0;
-	
-	map < sunset_statisticPktType, map <int, map <int, map <int, map <int, list < pair<double, double> > > > > > > ::iterator it;
-	map <int, map <int, map <int, map <int, list < pair<double, double> > > > > >::iterator it1;
-	map <int, map <int, map <int, list < pair<double, double> > > > >::iterator it2;
-	map <int, map <int, list < pair<double, double> > > >::iterator it3;
-	map <int, list < pair<double, double> > >::iterator it4;
-	
-	it = mac_pkt_recv.begin();
-	
-	for (; it != mac_pkt_recv.end(); it++) {
+	if (stop_time == 0) {
 	
-		spktType = it->first;
-
-		if (spktType != SUNSET_STAT_DATA) {
-		
-			continue;
-			
-		}
-		
-		it1 = (it->second).begin();
-		
-		for (; it1 != (it->second).end(); it1++) {
-		
-			node = it1->first;
-			
-			if (node != dst  && dst != Sunset_Address::getBroadcastAddress()) {
-			
-				continue;
-				
-			}
-			
-			it2 = (it1->second).begin();
-			
-			for (; it2 != (it1->second).end(); it2++) {
-			
-				node_src = it2->first;
-
-				if (node_src != src) {
-				
-					continue;
-					
-				}
-				
-				it3 = (it2->second).begin();
-				
-				for (; it3 != (it2->second).end(); it3++) {
-				
-					node_dst = it3->first;
-
-					if (node_dst != dst) {
-					
-						continue;
-						
-					}
-					
-					it4 = (it3->second).begin();
-					
-					for (; it4 != (it3->second).end(); it4++) {
-					
-						pkt_received += it4->first * (it4->second).size(); 
-						
-					}
-				}
-			}
-		}
+		return Sunset_Utilities::get_now() - start_traffic;
 	}
 	
-	return pkt_received;
+	return stop_time - start_traffic;
 }
 
 /*!
- * 	@brief The getMacDataPacketDiscarded() function returns the number of data packets discarded at the MAC layer, by the src node addressed to dst node. 
+ * 	@brief The getCreatedMacDataPacket() function returns the number of data packets received at the MAC layer, generated at the upper layer to be transmitted on the link from the src node to the dst node. 
  *	@param src The source node of the link.
  *	@param dst The destination of the link. 
- *	@retval result The number of data packets discarded at the MAC layer by the src node addressed to dst node..
+ *	@retval result The number of data packets received at the MAC layer for transmission from the src node to the destination node.
  */
-
-int Sunset_Protocol_Statistics::getMacDataPacketDiscarded(int src, int dst) 
+int Sunset_Protocol_Statistics::getCreatedMacDataPacket(int src, int dst) 
 {
-	int node_src = -1;
-	int node_dst = -1;
-	sunset_statisticPktType spktType = SUNSET_STAT_NONE;
-	int size = -1;
-	int mac_data_discarded = 0;
-	map < sunset_statisticPktType, map <int, map <int, map <int, list <double> > > > >::iterator it;
-	map <int, map <int, map <int, list <double> > > >::iterator it1;
-	map <int, map <int, list <double> > >::iterator it2;
-	map <int, list <double> >::iterator it3;
-	
-	it = (mac_pkt_discard).begin();
+	stat_link_info* info = findLinkInfo(src, dst);
 	
-	for (; it != (mac_pkt_discard).end(); it++) {
-	
-		spktType = it->first;
-
-		if (spktType != SUNSET_STAT_DATA) {
-		
-			continue;
-			
-		}
-
-		it1 = (it->second).begin();
-		
-		for (; it1 != (it->second).end(); it1++) {
-		
-			node_src = it1->first;
-			
-		        if (node_src != src) {
-			
-				continue;
-			
-			}         
-			
-			it2 = (it1->second).begin();
-			
-			for (; it2 != (it1->second).end(); it2++) {
-			
-				node_dst = it2->first;
-
-				if (node_dst != dst) {
-				
-					continue;
-				
-				}         
-				
-				it3 = (it2->second).begin();
-				
-				for (; it3 != (it2->second).end(); it3++) {
-				
-					if (spktType == SUNSET_STAT_DATA) {
-					
-						mac_data_discarded += (it3->second).size();
-					}
-				}
-			}
-		}
+	if (info == 0) {
+		
+		return 0;
 	}
 	
-	return mac_data_discarded;
+	return info->mac_data_new_;
 }
 
+
 /*!
- * 	@brief The getMacDataBytesDiscarded() function returns the number of data bytes discarded at the MAC layer, by the src node addressed to dst node. 
+ * 	@brief The getMacDataPacketTransmissions() function returns the number of data packets transmitted at the MAC layer, from the src node to the dst node. 
  *	@param src The source node of the link.
  *	@param dst The destination of the link. 
- *	@retval result The number of data pabytescket discarded at the MAC layer by the src node addressed to dst node..
+ *	@retval result The number of data packets transmitted by the src node to the destination node.
  */
-
-int Sunset_Protocol_Statistics::getMacDataBytesDiscarded(int src, int dst) 
+int Sunset_Protocol_Statistics::getMacDataPacketTransmissions(int src, int dst) 
 {
-	int node_src = -1;
-	int node_dst = -1;
-	sunset_statisticPktType spktType = SUNSET_STAT_NONE;
-	int size = -1;
-	int mac_data_discarded = 0;
-	map < sunset_statisticPktType, map <int, map <int, map <int, list <double> > > > >::iterator it;
-	map <int, map <int, map <int, list <double> > > >::iterator it1;
-	map <int, map <int, list <double> > >::iterator it2;
-	map <int, list <double> >::iterator it3;
+	stat_link_info* info = findLinkInfo(src, dst);
 	
-	it = (mac_pkt_discard).begin();
-	
-	for (; it != (mac_pkt_discard).end(); it++) {
+	if (info == 0) {
+		
+		return 0;
+	}
 	
-		spktType = it->first;
+	return info->mac_data_tx_;
+}
 
-		if (spktType != SUNSET_STAT_DATA) {
-		
-			continue;
-			
-		}
 
-		it1 = (it->second).begin();
-		
-		for (; it1 != (it->second).end(); it1++) {
+/*!
+ * 	@brief The getMacDataPacketReceptions() function returns the number of data packets received at the MAC layer, transmitted on the link from the src node to the dst node. 
+ *	@param src The source node of the link.
+ *	@param dst The destination of the link. 
+ *	@retval result The number of data packets received at the MAC layer on the link from the src node to the destination node.
+ */
+int Sunset_Protocol_Statistics::getMacDataPacketReceptions(int src, int dst) 
+{
+	stat_link_info* info = findLinkInfo(src, dst);
+	
+	if (info == 0) {
 		
-			node_src = it1->first;
-			
-		        if (node_src != src) {
-			
-				continue;
-			
-			}         
-			
-			it2 = (it1->second).begin();
-			
-			for (; it2 != (it1->second).end(); it2++) {
-			
-				node_dst = it2->first;
-
-				if (node_dst != dst) {
-				
-					continue;
-				
-				}         
-				
-				it3 = (it2->second).begin();
-				
-				for (; it3 != (it2->second).end(); it3++) {
-				
-					if (spktType == SUNSET_STAT_DATA) {
-					
-						mac_data_discarded += it3->first * (it3->second).size();
-					}
-				}
-			}
-		}
+		return 0;
 	}
 	
-	return mac_data_discarded;
+	return info->mac_data_rx_;
 }
 
 
-
 /*!
- * 	@brief The getMacCtrlPacketTransmissions() function returns the number of control packets transmitted at the MAC layer, by the src node to the dst node. 
+ * 	@brief The getCreatedMacDataBytes() function returns the number of data bytes received at the MAC layer, generated at the upper layer to be transmitted on the link from the src node to the dst node. 
  *	@param src The source node of the link.
  *	@param dst The destination of the link. 
- *	@retval result The number of control packets transmitted at the MAC layer by the src node to the destination node.
+ *	@retval result The number of data bytes received at the MAC layer for transmission from the src node to the destination node.
  */
 
-int Sunset_Protocol_Statistics::getMacCtrlPacketTransmissions(int src, int dst) 
+int Sunset_Protocol_Statistics::getCreatedMacDataBytes(int src, int dst) 
 {
-	int node_src = -1;
-	int node_dst = -1;
-	sunset_statisticPktType spktType = SUNSET_STAT_NONE;
-	int size = -1;
-	int mac_ctrl_tx = 0;
-	map < sunset_statisticPktType, map <int, map <int, map <int, list <double> > > > >::iterator it;
-	map <int, map <int, map <int, list <double> > > >::iterator it1;
-	map <int, map <int, list <double> > >::iterator it2;
-	map <int, list <double> >::iterator it3;
-	
-	it = (tx_done).begin();
+	stat_link_info* info = findLinkInfo(src, dst);
 	
-	for (; it != (tx_done).end(); it++) {
+	if (info == 0) {
+		
+		return 0;
+	}
 	
-		spktType = it->first;
+	return info->mac_data_new_bytes_;
+}
 
-		if (spktType == SUNSET_STAT_DATA || spktType == SUNSET_STAT_NONE) {
-		
-			continue;
-			
-		}
 
-		it1 = (it->second).begin();
-		
-		for (; it1 != (it->second).end(); it1++) {
-		
-			node_src = it1->first;
-			
-		        if (node_src != src) {
-			
-				continue;
-			
-			}         
-			
-			it2 = (it1->second).begin();
-			
-			for (; it2 != (it1->second).end(); it2++) {
-			
-				node_dst = it2->first;
+/*!
+ * 	@brief The getMacDataBytesTransmissions() function returns the number of data bytes transmitted at the MAC layer, from the src node to the dst node. 
+ *	@param src The source node of the link.
+ *	@param dst The destination of the link. 
+ *	@retval result The number of data bytes transmitted by the src node to the destination node.
+ */
 
-				if (node_dst != dst) { //TODO check if broadcast has to be added
-				
-					continue;
-				
-				}         
-				
-				it3 = (it2->second).begin();
-				
-				for (; it3 != (it2->second).end(); it3++) {
-				
-// 					if (spktType == SUNSET_STAT_DATA) {
-					
-						mac_ctrl_tx += (it3->second).size();
-// 					}
-				}
-			}
-		}
+int Sunset_Protocol_Statistics::getMacDataBytesTransmissions(int src, int dst) 
+{
+	stat_link_info* info = findLinkInfo(src, dst);
+	
+	if (info == 0) {
+		
+		return 0;
 	}
 	
-	return mac_ctrl_tx;
+	return info->mac_data_tx_bytes_;
 }
 
+
 /*!
- * 	@brief The getMacCtrlPacketReceptions() function returns the number of control packets received at the MAC layer, transmitted on the link from the src node to the dst node. 
+ * 	@brief The getMacDataBytesReceptions() function returns the number of data bytes received at the MAC layer, transmitted on the link from the src node to the dst node. 
  *	@param src The source node of the link.
  *	@param dst The destination of the link. 
- *	@retval result The number of control packets received at the MAC layer on the link from the src node to the destination node.
+ *	@retval result The number of data bytes received at the MAC layer on the link from the src node to the destination node.
  */
 
-int Sunset_Protocol_Statistics::getMacCtrlPacketReceptions(int src, int dst) 
+int Sunset_Protocol_Statistics::getMacDataBytesReceptions(int src, int dst) 
 {
-	int node = -1;
-	int node_src = -1;
-	int node_dst = -1;
-	sunset_statisticPktType spktType = SUNSET_STAT_NONE;
-	int size = -1;
-	int pkt_received = 0;
-	
-	map < sunset_statisticPktType, map <int, map <int, map <int, map <int, list < pair<double, double> > > > > > > ::iterator it;
-	map <int, map <int, map <int, map <int, list < pair<double, double> > > > > >::iterator it1;
-	map <int, map <int, map <int, list < pair<double, double> > > > >::iterator it2;
-	map <int, map <int, list < pair<double, double> > > >::iterator it3;
-	map <int, list < pair<double, double> > >::iterator it4;
+	stat_link_info* info = findLinkInfo(src, dst);
 	
-	it = mac_pkt_recv.begin();
-	
-	for (; it != mac_pkt_recv.end(); it++) {
+	if (info == 0) {
+		
+		return 0;
+	}
 	
-		spktType = it->first;
+	return info->mac_data_rx_bytes_;
+}
 
-		if (spktType == SUNSET_STAT_DATA || spktType == SUNSET_STAT_NONE) {
-		
-			continue;
-			
-		}
-		
-		it1 = (it->second).begin();
-		
-		for (; it1 != (it->second).end(); it1++) {
-		
-			node = it1->first;
-			
-			if (node != dst && dst != Sunset_Address::getBroadcastAddress()) { //TODO check if broadcast has to be added
-			
-				continue;
-				
-			}
-			
-			it2 = (it1->second).begin();
-			
-			for (; it2 != (it1->second).end(); it2++) {
-			
-				node_src = it2->first;
 
-				if (node_src != src) {
-				
-					continue;
-					
-				}
-				
-				it3 = (it2->second).begin();
-				
-				for (; it3 != (it2->second).end(); it3++) {
-				
-					node_dst = it3->first;
+/*!
+ * 	@brief The getMacDataPacketDiscarded() function returns the number of data packets discarded at the MAC layer, by the src node addressed to dst node. 
+ *	@param src The source node of the link.
+ *	@param dst The destination of the link. 
+ *	@retval result The number of data packets discarded at the MAC layer by the src node addressed to dst node..
+ */
 
-					if (node_dst != dst) {
-					
-						continue;
-						
-					}
-					
-					it4 = (it3->second).begin();
-					
-					for (; it4 != (it3->second).end(); it4++) {
-					
-						pkt_received += (it4->second).size(); 
-						
-					}
-				}
-			}
-		}
+int Sunset_Protocol_Statistics::getMacDataPacketDiscarded(int src, int dst) 
+{
+	stat_link_info* info = findLinkInfo(src, dst);
+	
+	if (info == 0) {
+		
+		return 0;
 	}
 	
-	return pkt_received;
+	return info->mac_data_discarded_;
 }
 
 
-
 /*!
- * 	@brief The getMacCtrlBytesTransmissions() function returns the number of control bytes transmitted at the MAC layer, by the src node to the dst node. 
+ * 	@brief The getMacDataBytesDiscarded() function returns the number of data bytes discarded at the MAC layer, by the src node addressed to dst node. 
  *	@param src The source node of the link.
  *	@param dst The destination of the link. 
- *	@retval result The number of control bytes transmitted at the MAC layer by the src node to the destination node.
+ *	@retval result The number of data pabytescket discarded at the MAC layer by the src node addressed to dst node..
  */
 
-int Sunset_Protocol_Statistics::getMacCtrlBytesTransmissions(int src, int dst) 
+int Sunset_Protocol_Statistics::getMacDataBytesDiscarded(int src, int dst) 
 {
-	int node_src = -1;
-	int node_dst = -1;
-	sunset_statisticPktType spktType = SUNSET_STAT_NONE;
-	int size = -1;
-	int mac_ctrl_tx = 0;
-	map < sunset_statisticPktType, map <int, map <int, map <int, list <double> > > > >::iterator it;
-	map <int, map <int, map <int, list <double> > > >::iterator it1;
-	map <int, map <int, list <double> > >::iterator it2;
-	map <int, list <double> >::iterator it3;
-	
-	it = (tx_done).begin();
-	
-	for (; it != (tx_done).end(); it++) {
+	stat_link_info* info = findLinkInfo(src, dst);
 	
-		spktType = it->first;
-
-		if (spktType == SUNSET_STAT_DATA || spktType == SUNSET_STAT_NONE) {
+	if (info == 0) {
 		
-			continue;
-			
-		}
+		return 0;
+	}
+	
+	return info->mac_data_discarded_bytes_;
+}
 
-		it1 = (it->second).begin();
-		
-		for (; it1 != (it->second).end(); it1++) {
-		
-			node_src = it1->first;
-			
-		        if (node_src != src) {
-			
-				continue;
-			
-			}         
-			
-			it2 = (it1->second).begin();
-			
-			for (; it2 != (it1->second).end(); it2++) {
-			
-				node_dst = it2->first;
 
-				if (node_dst != dst) {
-				
-					continue;
-				
-				}         
-				
-				it3 = (it2->second).begin();
-				
-				for (; it3 != (it2->second).end(); it3++) {
-				
-					if (spktType == SUNSET_STAT_DATA) {
-					
-						mac_ctrl_tx += it3->first * (it3->second).size();
-					}
-				}
-			}
-		}
+/*!
+ * 	@brief The getMacCtrlPacketTransmissions() function returns the number of control packets transmitted at the MAC layer, by the src node to the dst node. 
+ *	@param src The source node of the link.
+ *	@param dst The destination of the link. 
+ *	@retval result The number of control packets transmitted at the MAC layer by the src node to the destination node.
+ */
+
+int Sunset_Protocol_Statistics::getMacCtrlPacketTransmissions(int src, int dst) 
+{
+	stat_link_info* info = findLinkInfo(src, dst);
+	
+	if (info == 0) {
+		
+		return 0;
 	}
 	
-	return mac_ctrl_tx;
+	return info->mac_ctrl_tx_;
 }
 
+
 /*!
- * 	@brief The getMacCtrlBytesReceptions() function returns the number of control byes received at the MAC layer, transmitted on the link from the src node to the dst node. 
+ * 	@brief The getMacCtrlPacketReceptions() function returns the number of control packets received at the MAC layer, transmitted on the link from the src node to the dst node. 
  *	@param src The source node of the link.
  *	@param dst The destination of the link. 
- *	@retval result The number of control bytes received at the MAC layer on the link from the src node to the destination node.
+ *	@retval result The number of control packets received at the MAC layer on the link from the src node to the destination node.
  */
 
-int Sunset_Protocol_Statistics::getMacCtrlBytesReceptions(int src, int dst) 
+int Sunset_Protocol_Statistics::getMacCtrlPacketReceptions(int src, int dst) 
 {
-	int node = -1;
-	int node_src = -1;
-	int node_dst = -1;
-	sunset_statisticPktType spktType = SUNSET_STAT_NONE;
-	int size = -1;
-	int pkt_received = 0;
+	stat_link_info* info = findLinkInfo(src, dst);
 	
-	map < sunset_statisticPktType, map <int, map <int, map <int, map <int, list < pair<double, double> > > > > > > ::iterator it;
-	map <int, map <int, map <int, map <int, list < pair<double, double> > > > > >::iterator it1;
-	map <int, map <int, map <int, list < pair<double, double> > > > >::iterator it2;
-	map <int, map <int, list < pair<double, double> > > >::iterator it3;
-	map <int, list < pair<double, double> > >::iterator it4;
+	if (info == 0) {
+		
+		return 0;
+	}
 	
-	it = mac_pkt_recv.begin();
+	return info->mac_ctrl_rx_;
+}
+
+
+/*!
+ * 	@brief The getMacCtrlBytesTransmissions() function returns the number of control bytes transmitted at the MAC layer, by the src node to the dst node. 
+ *	@param src The source node of the link.
+ *	@param dst The destination of the link. 
+ *	@retval result The number of control bytes transmitted at the MAC layer by the src node to the destination node.
+ */
+
+int Sunset_Protocol_Statistics::getMacCtrlBytesTransmissions(int src, int dst) 
+{
+	stat_link_info* info = findLinkInfo(src, dst);
 	
-	for (; it != mac_pkt_recv.end(); it++) {
+	if (info == 0) {
+		
+		return 0;
+	}
 	
-		spktType = it->first;
+	return info->mac_ctrl_tx_bytes_;
+}
 
-		if (spktType == SUNSET_STAT_DATA || spktType == SUNSET_STAT_NONE) {
-		
-			continue;
-			
-		}
-		
-		it1 = (it->second).begin();
-		
-		for (; it1 != (it->second).end(); it1++) {
-		
-			node = it1->first;
-			
-			if (node != dst && dst != Sunset_Address::getBroadcastAddress()) {
-			
-				continue;
-				
-			}
-			
-			it2 = (it1->second).begin();
-			
-			for (; it2 != (it1->second).end(); it2++) {
-			
-				node_src = it2->first;
 
-				if (node_src != src) {
-				
-					continue;
-					
-				}
-				
-				it3 = (it2->second).begin();
-				
-				for (; it3 != (it2->second).end(); it3++) {
-				
-					node_dst = it3->first;
+/*!
+ * 	@brief The getMacCtrlBytesReceptions() function returns the number of control byes received at the MAC layer, transmitted on the link from the src node to the dst node. 
+ *	@param src The source node of the link.
+ *	@param dst The destination of the link. 
+ *	@retval result The number of control bytes received at the MAC layer on the link from the src node to the destination node.
+ */
 
-					if (node_dst != dst) {
-					
-						continue;
-						
-					}
-					
-					it4 = (it3->second).begin();
-					
-					for (; it4 != (it3->second).end(); it4++) {
-					
-						pkt_received += it4->first * (it4->second).size(); 
-						
-					}
-				}
-			}
-		}
+int Sunset_Protocol_Statistics::getMacCtrlBytesReceptions(int src, int dst) 
+{
+	stat_link_info* info = findLinkInfo(src, dst);
+	
+	if (info == 0) {
+		
+		return 0;
 	}
 	
-	return pkt_received;
+	return info->mac_ctrl_rx_bytes_;
 }
 
+
 /*!
  * 	@brief The getMacCtrlPacketDiscarded() function returns the number of control packets discarded at the MAC layer, by the src node addressed to dst node. 
  *	@param src The source node of the link.
@@ -3375,66 +2268,14 @@ int Sunset_Protocol_Statistics::getMacCtrlBytesReceptions(int src, int dst)
 
 int Sunset_Protocol_Statistics::getMacCtrlPacketDiscarded(int src, int dst) 
 {
-	int node_src = -1;
-	int node_dst = -1;
-	sunset_statisticPktType spktType = SUNSET_STAT_NONE;
-	int size = -1;
-	int mac_ctrl_discarded = 0;
-	map < sunset_statisticPktType, map <int, map <int, map <int, list <double> > > > >::iterator it;
-	map <int, map <int, map <int, list <double> > > >::iterator it1;
-	map <int, map <int, list <double> > >::iterator it2;
-	map <int, list <double> >::iterator it3;
-	
-	it = (mac_pkt_discard).begin();
+	stat_link_info* info = findLinkInfo(src, dst);
 	
-	for (; it != (mac_pkt_discard).end(); it++) {
-	
-		spktType = it->first;
-
-		if (spktType == SUNSET_STAT_DATA || spktType == SUNSET_STAT_NONE) {
-		
-			continue;
-			
-		}
-
-		it1 = (it->second).begin();
-		
-		for (; it1 != (it->second).end(); it1++) {
+	if (info == 0) {
 		
-			node_src = it1->first;
-			
-		        if (node_src != src) {
-			
-				continue;
-			
-			}         
-			
-			it2 = (it1->second).begin();
-			
-			for (; it2 != (it1->second).end(); it2++) {
-			
-				node_dst = it2->first;
-
-				if (node_dst != dst) {
-				
-					continue;
-				
-				}         
-				
-				it3 = (it2->second).begin();
-				
-				for (; it3 != (it2->second).end(); it3++) {
-				
-					if (spktType == SUNSET_STAT_DATA) {
-					
-						mac_ctrl_discarded += (it3->second).size();
-					}
-				}
-			}
-		}
+		return 0;
 	}
 	
-	return mac_ctrl_discarded;
+	return info->mac_ctrl_discarded_;
 }
 
 
@@ -3447,68 +2288,17 @@ int Sunset_Protocol_Statistics::getMacCtrlPacketDiscarded(int src, int dst)
 
 int Sunset_Protocol_Statistics::getMacCtrlBytesDiscarded(int src, int dst) 
 {
-	int node_src = -1;
-	int node_dst = -1;
-	sunset_statisticPktType spktType = SUNSET_STAT_NONE;
-	int size = -1;
-	int mac_ctrl_discarded = 0;
-	map < sunset_statisticPktType, map <int, map <int, map <int, list <double> > > > >::iterator it;
-	map <int, map <int, map <int, list <double> > > >::iterator it1;
-	map <int, map <int, list <double> > >::iterator it2;
-	map <int, list <double> >::iterator it3;
-	
-	it = (mac_pkt_discard).begin();
+	stat_link_info* info = findLinkInfo(src, dst);
 	
-	for (; it != (mac_pkt_discard).end(); it++) {
-	
-		spktType = it->first;
-
-		if (spktType == SUNSET_STAT_DATA || spktType == SUNSET_STAT_NONE) {
-		
-			continue;
-			
-		}
-
-		it1 = (it->second).begin();
-		
-		for (; it1 != (it->second).end(); it1++) {
+	if (info == 0) {
 		
-			node_src = it1->first;
-			
-		        if (node_src != src) {
-			
-				continue;
-			
-			}         
-			
-			it2 = (it1->second).begin();
-			
-			for (; it2 != (it1->second).end(); it2++) {
-			
-				node_dst = it2->first;
-
-				if (node_dst != dst) {
-				
-					continue;
-				
-				}         
-				
-				it3 = (it2->second).begin();
-				
-				for (; it3 != (it2->second).end(); it3++) {
-				
-					if (spktType == SUNSET_STAT_DATA) {
-					
-						mac_ctrl_discarded += it3->first * (it3->second).size();
-					}
-				}
-			}
-		}
+		return 0;
 	}
 	
-	return mac_ctrl_discarded;
+	return info->mac_ctrl_discarded_bytes_;
 }
 
+
 /*!
  * 	@brief The getPDR() function returns the packet delivery ratio between src node and dst node. 
  *	@param src The source node of the packet.
@@ -3558,29 +2348,33 @@ double Sunset_Protocol_Statistics::getPDR()
 double Sunset_Protocol_Statistics::getGeneratedPacket()
 {
 	int pkt_tx = 0;
-
-	for (int src = 0; src <= max_node_id; src++) {
-
-		for (int dst = 0; dst <= max_node_id; dst++) {
+	int src = -1;
+	int dst = -1;
+	
+	map <int, map <int, stat_link_info> >::iterator it;
+	map <int, stat_link_info>::iterator it1;
+	
+	for (it = link_info.begin(); it != link_info.end(); it++) {
 		
-			if (src != dst) {
-				
-				pkt_tx += getGeneratedPacket(src, dst);
+		src = it->first;
+		
+		for (it1 = (it->second).begin(); it1 != (it->second).end(); it1++) {
+			
+			dst = it1->first;
+			
+			if (!isReportedLink(src, dst, true)) {
 				
+				continue;
 			}
-		}
-
-		if (Sunset_Address::getBroadcastAddress() > max_node_id || Sunset_Address::getBroadcastAddress() < 0) {
-			
-				pkt_tx += getGeneratedPacket(src, Sunset_Address::getBroadcastAddress());			
 			
+			pkt_tx += getGeneratedPacket(src, dst);
 		}
 	}
 	
-		
 	return pkt_tx;
 }
 
+
 /*!
  * 	@brief The getMacDataPacketTransmissions() function returns the number of data packets transmitted at the MAC layer.
  *	@retval result The number of data packets generated at the MAC layer.
@@ -3589,29 +2383,33 @@ double Sunset_Protocol_Statistics::getGeneratedPacket()
 double Sunset_Protocol_Statistics::getMacDataPacketTransmissions()
 {
 	int pkt_tx = 0;
-
-	for (int src = 0; src <= max_node_id; src++) {
-
-		for (int dst = 0; dst <= max_node_id; dst++) {
+	int src = -1;
+	int dst = -1;
+	
+	map <int, map <int, stat_link_info> >::iterator it;
+	map <int, stat_link_info>::iterator it1;
+	
+	for (it = link_info.begin(); it != link_info.end(); it++) {
 		
-			if (src != dst) {
-				
-				pkt_tx += getMacDataPacketTransmissions(src, dst);
+		src = it->first;
+		
+		for (it1 = (it->second).begin(); it1 != (it->second).end(); it1++) {
+			
+			dst = it1->first;
+			
+			if (!isReportedLink(src, dst, true)) {
 				
+				continue;
 			}
-		}
-
-		if (Sunset_Address::getBroadcastAddress() > max_node_id || Sunset_Address::getBroadcastAddress() < 0) {
-			
-				pkt_tx += getMacDataPacketTransmissions(src, Sunset_Address::getBroadcastAddress());			
 			
+			pkt_tx += getMacDataPacketTransmissions(src, dst);
 		}
 	}
 	
-		
 	return pkt_tx;
 }
 
+
 /*!
  * 	@brief The getMacCtrlPacketTransmissions() function returns the number of ctrl packets transmitted at the MAC layer.
  *	@retval result The number of ctrl packets generated at the MAC layer.
@@ -3620,29 +2418,33 @@ double Sunset_Protocol_Statistics::getMacDataPacketTransmissions()
 double Sunset_Protocol_Statistics::getMacCtrlPacketTransmissions()
 {
 	int pkt_tx = 0;
-
-	for (int src = 0; src <= max_node_id; src++) {
-
-		for (int dst = 0; dst <= max_node_id; dst++) {
+	int src = -1;
+	int dst = -1;
+	
+	map <int, map <int, stat_link_info> >::iterator it;
+	map <int, stat_link_info>::iterator it1;
+	
+	for (it = link_info.begin(); it != link_info.end(); it++) {
 		
-			if (src != dst) {
-				
-				pkt_tx += getMacCtrlPacketTransmissions(src, dst);
+		src = it->first;
+		
+		for (it1 = (it->second).begin(); it1 != (it->second).end(); it1++) {
+			
+			dst = it1->first;
+			
+			if (!isReportedLink(src, dst, true)) {
 				
+				continue;
 			}
-		}
-
-		if (Sunset_Address::getBroadcastAddress() > max_node_id || Sunset_Address::getBroadcastAddress() < 0) {
-			
-				pkt_tx += getMacCtrlPacketTransmissions(src, Sunset_Address::getBroadcastAddress());			
 			
+			pkt_tx += getMacCtrlPacketTransmissions(src, dst);
 		}
 	}
 	
-		
 	return pkt_tx;
 }
 
+
 /*!
  * 	@brief The getMacDataPacketReceptions() function returns the number of data packets received at the MAC layer.
  *	@retval result The number of data packets received at the MAC layer.
@@ -3651,29 +2453,33 @@ double Sunset_Protocol_Statistics::getMacCtrlPacketTransmissions()
 double Sunset_Protocol_Statistics::getMacDataPacketReceptions()
 {
 	int pkt_rx = 0;
-
-	for (int src = 0; src <= max_node_id; src++) {
-
-		for (int dst = 0; dst <= max_node_id; dst++) {
+	int src = -1;
+	int dst = -1;
+	
+	map <int, map <int, stat_link_info> >::iterator it;
+	map <int, stat_link_info>::iterator it1;
+	
+	for (it = link_info.begin(); it != link_info.end(); it++) {
 		
-			if (src != dst) {
-				
-				pkt_rx += getMacDataPacketReceptions(src, dst);
+		src = it->first;
+		
+		for (it1 = (it->second).begin(); it1 != (it->second).end(); it1++) {
+			
+			dst = it1->first;
+			
+			if (!isReportedLink(src, dst, true)) {
 				
+				continue;
 			}
-		}
-
-		if (Sunset_Address::getBroadcastAddress() > max_node_id || Sunset_Address::getBroadcastAddress() < 0) {
-			
-				pkt_rx += getMacDataPacketReceptions(src, Sunset_Address::getBroadcastAddress());			
 			
+			pkt_rx += getMacDataPacketReceptions(src, dst);
 		}
 	}
 	
-		
 	return pkt_rx;
 }
 
+
 /*!
  * 	@brief The getMacCtrlPacketReceptions() function returns the number of ctrl packets received at the MAC layer.
  *	@retval result The number of ctrl packets received at the MAC layer.
@@ -3682,29 +2488,33 @@ double Sunset_Protocol_Statistics::getMacDataPacketReceptions()
 double Sunset_Protocol_Statistics::getMacCtrlPacketReceptions()
 {
 	int pkt_rx = 0;
-
-	for (int src = 0; src <= max_node_id; src++) {
-
-		for (int dst = 0; dst <= max_node_id; dst++) {
+	int src = -1;
+	int dst = -1;
+	
+	map <int, map <int, stat_link_info> >::iterator it;
+	map <int, stat_link_info>::iterator it1;
+	
+	for (it = link_info.begin(); it != link_info.end(); it++) {
 		
-			if (src != dst) {
-				
-				pkt_rx += getMacCtrlPacketReceptions(src, dst);
+		src = it->first;
+		
+		for (it1 = (it->second).begin(); it1 != (it->second).end(); it1++) {
+			
+			dst = it1->first;
+			
+			if (!isReportedLink(src, dst, true)) {
 				
+				continue;
 			}
-		}
-
-		if (Sunset_Address::getBroadcastAddress() > max_node_id || Sunset_Address::getBroadcastAddress() < 0) {
-			
-				pkt_rx += getMacCtrlPacketReceptions(src, Sunset_Address::getBroadcastAddress());			
 			
+			pkt_rx += getMacCtrlPacketReceptions(src, dst);
 		}
 	}
 	
-		
 	return pkt_rx;
 }
 
+
 /*!
  * 	@brief The getDeliveredPacket() function returns the number of data packets correctly delivered at the application layer with no repetitions.
  *	@retval result The number of data packets correctly delivered at the application layer with no repetitions.
@@ -3713,22 +2523,33 @@ double Sunset_Protocol_Statistics::getMacCtrlPacketReceptions()
 double Sunset_Protocol_Statistics::getDeliveredPacket()
 {
 	int pkt_rx = 0;
-
-	for (int src = 0; src <= max_node_id; src++) {
-
-		for (int dst = 0; dst <= max_node_id; dst++) {
+	int src = -1;
+	int dst = -1;
+	
+	map <int, map <int, stat_link_info> >::iterator it;
+	map <int, stat_link_info>::iterator it1;
+	
+	for (it = link_info.begin(); it != link_info.end(); it++) {
 		
-			if (src != dst) {
-				
-				pkt_rx += getDeliveredPacket(src, dst);
+		src = it->first;
+		
+		for (it1 = (it->second).begin(); it1 != (it->second).end(); it1++) {
+			
+			dst = it1->first;
+			
+			if (!isReportedLink(src, dst, false)) {
 				
+				continue;
 			}
+			
+			pkt_rx += getDeliveredPacket(src, dst);
 		}
 	}
-		
+	
 	return pkt_rx;
 }
 
+
 /*!
  * 	@brief The getGeneratedPacket() function returns the number of data packets generated at the application layer by the src node.
  *	@param src The source node of the packet.
@@ -3738,25 +2559,30 @@ double Sunset_Protocol_Statistics::getDeliveredPacket()
 double Sunset_Protocol_Statistics::getGeneratedPacket(int src)
 {
 	int pkt_tx = 0;
-
-	for (int dst = 0; dst <= max_node_id; dst++) {
+	int dst = -1;
+	map <int, stat_link_info>::iterator it1;
 	
-		if (src != dst) {
-			
-			pkt_tx += getGeneratedPacket(src, dst);
-			
-		}
+	if (link_info.find(src) == link_info.end()) {
+		
+		return pkt_tx;
 	}
-
-	if (Sunset_Address::getBroadcastAddress() > max_node_id || Sunset_Address::getBroadcastAddress() < 0) {
+	
+	for (it1 = link_info[src].begin(); it1 != link_info[src].end(); it1++) {
+		
+		dst = it1->first;
 		
-			pkt_tx += getGeneratedPacket(src, Sunset_Address::getBroadcastAddress());			
+		if (!isReportedDestination(src, dst, true)) {
+			
+			continue;
+		}
 		
+		pkt_tx += getGeneratedPacket(src, dst);
 	}
-
+	
 	return pkt_tx;
 }
 
+
 /*!
  * 	@brief The getDeliveredPacket() function returns the number of data packets correctly delivered at the application layer with no repetitions generated by the src node.
  *	@param src The source node of the packet.
@@ -3766,19 +2592,30 @@ double Sunset_Protocol_Statistics::getGeneratedPacket(int src)
 double Sunset_Protocol_Statistics::getDeliveredPacket(int src)
 {
 	int pkt_rx = 0;
-
-	for (int dst = 0; dst <= max_node_id; dst++) {
+	int dst = -1;
+	map <int, stat_link_info>::iterator it1;
 	
-		if (src != dst) {
-			
-			pkt_rx += getDeliveredPacket(src, dst);
+	if (link_info.find(src) == link_info.end()) {
+		
+		return pkt_rx;
+	}
+	
+	for (it1 = link_info[src].begin(); it1 != link_info[src].end(); it1++) {
+		
+		dst = it1->first;
+		
+		if (!isReportedDestination(src, dst, false)) {
 			
+			continue;
 		}
-	}
 		
+		pkt_rx += getDeliveredPacket(src, dst);
+	}
+	
 	return pkt_rx;
 }
 
+
 /*!
  * 	@brief The getApplicationThroughput() function returns the throughput at the application layer between the src node to the dst node. 
  *	@param src The source node of the packet.
@@ -3810,29 +2647,39 @@ double Sunset_Protocol_Statistics::getApplicationThroughput(int src, int dst)
 double Sunset_Protocol_Statistics::getApplicationThroughput()
 {
 	double time = getExperimentTime();
+	int pkt_rx = 0;
+	int src = -1;
+	int dst = -1;
+	
+	map <int, map <int, stat_link_info> >::iterator it;
+	map <int, stat_link_info>::iterator it1;
 	
 	if (time <= 0) {
 		
 		return 0.0;
 	}
 	
-	int pkt_rx = 0;
-	
-	for (int src = 0; src <= max_node_id; src++) {
-
-		for (int dst = 0; dst <= max_node_id; dst++) {
+	for (it = link_info.begin(); it != link_info.end(); it++) {
 		
-			if (src != dst) {
-				
-				pkt_rx += getDeliveredBytes(src, dst) * 8.0;
+		src = it->first;
+		
+		for (it1 = (it->second).begin(); it1 != (it->second).end(); it1++) {
+			
+			dst = it1->first;
 			
+			if (!isReportedLink(src, dst, false)) {
+				
+				continue;
 			}
+			
+			pkt_rx += getDeliveredBytes(src, dst) * 8.0;
 		}
 	}
 	
 	return pkt_rx / time;
 }
 
+
 /*!
  * 	@brief The getPacketLatency() function returns the average end-to-end packet latency in the network.
  *	@retval result The average end-to-end packet latency in the network.
@@ -3843,22 +2690,31 @@ double Sunset_Protocol_Statistics::getPacketLatency()
 	double aux_val = 0.0;
 	double pkt_latency = 0;
 	int count = 0;
-	for (int src = 0; src <= max_node_id; src++) {
-
-		for (int dst = 0; dst <= max_node_id; dst++) {
+	int src = -1;
+	int dst = -1;
+	
+	map <int, map <int, stat_link_info> >::iterator it;
+	map <int, stat_link_info>::iterator it1;
+	
+	for (it = link_info.begin(); it != link_info.end(); it++) {
 		
-			if (src != dst) {
-				
-				aux_val = getPacketLatency(src, dst);
-				
-				if (aux_val > 0.0) {
-					
-					pkt_latency += aux_val;
-					
-					count++;
+		src = it->first;
+		
+		for (it1 = (it->second).begin(); it1 != (it->second).end(); it1++) {
+			
+			dst = it1->first;
+			
+			if (!isReportedLink(src, dst, false)) {
 				
-				}
+				continue;
+			}
+			
+			aux_val = getPacketLatency(src, dst);
 			
+			if (aux_val > 0.0) {
+				
+				pkt_latency += aux_val;
+				count++;
 			}
 		}
 	}
@@ -3871,6 +2727,7 @@ double Sunset_Protocol_Statistics::getPacketLatency()
 	return 0.0;
 }
 
+
 /*!
  * 	@brief The getDuplicatedPacketLatency() function returns the average end-to-end packet latency in the network for the reception of duplicated packets.
  *	@retval result The average end-to-end packet latency in the network for the reception of duplicated packets.
@@ -3881,22 +2738,31 @@ double Sunset_Protocol_Statistics::getDuplicatedPacketLatency()
 	double aux_val = 0.0;
 	double pkt_latency = 0;
 	int count = 0;
-	for (int src = 0; src <= max_node_id; src++) {
-
-		for (int dst = 0; dst <= max_node_id; dst++) {
+	int src = -1;
+	int dst = -1;
+	
+	map <int, map <int, stat_link_info> >::iterator it;
+	map <int, stat_link_info>::iterator it1;
+	
+	for (it = link_info.begin(); it != link_info.end(); it++) {
 		
-			if (src != dst) {
-				
-				aux_val = getDuplicatedPacketLatency(src, dst);
-				
-				if (aux_val > 0.0) {
-					
-					pkt_latency += aux_val;
-					
-					count++;
+		src = it->first;
+		
+		for (it1 = (it->second).begin(); it1 != (it->second).end(); it1++) {
+			
+			dst = it1->first;
+			
+			if (!isReportedLink(src, dst, false)) {
 				
-				}
+				continue;
+			}
+			
+			aux_val = getDuplicatedPacketLatency(src, dst);
 			
+			if (aux_val > 0.0) {
+				
+				pkt_latency += aux_val;
+				count++;
 			}
 		}
 	}
@@ -3909,6 +2775,7 @@ double Sunset_Protocol_Statistics::getDuplicatedPacketLatency()
 	return 0.0;
 }
 
+
 /*!
  * 	@brief The getRouteLength() function returns the average route length for packets delivered in the network, with no repetitions.
  *	@retval result The average route length for packets delivered in the network.
@@ -3919,22 +2786,31 @@ double Sunset_Protocol_Statistics::getRouteLength()
 	double aux_val = 0.0;
 	double route_len = 0;
 	int count = 0;
-	for (int src = 0; src <= max_node_id; src++) {
-
-		for (int dst = 0; dst <= max_node_id; dst++) {
+	int src = -1;
+	int dst = -1;
+	
+	map <int, map <int, stat_link_info> >::iterator it;
+	map <int, stat_link_info>::iterator it1;
+	
+	for (it = link_info.begin(); it != link_info.end(); it++) {
 		
-			if (src != dst) {
-				
-				aux_val = getRouteLength(src, dst);
-				
-				if (aux_val > 0.0) {
-					
-					route_len += aux_val;
-					
-					count++;
+		src = it->first;
+		
+		for (it1 = (it->second).begin(); it1 != (it->second).end(); it1++) {
+			
+			dst = it1->first;
+			
+			if (!isReportedLink(src, dst, false)) {
 				
-				}
+				continue;
+			}
+			
+			aux_val = getRouteLength(src, dst);
 			
+			if (aux_val > 0.0) {
+				
+				route_len += aux_val;
+				count++;
 			}
 		}
 	}
@@ -3947,6 +2823,7 @@ double Sunset_Protocol_Statistics::getRouteLength()
 	return 0.0;
 }
 
+
 /*!
  * 	@brief The getNumRoutes() function returns the number of different routes used in the network when delivering data packets to the destination node. 
  *	@retval result The number of differente routes used in the network.
@@ -3957,22 +2834,31 @@ double Sunset_Protocol_Statistics::getNumRoutes()
 	double aux_val = 0.0;
 	double routes = 0;
 	int count = 0;
-	for (int src = 0; src <= max_node_id; src++) {
-
-		for (int dst = 0; dst <= max_node_id; dst++) {
+	int src = -1;
+	int dst = -1;
+	
+	map <int, map <int, stat_link_info> >::iterator it;
+	map <int, stat_link_info>::iterator it1;
+	
+	for (it = link_info.begin(); it != link_info.end(); it++) {
 		
-			if (src != dst) {
-				
-				aux_val = getNumRoutes(src, dst);
-				
-				if (aux_val > 0.0) {
-					
-					routes += aux_val;
-					
-					count++;
+		src = it->first;
+		
+		for (it1 = (it->second).begin(); it1 != (it->second).end(); it1++) {
+			
+			dst = it1->first;
+			
+			if (!isReportedLink(src, dst, false)) {
 				
-				}
+				continue;
+			}
+			
+			aux_val = getNumRoutes(src, dst);
 			
+			if (aux_val > 0.0) {
+				
+				routes += aux_val;
+				count++;
 			}
 		}
 	}
@@ -3985,6 +2871,7 @@ double Sunset_Protocol_Statistics::getNumRoutes()
 	return 0.0;
 }
 
+
 /*!
  * 	@brief The getMaxRouteLength() function returns the maximal route length in the network.
  *	@retval result The  maximal route length in the network.
@@ -3993,40 +2880,46 @@ double Sunset_Protocol_Statistics::getNumRoutes()
 double Sunset_Protocol_Statistics::getMaxRouteLength()
 {
 	double aux_val = 0.0;
-	
 	double max_route_len = 0;
-	
 	int count = 0;
-
-	for (int src = 0; src <= max_node_id; src++) {
-
-		for (int dst = 0; dst <= max_node_id; dst++) {
+	int src = -1;
+	int dst = -1;
+	
+	map <int, map <int, stat_link_info> >::iterator it;
+	map <int, stat_link_info>::iterator it1;
+	
+	for (it = link_info.begin(); it != link_info.end(); it++) {
 		
-			if (src != dst) {
-				
-				aux_val = (double) getMaxRouteLength(src, dst);
+		src = it->first;
+		
+		for (it1 = (it->second).begin(); it1 != (it->second).end(); it1++) {
+			
+			dst = it1->first;
+			
+			if (!isReportedLink(src, dst, false)) {
 				
-				if (aux_val > 0.0) {
-					
-					max_route_len += aux_val;
-					
-					count++;
-					
-				}
+				continue;
+			}
 			
+			aux_val = (double) getMaxRouteLength(src, dst);
+			
+			if (aux_val > 0.0) {
+				
+				max_route_len += aux_val;
+				count++;
 			}
 		}
 	}
 	
 	if (count > 0) {
-	
-		return max_route_len / count;
 		
+		return max_route_len / count;
 	}
 	
-	return 0;
+	return 0.0;
 }
 
+
 /*!
  * 	@brief The getDuplicatedRouteLength() function returns the average route length for duplicated packets delivered in the network.
  *	@retval result The average route length for duplicated packets delivered in the network.
@@ -4037,22 +2930,31 @@ double Sunset_Protocol_Statistics::getDuplicatedRouteLength()
 	double aux_val = 0.0;
 	double route_len = 0;
 	int count = 0;
-	for (int src = 0; src <= max_node_id; src++) {
-
-		for (int dst = 0; dst <= max_node_id; dst++) {
+	int src = -1;
+	int dst = -1;
+	
+	map <int, map <int, stat_link_info> >::iterator it;
+	map <int, stat_link_info>::iterator it1;
+	
+	for (it = link_info.begin(); it != link_info.end(); it++) {
 		
-			if (src != dst) {
-				
-				aux_val = getDuplicatedRouteLength(src, dst);
-				
-				if (aux_val > 0.0) {
-					
-					route_len += aux_val;
-					
-					count++;
+		src = it->first;
+		
+		for (it1 = (it->second).begin(); it1 != (it->second).end(); it1++) {
+			
+			dst = it1->first;
+			
+			if (!isReportedLink(src, dst, false)) {
 				
-				}
+				continue;
+			}
 			
+			aux_val = getDuplicatedRouteLength(src, dst);
+			
+			if (aux_val > 0.0) {
+				
+				route_len += aux_val;
+				count++;
 			}
 		}
 	}
@@ -4065,6 +2967,7 @@ double Sunset_Protocol_Statistics::getDuplicatedRouteLength()
 	return 0.0;
 }
 
+
 /*!
  * 	@brief The getDuplicatedNumRoutes() function returns the number of different routes used in the network when delivering duplicated data packets to the destination node. 
  *	@retval result The number of different routes used in the network.
@@ -4075,22 +2978,31 @@ double Sunset_Protocol_Statistics::getDuplicatedNumRoutes()
 	double aux_val = 0.0;
 	double routes = 0;
 	int count = 0;
-	for (int src = 0; src <= max_node_id; src++) {
-
-		for (int dst = 0; dst <= max_node_id; dst++) {
+	int src = -1;
+	int dst = -1;
+	
+	map <int, map <int, stat_link_info> >::iterator it;
+	map <int, stat_link_info>::iterator it1;
+	
+	for (it = link_info.begin(); it != link_info.end(); it++) {
 		
-			if (src != dst) {
-				
-				aux_val = getDuplicatedNumRoutes(src, dst);
-				
-				if (aux_val > 0.0) {
-					
-					routes += aux_val;
-					
-					count++;
+		src = it->first;
+		
+		for (it1 = (it->second).begin(); it1 != (it->second).end(); it1++) {
+			
+			dst = it1->first;
+			
+			if (!isReportedLink(src, dst, false)) {
 				
-				}
+				continue;
+			}
 			
+			aux_val = getDuplicatedNumRoutes(src, dst);
+			
+			if (aux_val > 0.0) {
+				
+				routes += aux_val;
+				count++;
 			}
 		}
 	}
@@ -4103,6 +3015,7 @@ double Sunset_Protocol_Statistics::getDuplicatedNumRoutes()
 	return 0.0;
 }
 
+
 /*!
  * 	@brief The getMaxDuplicatedRouteLength() function returns the maximal routes length in the network when delivering duplicated data packets to the destination node. 
  *	@retval result The maximal route length for duplicated packets.
@@ -4111,40 +3024,46 @@ double Sunset_Protocol_Statistics::getDuplicatedNumRoutes()
 double Sunset_Protocol_Statistics::getMaxDuplicatedRouteLength()
 {
 	double aux_val = 0.0;
-	
 	double max_route_len = 0;
-	
 	int count = 0;
-
-	for (int src = 0; src <= max_node_id; src++) {
-
-		for (int dst = 0; dst <= max_node_id; dst++) {
+	int src = -1;
+	int dst = -1;
+	
+	map <int, map <int, stat_link_info> >::iterator it;
+	map <int, stat_link_info>::iterator it1;
+	
+	for (it = link_info.begin(); it != link_info.end(); it++) {
 		
-			if (src != dst) {
-				
-				aux_val = getDuplicatedRouteLength(src, dst);
+		src = it->first;
+		
+		for (it1 = (it->second).begin(); it1 != (it->second).end(); it1++) {
+			
+			dst = it1->first;
+			
+			if (!isReportedLink(src, dst, false)) {
 				
-				if (aux_val > 0.0) {
-					
-					max_route_len += aux_val;
-					
-					count++;
-					
-				}
+				continue;
+			}
+			
+			aux_val = getDuplicatedRouteLength(src, dst);
 			
+			if (aux_val > 0.0) {
+				
+				max_route_len += aux_val;
+				count++;
 			}
 		}
 	}
 	
 	if (count > 0) {
-	
+		
 		return max_route_len / count;
-	
 	}
 	
 	return 0.0;
 }
 
+
 /*!
  * 	@brief The getMacThroughput() function returns the throughput at the MAC layer on the link src to dst. 
  *	@param src The source node of the link.
@@ -4176,29 +3095,39 @@ double Sunset_Protocol_Statistics::getMacThroughput(int src, int dst)
 double Sunset_Protocol_Statistics::getMacThroughput()
 {
 	double time = getExperimentTime();
+	int pkt_rx = 0;
+	int src = -1;
+	int dst = -1;
+	
+	map <int, map <int, stat_link_info> >::iterator it;
+	map <int, stat_link_info>::iterator it1;
 	
 	if (time <= 0) {
 		
 		return 0.0;
 	}
 	
-	int pkt_rx = 0;
-	
-	for (int src = 0; src <= max_node_id; src++) {
-
-		for (int dst = 0; dst <= max_node_id; dst++) {
+	for (it = link_info.begin(); it != link_info.end(); it++) {
 		
-			if (src != dst) {
+		src = it->first;
+		
+		for (it1 = (it->second).begin(); it1 != (it->second).end(); it1++) {
+			
+			dst = it1->first;
+			
+			if (!isReportedLink(src, dst, false)) {
 				
-				pkt_rx += (getMacDataBytesReceptions(src, dst) + getMacCtrlBytesReceptions(src, dst)) * 8.0;
-
+				continue;
 			}
+			
+			pkt_rx += (getMacDataBytesReceptions(src, dst) + getMacCtrlBytesReceptions(src, dst)) * 8.0;
 		}
 	}
-
+	
 	return pkt_rx / time;
 }
 
+
 /*!
  * 	@brief The getMacLoad() function returns the number of MAC packets transmitted in the network.
  *	@retval result The number of  MAC packets transmitted in the network.
@@ -4207,29 +3136,33 @@ double Sunset_Protocol_Statistics::getMacThroughput()
 double Sunset_Protocol_Statistics::getMacLoad()
 {
 	int pkt_tx = 0;
+	int src = -1;
+	int dst = -1;
 	
-	for (int src = 0; src <= max_node_id; src++) {
-
-		for (int dst = 0; dst <= max_node_id; dst++) {
+	map <int, map <int, stat_link_info> >::iterator it;
+	map <int, stat_link_info>::iterator it1;
+	
+	for (it = link_info.begin(); it != link_info.end(); it++) {
 		
-			if (src != dst) {
-				
-				pkt_tx += (getMacDataPacketTransmissions(src, dst) + getMacCtrlPacketTransmissions(src, dst));
+		src = it->first;
+		
+		for (it1 = (it->second).begin(); it1 != (it->second).end(); it1++) {
 			
-			}
-		}
-
-		if (Sunset_Address::getBroadcastAddress() > max_node_id || Sunset_Address::getBroadcastAddress() < 0) {
+			dst = it1->first;
 			
-				pkt_tx += (getMacDataPacketTransmissions(src, Sunset_Address::getBroadcastAddress()) + 
-					getMacCtrlPacketTransmissions(src, Sunset_Address::getBroadcastAddress()));
+			if (!isReportedLink(src, dst, true)) {
+				
+				continue;
+			}
 			
+			pkt_tx += (getMacDataPacketTransmissions(src, dst) + getMacCtrlPacketTransmissions(src, dst));
 		}
 	}
 	
 	return pkt_tx;
 }
 
+
 /*!
  * 	@brief The getMacLoadBytes() function returns the number of MAC bytes transmitted in the network.
  *	@retval result The number of  MAC bytes transmitted in the network.
@@ -4238,30 +3171,33 @@ double Sunset_Protocol_Statistics::getMacLoad()
 double Sunset_Protocol_Statistics::getMacLoadBytes()
 {
 	int pkt_tx = 0;
+	int src = -1;
+	int dst = -1;
 	
-	for (int src = 0; src <= max_node_id; src++) {
-
-		for (int dst = 0; dst <= max_node_id; dst++) {
+	map <int, map <int, stat_link_info> >::iterator it;
+	map <int, stat_link_info>::iterator it1;
+	
+	for (it = link_info.begin(); it != link_info.end(); it++) {
 		
-			if (src != dst) {
-				
-				pkt_tx += (getMacDataBytesTransmissions(src, dst) + getMacCtrlBytesTransmissions(src, dst));
-			
-			}
-		}
+		src = it->first;
 		
-		if (Sunset_Address::getBroadcastAddress() > max_node_id || Sunset_Address::getBroadcastAddress() < 0) {
+		for (it1 = (it->second).begin(); it1 != (it->second).end(); it1++) {
 			
-				pkt_tx += (getMacDataBytesTransmissions(src, Sunset_Address::getBroadcastAddress()) + 
-					getMacCtrlBytesTransmissions(src, Sunset_Address::getBroadcastAddress()));
+			dst = it1->first;
 			
+			if (!isReportedLink(src, dst, true)) {
+				
+				continue;
+			}
+			
+			pkt_tx += (getMacDataBytesTransmissions(src, dst) + getMacCtrlBytesTransmissions(src, dst));
 		}
-
 	}
 	
 	return pkt_tx;
 }
 
+
 /*!
  * 	@brief The getMacDataLoad() function returns the number of MAC data packets transmitted in the network.
  *	@retval result The number of  MAC data packets transmitted in the network.
@@ -4270,29 +3206,33 @@ double Sunset_Protocol_Statistics::getMacLoadBytes()
 double Sunset_Protocol_Statistics::getMacDataLoad()
 {
 	int pkt_tx = 0;
+	int src = -1;
+	int dst = -1;
 	
-	for (int src = 0; src <= max_node_id; src++) {
-
-		for (int dst = 0; dst <= max_node_id; dst++) {
+	map <int, map <int, stat_link_info> >::iterator it;
+	map <int, stat_link_info>::iterator it1;
+	
+	for (it = link_info.begin(); it != link_info.end(); it++) {
 		
-			if (src != dst) {
-				
-				pkt_tx += (getMacDataPacketTransmissions(src, dst));
+		src = it->first;
+		
+		for (it1 = (it->second).begin(); it1 != (it->second).end(); it1++) {
 			
-			}
-		}
-
-		if (Sunset_Address::getBroadcastAddress() > max_node_id || Sunset_Address::getBroadcastAddress() < 0) {
+			dst = it1->first;
 			
-				pkt_tx += (getMacDataPacketTransmissions(src, Sunset_Address::getBroadcastAddress()));
+			if (!isReportedLink(src, dst, true)) {
+				
+				continue;
+			}
 			
+			pkt_tx += (getMacDataPacketTransmissions(src, dst));
 		}
-	
 	}
 	
 	return pkt_tx;
 }
 
+
 /*!
  * 	@brief The getMacDataLoadBytes() function returns the number of MAC data bytes transmitted in the network.
  *	@retval result The number of  MAC data bytes transmitted in the network.
@@ -4301,29 +3241,33 @@ double Sunset_Protocol_Statistics::getMacDataLoad()
 double Sunset_Protocol_Statistics::getMacDataLoadBytes()
 {
 	int pkt_tx = 0;
+	int src = -1;
+	int dst = -1;
 	
-	for (int src = 0; src <= max_node_id; src++) {
-
-		for (int dst = 0; dst <= max_node_id; dst++) {
+	map <int, map <int, stat_link_info> >::iterator it;
+	map <int, stat_link_info>::iterator it1;
+	
+	for (it = link_info.begin(); it != link_info.end(); it++) {
 		
-			if (src != dst) {
-				
-				pkt_tx += (getMacDataBytesTransmissions(src, dst));
+		src = it->first;
+		
+		for (it1 = (it->second).begin(); it1 != (it->second).end(); it1++) {
 			
-			}
-		}
-
-		if (Sunset_Address::getBroadcastAddress() > max_node_id || Sunset_Address::getBroadcastAddress() < 0) {
+			dst = it1->first;
 			
-				pkt_tx += (getMacDataBytesTransmissions(src, Sunset_Address::getBroadcastAddress()));
+			if (!isReportedLink(src, dst, true)) {
+				
+				continue;
+			}
 			
+			pkt_tx += (getMacDataBytesTransmissions(src, dst));
 		}
-	
 	}
 	
 	return pkt_tx;
 }
 
+
 /*!
  * 	@brief The getMacCtrlLoad() function returns the number of MAC control packets transmitted in the network.
  *	@retval result The number of  MAC control packets transmitted in the network.
@@ -4332,29 +3276,33 @@ double Sunset_Protocol_Statistics::getMacDataLoadBytes()
 double Sunset_Protocol_Statistics::getMacCtrlLoad()
 {
 	int pkt_tx = 0;
+	int src = -1;
+	int dst = -1;
 	
-	for (int src = 0; src <= max_node_id; src++) {
-
-		for (int dst = 0; dst <= max_node_id; dst++) {
+	map <int, map <int, stat_link_info> >::iterator it;
+	map <int, stat_link_info>::iterator it1;
+	
+	for (it = link_info.begin(); it != link_info.end(); it++) {
 		
-			if (src != dst) {
-				
-				pkt_tx += (getMacCtrlPacketTransmissions(src, dst));
+		src = it->first;
+		
+		for (it1 = (it->second).begin(); it1 != (it->second).end(); it1++) {
 			
-			}
-		}
-
-		if (Sunset_Address::getBroadcastAddress() > max_node_id || Sunset_Address::getBroadcastAddress() < 0) {
+			dst = it1->first;
 			
-				pkt_tx += (getMacCtrlPacketTransmissions(src, Sunset_Address::getBroadcastAddress()));
+			if (!isReportedLink(src, dst, true)) {
+				
+				continue;
+			}
 			
+			pkt_tx += (getMacCtrlPacketTransmissions(src, dst));
 		}
-	
 	}
 	
 	return pkt_tx;
 }
 
+
 /*!
  * 	@brief The getMacCtrlLoadBytes() function returns the number of MAC control bytes transmitted in the network.
  *	@retval result The number of  MAC control bytes transmitted in the network.
@@ -4363,29 +3311,33 @@ double Sunset_Protocol_Statistics::getMacCtrlLoad()
 double Sunset_Protocol_Statistics::getMacCtrlLoadBytes()
 {
 	int pkt_tx = 0;
+	int src = -1;
+	int dst = -1;
 	
-	for (int src = 0; src <= max_node_id; src++) {
-
-		for (int dst = 0; dst <= max_node_id; dst++) {
+	map <int, map <int, stat_link_info> >::iterator it;
+	map <int, stat_link_info>::iterator it1;
+	
+	for (it = link_info.begin(); it != link_info.end(); it++) {
 		
-			if (src != dst) {
-				
-				pkt_tx += (getMacCtrlBytesTransmissions(src, dst));
+		src = it->first;
+		
+		for (it1 = (it->second).begin(); it1 != (it->second).end(); it1++) {
 			
-			}
-		}
-
-		if (Sunset_Address::getBroadcastAddress() > max_node_id || Sunset_Address::getBroadcastAddress() < 0) {
+			dst = it1->first;
 			
-				pkt_tx += (getMacCtrlBytesTransmissions(src, Sunset_Address::getBroadcastAddress()));
+			if (!isReportedLink(src, dst, true)) {
+				
+				continue;
+			}
 			
-		}	
-	
+			pkt_tx += (getMacCtrlBytesTransmissions(src, dst));
+		}
 	}
 	
 	return pkt_tx;
 }
 
+
 /*!
  * 	@brief The getMacDataRetransmissions() function returns the average number of data packets retransmissions on the link from the src node to the dst node. 
  *	@param src The source node of the link.
@@ -4417,38 +3369,39 @@ double Sunset_Protocol_Statistics::getMacDataRetransmissions()
 {
 	int pkt_tx = 0;
 	int pkt = 0;
-	for (int src = 0; src <= max_node_id; src++) {
-
-		for (int dst = 0; dst <= max_node_id; dst++) {
+	int src = -1;
+	int dst = -1;
+	
+	map <int, map <int, stat_link_info> >::iterator it;
+	map <int, stat_link_info>::iterator it1;
+	
+	for (it = link_info.begin(); it != link_info.end(); it++) {
 		
-			if (src != dst) {
-				
-				pkt_tx += getMacDataPacketTransmissions(src, dst);
-				
-				pkt += getCreatedMacDataPacket(src, dst);
-			
-			}
-		}
-
-		if (Sunset_Address::getBroadcastAddress() > max_node_id || Sunset_Address::getBroadcastAddress() < 0) {
+		src = it->first;
+		
+		for (it1 = (it->second).begin(); it1 != (it->second).end(); it1++) {
 			
-				pkt_tx += (getMacDataPacketTransmissions(src, Sunset_Address::getBroadcastAddress()));
+			dst = it1->first;
 			
-				pkt += getCreatedMacDataPacket(src, Sunset_Address::getBroadcastAddress());
+			if (!isReportedLink(src, dst, true)) {
+				
+				continue;
+			}
 			
+			pkt_tx += getMacDataPacketTransmissions(src, dst);
+			pkt += getCreatedMacDataPacket(src, dst);
 		}
-	
 	}
 	
 	if (pkt > 0 && pkt < pkt_tx) {
 		
 		return (pkt_tx - pkt) / pkt;
-	
 	}
 	
 	return 0.0;
 }
 
+
 /*!
  * 	@brief The getMacDataPacketDiscarded() function returns the number of data packets discarded at the MAC layer. 
  *	@retval result The number of data packets discarded at the MAC layer.
@@ -4457,28 +3410,33 @@ double Sunset_Protocol_Statistics::getMacDataRetransmissions()
 int Sunset_Protocol_Statistics::getMacDataPacketDiscarded()
 {
 	double pkt = 0;
-	for (int src = 0; src <= max_node_id; src++) {
-
-		for (int dst = 0; dst <= max_node_id; dst++) {
+	int src = -1;
+	int dst = -1;
+	
+	map <int, map <int, stat_link_info> >::iterator it;
+	map <int, stat_link_info>::iterator it1;
+	
+	for (it = link_info.begin(); it != link_info.end(); it++) {
 		
-			if (src != dst) {
-				
-				pkt += getMacDataPacketDiscarded(src, dst);
+		src = it->first;
+		
+		for (it1 = (it->second).begin(); it1 != (it->second).end(); it1++) {
 			
-			}
-		}
-
-		if (Sunset_Address::getBroadcastAddress() > max_node_id || Sunset_Address::getBroadcastAddress() < 0) {
+			dst = it1->first;
 			
-				pkt += getMacDataPacketDiscarded(src, Sunset_Address::getBroadcastAddress());
+			if (!isReportedLink(src, dst, true)) {
+				
+				continue;
+			}
 			
+			pkt += getMacDataPacketDiscarded(src, dst);
 		}
-	
 	}
-		
+	
 	return pkt;
 }
 
+
 /*!
  * 	@brief The getMacCtrlPacketDiscarded() function returns the number of control packets discarded at the MAC layer. 
  *	@retval result The number of control packets discarded at the MAC layer.
@@ -4487,25 +3445,29 @@ int Sunset_Protocol_Statistics::getMacDataPacketDiscarded()
 int Sunset_Protocol_Statistics::getMacCtrlPacketDiscarded()
 {
 	int pkt = 0;
-	for (int src = 0; src <= max_node_id; src++) {
-
-		for (int dst = 0; dst <= max_node_id; dst++) {
+	int src = -1;
+	int dst = -1;
+	
+	map <int, map <int, stat_link_info> >::iterator it;
+	map <int, stat_link_info>::iterator it1;
+	
+	for (it = link_info.begin(); it != link_info.end(); it++) {
 		
-			if (src != dst) {
-				
-				pkt += getMacCtrlPacketDiscarded(src, dst);
+		src = it->first;
+		
+		for (it1 = (it->second).begin(); it1 != (it->second).end(); it1++) {
 			
-			}
-		}
-
-		if (Sunset_Address::getBroadcastAddress() > max_node_id || Sunset_Address::getBroadcastAddress() < 0) {
+			dst = it1->first;
 			
-				pkt += getMacCtrlPacketDiscarded(src, Sunset_Address::getBroadcastAddress());
+			if (!isReportedLink(src, dst, true)) {
+				
+				continue;
+			}
 			
+			pkt += getMacCtrlPacketDiscarded(src, dst);
 		}
-	
 	}
-		
+	
 	return pkt;
 }
 
@@ -4541,42 +3503,43 @@ double Sunset_Protocol_Statistics::getOverheadPerBit(int src, int dst)
 
 double Sunset_Protocol_Statistics::getOverheadPerBit()
 {
-
 	int pkt_tx = 0;
-	
 	int pkt_rx = 0;
+	int src = -1;
+	int dst = -1;
 	
-	for (int src = 0; src <= max_node_id; src++) {
-
-		for (int dst = 0; dst <= max_node_id; dst++) {
+	map <int, map <int, stat_link_info> >::iterator it;
+	map <int, stat_link_info>::iterator it1;
+	
+	for (it = link_info.begin(); it != link_info.end(); it++) {
+		
+		src = it->first;
 		
-			if (src != dst) {
+		for (it1 = (it->second).begin(); it1 != (it->second).end(); it1++) {
 			
+			dst = it1->first;
+			
+			if (isReportedLink(src, dst, true)) {
+				
 				pkt_tx += (getMacDataBytesTransmissions(src, dst) + getMacCtrlBytesTransmissions(src, dst)) * 8;
-
-				pkt_rx += getDeliveredBytes(src, dst) * 8;
 			}
-		}
-
-		if (Sunset_Address::getBroadcastAddress() > max_node_id || Sunset_Address::getBroadcastAddress() < 0) {
-			
-				pkt_tx += (getMacDataBytesTransmissions(src, Sunset_Address::getBroadcastAddress()) +
-					getMacCtrlBytesTransmissions(src, Sunset_Address::getBroadcastAddress())) * 8;
 			
+			if (isReportedLink(src, dst, false)) {
+				
+				pkt_rx += getDeliveredBytes(src, dst) * 8;
+			}
 		}
-	
 	}
-
+	
 	if (pkt_rx > 0 && pkt_rx < pkt_tx) {
 		
 		return (double)(pkt_tx - pkt_rx) / (double)pkt_rx;
-	
 	}
 	
 	return 0.0;
-
 }
 
+
 /*!
  * 	@brief The show_data() function is used to collect the processed informaiton and store in the file selected
  *	by the user.
@@ -4593,7 +3556,7 @@ void Sunset_Protocol_Statistics::show_data()
 	
 	if (!outFile2.is_open()) {
 		
-		Sunset_Debug::debugInfo(-1, -1, "Sunset_Protocol_Statistics::show_data outputFile2 %s cannot be opened ERROR", fileOut2);
+		SUNSET_DEBUG_LOG(-1, -1, "Sunset_Protocol_Statistics::show_data outputFile2 %s cannot be opened ERROR", fileOut2);
 		
 		return;
 	}
@@ -4744,7 +3707,7 @@ void Sunset_Protocol_Statistics::get_agt_tx(int node_id, map<int, agt_tx_info>&
 					    (pkt_dest_info[spktType]).find(node) == (pkt_dest_info[spktType]).end() ||
 					    (pkt_dest_info[spktType])[node].find(pkt_id) == (pkt_dest_info[spktType])[node].end()) {
 						
-						Sunset_Debug::debugInfo(-1, -1, "Sunset_Protocol_Statistics::get_agt_tx ERROR size node %d pkt_id %d", node, pkt_id);
+						SUNSET_DEBUG_LOG(-1, -1, "Sunset_Protocol_Statistics::get_agt_tx ERROR size node %d pkt_id %d", node, pkt_id);
 						
 						continue;
 					}
@@ -5571,3 +4534,266 @@ float Sunset_Protocol_Statistics::getTxConsumption(int id, double pow)
 	
 	return tmp; 
 }
+
+static const char* const exportLinkIds[] = { "src", "dst" };
+
+static const char* const exportLinkNames[STAT_EXPORT_LINK_METRICS] = { "generated", "delivered", "delivered_dup", 
+	"generated_bytes", "delivered_bytes", "pdr", "throughput", "latency", "route_length", "max_route_length", 
+	"num_routes", "mac_data_new", "mac_data_tx", "mac_data_rx", "mac_data_discarded", "mac_ctrl_tx", "mac_ctrl_rx", 
+	"mac_ctrl_discarded", "mac_retransmissions", "mac_throughput", "overhead_per_bit" };
+
+static const char* const exportNodeIds[] = { "node" };
+
+static const char* const exportNodeNames[STAT_EXPORT_NODE_METRICS] = { "generated", "delivered", "generated_bytes", 
+	"delivered_bytes", "pdr", "mac_data_tx", "mac_data_rx", "mac_data_discarded", "mac_ctrl_tx", "mac_ctrl_rx", 
+	"mac_ctrl_discarded", "residual_energy", "idle_time", "rx_time", "tx_time", "idle_consumption", 
+	"rx_consumption", "tx_consumption" };
+
+/*!
+ * 	@brief The computeLinkMetrics function computes all the metrics of a src-dst link from its aggregated information,
+ *		using the same definitions of the single getter functions.
+ *	@param info The aggregated information of the link.
+ *	@param time The experiment duration.
+ *	@param[out] v The STAT_EXPORT_LINK_METRICS computed values, in the order of exportLinkNames.
+ */
+void Sunset_Protocol_Statistics::computeLinkMetrics(stat_link_info& info, double time, double* v) 
+{
+	double overhead = (info.mac_data_tx_bytes_ + info.mac_ctrl_tx_bytes_) * 8.0;
+	double payload = info.bytes_delivered_ * 8.0;
+	
+	v[0] = info.pkt_generated_;
+	v[1] = info.pkt_delivered_;
+	v[2] = info.pkt_delivered_dup_;
+	v[3] = info.bytes_generated_;
+	v[4] = info.bytes_delivered_;
+	v[5] = (info.pkt_generated_ > 0) ? (double)info.pkt_delivered_ / (double)info.pkt_generated_ : 0.0;
+	v[6] = (time > 0) ? payload / time : 0.0;
+	v[7] = (info.delay_count_ > 0) ? info.delay_ / (double)info.delay_count_ : 0.0;
+	v[8] = (info.hops_count_ > 0) ? info.hops_ / (double)info.hops_count_ : 0.0;
+	v[9] = info.max_hops_;
+	v[10] = (double)info.routes_.size();
+	v[11] = info.mac_data_new_;
+	v[12] = info.mac_data_tx_;
+	v[13] = info.mac_data_rx_;
+	v[14] = info.mac_data_discarded_;
+	v[15] = info.mac_ctrl_tx_;
+	v[16] = info.mac_ctrl_rx_;
+	v[17] = info.mac_ctrl_discarded_;
+	v[18] = (info.mac_data_new_ > 0 && info.mac_data_new_ < info.mac_data_tx_) ? 
+		(double)(info.mac_data_tx_ - info.mac_data_new_) / (double)info.mac_data_new_ : 0.0;
+	v[19] = (time > 0) ? (info.mac_data_rx_bytes_ + info.mac_ctrl_rx_bytes_) * 8.0 / time : 0.0;
+	v[20] = (payload > 0 && payload < overhead) ? (overhead - payload) / payload : 0.0;
+}
+
+/*!
+ * 	@brief The appendMetrics function appends to "out" a row of metrics in the given format.
+ *	@param format The output format.
+ *	@param out The string where the row is appended.
+ *	@param idNames The names of the row identifiers.
+ *	@param ids The row identifiers.
+ *	@param nIds The number of row identifiers.
+ *	@param names The names of the metrics.
+ *	@param v The metric values.
+ *	@param n The number of metrics.
+ *	@param first True if this is the first row of the table.
+ */
+void Sunset_Protocol_Statistics::appendMetrics(sunset_statExportFormat format, string& out, const char* const* idNames, 
+					       const int* ids, int nIds, const char* const* names, const double* v, int n, bool first) 
+{
+	char buf[STAT_MAX_BUF];
+	int len = 0;
+	int i = 0;
+	
+	switch ( format ) {
+		
+		case SUNSET_STAT_EXPORT_CSV:
+			
+			if ( first ) {
+				
+				for ( i = 0; i < nIds; i++ ) {
+					
+					len += snprintf(buf + len, STAT_MAX_BUF - len, "%s,", idNames[i]);
+				}
+				
+				for ( i = 0; i < n; i++ ) {
+					
+					len += snprintf(buf + len, STAT_MAX_BUF - len, (i < n - 1) ? "%s," : "%s\n", names[i]);
+				}
+				
+				out.append(buf, len);
+				len = 0;
+			}
+			
+			for ( i = 0; i < nIds; i++ ) {
+				
+				len += snprintf(buf + len, STAT_MAX_BUF - len, "%d,", ids[i]);
+			}
+			
+			for ( i = 0; i < n; i++ ) {
+				
+				len += snprintf(buf + len, STAT_MAX_BUF - len, (i < n - 1) ? "%.10g," : "%.10g\n", v[i]);
+			}
+			
+			break;
+			
+		case SUNSET_STAT_EXPORT_JSON:
+			
+			len += snprintf(buf + len, STAT_MAX_BUF - len, first ? "\n\t\t{" : ",\n\t\t{");
+			
+			for ( i = 0; i < nIds; i++ ) {
+				
+				len += snprintf(buf + len, STAT_MAX_BUF - len, "\"%s\": %d, ", idNames[i], ids[i]);
+			}
+			
+			for ( i = 0; i < n; i++ ) {
+				
+				len += snprintf(buf + len, STAT_MAX_BUF - len, (i < n - 1) ? "\"%s\": %.10g, " : "\"%s\": %.10g}", names[i], v[i]);
+			}
+			
+			break;
+			
+		case SUNSET_STAT_EXPORT_DICT:
+			
+			len += snprintf(buf + len, STAT_MAX_BUF - len, first ? "{" : " {");
+			
+			for ( i = 0; i < nIds; i++ ) {
+				
+				len += snprintf(buf + len, STAT_MAX_BUF - len, (i < nIds - 1) ? "%d " : "%d} {", ids[i]);
+			}
+			
+			for ( i = 0; i < n; i++ ) {
+				
+				len += snprintf(buf + len, STAT_MAX_BUF - len, (i < n - 1) ? "%s %.10g " : "%s %.10g}", names[i], v[i]);
+			}
+			
+			break;
+	}
+	
+	out.append(buf, len);
+}
+
+/*!
+ * 	@brief The exportMetrics function computes the metrics of all the reported src-dst links and of all the nodes
+ *		in a single pass over the aggregated link information, instead of calling one getter per metric and pair.
+ *		CSV: a link table (src,dst,...) followed, after an empty line, by a node table (node,...).
+ *		JSON: an object with the "experiment_time", "links" and "nodes" fields.
+ *		Tcl dictionary: experiment_time, links (keyed by {src dst}) and nodes (keyed by the node id).
+ *	@param format The output format.
+ *	@param[out] out The exported metrics.
+ */
+void Sunset_Protocol_Statistics::exportMetrics(sunset_statExportFormat format, string& out) 
+{
+	map <int, map <int, stat_link_info> >::iterator it;
+	map <int, stat_link_info>::iterator it1;
+	vector<double> node((max_node_id + 1) * STAT_EXPORT_NODE_METRICS, 0.0);
+	double link[STAT_EXPORT_LINK_METRICS];
+	double time = getExperimentTime();
+	double* v = 0;
+	char buf[STAT_MAX_BUF];
+	int ids[2];
+	int src = -1;
+	int dst = -1;
+	bool first = true;
+	
+	out.clear();
+	
+	if ( format == SUNSET_STAT_EXPORT_JSON ) {
+		
+		snprintf(buf, STAT_MAX_BUF, "{\n\t\"experiment_time\": %.10g,\n\t\"links\": [", time);
+		out.append(buf);
+	}
+	else if ( format == SUNSET_STAT_EXPORT_DICT ) {
+		
+		snprintf(buf, STAT_MAX_BUF, "experiment_time %.10g links {", time);
+		out.append(buf);
+	}
+	
+	for ( it = link_info.begin(); it != link_info.end(); it++ ) {
+		
+		src = it->first;
+		
+		for ( it1 = (it->second).begin(); it1 != (it->second).end(); it1++ ) {
+			
+			dst = it1->first;
+			
+			if ( !isReportedLink(src, dst, true) ) {
+				
+				continue;
+			}
+			
+			stat_link_info& info = it1->second;
+			
+			computeLinkMetrics(info, time, link);
+			
+			ids[0] = src;
+			ids[1] = dst;
+			
+			appendMetrics(format, out, exportLinkIds, ids, 2, exportLinkNames, link, STAT_EXPORT_LINK_METRICS, first);
+			first = false;
+			
+			/* node totals are accounted to the source of the link, the delivered packets to the 
+			 * broadcast address are not considered as for getDeliveredPacket(src) */
+			
+			v = &(node[src * STAT_EXPORT_NODE_METRICS]);
+			
+			v[0] += info.pkt_generated_;
+			v[2] += info.bytes_generated_;
+			
+			if ( isReportedLink(src, dst, false) ) {
+				
+				v[1] += info.pkt_delivered_;
+				v[3] += info.bytes_delivered_;
+			}
+			
+			v[5] += info.mac_data_tx_;
+			v[6] += info.mac_data_rx_;
+			v[7] += info.mac_data_discarded_;
+			v[8] += info.mac_ctrl_tx_;
+			v[9] += info.mac_ctrl_rx_;
+			v[10] += info.mac_ctrl_discarded_;
+		}
+	}
+	
+	if ( format == SUNSET_STAT_EXPORT_CSV ) {
+		
+		out.append("\n");
+	}
+	else if ( format == SUNSET_STAT_EXPORT_JSON ) {
+		
+		out.append("\n\t],\n\t\"nodes\": [");
+	}
+	else {
+		
+		out.append("} nodes {");
+	}
+	
+	first = true;
+	
+	for ( int id = 0; id <= max_node_id; id++ ) {
+		
+		v = &(node[id * STAT_EXPORT_NODE_METRICS]);
+		
+		v[4] = (v[0] > 0) ? v[1] / v[0] : 0.0;
+		v[11] = getResidualEnergy(id);
+		v[12] = getIdleTime(id);
+		v[13] = getRxTime(id);
+		v[14] = getTotTxTime(id);
+		v[15] = getIdleConsumption(id);
+		v[16] = getRxConsumption(id);
+		v[17] = getTotTxConsumption(id);
+		
+		ids[0] = id;
+		
+		appendMetrics(format, out, exportNodeIds, ids, 1, exportNodeNames, v, STAT_EXPORT_NODE_METRICS, first);
+		first = false;
+	}
+	
+	if ( format == SUNSET_STAT_EXPORT_JSON ) {
+		
+		out.append("\n\t]\n}\n");
+	}
+	else if ( format == SUNSET_STAT_EXPORT_DICT ) {
+		
+		out.append("}");
+	}
+}
@@ -26,6 +26,8 @@
 #include "sunset_address.h"
 #include "sunset_trace.h"
 #include "sunset_information_dispatcher.h"
+#include "sunset_stat_writer.h"
+#include "sunset_trace_encoder.h"
 
 #include "sunset_agent_pkt.h"
 #include "sunset_routing_pkt.h"
@@ -36,6 +38,9 @@
 #define TIME2INT 	10000
 #define STAT_MAX_BUF	3000
 
+#define STAT_EXPORT_LINK_METRICS	21	/*!< @brief Number of metrics exported for each src-dst link. */
+#define STAT_EXPORT_NODE_METRICS	18	/*!< @brief Number of metrics exported for each node. */
+
 /*!
  @brief This data structure defines the different packet types we want to capture in our statistic analysis.
  */
@@ -109,6 +114,69 @@ typedef struct mac_rx_info {
 	
 } mac_rx_info;
 
+/*! @brief This data structure contains the information aggregated for a src-dst link while the statistics are collected,
+ *  to provide the protocol performance without processing all the stored packets. */
+
+typedef struct stat_link_info {
+	
+	/* application layer - data packets */
+	int pkt_generated_;
+	int bytes_generated_;
+	int pkt_delivered_;
+	int bytes_delivered_;
+	int pkt_delivered_dup_;
+	int bytes_delivered_dup_;
+	
+	double hops_;		// sum of the hops of the delivered packets
+	int hops_count_;
+	int max_hops_;
+	set<int> routes_;	// different route lengths
+	
+	double hops_dup_;	// sum of the hops of the first duplicated reception of the packets
+	int hops_dup_count_;
+	int max_hops_dup_;
+	set<int> routes_dup_;
+	
+	double delay_;		// sum of the end-to-end latency
+	int delay_count_;
+	double delay_dup_;
+	int delay_dup_count_;
+	
+	/* MAC layer */
+	int mac_data_new_;
+	int mac_data_new_bytes_;
+	int mac_data_tx_;
+	int mac_data_tx_bytes_;
+	int mac_data_rx_;
+	int mac_data_rx_bytes_;
+	int mac_data_discarded_;
+	int mac_data_discarded_bytes_;
+	int mac_ctrl_tx_;
+	int mac_ctrl_tx_bytes_;
+	int mac_ctrl_rx_;
+	int mac_ctrl_rx_bytes_;
+	int mac_ctrl_discarded_;
+	int mac_ctrl_discarded_bytes_;
+	
+	stat_link_info() : pkt_generated_(0), bytes_generated_(0), pkt_delivered_(0), bytes_delivered_(0), 
+		pkt_delivered_dup_(0), bytes_delivered_dup_(0), hops_(0.0), hops_count_(0), max_hops_(-1), 
+		hops_dup_(0.0), hops_dup_count_(0), max_hops_dup_(-1), delay_(0.0), delay_count_(0), 
+		delay_dup_(0.0), delay_dup_count_(0), mac_data_new_(0), mac_data_new_bytes_(0), mac_data_tx_(0), 
+		mac_data_tx_bytes_(0), mac_data_rx_(0), mac_data_rx_bytes_(0), mac_data_discarded_(0), 
+		mac_data_discarded_bytes_(0), mac_ctrl_tx_(0), mac_ctrl_tx_bytes_(0), mac_ctrl_rx_(0), 
+		mac_ctrl_rx_bytes_(0), mac_ctrl_discarded_(0), mac_ctrl_discarded_bytes_(0) {}
+	
+} stat_link_info;
+
+/*! @brief This data structure defines the formats supported when exporting all the metrics in one call. */
+typedef enum {
+	
+	SUNSET_STAT_EXPORT_CSV = 0,
+	SUNSET_STAT_EXPORT_JSON = 1,
+	SUNSET_STAT_EXPORT_DICT = 2	// Tcl dictionary
+	
+} sunset_statExportFormat;
+
 /************************ _ END OF DATA STRUCTURES _ **********************************************************/
 
 /*! @brief This class implements all the functionalities to evaluate the performance of the protocol solutions
@@ -150,6 +218,10 @@ public:
 	void get_mac_tx(int node_id, map<int, mac_tx_info>& info);
 	void get_mac_rx(int node_id, map<int, mac_rx_info>& info);
 	/*******************************************************/
+	
+	/*!< @brief Computes the per-link and per-node metrics in a single pass over the aggregated link information
+	 *  and writes them in "out" using the given format. */
+	void exportMetrics(sunset_statExportFormat format, string& out);
 		
 protected:
 	
@@ -188,6 +260,18 @@ protected:
 	double start_time;
 	double stop_time;
 	
+	map <int, map <int, stat_link_info> > link_info; // src - dst - aggregated information, updated as the actions are logged
+	
+	void updateGeneratedInfo(int src, int pkt_id, int sign);
+	void updateDeliveredInfo(int src, int dst, int pkt_id, int num_hop, double time, bool duplicated);
+	stat_link_info* findLinkInfo(int src, int dst);
+	bool isReportedDestination(int src, int dst, bool broadcast);
+	bool isReportedLink(int src, int dst, bool broadcast);
+	
+	void computeLinkMetrics(stat_link_info& info, double time, double* v);
+	void appendMetrics(sunset_statExportFormat format, string& out, const char* const* idNames, const int* ids, int nIds, 
+			   const char* const* names, const double* v, int n, bool first);
+	
 
 	void processCreateData(statInfo st);
 	void processRecvData(statInfo st);
@@ -216,10 +300,24 @@ protected:
 	
 	int run_id;
 	
-	/* if 1 all the collected information are lgged in bunary format to reduce the file size, 
-	 *  otherwise the ASCII format is used.*/
+	/* if 1 all the collected information are logged in the SUNSET binary trace format (see sunset_trace_format.h),
+	 *  which can be processed by the sunset_trace_stats tool, otherwise the ASCII format is used.*/
 	int binaryOutput; 
 	
+	Sunset_Trace_Encoder traceEncoder;	// chunk of records being encoded, protected by mutex_stat
+	
+	void logTraceRecord(statInfo& st, const char* info, int infoLen, const double* energy);
+	void writeTraceChunk();
+	void writeTraceMeta();
+	
+	/* if 1 the records are buffered and written on file by a background thread, 
+	 *  otherwise each record is written and flushed when logged.*/
+	int asyncLog;
+	int flushSize;		// size (bytes) of the buffered records triggering a write
+	double flushInterval;	// maximum time (sec) a record is kept in memory
+	
+	Sunset_Stat_Writer statWriter;
+	
 	void setTxDuration(int, double, double, double );
 	void setRxDuration(int id, double, double sec);
 	void setIdleDuration(int id, double, double sec);
@@ -0,0 +1,426 @@
+/* SUNSET - Sapienza University Networking framework for underwater Simulation, Emulation and real-life Testing
+ *
+ * Copyright (C) 2012 Regents of UWSN Group of SENSES Lab <http://reti.dsi.uniroma1.it/SENSES_lab/>
+ *
+ * Author: Roberto Petroccia - petroccia@di.uniroma1.it
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License as published
+ * at http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANATBILITY or FITNESS FOR A PARTICULAR PURPOSE. See the Creative Commons
+ * Attribution-NonCommercial-ShareAlike 3.0 Unported License for more details.
+ *
+ * You should have received a copy of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License
+ * along with this program. If not, see <http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode>.
+ */
+
+#include "sunset_stat_writer.h"
+
+Sunset_Stat_Writer::Sunset_Stat_Writer()
+{
+	out_ = 0;
+	blockSize_ = STAT_WRITER_BLOCK_SIZE;
+	flushInterval_ = STAT_WRITER_FLUSH_INTERVAL;
+	running = false;
+	stopping = false;
+
+	pthread_mutex_init(&mutex_, NULL);
+	pthread_cond_init(&cond_, NULL);
+	pthread_key_create(&key_, NULL);
+}
+
+Sunset_Stat_Writer::~Sunset_Stat_Writer()
+{
+	list<stat_thread_buffer*>::iterator itb;
+	list<stat_block*>::iterator it;
+
+	stop();
+
+	for ( itb = buffers.begin(); itb != buffers.end(); itb++ ) {
+
+		pthread_mutex_destroy(&((*itb)->lock));
+
+		if ( (*itb)->block != 0 ) {
+
+			free((*itb)->block->data);
+			free((*itb)->block);
+		}
+
+		free(*itb);
+	}
+
+	for ( it = freeBlocks.begin(); it != freeBlocks.end(); it++ ) {
+
+		free((*it)->data);
+		free(*it);
+	}
+
+	buffers.clear();
+	freeBlocks.clear();
+
+	pthread_key_delete(key_);
+	pthread_cond_destroy(&cond_);
+	pthread_mutex_destroy(&mutex_);
+}
+
+/*!
+ * 	@brief The start function starts the background thread writing on the given output file.
+ *	@param out The output file.
+ *	@param blockSize The size (bytes) a block has to reach before being written.
+ *	@param flushInterval The interval (sec) after which partially filled blocks are written.
+ *	@retval true If the thread has been started, false otherwise (records are then written synchronously).
+ */
+
+bool Sunset_Stat_Writer::start(ofstream* out, int blockSize, double flushInterval)
+{
+	if ( running ) {
+
+		return true;
+	}
+
+	out_ = out;
+
+	if ( blockSize > 0 ) {
+
+		blockSize_ = blockSize;
+	}
+
+	if ( flushInterval > 0.0 ) {
+
+		flushInterval_ = flushInterval;
+	}
+
+	stopping = false;
+
+	if ( pthread_create(&thread_, NULL, Sunset_Stat_Writer::writerThread, (void*)this) != 0 ) {
+
+		SUNSET_DEBUG_LOG(-1, -1, "Sunset_Stat_Writer::start ERROR creating writer thread - writing synchronously");
+
+		return false;
+	}
+
+	running = true;
+
+	return true;
+}
+
+/*!
+ * 	@brief The stop function hands all the pending records to the writer thread, waits until they have been
+ *	written and stops the thread.
+ */
+
+void Sunset_Stat_Writer::stop()
+{
+	if ( !running ) {
+
+		return;
+	}
+
+	flush();
+
+	pthread_mutex_lock(&mutex_);
+
+	stopping = true;
+	pthread_cond_signal(&cond_);
+
+	pthread_mutex_unlock(&mutex_);
+
+	pthread_join(thread_, NULL);
+
+	running = false;
+
+	if ( out_ != 0 ) {
+
+		out_->flush();
+	}
+}
+
+/*!
+ * 	@brief The begin function returns the memory where the calling thread can write a record of at most maxLen bytes.
+ *	The thread buffer is locked until end() is called. The lock is contended only by the time flush of the writer thread.
+ *	@param maxLen The maximum length of the record.
+ *	@retval The pointer where the record has to be written.
+ */
+
+char* Sunset_Stat_Writer::begin(int maxLen)
+{
+	stat_thread_buffer* b = getThreadBuffer();
+	stat_block* blk = 0;
+
+	pthread_mutex_lock(&(b->lock));
+
+	blk = b->block;
+
+	if ( blk == 0 ) {
+
+		blk = b->block = getFreeBlock(maxLen);
+	}
+
+	if ( blk->len + maxLen > blk->size ) {
+
+		handOff(b);
+
+		blk = b->block = getFreeBlock(maxLen);
+	}
+
+	return blk->data + blk->len;
+}
+
+/*!
+ * 	@brief The end function commits the record written after begin() and releases the thread buffer. When the writer thread
+ *	is not running the block is written directly on file.
+ *	@param len The number of bytes written.
+ */
+
+void Sunset_Stat_Writer::end(int len)
+{
+	stat_thread_buffer* b = (stat_thread_buffer*)pthread_getspecific(key_);
+	stat_block* blk = b->block;
+
+	blk->len += len;
+
+	if ( !running ) {
+
+		if ( out_ != 0 ) {
+
+			out_->write(blk->data, blk->len);
+			out_->flush();
+		}
+
+		blk->len = 0;
+	}
+	else if ( blk->len >= blockSize_ ) {
+
+		handOff(b);
+	}
+
+	pthread_mutex_unlock(&(b->lock));
+}
+
+/*!
+ * 	@brief The flush function hands all the partially filled thread blocks to the writer thread.
+ */
+
+void Sunset_Stat_Writer::flush()
+{
+	list<stat_thread_buffer*> snapshot;
+	list<stat_thread_buffer*>::iterator it;
+
+	pthread_mutex_lock(&mutex_);
+	snapshot = buffers;
+	pthread_mutex_unlock(&mutex_);
+
+	for ( it = snapshot.begin(); it != snapshot.end(); it++ ) {
+
+		pthread_mutex_lock(&((*it)->lock));
+
+		if ( (*it)->block != 0 && (*it)->block->len > 0 ) {
+
+			handOff(*it);
+		}
+
+		pthread_mutex_unlock(&((*it)->lock));
+	}
+}
+
+/*!
+ * 	@brief The getThreadBuffer function returns the buffer of the calling thread, creating it the first time.
+ */
+
+stat_thread_buffer* Sunset_Stat_Writer::getThreadBuffer()
+{
+	stat_thread_buffer* b = (stat_thread_buffer*)pthread_getspecific(key_);
+
+	if ( b != 0 ) {
+
+		return b;
+	}
+
+	b = (stat_thread_buffer*) malloc (sizeof(stat_thread_buffer));
+
+	if ( b == NULL ) {
+
+		SUNSET_DEBUG_LOG(-1, -1, "Sunset_Stat_Writer::getThreadBuffer MALLOC ERROR");
+
+		exit(1);
+	}
+
+	pthread_mutex_init(&(b->lock), NULL);
+	b->block = 0;
+
+	pthread_setspecific(key_, (void*)b);
+
+	pthread_mutex_lock(&mutex_);
+	buffers.push_back(b);
+	pthread_mutex_unlock(&mutex_);
+
+	return b;
+}
+
+/*!
+ * 	@brief The getFreeBlock function returns an empty block, a new one is allocated only if no block can be reused.
+ *	@param maxLen The maximum length of the record which will be written in the block.
+ */
+
+stat_block* Sunset_Stat_Writer::getFreeBlock(int maxLen)
+{
+	stat_block* blk = 0;
+
+	pthread_mutex_lock(&mutex_);
+
+	if ( !freeBlocks.empty() ) {
+
+		blk = freeBlocks.front();
+		freeBlocks.pop_front();
+	}
+
+	pthread_mutex_unlock(&mutex_);
+
+	if ( blk != 0 ) {
+
+		blk->len = 0;
+
+		if ( blk->size >= blockSize_ + maxLen ) {
+
+			return blk;
+		}
+
+		free(blk->data);
+		free(blk);
+	}
+
+	blk = (stat_block*) malloc (sizeof(stat_block));
+
+	if ( blk == NULL ) {
+
+		SUNSET_DEBUG_LOG(-1, -1, "Sunset_Stat_Writer::getFreeBlock MALLOC ERROR");
+
+		exit(1);
+	}
+
+	// a record is never split: a block has room for a full block plus the largest record
+
+	blk->size = blockSize_ + maxLen;
+	blk->len = 0;
+	blk->data = (char*) malloc (blk->size);
+
+	if ( blk->data == NULL ) {
+
+		SUNSET_DEBUG_LOG(-1, -1, "Sunset_Stat_Writer::getFreeBlock MALLOC ERROR");
+
+		exit(1);
+	}
+
+	return blk;
+}
+
+/*!
+ * 	@brief The handOff function moves the block of the given thread buffer to the writer queue. The thread buffer lock has to be held.
+ */
+
+void Sunset_Stat_Writer::handOff(stat_thread_buffer* b)
+{
+	if ( b->block == 0 ) {
+
+		return;
+	}
+
+	pthread_mutex_lock(&mutex_);
+
+	fullBlocks.push_back(b->block);
+	pthread_cond_signal(&cond_);
+
+	pthread_mutex_unlock(&mutex_);
+
+	b->block = 0;
+}
+
+void* Sunset_Stat_Writer::writerThread(void* arg)
+{
+	((Sunset_Stat_Writer*)arg)->run();
+
+	return NULL;
+}
+
+/*!
+ * 	@brief The run function is executed by the writer thread. It writes the queued blocks on file and, every flush interval,
+ *	collects the partially filled thread blocks. It returns when stop() has been called and the queue is empty.
+ */
+
+void Sunset_Stat_Writer::run()
+{
+	struct timeval now;
+	struct timespec deadline;
+	stat_block* blk = 0;
+	int ret = 0;
+
+	while ( true ) {
+
+		gettimeofday(&now, NULL);
+
+		deadline.tv_sec = now.tv_sec + (time_t)flushInterval_;
+		deadline.tv_nsec = now.tv_usec * 1000 + (long)((flushInterval_ - (time_t)flushInterval_) * 1e9);
+
+		if ( deadline.tv_nsec >= 1000000000L ) {
+
+			deadline.tv_sec++;
+			deadline.tv_nsec -= 1000000000L;
+		}
+
+		pthread_mutex_lock(&mutex_);
+
+		ret = 0;
+
+		while ( fullBlocks.empty() && !stopping && ret != ETIMEDOUT ) {
+
+			ret = pthread_cond_timedwait(&cond_, &mutex_, &deadline);
+		}
+
+		if ( fullBlocks.empty() && stopping ) {
+
+			pthread_mutex_unlock(&mutex_);
+
+			break;
+		}
+
+		if ( fullBlocks.empty() ) {
+
+			// flush interval expired: collect the partially filled blocks (thread buffer locks are taken before mutex_)
+
+			pthread_mutex_unlock(&mutex_);
+
+			flush();
+
+			continue;
+		}
+
+		while ( !fullBlocks.empty() ) {
+
+			blk = fullBlocks.front();
+			fullBlocks.pop_front();
+
+			pthread_mutex_unlock(&mutex_);
+
+			if ( out_ != 0 && blk->len > 0 ) {
+
+				out_->write(blk->data, blk->len);
+			}
+
+			blk->len = 0;
+
+			pthread_mutex_lock(&mutex_);
+
+			freeBlocks.push_back(blk);
+		}
+
+		pthread_mutex_unlock(&mutex_);
+
+		if ( out_ != 0 ) {
+
+			out_->flush();
+		}
+	}
+}
@@ -0,0 +1,108 @@
+/* SUNSET - Sapienza University Networking framework for underwater Simulation, Emulation and real-life Testing
+ *
+ * Copyright (C) 2012 Regents of UWSN Group of SENSES Lab <http://reti.dsi.uniroma1.it/SENSES_lab/>
+ *
+ * Author: Roberto Petroccia - petroccia@di.uniroma1.it
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License as published
+ * at http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANATBILITY or FITNESS FOR A PARTICULAR PURPOSE. See the Creative Commons
+ * Attribution-NonCommercial-ShareAlike 3.0 Unported License for more details.
+ *
+ * You should have received a copy of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License
+ * along with this program. If not, see <http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode>.
+ */
+
+#ifndef __Sunset_Stat_Writer_h__
+#define __Sunset_Stat_Writer_h__
+
+#include <list>
+#include <fstream>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/time.h>
+
+#include <sunset_debug.h>
+
+using namespace std;
+
+#define STAT_WRITER_BLOCK_SIZE		65536	/*!< @brief Default size (bytes) of a block before it is handed to the writer thread. */
+#define STAT_WRITER_FLUSH_INTERVAL	1.0	/*!< @brief Default interval (sec) after which partially filled blocks are written. */
+
+/*! @brief A block of records waiting to be written on file. */
+
+typedef struct stat_block {
+
+	char* data;
+	int len;	// bytes currently stored
+	int size;	// allocated bytes
+
+} stat_block;
+
+/*! @brief The append-only buffer of a thread producing statistics records. */
+
+typedef struct stat_thread_buffer {
+
+	pthread_mutex_t lock;	// taken by the owner thread and, on time flush, by the writer thread
+	stat_block* block;
+
+} stat_thread_buffer;
+
+/*! @brief This class implements the asynchronous writer used by the statistics module. Each thread appends the
+ *  records in its own block, full blocks are handed to a background thread which writes them on file. Blocks are
+ *  recycled, no memory is allocated per record. Blocks are written when they reach the configured size, when
+ *  the flush interval expires or when the writer is stopped.
+ */
+
+class Sunset_Stat_Writer {
+
+public:
+
+	Sunset_Stat_Writer();
+	~Sunset_Stat_Writer();
+
+	bool start(ofstream* out, int blockSize, double flushInterval);	// start the writer thread
+	void stop();		// write all pending records and stop the writer thread
+
+	char* begin(int maxLen);	// return where the calling thread can write up to maxLen bytes
+	void end(int len);		// commit len bytes written after begin()
+
+	void flush();		// hand all the partially filled blocks to the writer thread
+
+	bool isRunning() { return running; }
+
+private:
+
+	static void* writerThread(void* arg);
+	void run();
+
+	stat_thread_buffer* getThreadBuffer();
+	stat_block* getFreeBlock(int maxLen);
+	void handOff(stat_thread_buffer* b);
+
+	ofstream* out_;
+
+	int blockSize_;
+	double flushInterval_;
+
+	bool running;
+	bool stopping;
+
+	pthread_t thread_;
+	pthread_key_t key_;
+
+	pthread_mutex_t mutex_;		// protects the lists below
+	pthread_cond_t cond_;
+
+	list<stat_thread_buffer*> buffers;	// per-thread buffers
+	list<stat_block*> fullBlocks;		// blocks waiting to be written
+	list<stat_block*> freeBlocks;		// blocks ready to be reused
+};
+
+#endif
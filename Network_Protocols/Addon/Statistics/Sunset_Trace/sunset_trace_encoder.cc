@@ -0,0 +1,308 @@
+/* SUNSET - Sapienza University Networking framework for underwater Simulation, Emulation and real-life Testing
+ *
+ * Copyright (C) 2012 Regents of UWSN Group of SENSES Lab <http://reti.dsi.uniroma1.it/SENSES_lab/>
+ *
+ * Author: Roberto Petroccia - petroccia@di.uniroma1.it
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License as published
+ * at http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANATBILITY or FITNESS FOR A PARTICULAR PURPOSE. See the Creative Commons
+ * Attribution-NonCommercial-ShareAlike 3.0 Unported License for more details.
+ *
+ * You should have received a copy of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License
+ * along with this program. If not, see <http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode>.
+ */
+
+#include "sunset_trace_encoder.h"
+
+Sunset_Trace_Encoder::Sunset_Trace_Encoder(int chunkRecords) 
+{
+	chunkRecords_ = (chunkRecords > 0) ? chunkRecords : SUNSET_TRACE_CHUNK_RECORDS;
+	numRecords = 0;
+}
+
+/*!
+ * 	@brief The add function adds a record to the current chunk.
+ *	@param r The record.
+ *	@param info The additional text of the record.
+ *	@param infoLen The length of the additional text.
+ *	@param energy The SUNSET_TRACE_ENERGY_VALUES values of an energy record, 0 for the other records.
+ */
+
+void Sunset_Trace_Encoder::add(const sunset_trace_record& r, const char* info, int infoLen, const double* energy) 
+{
+	statType.push_back((char)r.stat_type);
+	pktType.push_back((char)r.pkt_type);
+	realTime.push_back(Sunset_Trace_Codec::toTicks(r.real_time));
+	time.push_back(Sunset_Trace_Codec::toTicks(r.time));
+	node.push_back(r.node);
+	src.push_back(r.src);
+	dst.push_back(r.dst);
+	agtSrc.push_back(r.agt_src);
+	agtDst.push_back(r.agt_dst);
+	agtPktId.push_back(r.agt_pkt_id);
+	pktSize.push_back(r.pkt_size);
+	numHop.push_back(r.num_hop);
+	rssi.push_back(r.rssi);
+	linkQuality.push_back(r.link_quality);
+	
+	if ( info == 0 || infoLen < 0 ) {
+		
+		infoLen = 0;
+	}
+	
+	infoLen_.push_back(infoLen);
+	info_.insert(info_.end(), info, info + infoLen);
+	
+	if ( energy != 0 ) {
+		
+		energy_.insert(energy_.end(), energy, energy + SUNSET_TRACE_ENERGY_VALUES);
+	}
+	
+	numRecords++;
+}
+
+/*!
+ * 	@brief The maxEncodedSize function returns an upper bound of the bytes needed to encode the current chunk.
+ */
+
+int Sunset_Trace_Encoder::maxEncodedSize() 
+{
+	// 2 single byte columns, 9 varint columns (at most 10 bytes), 2 double columns, the info length (at most 5 bytes)
+	
+	return SUNSET_TRACE_CHUNK_HEADER_SIZE + SUNSET_TRACE_NUM_COLUMNS * SUNSET_TRACE_COLUMN_ENTRY_SIZE + 
+		numRecords * (2 + 9 * 10 + 2 * 8 + 5) + info_.size() + energy_.size() * 8;
+}
+
+int Sunset_Trace_Encoder::putColumnEntry(char* out, int id, int offset, int size, int encoding) 
+{
+	Sunset_Trace_Codec::putU32(out, id);
+	Sunset_Trace_Codec::putU32(out + 4, offset);
+	Sunset_Trace_Codec::putU32(out + 8, size);
+	Sunset_Trace_Codec::putU32(out + 12, encoding);
+	
+	return SUNSET_TRACE_COLUMN_ENTRY_SIZE;
+}
+
+int Sunset_Trace_Encoder::putDeltaColumn(char* out, const vector<int>& v) 
+{
+	int64_t prev = 0;
+	int len = 0;
+	
+	for ( unsigned int i = 0; i < v.size(); i++ ) {
+		
+		len += Sunset_Trace_Codec::putVarint(out + len, Sunset_Trace_Codec::zigzag((int64_t)v[i] - prev));
+		prev = v[i];
+	}
+	
+	return len;
+}
+
+int Sunset_Trace_Encoder::putDeltaColumn(char* out, const vector<int64_t>& v) 
+{
+	int64_t prev = 0;
+	int len = 0;
+	
+	for ( unsigned int i = 0; i < v.size(); i++ ) {
+		
+		len += Sunset_Trace_Codec::putVarint(out + len, Sunset_Trace_Codec::zigzag(v[i] - prev));
+		prev = v[i];
+	}
+	
+	return len;
+}
+
+/*!
+ * 	@brief The encode function writes the current chunk in out and starts a new chunk.
+ *	@param out The output buffer, it has to contain at least maxEncodedSize() bytes.
+ *	@retval len The number of bytes written, 0 if the chunk is empty.
+ */
+
+int Sunset_Trace_Encoder::encode(char* out) 
+{
+	char* dir = out + SUNSET_TRACE_CHUNK_HEADER_SIZE;
+	char* payload = dir + SUNSET_TRACE_NUM_COLUMNS * SUNSET_TRACE_COLUMN_ENTRY_SIZE;
+	int len = 0;
+	int start = 0;
+	int col = 0;
+	unsigned int i = 0;
+	
+	if ( numRecords == 0 ) {
+		
+		return 0;
+	}
+	
+	memcpy(payload + len, &(statType[0]), numRecords);
+	dir += putColumnEntry(dir, SUNSET_TRACE_COL_STAT_TYPE, len, numRecords, SUNSET_TRACE_ENC_U8);
+	len += numRecords;
+	
+	memcpy(payload + len, &(pktType[0]), numRecords);
+	dir += putColumnEntry(dir, SUNSET_TRACE_COL_PKT_TYPE, len, numRecords, SUNSET_TRACE_ENC_U8);
+	len += numRecords;
+	
+	start = len;
+	len += putDeltaColumn(payload + len, realTime);
+	dir += putColumnEntry(dir, SUNSET_TRACE_COL_REAL_TIME, start, len - start, SUNSET_TRACE_ENC_DELTA_VARINT);
+	
+	start = len;
+	len += putDeltaColumn(payload + len, time);
+	dir += putColumnEntry(dir, SUNSET_TRACE_COL_TIME, start, len - start, SUNSET_TRACE_ENC_DELTA_VARINT);
+	
+	const vector<int>* ids[] = { &node, &src, &dst, &agtSrc, &agtDst, &agtPktId };
+	int idCols[] = { SUNSET_TRACE_COL_NODE, SUNSET_TRACE_COL_SRC, SUNSET_TRACE_COL_DST, 
+			 SUNSET_TRACE_COL_AGT_SRC, SUNSET_TRACE_COL_AGT_DST, SUNSET_TRACE_COL_AGT_PKT_ID };
+	
+	for ( col = 0; col < 6; col++ ) {
+		
+		start = len;
+		len += putDeltaColumn(payload + len, *(ids[col]));
+		dir += putColumnEntry(dir, idCols[col], start, len - start, SUNSET_TRACE_ENC_DELTA_VARINT);
+	}
+	
+	start = len;
+	
+	for ( i = 0; i < pktSize.size(); i++ ) {
+		
+		len += Sunset_Trace_Codec::putVarint(payload + len, (uint32_t)pktSize[i]);
+	}
+	
+	dir += putColumnEntry(dir, SUNSET_TRACE_COL_PKT_SIZE, start, len - start, SUNSET_TRACE_ENC_VARINT);
+	
+	start = len;
+	
+	for ( i = 0; i < numHop.size(); i++ ) {
+		
+		len += Sunset_Trace_Codec::putVarint(payload + len, (uint32_t)numHop[i]);
+	}
+	
+	dir += putColumnEntry(dir, SUNSET_TRACE_COL_NUM_HOP, start, len - start, SUNSET_TRACE_ENC_VARINT);
+	
+	start = len;
+	
+	for ( i = 0; i < rssi.size(); i++ ) {
+		
+		Sunset_Trace_Codec::putF64(payload + len, rssi[i]);
+		len += 8;
+	}
+	
+	dir += putColumnEntry(dir, SUNSET_TRACE_COL_RSSI, start, len - start, SUNSET_TRACE_ENC_F64);
+	
+	start = len;
+	
+	for ( i = 0; i < linkQuality.size(); i++ ) {
+		
+		Sunset_Trace_Codec::putF64(payload + len, linkQuality[i]);
+		len += 8;
+	}
+	
+	dir += putColumnEntry(dir, SUNSET_TRACE_COL_LINK_QUALITY, start, len - start, SUNSET_TRACE_ENC_F64);
+	
+	start = len;
+	
+	for ( i = 0; i < infoLen_.size(); i++ ) {
+		
+		len += Sunset_Trace_Codec::putVarint(payload + len, (uint32_t)infoLen_[i]);
+	}
+	
+	dir += putColumnEntry(dir, SUNSET_TRACE_COL_INFO_LEN, start, len - start, SUNSET_TRACE_ENC_VARINT);
+	
+	if ( !info_.empty() ) {
+		
+		memcpy(payload + len, &(info_[0]), info_.size());
+	}
+	
+	dir += putColumnEntry(dir, SUNSET_TRACE_COL_INFO, len, info_.size(), SUNSET_TRACE_ENC_BYTES);
+	len += info_.size();
+	
+	start = len;
+	
+	for ( i = 0; i < energy_.size(); i++ ) {
+		
+		Sunset_Trace_Codec::putF64(payload + len, energy_[i]);
+		len += 8;
+	}
+	
+	dir += putColumnEntry(dir, SUNSET_TRACE_COL_ENERGY, start, len - start, SUNSET_TRACE_ENC_F64);
+	
+	memcpy(out, SUNSET_TRACE_CHUNK_MAGIC, 4);
+	Sunset_Trace_Codec::putU32(out + 4, SUNSET_TRACE_CHUNK_RECORDS_TYPE);
+	Sunset_Trace_Codec::putU32(out + 8, numRecords);
+	Sunset_Trace_Codec::putU32(out + 12, len);
+	Sunset_Trace_Codec::putU32(out + 16, SUNSET_TRACE_NUM_COLUMNS);
+	Sunset_Trace_Codec::putU32(out + 20, 0);
+	
+	// the buffers keep their capacity for the next chunk
+	
+	statType.clear();
+	pktType.clear();
+	realTime.clear();
+	time.clear();
+	node.clear();
+	src.clear();
+	dst.clear();
+	agtSrc.clear();
+	agtDst.clear();
+	agtPktId.clear();
+	pktSize.clear();
+	numHop.clear();
+	rssi.clear();
+	linkQuality.clear();
+	infoLen_.clear();
+	info_.clear();
+	energy_.clear();
+	
+	numRecords = 0;
+	
+	return SUNSET_TRACE_CHUNK_HEADER_SIZE + SUNSET_TRACE_NUM_COLUMNS * SUNSET_TRACE_COLUMN_ENTRY_SIZE + len;
+}
+
+/*!
+ * 	@brief The encodeFileHeader function writes the trace file header in out (SUNSET_TRACE_FILE_HEADER_SIZE bytes).
+ */
+
+int Sunset_Trace_Encoder::encodeFileHeader(char* out) 
+{
+	memset(out, 0, SUNSET_TRACE_FILE_HEADER_SIZE);
+	memcpy(out, SUNSET_TRACE_MAGIC, 4);
+	Sunset_Trace_Codec::putU16(out + 4, SUNSET_TRACE_VERSION);
+	Sunset_Trace_Codec::putU16(out + 6, SUNSET_TRACE_FILE_HEADER_SIZE);
+	Sunset_Trace_Codec::putU32(out + 8, SUNSET_TRACE_TIME_SCALE);
+	Sunset_Trace_Codec::putU32(out + 12, 0);
+	
+	return SUNSET_TRACE_FILE_HEADER_SIZE;
+}
+
+/*!
+ * 	@brief The encodeMeta function writes the meta chunk in out (at most maxMetaSize() bytes).
+ */
+
+int Sunset_Trace_Encoder::encodeMeta(char* out, const sunset_trace_meta& meta) 
+{
+	int keys[] = { SUNSET_TRACE_META_START_TIME, SUNSET_TRACE_META_STOP_TIME, SUNSET_TRACE_META_START_TRAFFIC, 
+		       SUNSET_TRACE_META_PREAMBLE_SIZE, SUNSET_TRACE_META_MAX_NODE_ID, SUNSET_TRACE_META_BROADCAST, 
+		       SUNSET_TRACE_META_TOTAL_ENERGY, SUNSET_TRACE_META_RUN_ID };
+	double values[] = { meta.start_time, meta.stop_time, meta.start_traffic, (double)meta.preamble_size, 
+			    (double)meta.max_node_id, (double)meta.broadcast, meta.total_energy, (double)meta.run_id };
+	char* p = out + SUNSET_TRACE_CHUNK_HEADER_SIZE;
+	
+	for ( int i = 0; i < SUNSET_TRACE_META_NUM_KEYS; i++ ) {
+		
+		Sunset_Trace_Codec::putU32(p, keys[i]);
+		Sunset_Trace_Codec::putU32(p + 4, 0);
+		Sunset_Trace_Codec::putF64(p + 8, values[i]);
+		p += SUNSET_TRACE_META_ENTRY_SIZE;
+	}
+	
+	memcpy(out, SUNSET_TRACE_CHUNK_MAGIC, 4);
+	Sunset_Trace_Codec::putU32(out + 4, SUNSET_TRACE_CHUNK_META_TYPE);
+	Sunset_Trace_Codec::putU32(out + 8, SUNSET_TRACE_META_NUM_KEYS);
+	Sunset_Trace_Codec::putU32(out + 12, SUNSET_TRACE_META_NUM_KEYS * SUNSET_TRACE_META_ENTRY_SIZE);
+	Sunset_Trace_Codec::putU32(out + 16, 0);
+	Sunset_Trace_Codec::putU32(out + 20, 0);
+	
+	return maxMetaSize();
+}
@@ -0,0 +1,80 @@
+/* SUNSET - Sapienza University Networking framework for underwater Simulation, Emulation and real-life Testing
+ *
+ * Copyright (C) 2012 Regents of UWSN Group of SENSES Lab <http://reti.dsi.uniroma1.it/SENSES_lab/>
+ *
+ * Author: Roberto Petroccia - petroccia@di.uniroma1.it
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License as published
+ * at http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANATBILITY or FITNESS FOR A PARTICULAR PURPOSE. See the Creative Commons
+ * Attribution-NonCommercial-ShareAlike 3.0 Unported License for more details.
+ *
+ * You should have received a copy of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License
+ * along with this program. If not, see <http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode>.
+ */
+
+#ifndef __Sunset_Trace_Encoder_h__
+#define __Sunset_Trace_Encoder_h__
+
+#include <vector>
+#include "sunset_trace_format.h"
+
+using namespace std;
+
+/*! @brief This class collects the statistics records in columns and encodes them in the SUNSET binary trace format.
+ *  The column buffers are reused from one chunk to the next one, no memory is allocated once they have reached 
+ *  their working size. The class is not thread safe, the caller has to serialize the accesses.
+ *  @see sunset_trace_format.h
+ */
+
+class Sunset_Trace_Encoder {
+	
+public:
+	
+	Sunset_Trace_Encoder(int chunkRecords = SUNSET_TRACE_CHUNK_RECORDS);
+	
+	void add(const sunset_trace_record& r, const char* info, int infoLen, const double* energy = 0); // add a record to the current chunk
+	
+	bool full() { return numRecords >= chunkRecords_; }
+	bool empty() { return numRecords == 0; }
+	
+	int maxEncodedSize();	// upper bound of the bytes needed to encode the current chunk
+	int encode(char* out);	// encode the current chunk in out and start a new one, it returns the bytes written
+	
+	static int encodeFileHeader(char* out);
+	static int maxMetaSize() { return SUNSET_TRACE_CHUNK_HEADER_SIZE + SUNSET_TRACE_META_NUM_KEYS * SUNSET_TRACE_META_ENTRY_SIZE; }
+	static int encodeMeta(char* out, const sunset_trace_meta& meta);
+	
+private:
+	
+	int chunkRecords_;
+	int numRecords;
+	
+	vector<char> statType;
+	vector<char> pktType;
+	vector<int64_t> realTime;
+	vector<int64_t> time;
+	vector<int> node;
+	vector<int> src;
+	vector<int> dst;
+	vector<int> agtSrc;
+	vector<int> agtDst;
+	vector<int> agtPktId;
+	vector<int> pktSize;
+	vector<int> numHop;
+	vector<double> rssi;
+	vector<double> linkQuality;
+	vector<int> infoLen_;
+	vector<char> info_;
+	vector<double> energy_;
+	
+	static int putColumnEntry(char* out, int id, int offset, int size, int encoding);
+	static int putDeltaColumn(char* out, const vector<int>& v);
+	static int putDeltaColumn(char* out, const vector<int64_t>& v);
+};
+
+#endif
@@ -0,0 +1,279 @@
+/* SUNSET - Sapienza University Networking framework for underwater Simulation, Emulation and real-life Testing
+ *
+ * Copyright (C) 2012 Regents of UWSN Group of SENSES Lab <http://reti.dsi.uniroma1.it/SENSES_lab/>
+ *
+ * Author: Roberto Petroccia - petroccia@di.uniroma1.it
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License as published
+ * at http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANATBILITY or FITNESS FOR A PARTICULAR PURPOSE. See the Creative Commons
+ * Attribution-NonCommercial-ShareAlike 3.0 Unported License for more details.
+ *
+ * You should have received a copy of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License
+ * along with this program. If not, see <http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode>.
+ */
+
+#ifndef __Sunset_Trace_Format_h__
+#define __Sunset_Trace_Format_h__
+
+#include <stdint.h>
+#include <string.h>
+
+/*
+ * The SUNSET binary trace is a sequence of self-contained chunks preceded by a file header:
+ *
+ *  file header   | magic "SNTR" | version (u16) | header size (u16) | time scale (u32) | flags (u32) | reserved (16 bytes) |
+ *  chunk header  | magic "SNCK" | chunk type (u32) | num records (u32) | payload size (u32) | num columns (u32) | reserved (u32) |
+ *  column entry  | column id (u32) | offset in payload (u32) | size (u32) | encoding (u32) |   (num columns entries)
+ *  payload       | column data |
+ *
+ * Record chunks store the records in columns (struct of arrays). Times are converted in ticks (1/time scale sec)
+ * and, as node IDs and packet IDs, are delta-encoded with respect to the previous record of the same chunk using
+ * zig-zag variable length integers. Each chunk is decoded independently, a reader can map the file in memory and 
+ * skip the chunks and the columns it is not interested in. Unknown columns and chunk types have to be ignored.
+ * The meta chunk, written when the statistics module is stopped, contains (key, value) pairs describing the experiment.
+ * All the values are stored little-endian.
+ */
+
+#define SUNSET_TRACE_MAGIC		"SNTR"
+#define SUNSET_TRACE_CHUNK_MAGIC	"SNCK"
+#define SUNSET_TRACE_VERSION		1
+#define SUNSET_TRACE_TIME_SCALE		1000000		/*!< @brief Ticks per second used to store the times. */
+#define SUNSET_TRACE_CHUNK_RECORDS	4096		/*!< @brief Default number of records in a chunk. */
+#define SUNSET_TRACE_ENERGY_VALUES	3		/*!< @brief Values stored for each energy record. */
+
+typedef enum {
+	
+	SUNSET_TRACE_CHUNK_RECORDS_TYPE = 1,
+	SUNSET_TRACE_CHUNK_META_TYPE = 2
+	
+} sunset_trace_chunk_type;
+
+typedef enum {
+	
+	SUNSET_TRACE_ENC_U8 = 1,		// one byte per record
+	SUNSET_TRACE_ENC_F64 = 2,		// IEEE 754 double per record
+	SUNSET_TRACE_ENC_VARINT = 3,		// unsigned variable length integer per record
+	SUNSET_TRACE_ENC_DELTA_VARINT = 4,	// zig-zag variable length integer of the difference with the previous record
+	SUNSET_TRACE_ENC_BYTES = 5		// raw bytes
+	
+} sunset_trace_encoding;
+
+typedef enum {
+	
+	SUNSET_TRACE_COL_STAT_TYPE = 1,
+	SUNSET_TRACE_COL_PKT_TYPE = 2,
+	SUNSET_TRACE_COL_REAL_TIME = 3,
+	SUNSET_TRACE_COL_TIME = 4,
+	SUNSET_TRACE_COL_NODE = 5,
+	SUNSET_TRACE_COL_SRC = 6,
+	SUNSET_TRACE_COL_DST = 7,
+	SUNSET_TRACE_COL_AGT_SRC = 8,
+	SUNSET_TRACE_COL_AGT_DST = 9,
+	SUNSET_TRACE_COL_AGT_PKT_ID = 10,
+	SUNSET_TRACE_COL_PKT_SIZE = 11,
+	SUNSET_TRACE_COL_NUM_HOP = 12,
+	SUNSET_TRACE_COL_RSSI = 13,
+	SUNSET_TRACE_COL_LINK_QUALITY = 14,
+	SUNSET_TRACE_COL_INFO_LEN = 15,		// length of the additional text of each record
+	SUNSET_TRACE_COL_INFO = 16,		// additional text of all the records
+	SUNSET_TRACE_COL_ENERGY = 17,		// SUNSET_TRACE_ENERGY_VALUES doubles for each energy record
+	SUNSET_TRACE_NUM_COLUMNS = 17
+	
+} sunset_trace_column;
+
+typedef enum {
+	
+	SUNSET_TRACE_META_START_TIME = 1,
+	SUNSET_TRACE_META_STOP_TIME = 2,
+	SUNSET_TRACE_META_START_TRAFFIC = 3,
+	SUNSET_TRACE_META_PREAMBLE_SIZE = 4,
+	SUNSET_TRACE_META_MAX_NODE_ID = 5,
+	SUNSET_TRACE_META_BROADCAST = 6,
+	SUNSET_TRACE_META_TOTAL_ENERGY = 7,
+	SUNSET_TRACE_META_RUN_ID = 8,
+	SUNSET_TRACE_META_NUM_KEYS = 8
+	
+} sunset_trace_meta_key;
+
+/*! @brief The action and packet types (sunset_statisticType and sunset_statisticPktType) used by the trace tools, 
+ *  which do not depend on the simulator headers. */
+
+typedef enum {
+	
+	SUNSET_TRACE_STAT_AGENT_TX = 1,
+	SUNSET_TRACE_STAT_AGENT_RX = 2,
+	SUNSET_TRACE_STAT_MAC_DISCARD = 8,
+	SUNSET_TRACE_STAT_MAC_RX = 9,
+	SUNSET_TRACE_STAT_MAC_TX_DONE = 25,
+	SUNSET_TRACE_STAT_MAC_NEW = 27,
+	SUNSET_TRACE_STAT_ENERGY_TX = 28,
+	SUNSET_TRACE_STAT_ENERGY_RX = 29,
+	SUNSET_TRACE_STAT_ENERGY_IDLE = 30
+	
+} sunset_trace_stat_type;
+
+#define SUNSET_TRACE_PKT_NONE	0
+#define SUNSET_TRACE_PKT_DATA	1
+
+#define SUNSET_TRACE_FILE_HEADER_SIZE	32
+#define SUNSET_TRACE_CHUNK_HEADER_SIZE	24
+#define SUNSET_TRACE_COLUMN_ENTRY_SIZE	16
+#define SUNSET_TRACE_META_ENTRY_SIZE	16
+
+/*! @brief A record of the trace, it contains the information of the statInfo structure logged by the statistics module. */
+
+typedef struct sunset_trace_record {
+	
+	int stat_type;
+	int pkt_type;
+	double real_time;
+	double time;
+	int node;
+	int src;
+	int dst;
+	int agt_src;
+	int agt_dst;
+	int agt_pkt_id;
+	int pkt_size;
+	int num_hop;
+	double rssi;
+	double link_quality;
+	
+} sunset_trace_record;
+
+/*! @brief The experiment information stored in the meta chunk. */
+
+typedef struct sunset_trace_meta {
+	
+	double start_time;
+	double stop_time;
+	double start_traffic;
+	int preamble_size;
+	int max_node_id;
+	int broadcast;
+	double total_energy;
+	int run_id;
+	
+} sunset_trace_meta;
+
+/*! @brief Helper functions to encode and decode the trace values. */
+
+class Sunset_Trace_Codec {
+	
+public:
+	
+	static inline uint64_t zigzag(int64_t v) { return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63); }
+	
+	static inline int64_t unzigzag(uint64_t v) { return (int64_t)(v >> 1) ^ -(int64_t)(v & 1); }
+	
+	static inline int64_t toTicks(double t) 
+	{
+		double v = t * SUNSET_TRACE_TIME_SCALE;
+		
+		return (int64_t)(v < 0 ? v - 0.5 : v + 0.5);
+	}
+	
+	static inline double fromTicks(int64_t t, uint32_t scale) { return (double)t / (double)scale; }
+	
+	/*! @brief The putVarint function writes v using 7 bits per byte and returns the number of bytes written (at most 10). */
+	
+	static inline int putVarint(char* out, uint64_t v)
+	{
+		int n = 0;
+		
+		while ( v >= 0x80 ) {
+			
+			out[n++] = (char)((v & 0x7f) | 0x80);
+			v >>= 7;
+		}
+		
+		out[n++] = (char)v;
+		
+		return n;
+	}
+	
+	/*! @brief The getVarint function reads a value written by putVarint, it returns the number of bytes read, 0 on error. */
+	
+	static inline int getVarint(const char* in, const char* end, uint64_t* v)
+	{
+		uint64_t res = 0;
+		int shift = 0;
+		int n = 0;
+		
+		while ( in + n < end && shift < 64 ) {
+			
+			uint8_t b = (uint8_t)in[n++];
+			
+			res |= (uint64_t)(b & 0x7f) << shift;
+			
+			if ( (b & 0x80) == 0 ) {
+				
+				*v = res;
+				
+				return n;
+			}
+			
+			shift += 7;
+		}
+		
+		return 0;
+	}
+	
+	static inline void putU16(char* out, uint16_t v) { out[0] = (char)(v & 0xff); out[1] = (char)(v >> 8); }
+	
+	static inline void putU32(char* out, uint32_t v) 
+	{
+		for ( int i = 0; i < 4; i++ ) {
+			
+			out[i] = (char)((v >> (8 * i)) & 0xff);
+		}
+	}
+	
+	static inline uint16_t getU16(const char* in) { return (uint16_t)((uint8_t)in[0] | ((uint8_t)in[1] << 8)); }
+	
+	static inline uint32_t getU32(const char* in) 
+	{
+		uint32_t v = 0;
+		
+		for ( int i = 0; i < 4; i++ ) {
+			
+			v |= (uint32_t)((uint8_t)in[i]) << (8 * i);
+		}
+		
+		return v;
+	}
+	
+	static inline void putF64(char* out, double d)
+	{
+		uint64_t v = 0;
+		
+		memcpy(&v, &d, sizeof(double));
+		
+		for ( int i = 0; i < 8; i++ ) {
+			
+			out[i] = (char)((v >> (8 * i)) & 0xff);
+		}
+	}
+	
+	static inline double getF64(const char* in)
+	{
+		uint64_t v = 0;
+		double d = 0.0;
+		
+		for ( int i = 0; i < 8; i++ ) {
+			
+			v |= (uint64_t)((uint8_t)in[i]) << (8 * i);
+		}
+		
+		memcpy(&d, &v, sizeof(double));
+		
+		return d;
+	}
+};
+
+#endif
@@ -0,0 +1,895 @@
+/* SUNSET - Sapienza University Networking framework for underwater Simulation, Emulation and real-life Testing
+ *
+ * Copyright (C) 2012 Regents of UWSN Group of SENSES Lab <http://reti.dsi.uniroma1.it/SENSES_lab/>
+ *
+ * Author: Roberto Petroccia - petroccia@di.uniroma1.it
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License as published
+ * at http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANATBILITY or FITNESS FOR A PARTICULAR PURPOSE. See the Creative Commons
+ * Attribution-NonCommercial-ShareAlike 3.0 Unported License for more details.
+ *
+ * You should have received a copy of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License
+ * along with this program. If not, see <http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode>.
+ */
+
+#include "sunset_trace_metrics.h"
+
+#define TRACE_LINK_LOOP(BROADCAST) \
+	for (map <int, map <int, trace_link_info> >::iterator it = link_info.begin(); it != link_info.end(); it++) \
+		for (map <int, trace_link_info>::iterator it1 = (it->second).begin(); it1 != (it->second).end(); it1++) \
+			if (isReportedLink(it->first, it1->first, BROADCAST))
+
+Sunset_Trace_Metrics::Sunset_Trace_Metrics() 
+{
+	memset(&meta, 0, sizeof(sunset_trace_meta));
+	meta.broadcast = -1;
+	computed = true;
+}
+
+/*!
+ * 	@brief The add function processes all the records of a chunk.
+ */
+
+void Sunset_Trace_Metrics::add(const sunset_trace_chunk& c) 
+{
+	sunset_trace_record r;
+	
+	for ( int i = 0; i < c.numRecords; i++ ) {
+		
+		c.getRecord(i, r);
+		
+		addRecord(r, (c.energyOffset[i] >= 0) ? &(c.energy[c.energyOffset[i]]) : 0);
+	}
+}
+
+/*!
+ * 	@brief The addRecord function processes a record as done by the update_data function of the statistics module.
+ *	@param r The record.
+ *	@param energy The values of an energy record, 0 for the other records.
+ */
+
+void Sunset_Trace_Metrics::addRecord(const sunset_trace_record& r, const double* energy) 
+{
+	bool bcast = (r.dst == meta.broadcast);
+	
+	switch ( r.stat_type ) {
+		
+		case SUNSET_TRACE_STAT_ENERGY_TX:
+		{
+			if ( energy == 0 ) {
+				
+				return;
+			}
+			
+			// watt, tx power, duration
+			
+			if ( txPower.find(energy[1]) == txPower.end() ) {
+				
+				txPower[energy[1]] = energy[0];
+			}
+			
+			txTime[r.node][energy[1]] += energy[2];
+			consumed[r.node] += energy[0] * energy[2];
+			
+			return;
+		}
+		
+		case SUNSET_TRACE_STAT_ENERGY_RX:
+		case SUNSET_TRACE_STAT_ENERGY_IDLE:
+		{
+			if ( energy == 0 ) {
+				
+				return;
+			}
+			
+			// power, duration
+			
+			if ( r.stat_type == SUNSET_TRACE_STAT_ENERGY_RX ) {
+				
+				rxTime[r.node][energy[0]] += energy[1];
+			}
+			else {
+				
+				idleTime[r.node][energy[0]] += energy[1];
+			}
+			
+			consumed[r.node] += energy[0] * energy[1];
+			
+			return;
+		}
+		
+		default:
+			break;
+	}
+	
+	if ( r.pkt_type == SUNSET_TRACE_PKT_NONE ) {
+		
+		return;
+	}
+	
+	computed = false;
+	
+	switch ( r.stat_type ) {
+		
+		case SUNSET_TRACE_STAT_AGENT_TX:
+		{
+			if ( r.pkt_type != SUNSET_TRACE_PKT_DATA ) {
+				
+				return;
+			}
+			
+			map <int, trace_pkt_tx>& sent = pkt_sent[r.agt_src];
+			
+			if ( sent.find(r.agt_pkt_id) == sent.end() ) {
+				
+				trace_pkt_tx tx;
+				
+				tx.count = 0;
+				tx.first = r.real_time;
+				sent[r.agt_pkt_id] = tx;
+			}
+			
+			trace_pkt_tx& tx = sent[r.agt_pkt_id];
+			
+			tx.count++;
+			tx.dst = r.agt_dst;
+			tx.size = r.pkt_size;
+			
+			return;
+		}
+		
+		case SUNSET_TRACE_STAT_AGENT_RX:
+		{
+			if ( r.pkt_type != SUNSET_TRACE_PKT_DATA ) {
+				
+				return;
+			}
+			
+			map <int, trace_pkt_rx>& recv = (pkt_recv[r.agt_dst])[r.agt_src];
+			map <int, trace_pkt_rx>::iterator it = recv.find(r.agt_pkt_id);
+			
+			if ( it == recv.end() ) {
+				
+				trace_pkt_rx rx;
+				
+				rx.count = 1;
+				rx.first = r.real_time;
+				rx.hop = r.num_hop;
+				rx.dup_hop = -1;
+				recv[r.agt_pkt_id] = rx;
+				
+				return;
+			}
+			
+			if ( (it->second).dup_hop < 0 ) {
+				
+				(it->second).dup_hop = r.num_hop;
+			}
+			
+			(it->second).count++;
+			(it->second).dup.push_back(r.real_time);
+			
+			return;
+		}
+		
+		case SUNSET_TRACE_STAT_MAC_NEW:
+		{
+			if ( r.pkt_type == SUNSET_TRACE_PKT_DATA ) {
+				
+				trace_link_info& info = (link_info[r.node])[r.dst];
+				
+				info.mac_data_new_++;
+				info.mac_data_new_bytes_ += r.pkt_size;
+			}
+			
+			return;
+		}
+		
+		case SUNSET_TRACE_STAT_MAC_TX_DONE:
+		{
+			trace_link_info& info = (link_info[r.src])[r.dst];
+			
+			if ( r.pkt_type == SUNSET_TRACE_PKT_DATA ) {
+				
+				info.mac_data_tx_++;
+				info.mac_data_tx_bytes_ += r.pkt_size;
+			}
+			else {
+				
+				info.mac_ctrl_tx_++;
+				info.mac_ctrl_tx_bytes_ += r.pkt_size;
+			}
+			
+			return;
+		}
+		
+		case SUNSET_TRACE_STAT_MAC_DISCARD:
+		{
+			trace_link_info& info = (link_info[r.node])[r.dst];
+			
+			if ( r.pkt_type == SUNSET_TRACE_PKT_DATA ) {
+				
+				info.mac_data_discarded_++;
+			}
+			else {
+				
+				info.mac_ctrl_discarded_++;
+			}
+			
+			return;
+		}
+		
+		case SUNSET_TRACE_STAT_MAC_RX:
+		{
+			if ( r.node != r.dst && !bcast ) {
+				
+				return;
+			}
+			
+			trace_link_info& info = (link_info[r.src])[r.dst];
+			
+			if ( r.pkt_type == SUNSET_TRACE_PKT_DATA ) {
+				
+				info.mac_data_rx_++;
+				info.mac_data_rx_bytes_ += r.pkt_size;
+			}
+			else {
+				
+				info.mac_ctrl_rx_++;
+				info.mac_ctrl_rx_bytes_ += r.pkt_size;
+			}
+			
+			return;
+		}
+		
+		default:
+			return;
+	}
+}
+
+/*!
+ * 	@brief The compute function computes the application layer information of all the links from the 
+ *		generated and received packets.
+ */
+
+void Sunset_Trace_Metrics::compute() 
+{
+	map <int, map <int, trace_link_info> >::iterator it;
+	map <int, trace_link_info>::iterator it1;
+	map <int, map <int, trace_pkt_tx> >::iterator its;
+	map <int, trace_pkt_tx>::iterator its1;
+	map <int, map <int, map <int, trace_pkt_rx> > >::iterator itr;
+	map <int, map <int, trace_pkt_rx> >::iterator itr1;
+	map <int, trace_pkt_rx>::iterator itr2;
+	list<double>::iterator itd;
+	
+	if ( computed ) {
+		
+		return;
+	}
+	
+	for ( it = link_info.begin(); it != link_info.end(); it++ ) {
+		
+		for ( it1 = (it->second).begin(); it1 != (it->second).end(); it1++ ) {
+			
+			(it1->second).resetApplication();
+		}
+	}
+	
+	for ( its = pkt_sent.begin(); its != pkt_sent.end(); its++ ) {
+		
+		for ( its1 = (its->second).begin(); its1 != (its->second).end(); its1++ ) {
+			
+			trace_pkt_tx& tx = its1->second;
+			trace_link_info& info = (link_info[its->first])[tx.dst];
+			
+			info.pkt_generated_ += tx.count;
+			
+			// packets generated more than once are not considered for the generated bytes
+			if ( tx.count == 1 ) {
+				
+				info.bytes_generated_ += tx.size;
+			}
+		}
+	}
+	
+	for ( itr = pkt_recv.begin(); itr != pkt_recv.end(); itr++ ) {
+		
+		int dst = itr->first;
+		
+		for ( itr1 = (itr->second).begin(); itr1 != (itr->second).end(); itr1++ ) {
+			
+			int src = itr1->first;
+			trace_link_info& info = (link_info[src])[dst];
+			map <int, trace_pkt_tx>& sent = pkt_sent[src];
+			
+			for ( itr2 = (itr1->second).begin(); itr2 != (itr1->second).end(); itr2++ ) {
+				
+				trace_pkt_rx& rx = itr2->second;
+				map <int, trace_pkt_tx>::iterator itx = sent.find(itr2->first);
+				
+				info.pkt_delivered_++;
+				info.pkt_delivered_dup_ += rx.count - 1;
+				
+				info.hops_ += rx.hop;
+				info.hops_count_++;
+				info.routes_.insert(rx.hop);
+				
+				if ( info.max_hops_ < rx.hop ) {
+					
+					info.max_hops_ = rx.hop;
+				}
+				
+				if ( rx.dup_hop >= 0 ) {
+					
+					info.hops_dup_ += rx.dup_hop;
+					info.hops_dup_count_++;
+					info.routes_dup_.insert(rx.dup_hop);
+				}
+				
+				if ( itx == sent.end() ) {
+					
+					continue;
+				}
+				
+				info.bytes_delivered_ += (itx->second).size;
+				
+				if ( rx.first - (itx->second).first >= 0.0 ) {
+					
+					info.delay_ += rx.first - (itx->second).first;
+					info.delay_count_++;
+				}
+				
+				for ( itd = rx.dup.begin(); itd != rx.dup.end(); itd++ ) {
+					
+					if ( *itd - (itx->second).first >= 0.0 ) {
+						
+						info.delay_dup_ += *itd - (itx->second).first;
+						info.delay_dup_count_++;
+					}
+				}
+			}
+		}
+	}
+	
+	computed = true;
+}
+
+trace_link_info* Sunset_Trace_Metrics::findLinkInfo(int src, int dst) 
+{
+	map <int, map <int, trace_link_info> >::iterator it;
+	map <int, trace_link_info>::iterator it1;
+	
+	compute();
+	
+	it = link_info.find(src);
+	
+	if ( it == link_info.end() ) {
+		
+		return 0;
+	}
+	
+	it1 = (it->second).find(dst);
+	
+	if ( it1 == (it->second).end() ) {
+		
+		return 0;
+	}
+	
+	return &(it1->second);
+}
+
+/*!
+ * 	@brief The isReportedLink function returns true if the link is considered for the network metrics, as done by
+ *		the statistics module: the nodes up to max_node_id and optionally the broadcast address.
+ */
+
+bool Sunset_Trace_Metrics::isReportedLink(int src, int dst, bool broadcast) 
+{
+	if ( src < 0 || src > meta.max_node_id ) {
+		
+		return false;
+	}
+	
+	if ( dst >= 0 && dst <= meta.max_node_id ) {
+		
+		return dst != src;
+	}
+	
+	return broadcast && dst == meta.broadcast && (meta.broadcast > meta.max_node_id || meta.broadcast < 0);
+}
+
+double Sunset_Trace_Metrics::getExperimentTime() 
+{
+	if ( meta.stop_time == 0.0 && meta.start_time == 0.0 && meta.start_traffic == 0.0 ) {
+		
+		return -1;
+	}
+	
+	return meta.stop_time - meta.start_traffic;
+}
+
+int Sunset_Trace_Metrics::getGeneratedPacket(int src, int dst) 
+{
+	trace_link_info* info = findLinkInfo(src, dst);
+	
+	return (info == 0) ? 0 : info->pkt_generated_;
+}
+
+int Sunset_Trace_Metrics::getGeneratedBytes(int src, int dst) 
+{
+	trace_link_info* info = findLinkInfo(src, dst);
+	
+	return (info == 0) ? 0 : info->bytes_generated_;
+}
+
+int Sunset_Trace_Metrics::getDeliveredPacket(int src, int dst) 
+{
+	trace_link_info* info = findLinkInfo(src, dst);
+	
+	return (info == 0) ? 0 : info->pkt_delivered_;
+}
+
+int Sunset_Trace_Metrics::getDeliveredBytes(int src, int dst) 
+{
+	trace_link_info* info = findLinkInfo(src, dst);
+	
+	return (info == 0) ? 0 : info->bytes_delivered_;
+}
+
+int Sunset_Trace_Metrics::getDeliveredDuplicatedPacket(int src, int dst) 
+{
+	trace_link_info* info = findLinkInfo(src, dst);
+	
+	return (info == 0) ? 0 : info->pkt_delivered_dup_;
+}
+
+double Sunset_Trace_Metrics::getPacketLatency(int src, int dst) 
+{
+	trace_link_info* info = findLinkInfo(src, dst);
+	
+	return (info == 0 || info->delay_count_ == 0) ? 0.0 : info->delay_ / info->delay_count_;
+}
+
+double Sunset_Trace_Metrics::getDuplicatedPacketLatency(int src, int dst) 
+{
+	trace_link_info* info = findLinkInfo(src, dst);
+	
+	return (info == 0 || info->delay_dup_count_ == 0) ? 0.0 : info->delay_dup_ / info->delay_dup_count_;
+}
+
+double Sunset_Trace_Metrics::getRouteLength(int src, int dst) 
+{
+	trace_link_info* info = findLinkInfo(src, dst);
+	
+	return (info == 0 || info->hops_count_ == 0) ? 0.0 : info->hops_ / (double)info->hops_count_;
+}
+
+double Sunset_Trace_Metrics::getDuplicatedRouteLength(int src, int dst) 
+{
+	trace_link_info* info = findLinkInfo(src, dst);
+	
+	return (info == 0 || info->hops_dup_count_ == 0) ? 0.0 : info->hops_dup_ / (double)info->hops_dup_count_;
+}
+
+int Sunset_Trace_Metrics::getMaxRouteLength(int src, int dst) 
+{
+	trace_link_info* info = findLinkInfo(src, dst);
+	
+	return (info == 0) ? -1 : info->max_hops_;
+}
+
+int Sunset_Trace_Metrics::getNumRoutes(int src, int dst) 
+{
+	trace_link_info* info = findLinkInfo(src, dst);
+	
+	return (info == 0) ? 0 : (int)(info->routes_.size());
+}
+
+int Sunset_Trace_Metrics::getDuplicatedNumRoutes(int src, int dst) 
+{
+	trace_link_info* info = findLinkInfo(src, dst);
+	
+	return (info == 0) ? 0 : (int)(info->routes_dup_.size());
+}
+
+int Sunset_Trace_Metrics::getCreatedMacDataPacket(int src, int dst) 
+{
+	trace_link_info* info = findLinkInfo(src, dst);
+	
+	return (info == 0) ? 0 : info->mac_data_new_;
+}
+
+int Sunset_Trace_Metrics::getMacDataPacketTransmissions(int src, int dst) 
+{
+	trace_link_info* info = findLinkInfo(src, dst);
+	
+	return (info == 0) ? 0 : info->mac_data_tx_;
+}
+
+int Sunset_Trace_Metrics::getMacCtrlPacketTransmissions(int src, int dst) 
+{
+	trace_link_info* info = findLinkInfo(src, dst);
+	
+	return (info == 0) ? 0 : info->mac_ctrl_tx_;
+}
+
+int Sunset_Trace_Metrics::getMacDataBytesTransmissions(int src, int dst) 
+{
+	trace_link_info* info = findLinkInfo(src, dst);
+	
+	return (info == 0) ? 0 : macBytes(info->mac_data_tx_bytes_, info->mac_data_tx_);
+}
+
+int Sunset_Trace_Metrics::getMacCtrlBytesTransmissions(int src, int dst) 
+{
+	trace_link_info* info = findLinkInfo(src, dst);
+	
+	return (info == 0) ? 0 : macBytes(info->mac_ctrl_tx_bytes_, info->mac_ctrl_tx_);
+}
+
+int Sunset_Trace_Metrics::getMacDataBytesReceptions(int src, int dst) 
+{
+	trace_link_info* info = findLinkInfo(src, dst);
+	
+	return (info == 0) ? 0 : macBytes(info->mac_data_rx_bytes_, info->mac_data_rx_);
+}
+
+int Sunset_Trace_Metrics::getMacCtrlBytesReceptions(int src, int dst) 
+{
+	trace_link_info* info = findLinkInfo(src, dst);
+	
+	return (info == 0) ? 0 : macBytes(info->mac_ctrl_rx_bytes_, info->mac_ctrl_rx_);
+}
+
+double Sunset_Trace_Metrics::getGeneratedPacket() 
+{
+	int pkt = 0;
+	
+	compute();
+	
+	TRACE_LINK_LOOP(true) {
+		
+		pkt += (it1->second).pkt_generated_;
+	}
+	
+	return pkt;
+}
+
+double Sunset_Trace_Metrics::getDeliveredPacket() 
+{
+	int pkt = 0;
+	
+	compute();
+	
+	TRACE_LINK_LOOP(false) {
+		
+		pkt += (it1->second).pkt_delivered_;
+	}
+	
+	return pkt;
+}
+
+double Sunset_Trace_Metrics::getPDR() 
+{
+	int pkt_tx = (int)getGeneratedPacket();
+	int pkt_rx = (int)getDeliveredPacket();
+	
+	if ( pkt_tx > 0 ) {
+		
+		return (double)pkt_rx / (double)pkt_tx;
+	}
+	
+	return 0.0;
+}
+
+double Sunset_Trace_Metrics::getApplicationThroughput() 
+{
+	double time = getExperimentTime();
+	int pkt_rx = 0;
+	
+	if ( time <= 0 ) {
+		
+		return 0.0;
+	}
+	
+	compute();
+	
+	TRACE_LINK_LOOP(false) {
+		
+		pkt_rx += (it1->second).bytes_delivered_ * 8.0;
+	}
+	
+	return pkt_rx / time;
+}
+
+/* The network average of a link metric, only the links with a positive value are considered. */
+
+#define TRACE_LINK_AVERAGE(GETTER) \
+	double val = 0.0; \
+	double aux_val = 0.0; \
+	int count = 0; \
+	compute(); \
+	TRACE_LINK_LOOP(false) { \
+		aux_val = (double) GETTER(it->first, it1->first); \
+		if ( aux_val > 0.0 ) { \
+			val += aux_val; \
+			count++; \
+		} \
+	} \
+	return (count > 0) ? val / count : 0.0;
+
+double Sunset_Trace_Metrics::getPacketLatency() 
+{
+	TRACE_LINK_AVERAGE(getPacketLatency)
+}
+
+double Sunset_Trace_Metrics::getDuplicatedPacketLatency() 
+{
+	TRACE_LINK_AVERAGE(getDuplicatedPacketLatency)
+}
+
+double Sunset_Trace_Metrics::getRouteLength() 
+{
+	TRACE_LINK_AVERAGE(getRouteLength)
+}
+
+double Sunset_Trace_Metrics::getMaxRouteLength() 
+{
+	TRACE_LINK_AVERAGE(getMaxRouteLength)
+}
+
+double Sunset_Trace_Metrics::getNumRoutes() 
+{
+	TRACE_LINK_AVERAGE(getNumRoutes)
+}
+
+double Sunset_Trace_Metrics::getDuplicatedRouteLength() 
+{
+	TRACE_LINK_AVERAGE(getDuplicatedRouteLength)
+}
+
+double Sunset_Trace_Metrics::getMaxDuplicatedRouteLength() 
+{
+	// as computed by the statistics module
+	TRACE_LINK_AVERAGE(getDuplicatedRouteLength)
+}
+
+double Sunset_Trace_Metrics::getDuplicatedNumRoutes() 
+{
+	TRACE_LINK_AVERAGE(getDuplicatedNumRoutes)
+}
+
+double Sunset_Trace_Metrics::getMacLoad() 
+{
+	int pkt_tx = 0;
+	
+	TRACE_LINK_LOOP(true) {
+		
+		pkt_tx += (it1->second).mac_data_tx_ + (it1->second).mac_ctrl_tx_;
+	}
+	
+	return pkt_tx;
+}
+
+double Sunset_Trace_Metrics::getMacDataLoad() 
+{
+	int pkt_tx = 0;
+	
+	TRACE_LINK_LOOP(true) {
+		
+		pkt_tx += (it1->second).mac_data_tx_;
+	}
+	
+	return pkt_tx;
+}
+
+double Sunset_Trace_Metrics::getMacCtrlLoad() 
+{
+	int pkt_tx = 0;
+	
+	TRACE_LINK_LOOP(true) {
+		
+		pkt_tx += (it1->second).mac_ctrl_tx_;
+	}
+	
+	return pkt_tx;
+}
+
+double Sunset_Trace_Metrics::getMacThroughput() 
+{
+	double time = getExperimentTime();
+	int pkt_rx = 0;
+	
+	if ( time <= 0 ) {
+		
+		return 0.0;
+	}
+	
+	TRACE_LINK_LOOP(false) {
+		
+		pkt_rx += (getMacDataBytesReceptions(it->first, it1->first) + getMacCtrlBytesReceptions(it->first, it1->first)) * 8.0;
+	}
+	
+	return pkt_rx / time;
+}
+
+double Sunset_Trace_Metrics::getMacDataRetransmissions() 
+{
+	int pkt_tx = 0;
+	int pkt = 0;
+	
+	TRACE_LINK_LOOP(true) {
+		
+		pkt_tx += (it1->second).mac_data_tx_;
+		pkt += (it1->second).mac_data_new_;
+	}
+	
+	if ( pkt > 0 && pkt < pkt_tx ) {
+		
+		return (pkt_tx - pkt) / pkt;
+	}
+	
+	return 0.0;
+}
+
+double Sunset_Trace_Metrics::getOverheadPerBit() 
+{
+	int pkt_tx = 0;
+	int pkt_rx = 0;
+	
+	compute();
+	
+	TRACE_LINK_LOOP(true) {
+		
+		pkt_tx += (getMacDataBytesTransmissions(it->first, it1->first) + getMacCtrlBytesTransmissions(it->first, it1->first)) * 8;
+		
+		if ( isReportedLink(it->first, it1->first, false) ) {
+			
+			pkt_rx += (it1->second).bytes_delivered_ * 8;
+		}
+	}
+	
+	if ( pkt_rx > 0 && pkt_rx < pkt_tx ) {
+		
+		return (double)(pkt_tx - pkt_rx) / (double)pkt_rx;
+	}
+	
+	return 0.0;
+}
+
+int Sunset_Trace_Metrics::getMacDataPacketDiscarded() 
+{
+	int pkt = 0;
+	
+	TRACE_LINK_LOOP(true) {
+		
+		pkt += (it1->second).mac_data_discarded_;
+	}
+	
+	return pkt;
+}
+
+int Sunset_Trace_Metrics::getMacCtrlPacketDiscarded() 
+{
+	int pkt = 0;
+	
+	TRACE_LINK_LOOP(true) {
+		
+		pkt += (it1->second).mac_ctrl_discarded_;
+	}
+	
+	return pkt;
+}
+
+float Sunset_Trace_Metrics::getResidualEnergy(int id) 
+{
+	if ( consumed.find(id) == consumed.end() ) {
+		
+		return 0.0;
+	}
+	
+	return meta.total_energy - consumed[id];
+}
+
+float Sunset_Trace_Metrics::getResidualEnergy() 
+{
+	float energy = 0.0;
+	
+	for ( int id = 0; id <= meta.max_node_id; id++ ) {
+		
+		energy += getResidualEnergy(id);
+	}
+	
+	return energy;
+}
+
+/* The network sum of the time spent in the given state, weighted by the watt of each tx power when given. */
+
+static float sumTime(map <int, map <float, float> >& m, int max_node_id, map <float, float>* watt) 
+{
+	map <int, map <float, float> >::iterator it;
+	map <float, float>::iterator it1;
+	float tot = 0.0;
+	
+	for ( it = m.begin(); it != m.end(); it++ ) {
+		
+		if ( it->first < 0 || it->first > max_node_id ) {
+			
+			continue;
+		}
+		
+		for ( it1 = (it->second).begin(); it1 != (it->second).end(); it1++ ) {
+			
+			if ( watt != 0 ) {
+				
+				tot += it1->second * (*watt)[it1->first];
+			}
+			else {
+				
+				tot += it1->second;
+			}
+		}
+	}
+	
+	return tot;
+}
+
+/* The network sum of the energy consumed in the given state, the power is the key of the map. */
+
+static float sumConsumption(map <int, map <float, float> >& m, int max_node_id) 
+{
+	map <int, map <float, float> >::iterator it;
+	map <float, float>::iterator it1;
+	float tot = 0.0;
+	
+	for ( it = m.begin(); it != m.end(); it++ ) {
+		
+		if ( it->first < 0 || it->first > max_node_id ) {
+			
+			continue;
+		}
+		
+		for ( it1 = (it->second).begin(); it1 != (it->second).end(); it1++ ) {
+			
+			tot += it1->second * it1->first;
+		}
+	}
+	
+	return tot;
+}
+
+float Sunset_Trace_Metrics::getTotTxTime() 
+{
+	return sumTime(txTime, meta.max_node_id, 0);
+}
+
+float Sunset_Trace_Metrics::getRxTime() 
+{
+	return sumTime(rxTime, meta.max_node_id, 0);
+}
+
+float Sunset_Trace_Metrics::getIdleTime() 
+{
+	return sumTime(idleTime, meta.max_node_id, 0);
+}
+
+float Sunset_Trace_Metrics::getTotTxConsumption() 
+{
+	return sumTime(txTime, meta.max_node_id, &txPower);
+}
+
+float Sunset_Trace_Metrics::getRxConsumption() 
+{
+	return sumConsumption(rxTime, meta.max_node_id);
+}
+
+float Sunset_Trace_Metrics::getIdleConsumption() 
+{
+	return sumConsumption(idleTime, meta.max_node_id);
+}
@@ -0,0 +1,203 @@
+/* SUNSET - Sapienza University Networking framework for underwater Simulation, Emulation and real-life Testing
+ *
+ * Copyright (C) 2012 Regents of UWSN Group of SENSES Lab <http://reti.dsi.uniroma1.it/SENSES_lab/>
+ *
+ * Author: Roberto Petroccia - petroccia@di.uniroma1.it
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License as published
+ * at http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANATBILITY or FITNESS FOR A PARTICULAR PURPOSE. See the Creative Commons
+ * Attribution-NonCommercial-ShareAlike 3.0 Unported License for more details.
+ *
+ * You should have received a copy of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License
+ * along with this program. If not, see <http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode>.
+ */
+
+#ifndef __Sunset_Trace_Metrics_h__
+#define __Sunset_Trace_Metrics_h__
+
+#include <map>
+#include <set>
+#include <list>
+#include "sunset_trace_reader.h"
+
+using namespace std;
+
+/*! @brief The information stored for a packet generated at the application layer. */
+
+typedef struct trace_pkt_tx {
+	
+	int count;
+	int dst;
+	int size;
+	double first;	// first generation time
+	
+} trace_pkt_tx;
+
+/*! @brief The information stored for a packet received at the application layer. */
+
+typedef struct trace_pkt_rx {
+	
+	int count;
+	double first;		// first reception time
+	int hop;		// hops of the first reception
+	int dup_hop;		// hops of the first duplicated reception, -1 if none
+	list<double> dup;	// time of the duplicated receptions
+	
+} trace_pkt_rx;
+
+/*! @brief The information collected for a src-dst link. The application layer information is computed from the
+ *  packets once all the records have been added. The MAC sizes include the modem preamble which is removed when 
+ *  the metrics are computed, since the preamble size is known only at the end of the trace. */
+
+typedef struct trace_link_info {
+	
+	int pkt_generated_;
+	int bytes_generated_;
+	int pkt_delivered_;
+	int bytes_delivered_;
+	int pkt_delivered_dup_;
+	double hops_;
+	int hops_count_;
+	int max_hops_;
+	set<int> routes_;
+	double hops_dup_;
+	int hops_dup_count_;
+	set<int> routes_dup_;
+	double delay_;
+	int delay_count_;
+	double delay_dup_;
+	int delay_dup_count_;
+	
+	int mac_data_new_;
+	double mac_data_new_bytes_;
+	int mac_data_tx_;
+	double mac_data_tx_bytes_;
+	int mac_data_rx_;
+	double mac_data_rx_bytes_;
+	int mac_data_discarded_;
+	int mac_ctrl_tx_;
+	double mac_ctrl_tx_bytes_;
+	int mac_ctrl_rx_;
+	double mac_ctrl_rx_bytes_;
+	int mac_ctrl_discarded_;
+	
+	trace_link_info() : mac_data_new_(0), mac_data_new_bytes_(0), mac_data_tx_(0), mac_data_tx_bytes_(0), 
+		mac_data_rx_(0), mac_data_rx_bytes_(0), mac_data_discarded_(0), mac_ctrl_tx_(0), mac_ctrl_tx_bytes_(0), 
+		mac_ctrl_rx_(0), mac_ctrl_rx_bytes_(0), mac_ctrl_discarded_(0) { resetApplication(); }
+	
+	void resetApplication() 
+	{
+		pkt_generated_ = bytes_generated_ = pkt_delivered_ = bytes_delivered_ = pkt_delivered_dup_ = 0;
+		hops_ = hops_dup_ = delay_ = delay_dup_ = 0.0;
+		hops_count_ = hops_dup_count_ = delay_count_ = delay_dup_count_ = 0;
+		max_hops_ = -1;
+		routes_.clear();
+		routes_dup_.clear();
+	}
+	
+} trace_link_info;
+
+/*! @brief This class recomputes from a SUNSET binary trace the metrics provided by the Sunset_Protocol_Statistics 
+ *  module: packet delivery ratio, throughput, latency, route length, MAC load, overhead and energy consumption.
+ *  The records of several traces (e.g. one per node in emulation) can be added before computing the metrics.
+ */
+
+class Sunset_Trace_Metrics {
+	
+public:
+	
+	Sunset_Trace_Metrics();
+	
+	void setMeta(const sunset_trace_meta& m) { meta = m; }
+	const sunset_trace_meta& getMeta() { return meta; }
+	
+	void add(const sunset_trace_chunk& c);
+	void addRecord(const sunset_trace_record& r, const double* energy);
+	
+	double getExperimentTime();
+	
+	/* application layer, src-dst link */
+	int getGeneratedPacket(int src, int dst);
+	int getGeneratedBytes(int src, int dst);
+	int getDeliveredPacket(int src, int dst);
+	int getDeliveredBytes(int src, int dst);
+	int getDeliveredDuplicatedPacket(int src, int dst);
+	double getPacketLatency(int src, int dst);
+	double getDuplicatedPacketLatency(int src, int dst);
+	double getRouteLength(int src, int dst);
+	double getDuplicatedRouteLength(int src, int dst);
+	int getMaxRouteLength(int src, int dst);
+	int getNumRoutes(int src, int dst);
+	int getDuplicatedNumRoutes(int src, int dst);
+	
+	/* MAC layer, src-dst link */
+	int getCreatedMacDataPacket(int src, int dst);
+	int getMacDataPacketTransmissions(int src, int dst);
+	int getMacCtrlPacketTransmissions(int src, int dst);
+	int getMacDataBytesTransmissions(int src, int dst);
+	int getMacCtrlBytesTransmissions(int src, int dst);
+	int getMacDataBytesReceptions(int src, int dst);
+	int getMacCtrlBytesReceptions(int src, int dst);
+	
+	/* network */
+	double getGeneratedPacket();
+	double getDeliveredPacket();
+	double getPDR();
+	double getApplicationThroughput();
+	double getPacketLatency();
+	double getDuplicatedPacketLatency();
+	double getRouteLength();
+	double getMaxRouteLength();
+	double getNumRoutes();
+	double getDuplicatedRouteLength();
+	double getMaxDuplicatedRouteLength();
+	double getDuplicatedNumRoutes();
+	double getMacLoad();
+	double getMacDataLoad();
+	double getMacCtrlLoad();
+	double getMacThroughput();
+	double getMacDataRetransmissions();
+	double getOverheadPerBit();
+	int getMacDataPacketDiscarded();
+	int getMacCtrlPacketDiscarded();
+	
+	/* energy */
+	float getResidualEnergy();
+	float getResidualEnergy(int id);
+	float getTotTxTime();
+	float getRxTime();
+	float getIdleTime();
+	float getTotTxConsumption();
+	float getRxConsumption();
+	float getIdleConsumption();
+	
+private:
+	
+	sunset_trace_meta meta;
+	
+	map <int, map <int, trace_pkt_tx> > pkt_sent;			// src - pkt_id
+	map <int, map <int, map <int, trace_pkt_rx> > > pkt_recv;	// dst - src - pkt_id
+	map <int, map <int, trace_link_info> > link_info;		// src - dst
+	
+	map <int, map <float, float> > txTime;		// node - tx power - time
+	map <int, map <float, float> > rxTime;		// node - rx power - time
+	map <int, map <float, float> > idleTime;	// node - idle power - time
+	map <float, float> txPower;			// tx power - watt
+	map <int, double> consumed;			// node - consumed energy
+	
+	bool computed;	// false if records have been added after the last compute()
+	
+	void compute();	// compute the application layer information of the links
+	
+	bool isReportedLink(int src, int dst, bool broadcast);
+	trace_link_info* findLinkInfo(int src, int dst);
+	
+	int macBytes(double bytes, int count) { return (int)(bytes - (double)count * meta.preamble_size); }
+};
+
+#endif
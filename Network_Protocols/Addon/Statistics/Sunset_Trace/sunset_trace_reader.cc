@@ -0,0 +1,521 @@
+/* SUNSET - Sapienza University Networking framework for underwater Simulation, Emulation and real-life Testing
+ *
+ * Copyright (C) 2012 Regents of UWSN Group of SENSES Lab <http://reti.dsi.uniroma1.it/SENSES_lab/>
+ *
+ * Author: Roberto Petroccia - petroccia@di.uniroma1.it
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License as published
+ * at http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANATBILITY or FITNESS FOR A PARTICULAR PURPOSE. See the Creative Commons
+ * Attribution-NonCommercial-ShareAlike 3.0 Unported License for more details.
+ *
+ * You should have received a copy of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License
+ * along with this program. If not, see <http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode>.
+ */
+
+#include "sunset_trace_reader.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/*!
+ * 	@brief The getRecord function returns the i-th record of the chunk.
+ */
+
+void sunset_trace_chunk::getRecord(int i, sunset_trace_record& r) const 
+{
+	r.stat_type = statType[i];
+	r.pkt_type = pktType[i];
+	r.real_time = realTime[i];
+	r.time = time[i];
+	r.node = node[i];
+	r.src = src[i];
+	r.dst = dst[i];
+	r.agt_src = agtSrc[i];
+	r.agt_dst = agtDst[i];
+	r.agt_pkt_id = agtPktId[i];
+	r.pkt_size = pktSize[i];
+	r.num_hop = numHop[i];
+	r.rssi = rssi[i];
+	r.link_quality = linkQuality[i];
+}
+
+Sunset_Trace_Reader::Sunset_Trace_Reader() 
+{
+	data = 0;
+	size = 0;
+	pos = 0;
+	fd = -1;
+	version = 0;
+	timeScale = SUNSET_TRACE_TIME_SCALE;
+	hasMeta_ = false;
+	memset(&meta, 0, sizeof(sunset_trace_meta));
+}
+
+Sunset_Trace_Reader::~Sunset_Trace_Reader() 
+{
+	close();
+}
+
+/*!
+ * 	@brief The open function maps the trace file in memory and checks the file header.
+ *	@param path The trace file.
+ *	@retval true If the file is a valid trace, false otherwise (getError() describes the problem).
+ */
+
+bool Sunset_Trace_Reader::open(const char* path) 
+{
+	struct stat st;
+	void* addr = 0;
+	
+	close();
+	
+	fd = ::open(path, O_RDONLY);
+	
+	if ( fd < 0 ) {
+		
+		error = string("cannot open ") + path;
+		
+		return false;
+	}
+	
+	if ( fstat(fd, &st) != 0 || st.st_size < SUNSET_TRACE_FILE_HEADER_SIZE ) {
+		
+		error = string("invalid trace file ") + path;
+		close();
+		
+		return false;
+	}
+	
+	size = st.st_size;
+	addr = mmap(0, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	
+	if ( addr == MAP_FAILED ) {
+		
+		error = string("cannot map ") + path;
+		size = 0;
+		close();
+		
+		return false;
+	}
+	
+	data = (const char*)addr;
+	
+	madvise(addr, size, MADV_SEQUENTIAL);
+	
+	if ( memcmp(data, SUNSET_TRACE_MAGIC, 4) != 0 ) {
+		
+		error = string("not a SUNSET binary trace ") + path;
+		close();
+		
+		return false;
+	}
+	
+	version = Sunset_Trace_Codec::getU16(data + 4);
+	
+	if ( version > SUNSET_TRACE_VERSION ) {
+		
+		error = string("unsupported trace version in ") + path;
+		close();
+		
+		return false;
+	}
+	
+	pos = Sunset_Trace_Codec::getU16(data + 6);
+	timeScale = Sunset_Trace_Codec::getU32(data + 8);
+	
+	if ( timeScale == 0 || pos > size ) {
+		
+		error = string("invalid trace header in ") + path;
+		close();
+		
+		return false;
+	}
+	
+	return true;
+}
+
+void Sunset_Trace_Reader::close() 
+{
+	if ( data != 0 ) {
+		
+		munmap((void*)data, size);
+	}
+	
+	if ( fd >= 0 ) {
+		
+		::close(fd);
+	}
+	
+	data = 0;
+	size = 0;
+	pos = 0;
+	fd = -1;
+}
+
+/*!
+ * 	@brief The nextChunk function decodes the next record chunk of the file. The meta chunks are processed internally.
+ *	@param c The chunk where the records are decoded, its buffers are reused.
+ *	@retval true If a chunk has been decoded, false at the end of the file. A truncated last chunk (e.g. the 
+ *		experiment has not been correctly stopped) is ignored.
+ */
+
+bool Sunset_Trace_Reader::nextChunk(sunset_trace_chunk& c) 
+{
+	while ( data != 0 && pos + SUNSET_TRACE_CHUNK_HEADER_SIZE <= size ) {
+		
+		const char* hdr = data + pos;
+		uint32_t type = Sunset_Trace_Codec::getU32(hdr + 4);
+		uint32_t num = Sunset_Trace_Codec::getU32(hdr + 8);
+		uint32_t payloadSize = Sunset_Trace_Codec::getU32(hdr + 12);
+		uint32_t numColumns = Sunset_Trace_Codec::getU32(hdr + 16);
+		size_t len = SUNSET_TRACE_CHUNK_HEADER_SIZE + (size_t)numColumns * SUNSET_TRACE_COLUMN_ENTRY_SIZE + payloadSize;
+		
+		if ( memcmp(hdr, SUNSET_TRACE_CHUNK_MAGIC, 4) != 0 ) {
+			
+			error = "corrupted chunk header";
+			
+			return false;
+		}
+		
+		if ( pos + len > size ) {
+			
+			error = "truncated chunk";
+			
+			return false;
+		}
+		
+		pos += len;
+		
+		if ( type == SUNSET_TRACE_CHUNK_META_TYPE ) {
+			
+			decodeMeta(hdr + SUNSET_TRACE_CHUNK_HEADER_SIZE + numColumns * SUNSET_TRACE_COLUMN_ENTRY_SIZE, payloadSize, num);
+			
+			continue;
+		}
+		
+		if ( type != SUNSET_TRACE_CHUNK_RECORDS_TYPE ) {
+			
+			continue;	// unknown chunk type
+		}
+		
+		if ( !decodeRecords(hdr, hdr + SUNSET_TRACE_CHUNK_HEADER_SIZE + numColumns * SUNSET_TRACE_COLUMN_ENTRY_SIZE, payloadSize, c) ) {
+			
+			error = "corrupted record chunk";
+			
+			return false;
+		}
+		
+		return true;
+	}
+	
+	return false;
+}
+
+bool Sunset_Trace_Reader::decodeDelta(const char* p, const char* end, int n, vector<int>& v) 
+{
+	int64_t prev = 0;
+	uint64_t x = 0;
+	int k = 0;
+	
+	v.resize(n);
+	
+	for ( int i = 0; i < n; i++ ) {
+		
+		if ( (k = Sunset_Trace_Codec::getVarint(p, end, &x)) == 0 ) {
+			
+			return false;
+		}
+		
+		p += k;
+		prev += Sunset_Trace_Codec::unzigzag(x);
+		v[i] = (int)prev;
+	}
+	
+	return true;
+}
+
+bool Sunset_Trace_Reader::decodeDelta(const char* p, const char* end, int n, vector<double>& v) 
+{
+	int64_t prev = 0;
+	uint64_t x = 0;
+	int k = 0;
+	
+	v.resize(n);
+	
+	for ( int i = 0; i < n; i++ ) {
+		
+		if ( (k = Sunset_Trace_Codec::getVarint(p, end, &x)) == 0 ) {
+			
+			return false;
+		}
+		
+		p += k;
+		prev += Sunset_Trace_Codec::unzigzag(x);
+		v[i] = Sunset_Trace_Codec::fromTicks(prev, timeScale);
+	}
+	
+	return true;
+}
+
+bool Sunset_Trace_Reader::decodeVarint(const char* p, const char* end, int n, vector<int>& v) 
+{
+	uint64_t x = 0;
+	int k = 0;
+	
+	v.resize(n);
+	
+	for ( int i = 0; i < n; i++ ) {
+		
+		if ( (k = Sunset_Trace_Codec::getVarint(p, end, &x)) == 0 ) {
+			
+			return false;
+		}
+		
+		p += k;
+		v[i] = (int)x;
+	}
+	
+	return true;
+}
+
+/*!
+ * 	@brief The decodeRecords function decodes the columns of a record chunk. Missing columns are filled with zeros.
+ */
+
+bool Sunset_Trace_Reader::decodeRecords(const char* hdr, const char* payload, uint32_t payloadSize, sunset_trace_chunk& c) 
+{
+	uint32_t numColumns = Sunset_Trace_Codec::getU32(hdr + 16);
+	int n = (int)Sunset_Trace_Codec::getU32(hdr + 8);
+	const char* dir = hdr + SUNSET_TRACE_CHUNK_HEADER_SIZE;
+	int energyCount = 0;
+	int offset = 0;
+	
+	c.numRecords = n;
+	c.info = payload;
+	
+	c.statType.assign(n, 0);
+	c.pktType.assign(n, 0);
+	c.realTime.assign(n, 0.0);
+	c.time.assign(n, 0.0);
+	c.node.assign(n, 0);
+	c.src.assign(n, 0);
+	c.dst.assign(n, 0);
+	c.agtSrc.assign(n, 0);
+	c.agtDst.assign(n, 0);
+	c.agtPktId.assign(n, 0);
+	c.pktSize.assign(n, 0);
+	c.numHop.assign(n, 0);
+	c.rssi.assign(n, 0.0);
+	c.linkQuality.assign(n, 0.0);
+	c.infoOffset.assign(n, 0);
+	c.infoLen.assign(n, 0);
+	c.energyOffset.assign(n, -1);
+	c.energy.clear();
+	
+	for ( uint32_t i = 0; i < numColumns; i++, dir += SUNSET_TRACE_COLUMN_ENTRY_SIZE ) {
+		
+		uint32_t id = Sunset_Trace_Codec::getU32(dir);
+		uint32_t off = Sunset_Trace_Codec::getU32(dir + 4);
+		uint32_t len = Sunset_Trace_Codec::getU32(dir + 8);
+		const char* p = payload + off;
+		const char* end = p + len;
+		bool ok = true;
+		
+		if ( (uint64_t)off + len > payloadSize ) {
+			
+			return false;
+		}
+		
+		switch ( id ) {
+			
+			case SUNSET_TRACE_COL_STAT_TYPE:
+			case SUNSET_TRACE_COL_PKT_TYPE:
+			{
+				vector<int>& v = (id == SUNSET_TRACE_COL_STAT_TYPE) ? c.statType : c.pktType;
+				
+				if ( (int)len < n ) {
+					
+					return false;
+				}
+				
+				for ( int k = 0; k < n; k++ ) {
+					
+					v[k] = (signed char)p[k];
+				}
+				
+				break;
+			}
+			
+			case SUNSET_TRACE_COL_REAL_TIME:
+				ok = decodeDelta(p, end, n, c.realTime);
+				break;
+			
+			case SUNSET_TRACE_COL_TIME:
+				ok = decodeDelta(p, end, n, c.time);
+				break;
+			
+			case SUNSET_TRACE_COL_NODE:
+				ok = decodeDelta(p, end, n, c.node);
+				break;
+			
+			case SUNSET_TRACE_COL_SRC:
+				ok = decodeDelta(p, end, n, c.src);
+				break;
+			
+			case SUNSET_TRACE_COL_DST:
+				ok = decodeDelta(p, end, n, c.dst);
+				break;
+			
+			case SUNSET_TRACE_COL_AGT_SRC:
+				ok = decodeDelta(p, end, n, c.agtSrc);
+				break;
+			
+			case SUNSET_TRACE_COL_AGT_DST:
+				ok = decodeDelta(p, end, n, c.agtDst);
+				break;
+			
+			case SUNSET_TRACE_COL_AGT_PKT_ID:
+				ok = decodeDelta(p, end, n, c.agtPktId);
+				break;
+			
+			case SUNSET_TRACE_COL_PKT_SIZE:
+				ok = decodeVarint(p, end, n, c.pktSize);
+				break;
+			
+			case SUNSET_TRACE_COL_NUM_HOP:
+				ok = decodeVarint(p, end, n, c.numHop);
+				break;
+			
+			case SUNSET_TRACE_COL_RSSI:
+			case SUNSET_TRACE_COL_LINK_QUALITY:
+			{
+				vector<double>& v = (id == SUNSET_TRACE_COL_RSSI) ? c.rssi : c.linkQuality;
+				
+				if ( (int)len < n * 8 ) {
+					
+					return false;
+				}
+				
+				for ( int k = 0; k < n; k++ ) {
+					
+					v[k] = Sunset_Trace_Codec::getF64(p + 8 * k);
+				}
+				
+				break;
+			}
+			
+			case SUNSET_TRACE_COL_INFO_LEN:
+				ok = decodeVarint(p, end, n, c.infoLen);
+				break;
+			
+			case SUNSET_TRACE_COL_INFO:
+				c.info = p;
+				break;
+			
+			case SUNSET_TRACE_COL_ENERGY:
+				energyCount = len / 8;
+				c.energy.resize(energyCount);
+				
+				for ( int k = 0; k < energyCount; k++ ) {
+					
+					c.energy[k] = Sunset_Trace_Codec::getF64(p + 8 * k);
+				}
+				
+				break;
+			
+			default:
+				break;	// unknown column
+		}
+		
+		if ( !ok ) {
+			
+			return false;
+		}
+	}
+	
+	for ( int k = 0; k < n; k++ ) {
+		
+		c.infoOffset[k] = offset;
+		offset += c.infoLen[k];
+	}
+	
+	offset = 0;
+	
+	for ( int k = 0; k < n; k++ ) {
+		
+		if ( c.statType[k] < SUNSET_TRACE_STAT_ENERGY_TX || c.statType[k] > SUNSET_TRACE_STAT_ENERGY_IDLE ) {
+			
+			continue;
+		}
+		
+		if ( offset + SUNSET_TRACE_ENERGY_VALUES > energyCount ) {
+			
+			return false;
+		}
+		
+		c.energyOffset[k] = offset;
+		offset += SUNSET_TRACE_ENERGY_VALUES;
+	}
+	
+	return true;
+}
+
+/*!
+ * 	@brief The decodeMeta function reads the experiment information, unknown keys are ignored.
+ */
+
+void Sunset_Trace_Reader::decodeMeta(const char* payload, uint32_t payloadSize, uint32_t num) 
+{
+	for ( uint32_t i = 0; i < num && (i + 1) * SUNSET_TRACE_META_ENTRY_SIZE <= payloadSize; i++ ) {
+		
+		const char* p = payload + i * SUNSET_TRACE_META_ENTRY_SIZE;
+		double v = Sunset_Trace_Codec::getF64(p + 8);
+		
+		switch ( Sunset_Trace_Codec::getU32(p) ) {
+			
+			case SUNSET_TRACE_META_START_TIME:
+				meta.start_time = v;
+				break;
+			
+			case SUNSET_TRACE_META_STOP_TIME:
+				meta.stop_time = v;
+				break;
+			
+			case SUNSET_TRACE_META_START_TRAFFIC:
+				meta.start_traffic = v;
+				break;
+			
+			case SUNSET_TRACE_META_PREAMBLE_SIZE:
+				meta.preamble_size = (int)v;
+				break;
+			
+			case SUNSET_TRACE_META_MAX_NODE_ID:
+				meta.max_node_id = (int)v;
+				break;
+			
+			case SUNSET_TRACE_META_BROADCAST:
+				meta.broadcast = (int)v;
+				break;
+			
+			case SUNSET_TRACE_META_TOTAL_ENERGY:
+				meta.total_energy = v;
+				break;
+			
+			case SUNSET_TRACE_META_RUN_ID:
+				meta.run_id = (int)v;
+				break;
+			
+			default:
+				break;
+		}
+	}
+	
+	hasMeta_ = true;
+}
@@ -0,0 +1,106 @@
+/* SUNSET - Sapienza University Networking framework for underwater Simulation, Emulation and real-life Testing
+ *
+ * Copyright (C) 2012 Regents of UWSN Group of SENSES Lab <http://reti.dsi.uniroma1.it/SENSES_lab/>
+ *
+ * Author: Roberto Petroccia - petroccia@di.uniroma1.it
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License as published
+ * at http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANATBILITY or FITNESS FOR A PARTICULAR PURPOSE. See the Creative Commons
+ * Attribution-NonCommercial-ShareAlike 3.0 Unported License for more details.
+ *
+ * You should have received a copy of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License
+ * along with this program. If not, see <http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode>.
+ */
+
+#ifndef __Sunset_Trace_Reader_h__
+#define __Sunset_Trace_Reader_h__
+
+#include <vector>
+#include <string>
+#include "sunset_trace_format.h"
+
+using namespace std;
+
+/*! @brief The records of a chunk decoded in columns. The additional text of record i is info[infoOffset[i]] 
+ *  (infoLen[i] bytes, not NUL terminated), the energy values of record i are energy[energyOffset[i]] 
+ *  (SUNSET_TRACE_ENERGY_VALUES values) if energyOffset[i] >= 0. */
+
+typedef struct sunset_trace_chunk {
+	
+	int numRecords;
+	vector<int> statType;
+	vector<int> pktType;
+	vector<double> realTime;
+	vector<double> time;
+	vector<int> node;
+	vector<int> src;
+	vector<int> dst;
+	vector<int> agtSrc;
+	vector<int> agtDst;
+	vector<int> agtPktId;
+	vector<int> pktSize;
+	vector<int> numHop;
+	vector<double> rssi;
+	vector<double> linkQuality;
+	vector<int> infoOffset;
+	vector<int> infoLen;
+	const char* info;		// points to the mapped file
+	vector<int> energyOffset;
+	vector<double> energy;
+	
+	void getRecord(int i, sunset_trace_record& r) const;
+	
+} sunset_trace_chunk;
+
+/*! @brief This class reads a SUNSET binary trace. The file is mapped in memory and processed one chunk at a time,
+ *  the memory used does not depend on the file size.
+ *  @see sunset_trace_format.h
+ */
+
+class Sunset_Trace_Reader {
+	
+public:
+	
+	Sunset_Trace_Reader();
+	~Sunset_Trace_Reader();
+	
+	bool open(const char* path);	// map the file and check the header
+	void close();
+	
+	bool nextChunk(sunset_trace_chunk& c);	// decode the next record chunk, false at the end of the file or on error
+	
+	bool hasMeta() { return hasMeta_; }
+	const sunset_trace_meta& getMeta() { return meta; }	// valid once the meta chunk has been read
+	
+	int getVersion() { return version; }
+	const string& getError() { return error; }
+	
+private:
+	
+	bool decodeRecords(const char* hdr, const char* payload, uint32_t payloadSize, sunset_trace_chunk& c);
+	void decodeMeta(const char* payload, uint32_t payloadSize, uint32_t num);
+	
+	bool decodeDelta(const char* p, const char* end, int n, vector<int>& v);
+	bool decodeDelta(const char* p, const char* end, int n, vector<double>& v);
+	bool decodeVarint(const char* p, const char* end, int n, vector<int>& v);
+	
+	const char* data;
+	size_t size;
+	size_t pos;
+	int fd;
+	
+	int version;
+	uint32_t timeScale;
+	
+	bool hasMeta_;
+	sunset_trace_meta meta;
+	
+	string error;
+};
+
+#endif
@@ -0,0 +1,222 @@
+/* SUNSET - Sapienza University Networking framework for underwater Simulation, Emulation and real-life Testing
+ *
+ * Copyright (C) 2012 Regents of UWSN Group of SENSES Lab <http://reti.dsi.uniroma1.it/SENSES_lab/>
+ *
+ * Author: Roberto Petroccia - petroccia@di.uniroma1.it
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License as published
+ * at http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANATBILITY or FITNESS FOR A PARTICULAR PURPOSE. See the Creative Commons
+ * Attribution-NonCommercial-ShareAlike 3.0 Unported License for more details.
+ *
+ * You should have received a copy of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License
+ * along with this program. If not, see <http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode>.
+ */
+
+/*
+ * sunset_trace_stats reads one or more SUNSET binary traces and prints the metrics computed by the 
+ * Sunset_Protocol_Statistics module. The meta information stored at the end of the trace can be overridden 
+ * from the command line, e.g. when a trace has been truncated.
+ *
+ * Usage: sunset_trace_stats [-l] [-m max_node_id] [-p preamble] [-t start_traffic] [-s stop_time] 
+ *		[-e total_energy] [-b broadcast] trace [trace ...]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "sunset_trace_metrics.h"
+
+static void usage(const char* name) 
+{
+	fprintf(stderr, "Usage: %s [-l] [-m max_node_id] [-p preamble] [-t start_traffic] [-s stop_time] [-e total_energy] [-b broadcast] trace [trace ...]\n", name);
+	fprintf(stderr, "  -l  print a single line in the format of the statistics module output file\n");
+}
+
+int main(int argc, char** argv) 
+{
+	Sunset_Trace_Metrics metrics;
+	Sunset_Trace_Reader reader;
+	sunset_trace_chunk chunk;
+	sunset_trace_meta meta;
+	bool hasMeta = false;
+	bool line = false;
+	int maxNodeId = -1;
+	int preamble = -1;
+	int broadcast = -1;
+	bool setBroadcast = false;
+	double startTraffic = -1.0;
+	double stopTime = -1.0;
+	double totalEnergy = -1.0;
+	long records = 0;
+	int opt = 0;
+	
+	memset(&meta, 0, sizeof(sunset_trace_meta));
+	meta.broadcast = -1;
+	
+	while ( (opt = getopt(argc, argv, "lm:p:t:s:e:b:h")) != -1 ) {
+		
+		switch ( opt ) {
+			
+			case 'l':
+				line = true;
+				break;
+				
+			case 'm':
+				maxNodeId = atoi(optarg);
+				break;
+				
+			case 'p':
+				preamble = atoi(optarg);
+				break;
+				
+			case 't':
+				startTraffic = atof(optarg);
+				break;
+				
+			case 's':
+				stopTime = atof(optarg);
+				break;
+				
+			case 'e':
+				totalEnergy = atof(optarg);
+				break;
+				
+			case 'b':
+				broadcast = atoi(optarg);
+				setBroadcast = true;
+				break;
+				
+			default:
+				usage(argv[0]);
+				return 1;
+		}
+	}
+	
+	if ( optind >= argc ) {
+		
+		usage(argv[0]);
+		
+		return 1;
+	}
+	
+	for ( int i = optind; i < argc; i++ ) {
+		
+		if ( !reader.open(argv[i]) ) {
+			
+			fprintf(stderr, "%s: %s\n", argv[i], reader.getError().c_str());
+			
+			return 1;
+		}
+		
+		while ( reader.nextChunk(chunk) ) {
+			
+			metrics.add(chunk);
+			records += chunk.numRecords;
+		}
+		
+		if ( reader.getError() != "" ) {
+			
+			fprintf(stderr, "%s: %s\n", argv[i], reader.getError().c_str());
+		}
+		
+		if ( reader.hasMeta() ) {
+			
+			meta = reader.getMeta();
+			hasMeta = true;
+		}
+		else {
+			
+			fprintf(stderr, "%s: meta information not found\n", argv[i]);
+		}
+		
+		reader.close();
+	}
+	
+	if ( maxNodeId >= 0 ) {
+		
+		meta.max_node_id = maxNodeId;
+	}
+	
+	if ( preamble >= 0 ) {
+		
+		meta.preamble_size = preamble;
+	}
+	
+	if ( startTraffic >= 0.0 ) {
+		
+		meta.start_traffic = startTraffic;
+	}
+	
+	if ( stopTime >= 0.0 ) {
+		
+		meta.stop_time = stopTime;
+	}
+	
+	if ( totalEnergy >= 0.0 ) {
+		
+		meta.total_energy = totalEnergy;
+	}
+	
+	if ( setBroadcast ) {
+		
+		meta.broadcast = broadcast;
+	}
+	
+	if ( !hasMeta && maxNodeId < 0 ) {
+		
+		fprintf(stderr, "max node id unknown, use -m\n");
+		
+		return 1;
+	}
+	
+	metrics.setMeta(meta);
+	
+	if ( line ) {
+		
+		printf("%d %f %f %f %f %f %f %f %f %f %f %f %f %f %f %f %f %f %f %f\n", 
+			meta.run_id, meta.stop_time - meta.start_traffic, meta.stop_time - meta.start_time, 
+			metrics.getGeneratedPacket(), metrics.getDeliveredPacket(), metrics.getPDR(), 
+			metrics.getApplicationThroughput(), metrics.getPacketLatency(), metrics.getRouteLength(), 
+			metrics.getMaxRouteLength(), metrics.getNumRoutes(), metrics.getDuplicatedRouteLength(), 
+			metrics.getMaxDuplicatedRouteLength(), metrics.getDuplicatedNumRoutes(), metrics.getMacLoad(), 
+			metrics.getMacDataLoad(), metrics.getMacCtrlLoad(), metrics.getOverheadPerBit(), 
+			metrics.getMacThroughput(), metrics.getMacDataRetransmissions());
+		
+		return 0;
+	}
+	
+	printf("records               %ld\n", records);
+	printf("run_id                %d\n", meta.run_id);
+	printf("experiment_time       %f\n", metrics.getExperimentTime());
+	printf("generated_packets     %f\n", metrics.getGeneratedPacket());
+	printf("delivered_packets     %f\n", metrics.getDeliveredPacket());
+	printf("pdr                   %f\n", metrics.getPDR());
+	printf("throughput            %f\n", metrics.getApplicationThroughput());
+	printf("latency               %f\n", metrics.getPacketLatency());
+	printf("duplicated_latency    %f\n", metrics.getDuplicatedPacketLatency());
+	printf("route_length          %f\n", metrics.getRouteLength());
+	printf("max_route_length      %f\n", metrics.getMaxRouteLength());
+	printf("num_routes            %f\n", metrics.getNumRoutes());
+	printf("mac_load              %f\n", metrics.getMacLoad());
+	printf("mac_data_load         %f\n", metrics.getMacDataLoad());
+	printf("mac_ctrl_load         %f\n", metrics.getMacCtrlLoad());
+	printf("mac_throughput        %f\n", metrics.getMacThroughput());
+	printf("mac_retransmissions   %f\n", metrics.getMacDataRetransmissions());
+	printf("mac_data_discarded    %d\n", metrics.getMacDataPacketDiscarded());
+	printf("mac_ctrl_discarded    %d\n", metrics.getMacCtrlPacketDiscarded());
+	printf("overhead_per_bit      %f\n", metrics.getOverheadPerBit());
+	printf("tx_time               %f\n", metrics.getTotTxTime());
+	printf("rx_time               %f\n", metrics.getRxTime());
+	printf("idle_time             %f\n", metrics.getIdleTime());
+	printf("tx_energy             %f\n", metrics.getTotTxConsumption());
+	printf("rx_energy             %f\n", metrics.getRxConsumption());
+	printf("idle_energy           %f\n", metrics.getIdleConsumption());
+	printf("residual_energy       %f\n", metrics.getResidualEnergy());
+	
+	return 0;
+}
@@ -0,0 +1,208 @@
+/* SUNSET - Sapienza University Networking framework for underwater Simulation, Emulation and real-life Testing
+ *
+ * Copyright (C) 2012 Regents of UWSN Group of SENSES Lab <http://reti.dsi.uniroma1.it/SENSES_lab/>
+ *
+ * Author: Roberto Petroccia - petroccia@di.uniroma1.it
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License as published
+ * at http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANATBILITY or FITNESS FOR A PARTICULAR PURPOSE. See the Creative Commons
+ * Attribution-NonCommercial-ShareAlike 3.0 Unported License for more details.
+ *
+ * You should have received a copy of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License
+ * along with this program. If not, see <http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode>.
+ */
+
+#include <sunset_agent_payload.h>
+#include <sunset_debug.h>
+
+vector<sunset_payload_block*> Sunset_Agent_Payload::freeBlocks[SUNSET_PAYLOAD_CLASSES];
+volatile int Sunset_Agent_Payload::lock_ = 0;
+long Sunset_Agent_Payload::allocated = 0;
+long Sunset_Agent_Payload::reused = 0;
+long Sunset_Agent_Payload::shared = 0;
+
+/*!
+ * 	@brief The getSizeClass function returns the smallest size class able to store size bytes, -1 if size is larger than the largest class.
+ */
+
+int Sunset_Agent_Payload::getSizeClass(int size) 
+{
+	int c = 0;
+	int capacity = SUNSET_PAYLOAD_MIN_SIZE;
+	
+	while ( capacity < size ) {
+		
+		capacity = capacity << 1;
+		c++;
+	}
+	
+	if ( c >= SUNSET_PAYLOAD_CLASSES ) {
+		
+		return -1;
+	}
+	
+	return c;
+}
+
+/*!
+ * 	@brief The alloc function returns a zeroed payload of len + 1 bytes referenced once. A free buffer of the corresponding size class 
+ *	is reused if available, otherwise a new one is allocated.
+ *	@param len The length of the payload.
+ *	@retval The payload, NULL if no memory is available.
+ */
+
+char* Sunset_Agent_Payload::alloc(int len) 
+{
+	sunset_payload_block* b = 0;
+	int c = getSizeClass(len + 1);
+	int size = len + 1;
+	
+	if ( c >= 0 ) {
+		
+		size = SUNSET_PAYLOAD_MIN_SIZE << c;
+		
+		lock();
+		
+		if ( !freeBlocks[c].empty() ) {
+			
+			b = freeBlocks[c].back();
+			freeBlocks[c].pop_back();
+			reused++;
+		}
+		
+		unlock();
+	}
+	
+	if ( b == 0 ) {
+		
+		b = (sunset_payload_block*) malloc (sizeof(sunset_payload_block) + size);
+		
+		if ( b == NULL ) {
+			
+			SUNSET_DEBUG_LOG(-1, -1, "Sunset_Agent_Payload::alloc MALLOC ERROR");
+			
+			return NULL;
+		}
+		
+		b->sizeClass = c;
+		b->size = size;
+		
+		__sync_fetch_and_add(&allocated, 1);
+	}
+	
+	b->refs = 1;
+	
+	memset(getData(b), '\0', len + 1);
+	
+	return getData(b);
+}
+
+/*!
+ * 	@brief The share function adds a reference to the payload, the packet copy can use the same buffer of the original packet.
+ *	@param data The payload to share.
+ *	@retval The shared payload.
+ */
+
+char* Sunset_Agent_Payload::share(char* data) 
+{
+	if ( data == NULL ) {
+		
+		return NULL;
+	}
+	
+	__sync_fetch_and_add(&(getBlock(data)->refs), 1);
+	__sync_fetch_and_add(&shared, 1);
+	
+	return data;
+}
+
+/*!
+ * 	@brief The release function removes a reference to the payload. When no packet references the payload anymore the buffer 
+ *	goes back to the free list of its size class, or it is deallocated if the free list is full.
+ *	@param data The payload to release.
+ */
+
+void Sunset_Agent_Payload::release(char* data) 
+{
+	sunset_payload_block* b = 0;
+	
+	if ( data == NULL ) {
+		
+		return;
+	}
+	
+	b = getBlock(data);
+	
+	if ( __sync_sub_and_fetch(&(b->refs), 1) > 0 ) {
+		
+		return;
+	}
+	
+	if ( b->sizeClass >= 0 ) {
+		
+		lock();
+		
+		if ( (int)(freeBlocks[b->sizeClass].size()) < SUNSET_PAYLOAD_MAX_FREE ) {
+			
+			freeBlocks[b->sizeClass].push_back(b);
+			b = 0;
+		}
+		
+		unlock();
+	}
+	
+	if ( b != 0 ) {
+		
+		free(b);
+	}
+}
+
+/*!
+ * 	@brief The writable function returns a payload which can be modified by the caller. If the payload is shared with other packets 
+ *	a private copy is created and the reference to the shared one is released.
+ *	@param data The payload to modify.
+ *	@param len The length of the payload.
+ *	@retval The payload to use in place of data.
+ */
+
+char* Sunset_Agent_Payload::writable(char* data, int len) 
+{
+	char* copy = NULL;
+	
+	if ( data == NULL || getRefs(data) <= 1 ) {
+		
+		return data;
+	}
+	
+	copy = alloc(len);
+	
+	if ( copy == NULL ) {
+		
+		return data;
+	}
+	
+	memcpy(copy, data, len);
+	
+	release(data);
+	
+	return copy;
+}
+
+/*!
+ * 	@brief The getRefs function returns the number of packets currently sharing the payload.
+ */
+
+int Sunset_Agent_Payload::getRefs(char* data) 
+{
+	if ( data == NULL ) {
+		
+		return 0;
+	}
+	
+	return getBlock(data)->refs;
+}
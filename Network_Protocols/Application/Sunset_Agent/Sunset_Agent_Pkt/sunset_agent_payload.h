@@ -0,0 +1,93 @@
+/* SUNSET - Sapienza University Networking framework for underwater Simulation, Emulation and real-life Testing
+ *
+ * Copyright (C) 2012 Regents of UWSN Group of SENSES Lab <http://reti.dsi.uniroma1.it/SENSES_lab/>
+ *
+ * Author: Roberto Petroccia - petroccia@di.uniroma1.it
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License as published
+ * at http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANATBILITY or FITNESS FOR A PARTICULAR PURPOSE. See the Creative Commons
+ * Attribution-NonCommercial-ShareAlike 3.0 Unported License for more details.
+ *
+ * You should have received a copy of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License
+ * along with this program. If not, see <http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode>.
+ */
+
+#ifndef SUNSET_AGENT_PAYLOAD_H
+#define SUNSET_AGENT_PAYLOAD_H
+
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#define SUNSET_PAYLOAD_MIN_SIZE		32	/*!< @brief Capacity of the smallest size class (bytes). */
+#define SUNSET_PAYLOAD_CLASSES		8	/*!< @brief Number of size classes, each one doubling the previous capacity. */
+#define SUNSET_PAYLOAD_MAX_FREE		256	/*!< @brief Maximum number of free buffers kept for each size class. */
+
+using namespace std;
+
+/*! @brief The header stored in front of each payload buffer. The payload pointer stored in the agent header points right after it. */
+
+typedef struct sunset_payload_block {
+	
+	volatile int refs;	/*!< @brief Number of packets sharing the buffer. */
+	int sizeClass;		/*!< @brief Size class of the buffer, -1 if it is larger than the largest class. */
+	int size;		/*!< @brief Capacity of the buffer (bytes). */
+	int pad;
+	
+} sunset_payload_block;
+
+/*! @brief This class implements a size-classed pool of reference-counted payload buffers for the agent packets.
+ *  Packet copies share the same buffer incrementing its counter, the buffer goes back to the pool when the last packet releases it.
+ *  Buffers are copied only when a shared payload has to be modified (copy-on-write).
+ */
+
+class Sunset_Agent_Payload {
+	
+public:
+	
+	/*! @brief The alloc function returns a zeroed payload of len + 1 bytes (the last one is the string terminator) referenced once. */
+	static char* alloc(int len);
+	
+	/*! @brief The share function adds a reference to the payload and returns it. */
+	static char* share(char* data);
+	
+	/*! @brief The release function removes a reference to the payload, the buffer is reused when no packet references it. */
+	static void release(char* data);
+	
+	/*! @brief The writable function returns a payload of len bytes which can be modified, it is copied if currently shared. */
+	static char* writable(char* data, int len);
+	
+	/*! @brief The getRefs function returns the number of packets sharing the payload. */
+	static int getRefs(char* data);
+	
+	static long getAllocated() { return allocated; }	/*!< @brief Number of buffers allocated from the system. */
+	static long getReused() { return reused; }		/*!< @brief Number of buffers taken from the pool. */
+	static long getShared() { return shared; }		/*!< @brief Number of payload copies avoided sharing the buffer. */
+	
+private:
+	
+	static sunset_payload_block* getBlock(char* data) { return ((sunset_payload_block*)data) - 1; }
+	
+	static char* getData(sunset_payload_block* b) { return (char*)(b + 1); }
+	
+	static int getSizeClass(int size);
+	
+	static void lock() { while ( __sync_lock_test_and_set(&lock_, 1) ) { } }
+	
+	static void unlock() { __sync_lock_release(&lock_); }
+	
+	static vector<sunset_payload_block*> freeBlocks[SUNSET_PAYLOAD_CLASSES];	/*!< @brief Free buffers of each size class. */
+	
+	static volatile int lock_;	/*!< @brief Lock protecting the free lists, payloads can be converted by the modem threads. */
+	
+	static long allocated;
+	static long reused;
+	static long shared;
+};
+
+#endif
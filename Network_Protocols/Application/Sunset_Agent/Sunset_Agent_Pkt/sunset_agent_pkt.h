@@ -25,6 +25,7 @@
 #include <packet.h>
 #include <stdint.h>
 #include <vector>
+#include <sunset_agent_payload.h>
 
 #define MAXDATASIZE		256
 
@@ -64,7 +65,7 @@ typedef struct hdr_Sunset_Agent
 	int pkt_id;
 	int src_id;
 	int dst_id;
-	char* data; /* This is the packet payload */
+	char* data; /* This is the packet payload, a pooled buffer shared by the packet copies (see Sunset_Agent_Payload) */
 	int data_size;
 		
 	/* Functions to access to the packet fields */
@@ -75,6 +76,9 @@ typedef struct hdr_Sunset_Agent
 	inline int& dstId() {return (dst_id);}
 	inline char* getData() { return data; }
 	
+	/*! @brief It returns the payload to be modified, a private copy is created if the payload is shared with other packets. */
+	inline char* getWritableData() { data = Sunset_Agent_Payload::writable(data, data_size); return data; }
+	
 	static int offset_;
 	inline static int& offset() { return offset_; }
 	
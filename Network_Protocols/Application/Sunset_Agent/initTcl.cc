@@ -7,6 +7,11 @@ Module/Sunset_Agent set portNumber -1\n\
 Module/Sunset_Agent set start_pktId 0\n\
 \n\
 \n\
+Sunset_Traffic_Generator set pktSize 0\n\
+Sunset_Traffic_Generator set startTime 0.0\n\
+Sunset_Traffic_Generator set endTime 0.0\n\
+Sunset_Traffic_Generator set maxPkts 0\n\
+\n\
 PacketHeaderManager set tab_(PacketHeader/Sunset_Agent) 1\n\
 ";
 #include "tclcl.h"
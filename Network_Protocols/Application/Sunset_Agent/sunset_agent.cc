@@ -69,7 +69,7 @@ Sunset_Agent::Sunset_Agent() : Module()
 	
 	stat = NULL;
 	
-	Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Agent::Sunset_Agent setup MAX_DATA_SIZE %d port_number %d", MAX_DATA_SIZE, port_number);
+	SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Agent::Sunset_Agent setup MAX_DATA_SIZE %d port_number %d", MAX_DATA_SIZE, port_number);
 }
 
 
@@ -85,7 +85,7 @@ void Sunset_Agent::start()
 {
 	Sunset_Module::start();
 	
-	Sunset_Debug::debugInfo(1, getModuleAddress(), "Sunset_Agent::start");
+	SUNSET_DEBUG_LOG(1, getModuleAddress(), "Sunset_Agent::start");
 	
 	// if statistics info are used initialize the statistics module reference
 	if (Sunset_Statistics::use_stat()) {
@@ -131,7 +131,7 @@ int Sunset_Agent::command(int argc, const char*const* argv)
 		
 		if (strcmp(argv[1], "start") == 0) {
 			
-			Sunset_Debug::debugInfo(1, getModuleAddress(), "Sunset_Agent::command start Module");
+			SUNSET_DEBUG_LOG(1, getModuleAddress(), "Sunset_Agent::command start Module");
 			start();
 			
 			return TCL_OK;
@@ -141,7 +141,7 @@ int Sunset_Agent::command(int argc, const char*const* argv)
 		
 		if (strcmp(argv[1], "stop") == 0) {
 			
-			Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Agent::command stop Module");
+			SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Agent::command stop Module");
 			stop();
 			
 			return TCL_OK;
@@ -154,7 +154,7 @@ int Sunset_Agent::command(int argc, const char*const* argv)
 		if (strcmp(argv[1], "setModuleAddress") == 0) {
 			
 			module_address = atoi(argv[2]);
-			Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Agent::command setModuleAddress %d", getModuleAddress());
+			SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Agent::command setModuleAddress %d", getModuleAddress());
 			
 			return TCL_OK;
 		}
@@ -168,7 +168,7 @@ int Sunset_Agent::command(int argc, const char*const* argv)
 			
 			port_number = atoi(argv[2]);
 			
-			Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Agent::command setPortNumber %d", getPortNumber());
+			SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Agent::command setPortNumber %d", getPortNumber());
 			
 			return TCL_OK;
 		}
@@ -179,7 +179,7 @@ int Sunset_Agent::command(int argc, const char*const* argv)
 			
 			start_pktId = atoi(argv[2]);
 			pkt_num = start_pktId;
-			Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Agent::command start_pktId %d", start_pktId);
+			SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Agent::command start_pktId %d", start_pktId);
 			
 			return TCL_OK;
 		}
@@ -189,7 +189,7 @@ int Sunset_Agent::command(int argc, const char*const* argv)
 		if (strcmp(argv[1], "setDataSize") == 0) {
 			
 			MAX_DATA_SIZE = atoi(argv[2]);
-			Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Agent::command MAX_DATA_SIZE %d", MAX_DATA_SIZE);
+			SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Agent::command MAX_DATA_SIZE %d", MAX_DATA_SIZE);
 			
 			return TCL_OK;
 		}
@@ -200,7 +200,7 @@ int Sunset_Agent::command(int argc, const char*const* argv)
 			
 			int dest = atoi(argv[2]);
 			
-			Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Agent::command send to %d", dest);
+			SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Agent::command send to %d", dest);
 			
 			if (Sunset_Utilities::isSimulation()) {
 				
@@ -221,7 +221,7 @@ int Sunset_Agent::command(int argc, const char*const* argv)
 			
 			int dest = atoi(argv[2]);
 			
-			Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Agent::command - getTxPkt %d", dest);
+			SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Agent::command - getTxPkt %d", dest);
 			tcl.resultf("%d", getTxPkt(dest));
 			
 			return TCL_OK;
@@ -233,7 +233,7 @@ int Sunset_Agent::command(int argc, const char*const* argv)
 			
 			int src = atoi(argv[2]);
 			
-			Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Agent::command - getPktHop %d", src);
+			SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Agent::command - getPktHop %d", src);
 			tcl.resultf("%d", getPktHop(src));
 			
 			return TCL_OK;
@@ -245,7 +245,7 @@ int Sunset_Agent::command(int argc, const char*const* argv)
 			
 			int src = atoi(argv[2]);
 			
-			Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Agent::command - getRxPkt %d", src);
+			SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Agent::command - getRxPkt %d", src);
 			tcl.resultf("%d", getRxPkt(src));
 			
 			return TCL_OK;
@@ -257,7 +257,7 @@ int Sunset_Agent::command(int argc, const char*const* argv)
 			
 			int src = atoi(argv[2]);
 			
-			Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Agent::command - getDelay %d", src);
+			SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Agent::command - getDelay %d", src);
 			tcl.resultf("%f", getDelay(src));
 			
 			return TCL_OK;
@@ -271,7 +271,7 @@ int Sunset_Agent::command(int argc, const char*const* argv)
 			
 			module_address = atoi(argv[2]);
 			run_id = atoi(argv[3]);
-			Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Agent::command setModuleAddress %d runId %d", getModuleAddress(), getRunId());
+			SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Agent::command setModuleAddress %d runId %d", getModuleAddress(), getRunId());
 			
 			return TCL_OK;
 		}
@@ -293,14 +293,14 @@ int Sunset_Agent::command(int argc, const char*const* argv)
 			
 			if ( msg == NULL ) {
 				
-				Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Agent::command MALLOC ERROR");
+				SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Agent::command MALLOC ERROR");
 				return TCL_ERROR;
 			}
 			
 			memset(msg, '\0', maxDataSize+1);
 			strncpy(msg, argv[3], maxDataSize);
 			
-			Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Agent::command send to %d msg %s", dest, msg);
+			SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Agent::command send to %d msg %s", dest, msg);
 			
 			sendData(dest, msg);
 			
@@ -321,7 +321,7 @@ int Sunset_Agent::command(int argc, const char*const* argv)
 			int min_size = atoi(argv[4]);
 			int max_size = atoi(argv[5]);
 			
-			Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Agent::command sendRandom to %d fix %d min %d max %d", dest, fix_size, min_size, max_size);
+			SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Agent::command sendRandom to %d fix %d min %d max %d", dest, fix_size, min_size, max_size);
 			
 			if (fix_size < 0 || min_size < 0 || max_size < 0 || max_size < min_size ) {
 				
@@ -349,7 +349,7 @@ bool Sunset_Agent::isPktForMe(Packet* p)
 {
 	struct hdr_ip* iph = HDR_IP(p);
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Agent::isPktForMe my_port %d port %d", getPortNumber(), iph->dport());
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Agent::isPktForMe my_port %d port %d", getPortNumber(), iph->dport());
 	
 	if (getPortNumber() != -1 && iph->dport() != getPortNumber()) {
 		
@@ -370,7 +370,7 @@ void Sunset_Agent::recvPkt(Packet *p)
 	u_int8_t  type = gh->ac.ac_type;
 	u_int8_t  subtype = gh->ac.ac_subtype;
 	
-	Sunset_Debug::debugInfo(0, getModuleAddress(), "Sunset_Agent::recv pkt src %d type %d subtype %d dest %d", gh->srcId(), type, subtype, gh->dstId());
+	SUNSET_DEBUG_LOG(0, getModuleAddress(), "Sunset_Agent::recv pkt src %d type %d subtype %d dest %d", gh->srcId(), type, subtype, gh->dstId());
 	
 	/* If I am the sender of the packet discard it */
 	
@@ -410,7 +410,7 @@ void Sunset_Agent::recvPkt(Packet *p)
 
 			Sunset_Trace::print_info("stat - (%.3f) Node:%d - Receives duplicated DATA message from %d id %d hop %d\n", Sunset_Utilities::get_now(), getModuleAddress(), gh->srcId(), id, HDR_CMN(p)->num_forwards());
 
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Agent::recvPkt pkt from %d to %d already processed DISCARD", src, dst);
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Agent::recvPkt pkt from %d to %d already processed DISCARD", src, dst);
 			
 			Sunset_Utilities::erasePkt(p, getModuleAddress());
 			
@@ -436,7 +436,7 @@ void Sunset_Agent::recvPkt(Packet *p)
 						break;
 						
 					default:
-						Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Agent::recv recv_timer3:Invalid MAC Data Subtype %x ERROR", subtype);
+						SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Agent::recv recv_timer3:Invalid MAC Data Subtype %x ERROR", subtype);
 						
 						Sunset_Utilities::erasePkt(p, getModuleAddress());
 						
@@ -451,7 +451,7 @@ void Sunset_Agent::recvPkt(Packet *p)
 				
 				switch(subtype) {
 					default:
-						Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Agent::recv recv_timer3:Invalid MAC Control Subtype %x ERROR",	subtype);
+						SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Agent::recv recv_timer3:Invalid MAC Control Subtype %x ERROR",	subtype);
 						
 						Sunset_Utilities::erasePkt(p, getModuleAddress());
 						
@@ -461,7 +461,7 @@ void Sunset_Agent::recvPkt(Packet *p)
 				break;	
 				
 			default:
-				Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Agent::recv recv_timer4:Invalid MAC Type %x ERROR", subtype);
+				SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Agent::recv recv_timer4:Invalid MAC Type %x ERROR", subtype);
 				
 				Sunset_Utilities::erasePkt(p, getModuleAddress());
 				
@@ -531,14 +531,14 @@ void Sunset_Agent::sendPkt(int dest, char* msg, int sizeMsg, int type, int subTy
 	// if I am running in simulation mode exit
 	if (Sunset_Utilities::isSimulation()) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Agent::sendPkt to node:%d but running in simulation mode ERROR", dest);
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Agent::sendPkt to node:%d but running in simulation mode ERROR", dest);
 		
 		return;
 	}
 	
 	Packet *p;
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Agent::sendPkt to node:%d len %d len2 %d text: %s", dest, sizeMsg, strlen(msg), msg);
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Agent::sendPkt to node:%d len %d len2 %d text: %s", dest, sizeMsg, strlen(msg), msg);
 	
 	// if dest = -1, conventionally used by ns2 for BRAODCAST set dest to  Sunset_Address::getBroadcastAddress()
 	
@@ -565,11 +565,11 @@ void Sunset_Agent::sendPkt(int dest, char* msg, int sizeMsg, int type, int subTy
 	
 	if (dest == Sunset_Address::getBroadcastAddress()) {
 		
-		Sunset_Debug::debugInfo(0, getModuleAddress(), "send BROADCAST DATA len %d id %d message: %s", HDR_SUNSET_AGT(p)->dataSize(), HDR_CMN(p)->uid(), HDR_SUNSET_AGT(p)->getData());
+		SUNSET_DEBUG_LOG(0, getModuleAddress(), "send BROADCAST DATA len %d id %d message: %s", HDR_SUNSET_AGT(p)->dataSize(), HDR_CMN(p)->uid(), HDR_SUNSET_AGT(p)->getData());
 		
 	} else {
 		
-		Sunset_Debug::debugInfo(0, getModuleAddress(), "send DATA message to %d len %d id %d msg: %s", dest, HDR_SUNSET_AGT(p)->dataSize(), HDR_CMN(p)->uid(), HDR_SUNSET_AGT(p)->getData());
+		SUNSET_DEBUG_LOG(0, getModuleAddress(), "send DATA message to %d len %d id %d msg: %s", dest, HDR_SUNSET_AGT(p)->dataSize(), HDR_CMN(p)->uid(), HDR_SUNSET_AGT(p)->getData());
 	}
 	
 	sendDown(p);
@@ -608,7 +608,7 @@ int Sunset_Agent::sendRandomLength(int destId, int fix_size, int min_size, int m
 		
 		if ( msg == NULL ) {
 			
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Agent::sendRandomLength MALLOC ERROR");
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Agent::sendRandomLength MALLOC ERROR");
 			return 0;
 		}
 		
@@ -630,7 +630,7 @@ int Sunset_Agent::sendRandomLength(int destId, int fix_size, int min_size, int m
 		}
 		
 		
-		Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Agent::command sendRandomLength to %d msg %s", dest, msg);
+		SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Agent::command sendRandomLength to %d msg %s", dest, msg);
 		
 		sendPkt(dest, msg, rand_len, SUNSET_AGT_Type_Data, SUNSET_AGT_Subtype_Data);
 		
@@ -654,6 +654,31 @@ void Sunset_Agent::sendData(int dest, char* msg)
 	sendPkt(dest, msg, strlen(msg), SUNSET_AGT_Type_Data, SUNSET_AGT_Subtype_Data);
 }
 
+/*!
+ * 	@brief The generateData function creates and sends a data packet to a specified destination, both in simulation and in emulation mode.
+ *	@param dest The intended packet destination.
+ *	@param len The packet size in bytes, MAX_DATA_SIZE is used if len <= 0.
+ */
+
+void Sunset_Agent::generateData(int dest, int len) 
+{
+	if (Sunset_Utilities::isSimulation()) {
+		
+		sendDataSim(dest, len > 0 ? len : MAX_DATA_SIZE);
+		
+		return;
+	}
+	
+	if (len <= 0) {
+		
+		sendDataEmulation(dest);
+		
+		return;
+	}
+	
+	sendRandomLength(dest, len, 0, 0);
+}
+
 /*!
  * 	@brief The sendDataSim function creates and sends a packet to a specified destination when running in simulation mode.
  *	@param dest The intended packet destination.
@@ -683,11 +708,11 @@ void Sunset_Agent::sendDataSim(int dest, int len)
 	
 	if (dest == -1 || dest == Sunset_Address::getBroadcastAddress()) {
 		
-		Sunset_Debug::debugInfo(0, getModuleAddress(),  "send BROADCAST DATA message id %d", HDR_SUNSET_AGT(p)->pktId());
+		SUNSET_DEBUG_LOG(0, getModuleAddress(),  "send BROADCAST DATA message id %d", HDR_SUNSET_AGT(p)->pktId());
 		
 	}
 	else {
-		Sunset_Debug::debugInfo(0, getModuleAddress(),  "send DATA message to %d id %d size %d - count %d", dest, HDR_SUNSET_AGT(p)->pktId(), HDR_CMN(p)->size(), pktSent_[dest]);
+		SUNSET_DEBUG_LOG(0, getModuleAddress(),  "send DATA message to %d id %d size %d - count %d", dest, HDR_SUNSET_AGT(p)->pktId(), HDR_CMN(p)->size(), pktSent_[dest]);
 	}
 	
 	sendDown(p);
@@ -711,7 +736,7 @@ void Sunset_Agent::sendDataEmulation(int dest)
 	
 	int len = 0;
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Agent::sendDataEmulation - %d - %d", max_pkt_size, pkt_size);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Agent::sendDataEmulation - %d - %d", max_pkt_size, pkt_size);
 	
 	//allocate the memory for the packet payload without exceedign the maximum allowed payload size
 	if (pkt_size < max_pkt_size) {
@@ -728,7 +753,7 @@ void Sunset_Agent::sendDataEmulation(int dest)
 	
 	if ( dData == NULL ) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Agent::sendDataEmulation MALLOC ERROR");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Agent::sendDataEmulation MALLOC ERROR");
 		
 		return;
 	}
@@ -774,21 +799,21 @@ void Sunset_Agent::recvData(Packet *pkt)
 	pktLatency_[(int)(gh->srcId())] += Sunset_Utilities::getRealTime() - HDR_CMN(pkt)->timestamp();
 	
 	if (Sunset_Utilities::isSimulation()) {
-		Sunset_Debug::debugInfo(0, getModuleAddress(), "receives DATA message from %d id %d hop %d latency %f", gh->srcId(), gh->pktId(), HDR_CMN(pkt)->num_forwards(), Sunset_Utilities::getRealTime() - HDR_CMN(pkt)->timestamp());
+		SUNSET_DEBUG_LOG(0, getModuleAddress(), "receives DATA message from %d id %d hop %d latency %f", gh->srcId(), gh->pktId(), HDR_CMN(pkt)->num_forwards(), Sunset_Utilities::getRealTime() - HDR_CMN(pkt)->timestamp());
 	}
 	else {
 		if (HDR_CMN(pkt)->timestamp() != 0) {
 			
-			Sunset_Debug::debugInfo(0, getModuleAddress(), "receives DATA message from %d id %d  hop %d latency %f: %s", gh->srcId(), gh->pktId(), HDR_CMN(pkt)->num_forwards(), Sunset_Utilities::getRealTime() - HDR_CMN(pkt)->timestamp(), gh->getData());
+			SUNSET_DEBUG_LOG(0, getModuleAddress(), "receives DATA message from %d id %d  hop %d latency %f: %s", gh->srcId(), gh->pktId(), HDR_CMN(pkt)->num_forwards(), Sunset_Utilities::getRealTime() - HDR_CMN(pkt)->timestamp(), gh->getData());
 			
 			if (Sunset_Utilities::getRealTime() - HDR_CMN(pkt)->timestamp() < 0.0) {
 				
-				Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Agent::recvData pktLatency_ %f < 0 ERROR", Sunset_Utilities::getRealTime() - HDR_CMN(pkt)->timestamp()); 
+				SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Agent::recvData pktLatency_ %f < 0 ERROR", Sunset_Utilities::getRealTime() - HDR_CMN(pkt)->timestamp()); 
 			}
 		}
 		else {
 			
-			Sunset_Debug::debugInfo(0, getModuleAddress(), "receives DATA message from %d id %d  hop %d: %s", gh->srcId(), gh->pktId(), HDR_CMN(pkt)->num_forwards(), gh->getData());
+			SUNSET_DEBUG_LOG(0, getModuleAddress(), "receives DATA message from %d id %d  hop %d: %s", gh->srcId(), gh->pktId(), HDR_CMN(pkt)->num_forwards(), gh->getData());
 		}
 		
 	}
@@ -869,24 +894,22 @@ Packet* Sunset_Agent::createPacket(int dest, char* msg, int len, int pktType, in
 	
 	HDR_IP(p)->dport() = getPortNumber();
 	
-	Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Agent::createPacket src %d dst %d uid %d pktId %d port %d my_port %d", getModuleAddress(), dest, cmh->uid(), gh->pktId(), HDR_IP(p)->dport(), getPortNumber());
+	SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Agent::createPacket src %d dst %d uid %d pktId %d port %d my_port %d", getModuleAddress(), dest, cmh->uid(), gh->pktId(), HDR_IP(p)->dport(), getPortNumber());
 
 	gh->dataSize() = lenData; //PKT_SIZE;
-	gh->data = (char*)malloc(sizeof(char) * ((int)(gh->dataSize()) + 1));
+	gh->data = Sunset_Agent_Payload::alloc((int)(gh->dataSize())); // zeroed pooled buffer, released when the last copy of the packet is erased
 	
 	if ( gh->data == NULL ) { 
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Agent::createPacket MALLOC ERROR");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Agent::createPacket MALLOC ERROR");
 		
 		return p;
 		exit(1);
 	}
 	
-	memset(gh->data, '\0', ((int)(gh->dataSize()) + 1));
-	
 	memcpy(gh->getData(), msg, (int)(gh->dataSize()));
 	
-	Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Agent::createPacket len %d max_lenData %d msg_len %d msg: %s", len, maxDataSize, gh->dataSize(), gh->data);
+	SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Agent::createPacket len %d max_lenData %d msg_len %d msg: %s", len, maxDataSize, gh->dataSize(), gh->data);
 
 	cmh->size() = getAgtHeaderSize() + lenData;
 	cmh->direction() == hdr_cmn::DOWN;
@@ -959,7 +982,7 @@ void Sunset_Agent::initPacket(Packet* p, int dest, int size, int pktType, int pk
 	
 	cmh->direction() = hdr_cmn::DOWN;
 	
-	Sunset_Debug::debugInfo(1, getModuleAddress(), "Sunset_Agent::initPacket for node:%d", dest);
+	SUNSET_DEBUG_LOG(1, getModuleAddress(), "Sunset_Agent::initPacket for node:%d", dest);
 	
 	gh->data = 0;
 	gh->dataSize() = 0;
@@ -979,14 +1002,14 @@ void Sunset_Agent::initPacket(Packet* p, int dest, int size, int pktType, int pk
 
 int Sunset_Agent::getTxPkt(int dest) 
 {
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Agent::getTxPkt %d", dest);
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Agent::getTxPkt %d", dest);
 	
 	if ( pktSent_.find(dest) == pktSent_.end() ) {
 		
 		return 0;
 	}
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Agent::getTxPkt %d value %d", dest, pktSent_[dest]);
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Agent::getTxPkt %d value %d", dest, pktSent_[dest]);
 	
 	return pktSent_[dest];
 }
@@ -1017,14 +1040,14 @@ int Sunset_Agent::getPktHop(int src)
 int Sunset_Agent::getRxPkt(int src) 
 {
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Agent::getRxPkt %d", src);
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Agent::getRxPkt %d", src);
 	
 	if (pktRx_.find(src) == pktRx_.end()) {
 		
 		return 0;
 	}
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Agent::getRxPkt %d value %d", src, pktRx_[src]);
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Agent::getRxPkt %d value %d", src, pktRx_[src]);
 	
 	return pktRx_[src];
 }
@@ -59,6 +59,9 @@ public:
 	
 	virtual int getPortNumber() { return port_number; }
 	
+	/*! @brief Create and send a data packet of len bytes to dest, the configured data size is used if len <= 0. It is used by the traffic generators. */
+	virtual void generateData(int dest, int len);
+	
 protected:
 	
 	// These functions compute basic statistic information to be able to provide a feedback to the user even if the statistic module is not used
@@ -0,0 +1,5 @@
+
+Sunset_Traffic_Generator set pktSize 0
+Sunset_Traffic_Generator set startTime 0.0
+Sunset_Traffic_Generator set endTime 0.0
+Sunset_Traffic_Generator set maxPkts 0
@@ -0,0 +1,591 @@
+/* SUNSET - Sapienza University Networking framework for underwater Simulation, Emulation and real-life Testing
+ *
+ * Copyright (C) 2012 Regents of UWSN Group of SENSES Lab <http://reti.dsi.uniroma1.it/SENSES_lab/>
+ *
+ * Author: Roberto Petroccia - petroccia@di.uniroma1.it
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License as published
+ * at http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANATBILITY or FITNESS FOR A PARTICULAR PURPOSE. See the Creative Commons
+ * Attribution-NonCommercial-ShareAlike 3.0 Unported License for more details.
+ *
+ * You should have received a copy of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License
+ * along with this program. If not, see <http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode>.
+ */
+
+#include <sunset_traffic_generator.h>
+
+/*!
+ * 	@brief This static class is a hook class used to instantiate a C++ object from the TCL script. 
+ *	It also allows to define parameter values using the bind function in the class constructor.
+ */
+
+static class Sunset_Traffic_GeneratorTClass : public TclClass 
+{
+	
+public:
+	Sunset_Traffic_GeneratorTClass() : TclClass("Sunset_Traffic_Generator") {}
+	
+	TclObject* create(int argc , const char*const* argv) {
+		
+		return(new Sunset_Traffic_Generator());
+	}
+	
+} class_Sunset_Traffic_Generator;
+
+
+Sunset_Traffic_Generator::Sunset_Traffic_Generator()
+{
+	agent_ = 0;
+	rng_ = RNG::defaultrng();
+	running_ = false;
+	
+	model_ = SUNSET_TRAFFIC_CBR;
+	period_ = 1.0;
+	rate_ = 1.0;
+	meanOn_ = 1.0;
+	meanOff_ = 1.0;
+	onEnd_ = 0.0;
+	
+	traceIndex_ = 0;
+	traceDest_ = -2;
+	traceSize_ = 0;
+	
+	destType_ = SUNSET_TRAFFIC_DEST_FIXED;
+	dest_ = -1;
+	minDest_ = 0;
+	maxDest_ = 0;
+	totalWeight_ = 0.0;
+	
+	pktSize_ = 0;
+	startTime_ = 0.0;
+	endTime_ = 0.0;
+	maxPkts_ = 0;
+	generated_ = 0;
+	
+	bind("pktSize", &pktSize_);
+	bind("startTime", &startTime_);
+	bind("endTime", &endTime_);
+	bind("maxPkts", &maxPkts_);
+}
+
+Sunset_Traffic_Generator::~Sunset_Traffic_Generator()
+{
+	stop();
+}
+
+/*!
+ * 	@brief The command() function is a TCL hook for all the classes in ns-2 which allows C++ functions to be called from a TCL script 
+ *	@param argc argc is a count of the arguments supplied to the command function.
+ *	@param argv argv is an array of pointers to the strings which are those arguments.
+ *	@retval TCL_OK the command has been correctly executed. 
+ *	@retval TCL_ERROR the command has NOT been correctly executed. 
+ */
+
+int Sunset_Traffic_Generator::command(int argc, const char*const* argv)
+{
+	Tcl& tcl = Tcl::instance();
+	
+	if (argc == 2) {
+		
+		/* The "start" command starts the generation at startTime, or now if startTime is in the past */
+		
+		if (strcmp(argv[1], "start") == 0) {
+			
+			start(startTime_);
+			
+			return TCL_OK;
+		}
+		
+		/* The "stop" command stops the generation */
+		
+		if (strcmp(argv[1], "stop") == 0) {
+			
+			stop();
+			
+			return TCL_OK;
+		}
+		
+		/* The "getGenerated" command returns the number of generated packets */
+		
+		if (strcmp(argv[1], "getGenerated") == 0) {
+			
+			tcl.resultf("%d", getGenerated());
+			
+			return TCL_OK;
+		}
+	}
+	else if (argc == 3) {
+		
+		/* The "setAgent" command sets the agent module transmitting the generated packets */
+		
+		if (strcmp(argv[1], "setAgent") == 0) {
+			
+			agent_ = dynamic_cast<Sunset_Agent*>(TclObject::lookup(argv[2]));
+			
+			if (agent_ == 0) {
+				
+				SUNSET_DEBUG_LOG(-1, -1, "Sunset_Traffic_Generator::command setAgent %s is not a Sunset_Agent ERROR", argv[2]);
+				
+				return TCL_ERROR;
+			}
+			
+			return TCL_OK;
+		}
+		
+		/* The "setRng" command sets the random number generator used for the arrivals and the destinations */
+		
+		if (strcmp(argv[1], "setRng") == 0) {
+			
+			RNG* rng = dynamic_cast<RNG*>(TclObject::lookup(argv[2]));
+			
+			if (rng == 0) {
+				
+				return TCL_ERROR;
+			}
+			
+			rng_ = rng;
+			
+			return TCL_OK;
+		}
+		
+		/* The "start" command starts the generation at the given time */
+		
+		if (strcmp(argv[1], "start") == 0) {
+			
+			start(atof(argv[2]));
+			
+			return TCL_OK;
+		}
+		
+		/* The "setCbr" command generates a packet every period seconds */
+		
+		if (strcmp(argv[1], "setCbr") == 0) {
+			
+			period_ = atof(argv[2]);
+			
+			if (period_ <= 0.0) {
+				
+				return TCL_ERROR;
+			}
+			
+			model_ = SUNSET_TRAFFIC_CBR;
+			
+			return TCL_OK;
+		}
+		
+		/* The "setPoisson" command generates packets according to a Poisson process with the given rate (pkt/sec) */
+		
+		if (strcmp(argv[1], "setPoisson") == 0) {
+			
+			rate_ = atof(argv[2]);
+			
+			if (rate_ <= 0.0) {
+				
+				return TCL_ERROR;
+			}
+			
+			model_ = SUNSET_TRAFFIC_POISSON;
+			
+			return TCL_OK;
+		}
+		
+		/* The "setTrace" command reads the arrivals from a file, each line contains: time [destination [size]] */
+		
+		if (strcmp(argv[1], "setTrace") == 0) {
+			
+			if (!loadTrace(argv[2])) {
+				
+				return TCL_ERROR;
+			}
+			
+			model_ = SUNSET_TRAFFIC_TRACE;
+			
+			return TCL_OK;
+		}
+		
+		/* The "setDestination" command sends all the packets to the given node */
+		
+		if (strcmp(argv[1], "setDestination") == 0) {
+			
+			dest_ = atoi(argv[2]);
+			destType_ = SUNSET_TRAFFIC_DEST_FIXED;
+			
+			return TCL_OK;
+		}
+		
+		/* The "setPktSize" command sets the size of the generated packets, the agent data size is used if <= 0 */
+		
+		if (strcmp(argv[1], "setPktSize") == 0) {
+			
+			pktSize_ = atoi(argv[2]);
+			
+			return TCL_OK;
+		}
+	}
+	else if (argc == 4) {
+		
+		/* The "setRandomDestination" command selects the destination of each packet uniformly in [min, max], the node itself excluded */
+		
+		if (strcmp(argv[1], "setRandomDestination") == 0) {
+			
+			minDest_ = atoi(argv[2]);
+			maxDest_ = atoi(argv[3]);
+			
+			if (maxDest_ < minDest_) {
+				
+				return TCL_ERROR;
+			}
+			
+			destType_ = SUNSET_TRAFFIC_DEST_RANDOM;
+			
+			return TCL_OK;
+		}
+		
+		/* The "addFlow" command adds a destination, each packet selects a flow with probability proportional to its weight */
+		
+		if (strcmp(argv[1], "addFlow") == 0) {
+			
+			traffic_flow f;
+			
+			f.dest = atoi(argv[2]);
+			f.weight = atof(argv[3]);
+			
+			if (f.weight <= 0.0) {
+				
+				return TCL_ERROR;
+			}
+			
+			flows_.push_back(f);
+			totalWeight_ += f.weight;
+			destType_ = SUNSET_TRAFFIC_DEST_FLOW;
+			
+			return TCL_OK;
+		}
+	}
+	else if (argc == 5) {
+		
+		/* The "setOnOff" command generates a packet every period seconds during ON intervals, ON and OFF durations are exponentially distributed */
+		
+		if (strcmp(argv[1], "setOnOff") == 0) {
+			
+			period_ = atof(argv[2]);
+			meanOn_ = atof(argv[3]);
+			meanOff_ = atof(argv[4]);
+			
+			if (period_ <= 0.0 || meanOn_ <= 0.0 || meanOff_ < 0.0) {
+				
+				return TCL_ERROR;
+			}
+			
+			model_ = SUNSET_TRAFFIC_ON_OFF;
+			
+			return TCL_OK;
+		}
+	}
+	
+	return TclObject::command(argc, argv);
+}
+
+/*!
+ * 	@brief The start function schedules the first arrival.
+ *	@param time The time the generation starts, now if it is in the past.
+ */
+
+void Sunset_Traffic_Generator::start(double time)
+{
+	double now = Scheduler::instance().clock();
+	double first = 0.0;
+	
+	if (agent_ == 0) {
+		
+		SUNSET_DEBUG_LOG(-1, -1, "Sunset_Traffic_Generator::start agent not defined ERROR");
+		
+		return;
+	}
+	
+	stop();
+	
+	if (time < now) {
+		
+		time = now;
+	}
+	
+	startTime_ = time;
+	traceIndex_ = 0;
+	generated_ = 0;
+	
+	switch (model_) {
+			
+		case SUNSET_TRAFFIC_POISSON:
+			
+			first = time + exponential(1.0 / rate_);
+			
+			break;
+			
+		case SUNSET_TRAFFIC_ON_OFF:
+			
+			onEnd_ = time + exponential(meanOn_);
+			first = time;
+			
+			break;
+			
+		case SUNSET_TRAFFIC_TRACE:
+			
+			first = nextArrival(time);
+			
+			break;
+			
+		default:
+			
+			first = time;
+			
+			break;
+	}
+	
+	if (first < 0.0 || (endTime_ > 0.0 && first > endTime_)) {
+		
+		SUNSET_DEBUG_LOG(1, agent_->getModuleAddress(), "Sunset_Traffic_Generator::start no arrival to generate");
+		
+		return;
+	}
+	
+	running_ = true;
+	
+	SUNSET_DEBUG_LOG(1, agent_->getModuleAddress(), "Sunset_Traffic_Generator::start model %d first arrival %f", model_, first);
+	
+	Sunset_Utilities::schedule(this, &ev_, first - now);
+}
+
+/*!
+ * 	@brief The stop function cancels the scheduled arrival.
+ */
+
+void Sunset_Traffic_Generator::stop()
+{
+	if (!running_) {
+		
+		return;
+	}
+	
+	Scheduler::instance().cancel(&ev_);
+	
+	running_ = false;
+}
+
+/*!
+ * 	@brief The handle function is invoked at each arrival: the packet is handed to the agent and the next arrival is scheduled.
+ */
+
+void Sunset_Traffic_Generator::handle(Event *e)
+{
+	double now = Scheduler::instance().clock();
+	double next = 0.0;
+	int dest = nextDestination();
+	int size = pktSize_;
+	
+	running_ = false;
+	
+	if (model_ == SUNSET_TRAFFIC_TRACE) {
+		
+		if (traceDest_ != -2) {
+			
+			dest = traceDest_;
+		}
+		
+		if (traceSize_ > 0) {
+			
+			size = traceSize_;
+		}
+	}
+	
+	generated_++;
+	
+	SUNSET_DEBUG_LOG(3, agent_->getModuleAddress(), "Sunset_Traffic_Generator::handle packet %d to %d size %d", generated_, dest, size);
+	
+	agent_->generateData(dest, size);
+	
+	if (maxPkts_ > 0 && generated_ >= maxPkts_) {
+		
+		return;
+	}
+	
+	next = nextArrival(now);
+	
+	if (next < 0.0 || (endTime_ > 0.0 && next > endTime_)) {
+		
+		SUNSET_DEBUG_LOG(1, agent_->getModuleAddress(), "Sunset_Traffic_Generator::handle generation completed packets %d", generated_);
+		
+		return;
+	}
+	
+	running_ = true;
+	
+	Sunset_Utilities::schedule(this, &ev_, next - now);
+}
+
+/*!
+ * 	@brief The nextArrival function computes the time of the arrival following the one at time now.
+ *	@param now The time of the current arrival.
+ *	@retval The time of the next arrival, -1 if no more arrivals have to be generated.
+ */
+
+double Sunset_Traffic_Generator::nextArrival(double now)
+{
+	double t = 0.0;
+	
+	switch (model_) {
+			
+		case SUNSET_TRAFFIC_CBR:
+			
+			return now + period_;
+			
+		case SUNSET_TRAFFIC_POISSON:
+			
+			return now + exponential(1.0 / rate_);
+			
+		case SUNSET_TRAFFIC_ON_OFF:
+			
+			t = now + period_;
+			
+			// move to the next ON interval, skipping the empty ones
+			
+			while (t > onEnd_) {
+				
+				t = onEnd_ + exponential(meanOff_);
+				onEnd_ = t + exponential(meanOn_);
+			}
+			
+			return t;
+			
+		case SUNSET_TRAFFIC_TRACE:
+			
+			if (traceIndex_ >= (int)trace_.size()) {
+				
+				return -1.0;
+			}
+			
+			t = startTime_ + trace_[traceIndex_].time;
+			traceDest_ = trace_[traceIndex_].dest;
+			traceSize_ = trace_[traceIndex_].size;
+			traceIndex_++;
+			
+			return (t < now) ? now : t;
+	}
+	
+	return -1.0;
+}
+
+/*!
+ * 	@brief The nextDestination function selects the destination of the next packet.
+ */
+
+int Sunset_Traffic_Generator::nextDestination()
+{
+	int dest = 0;
+	double x = 0.0;
+	
+	switch (destType_) {
+			
+		case SUNSET_TRAFFIC_DEST_RANDOM:
+			
+			// the node itself is excluded, if it is in the range
+			
+			if (agent_->getModuleAddress() >= minDest_ && agent_->getModuleAddress() <= maxDest_ && maxDest_ > minDest_) {
+				
+				dest = minDest_ + rng_->uniform(maxDest_ - minDest_);
+				
+				if (dest >= agent_->getModuleAddress()) {
+					
+					dest++;
+				}
+				
+				return dest;
+			}
+			
+			return minDest_ + rng_->uniform(maxDest_ - minDest_ + 1);
+			
+		case SUNSET_TRAFFIC_DEST_FLOW:
+			
+			x = rng_->uniform_double() * totalWeight_;
+			
+			for (int i = 0; i < (int)flows_.size(); i++) {
+				
+				if (x < flows_[i].weight) {
+					
+					return flows_[i].dest;
+				}
+				
+				x -= flows_[i].weight;
+			}
+			
+			return flows_.back().dest;
+			
+		default:
+			
+			return dest_;
+	}
+}
+
+/*!
+ * 	@brief The loadTrace function reads the arrivals from a trace file. Each line contains the arrival time (sec, from the 
+ *	generator start) and optionally the destination and the packet size. Empty lines and lines starting with '#' are skipped.
+ *	@param file The trace file name.
+ *	@retval false If the file cannot be read.
+ */
+
+bool Sunset_Traffic_Generator::loadTrace(const char* file)
+{
+	FILE* fp = fopen(file, "r");
+	char line[256];
+	traffic_trace_entry te;
+	int n = 0;
+	
+	if (fp == NULL) {
+		
+		SUNSET_DEBUG_LOG(-1, -1, "Sunset_Traffic_Generator::loadTrace cannot open %s ERROR", file);
+		
+		return false;
+	}
+	
+	trace_.clear();
+	
+	while (fgets(line, sizeof(line), fp) != NULL) {
+		
+		if (line[0] == '#') {
+			
+			continue;
+		}
+		
+		te.dest = -2;
+		te.size = 0;
+		
+		n = sscanf(line, "%lf %d %d", &(te.time), &(te.dest), &(te.size));
+		
+		if (n < 1) {
+			
+			continue;
+		}
+		
+		if (!trace_.empty() && te.time < trace_.back().time) {
+			
+			SUNSET_DEBUG_LOG(-1, -1, "Sunset_Traffic_Generator::loadTrace %s arrivals not sorted at %f ERROR", file, te.time);
+			
+			fclose(fp);
+			
+			return false;
+		}
+		
+		trace_.push_back(te);
+	}
+	
+	fclose(fp);
+	
+	SUNSET_DEBUG_LOG(1, -1, "Sunset_Traffic_Generator::loadTrace %s arrivals %d", file, (int)trace_.size());
+	
+	return true;
+}
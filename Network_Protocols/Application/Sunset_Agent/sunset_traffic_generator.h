@@ -0,0 +1,132 @@
+/* SUNSET - Sapienza University Networking framework for underwater Simulation, Emulation and real-life Testing
+ *
+ * Copyright (C) 2012 Regents of UWSN Group of SENSES Lab <http://reti.dsi.uniroma1.it/SENSES_lab/>
+ *
+ * Author: Roberto Petroccia - petroccia@di.uniroma1.it
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License as published
+ * at http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANATBILITY or FITNESS FOR A PARTICULAR PURPOSE. See the Creative Commons
+ * Attribution-NonCommercial-ShareAlike 3.0 Unported License for more details.
+ *
+ * You should have received a copy of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License
+ * along with this program. If not, see <http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode>.
+ */
+
+#ifndef __Sunset_Traffic_Generator_h__
+#define __Sunset_Traffic_Generator_h__
+
+#include <math.h>
+#include <stdio.h>
+#include <vector>
+#include <rng.h>
+#include <sunset_agent.h>
+#include <sunset_utilities.h>
+#include <sunset_debug.h>
+
+typedef enum traffic_model_type {	// arrival processes supported by the traffic generator
+	SUNSET_TRAFFIC_CBR		= 0,
+	SUNSET_TRAFFIC_POISSON		= 1,
+	SUNSET_TRAFFIC_ON_OFF		= 2,
+	SUNSET_TRAFFIC_TRACE		= 3
+} traffic_model_type;
+
+typedef enum traffic_dest_type {	// destination selection policies
+	SUNSET_TRAFFIC_DEST_FIXED	= 0,
+	SUNSET_TRAFFIC_DEST_RANDOM	= 1,
+	SUNSET_TRAFFIC_DEST_FLOW	= 2
+} traffic_dest_type;
+
+/*! @brief An arrival read from a trace file: time (relative to the generator start), destination (-2 if not given) and size (0 if not given). */
+typedef struct traffic_trace_entry {
+	
+	double time;
+	int dest;
+	int size;
+	
+} traffic_trace_entry;
+
+/*! @brief A flow of the generator: packets are sent to dest with probability proportional to weight. */
+typedef struct traffic_flow {
+	
+	int dest;
+	double weight;
+	
+} traffic_flow;
+
+/*! @brief This class implements a traffic generator attached to a Sunset_Agent module. The arrivals (CBR, Poisson, 
+ *  on/off bursts or trace file) and the destinations (fixed, random or per-flow) are generated natively, the TCL 
+ *  script only configures the generator and starts it.
+ */
+
+class Sunset_Traffic_Generator : public TclObject, public Handler {
+	
+public:
+	
+	Sunset_Traffic_Generator();
+	~Sunset_Traffic_Generator();
+	
+	virtual int command( int argc, const char*const* argv );
+	
+	virtual void handle(Event *e);
+	
+	int getGenerated() { return generated_; }
+	
+protected:
+	
+	virtual void start(double time);
+	
+	virtual void stop();
+	
+	/*! @brief Return the time of the arrival following the one at time now, -1 if no more arrivals have to be generated. */
+	virtual double nextArrival(double now);
+	
+	/*! @brief Return the destination of the next packet. */
+	virtual int nextDestination();
+	
+	bool loadTrace(const char* file);
+	
+	double exponential(double mean) { return -mean * log(1.0 - rng_->uniform_double()); }
+	
+	Sunset_Agent* agent_;
+	
+	RNG* rng_;
+	
+	Event ev_;
+	
+	bool running_;
+	
+	traffic_model_type model_;
+	
+	double period_;		// CBR period and packet period during the ON intervals (sec)
+	double rate_;		// Poisson arrival rate (pkt/sec)
+	double meanOn_;		// mean duration of the ON intervals (sec)
+	double meanOff_;	// mean duration of the OFF intervals (sec)
+	double onEnd_;		// end of the current ON interval
+	
+	vector<traffic_trace_entry> trace_;
+	int traceIndex_;	// next trace entry
+	int traceDest_;		// destination of the scheduled trace arrival, -2 if not given
+	int traceSize_;		// size of the scheduled trace arrival, 0 if not given
+	
+	traffic_dest_type destType_;
+	int dest_;
+	int minDest_;
+	int maxDest_;
+	vector<traffic_flow> flows_;
+	double totalWeight_;
+	
+	int pktSize_;		// packet size in bytes, the agent data size is used if <= 0
+	
+	double startTime_;
+	double endTime_;	// no more packets are generated after endTime_, if > 0
+	int maxPkts_;		// maximum number of generated packets, if > 0
+	
+	int generated_;
+};
+
+#endif
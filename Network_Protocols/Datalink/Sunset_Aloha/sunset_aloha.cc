@@ -90,7 +90,7 @@ void Sunset_Aloha::anotherTransmission()
 		
 		Packet* p2;
 		
-		Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Aloha::anotherTransmission queue length %d", macQueue_->length());
+		SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Aloha::anotherTransmission queue length %d", macQueue_->length());
 		
 		p2 = macQueue_->deque();
 		
@@ -99,15 +99,15 @@ void Sunset_Aloha::anotherTransmission()
 		Mac2PhyStartTx(p2->copy());
 		
 		tx_active_ = 1;
-Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Aloha::Mac2PhyStartTx1 p2 %p pktTx_ %p", p2, pktTx_);
+SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Aloha::Mac2PhyStartTx1 p2 %p pktTx_ %p", p2, pktTx_);
 		
 	} else {
 		
-		Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Aloha::anotherTransmission no pkt in queue");
+		SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Aloha::anotherTransmission no pkt in queue");
 	}
 
 
-Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Aloha::Mac2PhyStartTx pktTx_ %p", pktTx_);
+SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Aloha::Mac2PhyStartTx pktTx_ %p", pktTx_);
 
 }
 
@@ -126,11 +126,11 @@ void Sunset_Aloha::send(Packet* p)
 			
 			macQueue_->enque(p);
 			
-			Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Aloha::send enque packet, queue length %d", macQueue_->length());
+			SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Aloha::send enque packet, queue length %d", macQueue_->length());
 		}
 		else {
 			
-			Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Aloha::send no queue discard pkt");
+			SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Aloha::send no queue discard pkt");
 			
 			Mac2RtgPktDiscarded(p->copy());
 			
@@ -146,7 +146,7 @@ void Sunset_Aloha::send(Packet* p)
 		
 		tx_active_ = 1;
 		
-		Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Aloha::send transmit pkt to %d", HDR_SUNSET_MAC(p)->dst);
+		SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Aloha::send transmit pkt to %d", HDR_SUNSET_MAC(p)->dst);
 	}
 }
 
@@ -183,7 +183,7 @@ void Sunset_Aloha::txAction(Packet* p, mac_action_type mct)
 			
 				default:
 					
-					Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Aloha::txAction Invalid MAC Control Subtype %x ERROR", subtype);
+					SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Aloha::txAction Invalid MAC Control Subtype %x ERROR", subtype);
 					
 					return;
 			}
@@ -200,7 +200,7 @@ void Sunset_Aloha::txAction(Packet* p, mac_action_type mct)
 					break;
 					
 				default:
-					Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Aloha::txAction Invalid MAC Data Subtype %x ERROR", subtype);
+					SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Aloha::txAction Invalid MAC Data Subtype %x ERROR", subtype);
 					
 					return;
 			}
@@ -209,7 +209,7 @@ void Sunset_Aloha::txAction(Packet* p, mac_action_type mct)
 			
 		default:
 			
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Aloha::txAction Invalid MAC Type %x ERROR", subtype);
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Aloha::txAction Invalid MAC Type %x ERROR", subtype);
 			
 			return;
 	}
@@ -294,7 +294,7 @@ void Sunset_Aloha::rxAction(Packet* p, mac_action_type mct)
 			switch(subtype) {
 			
 				default:
-					Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Aloha::rxAction Invalid MAC Control Subtype %x ERROR", subtype);
+					SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Aloha::rxAction Invalid MAC Control Subtype %x ERROR", subtype);
 					
 					return;
 			}
@@ -310,7 +310,7 @@ void Sunset_Aloha::rxAction(Packet* p, mac_action_type mct)
 					break;
 				
 				default:
-					Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Aloha::rxAction Invalid MAC Data Subtype %x ERROR", subtype);
+					SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Aloha::rxAction Invalid MAC Data Subtype %x ERROR", subtype);
 					
 					return;
 			}
@@ -319,7 +319,7 @@ void Sunset_Aloha::rxAction(Packet* p, mac_action_type mct)
 			
 		default:
 			
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Aloha::rxAction Invalid MAC Type %x ERROR", subtype);
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Aloha::rxAction Invalid MAC Type %x ERROR", subtype);
 			
 			return;
 	}
@@ -358,7 +358,7 @@ void Sunset_Aloha::rxAction(Packet* p, mac_action_type mct)
 
 void Sunset_Aloha::Phy2MacEndTx(const Packet* p) {
 	
-	Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Aloha::Phy2MacEndTx %p %p", p, pktTx_);
+	SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Aloha::Phy2MacEndTx %p %p", p, pktTx_);
 	
 	if (sid == NULL) {
 		
@@ -375,12 +375,12 @@ void Sunset_Aloha::Phy2MacEndTx(const Packet* p) {
 	
 	if ( sid->set(getModuleAddress(), sid_id, ni) == 0 ) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Aloha::sendMacTxCompleted PROVIDING INFO %s NOT DEFINED", (ni.info_name).c_str());
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Aloha::sendMacTxCompleted PROVIDING INFO %s NOT DEFINED", (ni.info_name).c_str());
 		Sunset_Mac::Phy2MacEndTx(p);
 		return;
 	}
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Aloha::sendMacTxCompleted node %d time %f", 
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Aloha::sendMacTxCompleted node %d time %f", 
 				getModuleAddress(), NOW);
 	
 	Sunset_Mac::Phy2MacEndTx(p);
@@ -404,12 +404,12 @@ void Sunset_Aloha::Phy2MacTxAborted(const Packet* p) {
 	
 	if ( sid->set(getModuleAddress(), sid_id, ni) == 0 ) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Aloha::sendMacTxAbort PROVIDING INFO %s NOT DEFINED", (ni.info_name).c_str());
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Aloha::sendMacTxAbort PROVIDING INFO %s NOT DEFINED", (ni.info_name).c_str());
 		Sunset_Mac::Phy2MacTxAborted(p);
 		return;
 	}
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Aloha::sendMacTxAbort node %d time %f", 
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Aloha::sendMacTxAbort node %d time %f", 
 				getModuleAddress(), NOW);
 	
 	Sunset_Mac::Phy2MacTxAborted(p);
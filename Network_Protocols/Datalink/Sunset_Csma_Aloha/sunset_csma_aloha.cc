@@ -49,7 +49,7 @@ Sunset_Csma_Aloha::Sunset_Csma_Aloha() : mhBackoff_(this)
 	
 	DATA_SIZE += MAC_HDR_SIZE;
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Csma_Aloha::CREATED hdr %d data %d", MAC_HDR_SIZE, DATA_SIZE);
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Csma_Aloha::CREATED hdr %d data %d", MAC_HDR_SIZE, DATA_SIZE);
 }
 
 /*!
@@ -63,7 +63,7 @@ void Sunset_Csma_Aloha::transmit(Packet *p)
 	
 	if (tx_active_) { 
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Csma_Aloha::transmit but tx is already active ERROR");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Csma_Aloha::transmit but tx is already active ERROR");
 		
 		return;  //TODO: it's just to avoid exiting the simulation
 		exit(8);
@@ -93,7 +93,7 @@ void Sunset_Csma_Aloha::rx_resume()
 
 void Sunset_Csma_Aloha::backoffHandler() 
 {
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Csma_Aloha::backoffHandler pktTx_ %p ", pktTx_);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Csma_Aloha::backoffHandler pktTx_ %p ", pktTx_);
 	
 	if(pktTx_ && check_pktTx() != 0) {
 		
@@ -106,7 +106,7 @@ double Sunset_Csma_Aloha::getBackoffTime()
 {
 	double time = Random::uniform(MAX(getTxRetry(), 1) * (getMinBackoff() + macTiming->txtime(macTiming->getPktSize(DATA_SIZE+getMacHdrSize()))));
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Csma_Aloha::getBackoffTime computed time %f", time);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Csma_Aloha::getBackoffTime computed time %f", time);
 	
 	return time;
 }
@@ -133,7 +133,7 @@ void Sunset_Csma_Aloha::txDone(Packet* p)
 			
 		case MAC_SEND:
 			
-			Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Csma_Aloha::txDone DATA TRANSMITTED %p", pktTx_);
+			SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Csma_Aloha::txDone DATA TRANSMITTED %p", pktTx_);
 			
 			if (p != pktTx_ && p != 0) {
 		
@@ -171,7 +171,7 @@ void Sunset_Csma_Aloha::txDone(Packet* p)
 			break;
 			
 		default:
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Csma_Aloha::txDone DATA TRANSMITTED tx_state_ ERROR %d", tx_state_);
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Csma_Aloha::txDone DATA TRANSMITTED tx_state_ ERROR %d", tx_state_);
 
 	}	
 	
@@ -208,7 +208,7 @@ void Sunset_Csma_Aloha::txAborted(Packet* p)
 		
 		case MAC_SEND:
 		
-			Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Csma_Aloha::txAborted DATA TRANSMISSION ABORTED pktTx == 0 (%d)", pktTx_ == 0);
+			SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Csma_Aloha::txAborted DATA TRANSMISSION ABORTED pktTx == 0 (%d)", pktTx_ == 0);
 			
 			setTxState(MAC_IDLE);
 			
@@ -228,7 +228,7 @@ void Sunset_Csma_Aloha::txAborted(Packet* p)
 			break;
 			
 		default:
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Csma_Aloha::txAborted DATA TX ABORTED tx_state_ ERROR %d", tx_state_);
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Csma_Aloha::txAborted DATA TX ABORTED tx_state_ ERROR %d", tx_state_);
 	}	
 
 	if (p != 0 && removePkt) {
@@ -264,7 +264,7 @@ int Sunset_Csma_Aloha::check_pktTx() {
 	double timeout;
 	int dst, src;
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Csma_Aloha::check_pktTx");
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Csma_Aloha::check_pktTx");
 	
 	if(mhBackoff_.busy() != 0) {
 		
@@ -284,7 +284,7 @@ int Sunset_Csma_Aloha::check_pktTx() {
 		
 			if(!is_idle() || tx_active_) {
 			
-				Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Csma_Aloha::check_pktTx channel is busy backoff");
+				SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Csma_Aloha::check_pktTx channel is busy backoff");
 				
 				txAction(pktTx_, SUNSET_MAC_TX_ACTION_BUSY);
 				
@@ -298,7 +298,7 @@ int Sunset_Csma_Aloha::check_pktTx() {
 			break;
 			
 		default:
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Csma_Aloha::check_pktTx check_pktTx:Invalid MAC Control subtype ERROR");
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Csma_Aloha::check_pktTx check_pktTx:Invalid MAC Control subtype ERROR");
 			
 			return -1;
 	}
@@ -306,7 +306,7 @@ int Sunset_Csma_Aloha::check_pktTx() {
 	dst = (mh->dst);
 	src = (mh->src);
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Csma_Aloha::check_pktTx send DATA to %d timeout at %f", dst, NOW + timeout);
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Csma_Aloha::check_pktTx send DATA to %d timeout at %f", dst, NOW + timeout);
 	
 	transmit(pktTx_);
 	
@@ -330,7 +330,7 @@ void Sunset_Csma_Aloha::RetransmitDATA()
 	dst = (dh->dst);
 	src = (dh->src);
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Csma_Aloha::RetransmitDATA to %d retry %d broadcast %d", dst, tx_retry, getBroadcastAddress());
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Csma_Aloha::RetransmitDATA to %d retry %d broadcast %d", dst, tx_retry, getBroadcastAddress());
 	
 	tx_retry += 1;
 	
@@ -344,7 +344,7 @@ void Sunset_Csma_Aloha::RetransmitDATA()
 		
 		txAction(pktTx_, SUNSET_MAC_ACTION_PKT_DISCARDED);
 		
-		Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Csma_Aloha::RetransmitDATA DISCARD too many retransmissions");
+		SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Csma_Aloha::RetransmitDATA DISCARD too many retransmissions");
 		
 		discard(pktTx_);
 		
@@ -368,7 +368,7 @@ void Sunset_Csma_Aloha::RetransmitDATA()
 		struct hdr_Sunset_Mac *dh;
 		double time = getBackoffTime();
 		
-		Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Csma_Aloha::RetransmitDATA start retransmission process");
+		SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Csma_Aloha::RetransmitDATA start retransmission process");
 		
 		dh = HDR_SUNSET_MAC(pktTx_);
 		dh->dh_fc.fc_retry = 1;
@@ -380,7 +380,7 @@ void Sunset_Csma_Aloha::RetransmitDATA()
 		
 		mhBackoff_.start(time);
 		
-		Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Csma_Aloha::RetransmitDATA backoff Time %f", time);
+		SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Csma_Aloha::RetransmitDATA backoff Time %f", time);
 		
 		if (Sunset_Statistics::use_stat() && stat != NULL) {
 			
@@ -388,7 +388,7 @@ void Sunset_Csma_Aloha::RetransmitDATA()
 		}
 	}
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Csma_Aloha::RetransmitDATA to %d retry %d time %f", dst, tx_retry, NOW + mhBackoff_.expire());	
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Csma_Aloha::RetransmitDATA to %d retry %d time %f", dst, tx_retry, NOW + mhBackoff_.expire());	
 }
 
 /*!
@@ -470,7 +470,7 @@ void Sunset_Csma_Aloha::recvPkt()
 		goto done;
 	}
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Csma_Aloha::recvPkt %d->%d error %d type %d subType %d", src, dst, ch->error(), type, subtype);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Csma_Aloha::recvPkt %d->%d error %d type %d subType %d", src, dst, ch->error(), type, subtype);
 	
 	if( ch->error() ) {
 		
@@ -503,7 +503,7 @@ void Sunset_Csma_Aloha::recvPkt()
 					
 				default:
 					
-					Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Csma_Aloha::recvPkt Invalid MAC Data Subtype %x ERROR", subtype);
+					SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Csma_Aloha::recvPkt Invalid MAC Data Subtype %x ERROR", subtype);
 					
 					return;
 			}
@@ -511,13 +511,13 @@ void Sunset_Csma_Aloha::recvPkt()
 			break;
 			
 		default:
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Csma_Aloha::recvPkt Invalid MAC Type %x ERROR", subtype);
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Csma_Aloha::recvPkt Invalid MAC Type %x ERROR", subtype);
 			
 			return;
 	}
 	
 done:
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Csma_Aloha::recv_timer recv completed");
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Csma_Aloha::recv_timer recv completed");
 	pktRx_ = 0;
 	rx_resume();
 	
@@ -544,13 +544,13 @@ void Sunset_Csma_Aloha::recvDATA(Packet *p)
 	ch->size() -= getMacHdrSize();
 	ch->num_forwards() += 1;
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Csma_Aloha::recvDATAsize %d from %d to %d  timestamp %f broadcast %d", HDR_CMN(p)->size(), src, dst, HDR_CMN(p)->timestamp(), getBroadcastAddress());
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Csma_Aloha::recvDATAsize %d from %d to %d  timestamp %f broadcast %d", HDR_CMN(p)->size(), src, dst, HDR_CMN(p)->timestamp(), getBroadcastAddress());
 	
 	//it is a UNICAST pkt but I am not the destination
 	
 	if(dst != getBroadcastAddress() && dst != getModuleAddress()) {
 		
-		Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Csma_Aloha::recvDATA size %d from %d to %d  timestamp %f DISCARD", HDR_CMN(p)->size(), src, dst, HDR_CMN(p)->timestamp());
+		SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Csma_Aloha::recvDATA size %d from %d to %d  timestamp %f DISCARD", HDR_CMN(p)->size(), src, dst, HDR_CMN(p)->timestamp());
 		
 		discard(p);
 		
@@ -598,7 +598,7 @@ void Sunset_Csma_Aloha::stop()
 	
 	Sunset_Mac::stop();
 	
-	Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Csma_Aloha::stop macQueue_->length() = %d pktTx %d pktRx %d pktAck %d tx_active %d tx_state %d rx_state %d backoff %d", macQueue_->length(), pktTx_, pktRx_, tx_active_, tx_state_, rx_state_, mhBackoff_.busy() );
+	SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Csma_Aloha::stop macQueue_->length() = %d pktTx %d pktRx %d pktAck %d tx_active %d tx_state %d rx_state %d backoff %d", macQueue_->length(), pktTx_, pktRx_, tx_active_, tx_state_, rx_state_, mhBackoff_.busy() );
 	
 	return;
 }
@@ -618,14 +618,14 @@ void Sunset_Csma_Aloha::anotherTransmission()
 		
 		Packet* p2;
 		
-		Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Csma_Aloha::anotherTransmission macQueue_->length() = %d", macQueue_->length());
+		SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Csma_Aloha::anotherTransmission macQueue_->length() = %d", macQueue_->length());
 		
 		p2 = macQueue_->deque();
 		
 		send(p2);
 	}
 	else {
-		Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Csma_Aloha::anotherTransmission macQueue_->length() = 0");
+		SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Csma_Aloha::anotherTransmission macQueue_->length() = 0");
 	}
 	
 }
@@ -637,7 +637,7 @@ void Sunset_Csma_Aloha::anotherTransmission()
 
 void Sunset_Csma_Aloha::Phy2MacTxAborted(const Packet* p) 
 {
-	Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Csma_Aloha::Phy2MacTxAborted");
+	SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Csma_Aloha::Phy2MacTxAborted");
 	txAborted((Packet*)p);
 	Sunset_Utilities::eraseOnlyPkt((Packet *)p, getModuleAddress());	
 }
@@ -649,7 +649,7 @@ void Sunset_Csma_Aloha::Phy2MacTxAborted(const Packet* p)
 
 void Sunset_Csma_Aloha::Phy2MacEndTx(const Packet* p) 
 {
-	Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Csma_Aloha::Phy2MacEndTx %p %p", p, pktTx_);
+	SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Csma_Aloha::Phy2MacEndTx %p %p", p, pktTx_);
 	txDone((Packet*)p);
 	Sunset_Utilities::eraseOnlyPkt((Packet *)p, getModuleAddress());	
 }
@@ -661,12 +661,12 @@ void Sunset_Csma_Aloha::Phy2MacEndTx(const Packet* p)
 
 void Sunset_Csma_Aloha::Phy2MacStartRx(const Packet* p) 
 {
-	Sunset_Debug::debugInfo(5, getModuleAddress(),  "Sunset_Csma_Aloha::Phy2MacStartRx");
+	SUNSET_DEBUG_LOG(5, getModuleAddress(),  "Sunset_Csma_Aloha::Phy2MacStartRx");
 	setRxState(MAC_RECV);
 	
 	if (Sunset_Utilities::isSimulation()) {
 		
-		Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Csma_Aloha::Phy2MacStartRx src %d dst %d",  HDR_SUNSET_MAC(p)->src, HDR_SUNSET_MAC(p)->dst);
+		SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Csma_Aloha::Phy2MacStartRx src %d dst %d",  HDR_SUNSET_MAC(p)->src, HDR_SUNSET_MAC(p)->dst);
 	}
 }
 
@@ -688,7 +688,7 @@ void Sunset_Csma_Aloha::Phy2MacEndRx(Packet* p)
 	
 	hdr_cmn* ch = HDR_CMN(p);
 	
-	Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Csma_Aloha::Phy2MacEndRx size %d error %d src %d dst %d", ch->size(), ch->error(), HDR_SUNSET_MAC(p)->src, HDR_SUNSET_MAC(p)->dst);
+	SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Csma_Aloha::Phy2MacEndRx size %d error %d src %d dst %d", ch->size(), ch->error(), HDR_SUNSET_MAC(p)->src, HDR_SUNSET_MAC(p)->dst);
 	
 	if (ch->error()) {
 		
@@ -703,7 +703,7 @@ void Sunset_Csma_Aloha::Phy2MacEndRx(Packet* p)
 		
 		if (HDR_SUNSET_MAC(p)->dst == getModuleAddress() || HDR_SUNSET_MAC(p)->dst == getBroadcastAddress()) {
 			
-			Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Csma_Aloha::Phy2MacEndRx src %d dst %d TOO MUCH NOISE %d", HDR_SUNSET_MAC(p)->src, HDR_SUNSET_MAC(p)->dst, ch->size());
+			SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Csma_Aloha::Phy2MacEndRx src %d dst %d TOO MUCH NOISE %d", HDR_SUNSET_MAC(p)->src, HDR_SUNSET_MAC(p)->dst, ch->size());
 		}
 		
 		if (p != 0) {
@@ -718,14 +718,14 @@ void Sunset_Csma_Aloha::Phy2MacEndRx(Packet* p)
 		
 		if (HDR_SUNSET_MAC(p)->dst == getModuleAddress()  || HDR_SUNSET_MAC(p)->dst == getBroadcastAddress()) {
 		
-			Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Csma_Aloha::Phy2MacEndRx src %d dst %d CORRECT", HDR_SUNSET_MAC(p)->src, HDR_SUNSET_MAC(p)->dst);
+			SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Csma_Aloha::Phy2MacEndRx src %d dst %d CORRECT", HDR_SUNSET_MAC(p)->src, HDR_SUNSET_MAC(p)->dst);
 		}
 		
 		pktRx_ = p;
 		recvPkt();
 	}
 	
-	Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Csma_Aloha::Phy2MacEndRx EXIT");
+	SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Csma_Aloha::Phy2MacEndRx EXIT");
 }
 
 /*!
@@ -736,7 +736,7 @@ void Sunset_Csma_Aloha::Phy2MacEndRx(Packet* p)
 
 int Sunset_Csma_Aloha::notify_info(list<notified_info> linfo) 
 { 
-	Sunset_Debug::debugInfo(-1, getModuleAddress(), " Sunset_Csma_Aloha::notify_info NOTHING TO DO");
+	SUNSET_DEBUG_LOG(-1, getModuleAddress(), " Sunset_Csma_Aloha::notify_info NOTHING TO DO");
 	
 	return Sunset_Mac::notify_info(linfo); 
 } 
@@ -777,7 +777,7 @@ void Sunset_Csma_Aloha::txAction(Packet* p, mac_action_type mct)
 					break;
 				
 				default:
-					Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Csma_Aloha::txAction Invalid MAC Control Subtype %x ERROR", subtype);
+					SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Csma_Aloha::txAction Invalid MAC Control Subtype %x ERROR", subtype);
 					
 					return;
 			}
@@ -794,7 +794,7 @@ void Sunset_Csma_Aloha::txAction(Packet* p, mac_action_type mct)
 					break;
 				
 				default:
-					Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Csma_Aloha::txAction Invalid MAC Data Subtype %x ERROR", subtype);
+					SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Csma_Aloha::txAction Invalid MAC Data Subtype %x ERROR", subtype);
 					
 					return;
 			}
@@ -803,7 +803,7 @@ void Sunset_Csma_Aloha::txAction(Packet* p, mac_action_type mct)
 			
 		default:
 			
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Csma_Aloha::txAction Invalid MAC Type %x ERROR", subtype);
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Csma_Aloha::txAction Invalid MAC Type %x ERROR", subtype);
 			
 			return;
 	}
@@ -896,7 +896,7 @@ void Sunset_Csma_Aloha::rxAction(Packet* p, mac_action_type mct)
 				
 				default:
 				
-					Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Csma_Aloha::rxAction Invalid MAC Control Subtype %x ERROR", subtype);
+					SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Csma_Aloha::rxAction Invalid MAC Control Subtype %x ERROR", subtype);
 					
 					return;
 			}
@@ -914,7 +914,7 @@ void Sunset_Csma_Aloha::rxAction(Packet* p, mac_action_type mct)
 					
 				default:
 					
-					Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Csma_Aloha::rxAction Invalid MAC Data Subtype %x ERROR", subtype);
+					SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Csma_Aloha::rxAction Invalid MAC Data Subtype %x ERROR", subtype);
 					
 					return;
 			}
@@ -923,7 +923,7 @@ void Sunset_Csma_Aloha::rxAction(Packet* p, mac_action_type mct)
 			
 		default:
 			
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Csma_Aloha::rxAction Invalid MAC Type %x ERROR", subtype);
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Csma_Aloha::rxAction Invalid MAC Type %x ERROR", subtype);
 			
 			return;
 	}
@@ -46,7 +46,7 @@ void Sunset_Csma_Aloha_Backoff_Timer::pause() {
 	double rt = stime + rtime - st;
 	
 	if (busy_ == 0 || paused_) {
-		Sunset_Debug::debugInfo(-1, mac->getModuleAddress(), "Sunset_Csma_Aloha_Backoff_Timer::pauser paused ERROR");
+		SUNSET_DEBUG_LOG(-1, mac->getModuleAddress(), "Sunset_Csma_Aloha_Backoff_Timer::pauser paused ERROR");
 		//		return;  //TODO: it's just to avoid exiting the simulation
 		exit(28);
 	}
@@ -56,7 +56,7 @@ void Sunset_Csma_Aloha_Backoff_Timer::pause() {
 	
 	
 	if (rtime < 0.0) {
-		Sunset_Debug::debugInfo(-1, mac->getModuleAddress(), "Sunset_Csma_Aloha_Backoff_Timer::pause rtimer ERROR");
+		SUNSET_DEBUG_LOG(-1, mac->getModuleAddress(), "Sunset_Csma_Aloha_Backoff_Timer::pause rtimer ERROR");
 		//		return;  //TODO: it's just to avoid exiting the simulation
 		exit(28);
 	} 
@@ -69,7 +69,7 @@ void Sunset_Csma_Aloha_Backoff_Timer::resume() {
 	Scheduler& s = Scheduler::instance();
 	
 	if (busy_ == 0 || paused_ == 0) {
-		Sunset_Debug::debugInfo(-1, mac->getModuleAddress(), "Sunset_Csma_Aloha_Backoff_Timer::resume paused ERROR");
+		SUNSET_DEBUG_LOG(-1, mac->getModuleAddress(), "Sunset_Csma_Aloha_Backoff_Timer::resume paused ERROR");
 		//		return;  //TODO: it's just to avoid exiting the simulation
 		exit(28);
 	}
@@ -79,7 +79,7 @@ void Sunset_Csma_Aloha_Backoff_Timer::resume() {
 	stime = s.clock();
 	
 	if (rtime < 0.0) {
-		Sunset_Debug::debugInfo(-1, mac->getModuleAddress(), "Sunset_Csma_Aloha_Backoff_Timer::resume rtimer ERROR");
+		SUNSET_DEBUG_LOG(-1, mac->getModuleAddress(), "Sunset_Csma_Aloha_Backoff_Timer::resume rtimer ERROR");
 		//		return;  //TODO: it's just to avoid exiting the simulation
 		exit(28);
 	} 
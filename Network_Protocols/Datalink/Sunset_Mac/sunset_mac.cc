@@ -79,7 +79,7 @@ Sunset_Mac::Sunset_Mac() : macQueue_(0), macTiming(0)
 
 void Sunset_Mac::recvFromUpperLayers(Packet* p)
 {  
-	Sunset_Debug::debugInfo(5, getModuleAddress(),  "Sunset_Mac::recvFromUpperLayers");
+	SUNSET_DEBUG_LOG(5, getModuleAddress(),  "Sunset_Mac::recvFromUpperLayers");
 	
 	send(p);
 }
@@ -91,7 +91,7 @@ void Sunset_Mac::recvFromUpperLayers(Packet* p)
 
 void Sunset_Mac::Phy2MacTxAborted(const Packet* p)
 {
-	Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Mac::Phy2MacTxAborted");
+	SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Mac::Phy2MacTxAborted");
 	
 	tx_active_ = 0;
 	
@@ -126,7 +126,7 @@ void Sunset_Mac::Phy2MacTxAborted(const Packet* p)
 void Sunset_Mac::anotherTransmission() 
 {
 	
-	Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Mac::anotherTransmission");
+	SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Mac::anotherTransmission");
 }
 
 /*!
@@ -136,7 +136,7 @@ void Sunset_Mac::anotherTransmission()
 
 void Sunset_Mac::Phy2MacEndTx(const Packet* p)
 {
-	Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Mac::Phy2MacEndTx pktTx_ %p", pktTx_);
+	SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Mac::Phy2MacEndTx pktTx_ %p", pktTx_);
 	
 	tx_active_ = 0;
 	
@@ -173,7 +173,7 @@ void Sunset_Mac::Phy2MacEndTx(const Packet* p)
 
 void Sunset_Mac::Phy2MacStartRx(const Packet* p)
 {
-	Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Mac::Phy2MacStartRx");
+	SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Mac::Phy2MacStartRx");
 }
 
 /*!
@@ -201,7 +201,7 @@ void Sunset_Mac::Phy2MacEndRx(Packet* p)
 	u_int8_t type = mh->dh_fc.fc_type;
 	u_int8_t subtype = mh->dh_fc.fc_subtype;
 	
-	Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Mac::Phy2MacEndRx src %d dest %d size %d", src, dst, ch->size());
+	SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Mac::Phy2MacEndRx src %d dest %d size %d", src, dst, ch->size());
 	
 	if (ch->error()) {
 		
@@ -217,11 +217,11 @@ void Sunset_Mac::Phy2MacEndRx(Packet* p)
 
 		if (dst == getModuleAddress() || dst == Sunset_Address::getBroadcastAddress()) {
 			
-			Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Mac::Phy2MacEndRx pkt for me Error src %d dest %d", src, dst);
+			SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Mac::Phy2MacEndRx pkt for me Error src %d dest %d", src, dst);
 		}
 		else {
 			
-			Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Mac::Phy2MacEndRx pkt Error src %d dest %d", src, dst);        
+			SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Mac::Phy2MacEndRx pkt Error src %d dest %d", src, dst);        
 		}
 		
 		Sunset_Utilities::erasePkt(p, getModuleAddress());
@@ -331,7 +331,7 @@ int Sunset_Mac::command(int argc, const char*const* argv)
 		
 		if (strcmp(argv[1], "start") == 0) {
 			
-			Sunset_Debug::debugInfo(1, getModuleAddress(), "Sunset_Agent::command start Module");
+			SUNSET_DEBUG_LOG(1, getModuleAddress(), "Sunset_Agent::command start Module");
 			
 			start();
 			
@@ -342,7 +342,7 @@ int Sunset_Mac::command(int argc, const char*const* argv)
 		
 		if (strcmp(argv[1], "stop") == 0) {
 			
-			Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Agent::command stop Module");
+			SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Agent::command stop Module");
 			
 			stop();
 			
@@ -357,7 +357,7 @@ int Sunset_Mac::command(int argc, const char*const* argv)
 			
 			module_address = atoi(argv[2]);
 			
-			Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Agent::command setModuleAddress %d", getModuleAddress());
+			SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Agent::command setModuleAddress %d", getModuleAddress());
 			return TCL_OK;
 		}
 		
@@ -367,7 +367,7 @@ int Sunset_Mac::command(int argc, const char*const* argv)
 			
 			macQueue_ = (Sunset_Queue*) TclObject::lookup(argv[2]);
 			
-			Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Mac::command setQueue");
+			SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Mac::command setQueue");
 			
 			assert(macQueue_);
 			
@@ -380,7 +380,7 @@ int Sunset_Mac::command(int argc, const char*const* argv)
 			
 			macTiming = (Sunset_Timing*) TclObject::lookup(argv[2]);
 			
-			Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Mac::command setTiming");
+			SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Mac::command setTiming");
 			
 			assert(macTiming);
 			
@@ -395,7 +395,7 @@ int Sunset_Mac::command(int argc, const char*const* argv)
 			
 			module_address = atoi(argv[2]);
 			run_id = atoi(argv[3]);
-			Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Mac::command setModuleAddress %d runId %d", getModuleAddress(), getRunId());
+			SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Mac::command setModuleAddress %d runId %d", getModuleAddress(), getRunId());
 			return TCL_OK;
 		}
 	}
@@ -410,7 +410,7 @@ int Sunset_Mac::command(int argc, const char*const* argv)
 
 void Sunset_Mac::send(Packet* p) 
 {
-	Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Mac::send");
+	SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Mac::send");
 }
 
 /*!
@@ -453,7 +453,7 @@ void Sunset_Mac::createData(Packet* p)
  	ch->txtime() = macTiming->txtime(macTiming->getPktSize(p), TIMING_DATA_RATE);
 	
 	
-	Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Mac::createData Src %d Dest %d Type %d SubType %d pkt_type %d", dh->src, dh->dst, dh->dh_fc.fc_type, dh->dh_fc.fc_subtype, ch->ptype());
+	SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Mac::createData Src %d Dest %d Type %d SubType %d pkt_type %d", dh->src, dh->dst, dh->dh_fc.fc_type, dh->dh_fc.fc_subtype, ch->ptype());
 	
 	return;
 }
@@ -467,7 +467,7 @@ int Sunset_Mac::recvSyncClMsg(ClMessage* m)
 {
 	
 	/* If the data packet transmission has been aborted ... */
-	Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Mac::recvSyncClMsg mType %d", m->type());
+	SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Mac::recvSyncClMsg mType %d", m->type());
 	
 	if (m->type() == CLMSG_PHY2MAC_TXABORTED) {
 		
@@ -503,7 +503,7 @@ int Sunset_Mac::is_idle()
 	int isIdle = 1;
 	ClMsgMac2PhyGetIsIdle msg;
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Mac::is_idle() rxState %d txState %d", rx_state_, tx_state_);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Mac::is_idle() rxState %d txState %d", rx_state_, tx_state_);
 	
 	if(rx_state_ != MAC_IDLE) {
 		
@@ -520,7 +520,7 @@ int Sunset_Mac::is_idle()
 	
 	if(!isIdle) {
 		
-		Sunset_Debug::debugInfo(0, getModuleAddress(), "Sunset_Mac::is_idle() passes al check but is receiving");
+		SUNSET_DEBUG_LOG(0, getModuleAddress(), "Sunset_Mac::is_idle() passes al check but is receiving");
 		
 		return 0;
 	}
@@ -544,7 +544,7 @@ void Sunset_Mac::checkQueue(Packet* p)
 			
 			macQueue_->enque(p);
 			
-			Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Mac::checkQueue queueLength %d", macQueue_->length());
+			SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Mac::checkQueue queueLength %d", macQueue_->length());
 			
 			return;
 		}
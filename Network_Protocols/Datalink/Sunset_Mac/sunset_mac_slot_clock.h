@@ -0,0 +1,160 @@
+/* SUNSET - Sapienza University Networking framework for underwater Simulation, Emulation and real-life Testing
+ *
+ * Copyright (C) 2012 Regents of UWSN Group of SENSES Lab <http://reti.dsi.uniroma1.it/SENSES_lab/>
+ *
+ * Author: Roberto Petroccia - petroccia@di.uniroma1.it
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License as published
+ * at http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANATBILITY or FITNESS FOR A PARTICULAR PURPOSE. See the Creative Commons
+ * Attribution-NonCommercial-ShareAlike 3.0 Unported License for more details.
+ *
+ * You should have received a copy of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License
+ * along with this program. If not, see <http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode>.
+ */
+
+
+#ifndef __Sunset_Mac_Slot_Clock_h__
+#define __Sunset_Mac_Slot_Clock_h__
+
+#include <math.h>
+
+/*! @brief This class keeps track of the slot boundaries of a slotted MAC without scheduling an event for each slot.
+ *  The boundaries are computed exactly as a slot timer restarted at every boundary would do (each boundary is the previous 
+ *  one plus the slot time), so a MAC waking up only for the slots where it has something to do sees the same slot times 
+ *  and slot counts. Boundary k is the k-th boundary after start (k = 0 is the first one).
+ */
+
+class Sunset_Mac_Slot_Clock {
+	
+public:
+	
+	Sunset_Mac_Slot_Clock() 
+	{ 
+		next_ = 0.0; 
+		slotTime_ = 0.0; 
+		count_ = 0; 
+		running_ = false; 
+	}
+	
+	/*! @brief The start function sets the first boundary "firstDelay" seconds after "now", the following ones every "slotTime" seconds. */
+	
+	void start(double now, double firstDelay, double slotTime)
+	{
+		next_ = now + firstDelay;
+		slotTime_ = slotTime;
+		count_ = 0;
+		running_ = slotTime > 0.0;
+	}
+	
+	void stop() { running_ = false; }
+	bool isRunning() { return running_; }
+	
+	/*! @brief The advance function moves the clock over the boundaries before "now" and returns their number. */
+	
+	int advance(double now)
+	{
+		int n = 0;
+		
+		while ( running_ && next_ < now ) {
+			
+			next_ = next_ + slotTime_;
+			count_++;
+			n++;
+		}
+		
+		return n;
+	}
+	
+	/*! @brief The advanceTo function moves the clock over the boundaries up to "now" included and returns their number. 
+	 *  It is used by the slot handler, the last boundary is the current slot.
+	 */
+	
+	int advanceTo(double now)
+	{
+		int n = 0;
+		
+		while ( running_ && next_ <= now ) {
+			
+			next_ = next_ + slotTime_;
+			count_++;
+			n++;
+		}
+		
+		return n;
+	}
+	
+	/*! @brief The update function moves the clock to "now" outside the slot handler. A boundary equal to "now" counts as passed, 
+	 *  as if its slot handler had already been executed, unless the slot timer is still pending on it ("pending" true): the slot 
+	 *  handler is then going to handle that slot.
+	 */
+	
+	int update(double now, bool pending)
+	{
+		if ( pending ) {
+			
+			return advance(now);
+		}
+		
+		return advanceTo(now);
+	}
+	
+	/*! @brief The getCount function returns the index of the next boundary, i.e. the number of boundaries already passed. */
+	long getCount() { return count_; }
+	
+	/*! @brief The getNext function returns the time of the next boundary. */
+	double getNext() { return next_; }
+	
+	/*! @brief The getBoundary function returns the time of boundary k, k has to be greater or equal to getCount(). */
+	
+	double getBoundary(long k)
+	{
+		double t = next_;
+		
+		for ( long i = count_; i < k; i++ ) {
+			
+			t = t + slotTime_;
+		}
+		
+		return t;
+	}
+	
+	/*! @brief The getNextInFrame function returns the first boundary from k (included) starting slot "slot" of a frame of "slotPerFrame" slots. */
+	
+	static long getNextInFrame(long k, int slot, int slotPerFrame)
+	{
+		return k + (slot - (int)(k % slotPerFrame) + slotPerFrame) % slotPerFrame;
+	}
+	
+	/*! @brief The getDelay function returns the delay d such that now + d is exactly t, the timer then expires on the boundary. */
+	
+	static double getDelay(double now, double t)
+	{
+		double d = t - now;
+		
+		while ( now + d < t ) {
+			
+			d = nextafter(d, HUGE_VAL);
+		}
+		
+		while ( now + d > t ) {
+			
+			d = nextafter(d, -HUGE_VAL);
+		}
+		
+		return d;
+	}
+	
+private:
+	
+	double next_;		// time of the next boundary
+	double slotTime_;
+	long count_;		// number of boundaries passed
+	bool running_;
+};
+
+#endif
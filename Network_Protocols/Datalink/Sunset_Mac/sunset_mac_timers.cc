@@ -33,7 +33,7 @@ void Sunset_Mac_Timer::start(double time)
 	
 	if (busy()) {
 		
-		Sunset_Debug::debugInfo(-1, mac->addr(), "Sunset_Mac_Timer::start timer busy ERROR");
+		SUNSET_DEBUG_LOG(-1, mac->addr(), "Sunset_Mac_Timer::start timer busy ERROR");
 		
 		if (rtime - stime > time) {
 			
@@ -11,6 +11,7 @@ Module/MMac/Sunset_Slotted_Csma set ACK_SIZE	32\n\
 Module/MMac/Sunset_Slotted_Csma set DATA_SIZE	32\n\
 Module/MMac/Sunset_Slotted_Csma set use_ack_	0\n\
 Module/MMac/Sunset_Slotted_Csma set slotTime_ 0.0\n\
+Module/MMac/Sunset_Slotted_Csma set skipIdleSlots_	1\n\
 ";
 #include "tclcl.h"
 EmbeddedTcl Sunset_Slotted_Csma_TclCode(code);
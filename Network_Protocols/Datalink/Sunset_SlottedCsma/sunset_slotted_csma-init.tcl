@@ -12,3 +12,4 @@ Module/MMac/Sunset_Slotted_Csma set ACK_SIZE	32
 Module/MMac/Sunset_Slotted_Csma set DATA_SIZE	32
 Module/MMac/Sunset_Slotted_Csma set use_ack_	0
 Module/MMac/Sunset_Slotted_Csma set slotTime_ 0.0
+Module/MMac/Sunset_Slotted_Csma set skipIdleSlots_	1
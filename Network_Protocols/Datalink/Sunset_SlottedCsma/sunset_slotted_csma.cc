@@ -51,6 +51,9 @@ Sunset_SlottedCsma::Sunset_SlottedCsma() :  mhSend_(this), mhDefer_(this), mhSlo
 	longRetryLimit = 0;
 	
 	slotTime_ = 0.0;
+	slotWake_ = 0.0;
+	backoffSlotIndex_ = 0;
+	skipIdleSlots_ = 1;
 	
 	// Get variables initialization from the Tcl script
 	bind("use_ack_", &use_ack);
@@ -58,13 +61,14 @@ Sunset_SlottedCsma::Sunset_SlottedCsma() :  mhSend_(this), mhDefer_(this), mhSlo
 	bind("ACK_SIZE", &ACK_SIZE);
 	bind("DATA_SIZE", &DATA_SIZE);
 	bind("slotTime_", &slotTime_);
+	bind("skipIdleSlots_", &skipIdleSlots_);
 	
 	distanceToNode.clear();
 	timeSentToNode.clear();
 	roundTripTime.clear();
 	backoffSlotCount = 0;
 	
-	Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_SlottedCsma::CREATED");
+	SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_SlottedCsma::CREATED");
 }
 
 /*!
@@ -92,7 +96,7 @@ void Sunset_SlottedCsma::transmit(Packet *p)
 	
 	if (tx_active_) { // if another transmission is on going return
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_SlottedCsma::transmit but tx already active ERROR");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_SlottedCsma::transmit but tx already active ERROR");
 		return;
 	}
 	
@@ -104,7 +108,7 @@ void Sunset_SlottedCsma::transmit(Packet *p)
 	
 	if (mhSend_.busy()) {   // if tx timer is running stop it
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_SlottedCsma::transmit timeout mhSend busy ERROR");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_SlottedCsma::transmit timeout mhSend busy ERROR");
 		mhSend_.stop();
 	}
 	
@@ -121,7 +125,7 @@ void Sunset_SlottedCsma::transmit(Packet *p)
 	+ macTiming->getMaxPropagationDelay()
 	+ macTiming->txtime(pkt_size, rate);
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_SlottedCsma::transmit timeout %f size %d", newTimeout, HDR_CMN(p)->size());
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_SlottedCsma::transmit timeout %f size %d", newTimeout, HDR_CMN(p)->size());
 	
 	mhSend_.start(newTimeout);
 }
@@ -143,7 +147,7 @@ void Sunset_SlottedCsma::rx_resume()
 
 void Sunset_SlottedCsma::deferHandler() 
 {
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_SlottedCsma::deferHandler pktACK_ %d pktTx_ %d ", pktACK_, pktTx_);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_SlottedCsma::deferHandler pktACK_ %d pktTx_ %d ", pktACK_, pktTx_);
 	
 	if (!use_ack) {
 		
@@ -152,7 +156,7 @@ void Sunset_SlottedCsma::deferHandler()
 	
 	if (use_ack && check_pktACK() != 0) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_SlottedCsma::deferHandler but no ACK pkt ERROR");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_SlottedCsma::deferHandler but no ACK pkt ERROR");
 		return;
 	}
 }
@@ -176,7 +180,7 @@ int Sunset_SlottedCsma::getBackoffSlotCount()
 	
 	count = Random::uniform(MAX(getTxRetry(), 1));
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_SlottedCsma::getBackoffSlotCount computed count %d", count);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_SlottedCsma::getBackoffSlotCount computed count %d", count);
 	
 	return count;
 }
@@ -208,11 +212,11 @@ void Sunset_SlottedCsma::txDone(Packet* p)
 			
 		case MAC_ACK:
 			
-			Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_SlottedCsma::txDone ACK transmitted");
+			SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_SlottedCsma::txDone ACK transmitted");
 			
 			if (!use_ack) {
 				
-				Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_SlottedCsma::txDone but we are not using ACK pkt ERROR");
+				SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_SlottedCsma::txDone but we are not using ACK pkt ERROR");
 				return;	
 			}
 			
@@ -242,7 +246,7 @@ void Sunset_SlottedCsma::txDone(Packet* p)
 			
 			// A DATA packet has been correctly transmitted
 			
-			Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_SlottedCsma::txDone DATA transmitted %p", pktTx_);
+			SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_SlottedCsma::txDone DATA transmitted %p", pktTx_);
 			
 			if (pktTx_ != 0) {
 				
@@ -281,7 +285,7 @@ void Sunset_SlottedCsma::txDone(Packet* p)
 					//compute the timeout for the ACK packet
 					double timeout = getTimeout(pktTx_);
 					
-					Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_SlottedCsma::txDone timeout at %f pktSize %d", NOW + timeout, HDR_CMN(pktTx_)->size());
+					SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_SlottedCsma::txDone timeout at %f pktSize %d", NOW + timeout, HDR_CMN(pktTx_)->size());
 					
 					// start the timer
 					mhSend_.start(timeout);	
@@ -291,7 +295,7 @@ void Sunset_SlottedCsma::txDone(Packet* p)
 			break;
 			
 		default:
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_SlottedCsma::txDone tx_state_ ERROR %d", tx_state_);
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_SlottedCsma::txDone tx_state_ ERROR %d", tx_state_);
 	}	
 	
 	Sunset_Utilities::eraseOnlyPkt(p, getModuleAddress());
@@ -327,11 +331,11 @@ void Sunset_SlottedCsma::txAborted(Packet* p) {
 			
 			// ERROR on an ACK packet transmission
 			
-			Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_SlottedCsma::txAborted ACK tranmission ABORTED");
+			SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_SlottedCsma::txAborted ACK tranmission ABORTED");
 			
 			if (!use_ack) {
 				
-				Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_SlottedCsma::txAborted but we are not using ACK pkt ERROR");
+				SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_SlottedCsma::txAborted but we are not using ACK pkt ERROR");
 				
 				Sunset_Utilities::eraseOnlyPkt(p, getModuleAddress());
 				
@@ -362,7 +366,7 @@ void Sunset_SlottedCsma::txAborted(Packet* p) {
 			
 			// ERROR on an DATA packet transmission
 			
-			Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_SlottedCsma::txAborted DATA transmission ABORTED pktTx == 0 (%d)", pktTx_ == 0);
+			SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_SlottedCsma::txAborted DATA transmission ABORTED pktTx == 0 (%d)", pktTx_ == 0);
 			
 			setTxState(MAC_IDLE);
 			
@@ -377,7 +381,7 @@ void Sunset_SlottedCsma::txAborted(Packet* p) {
 			break;
 			
 		default:
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_SlottedCsma::txAborted tx_state_ ERROR %d", tx_state_);
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_SlottedCsma::txAborted tx_state_ ERROR %d", tx_state_);
 	}
 	
 	Sunset_Utilities::eraseOnlyPkt(p, getModuleAddress());
@@ -391,7 +395,7 @@ void Sunset_SlottedCsma::txAborted(Packet* p) {
 
 void Sunset_SlottedCsma::send_timer() 
 {
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "unset_SlottedCsma::send_timer  pktACK_ %d pktTx_ %d tx_state %d", pktACK_, pktTx_, tx_state_);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "unset_SlottedCsma::send_timer  pktACK_ %d pktTx_ %d tx_state %d", pktACK_, pktTx_, tx_state_);
 	
 	if (tx_active_) {   // if the transmission is active no txDone message has been received
 		
@@ -424,7 +428,7 @@ void Sunset_SlottedCsma::send_timer()
 			
 			if (!use_ack) {
 				
-				Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_SlottedCsma::send_timer but we are not using ACK pkt ERROR");
+				SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_SlottedCsma::send_timer but we are not using ACK pkt ERROR");
 				break;	
 			}
 			
@@ -467,7 +471,7 @@ double Sunset_SlottedCsma::getTimeout(Packet* p)
 	dst = (mh->dst);
 	src = (mh->src);
 	
-	Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_SlottedCsma::getTimeout src %d dst %d type %d subType %d", src, dst, mh->dh_fc.fc_type, mh->dh_fc.fc_subtype);
+	SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_SlottedCsma::getTimeout src %d dst %d type %d subType %d", src, dst, mh->dh_fc.fc_type, mh->dh_fc.fc_subtype);
 	
 	if (mh->dh_fc.fc_type == SUNSET_MAC_Type_Control) {
 		
@@ -478,7 +482,7 @@ double Sunset_SlottedCsma::getTimeout(Packet* p)
 				/* if the packet type is ACK ... */	
 				
 				if (!use_ack) {
-					Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_SlottedCsma::getTimeout but we are not using ACK pkt ERROR");
+					SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_SlottedCsma::getTimeout but we are not using ACK pkt ERROR");
 					
 					return 10.0;
 				}
@@ -486,12 +490,12 @@ double Sunset_SlottedCsma::getTimeout(Packet* p)
 				// There is no need to wait after ACK packet transmission
 				timeout = 0.0; 
 				
-				Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_SlottedCsma::getTimeout send ACK to %d timeout at %f", dst, NOW + timeout);
+				SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_SlottedCsma::getTimeout send ACK to %d timeout at %f", dst, NOW + timeout);
 				
 				return timeout;
 				
 			default:
-				Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_SlottedCsma::getTimeout SubTypeCtrl ERROR %d", mh->dh_fc.fc_subtype);
+				SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_SlottedCsma::getTimeout SubTypeCtrl ERROR %d", mh->dh_fc.fc_subtype);
 				
 				return 10.0;
 		}
@@ -520,17 +524,17 @@ double Sunset_SlottedCsma::getTimeout(Packet* p)
 				timeout = 0.001;
 			}
 			
-			Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_SlottedCsma::getTimeout propagation %f time %f dDelay %f mDelay %f tTime %f maxPropDelay %f ACK_SIZE %d DATA_SIZE %d", macTiming->getMaxPropagationDelay(), macTiming->txtime(pkt_ack_size), macTiming->getDeviceDelay(), macTiming->getModemDelay(), macTiming->transfertTime(pkt_ack_size), getPropagationDelay(mh->dst), pkt_ack_size, macTiming->getPktSize(getDATA_Size()));
+			SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_SlottedCsma::getTimeout propagation %f time %f dDelay %f mDelay %f tTime %f maxPropDelay %f ACK_SIZE %d DATA_SIZE %d", macTiming->getMaxPropagationDelay(), macTiming->txtime(pkt_ack_size), macTiming->getDeviceDelay(), macTiming->getModemDelay(), macTiming->transfertTime(pkt_ack_size), getPropagationDelay(mh->dst), pkt_ack_size, macTiming->getPktSize(getDATA_Size()));
 		}
 		else {
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_SlottedCsma::getTimeout SubTypeData ERROR %d", mh->dh_fc.fc_subtype);
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_SlottedCsma::getTimeout SubTypeData ERROR %d", mh->dh_fc.fc_subtype);
 			
 			return 10.0;
 		}
 	}
 	else {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_SlottedCsma::getTimeout Type ERROR %d", mh->dh_fc.fc_type);
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_SlottedCsma::getTimeout Type ERROR %d", mh->dh_fc.fc_type);
 		
 		return 10.0;
 	}
@@ -538,15 +542,15 @@ double Sunset_SlottedCsma::getTimeout(Packet* p)
 	// if timeout is longer than slot time, the time needed for the communication requires more than one slot and this is not allowed
 	if (timeout > getSlotTime()) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_SlottedCsma::getTimeout %f slotTime %f ERROR", timeout, getSlotTime());
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_SlottedCsma::getTimeout %f slotTime %f ERROR", timeout, getSlotTime());
 		
 		return 10.0;
 	}
 	
 	// if timeout is longer than the remaining time for the current slot, the time needed for the communication requires more than one slot and this is not allowed
-	if (timeout > mhSlot_.expire()) {
+	if (timeout > getSlotRemaining()) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_SlottedCsma::getTimeout %f slotTime expire %f ERROR", timeout, mhSlot_.expire());
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_SlottedCsma::getTimeout %f slotTime expire %f ERROR", timeout, getSlotRemaining());
 		
 		return 10.0;
 	}
@@ -567,7 +571,7 @@ int Sunset_SlottedCsma::check_pktACK()
 	
 	if (!use_ack) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_SlottedCsma::check_pktACK but we are not using ACK pkt ERROR");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_SlottedCsma::check_pktACK but we are not using ACK pkt ERROR");
 		
 		return -1;
 	}
@@ -609,7 +613,7 @@ int Sunset_SlottedCsma::check_pktTx() {
 	struct hdr_Sunset_Mac *mh;
 	int dst, src;
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_SlottedCsma::check_pktTx entering ...");
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_SlottedCsma::check_pktTx entering ...");
 	
 	if(pktTx_ == 0) {
 		
@@ -624,7 +628,7 @@ int Sunset_SlottedCsma::check_pktTx() {
 			
 			if(!is_idle() || mhDefer_.busy() || mhSend_.busy() || tx_active_ || pktACK_) {
 				
-				Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_SlottedCsma::check_pktTx channel is busy");
+				SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_SlottedCsma::check_pktTx channel is busy");
 				
 				txAction(pktTx_, SUNSET_MAC_TX_ACTION_BUSY);
 				
@@ -638,7 +642,7 @@ int Sunset_SlottedCsma::check_pktTx() {
 			break;
 			
 		default:
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_SlottedCsma::check_pktTx check_pktTx:Invalid MAC Control subtype ERROR");
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_SlottedCsma::check_pktTx check_pktTx:Invalid MAC Control subtype ERROR");
 			
 			return -1;
 	}
@@ -666,13 +670,13 @@ void Sunset_SlottedCsma::createACK(int dst)
 	
 	if (pktACK_ != 0) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_SlottedCsma::createACK but pktACK_ is not zero ERROR");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_SlottedCsma::createACK but pktACK_ is not zero ERROR");
 		return;
 	}
 	
 	if (!use_ack) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_SlottedCsma::createACK but we are not using ACK pkt ERROR");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_SlottedCsma::createACK but we are not using ACK pkt ERROR");
 		return;
 	}
 	
@@ -702,7 +706,7 @@ void Sunset_SlottedCsma::createACK(int dst)
 	
 	SUNSET_HDR_CMN(p)->response = 1;
 
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_SlottedCsma::createACK size %d rate %d", ch->size(), TIMING_CTRL_RATE);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_SlottedCsma::createACK size %d rate %d", ch->size(), TIMING_CTRL_RATE);
 	
 	/* store ack tx time */
  	
@@ -710,7 +714,7 @@ void Sunset_SlottedCsma::createACK(int dst)
 	
 	HDR_CMN(p)->timestamp() = Sunset_Utilities::getRealTime();
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_SlottedCsma::createACK txTime %f timeStamp %f", ch->txtime(), HDR_CMN(p)->timestamp());
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_SlottedCsma::createACK txTime %f timeStamp %f", ch->txtime(), HDR_CMN(p)->timestamp());
 	
 	/* calculate ack duration */
 	
@@ -720,12 +724,12 @@ void Sunset_SlottedCsma::createACK(int dst)
 	
 	if (mhDefer_.busy() != 0) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_SlottedCsma::createACK has to send ACK pkt to node:%d but timer is running ERROR", dst);
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_SlottedCsma::createACK has to send ACK pkt to node:%d but timer is running ERROR", dst);
 		
 		return;
 	}
 	
-	Sunset_Debug::debugInfo(1, getModuleAddress(), "Sunset_SlottedCsma::createACK node:%d to node:%d time %f pType %d", getModuleAddress(), dst, HDR_CMN(p)->timestamp(), (u_int8_t)ch->ptype());
+	SUNSET_DEBUG_LOG(1, getModuleAddress(), "Sunset_SlottedCsma::createACK node:%d to node:%d time %f pType %d", getModuleAddress(), dst, HDR_CMN(p)->timestamp(), (u_int8_t)ch->ptype());
 }
 
 
@@ -743,6 +747,8 @@ void Sunset_SlottedCsma::RetransmitDATA()
 		return;
 	}
 	
+	syncBackoff(false); // the back off counter is going to be updated
+	
 	dh = HDR_SUNSET_MAC(pktTx_);
 	
 	setTxState(MAC_IDLE);
@@ -750,7 +756,7 @@ void Sunset_SlottedCsma::RetransmitDATA()
 	dst = (dh->dst);
 	src = (dh->src);
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_SlottedCsma::RetransmitDATA to %d retry %d", dst, tx_retry);
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_SlottedCsma::RetransmitDATA to %d retry %d", dst, tx_retry);
 	
 	tx_retry += 1;
 	
@@ -762,7 +768,7 @@ void Sunset_SlottedCsma::RetransmitDATA()
 		
 		hdr_cmn *ch = HDR_CMN(pktTx_);
 		
-		Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_SlottedCsma::RetransmitDATA DISCARD too many retransmissions");
+		SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_SlottedCsma::RetransmitDATA DISCARD too many retransmissions");
 		
 		Packet* aux = pktTx_->copy();
 		
@@ -789,7 +795,7 @@ void Sunset_SlottedCsma::RetransmitDATA()
 		
 		struct hdr_Sunset_Mac *dh;
 		
-		Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_SlottedCsma::RetransmitDATA start retransmission process");
+		SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_SlottedCsma::RetransmitDATA start retransmission process");
 		
 		dh = HDR_SUNSET_MAC(pktTx_);
 		dh->dh_fc.fc_retry = 1;
@@ -797,7 +803,7 @@ void Sunset_SlottedCsma::RetransmitDATA()
 		// compute the number of slots to back off
 		backoffSlotCount = getBackoffSlotCount();
 		
-		Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_SlottedCsma::RetransmitDATA backoff Time %f backoffSlotCount %d", backoffSlotCount * getSlotTime(), backoffSlotCount);
+		SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_SlottedCsma::RetransmitDATA backoff Time %f backoffSlotCount %d", backoffSlotCount * getSlotTime(), backoffSlotCount);
 		
 		if (Sunset_Statistics::use_stat() && stat != NULL) {
 			
@@ -805,7 +811,9 @@ void Sunset_SlottedCsma::RetransmitDATA()
 		}
 	}
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_SlottedCsma::RetransmitDATA to %d retry %d count %d", dst, tx_retry, backoffSlotCount);
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_SlottedCsma::RetransmitDATA to %d retry %d count %d", dst, tx_retry, backoffSlotCount);
+	
+	armSlotTimer(); // wake up when the back off is over
 }
 
 
@@ -816,7 +824,7 @@ void Sunset_SlottedCsma::RetransmitDATA()
 
 void Sunset_SlottedCsma::send(Packet *p) 
 {
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_SlottedCsma::send size %d", HDR_CMN(p)->size());
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_SlottedCsma::send size %d", HDR_CMN(p)->size());
 	
 	if (pktTx_ != 0) {
 		
@@ -829,6 +837,8 @@ void Sunset_SlottedCsma::send(Packet *p)
 	}
 	
 	pktTx_ = p;
+	
+	armSlotTimer(); // a packet is waiting, wake up when the back off is over
 }
 
 /*!
@@ -838,24 +848,24 @@ void Sunset_SlottedCsma::send(Packet *p)
 void Sunset_SlottedCsma::slotHandler() 
 {
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_SlottedCsma::slotHandler %f backoffSlotCount %d", getSlotTime(), backoffSlotCount);
+	syncBackoff(true); // account the slots skipped before the current one
+	
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_SlottedCsma::slotHandler %f backoffSlotCount %d", getSlotTime(), backoffSlotCount);
 	
 	if (pktTx_ == 0) { // check if there is no data packet waiting to be transmitted
 		
-		mhSlot_.start(getSlotTime());
-		
 		if(backoffSlotCount != 0) {  // check if back off is running and decrease the number of back off slots
 		  	
 		  	backoffSlotCount--;
 		}
 		
+		armSlotTimer();
+		
 		return;
 	}
 	
 	// A data packet is waiting to be transmitted
 	
-	mhSlot_.start(getSlotTime());
-    	
 	if (backoffSlotCount <= 0) { // no back off currently running
 		
 		if (is_idle()) {
@@ -883,6 +893,102 @@ void Sunset_SlottedCsma::slotHandler()
 		
 		backoffSlotCount--; // decrease the number of back off slots
 	}
+	
+	armSlotTimer();
+}
+
+/*!
+ * 	@brief The syncBackoff() function decreases the back off counter for the slots skipped since its last update. In the 
+ *	skipped slots the slot handler would only have decreased the back off counter (if greater than 0), with or without 
+ *	a data packet waiting to be transmitted.
+ *	@param current True if called by the slot handler, the current slot is then handled by the slot handler itself.
+ */
+
+void Sunset_SlottedCsma::syncBackoff(bool current) 
+{
+	long skipped = 0;
+	
+	if (current) {
+		
+		slotClock_.advanceTo(NOW);
+		skipped = slotClock_.getCount() - 1 - backoffSlotIndex_;
+	}
+	else {
+		
+		slotClock_.update(NOW, mhSlot_.busy() && slotWake_ <= NOW); // a boundary at NOW already skipped is accounted
+		skipped = slotClock_.getCount() - backoffSlotIndex_;
+	}
+	
+	if (skipped > 0 && backoffSlotCount > 0) {
+		
+		backoffSlotCount = (skipped >= backoffSlotCount) ? 0 : backoffSlotCount - skipped;
+	}
+	
+	backoffSlotIndex_ = slotClock_.getCount();
+}
+
+/*!
+ * 	@brief The armSlotTimer() function schedules the slot timer on the first slot where the data packet waiting to be 
+ *	transmitted can be sent, i.e. when the back off is over. If no packet is waiting the timer is not scheduled. If skipIdleSlots_ 
+ *	is not set the timer is scheduled at every slot.
+ */
+
+void Sunset_SlottedCsma::armSlotTimer() 
+{
+	long next = 0;
+	double wake = 0.0;
+	
+	if (!slotClock_.isRunning()) {
+		
+		return;
+	}
+	
+	syncBackoff(false);
+	
+	next = slotClock_.getCount();
+	
+	if (skipIdleSlots_) {
+		
+		if (pktTx_ == 0) { // nothing to do in the next slots
+			
+			if (mhSlot_.busy()) {
+				
+				mhSlot_.stop();
+			}
+			
+			return;
+		}
+		
+		next += MAX(backoffSlotCount, 0);
+	}
+	
+	wake = slotClock_.getBoundary(next);
+	
+	if (mhSlot_.busy()) {
+		
+		if (slotWake_ == wake) {
+			
+			return;
+		}
+		
+		mhSlot_.stop();
+	}
+	
+	SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_SlottedCsma::armSlotTimer slot %ld at %f", next, wake);
+	
+	slotWake_ = wake;
+	mhSlot_.start(Sunset_Mac_Slot_Clock::getDelay(NOW, wake));
+}
+
+/*!
+ *  @brief The getSlotRemaining() function returns the time remaining before the end of the current slot.
+ */
+
+double Sunset_SlottedCsma::getSlotRemaining() 
+{
+	slotClock_.update(NOW, mhSlot_.busy() && slotWake_ <= NOW);
+	
+	return slotClock_.getNext() - NOW;
 }
 
 /*!
@@ -919,7 +1025,7 @@ void Sunset_SlottedCsma::recvPkt()
 		goto done;
 	}
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_SlottedCsma::recvPkt recv_timer %d->%d", src, dst);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_SlottedCsma::recvPkt recv_timer %d->%d", src, dst);
 	
 	if( ch->error() ) {  // packet received with error discard it
 		
@@ -957,7 +1063,7 @@ void Sunset_SlottedCsma::recvPkt()
 					break;
 					
 				default:
-					Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_SlottedCsma::recvPkt Invalid MAC Control Subtype %x ERROR", subtype);
+					SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_SlottedCsma::recvPkt Invalid MAC Control Subtype %x ERROR", subtype);
 					
 					return;
 			}
@@ -975,7 +1081,7 @@ void Sunset_SlottedCsma::recvPkt()
 					break;
 					
 				default:
-					Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_SlottedCsma::recvPkt Invalid MAC Data Subtype %x ERROR", subtype);
+					SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_SlottedCsma::recvPkt Invalid MAC Data Subtype %x ERROR", subtype);
 					
 					return;
 			}
@@ -983,7 +1089,7 @@ void Sunset_SlottedCsma::recvPkt()
 			break;
 			
 		default:
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_SlottedCsma::recvPkt Invalid MAC Type %x ERROR", subtype);
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_SlottedCsma::recvPkt Invalid MAC Type %x ERROR", subtype);
 			return;
 	}
 	
@@ -1014,7 +1120,7 @@ void Sunset_SlottedCsma::recvDATA(Packet *p)
 	ch->size() -= getMacHdrSize();
 	ch->num_forwards() += 1;
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_SlottedCsma::recvDATA from %d to %d size %d timestamp %f", src, dst, ch->size(), HDR_CMN(p)->timestamp());
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_SlottedCsma::recvDATA from %d to %d size %d timestamp %f", src, dst, ch->size(), HDR_CMN(p)->timestamp());
 	
 	/* it is a UNICAST pkt but I am not the destination */
 	
@@ -1037,7 +1143,7 @@ void Sunset_SlottedCsma::recvDATA(Packet *p)
 		
 		if (!mhSend_.busy() && !tx_active_) {
 			
-			Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_SlottedCsma::recvDATA from %d to %d  createACK", src, dst);
+			SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_SlottedCsma::recvDATA from %d to %d  createACK", src, dst);
 			
 			// packet for me prepare an ACK packet in response
 			createACK(src);
@@ -1045,7 +1151,7 @@ void Sunset_SlottedCsma::recvDATA(Packet *p)
 		}
 		else {
 			
-			Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_SlottedCsma::recvDATA from %d to %d  createACK mhSend %d tx_Active %d ERROR", src, dst, mhSend_.busy(), tx_active_);
+			SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_SlottedCsma::recvDATA from %d to %d  createACK mhSend %d tx_Active %d ERROR", src, dst, mhSend_.busy(), tx_active_);
 			
 			return;
 		}
@@ -1093,7 +1199,7 @@ void Sunset_SlottedCsma::recvACK(Packet *p)
 	dst = (dh->dst);
 	src = (dh->src);
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_SlottedCsma::recvACK from %d to %d", src, dst);
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_SlottedCsma::recvACK from %d to %d", src, dst);
 	
 	// ACK packet is not for me
 	if (dst != getModuleAddress()) {
@@ -1112,7 +1218,7 @@ void Sunset_SlottedCsma::recvACK(Packet *p)
 	
 	if (pktTx_ == 0) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_SlottedCsma::recvACK from %d but no pktTx is present ERROR", src);
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_SlottedCsma::recvACK from %d but no pktTx is present ERROR", src);
 		
 		discard(p);
 		
@@ -1171,8 +1277,8 @@ void Sunset_SlottedCsma::recvACK(Packet *p)
 	
 	discard(p);
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_SlottedCsma::recvACK recvACK");
-	Sunset_Debug::debugInfo(0, getModuleAddress(), "Sunset_SlottedCsma::recvACK Transmission COMPLETED to %d", src);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_SlottedCsma::recvACK recvACK");
+	SUNSET_DEBUG_LOG(0, getModuleAddress(), "Sunset_SlottedCsma::recvACK Transmission COMPLETED to %d", src);
 	
 	// reset tx status
 	setTxState(MAC_IDLE);
@@ -1218,11 +1324,14 @@ void Sunset_SlottedCsma::start()
 		}
 	}
 	
-	Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_SlottedCsma::start slotTime %f", getSlotTime());
+	SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_SlottedCsma::start slotTime %f", getSlotTime());
 	
 	aux = Random::uniform((5 + getModuleAddress())%10);
 	
-	mhSlot_.start(aux + getSlotTime());
+	slotClock_.start(NOW, aux + getSlotTime(), getSlotTime());
+	backoffSlotIndex_ = 0;
+	
+	armSlotTimer();
 	
 	// register this mac to the information dispatcher
 	if (sid != NULL) {
@@ -1241,7 +1350,10 @@ void Sunset_SlottedCsma::stop()
 {   
 	Sunset_Mac::stop(); // call the stop function of Sunset_Mac
 	
-	Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_SlottedCsma::stop macQueue_->length() = %d pktTx %d pktRx %d pktAck %d tx_active %d tx_state %d rx_state %d backoff %d", macQueue_->length(), pktTx_, pktRx_, pktACK_, tx_active_, tx_state_, rx_state_, backoffSlotCount);
+	syncBackoff(false);
+	slotClock_.stop();
+	
+	SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_SlottedCsma::stop macQueue_->length() = %d pktTx %d pktRx %d pktAck %d tx_active %d tx_state %d rx_state %d backoff %d", macQueue_->length(), pktTx_, pktRx_, pktACK_, tx_active_, tx_state_, rx_state_, backoffSlotCount);
 	
 	if (mhSlot_.busy()) {
 		
@@ -1266,14 +1378,14 @@ void Sunset_SlottedCsma::anotherTransmission()
 		
 		Packet* p2;
 		
-		Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_SlottedCsma::anotherTransmission macQueue_->length() = %d", macQueue_->length());
+		SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_SlottedCsma::anotherTransmission macQueue_->length() = %d", macQueue_->length());
 		
 		p2 = macQueue_->deque();
 		
 		send(p2);
 	}
 	else {
-		Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_SlottedCsma::anotherTransmission macQueue_->length() = 0");
+		SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_SlottedCsma::anotherTransmission macQueue_->length() = 0");
    	}
 }
 
@@ -1284,7 +1396,7 @@ void Sunset_SlottedCsma::anotherTransmission()
 
 void Sunset_SlottedCsma::Phy2MacTxAborted(const Packet* p) 
 {
-	Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_SlottedCsma::Phy2MacTxAborted");
+	SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_SlottedCsma::Phy2MacTxAborted");
 	txAborted((Packet*)p);
 //	Sunset_Utilities::eraseOnlyPkt((Packet *)p, getModuleAddress());
 }
@@ -1296,7 +1408,7 @@ void Sunset_SlottedCsma::Phy2MacTxAborted(const Packet* p)
 
 void Sunset_SlottedCsma::Phy2MacEndTx(const Packet* p) 
 {
-	Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_SlottedCsma::Phy2MacEndTx %p %p", p, pktTx_);
+	SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_SlottedCsma::Phy2MacEndTx %p %p", p, pktTx_);
 	txDone((Packet*)p);
 //	Sunset_Utilities::eraseOnlyPkt((Packet *)p, getModuleAddress());
 }
@@ -1308,13 +1420,13 @@ void Sunset_SlottedCsma::Phy2MacEndTx(const Packet* p)
 
 void Sunset_SlottedCsma::Phy2MacStartRx(const Packet* p) 
 {
-	Sunset_Debug::debugInfo(5, getModuleAddress(),  "Sunset_SlottedCsma::Phy2MacStartRx");
+	SUNSET_DEBUG_LOG(5, getModuleAddress(),  "Sunset_SlottedCsma::Phy2MacStartRx");
 	
 	setRxState(MAC_RECV);
 	
 	if (Sunset_Utilities::isSimulation()) {
 		
-		Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_SlottedCsma::Phy2MacStartRx src %d dst %d",  HDR_SUNSET_MAC(p)->src, HDR_SUNSET_MAC(p)->dst);
+		SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_SlottedCsma::Phy2MacStartRx src %d dst %d",  HDR_SUNSET_MAC(p)->src, HDR_SUNSET_MAC(p)->dst);
 	}
 }
 
@@ -1335,7 +1447,7 @@ void Sunset_SlottedCsma::Phy2MacEndRx(Packet* p)
 
 	hdr_cmn* ch = HDR_CMN(p);
 	
-	Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_SlottedCsma::Phy2MacEndRx size %d", ch->size());
+	SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_SlottedCsma::Phy2MacEndRx size %d", ch->size());
 	
 	if (ch->error()) {
 		
@@ -1355,7 +1467,7 @@ void Sunset_SlottedCsma::Phy2MacEndRx(Packet* p)
 
 		if (HDR_SUNSET_MAC(p)->dst == getModuleAddress()) {
 			
-			Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_SlottedCsma::Phy2MacEndRx src %d dst %d TOO MUCH NOISE", HDR_SUNSET_MAC(p)->src, HDR_SUNSET_MAC(p)->dst);
+			SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_SlottedCsma::Phy2MacEndRx src %d dst %d TOO MUCH NOISE", HDR_SUNSET_MAC(p)->src, HDR_SUNSET_MAC(p)->dst);
 		}
 		
 		Sunset_Utilities::erasePkt(p, getModuleAddress());
@@ -1365,7 +1477,7 @@ void Sunset_SlottedCsma::Phy2MacEndRx(Packet* p)
 		
 		if (HDR_SUNSET_MAC(p)->dst == getModuleAddress()) {
 			
-			Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_SlottedCsma::Phy2MacEndRx src %d dst %d CORRECT", HDR_SUNSET_MAC(p)->src, HDR_SUNSET_MAC(p)->dst);
+			SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_SlottedCsma::Phy2MacEndRx src %d dst %d CORRECT", HDR_SUNSET_MAC(p)->src, HDR_SUNSET_MAC(p)->dst);
 		}
 		
 		pktRx_ = p;
@@ -1417,13 +1529,13 @@ int Sunset_SlottedCsma::notify_info(list<notified_info> linfo)
 			
 			distanceToNode[ni.node_id] = (val * macTiming->getSoundSpeedInWater());				
 			
-			Sunset_Debug::debugInfo(1, getModuleAddress(), " Sunset_SlottedCsma::notify_info NODE_PROPAGATION_DELAY to %d val %f", ni.node_id, val);
+			SUNSET_DEBUG_LOG(1, getModuleAddress(), " Sunset_SlottedCsma::notify_info NODE_PROPAGATION_DELAY to %d val %f", ni.node_id, val);
 			
 			return 1;
 		}
 	}
 	
-	Sunset_Debug::debugInfo(-1, getModuleAddress(), " Sunset_SlottedCsma::notify_info NOTHING TO DO");
+	SUNSET_DEBUG_LOG(-1, getModuleAddress(), " Sunset_SlottedCsma::notify_info NOTHING TO DO");
 	
 	return Sunset_Mac::notify_info(linfo); 
 } 
@@ -1464,7 +1576,7 @@ void Sunset_SlottedCsma::txAction(Packet* p, mac_action_type mct)
 					break;
 				
 				default:
-					Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_SlottedCsma::txAction Invalid MAC Control Subtype %x ERROR", subtype);
+					SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_SlottedCsma::txAction Invalid MAC Control Subtype %x ERROR", subtype);
 					
 					return;
 			}
@@ -1481,7 +1593,7 @@ void Sunset_SlottedCsma::txAction(Packet* p, mac_action_type mct)
 					break;
 					
 				default:
-					Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_SlottedCsma::txAction Invalid MAC Data Subtype %x ERROR", subtype);
+					SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_SlottedCsma::txAction Invalid MAC Data Subtype %x ERROR", subtype);
 					
 					return;
 			}
@@ -1489,7 +1601,7 @@ void Sunset_SlottedCsma::txAction(Packet* p, mac_action_type mct)
 			break;
 			
 		default:
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_SlottedCsma::txAction Invalid MAC Type %x ERROR", subtype);
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_SlottedCsma::txAction Invalid MAC Type %x ERROR", subtype);
 			
 			return;
 	}
@@ -1582,7 +1694,7 @@ void Sunset_SlottedCsma::rxAction(Packet* p, mac_action_type mct)
 					
 				default:
 					
-					Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_SlottedCsma::rxAction Invalid MAC Control Subtype %x ERROR", subtype);
+					SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_SlottedCsma::rxAction Invalid MAC Control Subtype %x ERROR", subtype);
 					
 					return;
 			}
@@ -1600,7 +1712,7 @@ void Sunset_SlottedCsma::rxAction(Packet* p, mac_action_type mct)
 					
 				default:
 					
-					Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_SlottedCsma::rxAction Invalid MAC Data Subtype %x ERROR", subtype);
+					SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_SlottedCsma::rxAction Invalid MAC Data Subtype %x ERROR", subtype);
 					
 					return;
 			}
@@ -1609,7 +1721,7 @@ void Sunset_SlottedCsma::rxAction(Packet* p, mac_action_type mct)
 			
 		default:
 			
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_SlottedCsma::rxAction Invalid MAC Type %x ERROR", subtype);
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_SlottedCsma::rxAction Invalid MAC Type %x ERROR", subtype);
 			return;
 	}
 	
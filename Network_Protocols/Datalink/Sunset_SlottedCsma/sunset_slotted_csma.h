@@ -23,6 +23,7 @@
 
 #include "sunset_mac_pkt.h"
 #include "sunset_slotted_csma_timers.h"
+#include "sunset_mac_slot_clock.h"
 
 #include "sunset_mac.h"
 
@@ -121,6 +122,15 @@ protected:
 	/*! @brief Function called to collect the time duration of each slot. */
 	virtual double getSlotTime();
 	
+	/*! @brief Function called to collect the time remaining before the end of the current slot. */
+	double getSlotRemaining();
+	
+	/*! @brief Function called to schedule the slot timer on the next slot the node has to wake up for. */
+	virtual void armSlotTimer();
+	
+	/*! @brief Function called to decrease the back off counter for the slots skipped since the last update. */
+	void syncBackoff(bool current);
+	
 	/*! @brief Function called to compute the number of slots to wait when the node has to back off. */
 	virtual int getBackoffSlotCount();
 	
@@ -172,6 +182,11 @@ protected:
 	
 	double slotTime_;       // contains the duration of each slot
 	
+	Sunset_Mac_Slot_Clock slotClock_;	/*!< @brief slot boundaries, the slot timer is scheduled only for the slots requiring an operation */
+	long backoffSlotIndex_;			/*!< @brief index of the first slot not yet accounted in backoffSlotCount */
+	double slotWake_;			/*!< @brief time the slot timer has been scheduled for */
+	int skipIdleSlots_;			/*!< @brief if 1 the node wakes up only when a packet can be transmitted, otherwise at every slot */
+	
 	/*! @brief Function called  by the information dispatcher to notify to the agent if a value is changed among the ones the agent has registered itsef for. */
 	virtual int notify_info(list<notified_info> linfo);
 	
@@ -29,7 +29,7 @@ void Sunset_SlottedCsma_Defer_Timer::start(double time)
 	Scheduler& s = Scheduler::instance();
 	
 	if (busy_) {
-		Sunset_Debug::debugInfo(-1, mac->getModuleAddress(), "Sunset_SlottedCsma_Defer_Timer::start paused ERROR");
+		SUNSET_DEBUG_LOG(-1, mac->getModuleAddress(), "Sunset_SlottedCsma_Defer_Timer::start paused ERROR");
 		return;
 	} 
 	
@@ -41,7 +41,7 @@ void Sunset_SlottedCsma_Defer_Timer::start(double time)
 	
 	if (rtime < 0.0) {
 		
-		Sunset_Debug::debugInfo(-1, mac->getModuleAddress(), "Sunset_SlottedCsma_Defer_Timer::start rtime ERROR");
+		SUNSET_DEBUG_LOG(-1, mac->getModuleAddress(), "Sunset_SlottedCsma_Defer_Timer::start rtime ERROR");
 		return;
 	} 
 	
@@ -15,6 +15,7 @@ Module/MMac/Sunset_Tdma set slotTime_ 0.0\n\
 Module/MMac/Sunset_Tdma set debug_ false\n\
 Module/MMac/Sunset_Tdma set slot_per_frame_	16\n\
 Module/MMac/Sunset_Tdma set slot_offset_	0\n\
+Module/MMac/Sunset_Tdma set skipIdleSlots_	1\n\
 \n\
 ";
 #include "tclcl.h"
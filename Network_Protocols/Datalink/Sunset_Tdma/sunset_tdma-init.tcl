@@ -16,4 +16,5 @@ Module/MMac/Sunset_Tdma set slotTime_ 0.0
 Module/MMac/Sunset_Tdma set debug_ false
 Module/MMac/Sunset_Tdma set slot_per_frame_	16
 Module/MMac/Sunset_Tdma set slot_offset_	0
+Module/MMac/Sunset_Tdma set skipIdleSlots_	1
 
@@ -53,6 +53,8 @@ Sunset_Tdma::Sunset_Tdma():  mhSend_(this), mhDefer_(this), mhSlot_(this)
 	longRetryLimit = 0;
 	
 	slotTime_ = 0.0;
+	slotWake_ = 0.0;
+	skipIdleSlots_ = 1;
 	logical_id = getModuleAddress();
 	
 	// Get variables initialization from the Tcl script
@@ -64,12 +66,13 @@ Sunset_Tdma::Sunset_Tdma():  mhSend_(this), mhDefer_(this), mhSlot_(this)
 	bind("DATA_SIZE", &DATA_SIZE);
 	bind("slotTime_", &slotTime_);
 	bind("logical_id", &logical_id);
+	bind("skipIdleSlots_", &skipIdleSlots_);
 	
 	distanceToNode.clear();
 	timeSentToNode.clear();
 	roundTripTime.clear();
 	
-	Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Tdma::CREATED slot_per_frame %d slot_offset_ %d", slot_per_frame_, slot_offset_);
+	SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Tdma::CREATED slot_per_frame %d slot_offset_ %d", slot_per_frame_, slot_offset_);
 }
 
 
@@ -90,7 +93,7 @@ int Sunset_Tdma::command(int argc, const char*const* argv)
 		// assign the logical ID to the node
 		if (strcmp(argv[1], "setLogicalId") == 0) {
 			
-			Sunset_Debug::debugInfo(1, getModuleAddress(), "Sunset_Tdma::command setLogicalId %d", atoi(argv[2]));
+			SUNSET_DEBUG_LOG(1, getModuleAddress(), "Sunset_Tdma::command setLogicalId %d", atoi(argv[2]));
 			logical_id = atoi(argv[2]);
 			
 			return TCL_OK;
@@ -101,7 +104,8 @@ int Sunset_Tdma::command(int argc, const char*const* argv)
 }
 
 /*!
- * 	@brief The slotHandler() function is invoked when the slot timer timeout is over.
+ * 	@brief The slotHandler() function is invoked when the slot timer timeout is over. The slot timer is not scheduled 
+ *	for the slots where the node has nothing to do, the slot count is updated according to the slots skipped.
  */
 
 void Sunset_Tdma::slotHandler() 
@@ -109,28 +113,38 @@ void Sunset_Tdma::slotHandler()
 	int slotId = 0;
 	int my_slot = 0;
 	
+	if (slotClock_.advanceTo(NOW) == 0) { // the timer has not been scheduled on a slot boundary
+		
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Tdma::slotHandler no slot boundary ERROR");
+		
+		armSlotTimer();
+		return;
+	}
+	
+	slotCount_ = slotClock_.getCount() - 1; // the current slot is the last boundary passed
+	
 	slotId = (slotCount_ % slot_per_frame_); // determine the node ID for the current slot
 	my_slot = logical_id - slot_offset_;     // determine teh ID of the node
 	
-	Sunset_Debug::debugInfo(1, getModuleAddress(), "Sunset_Tdma::slotHandler slotHandler %f slotId %d my_slot %d", getSlotTime(), slotId, my_slot);
+	SUNSET_DEBUG_LOG(1, getModuleAddress(), "Sunset_Tdma::slotHandler slotHandler %f slotId %d my_slot %d", getSlotTime(), slotId, my_slot);
 	
 	slotCount_++;
 	
 	if (slotId != my_slot) {  // this is not my slot
 		
-		mhSlot_.start(getSlotTime());
+		armSlotTimer();
 		return;
 	}
 	
 	// It is my slot
 	if (pktTx_ == 0) {  // no pkt waiting to be transmitted
 		
-		mhSlot_.start(getSlotTime());
+		armSlotTimer();
 		return;
 	}
 	
 	// I have to send a data packet
-	mhSlot_.start(getSlotTime());
+	armSlotTimer();
 	
 	if (backoffSlotCount == 0) { // no back off currently on going
 		
@@ -166,6 +180,70 @@ void Sunset_Tdma::slotHandler()
 	}
 }
 
+/*!
+ * 	@brief The armSlotTimer() function schedules the slot timer on the next slot the node has to wake up for: its own slot if a data 
+ *	packet is waiting to be transmitted. If skipIdleSlots_ is not set the timer is scheduled at every slot. Skipping the other slots 
+ *	does not change the protocol behavior, in those slots the slot handler only increases the slot count.
+ */
+
+void Sunset_Tdma::armSlotTimer() 
+{
+	long next = 0;
+	double wake = 0.0;
+	int my_slot = logical_id - slot_offset_;
+	
+	if (!slotClock_.isRunning()) {
+		
+		return;
+	}
+	
+	slotClock_.update(NOW, mhSlot_.busy() && slotWake_ <= NOW); // a boundary at NOW already skipped is not the next slot
+	next = slotClock_.getCount();
+	
+	if (skipIdleSlots_) {
+		
+		if (pktTx_ == 0 || slot_per_frame_ <= 0 || my_slot < 0 || my_slot >= slot_per_frame_) { // nothing to do in the next slots
+			
+			if (mhSlot_.busy()) {
+				
+				mhSlot_.stop();
+			}
+			
+			return;
+		}
+		
+		next = Sunset_Mac_Slot_Clock::getNextInFrame(next, my_slot, slot_per_frame_);
+	}
+	
+	wake = slotClock_.getBoundary(next);
+	
+	if (mhSlot_.busy()) {
+		
+		if (slotWake_ == wake) {
+			
+			return;
+		}
+		
+		mhSlot_.stop();
+	}
+	
+	SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Tdma::armSlotTimer slot %ld at %f", next, wake);
+	
+	slotWake_ = wake;
+	mhSlot_.start(Sunset_Mac_Slot_Clock::getDelay(NOW, wake));
+}
+
+/*!
+ *  @brief The getSlotRemaining() function returns the time remaining before the end of the current slot.
+ */
+
+double Sunset_Tdma::getSlotRemaining() 
+{
+	slotClock_.update(NOW, mhSlot_.busy() && slotWake_ <= NOW);
+	
+	return slotClock_.getNext() - NOW;
+}
+
 /*!
  *  @brief The getBackoffSlotCount() function returns the backoff slot counter.
  */
@@ -174,7 +252,7 @@ int Sunset_Tdma::getBackoffSlotCount()
 {
 	int count = 0;
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Tdma::getBackoffSlotCount computed count %d", count);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Tdma::getBackoffSlotCount computed count %d", count);
 	
 	return count;
 }
@@ -192,13 +270,13 @@ void Sunset_Tdma::transmit(Packet *p)
 	
 	if (tx_active_) { // if another transmission is on going return
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Tdma::transmit but tx already active ERROR");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Tdma::transmit but tx already active ERROR");
 		return;
 	}
 	
 	tx_active_ = 1;
 	
-	Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Tdma::transmit src %d dest %d pktId %d", HDR_SUNSET_MAC(p)->src, HDR_SUNSET_MAC(p)->dst, HDR_SUNSET_MAC(p)->pktId);
+	SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Tdma::transmit src %d dest %d pktId %d", HDR_SUNSET_MAC(p)->src, HDR_SUNSET_MAC(p)->dst, HDR_SUNSET_MAC(p)->pktId);
 	
 	txAction(p, SUNSET_MAC_TX_ACTION_OK);
 	
@@ -206,7 +284,7 @@ void Sunset_Tdma::transmit(Packet *p)
 	
 	if (mhSend_.busy()) {   // if tx timer is running stop it
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Tdma::transmit timeout mhSend busy ERROR");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Tdma::transmit timeout mhSend busy ERROR");
 		
 		mhSend_.stop();
 	}
@@ -222,7 +300,7 @@ void Sunset_Tdma::transmit(Packet *p)
 	// compute the time to wait for a confirmation on the transmission (txDone)
 	newTimeout = macTiming->overheadTime(pkt_size) + macTiming->getMaxPropagationDelay() + macTiming->txtime(pkt_size, rate);
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Tdma::transmit timeout %f size %d", newTimeout, HDR_CMN(p)->size());
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Tdma::transmit timeout %f size %d", newTimeout, HDR_CMN(p)->size());
 	
 	mhSend_.start(newTimeout);
 }
@@ -243,7 +321,7 @@ void Sunset_Tdma::rx_resume()
 
 void Sunset_Tdma::deferHandler() 
 {
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Tdma::deferHandler pktACK_ %d pktTx_ %d ", pktACK_, pktTx_);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Tdma::deferHandler pktACK_ %d pktTx_ %d ", pktACK_, pktTx_);
 	
 	if (!use_ack) {
 		
@@ -252,7 +330,7 @@ void Sunset_Tdma::deferHandler()
 	
 	if (use_ack && check_pktACK() != 0) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Tdma::deferHandler but no ACK pkt ERROR");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Tdma::deferHandler but no ACK pkt ERROR");
 		return;
 	}
 }
@@ -299,11 +377,11 @@ void Sunset_Tdma::txDone(Packet* p)
 			
 		case MAC_ACK:
 			
-			Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Tdma::txDone ACK transmitted");
+			SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Tdma::txDone ACK transmitted");
 			
 			if (!use_ack) {
 				
-				Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Tdma::txDone but we are not using ACK pkt ERROR");
+				SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Tdma::txDone but we are not using ACK pkt ERROR");
 				
 				if (p != 0) {
 					
@@ -351,7 +429,7 @@ void Sunset_Tdma::txDone(Packet* p)
 			
 			// A DATA packet has been correctly transmitted
 			
-			Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Tdma::txDone DATA transmitted %p", pktTx_);
+			SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Tdma::txDone DATA transmitted %p", pktTx_);
 			
 			if ( p != pktTx_ && p != 0) {
 			
@@ -394,7 +472,7 @@ void Sunset_Tdma::txDone(Packet* p)
 					//compute the timeout for the ACK packet
 					double timeout = getTimeout(pktTx_);
 					
-					Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Tdma::txDone timeout at %f pktSize %d", NOW + timeout, HDR_CMN(pktTx_)->size());
+					SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Tdma::txDone timeout at %f pktSize %d", NOW + timeout, HDR_CMN(pktTx_)->size());
 					
 					// start the timer
 					mhSend_.start(timeout);	
@@ -404,7 +482,7 @@ void Sunset_Tdma::txDone(Packet* p)
 			break;
 			
 		default:
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Tdma::txDone tx_state_ ERROR %d", tx_state_);
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Tdma::txDone tx_state_ ERROR %d", tx_state_);
 
 	}	
 	
@@ -452,11 +530,11 @@ void Sunset_Tdma::txAborted(Packet* p)
 			
 		case MAC_ACK:
 			
-			Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Tdma::txAborted ACK tranmission ABORTED");
+			SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Tdma::txAborted ACK tranmission ABORTED");
 			
 			if (!use_ack) {
 				
-				Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Tdma::txAborted but we are not using ACK pkt ERROR");
+				SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Tdma::txAborted but we are not using ACK pkt ERROR");
 
 				if (p != 0) {
 					
@@ -495,7 +573,7 @@ void Sunset_Tdma::txAborted(Packet* p)
 			
 			// ERROR on an DATA packet transmission
 			
-			Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Tdma::txAborted DATA transmission ABORTED pktTx == 0 (%d)", pktTx_ == 0);
+			SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Tdma::txAborted DATA transmission ABORTED pktTx == 0 (%d)", pktTx_ == 0);
 			
 			setTxState(MAC_IDLE);
 			
@@ -516,7 +594,7 @@ void Sunset_Tdma::txAborted(Packet* p)
 			break;
 			
 		default:
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Tdma::txAborted tx_state_ ERROR %d", tx_state_);
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Tdma::txAborted tx_state_ ERROR %d", tx_state_);
 	}
 	
 	if (p != 0 && removePkt) {
@@ -534,7 +612,7 @@ void Sunset_Tdma::txAborted(Packet* p)
 
 void Sunset_Tdma::send_timer() 
 {
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "unset_SlottedTdma::send_timer pktACK_ %d pktTx_ %d tx_state %d", pktACK_, pktTx_, tx_state_);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "unset_SlottedTdma::send_timer pktACK_ %d pktTx_ %d tx_state %d", pktACK_, pktTx_, tx_state_);
 	
 	if (tx_active_) {  // if the transmission is active no txDone message has been received
 		
@@ -567,7 +645,7 @@ void Sunset_Tdma::send_timer()
 			
 			if (!use_ack) {
 				
-				Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Tdma::send_timer but we are not using ACK pkt ERROR");
+				SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Tdma::send_timer but we are not using ACK pkt ERROR");
 				break;	
 			}
 			
@@ -609,7 +687,7 @@ double Sunset_Tdma::getTimeout(Packet* p)
 	dst = (mh->dst);
 	src = (mh->src);
 	
-	Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Tdma::getTimeout src %d dst %d type %d subType %d", src, dst, mh->dh_fc.fc_type, mh->dh_fc.fc_subtype);
+	SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Tdma::getTimeout src %d dst %d type %d subType %d", src, dst, mh->dh_fc.fc_type, mh->dh_fc.fc_subtype);
 	
 	if (mh->dh_fc.fc_type == SUNSET_MAC_Type_Control) {
 		
@@ -621,7 +699,7 @@ double Sunset_Tdma::getTimeout(Packet* p)
 				
 				if (!use_ack) {
 					
-					Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Tdma::getTimeout but we are not using ACK pkt ERROR");
+					SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Tdma::getTimeout but we are not using ACK pkt ERROR");
 										
 					return 10.0;
 				}
@@ -629,13 +707,13 @@ double Sunset_Tdma::getTimeout(Packet* p)
 				// There is no need to wait after ACK packet transmission
 				timeout = 0.0; 
 				
-				Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Tdma::getTimeout send ACK to %d timeout at %f", dst, NOW + timeout);
+				SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Tdma::getTimeout send ACK to %d timeout at %f", dst, NOW + timeout);
 				
 				return timeout;
 				
 			default:
 				
-				Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Tdma::getTimeout SubTypeCtrl ERROR %d", mh->dh_fc.fc_subtype);
+				SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Tdma::getTimeout SubTypeCtrl ERROR %d", mh->dh_fc.fc_subtype);
 				
 				return 10.0;
 		}
@@ -659,17 +737,17 @@ double Sunset_Tdma::getTimeout(Packet* p)
 				timeout = 0.001;
 			}
 			
-			Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Tdma::getTimeout mDelay %f time %f dDelay %f mDelay %f tTime %f maxPropDelay %f ACK_SIZE %d DATA_SIZE %d", macTiming->getMaxPropagationDelay(), macTiming->txtime(pkt_ack_size), macTiming->getDeviceDelay(), macTiming->getModemDelay(), macTiming->transfertTime(pkt_ack_size), getPropagationDelay(mh->dst), pkt_ack_size, macTiming->getPktSize(getDATA_Size()));
+			SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Tdma::getTimeout mDelay %f time %f dDelay %f mDelay %f tTime %f maxPropDelay %f ACK_SIZE %d DATA_SIZE %d", macTiming->getMaxPropagationDelay(), macTiming->txtime(pkt_ack_size), macTiming->getDeviceDelay(), macTiming->getModemDelay(), macTiming->transfertTime(pkt_ack_size), getPropagationDelay(mh->dst), pkt_ack_size, macTiming->getPktSize(getDATA_Size()));
 		}
 		else {
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Tdma::getTimeout SubTypeData ERROR %d", mh->dh_fc.fc_subtype);
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Tdma::getTimeout SubTypeData ERROR %d", mh->dh_fc.fc_subtype);
 			
 			return 10.0;
 		}
 	}
 	else {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Tdma::getTimeout Type ERROR %d", mh->dh_fc.fc_type);
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Tdma::getTimeout Type ERROR %d", mh->dh_fc.fc_type);
 		
 		return 10.0;
 	}
@@ -677,15 +755,15 @@ double Sunset_Tdma::getTimeout(Packet* p)
 	// if timeout is longer than slot time, the time needed for the communication requires more than one slot and this is not allowed
 	if (timeout > getSlotTime()) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Tdma::getTimeout %f slotTime %f ERROR", timeout, getSlotTime());
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Tdma::getTimeout %f slotTime %f ERROR", timeout, getSlotTime());
 		
 		return 10.0;
 	}
 	
 	// if timeout is longer than the remaining time for the current slot, the time needed for the communication requires more than one slot and this is not allowed
-	if (timeout > mhSlot_.expire()) {
+	if (timeout > getSlotRemaining()) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Tdma::getTimeout %f slotTime expire %f ERROR", timeout, mhSlot_.expire());
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Tdma::getTimeout %f slotTime expire %f ERROR", timeout, getSlotRemaining());
 		
 		return 10.0;
 	}
@@ -706,7 +784,7 @@ int Sunset_Tdma::check_pktACK()
 	
 	if (!use_ack) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Tdma::check_pktACK but we are not using ACK pkt ERROR");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Tdma::check_pktACK but we are not using ACK pkt ERROR");
 		
 		return -1;
 	}
@@ -748,7 +826,7 @@ int Sunset_Tdma::check_pktTx() {
 	struct hdr_Sunset_Mac *mh;
 	int dst, src;
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Tdma::check_pktTx entering ...");
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Tdma::check_pktTx entering ...");
 	
 	if(pktTx_ == 0) {
 		
@@ -763,7 +841,7 @@ int Sunset_Tdma::check_pktTx() {
 			
 			if(!is_idle() || mhDefer_.busy() || mhSend_.busy() || tx_active_ || pktACK_) {
 				
-				Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Tdma::check_pktTx channel is busy");
+				SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Tdma::check_pktTx channel is busy");
 				
 				txAction(pktTx_, SUNSET_MAC_TX_ACTION_BUSY);
 				
@@ -785,7 +863,7 @@ int Sunset_Tdma::check_pktTx() {
 			break;
 			
 		default:
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Tdma::check_pktTx check_pktTx:Invalid MAC Control subtype ERROR");
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Tdma::check_pktTx check_pktTx:Invalid MAC Control subtype ERROR");
 			return -1;
 	}
 	
@@ -813,13 +891,13 @@ void Sunset_Tdma::createACK(int dst)
 	
 	if (pktACK_ != 0) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Tdma::createACK but pktACK_ is not zero ERROR");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Tdma::createACK but pktACK_ is not zero ERROR");
 		return;
 	}
 	
 	if (!use_ack) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Tdma::createACK but we are not using ACK pkt ERROR");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Tdma::createACK but we are not using ACK pkt ERROR");
 		return;
 	}
 	
@@ -849,7 +927,7 @@ void Sunset_Tdma::createACK(int dst)
 	
 	SUNSET_HDR_CMN(p)->response = 1;
 
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Tdma::createACK size %d rate %d", ch->size(), TIMING_CTRL_RATE);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Tdma::createACK size %d rate %d", ch->size(), TIMING_CTRL_RATE);
 	
 	/* store ack tx time */
  	
@@ -857,7 +935,7 @@ void Sunset_Tdma::createACK(int dst)
 	
 	HDR_CMN(p)->timestamp() = Sunset_Utilities::getRealTime();
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Tdma::createACK txTime %f timeStamp %f", ch->txtime(), HDR_CMN(p)->timestamp());
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Tdma::createACK txTime %f timeStamp %f", ch->txtime(), HDR_CMN(p)->timestamp());
 	
 	/* calculate ack duration */
 	
@@ -867,12 +945,12 @@ void Sunset_Tdma::createACK(int dst)
 	
 	if (mhDefer_.busy() != 0) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Tdma::createACK has to send ACK pkt to node:%d but timer is running ERROR", dst);
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Tdma::createACK has to send ACK pkt to node:%d but timer is running ERROR", dst);
 		
 		return;
 	}
 	
-	Sunset_Debug::debugInfo(1, getModuleAddress(), "Sunset_Tdma::createACK node:%d to node:%d time %f pType %d", getModuleAddress(), dst, HDR_CMN(p)->timestamp(), (u_int8_t)ch->ptype());
+	SUNSET_DEBUG_LOG(1, getModuleAddress(), "Sunset_Tdma::createACK node:%d to node:%d time %f pType %d", getModuleAddress(), dst, HDR_CMN(p)->timestamp(), (u_int8_t)ch->ptype());
 }
 
 
@@ -897,7 +975,7 @@ void Sunset_Tdma::RetransmitDATA()
 	dst = (dh->dst);
 	src = (dh->src);
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Tdma::RetransmitDATA() to %d retry %d", dst, tx_retry);
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Tdma::RetransmitDATA() to %d retry %d", dst, tx_retry);
 	
 	tx_retry += 1;
 	
@@ -908,7 +986,7 @@ void Sunset_Tdma::RetransmitDATA()
 		txAction(pktTx_, SUNSET_MAC_ACTION_PKT_DISCARDED);
 		
 		hdr_cmn *ch = HDR_CMN(pktTx_);
-		Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Tdma::RetransmitDATA() DISCARD too many retransmissions");
+		SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Tdma::RetransmitDATA() DISCARD too many retransmissions");
 		
 		Packet* aux = pktTx_->copy();
 
@@ -933,14 +1011,14 @@ void Sunset_Tdma::RetransmitDATA()
 		
 		struct hdr_Sunset_Mac *dh;
 		
-		Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Tdma::RetransmitDATA() start retransmission process");
+		SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Tdma::RetransmitDATA() start retransmission process");
 		
 		dh = HDR_SUNSET_MAC(pktTx_);
 		dh->dh_fc.fc_retry = 1;
 		
 		backoffSlotCount = getBackoffSlotCount();
 		
-		Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Tdma::RetransmitDATA() backoff Time %f", time);
+		SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Tdma::RetransmitDATA() backoff Time %f", time);
 		
 		if (Sunset_Statistics::use_stat() && stat != NULL) {
 			
@@ -948,7 +1026,7 @@ void Sunset_Tdma::RetransmitDATA()
 		}
 	}
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Tdma::RetransmitDATA() to %d retry %d count %d",
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Tdma::RetransmitDATA() to %d retry %d count %d",
 				dst, tx_retry, backoffSlotCount);
 }
 
@@ -960,7 +1038,7 @@ void Sunset_Tdma::RetransmitDATA()
 
 void Sunset_Tdma::send(Packet *p) 
 {
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Tdma::send size %d", HDR_CMN(p)->size());
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Tdma::send size %d", HDR_CMN(p)->size());
 	
 	if (pktTx_ != 0) {
 		
@@ -974,6 +1052,8 @@ void Sunset_Tdma::send(Packet *p)
 	}
 	
 	pktTx_ = p;
+	
+	armSlotTimer(); // a packet is waiting, wake up in the next slot of the node
 }
 
 /*!
@@ -1009,7 +1089,7 @@ void Sunset_Tdma::recvPkt()
 		goto done;
 	}
         
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Tdma::recvPkt recv_timer %d->%d", src, dst);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Tdma::recvPkt recv_timer %d->%d", src, dst);
 	
 	if( ch->error() ) {  // packet received with error discard it
 				
@@ -1018,7 +1098,7 @@ void Sunset_Tdma::recvPkt()
 		goto done;
 	}
 	
-	Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Tdma::recvPkt src %d dest %d pktId %d", src, dst, HDR_SUNSET_MAC(pktRx_)->pktId);
+	SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Tdma::recvPkt src %d dest %d pktId %d", src, dst, HDR_SUNSET_MAC(pktRx_)->pktId);
 	
 	
 	if (pktRx_ != 0) {
@@ -1044,7 +1124,7 @@ void Sunset_Tdma::recvPkt()
 					
 				default:
 					
-					Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Tdma::recvPkt Invalid MAC Control Subtype %x ERROR", subtype);
+					SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Tdma::recvPkt Invalid MAC Control Subtype %x ERROR", subtype);
 					
 					return;
 			}
@@ -1062,7 +1142,7 @@ void Sunset_Tdma::recvPkt()
 					break;
 					
 				default:
-					Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Tdma::recvPkt Invalid MAC Data Subtype %x ERROR", subtype);
+					SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Tdma::recvPkt Invalid MAC Data Subtype %x ERROR", subtype);
 					
 					return;
 			}
@@ -1070,7 +1150,7 @@ void Sunset_Tdma::recvPkt()
 			break;
 			
 		default:
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Tdma::recvPkt Invalid MAC Type %x ERROR", subtype);
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Tdma::recvPkt Invalid MAC Type %x ERROR", subtype);
 			return;
 	}
 	
@@ -1101,7 +1181,7 @@ void Sunset_Tdma::recvDATA(Packet *p)
 	ch->size() -= getMacHdrSize();
 	ch->num_forwards() += 1;
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Tdma::recvDATA from %d to %d size %d timestamp %f", src, dst, ch->size(), HDR_CMN(p)->timestamp());
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Tdma::recvDATA from %d to %d size %d timestamp %f", src, dst, ch->size(), HDR_CMN(p)->timestamp());
 	
 	/* it is a UNICAST pkt but I am not the destination */
 	
@@ -1124,14 +1204,14 @@ void Sunset_Tdma::recvDATA(Packet *p)
 		
 		if (!mhSend_.busy() && !tx_active_) {
 			
-			Sunset_Debug::debugInfo(4, getModuleAddress(), "MAC_TDMA recvDATA from %d to %d  createACK", src, dst);
+			SUNSET_DEBUG_LOG(4, getModuleAddress(), "MAC_TDMA recvDATA from %d to %d  createACK", src, dst);
 			
 			// packet for me prepare an ACK packet in response
 			createACK(src);
 		}
 		else {
 			
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "ERROR MAC_TDMA recvDATA from %d to %d  createACK mhSend %d tx_Active %d ERROR", src, dst, mhSend_.busy(), tx_active_);
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "ERROR MAC_TDMA recvDATA from %d to %d  createACK mhSend %d tx_Active %d ERROR", src, dst, mhSend_.busy(), tx_active_);
 			
 			return;
 		}
@@ -1180,7 +1260,7 @@ void Sunset_Tdma::recvACK(Packet *p)
 	dst = (dh->dst);
 	src = (dh->src);
 	
-	Sunset_Debug::debugInfo(2, getModuleAddress(), "Sunset_Tdma::recvACK from %d to %d", src, dst);
+	SUNSET_DEBUG_LOG(2, getModuleAddress(), "Sunset_Tdma::recvACK from %d to %d", src, dst);
 	
 	// ACK packet is not for me
 	if (dst != getModuleAddress()) {
@@ -1198,7 +1278,7 @@ void Sunset_Tdma::recvACK(Packet *p)
 	
 	if (pktTx_ == 0) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Tdma::recvACK from %d but no pktTx is present ERROR", src);
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Tdma::recvACK from %d but no pktTx is present ERROR", src);
 		
 		discard(p);
 		
@@ -1211,7 +1291,7 @@ void Sunset_Tdma::recvACK(Packet *p)
 		
 		if (pktTx_ == 0) {
 			
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Tdma::recvACK from %d but no pktTx is present ERROR2", src);
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Tdma::recvACK from %d but no pktTx is present ERROR2", src);
 			
 			discard(p);
 			
@@ -1250,8 +1330,8 @@ void Sunset_Tdma::recvACK(Packet *p)
 	
 	discard(p);
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Tdma::recvACK recvACK");
-	Sunset_Debug::debugInfo(0, getModuleAddress(), "Sunset_Tdma::recvACK Transmission COMPLETED to %d", src);
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Tdma::recvACK recvACK");
+	SUNSET_DEBUG_LOG(0, getModuleAddress(), "Sunset_Tdma::recvACK Transmission COMPLETED to %d", src);
 	
 	// reset tx status
 	setTxState(MAC_IDLE);
@@ -1304,9 +1384,11 @@ void Sunset_Tdma::start()
 		sid->provide(getModuleAddress(), sid_id, "MAC_SLOT_COUNT");
 	}
 	
-	Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Tdma::start slotTime %f", getSlotTime());
+	SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Tdma::start slotTime %f", getSlotTime());
+	
+	slotClock_.start(NOW, getSlotTime(), getSlotTime());
 	
-	mhSlot_.start(getSlotTime());
+	armSlotTimer();
 }
 
 /*!
@@ -1317,7 +1399,9 @@ void Sunset_Tdma::stop()
 {      
 	Sunset_Mac::stop(); // call the stop function of Sunset_Mac
 	
-	Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Tdma::stop macQueue_->length() = %d pktTx %d pktRx %d pktAck %d tx_active %d tx_state %d rx_state %d backoff %d", macQueue_->length(), pktTx_, pktRx_, pktACK_, tx_active_, tx_state_, rx_state_, backoffSlotCount);
+	SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Tdma::stop macQueue_->length() = %d pktTx %d pktRx %d pktAck %d tx_active %d tx_state %d rx_state %d backoff %d", macQueue_->length(), pktTx_, pktRx_, pktACK_, tx_active_, tx_state_, rx_state_, backoffSlotCount);
+	
+	slotClock_.stop();
 	
 	if (mhSlot_.busy()) {
 		
@@ -1342,14 +1426,14 @@ void Sunset_Tdma::anotherTransmission()
 		
 		Packet* p2;
 		
-		Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Tdma::anotherTransmission macQueue_->length() = %d", macQueue_->length());
+		SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Tdma::anotherTransmission macQueue_->length() = %d", macQueue_->length());
 		
 		p2 = macQueue_->deque();
 		
 		send(p2);
 	}
 	else {
-		Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Tdma::anotherTransmission macQueue_->length() = 0");
+		SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Tdma::anotherTransmission macQueue_->length() = 0");
    	}
 }
 
@@ -1360,7 +1444,7 @@ void Sunset_Tdma::anotherTransmission()
 
 void Sunset_Tdma::Phy2MacTxAborted(const Packet* p) 
 {
-	Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Tdma::Phy2MacTxAborted");
+	SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Tdma::Phy2MacTxAborted");
 	txAborted((Packet*)p);
 //	Sunset_Utilities::eraseOnlyPkt((Packet *)p, getModuleAddress());
 }
@@ -1372,7 +1456,7 @@ void Sunset_Tdma::Phy2MacTxAborted(const Packet* p)
 
 void Sunset_Tdma::Phy2MacEndTx(const Packet* p) 
 {
-	Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Tdma::Phy2MacEndTx %p %p", p, pktTx_);
+	SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Tdma::Phy2MacEndTx %p %p", p, pktTx_);
 	txDone((Packet*)p);
 //	Sunset_Utilities::eraseOnlyPkt((Packet *)p, getModuleAddress());
 }
@@ -1384,13 +1468,13 @@ void Sunset_Tdma::Phy2MacEndTx(const Packet* p)
 
 void Sunset_Tdma::Phy2MacStartRx(const Packet* p) 
 {
-	Sunset_Debug::debugInfo(5, getModuleAddress(),  "Sunset_Tdma::Phy2MacStartRx");
+	SUNSET_DEBUG_LOG(5, getModuleAddress(),  "Sunset_Tdma::Phy2MacStartRx");
 	
 	setRxState(MAC_RECV);
 	
 	if (Sunset_Utilities::isSimulation()) {
 		
-		Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Tdma::Phy2MacStartRx src %d dst %d",  HDR_SUNSET_MAC(p)->src, HDR_SUNSET_MAC(p)->dst);
+		SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Tdma::Phy2MacStartRx src %d dst %d",  HDR_SUNSET_MAC(p)->src, HDR_SUNSET_MAC(p)->dst);
 	}
 }
 
@@ -1411,7 +1495,7 @@ void Sunset_Tdma::Phy2MacEndRx(Packet* p)
 
 	hdr_cmn* ch = HDR_CMN(p);
 	
-	Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Tdma::Phy2MacEndRx size %d", ch->size());
+	SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Tdma::Phy2MacEndRx size %d", ch->size());
 	
 	if (ch->error()) {
 		
@@ -1431,7 +1515,7 @@ void Sunset_Tdma::Phy2MacEndRx(Packet* p)
 
 		if (HDR_SUNSET_MAC(p)->dst == getModuleAddress()) {
 			
-			Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Tdma::Phy2MacEndRx src %d dst %d TOO MUCH NOISE", HDR_SUNSET_MAC(p)->src, HDR_SUNSET_MAC(p)->dst);
+			SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Tdma::Phy2MacEndRx src %d dst %d TOO MUCH NOISE", HDR_SUNSET_MAC(p)->src, HDR_SUNSET_MAC(p)->dst);
 		}
 		
 		Sunset_Utilities::erasePkt(p, getModuleAddress());
@@ -1441,7 +1525,7 @@ void Sunset_Tdma::Phy2MacEndRx(Packet* p)
 		
 		if (HDR_SUNSET_MAC(p)->dst == getModuleAddress()) {
 			
-			Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Tdma::Phy2MacEndRx src %d dst %d CORRECT", HDR_SUNSET_MAC(p)->src, HDR_SUNSET_MAC(p)->dst);
+			SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Tdma::Phy2MacEndRx src %d dst %d CORRECT", HDR_SUNSET_MAC(p)->src, HDR_SUNSET_MAC(p)->dst);
 		}
 		
 		pktRx_ = p;
@@ -1504,7 +1588,7 @@ void Sunset_Tdma::txAction(Packet* p, mac_action_type mct)
 					
 				default:
 					
-					Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Tdma::txAction Invalid MAC Control Subtype %x ERROR", subtype);
+					SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Tdma::txAction Invalid MAC Control Subtype %x ERROR", subtype);
 					
 					return;
 			}
@@ -1521,7 +1605,7 @@ void Sunset_Tdma::txAction(Packet* p, mac_action_type mct)
 					break;
 				
 				default:
-					Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Tdma::txAction Invalid MAC Data Subtype %x ERROR", subtype);
+					SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Tdma::txAction Invalid MAC Data Subtype %x ERROR", subtype);
 					
 					return;
 			}
@@ -1530,7 +1614,7 @@ void Sunset_Tdma::txAction(Packet* p, mac_action_type mct)
 			
 		default:
 			
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Tdma::txAction Invalid MAC Type %x ERROR", subtype);
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Tdma::txAction Invalid MAC Type %x ERROR", subtype);
 			
 			return;
 	}
@@ -1620,7 +1704,7 @@ void Sunset_Tdma::rxAction(Packet* p, mac_action_type mct)
 					break;
 				
 				default:
-					Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Tdma::rxAction Invalid MAC Control Subtype %x ERROR", subtype);
+					SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Tdma::rxAction Invalid MAC Control Subtype %x ERROR", subtype);
 					
 					return;
 			}
@@ -1638,7 +1722,7 @@ void Sunset_Tdma::rxAction(Packet* p, mac_action_type mct)
 				
 				default:
 					
-					Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Tdma::rxAction Invalid MAC Data Subtype %x ERROR", subtype);
+					SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Tdma::rxAction Invalid MAC Data Subtype %x ERROR", subtype);
 					
 					return;
 			}
@@ -1646,7 +1730,7 @@ void Sunset_Tdma::rxAction(Packet* p, mac_action_type mct)
 			break;
 			
 		default:
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Tdma::rxAction Invalid MAC Type %x ERROR", subtype);
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Tdma::rxAction Invalid MAC Type %x ERROR", subtype);
 			
 			return;
 	}
@@ -26,6 +26,7 @@
 #include "sunset_mac.h"
 #include "sunset_mac_pkt.h"
 #include "sunset_tdma_timers.h"
+#include "sunset_mac_slot_clock.h"
 #include <sunset_common_pkt.h>
 
 /*! @brief This class implements the TDMA MAC protocol. It extends the Sunset_Mac class. 
@@ -133,6 +134,12 @@ protected:
 	/*! @brief Function called to collect the time duration of each slot. */
 	virtual double getSlotTime();
 	
+	/*! @brief Function called to collect the time remaining before the end of the current slot. */
+	double getSlotRemaining();
+	
+	/*! @brief Function called to schedule the slot timer on the next slot the node has to wake up for. */
+	virtual void armSlotTimer();
+	
 	/*! @brief Function called to compute the number of slots to wait when the node has to back off. */
 	virtual int getBackoffSlotCount();
 	
@@ -190,6 +197,10 @@ protected:
 	
 	int logical_id;     // logical ID (which could be different from node ID). It is used by the node to determine if current TDMA slot is assigned to the node (logical ID = slot count) 
 	
+	Sunset_Mac_Slot_Clock slotClock_;	/*!< @brief slot boundaries, the slot timer is scheduled only for the slots requiring an operation */
+	double slotWake_;			/*!< @brief time the slot timer has been scheduled for */
+	int skipIdleSlots_;			/*!< @brief if 1 the node wakes up only in its slot when a packet is waiting, otherwise at every slot */
+	
 };
 
 
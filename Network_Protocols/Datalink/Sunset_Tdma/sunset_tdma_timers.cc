@@ -30,7 +30,7 @@ void Sunset_Tdma_Defer_Timer::start(double time)
 	Scheduler& s = Scheduler::instance();
 	
 	if (busy_) {
-		Sunset_Debug::debugInfo(-1, mac->getModuleAddress(), "Sunset_Tdma_Defer_Timer::start paused ERROR");
+		SUNSET_DEBUG_LOG(-1, mac->getModuleAddress(), "Sunset_Tdma_Defer_Timer::start paused ERROR");
 		//		return;  //TODO: it's just to avoid exiting the simulation
 		exit(30);
 	} 
@@ -43,7 +43,7 @@ void Sunset_Tdma_Defer_Timer::start(double time)
 	
 	if (rtime < 0.0) {
 		
-		Sunset_Debug::debugInfo(-1, mac->getModuleAddress(), "Sunset_Tdma_Defer_Timer::start rtime ERROR");
+		SUNSET_DEBUG_LOG(-1, mac->getModuleAddress(), "Sunset_Tdma_Defer_Timer::start rtime ERROR");
 		//		return;  //TODO: it's just to avoid exiting the simulation
 		exit(30);
 	} 
@@ -1,9 +1,13 @@
 static char code[] = "\n\
 Module/Sunset_Routing set moduleAddress -1\n\
 Module/Sunset_Routing set debug_ false\n\
+Module/Sunset_Routing set dupWindow_ 8192\n\
+Module/Sunset_Routing set dupExpiry_ 0.0\n\
 \n\
 Module/Sunset_Flooding set moduleAddress -1\n\
 Module/Sunset_Flooding set debug_ false\n\
+Module/Sunset_Flooding set dupWindow_ 8192\n\
+Module/Sunset_Flooding set dupExpiry_ 0.0\n\
 \n\
 Module/Sunset_Flooding set probability_ 1.0\n\
 Module/Sunset_Flooding set max_forwards_ 5\n\
@@ -2,9 +2,13 @@
 
 Module/Sunset_Routing set moduleAddress -1
 Module/Sunset_Routing set debug_ false
+Module/Sunset_Routing set dupWindow_ 8192
+Module/Sunset_Routing set dupExpiry_ 0.0
 
 Module/Sunset_Flooding set moduleAddress -1
 Module/Sunset_Flooding set debug_ false
+Module/Sunset_Flooding set dupWindow_ 8192
+Module/Sunset_Flooding set dupExpiry_ 0.0
 
 Module/Sunset_Flooding set probability_ 1.0
 Module/Sunset_Flooding set max_forwards_ 5
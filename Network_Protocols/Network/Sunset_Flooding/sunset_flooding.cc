@@ -31,7 +31,7 @@ void Sunset_Flooding_Timer::start(double time)
 	
 	if (busy()) {
 		
-		Sunset_Debug::debugInfo(-1, node_rtg->getModuleAddress(), "Sunset_Flooding_Timer::start timer busy ERROR");
+		SUNSET_DEBUG_LOG(-1, node_rtg->getModuleAddress(), "Sunset_Flooding_Timer::start timer busy ERROR");
 		return;
 	}
 	
@@ -145,7 +145,7 @@ void Sunset_Flooding::recv(Packet *p)
 		
 	}
 	
-	Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Flooding::recv receiving something id %d size %d from %d to %d", cmh->uid(), cmh->size(), src, dst);
+	SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Flooding::recv receiving something id %d size %d from %d to %d", cmh->uid(), cmh->size(), src, dst);
 	
 	Sunset_Trace::print_info("rtg - (%f) Node:%d - FLOODING recv something id %d size %d from %d to %d hops %d\n", NOW, getModuleAddress(), cmh->uid(), cmh->size(), src, dst, cmh->num_forwards());
 	
@@ -153,7 +153,7 @@ void Sunset_Flooding::recv(Packet *p)
 	
 	if (dst == getModuleAddress()  && src != getModuleAddress()) {
 		
-		Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Flooding::recv recv pkt for me");
+		SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Flooding::recv recv pkt for me");
 		
 		sendUp(p);
 		
@@ -165,7 +165,7 @@ void Sunset_Flooding::recv(Packet *p)
 	
 	if (dst == Sunset_Address::getBroadcastAddress() && src != getModuleAddress()) {
 		
-		Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Flooding::recv pkt pkt copied DOPO");
+		SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Flooding::recv pkt pkt copied DOPO");
 		
 		tmp = p->copy();
 		Sunset_Utilities::copy_data(p, tmp, getModuleAddress());
@@ -174,7 +174,7 @@ void Sunset_Flooding::recv(Packet *p)
 		sendUp(tmp);	  
 	}
 	
-	Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Flooding::recv forward");
+	SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Flooding::recv forward");
 	
 	forwardPacket(p);
 	
@@ -205,13 +205,13 @@ void Sunset_Flooding::forwardPacket(Packet * p)
 	
 	cmh->direction() = hdr_cmn::DOWN;
 	
-	/* checking if I've already forwarded the same data packet. */
+	/* checking if I've already forwarded the same data packet, otherwise it is inserted in the processed packets structure. */
 	
 	//TODO check multiple commands for remote control that havae to be forwarded
 	
-	if (pktForwardedInfo.find(src) != pktForwardedInfo.end() && (pktForwardedInfo[src]).find(id) != (pktForwardedInfo[src]).end()) {
+	if (isForwarded(src, id)) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Flooding::forwardPacket pkt from %d to %d already processed DISCARD", src, dst);
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Flooding::forwardPacket pkt from %d to %d already processed DISCARD", src, dst);
 		
 		Sunset_Trace::print_info("rtg - (%f) Node:%d - FLOODING duplicated pkt not forwarded: id %d size %d from %d to %d hops %d\n", NOW, getModuleAddress(), cmh->uid(), cmh->size(), src, dst, cmh->num_forwards());
 		
@@ -221,12 +221,8 @@ void Sunset_Flooding::forwardPacket(Packet * p)
 	}
 	
 	
-	// insert this packet in the processed packets structure
-	
 	Sunset_Trace::print_info("rtg - (%f) Node:%d - FLOODING forwards pkt: id %d size %d from %d to %d hops %d\n", NOW, getModuleAddress(), cmh->uid(), cmh->size(), src, dst, cmh->num_forwards());
 	
-   	pktForwardedInfo[src].insert(id);
-	
   	// I am the packet originator, initialize the data
 	if (src == getModuleAddress()) {
 		
@@ -241,7 +237,7 @@ void Sunset_Flooding::forwardPacket(Packet * p)
 	
 	if (cmh->num_forwards() > max_forwards_) {
 		
-		Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Flooding::forwardPacket pkt for %d TOO MANY FORWARDS DISCARD", dst);
+		SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Flooding::forwardPacket pkt for %d TOO MANY FORWARDS DISCARD", dst);
 		Sunset_Utilities::erasePkt(p, getModuleAddress());
 		
 		return;
@@ -253,7 +249,7 @@ void Sunset_Flooding::forwardPacket(Packet * p)
      	
 	if (rand > probability_) {
 		
-		Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Flooding::forwardPacket pkt for %d probability DISCARDING %f", dst, rand);
+		SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Flooding::forwardPacket pkt for %d probability DISCARDING %f", dst, rand);
 		Sunset_Utilities::erasePkt(p, getModuleAddress());
 		
 		return;
@@ -261,7 +257,7 @@ void Sunset_Flooding::forwardPacket(Packet * p)
 	
 	cmh->next_hop_ = Sunset_Address::getBroadcastAddress();
 	
-    	Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Flooding::forwardPacket forwarding to node: %d", cmh->next_hop_);
+    	SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Flooding::forwardPacket forwarding to node: %d", cmh->next_hop_);
     	
     	/* if the max_random_time_ is set (!= 0) I'll wait a random time before forwarding the data packet. */
 	
@@ -292,7 +288,7 @@ void Sunset_Flooding::sendPkt()
 	
 	if (pktList.empty()) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Flooding::sendPkt NO PACKET ERROR");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Flooding::sendPkt NO PACKET ERROR");
 		return;
 	}
 	
@@ -312,6 +308,8 @@ void Sunset_Flooding::sendPkt()
  */
 void Sunset_Flooding::start()
 {
+	Sunset_Routing::start();
+	
 	return;
 }
 
@@ -1,6 +1,8 @@
 static char code[] = "\n\
 Module/Sunset_Routing set moduleAddress -1\n\
 Module/Sunset_Routing set debug_ false\n\
+Module/Sunset_Routing set dupWindow_ 8192\n\
+Module/Sunset_Routing set dupExpiry_ 0.0\n\
 \n\
 PacketHeaderManager set tab_(PacketHeader/Sunset_Routing) 1\n\
 ";
@@ -0,0 +1,215 @@
+/* SUNSET - Sapienza University Networking framework for underwater Simulation, Emulation and real-life Testing
+ *
+ * Copyright (C) 2012 Regents of UWSN Group of SENSES Lab <http://reti.dsi.uniroma1.it/SENSES_lab/>
+ *
+ * Author: Roberto Petroccia - petroccia@di.uniroma1.it
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License as published
+ * at http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANATBILITY or FITNESS FOR A PARTICULAR PURPOSE. See the Creative Commons
+ * Attribution-NonCommercial-ShareAlike 3.0 Unported License for more details.
+ *
+ * You should have received a copy of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License
+ * along with this program. If not, see <http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode>.
+ */
+
+
+#ifndef __Sunset_Duplicate_Filter_h__
+#define __Sunset_Duplicate_Filter_h__
+
+#include <vector>
+#include <string.h>
+
+using namespace std;
+
+#define SUNSET_DUP_WINDOW		8192	/*!< @brief Default number of packet IDs tracked for each source (1 KB for each source). */
+#define SUNSET_DUP_MAX_SOURCES		65536	/*!< @brief Sources with a larger ID are not filtered. */
+
+/*! @brief The sliding window of the packet IDs already processed for a source. Bit i of the window is set if packet 
+ *  "highest - i" has been processed.
+ */
+
+typedef struct sunset_dup_window {
+	
+	int highest;			// highest packet ID processed for the source
+	double lastTime;		// last time a packet of the source has been processed
+	vector<unsigned int> bits;	// empty until the first packet of the source is processed
+	
+} sunset_dup_window;
+
+/*! @brief This class keeps track of the packets already forwarded using, for each source, a bitmap of the last "window" 
+ *  packet IDs. Checking and inserting a packet is O(1) and the memory used for each source does not change over time.
+ *  A packet older than the window cannot be checked: it is considered as duplicated and counted as overflow, if 
+ *  overflows are frequent the window has to be increased. If no packet is received from a source for "expiry" 
+ *  seconds its window is reset, e.g. after a node reboot the packet IDs start again from 0. An expiry of 0 disables it.
+ *  The routing modules check the packet uid: it is assigned by a counter shared by all the nodes of a simulation (the 
+ *  Sunset_Agent pktId is set to the same value), so the IDs of a source are not consecutive and the window is measured 
+ *  in packets generated by the whole network. It has to cover all the packets generated in the network while a packet 
+ *  can still be forwarded, the default allows 8192 of them.
+ */
+
+class Sunset_Duplicate_Filter {
+	
+public:
+	
+	Sunset_Duplicate_Filter(int window = SUNSET_DUP_WINDOW, double expiry = 0.0) 
+	{ 
+		setWindow(window); 
+		expiry_ = expiry; 
+		accepted_ = duplicates_ = overflows_ = expired_ = 0; 
+	}
+	
+	/*! @brief The setWindow function sets the number of IDs tracked for each source (rounded to a multiple of 32) 
+	 *  and resets all the windows.
+	 */
+	
+	void setWindow(int window)
+	{
+		if ( window < 32 ) {
+			
+			window = 32;
+		}
+		
+		words_ = (window + 31) / 32;
+		
+		windows_.clear();
+	}
+	
+	void setExpiry(double expiry) { expiry_ = expiry; }
+	
+	/*! @brief The check function returns true if the packet "id" of "src" has already been processed, otherwise 
+	 *  it marks the packet as processed and returns false.
+	 */
+	
+	bool check(int src, int id, double now)
+	{
+		sunset_dup_window* w = 0;
+		unsigned int d = 0;
+		
+		if ( src < 0 || src >= SUNSET_DUP_MAX_SOURCES ) {
+			
+			accepted_++;
+			
+			return false;
+		}
+		
+		if ( src >= (int)windows_.size() ) {
+			
+			windows_.resize(src + 1);
+		}
+		
+		w = &(windows_[src]);
+		
+		if ( w->bits.empty() ) {
+			
+			w->bits.assign(words_, 0);
+			reset(w, id);
+		}
+		else if ( expiry_ > 0.0 && now - w->lastTime > expiry_ ) {
+			
+			expired_++;
+			reset(w, id);
+		}
+		
+		w->lastTime = now;
+		
+		if ( id > w->highest ) {
+			
+			shift(w, (unsigned int)id - (unsigned int)w->highest);
+			w->highest = id;
+			w->bits[0] |= 1;
+			accepted_++;
+			
+			return false;
+		}
+		
+		d = (unsigned int)w->highest - (unsigned int)id;
+		
+		if ( d >= (unsigned int)words_ * 32 ) {
+			
+			overflows_++;
+			
+			return true;
+		}
+		
+		if ( w->bits[d >> 5] & (1u << (d & 31)) ) {
+			
+			duplicates_++;
+			
+			return true;
+		}
+		
+		w->bits[d >> 5] |= (1u << (d & 31));
+		accepted_++;
+		
+		return false;
+	}
+	
+	/*! @brief The clear function removes the information of all the sources. */
+	void clear() { windows_.clear(); }
+	
+	int getWindow() { return words_ * 32; }
+	double getExpiry() { return expiry_; }
+	
+	long getAccepted() { return accepted_; }
+	long getDuplicates() { return duplicates_; }
+	long getOverflows() { return overflows_; }
+	long getExpired() { return expired_; }
+	
+private:
+	
+	/*! @brief The reset function empties the window, the next packet processed is "id - 1". */
+	
+	void reset(sunset_dup_window* w, int id)
+	{
+		memset(&(w->bits[0]), 0, words_ * sizeof(unsigned int));
+		w->highest = id - 1;
+	}
+	
+	/*! @brief The shift function moves the window forward by n IDs. */
+	
+	void shift(sunset_dup_window* w, unsigned int n)
+	{
+		unsigned int words = n >> 5;
+		unsigned int bits = n & 31;
+		
+		if ( n >= (unsigned int)words_ * 32 ) {
+			
+			memset(&(w->bits[0]), 0, words_ * sizeof(unsigned int));
+			
+			return;
+		}
+		
+		for ( int i = words_ - 1; i >= 0; i-- ) {
+			
+			unsigned int v = 0;
+			
+			if ( i >= (int)words ) {
+				
+				v = w->bits[i - words] << bits;
+				
+				if ( bits > 0 && i > (int)words ) {
+					
+					v |= w->bits[i - words - 1] >> (32 - bits);
+				}
+			}
+			
+			w->bits[i] = v;
+		}
+	}
+	
+	vector<sunset_dup_window> windows_;	// indexed by source ID
+	int words_;
+	double expiry_;
+	
+	long accepted_;
+	long duplicates_;
+	long overflows_;
+	long expired_;
+};
+
+#endif
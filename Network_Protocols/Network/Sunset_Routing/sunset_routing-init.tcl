@@ -2,4 +2,6 @@
 
 Module/Sunset_Routing set moduleAddress -1
 Module/Sunset_Routing set debug_ false
+Module/Sunset_Routing set dupWindow_ 8192
+Module/Sunset_Routing set dupExpiry_ 0.0
 
@@ -44,9 +44,13 @@ public:
 Sunset_Routing::Sunset_Routing() : Module() 
 {
 	module_address = -1;
+	dupWindow_ = SUNSET_DUP_WINDOW;
+	dupExpiry_ = 0.0;
 	
 	// Get variables initialization from the Tcl script
 	bind("moduleAddress", &module_address);
+	bind("dupWindow_", &dupWindow_);
+	bind("dupExpiry_", &dupExpiry_);
 }
 
 /*!
@@ -68,7 +72,7 @@ int Sunset_Routing::command(int argc, const char*const* argv)
 		
 		if (strcmp(argv[1], "start") == 0) {
 			
-			Sunset_Debug::debugInfo(1, getModuleAddress(), "Sunset_Routing::command start Module");
+			SUNSET_DEBUG_LOG(1, getModuleAddress(), "Sunset_Routing::command start Module");
 			
 			start();
 			
@@ -83,6 +87,18 @@ int Sunset_Routing::command(int argc, const char*const* argv)
 			
 			return TCL_OK;
 		}
+		
+		/* The "getDuplicateStats" command returns the counters of the duplicate detection: 
+		 * accepted packets, duplicated packets, packets older than the window and expired sources. 
+		 */
+		
+		if (strcmp(argv[1], "getDuplicateStats") == 0) {
+			
+			tcl.resultf("%ld %ld %ld %ld", pktForwardedInfo.getAccepted(), pktForwardedInfo.getDuplicates(), 
+				    pktForwardedInfo.getOverflows(), pktForwardedInfo.getExpired());
+			
+			return TCL_OK;
+		}
 	}
 	else if (argc == 3) {
 		
@@ -99,7 +115,7 @@ int Sunset_Routing::command(int argc, const char*const* argv)
 			
 			int dest = atoi(argv[2]);
 			
-			Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Routing::command getNextHop to %d", dest);
+			SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Routing::command getNextHop to %d", dest);
 			
 			tcl.resultf("%d", getNextHop(dest));
 			
@@ -111,7 +127,7 @@ int Sunset_Routing::command(int argc, const char*const* argv)
 			
 			module_address = atoi(argv[2]);
 			
-			Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Routing::command module_address %d", module_address);
+			SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Routing::command module_address %d", module_address);
 			
 			return TCL_OK;
 		}
@@ -131,7 +147,7 @@ int Sunset_Routing::getNextHop(int dest)
 	
 	if ( routingTable.find(dest) == routingTable.end() ) {
 		
-		Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Routing::getNextHop no next_hop available return broadcast address");
+		SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Routing::getNextHop no next_hop available return broadcast address");
 		
 		return Sunset_Address::getBroadcastAddress();
 	}
@@ -151,7 +167,7 @@ void Sunset_Routing::recv(Packet *p)
 	int src = (int)iph->saddr() ;
 	int dst = (int)iph->daddr() ;
 	
-	Sunset_Debug::debugInfo(5, getModuleAddress(),  "Sunset_Routing::recv receiving something id %d size %d from %d to %d", cmh->uid(), cmh->size(), src, dst);
+	SUNSET_DEBUG_LOG(5, getModuleAddress(),  "Sunset_Routing::recv receiving something id %d size %d from %d to %d", cmh->uid(), cmh->size(), src, dst);
 	
 	/* Packet coming from the upper layer.*/
 	
@@ -169,7 +185,7 @@ void Sunset_Routing::recv(Packet *p)
 	
 	if (dst == getModuleAddress() || (dst == (int)Sunset_Address::getBroadcastAddress() && src != getModuleAddress())) {
 		
-		Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Routing::recv received pkt for %d", dst);
+		SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Routing::recv received pkt for %d", dst);
 		
 		sendUp(p);
 		
@@ -203,12 +219,10 @@ void Sunset_Routing::forwardPacket(Packet * p)
 	
 	cmh->direction() = hdr_cmn::DOWN;
 	
-	// if I have already processed this packet return to avoid to forward several times the same packet
-	if (pktForwardedInfo.find(src) != pktForwardedInfo.end() && 
-	    (pktForwardedInfo[src]).find(id) != (pktForwardedInfo[src]).end()) {
-		
+	// if I have already processed this packet return to avoid to forward several times the same packet, otherwise keep track of it
+	if (isForwarded(src, id)) {
 		
-		Sunset_Debug::debugInfo(1, getModuleAddress(), "Sunset_Routing::forwardPacket to node:%d DUPLICATE pkt", dst);
+		SUNSET_DEBUG_LOG(1, getModuleAddress(), "Sunset_Routing::forwardPacket to node:%d DUPLICATE pkt", dst);
 		
 		Sunset_Trace::print_info("rtg - (%f) Node:%d - ROUTING duplicated pkt not forwarded: id %d size %d from %d to %d hops %d\n", NOW, getModuleAddress(), cmh->uid(), cmh->size(), src, dst, cmh->num_forwards());
 		
@@ -217,16 +231,13 @@ void Sunset_Routing::forwardPacket(Packet * p)
 		return;
 	}
 	
-	// insert this packet in the processed packets structure
-	pktForwardedInfo[src].insert(id);
-	
 	Sunset_Trace::print_info("rtg - (%f) Node:%d - ROUTING forwards pkt: id %d size %d from %d to %d hops %d\n", NOW, getModuleAddress(), cmh->uid(), cmh->size(), src, dst, cmh->num_forwards());
 	
 	if (dst == (int)Sunset_Address::getBroadcastAddress()) {
 		
 		cmh->next_hop_ = dst;
 		
-		Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Routing::forwardPacket to node:%d", cmh->next_hop_);		
+		SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Routing::forwardPacket to node:%d", cmh->next_hop_);		
 		
 		sendDown(p);
 		
@@ -237,7 +248,7 @@ void Sunset_Routing::forwardPacket(Packet * p)
 	// if no information are in the routing table send the packet in broadcast
 	if (routingTable.find(iph -> daddr()) == routingTable.end()) {
 		
-		Sunset_Debug::debugInfo(1, getModuleAddress(), "Sunset_Routing::forwardPacket to node:%d but no route is available, send in broadcast", dst);
+		SUNSET_DEBUG_LOG(1, getModuleAddress(), "Sunset_Routing::forwardPacket to node:%d but no route is available, send in broadcast", dst);
 		
 		cmh->next_hop_ = Sunset_Address::getBroadcastAddress();
 		
@@ -248,7 +259,7 @@ void Sunset_Routing::forwardPacket(Packet * p)
 	
 	cmh->next_hop_ = routingTable[iph->daddr()];
 	
-	Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Routing::forwardPacket to node:%d", cmh->next_hop_);
+	SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Routing::forwardPacket to node:%d", cmh->next_hop_);
 	
 	sendDown(p);
 }
@@ -259,9 +270,33 @@ void Sunset_Routing::forwardPacket(Packet * p)
 
 void Sunset_Routing::start()
 {
+	pktForwardedInfo.setWindow(dupWindow_);
+	pktForwardedInfo.setExpiry(dupExpiry_);
+	
 	return;
 }
 
+/*!
+ * 	@brief The isForwarded function checks if a packet has already been processed using a sliding window of packet IDs for 
+ *	each source, the memory used does not grow with the number of packets. If the packet is new it is marked as processed.
+ *	@param src The packet source.
+ *	@param id The packet ID.
+ *	@retval true If the packet has already been processed or it is older than the window.
+ */
+
+bool Sunset_Routing::isForwarded(int src, int id)
+{
+	long overflows = pktForwardedInfo.getOverflows();
+	bool ret = pktForwardedInfo.check(src, id, NOW);
+	
+	if ( pktForwardedInfo.getOverflows() != overflows ) {
+		
+		SUNSET_DEBUG_LOG(1, getModuleAddress(), "Sunset_Routing::isForwarded pkt %d from %d older than the window (%d) overflows %ld", id, src, pktForwardedInfo.getWindow(), pktForwardedInfo.getOverflows());
+	}
+	
+	return ret;
+}
+
 /*!
  * 	@brief The stop() function can be called from the TCL scripts to execute routing module operations when the simulation/emulation stops.
  */
@@ -275,7 +310,7 @@ int Sunset_Routing::recvSyncClMsg(ClMessage* m)
 {
 	
 	/* If the data packet transmission has been aborted ... */
-	Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Routing::recvSyncClMsg mType %d", m->type());
+	SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Routing::recvSyncClMsg mType %d", m->type());
 	
 	if (m->type() == CLMSG_MAC2RTG_PKT_TRANSMITTED) {
 		
@@ -36,6 +36,7 @@
 #include <sunset_address.h>
 #include <sunset_debug.h>
 #include <sunset_mac2rtg-clmsg.h>
+#include <sunset_duplicate_filter.h>
 
 /*! \brief The generic Routing layer class - it does not implement any methods to update the routing table. Other routing  solutions have to extend this class and implements these methods. */
 
@@ -61,10 +62,16 @@ protected:
 	/*! @brief The getNextHop returns the ID of the next hop realy for packetd addressed to node dest. */
 	int getNextHop(int dest);
 	
+	/*! @brief The isForwarded function returns true if the packet has already been processed, otherwise it keeps track of it. */
+	bool isForwarded(int src, int id);
+	
 protected:
 	map<int, int> routingTable; // routing table <destination, next hop>
 	
-	map<int, set<int> > pktForwardedInfo; // keep track of packet already forwarded
+	Sunset_Duplicate_Filter pktForwardedInfo; // keep track of packet already forwarded, see dupWindow_ and dupExpiry_
+	
+	int dupWindow_;		/*!< @brief Number of packet uids tracked for each source to detect duplicated packets, uids are shared by all the nodes. */
+	double dupExpiry_;	/*!< @brief Time (sec) after which the packet IDs of a silent source are forgotten, 0 to disable. */
 	
 private:
 	virtual void txDone(const Packet *);
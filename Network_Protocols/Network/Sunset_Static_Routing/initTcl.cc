@@ -1,9 +1,13 @@
 static char code[] = "\n\
 Module/Sunset_Routing set moduleAddress -1\n\
 Module/Sunset_Routing set debug_ false\n\
+Module/Sunset_Routing set dupWindow_ 1024\n\
+Module/Sunset_Routing set dupExpiry_ 0.0\n\
 \n\
 Module/Sunset_Static_Routing set moduleAddress -1\n\
 Module/Sunset_Static_Routing set debug_ false\n\
+Module/Sunset_Static_Routing set dupWindow_ 1024\n\
+Module/Sunset_Static_Routing set dupExpiry_ 0.0\n\
 \n\
 ";
 #include "tclcl.h"
@@ -2,7 +2,11 @@
 
 Module/Sunset_Routing set moduleAddress -1
 Module/Sunset_Routing set debug_ false
+Module/Sunset_Routing set dupWindow_ 1024
+Module/Sunset_Routing set dupExpiry_ 0.0
 
 Module/Sunset_Static_Routing set moduleAddress -1
 Module/Sunset_Static_Routing set debug_ false
+Module/Sunset_Static_Routing set dupWindow_ 1024
+Module/Sunset_Static_Routing set dupExpiry_ 0.0
 
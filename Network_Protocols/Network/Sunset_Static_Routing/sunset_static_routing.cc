@@ -85,7 +85,7 @@ int Sunset_Static_Routing::command(int argc, const char*const* argv)
 			
 			routingTable[dest] = relay;
 			
-			Sunset_Debug::debugInfo(5, getModuleAddress(), "ROUTING route (dest %d - relay %d) added", dest, relay);
+			SUNSET_DEBUG_LOG(5, getModuleAddress(), "ROUTING route (dest %d - relay %d) added", dest, relay);
 			
 			return TCL_OK;
 		}
@@ -99,7 +99,7 @@ int Sunset_Static_Routing::command(int argc, const char*const* argv)
 			
 			routingTable[dest] = relay;
 			
-			Sunset_Debug::debugInfo(5, getModuleAddress(), "ROUTING nextHop route (dest %d - relay %d) added", dest, relay);
+			SUNSET_DEBUG_LOG(5, getModuleAddress(), "ROUTING nextHop route (dest %d - relay %d) added", dest, relay);
 			
 			return TCL_OK;
 		}
@@ -129,7 +129,7 @@ void Sunset_Static_Routing::forwardPacket(Packet * p)
 	//if I do not have any relay node for the current packet discard it
 	if (iph -> daddr() != Sunset_Address::getBroadcastAddress() && routingTable.find(iph -> daddr()) == routingTable.end()) {
 		
-		Sunset_Debug::debugInfo(1, getModuleAddress(), "Sunset_Static_Routing::forwardPacket to node:%d but no route is available, delete pkt", 
+		SUNSET_DEBUG_LOG(1, getModuleAddress(), "Sunset_Static_Routing::forwardPacket to node:%d but no route is available, delete pkt", 
 					dst);
 		
 		Sunset_Trace::print_info("rtg - (%f) Node:%d - STATIC no route discard: id %d size %d from %d to %d hops %d\n", NOW, getModuleAddress(), cmh->uid(), cmh->size(), src, dst, cmh->num_forwards());
@@ -79,7 +79,7 @@ void Sunset_Phy::start()
 {
 	Sunset_Module::start(); // call father's start function
 	
-	Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Phy::start");
+	SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Phy::start");
 	
 	if ( use_pkt_error == 1 ) {
 		
@@ -97,7 +97,7 @@ void Sunset_Phy::stop()
 	
 	pkt_error = NULL;
 	
-	Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Phy::stop");
+	SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Phy::stop");
 	
 }
 
@@ -139,7 +139,7 @@ int Sunset_Phy::command(int argc, const char*const* argv)
 			
 			module_address = atoi(argv[2]);
 			
-			Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Phy::command getModuleAddress() %d", getModuleAddress());
+			SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Phy::command getModuleAddress() %d", getModuleAddress());
 			
 			return (TCL_OK);
 		}
@@ -150,7 +150,7 @@ int Sunset_Phy::command(int argc, const char*const* argv)
 			
 			use_pkt_error = atoi(argv[2]);
 			
-			Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Phy::command usePktErrorModel %d", use_pkt_error);
+			SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Phy::command usePktErrorModel %d", use_pkt_error);
 			
 			return (TCL_OK);
 		}
@@ -161,7 +161,7 @@ int Sunset_Phy::command(int argc, const char*const* argv)
 			
 			blackList.insert(atoi(argv[2]));
 			
-			Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Phy::command Blacklist %d", atoi(argv[2]));
+			SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Phy::command Blacklist %d", atoi(argv[2]));
 			
 			return (TCL_OK);
 		}
@@ -172,7 +172,7 @@ int Sunset_Phy::command(int argc, const char*const* argv)
 			
 			use_ch_emu = atoi(argv[2]);
 
-			Sunset_Debug::debugInfo(3, getModuleAddress(), "Sunset_Phy::command useChEmulator %d", use_ch_emu);
+			SUNSET_DEBUG_LOG(3, getModuleAddress(), "Sunset_Phy::command useChEmulator %d", use_ch_emu);
 			
 			return (TCL_OK);
 		}
@@ -214,11 +214,11 @@ void Sunset_Phy::startTx(Packet* p)
 		
 		txBusy_.start(timeout);
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Phy::starTx - end transmission at %f p %p aux %p ", Sunset_Utilities::get_now() + timeout, p, aux);
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Phy::starTx - end transmission at %f p %p aux %p ", Sunset_Utilities::get_now() + timeout, p, aux);
 
 	}
 
-	Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Phy::startTx");
+	SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Phy::startTx");
 	
 	sendDown(p);
 }
@@ -233,7 +233,7 @@ void Sunset_Phy::endTx(Packet* p)
 	
 	if ( use_ch_emu == 1 && !txBusy_.busy() ) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Phy::endTx ERROR");
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Phy::endTx ERROR");
 		
 		exit(1);
 		return;
@@ -243,7 +243,7 @@ void Sunset_Phy::endTx(Packet* p)
 	
 		txPending = false;
 	
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Phy::endTx p %p", p);
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Phy::endTx p %p", p);
 		
 		Phy2MacEndTx(p);
 	}
@@ -275,17 +275,17 @@ void Sunset_Phy::startRx(Packet* p)
 		
 			PktRx = p;
 			
-			Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Phy::startRx");
+			SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Phy::startRx");
 		}
 		else {
 			PktRx = p;
 						
-			Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Phy::startRx Node %d is in BlackList", SUNSET_HDR_CMN(p)->phy_src );
+			SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Phy::startRx Node %d is in BlackList", SUNSET_HDR_CMN(p)->phy_src );
 		}
 	}
 	else {
 		
-		Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Phy::startRx");
+		SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Phy::startRx");
 	}
 	
 	Phy2MacStartRx(p);
@@ -300,13 +300,13 @@ void Sunset_Phy::startRx(Packet* p)
 void Sunset_Phy::endRx(Packet* p) 
 {
 	
-	Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Phy::endRx Node src %d dst %d is in BlackList %d", 
+	SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Phy::endRx Node src %d dst %d is in BlackList %d", 
 				SUNSET_HDR_CMN(p)->phy_src, SUNSET_HDR_CMN(p)->phy_dst,
 				blackList.find(SUNSET_HDR_CMN(p)->phy_src) != blackList.end() );
 
 	if ( blackList.find(SUNSET_HDR_CMN(p)->phy_src) != blackList.end() ) {
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Phy::endRx Node %d is in BlackList", SUNSET_HDR_CMN(p)->phy_src );
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Phy::endRx Node %d is in BlackList", SUNSET_HDR_CMN(p)->phy_src );
 		
 		HDR_CMN(p)->error() = 1;
 		
@@ -317,7 +317,7 @@ void Sunset_Phy::endRx(Packet* p)
 	
 	if ( use_ch_emu == 0 ) {
 	
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Phy::endRx use_pkt_error %d - model %d", 
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Phy::endRx use_pkt_error %d - model %d", 
 					use_pkt_error, pkt_error != NULL);
 		
 		if ( use_pkt_error && pkt_error != NULL ) {
@@ -328,7 +328,7 @@ void Sunset_Phy::endRx(Packet* p)
 			
 			if ( error_n ) {
 				
-				Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Phy::endRx PER ERROR %f <= %f", rand, per);
+				SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Phy::endRx PER ERROR %f <= %f", rand, per);
 				HDR_CMN(p)->error() = error_n;
 			}
 		}
@@ -342,7 +342,7 @@ void Sunset_Phy::endRx(Packet* p)
 
 		timeout = HDR_CMN(p)->txtime();
 		
-		Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Phy::endRx Timeout %f", timeout);
+		SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Phy::endRx Timeout %f", timeout);
 					
 		if ( rxBusy_.size() == 0 ) {
 		
@@ -391,7 +391,7 @@ void Sunset_Phy::txAborted(Packet* p)
 {
 	txPending = false;
 	
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Phy::txAborted");
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Phy::txAborted");
 	
 	Phy2MacTxAborted(p);
 	
@@ -424,7 +424,7 @@ void Sunset_Phy::recv(Packet* p)
 	}    
 	else {
 		
-		Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Phy::recv DOWN");
+		SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Phy::recv DOWN");
 		
 		startTx(p);		
 	}
@@ -437,7 +437,7 @@ void Sunset_Phy::recv(Packet* p)
 
 void Sunset_Phy::Modem2PhyEndTx(const Packet* p) 
 {
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Phy::Modem2PhyEndTx");
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Phy::Modem2PhyEndTx");
 	
 	endTx((Packet*)p);
 }
@@ -449,7 +449,7 @@ void Sunset_Phy::Modem2PhyEndTx(const Packet* p)
 
 void Sunset_Phy::Modem2PhyTxAborted(const Packet* p) 
 {
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Phy::Modem2PhyTxAborted");
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Phy::Modem2PhyTxAborted");
 	
 	txAborted((Packet*)p);
 }
@@ -461,7 +461,7 @@ void Sunset_Phy::Modem2PhyTxAborted(const Packet* p)
 
 void Sunset_Phy::Modem2PhyStartRx(const Packet* p) 
 {
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Phy::Modem2PhystartRx");
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Phy::Modem2PhystartRx");
 		
 	startRx((Packet*)p);
 }
@@ -473,7 +473,7 @@ void Sunset_Phy::Modem2PhyStartRx(const Packet* p)
 
 void Sunset_Phy::Modem2PhyEndRx(Packet* p) 
 {
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Phy::Modem2PhyEndRx");
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Phy::Modem2PhyEndRx");
 	endRx(p);
 }
 
@@ -484,17 +484,17 @@ void Sunset_Phy::Modem2PhyEndRx(Packet* p)
 
 int Sunset_Phy::recvSyncClMsg(ClMessage* m)
 {
-	Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Phy::recvSyncClMsg type %d", m->type());
+	SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Phy::recvSyncClMsg type %d", m->type());
 	if (m->type() == CLMSG_MODEM2PHY_TXABORTED) {
 		
-		Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Phy::recvSyncClMsg TX ABORTED p %p", ((ClMsgModem2PhyTxAborted*)m)->pkt);
+		SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Phy::recvSyncClMsg TX ABORTED p %p", ((ClMsgModem2PhyTxAborted*)m)->pkt);
 		Modem2PhyTxAborted(((ClMsgModem2PhyTxAborted*)m)->pkt);
 		
 		return 0;
 	}
 	else if (m->type() == CLMSG_MODEM2PHY_ENDTX) {
 		
-		Sunset_Debug::debugInfo(4, getModuleAddress(), "Sunset_Phy::recvSyncClMsg END TX p %p", ((ClMsgModem2PhyTxAborted*)m)->pkt);
+		SUNSET_DEBUG_LOG(4, getModuleAddress(), "Sunset_Phy::recvSyncClMsg END TX p %p", ((ClMsgModem2PhyTxAborted*)m)->pkt);
 		Modem2PhyEndTx(((ClMsgModem2PhyEndTx*)m)->pkt);
 		
 		return 0;
@@ -581,7 +581,7 @@ void Sunset_Phy_Tx_Timer::handle(Event *)
 	stime = 0.0;
 	rtime = 0.0;
 	
-	Sunset_Debug::debugInfo(-1, t_->getModuleAddress(), "Sunset_Phy_Tx_Timer::handle");
+	SUNSET_DEBUG_LOG(-1, t_->getModuleAddress(), "Sunset_Phy_Tx_Timer::handle");
 
 	(t_)->hTxBusyTimeout(this->p);
 }
@@ -593,7 +593,7 @@ void Sunset_Phy_Rx_Timer::handle(Event *)
 	stime = 0.0;
 	rtime = 0.0;
 	
-	Sunset_Debug::debugInfo(-1, t_->getModuleAddress(), "Sunset_Phy_Rx_Timer::handle");
+	SUNSET_DEBUG_LOG(-1, t_->getModuleAddress(), "Sunset_Phy_Rx_Timer::handle");
 
 	(t_)->hRxBusyTimeout(this->p, this->id);
 }
@@ -602,7 +602,7 @@ void Sunset_Phy::hTxBusyTimeout(Packet *p)
 {
 	txPending = false;
 	
-	Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Phy::endTx2 p %p", p);
+	SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Phy::endTx2 p %p", p);
 	
 	Phy2MacEndTx(p);
 	
@@ -619,7 +619,7 @@ void Sunset_Phy::hRxBusyTimeout(Packet *p, int id)
 		
 		if ( error_n ) {
 			
-			Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Phy::endRx PER ERROR %f <= %f", rand, per);
+			SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Phy::endRx PER ERROR %f <= %f", rand, per);
 			HDR_CMN(p)->error() = error_n;
 		}
 	}
@@ -627,7 +627,7 @@ void Sunset_Phy::hRxBusyTimeout(Packet *p, int id)
 	delete rxBusy_[id];
 	(rxBusy_).erase(id);
 
-	Sunset_Debug::debugInfo(-1, getModuleAddress(), "Sunset_Phy::endRx");
+	SUNSET_DEBUG_LOG(-1, getModuleAddress(), "Sunset_Phy::endRx");
 
 	sendUp(p);
 	
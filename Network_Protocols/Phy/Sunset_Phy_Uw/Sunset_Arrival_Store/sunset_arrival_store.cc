@@ -0,0 +1,458 @@
+/* SUNSET - Sapienza University Networking framework for underwater Simulation, Emulation and real-life Testing
+ *
+ * Copyright (C) 2012 Regents of UWSN Group of SENSES Lab <http://reti.dsi.uniroma1.it/SENSES_lab/>
+ *
+ * Author: Roberto Petroccia - petroccia@di.uniroma1.it
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License as published
+ * at http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANATBILITY or FITNESS FOR A PARTICULAR PURPOSE. See the Creative Commons
+ * Attribution-NonCommercial-ShareAlike 3.0 Unported License for more details.
+ *
+ * You should have received a copy of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License
+ * along with this program. If not, see <http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode>.
+ */
+
+
+#include "sunset_arrival_store.h"
+
+#include <stdio.h>
+#include <math.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+Sunset_Arrival_Store::Sunset_Arrival_Store() 
+{
+	data = 0;
+	size = 0;
+	fd = -1;
+	journalFd = -1;
+	table = 0;
+	
+	hits = 0;
+	misses = 0;
+	recorded = 0;
+	
+	memset(&header, 0, sizeof(sunset_arrival_header));
+}
+
+Sunset_Arrival_Store::~Sunset_Arrival_Store() 
+{
+	close();
+}
+
+/*!
+ * 	@brief The open function maps the store in memory and checks the file header. The mapping is read-only and shared
+ *	among all the processes opening the same store.
+ *	@param path The store file.
+ *	@retval true If the file is a valid store, false otherwise (getError() describes the problem).
+ */
+
+bool Sunset_Arrival_Store::open(const char* path) 
+{
+	struct stat st;
+	void* addr = 0;
+	
+	if ( data != 0 ) {
+		
+		munmap((void*)data, size);
+		::close(fd);
+		
+		data = 0;
+		size = 0;
+		fd = -1;
+	}
+	
+	table = 0;
+	
+	fd = ::open(path, O_RDONLY);
+	
+	if ( fd < 0 ) {
+		
+		error = string("cannot open ") + path;
+		
+		return false;
+	}
+	
+	if ( fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(sunset_arrival_header) ) {
+		
+		error = string("invalid arrival store ") + path;
+		::close(fd);
+		fd = -1;
+		
+		return false;
+	}
+	
+	size = st.st_size;
+	addr = mmap(0, size, PROT_READ, MAP_SHARED, fd, 0);
+	
+	if ( addr == MAP_FAILED ) {
+		
+		error = string("cannot map ") + path;
+		size = 0;
+		::close(fd);
+		fd = -1;
+		
+		return false;
+	}
+	
+	data = (const char*)addr;
+	memcpy(&header, data, sizeof(sunset_arrival_header));
+	
+	if ( memcmp(header.magic, SUNSET_ARRIVAL_MAGIC, 4) != 0 || header.version > SUNSET_ARRIVAL_VERSION 
+	    || header.headerSize < sizeof(sunset_arrival_header) || header.capacity == 0 
+	    || (header.capacity & (header.capacity - 1)) != 0
+	    || header.headerSize + (size_t)header.capacity * sizeof(sunset_arrival_record) > size ) {
+		
+		error = string("not a valid SUNSET arrival store ") + path;
+		munmap((void*)data, size);
+		::close(fd);
+		
+		data = 0;
+		size = 0;
+		fd = -1;
+		
+		return false;
+	}
+	
+	// the lookups hit random records of the table
+	
+	madvise(addr, size, MADV_RANDOM);
+	
+	table = (const sunset_arrival_record*)(data + header.headerSize);
+	
+	return true;
+}
+
+/*!
+ * 	@brief The setJournal function opens the journal where the links missing in the store are appended. 
+ *	The file is opened in append mode, several processes can share it.
+ *	@param path The journal file.
+ */
+
+bool Sunset_Arrival_Store::setJournal(const char* path) 
+{
+	if ( journalFd >= 0 ) {
+		
+		::close(journalFd);
+	}
+	
+	journalFd = ::open(path, O_WRONLY | O_APPEND | O_CREAT, 0644);
+	
+	if ( journalFd < 0 ) {
+		
+		error = string("cannot open journal ") + path;
+		
+		return false;
+	}
+	
+	return true;
+}
+
+void Sunset_Arrival_Store::close() 
+{
+	if ( data != 0 ) {
+		
+		munmap((void*)data, size);
+	}
+	
+	if ( fd >= 0 ) {
+		
+		::close(fd);
+	}
+	
+	if ( journalFd >= 0 ) {
+		
+		::close(journalFd);
+	}
+	
+	data = 0;
+	table = 0;
+	size = 0;
+	fd = -1;
+	journalFd = -1;
+}
+
+/*!
+ * 	@brief The lookup function searches the given link in the store.
+ *	@param l The link, the gain field is not used.
+ *	@param gain The gain stored for the link.
+ *	@retval true If the link has been found.
+ */
+
+bool Sunset_Arrival_Store::lookup(const sunset_arrival_link& l, double& gain) 
+{
+	sunset_arrival_key k;
+	uint32_t mask = 0;
+	uint32_t i = 0;
+	uint32_t n = 0;
+	
+	if ( table == 0 ) {
+		
+		misses++;
+		
+		return false;
+	}
+	
+	quantize(header, l, k);
+	
+	mask = header.capacity - 1;
+	i = hash(k) & mask;
+	
+	for ( n = 0; n < header.capacity && table[i].used != 0; n++ ) {
+		
+		if ( memcmp(&(table[i].key), &k, sizeof(sunset_arrival_key)) == 0 ) {
+			
+			gain = table[i].gain;
+			hits++;
+			
+			return true;
+		}
+		
+		i = (i + 1) & mask;
+	}
+	
+	misses++;
+	
+	return false;
+}
+
+/*!
+ * 	@brief The record function appends the given link to the journal. A single write is used for each record, 
+ *	records of concurrent processes are not interleaved.
+ *	@param l The link computed by the PHY.
+ */
+
+bool Sunset_Arrival_Store::record(const sunset_arrival_link& l) 
+{
+	ssize_t ret = 0;
+	
+	if ( journalFd < 0 ) {
+		
+		return false;
+	}
+	
+	ret = write(journalFd, &l, sizeof(sunset_arrival_link));
+	
+	if ( ret != (ssize_t)sizeof(sunset_arrival_link) ) {
+		
+		error = "journal write error";
+		
+		return false;
+	}
+	
+	recorded++;
+	
+	return true;
+}
+
+/*!
+ * 	@brief The quantize function computes the key of the given link according to the quanta of the store.
+ */
+
+void Sunset_Arrival_Store::quantize(const sunset_arrival_header& h, const sunset_arrival_link& l, sunset_arrival_key& k) 
+{
+	memset(&k, 0, sizeof(sunset_arrival_key));
+	
+	for ( int i = 0; i < 2; i++ ) {
+		
+		k.tx[i] = llround(l.tx[i] / h.hQuantum);
+		k.rx[i] = llround(l.rx[i] / h.hQuantum);
+	}
+	
+	k.tx[2] = llround(l.tx[2] / h.vQuantum);
+	k.rx[2] = llround(l.rx[2] / h.vQuantum);
+	
+	k.freq = llround(l.freq / h.fQuantum);
+	k.bw = llround(l.bw / h.fQuantum);
+	
+	if ( h.timeBucket > 0.0 ) {
+		
+		k.time = (int64_t)floor(l.time / h.timeBucket);
+	}
+}
+
+/*!
+ * 	@brief The hash function returns the FNV-1a hash of the given key.
+ */
+
+uint32_t Sunset_Arrival_Store::hash(const sunset_arrival_key& k) 
+{
+	const unsigned char* p = (const unsigned char*)&k;
+	uint64_t h = 14695981039346656037ULL;
+	
+	for ( size_t i = 0; i < sizeof(sunset_arrival_key); i++ ) {
+		
+		h ^= p[i];
+		h *= 1099511628211ULL;
+	}
+	
+	return (uint32_t)(h ^ (h >> 32));
+}
+
+/*!
+ * 	@brief The insert function adds the given record to the table, the table size has to be a power of two.
+ *	@retval false If the key is already in the table or the table is full.
+ */
+
+bool Sunset_Arrival_Store::insert(vector<sunset_arrival_record>& table, const sunset_arrival_record& r) 
+{
+	uint32_t mask = table.size() - 1;
+	uint32_t i = hash(r.key) & mask;
+	
+	for ( size_t n = 0; n < table.size(); n++ ) {
+		
+		if ( table[i].used == 0 ) {
+			
+			table[i] = r;
+			table[i].used = 1;
+			
+			return true;
+		}
+		
+		if ( memcmp(&(table[i].key), &(r.key), sizeof(sunset_arrival_key)) == 0 ) {
+			
+			return false;
+		}
+		
+		i = (i + 1) & mask;
+	}
+	
+	return false;
+}
+
+void Sunset_Arrival_Store::initHeader(sunset_arrival_header& h, double hQuantum, double vQuantum, double fQuantum, double timeBucket) 
+{
+	memset(&h, 0, sizeof(sunset_arrival_header));
+	
+	memcpy(h.magic, SUNSET_ARRIVAL_MAGIC, 4);
+	h.version = SUNSET_ARRIVAL_VERSION;
+	h.headerSize = sizeof(sunset_arrival_header);
+	h.hQuantum = hQuantum;
+	h.vQuantum = vQuantum;
+	h.fQuantum = fQuantum;
+	h.timeBucket = timeBucket;
+}
+
+/*!
+ * 	@brief The readStore function reads the header and the used records of the given store.
+ */
+
+bool Sunset_Arrival_Store::readStore(const char* path, sunset_arrival_header& h, vector<sunset_arrival_record>& records, string& err) 
+{
+	Sunset_Arrival_Store store;
+	
+	if ( !store.open(path) ) {
+		
+		err = store.getError();
+		
+		return false;
+	}
+	
+	h = store.getHeader();
+	
+	for ( uint32_t i = 0; i < h.capacity; i++ ) {
+		
+		if ( store.table[i].used != 0 ) {
+			
+			records.push_back(store.table[i]);
+		}
+	}
+	
+	return true;
+}
+
+/*!
+ * 	@brief The readJournal function reads the links of the given journal. A truncated last record is ignored.
+ */
+
+bool Sunset_Arrival_Store::readJournal(const char* path, vector<sunset_arrival_link>& links, string& err) 
+{
+	sunset_arrival_link l;
+	FILE* f = fopen(path, "rb");
+	
+	if ( f == NULL ) {
+		
+		err = string("cannot open journal ") + path;
+		
+		return false;
+	}
+	
+	while ( fread(&l, sizeof(sunset_arrival_link), 1, f) == 1 ) {
+		
+		links.push_back(l);
+	}
+	
+	fclose(f);
+	
+	return true;
+}
+
+/*!
+ * 	@brief The writeStore function writes a new store with the given records. The store is written in a temporary file
+ *	which then replaces the given one, processes which have mapped the previous store are not affected.
+ *	@param h The header of the store, capacity and count are set according to the number of records.
+ */
+
+bool Sunset_Arrival_Store::writeStore(const char* path, sunset_arrival_header& h, const vector<sunset_arrival_record>& records, string& err) 
+{
+	vector<sunset_arrival_record> table;
+	sunset_arrival_record empty;
+	char tmp[1024];
+	uint32_t capacity = 1024;
+	uint32_t count = 0;
+	FILE* f = 0;
+	bool ok = true;
+	
+	while ( capacity * SUNSET_ARRIVAL_MAX_LOAD < records.size() ) {
+		
+		capacity = capacity << 1;
+	}
+	
+	memset(&empty, 0, sizeof(sunset_arrival_record));
+	table.assign(capacity, empty);
+	
+	for ( size_t i = 0; i < records.size(); i++ ) {
+		
+		if ( insert(table, records[i]) ) {
+			
+			count++;
+		}
+	}
+	
+	h.capacity = capacity;
+	h.count = count;
+	
+	snprintf(tmp, sizeof(tmp), "%s.tmp.%d", path, (int)getpid());
+	
+	f = fopen(tmp, "wb");
+	
+	if ( f == NULL ) {
+		
+		err = string("cannot create ") + tmp;
+		
+		return false;
+	}
+	
+	ok = fwrite(&h, sizeof(sunset_arrival_header), 1, f) == 1;
+	ok = ok && fwrite(&(table[0]), sizeof(sunset_arrival_record), capacity, f) == capacity;
+	ok = ok && fflush(f) == 0 && fsync(fileno(f)) == 0;
+	ok = (fclose(f) == 0) && ok;
+	
+	if ( !ok || rename(tmp, path) != 0 ) {
+		
+		err = string("cannot write ") + path + ": " + strerror(errno);
+		unlink(tmp);
+		
+		return false;
+	}
+	
+	return true;
+}
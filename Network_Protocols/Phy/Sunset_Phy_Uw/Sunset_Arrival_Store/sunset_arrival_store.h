@@ -0,0 +1,164 @@
+/* SUNSET - Sapienza University Networking framework for underwater Simulation, Emulation and real-life Testing
+ *
+ * Copyright (C) 2012 Regents of UWSN Group of SENSES Lab <http://reti.dsi.uniroma1.it/SENSES_lab/>
+ *
+ * Author: Roberto Petroccia - petroccia@di.uniroma1.it
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License as published
+ * at http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANATBILITY or FITNESS FOR A PARTICULAR PURPOSE. See the Creative Commons
+ * Attribution-NonCommercial-ShareAlike 3.0 Unported License for more details.
+ *
+ * You should have received a copy of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License
+ * along with this program. If not, see <http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode>.
+ */
+
+#ifndef __Sunset_Arrival_Store_h__
+#define __Sunset_Arrival_Store_h__
+
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+#include <string>
+
+using namespace std;
+
+/*
+ * The SUNSET arrival store keeps the channel gain computed by the Bellhop ray tracing for a link, so that replications 
+ * of the same geometry do not evaluate the same gain again. Only the gain evaluation of Sunset_Phy_Bellhop is saved: the 
+ * propagation delays are computed by the WOSS channel module, outside the PHY, from the WOSS arrival databases, and 
+ * the store does not hold them. Sunset_Phy_Bellhop "getArrivalStoreStats" measures the saved time. The store is an open-addressing hash table (linear probing) 
+ * written once by the sunset_arrival_store tool and mapped read-only by the ns processes:
+ *
+ *  file header   | magic "SNAS" | version (u16) | header size (u16) | capacity (u32) | count (u32) |
+ *                | horizontal quantum (f64) | vertical quantum (f64) | frequency quantum (f64) | time bucket (f64) | reserved (16 bytes) |
+ *  record        | tx (3 x i64) | rx (3 x i64) | frequency (i64) | bandwidth (i64) | time (i64) | gain (f64) | used (u64) |   (capacity records)
+ *
+ * The key stores the quantized transmitter and receiver positions (latitude, longitude, altitude for WOSS positions, 
+ * x, y, z otherwise), frequency, bandwidth and time bucket. Horizontal coordinates use the horizontal quantum, the vertical 
+ * one the vertical quantum, frequency and bandwidth the frequency quantum. A time bucket equal to 0 means time independent channel. The capacity is a power of two.
+ *
+ * The processes missing a link compute it and append it to the journal file, a sequence of raw records
+ * (tx xyz, rx xyz, frequency, bandwidth, time, gain as f64). Each record is written with a single write on a file opened in 
+ * append mode, concurrent processes can share the same journal. The tool merges the journals in a new store which 
+ * atomically replaces the previous one, running processes keep using the version they have mapped.
+ * All the values are stored in the host byte order.
+ */
+
+#define SUNSET_ARRIVAL_MAGIC		"SNAS"
+#define SUNSET_ARRIVAL_VERSION		1
+#define SUNSET_ARRIVAL_H_QUANTUM	0.00001		/*!< @brief Default horizontal quantum (about 1 m in degrees). */
+#define SUNSET_ARRIVAL_V_QUANTUM	1.0		/*!< @brief Default vertical quantum (m). */
+#define SUNSET_ARRIVAL_F_QUANTUM	1.0		/*!< @brief Default frequency quantum (Hz). */
+#define SUNSET_ARRIVAL_TIME_BUCKET	0.0		/*!< @brief Default time bucket (sec), 0 for a time independent channel. */
+#define SUNSET_ARRIVAL_MAX_LOAD		0.5		/*!< @brief Maximum load factor of the table written by the tool. */
+
+typedef struct sunset_arrival_header {
+	
+	char magic[4];
+	uint16_t version;
+	uint16_t headerSize;
+	uint32_t capacity;
+	uint32_t count;
+	double hQuantum;
+	double vQuantum;
+	double fQuantum;
+	double timeBucket;
+	char reserved[16];
+	
+} sunset_arrival_header;
+
+typedef struct sunset_arrival_key {
+	
+	int64_t tx[3];
+	int64_t rx[3];
+	int64_t freq;
+	int64_t bw;
+	int64_t time;
+	
+} sunset_arrival_key;
+
+typedef struct sunset_arrival_record {
+	
+	sunset_arrival_key key;
+	double gain;
+	uint64_t used;
+	
+} sunset_arrival_record;
+
+/*! @brief A link as computed by the PHY, before quantization. It is also the journal record. */
+
+typedef struct sunset_arrival_link {
+	
+	double tx[3];
+	double rx[3];
+	double freq;
+	double bw;
+	double time;
+	double gain;
+	
+} sunset_arrival_link;
+
+/*! @brief This class maps a SUNSET arrival store in memory, looks up the links and appends the missing ones to the journal.
+ *  The mapping is read-only and shared, the same pages are used by all the processes on the host.
+ *  @see the file format above.
+ */
+
+class Sunset_Arrival_Store {
+	
+public:
+	
+	Sunset_Arrival_Store();
+	~Sunset_Arrival_Store();
+	
+	bool open(const char* path);		// map the store and check the header
+	bool setJournal(const char* path);	// open the journal where the missing links are appended
+	void close();
+	
+	bool isOpen() { return data != 0; }
+	
+	bool lookup(const sunset_arrival_link& l, double& gain);
+	bool record(const sunset_arrival_link& l);
+	
+	uint32_t getCount() { return header.count; }
+	uint32_t getCapacity() { return header.capacity; }
+	const sunset_arrival_header& getHeader() { return header; }
+	
+	long getHits() { return hits; }
+	long getMisses() { return misses; }
+	long getRecorded() { return recorded; }
+	
+	const string& getError() { return error; }
+	
+	static void quantize(const sunset_arrival_header& h, const sunset_arrival_link& l, sunset_arrival_key& k);
+	static uint32_t hash(const sunset_arrival_key& k);
+	
+	static bool insert(vector<sunset_arrival_record>& table, const sunset_arrival_record& r);
+	
+	static void initHeader(sunset_arrival_header& h, double hQuantum, double vQuantum, double fQuantum, double timeBucket);
+	static bool readStore(const char* path, sunset_arrival_header& h, vector<sunset_arrival_record>& records, string& err);
+	static bool readJournal(const char* path, vector<sunset_arrival_link>& links, string& err);
+	static bool writeStore(const char* path, sunset_arrival_header& h, const vector<sunset_arrival_record>& records, string& err);
+	
+private:
+	
+	const char* data;
+	size_t size;
+	int fd;
+	int journalFd;
+	
+	sunset_arrival_header header;
+	const sunset_arrival_record* table;
+	
+	long hits;
+	long misses;
+	long recorded;
+	
+	string error;
+};
+
+#endif
@@ -0,0 +1,300 @@
+/* SUNSET - Sapienza University Networking framework for underwater Simulation, Emulation and real-life Testing
+ *
+ * Copyright (C) 2012 Regents of UWSN Group of SENSES Lab <http://reti.dsi.uniroma1.it/SENSES_lab/>
+ *
+ * Author: Roberto Petroccia - petroccia@di.uniroma1.it
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License as published
+ * at http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANATBILITY or FITNESS FOR A PARTICULAR PURPOSE. See the Creative Commons
+ * Attribution-NonCommercial-ShareAlike 3.0 Unported License for more details.
+ *
+ * You should have received a copy of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License
+ * along with this program. If not, see <http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode>.
+ */
+
+
+/*
+ * sunset_arrival_store creates and fills the arrival store used by the Sunset_Phy_Bellhop module.
+ *
+ *  info store                                     prints the store header and statistics
+ *  merge [options] [-r] store journal [...]      adds the links of the journals to the store (-r removes the journals)
+ *  prewarm [options] [-j jobs] store cmd [args]   runs jobs copies of the ns command in parallel and merges the links 
+ *                                                 they have computed. Each copy finds in the environment 
+ *                                                 SUNSET_PREWARM_SHARD (0 ... jobs - 1), SUNSET_PREWARM_SHARDS and 
+ *                                                 SUNSET_ARRIVAL_JOURNAL, see samples/simulation/tcl_folder/SUNSETBellhopPrewarm.tcl
+ *
+ * Options used when the store is created: -H horizontal quantum, -V vertical quantum (m), -F frequency quantum (Hz),
+ * -T time bucket (sec). Concurrent merges on the same store are serialized using the lock file "store.lock".
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/wait.h>
+#include "sunset_arrival_store.h"
+
+static void usage(const char* name) 
+{
+	fprintf(stderr, "Usage: %s info store\n", name);
+	fprintf(stderr, "       %s merge [-H hq] [-V vq] [-F fq] [-T bucket] [-r] store journal [journal ...]\n", name);
+	fprintf(stderr, "       %s prewarm [-H hq] [-V vq] [-F fq] [-T bucket] [-j jobs] store command [args ...]\n", name);
+}
+
+static int info(const char* path) 
+{
+	Sunset_Arrival_Store store;
+	sunset_arrival_header h;
+	
+	if ( !store.open(path) ) {
+		
+		fprintf(stderr, "%s\n", store.getError().c_str());
+		
+		return 1;
+	}
+	
+	h = store.getHeader();
+	
+	printf("version            %d\n", h.version);
+	printf("links              %u\n", h.count);
+	printf("capacity           %u\n", h.capacity);
+	printf("load               %.3f\n", (double)h.count / h.capacity);
+	printf("horizontal quantum %g\n", h.hQuantum);
+	printf("vertical quantum   %g\n", h.vQuantum);
+	printf("frequency quantum  %g\n", h.fQuantum);
+	printf("time bucket        %g\n", h.timeBucket);
+	
+	return 0;
+}
+
+/*!
+ * 	@brief The merge function adds the links of the given journals to the store, creating it if needed. 
+ *	The links already in the store are kept.
+ */
+
+static int merge(const char* path, sunset_arrival_header& h, char** journals, int numJournals, bool removeJournals) 
+{
+	vector<sunset_arrival_record> records;
+	vector<sunset_arrival_link> links;
+	sunset_arrival_record r;
+	string lockPath = string(path) + ".lock";
+	string err;
+	size_t old = 0;
+	int lockFd = -1;
+	int ret = 0;
+	
+	lockFd = open(lockPath.c_str(), O_RDWR | O_CREAT, 0644);
+	
+	if ( lockFd < 0 || flock(lockFd, LOCK_EX) != 0 ) {
+		
+		fprintf(stderr, "cannot lock %s\n", lockPath.c_str());
+		
+		return 1;
+	}
+	
+	if ( access(path, F_OK) == 0 && !Sunset_Arrival_Store::readStore(path, h, records, err) ) {
+		
+		fprintf(stderr, "%s\n", err.c_str());
+		close(lockFd);
+		
+		return 1;
+	}
+	
+	old = records.size();
+	
+	for ( int i = 0; i < numJournals; i++ ) {
+		
+		if ( !Sunset_Arrival_Store::readJournal(journals[i], links, err) ) {
+			
+			fprintf(stderr, "%s\n", err.c_str());
+			ret = 1;
+		}
+	}
+	
+	memset(&r, 0, sizeof(sunset_arrival_record));
+	
+	for ( size_t i = 0; i < links.size(); i++ ) {
+		
+		Sunset_Arrival_Store::quantize(h, links[i], r.key);
+		r.gain = links[i].gain;
+		r.used = 1;
+		
+		records.push_back(r);
+	}
+	
+	if ( !Sunset_Arrival_Store::writeStore(path, h, records, err) ) {
+		
+		fprintf(stderr, "%s\n", err.c_str());
+		close(lockFd);
+		
+		return 1;
+	}
+	
+	printf("%s: %u links (%u new, %d journal records)\n", path, h.count, (unsigned int)(h.count - old), (int)links.size());
+	
+	if ( removeJournals && ret == 0 ) {
+		
+		for ( int i = 0; i < numJournals; i++ ) {
+			
+			unlink(journals[i]);
+		}
+	}
+	
+	close(lockFd);
+	
+	return ret;
+}
+
+/*!
+ * 	@brief The prewarm function runs the given command "jobs" times in parallel, each copy computes a shard of the links 
+ *	and writes them in its own journal. The journals are then merged in the store.
+ */
+
+static int prewarm(const char* path, sunset_arrival_header& h, int jobs, char** cmd) 
+{
+	vector<string> journals;
+	vector<char*> names;
+	char value[64];
+	int failed = 0;
+	int status = 0;
+	pid_t pid;
+	
+	for ( int i = 0; i < jobs; i++ ) {
+		
+		snprintf(value, sizeof(value), ".journal.%d", i);
+		journals.push_back(string(path) + value);
+	}
+	
+	for ( int i = 0; i < jobs; i++ ) {
+		
+		pid = fork();
+		
+		if ( pid < 0 ) {
+			
+			fprintf(stderr, "cannot start job %d\n", i);
+			failed++;
+			
+			continue;
+		}
+		
+		if ( pid == 0 ) {
+			
+			snprintf(value, sizeof(value), "%d", i);
+			setenv("SUNSET_PREWARM_SHARD", value, 1);
+			
+			snprintf(value, sizeof(value), "%d", jobs);
+			setenv("SUNSET_PREWARM_SHARDS", value, 1);
+			
+			setenv("SUNSET_ARRIVAL_JOURNAL", journals[i].c_str(), 1);
+			
+			execvp(cmd[0], cmd);
+			
+			fprintf(stderr, "cannot execute %s\n", cmd[0]);
+			_exit(127);
+		}
+	}
+	
+	while ( wait(&status) > 0 ) {
+		
+		if ( !WIFEXITED(status) || WEXITSTATUS(status) != 0 ) {
+			
+			failed++;
+		}
+	}
+	
+	if ( failed > 0 ) {
+		
+		fprintf(stderr, "%d jobs failed, the links they have computed are merged anyway\n", failed);
+	}
+	
+	for ( int i = 0; i < jobs; i++ ) {
+		
+		if ( access(journals[i].c_str(), F_OK) == 0 ) {
+			
+			names.push_back((char*)journals[i].c_str());
+		}
+	}
+	
+	if ( names.empty() ) {
+		
+		fprintf(stderr, "no journal has been written\n");
+		
+		return 1;
+	}
+	
+	return merge(path, h, &(names[0]), names.size(), true) != 0 || failed > 0;
+}
+
+int main(int argc, char** argv) 
+{
+	sunset_arrival_header h;
+	double hQuantum = SUNSET_ARRIVAL_H_QUANTUM;
+	double vQuantum = SUNSET_ARRIVAL_V_QUANTUM;
+	double fQuantum = SUNSET_ARRIVAL_F_QUANTUM;
+	double timeBucket = SUNSET_ARRIVAL_TIME_BUCKET;
+	bool removeJournals = false;
+	string mode;
+	int jobs = 1;
+	int opt = 0;
+	
+	if ( argc < 3 ) {
+		
+		usage(argv[0]);
+		
+		return 1;
+	}
+	
+	mode = argv[1];
+	
+	if ( mode == "info" ) {
+		
+		return info(argv[2]);
+	}
+	
+	// options end at the first non option argument, the prewarm command keeps its own options
+	
+	optind = 2;
+	
+	while ( (opt = getopt(argc, argv, "+H:V:F:T:j:r")) != -1 ) {
+		
+		switch ( opt ) {
+				
+			case 'H': hQuantum = atof(optarg); break;
+			case 'V': vQuantum = atof(optarg); break;
+			case 'F': fQuantum = atof(optarg); break;
+			case 'T': timeBucket = atof(optarg); break;
+			case 'j': jobs = atoi(optarg); break;
+			case 'r': removeJournals = true; break;
+			default: usage(argv[0]); return 1;
+		}
+	}
+	
+	if ( hQuantum <= 0.0 || vQuantum <= 0.0 || fQuantum <= 0.0 || timeBucket < 0.0 || jobs <= 0 || argc - optind < 2 ) {
+		
+		usage(argv[0]);
+		
+		return 1;
+	}
+	
+	Sunset_Arrival_Store::initHeader(h, hQuantum, vQuantum, fQuantum, timeBucket);
+	
+	if ( mode == "merge" ) {
+		
+		return merge(argv[optind], h, argv + optind + 1, argc - optind - 1, removeJournals);
+	}
+	
+	if ( mode == "prewarm" ) {
+		
+		return prewarm(argv[optind], h, jobs, argv + optind + 1);
+	}
+	
+	usage(argv[0]);
+	
+	return 1;
+}
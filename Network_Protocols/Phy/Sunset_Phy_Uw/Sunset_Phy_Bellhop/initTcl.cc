@@ -14,6 +14,7 @@ Module/Sunset_Phy_Bellhop set PER_target_            0.01\n\
 \n\
 \n\
 Module/Sunset_Phy_Bellhop set use_pkt_error_ 0\n\
-Module/Sunset_Phy_Bellhop set use_energy_ 0";
+Module/Sunset_Phy_Bellhop set use_energy_ 0\n\
+Module/Sunset_Phy_Bellhop set use_link_cache_ 1";
 #include "tclcl.h"
 EmbeddedTcl Sunset_Phy_Bellhop_TclCode(code);
@@ -15,4 +15,5 @@ Module/Sunset_Phy_Bellhop set PER_target_            0.01
 
 
 Module/Sunset_Phy_Bellhop set use_pkt_error_ 0
-Module/Sunset_Phy_Bellhop set use_energy_ 0
\ No newline at end of file
+Module/Sunset_Phy_Bellhop set use_energy_ 0
+Module/Sunset_Phy_Bellhop set use_link_cache_ 1
\ No newline at end of file
@@ -25,6 +25,7 @@
 #include <sunset_phy2mac-clmsg.h>
 #include <phymac-clmsg.h>
 #include <sunset_utilities.h> 
+#include <sys/time.h>
 
 /*!
  * 	@brief This static class is a hook class used to instantiate a C++ object from the TCL script. 
@@ -48,9 +49,14 @@ Sunset_Phy_Bellhop::Sunset_Phy_Bellhop()
 	
 	use_pkt_error = 0;
 	use_energy = 0;
+	use_link_cache = 1;
+	use_arrival_store = 0;
+	traced = 0;
+	traceTime = 0.0;
 	
 	bind("use_pkt_error_", &use_pkt_error);
 	bind("use_energy_", &use_energy);
+	bind("use_link_cache_", &use_link_cache);
 	
 	energy = NULL;
 	pkt_error = NULL;
@@ -59,7 +65,7 @@ Sunset_Phy_Bellhop::Sunset_Phy_Bellhop()
 	
 	sid_id = 0;
 	
-	Sunset_Debug::debugInfo(-1, -1, "Sunset_Phy_Bellhop::Sunset_Phy_Bellhop CREATED");
+	SUNSET_DEBUG_LOG(-1, -1, "Sunset_Phy_Bellhop::Sunset_Phy_Bellhop CREATED");
 	
 }
 
@@ -91,6 +97,10 @@ void Sunset_Phy_Bellhop::start()
 		
 		sid->define(phyAddress, sid_id, "TX_POWER");
 		sid->subscribe(phyAddress, sid_id, "TX_POWER");
+		
+		/* the cached link gains are computed again when a node position changes */
+		sid->define(phyAddress, sid_id, "NODE_POSITION");
+		sid->subscribe(phyAddress, sid_id, "NODE_POSITION");
 	}	
 	
 	if ( use_pkt_error ) {
@@ -113,7 +123,7 @@ void Sunset_Phy_Bellhop::stop()
 	double duration = 0;
 	double power = 0.0;
 	
-	Sunset_Debug::debugInfo(3, phyAddress, "Sunset_Phy_Bellhop::end - STATE %d", state);
+	SUNSET_DEBUG_LOG(3, phyAddress, "Sunset_Phy_Bellhop::end - STATE %d", state);
 	
 	if ( use_energy ) {
 		
@@ -139,7 +149,7 @@ void Sunset_Phy_Bellhop::stop()
 				
 			} else {
 				
-				Sunset_Debug::debugInfo(-1, phyAddress, "Sunset_Phy_Bellhop::end ERROR Energy %f", power);
+				SUNSET_DEBUG_LOG(-1, phyAddress, "Sunset_Phy_Bellhop::end ERROR Energy %f", power);
 				exit(0);	
 			}	
 		} 
@@ -150,11 +160,17 @@ void Sunset_Phy_Bellhop::stop()
 			energy->setRxDuration(duration);
 		}
 		else {
-			Sunset_Debug::debugInfo(-1, phyAddress, "Sunset_Phy_Bellhop::end ERROR - STATE %d", state);
+			SUNSET_DEBUG_LOG(-1, phyAddress, "Sunset_Phy_Bellhop::end ERROR - STATE %d", state);
 			exit(0);
 		}
 	}
 	
+	if ( use_arrival_store ) {
+		
+		SUNSET_DEBUG_LOG(1, phyAddress, "Sunset_Phy_Bellhop::stop arrival store hits %ld misses %ld recorded %ld traced %ld in %f sec", 
+				 arrivalStore.getHits(), arrivalStore.getMisses(), arrivalStore.getRecorded(), traced, traceTime);
+	}
+	
 	sid_id = 0;
 	
 	sid = NULL; 
@@ -183,7 +199,7 @@ int Sunset_Phy_Bellhop::command(int argc, const char * const * argv )
 		
 		if (strcmp(argv[1], "start") == 0) {
 			
-			Sunset_Debug::debugInfo(1, phyAddress, "Sunset_Phy_Bellhop::command start Module");
+			SUNSET_DEBUG_LOG(1, phyAddress, "Sunset_Phy_Bellhop::command start Module");
 			start();
 			
 			return TCL_OK;
@@ -193,11 +209,26 @@ int Sunset_Phy_Bellhop::command(int argc, const char * const * argv )
 		
 		if (strcmp(argv[1], "stop") == 0) {
 			
-			Sunset_Debug::debugInfo(1, phyAddress, "Sunset_Phy_Bellhop::command stop Module");
+			SUNSET_DEBUG_LOG(1, phyAddress, "Sunset_Phy_Bellhop::command stop Module");
 			stop();
 			
 			return TCL_OK;
 		}
+		
+		/* The "getArrivalStoreStats" command returns the links found in the arrival store, the links missing in the 
+		 * store, the links appended to the journal, the links computed by the PHY and the wall clock time (sec) spent 
+		 * computing them. The time saved by the store is about hits * time / computed links; it covers only the gain 
+		 * evaluation of the PHY, the propagation delays are still computed by the WOSS channel module.
+		 */
+		
+		if (strcmp(argv[1], "getArrivalStoreStats") == 0) {
+			
+			Tcl& tcl = Tcl::instance();
+			
+			tcl.resultf("%ld %ld %ld %ld %f", arrivalStore.getHits(), arrivalStore.getMisses(), arrivalStore.getRecorded(), traced, traceTime);
+			
+			return TCL_OK;
+		}
 	}
 	
 	if( argc == 3 ) {
@@ -208,7 +239,7 @@ int Sunset_Phy_Bellhop::command(int argc, const char * const * argv )
 			
 			use_pkt_error = atoi(argv[2]);
 			
-			Sunset_Debug::debugInfo(3, phyAddress, "Sunset_Phy_Bellhop::command usePktErrorModel %d", use_pkt_error);
+			SUNSET_DEBUG_LOG(3, phyAddress, "Sunset_Phy_Bellhop::command usePktErrorModel %d", use_pkt_error);
 			
 			return (TCL_OK);
 		}
@@ -219,7 +250,7 @@ int Sunset_Phy_Bellhop::command(int argc, const char * const * argv )
 			
 			phyAddress = atoi(argv[2]);
 			
-			Sunset_Debug::debugInfo(3, -1, "Sunset_Phy_Bellhop::command phyAddress %d", phyAddress);
+			SUNSET_DEBUG_LOG(3, -1, "Sunset_Phy_Bellhop::command phyAddress %d", phyAddress);
 			
 			return TCL_OK;
 		}
@@ -240,19 +271,93 @@ int Sunset_Phy_Bellhop::command(int argc, const char * const * argv )
 			
 			lvlPowers.insert(atof(argv[2]));
 			
-			Sunset_Debug::debugInfo(3, -1, "Sunset_Phy_Bellhop::command addLevelPower %f", atof(argv[2]));
+			SUNSET_DEBUG_LOG(3, -1, "Sunset_Phy_Bellhop::command addLevelPower %f", atof(argv[2]));
 			
 			return TCL_OK;
 			
 		}
 
+		/* The "arrivalStore" command maps the given arrival store, the channel gains found in the store are not computed 
+		 * by the PHY, the propagation delays are still computed by the WOSS channel module. The links missing in the store are appended to the journal file specified by the 
+		 * SUNSET_ARRIVAL_JOURNAL environment variable ("store".journal by default), the sunset_arrival_store tool 
+		 * merges them in the store for the following runs.
+		 */
+		
+		if (strcmp(argv[1], "arrivalStore") == 0) {
+			
+			const char* journal = getenv("SUNSET_ARRIVAL_JOURNAL");
+			string path = string(argv[2]) + ".journal";
+			
+			if ( journal != NULL ) {
+				
+				path = journal;
+			}
+			
+			if ( !arrivalStore.open(argv[2]) ) {
+				
+				SUNSET_DEBUG_LOG(1, phyAddress, "Sunset_Phy_Bellhop::command arrivalStore %s not available - %s", argv[2], arrivalStore.getError().c_str());
+			}
+			
+			if ( !arrivalStore.setJournal(path.c_str()) ) {
+				
+				SUNSET_DEBUG_LOG(-1, phyAddress, "Sunset_Phy_Bellhop::command arrivalStore ERROR %s", arrivalStore.getError().c_str());
+			}
+			
+			use_arrival_store = 1;
+			
+			SUNSET_DEBUG_LOG(3, phyAddress, "Sunset_Phy_Bellhop::command arrivalStore %s links %u journal %s", argv[2], arrivalStore.getCount(), path.c_str());
+			
+			return TCL_OK;
+		}
+		
+		/* The "prewarmLink" command computes the channel gain from the given transmitter position to this node and 
+		 * appends it to the arrival store journal. It is used to fill the arrival store before running the simulations.
+		 */
+		
+		if (strcmp(argv[1], "prewarmLink") == 0) {
+			
+			Tcl& tcl = Tcl::instance();
+			Position* tx = (Position*) TclObject::lookup(argv[2]);
+			Packet* p = 0;
+			hdr_MPhy* ph = 0;
+			double gain = 0.0;
+			
+			if ( tx == 0 || spectralmask_ == 0 || getPosition() == 0 ) {
+				
+				SUNSET_DEBUG_LOG(-1, phyAddress, "Sunset_Phy_Bellhop::command prewarmLink ERROR position or spectral mask not set");
+				
+				return TCL_ERROR;
+			}
+			
+			p = Packet::alloc();
+			ph = HDR_MPHY(p);
+			
+			HDR_CMN(p)->prev_hop_ = -1;
+			
+			ph->Pt = 1.0;
+			ph->srcPosition = tx;
+			ph->dstPosition = getPosition();
+			ph->srcSpectralMask = spectralmask_;
+			ph->dstSpectralMask = spectralmask_;
+			ph->srcAntenna = antenna_;
+			ph->dstAntenna = antenna_;
+			
+			gain = getLinkGain(p, spectralmask_->getFreq(), spectralmask_->getBandwidth());
+			
+			Packet::free(p);
+			
+			tcl.resultf("%e", gain);
+			
+			return TCL_OK;
+		}
+		
 		/* The "addToBlacklist" adds the specified node id to the black list. */
 		
 		if (strcmp(argv[1], "addToBlacklist") == 0) {
 			
 			blackList.insert(atoi(argv[2]));
 			
-			Sunset_Debug::debugInfo(3, phyAddress, "Sunset_Phy_Urick::command Blacklist %d", atoi(argv[2]));
+			SUNSET_DEBUG_LOG(3, phyAddress, "Sunset_Phy_Urick::command Blacklist %d", atoi(argv[2]));
 			
 			return (TCL_OK);
 		}
@@ -288,7 +393,7 @@ void Sunset_Phy_Bellhop::startTx(Packet* p) {
 			energy->setRxDuration(duration);
 		}
 		else {
-			Sunset_Debug::debugInfo(-1, phyAddress, "Sunset_Phy_Bellhop::startTx ERROR - STATE %d", state);
+			SUNSET_DEBUG_LOG(-1, phyAddress, "Sunset_Phy_Bellhop::startTx ERROR - STATE %d", state);
 			exit(0);		
 		}
 		
@@ -313,7 +418,7 @@ void Sunset_Phy_Bellhop::endTx(Packet* p) {
 	double duration = 0.0;
 	double power = 0.0;
 	
-	Sunset_Debug::debugInfo(3, phyAddress, "Sunset_Phy_Bellhop::endTx - STATE %d", state);
+	SUNSET_DEBUG_LOG(3, phyAddress, "Sunset_Phy_Bellhop::endTx - STATE %d", state);
 	
 	if ( use_energy ) {
 		
@@ -325,7 +430,7 @@ void Sunset_Phy_Bellhop::endTx(Packet* p) {
 			
 			power = round(power * 100) / 100.0;
 						
-			Sunset_Debug::debugInfo(3, phyAddress, "Sunset_Phy_Bellhop::endTx - pow %f", power);		
+			SUNSET_DEBUG_LOG(3, phyAddress, "Sunset_Phy_Bellhop::endTx - pow %f", power);		
 			
 			if ( lvlPowers.find(power) != lvlPowers.end() ) {
 				
@@ -333,7 +438,7 @@ void Sunset_Phy_Bellhop::endTx(Packet* p) {
 				
 			} else {
 				
-				Sunset_Debug::debugInfo(-1, phyAddress, "Sunset_Phy_Bellhop::endTx ERROR Energy %f", power);
+				SUNSET_DEBUG_LOG(-1, phyAddress, "Sunset_Phy_Bellhop::endTx ERROR Energy %f", power);
 				exit(0);	
 			}
 		}
@@ -359,13 +464,13 @@ void Sunset_Phy_Bellhop::startRx(Packet* p) {
 		
 		if ( blackList.find(HDR_CMN(p)->prev_hop_) != blackList.end() ) {
 		
-			Sunset_Debug::debugInfo(3, phyAddress, "Sunset_Phy_Bellhop::startRx blacklist %d", HDR_CMN(p)->prev_hop_);
+			SUNSET_DEBUG_LOG(3, phyAddress, "Sunset_Phy_Bellhop::startRx blacklist %d", HDR_CMN(p)->prev_hop_);
 			
 			return;
 		}
 	}
 
-	Sunset_Debug::debugInfo(3, phyAddress, "Sunset_Phy_Bellhop::startRx - STATE %d", state);
+	SUNSET_DEBUG_LOG(3, phyAddress, "Sunset_Phy_Bellhop::startRx - STATE %d", state);
 	
 	if ( state == IDLE ) {
 		
@@ -397,7 +502,7 @@ void Sunset_Phy_Bellhop::startRx(Packet* p) {
 				
 			} else {
 				
-				Sunset_Debug::debugInfo(-1, phyAddress, "Sunset_Phy_Bellhop::startRx ERROR Energy %f", power);
+				SUNSET_DEBUG_LOG(-1, phyAddress, "Sunset_Phy_Bellhop::startRx ERROR Energy %f", power);
 				exit(0);	
 			}
 		}
@@ -415,13 +520,13 @@ void Sunset_Phy_Bellhop::startRx(Packet* p) {
 				
 				endRx_ = NOW + HDR_MPHY(p)->duration;
 				
-				Sunset_Debug::debugInfo(3, phyAddress, "Sunset_Phy_Bellhop::startRx - STATE %d -%f", state, endRx_);
+				SUNSET_DEBUG_LOG(3, phyAddress, "Sunset_Phy_Bellhop::startRx - STATE %d -%f", state, endRx_);
 			}
 		}
 		
 	} else {
 		
-		Sunset_Debug::debugInfo(-1, phyAddress, "Sunset_Phy_Bellhop::startRx ERROR - STATE %d", state);
+		SUNSET_DEBUG_LOG(-1, phyAddress, "Sunset_Phy_Bellhop::startRx ERROR - STATE %d", state);
 		exit(0);
 	}
 	
@@ -443,7 +548,7 @@ void Sunset_Phy_Bellhop::endRx(Packet* p)
 		
 		if ( blackList.find(HDR_CMN(p)->prev_hop_) != blackList.end() ) {
 		
-			Sunset_Debug::debugInfo(3, phyAddress, "Sunset_Phy_Bellhop::endRx blacklist %d", HDR_CMN(p)->prev_hop_);
+			SUNSET_DEBUG_LOG(3, phyAddress, "Sunset_Phy_Bellhop::endRx blacklist %d", HDR_CMN(p)->prev_hop_);
 			
 			return;
 		}
@@ -510,24 +615,159 @@ void Sunset_Phy_Bellhop::endRx(Packet* p)
 	return WossMPhyBpsk::endRx(p);
 }
 
+/*!
+ * 	@brief The getNoiseChannel function returns the noise power for the current frequency and bandwidth. When the link cache 
+ *	is used the noise model is evaluated once for each (frequency, bandwidth).
+ */
+
 double Sunset_Phy_Bellhop::getNoiseChannel()
 {
 	assert(propagation_);
 	
 	double freq = spectralmask_->getFreq();
 	double bw = spectralmask_->getBandwidth();
+	double noisepow = 0.0;
+	
+	if ( use_link_cache && linkCache.getNoise(freq, bw, noisepow) ) {
+		
+		return noisepow;
+	}
 	
 	UnderwaterMPropagation* uwmp = dynamic_cast<UnderwaterMPropagation*>(propagation_);
 	assert(uwmp);
 	
 	double noiseSPDdBperHz = uwmp->uw.getNoise(freq/1000.0);
-	double noisepow = bw * pow(10, noiseSPDdBperHz/10.0);
+	noisepow = bw * pow(10, noiseSPDdBperHz/10.0);
   	
-	Sunset_Debug::debugInfo(5, phyAddress, "Sunset_Phy_Bellhop::getNoiseChannel - freq %f - bw %f - Pn %f", freq, bw, noisepow);
+	SUNSET_DEBUG_LOG(5, phyAddress, "Sunset_Phy_Bellhop::getNoiseChannel - freq %f - bw %f - Pn %f", freq, bw, noisepow);
+	
+	if ( use_link_cache ) {
+		
+		linkCache.setNoise(freq, bw, noisepow);
+	}
 	
 	return (noisepow);
 }
 
+/*!
+ * 	@brief The getRxPower function returns the power of the received packet. When the link cache is used the ratio between
+ *	received and transmitted power (propagation, antenna and spectral mask gains) is computed by the channel model once 
+ *	for each link, it is computed again only when the transmitter or the receiver position changes.
+ *	@param p The received packet.
+ */
+
+double Sunset_Phy_Bellhop::getRxPower(Packet* p)
+{
+	hdr_MPhy* ph = HDR_MPHY(p);
+	int src = HDR_CMN(p)->prev_hop_;
+	double freq = 0.0;
+	double bw = 0.0;
+	double gain = 0.0;
+	double pr = 0.0;
+	
+	if ( (!use_link_cache && !use_arrival_store) || ph->Pt <= 0.0 || ph->srcSpectralMask == 0 ) {
+		
+		return WossMPhyBpsk::getRxPower(p);
+	}
+	
+	freq = ph->srcSpectralMask->getFreq();
+	bw = ph->srcSpectralMask->getBandwidth();
+	
+	if ( use_link_cache && linkCache.getGain(src, phyAddress, freq, bw, gain) ) {
+		
+		return ph->Pt * gain;
+	}
+	
+	gain = getLinkGain(p, freq, bw);
+	pr = ph->Pt * gain;
+	
+	if ( use_link_cache ) {
+		
+		linkCache.setGain(src, phyAddress, freq, bw, gain);
+	}
+	
+	SUNSET_DEBUG_LOG(5, phyAddress, "Sunset_Phy_Bellhop::getRxPower link %d gain %e hits %d misses %d", src, gain, linkCache.getHits(), linkCache.getMisses());
+	
+	return pr;
+}
+
+/*!
+ * 	@brief The getLinkGain function returns the ratio between received and transmitted power of the given packet. 
+ *	When the arrival store is used the gain is searched in the store, the gain is computed by WOSS only for the 
+ *	missing links which are then appended to the store journal. The time spent computing them is accumulated in 
+ *	traceTime to measure the saving of the store. The propagation delay is not affected: it is computed by the WOSS 
+ *	channel module, outside the PHY, from the WOSS arrival databases.
+ *	@param p The received packet, its transmission power has to be greater than 0.
+ *	@param freq The frequency of the transmitter spectral mask.
+ *	@param bw The bandwidth of the transmitter spectral mask.
+ */
+
+double Sunset_Phy_Bellhop::getLinkGain(Packet* p, double freq, double bw)
+{
+	hdr_MPhy* ph = HDR_MPHY(p);
+	sunset_arrival_link l;
+	struct timeval start, end;
+	double gain = 0.0;
+	bool useStore = use_arrival_store && ph->srcPosition != 0 && getPosition() != 0;
+	
+	if ( useStore ) {
+		
+		getStorePosition(ph->srcPosition, l.tx);
+		getStorePosition(getPosition(), l.rx);
+		
+		l.freq = freq;
+		l.bw = bw;
+		l.time = NOW;
+		l.gain = 0.0;
+		
+		if ( arrivalStore.lookup(l, gain) ) {
+			
+			return gain;
+		}
+	}
+	
+	gettimeofday(&start, NULL);
+	
+	gain = WossMPhyBpsk::getRxPower(p) / ph->Pt;
+	
+	if ( useStore ) {
+		
+		gettimeofday(&end, NULL);
+		
+		traced++;
+		traceTime += (end.tv_sec - start.tv_sec) + (end.tv_usec - start.tv_usec) / 1e6;
+		
+		l.gain = gain;
+		
+		arrivalStore.record(l);
+	}
+	
+	return gain;
+}
+
+/*!
+ * 	@brief The getStorePosition function returns the coordinates used to search a node in the arrival store: 
+ *	latitude, longitude and altitude for WOSS positions, x, y and z otherwise.
+ */
+
+void Sunset_Phy_Bellhop::getStorePosition(Position* pos, double* v)
+{
+	WossPosition* wp = dynamic_cast<WossPosition*>(pos);
+	
+	if ( wp != 0 ) {
+		
+		v[0] = wp->getLatitude();
+		v[1] = wp->getLongitude();
+		v[2] = wp->getAltitude();
+		
+		return;
+	}
+	
+	v[0] = pos->getX();
+	v[1] = pos->getY();
+	v[2] = pos->getZ();
+}
+
 int Sunset_Phy_Bellhop::notify_info(list<notified_info> linfo) 
 { 
 	list<notified_info>::iterator it = linfo.begin();
@@ -537,6 +777,15 @@ int Sunset_Phy_Bellhop::notify_info(list<notified_info> linfo)
 		
 		ni = *it;
 		string s = "TX_POWER";
+		
+		if ( strcmp((ni.info_name).c_str(), "NODE_POSITION") == 0 ) {
+			
+			Sunset_Phy_Link_Cache::positionChanged(ni.node_id);
+			
+			SUNSET_DEBUG_LOG(3, phyAddress, "Sunset_Phy_Bellhop::notify_info position changed node %d", ni.node_id);
+			
+			continue;
+		}
 				
 		if ( ni.node_id == phyAddress ) {
 			
@@ -546,7 +795,7 @@ int Sunset_Phy_Bellhop::notify_info(list<notified_info> linfo)
 				
 				sid->get_value(&MaxTxSPL_dB_, ni);
 				
-				Sunset_Debug::debugInfo(3, phyAddress, " Sunset_Phy_Bellhop::notify_info Power Set to %f", MaxTxSPL_dB_);
+				SUNSET_DEBUG_LOG(3, phyAddress, " Sunset_Phy_Bellhop::notify_info Power Set to %f", MaxTxSPL_dB_);
 				
 				return 1;
 			}
@@ -55,6 +55,9 @@
 #include <climits>
 
 #include <sunset_packet_error_model.h>
+#include <sunset_phy_link_cache.h>
+#include <sunset_arrival_store.h>
+#include <woss-position.h>
 
 enum { IDLE = 0, START_TX = 1, END_TX = 2, START_RX = 3, END_RX = 4};
 
@@ -79,11 +82,20 @@ private:
 	
 	double lastPower;
 	
+	Sunset_Phy_Link_Cache linkCache;	// channel gain of each link and noise power, see use_link_cache
+	Sunset_Arrival_Store arrivalStore;	// channel gains computed by previous runs, see the arrivalStore command
+	long traced;				// gains computed by WOSS while the arrival store is used
+	double traceTime;			// wall clock time (sec) spent computing them
+	
+	double getLinkGain(Packet* p, double freq, double bw);
+	void getStorePosition(Position* pos, double* v);
+	
 public:
 	Sunset_Phy_Bellhop();
 	~Sunset_Phy_Bellhop();
  	
 	virtual double getNoiseChannel();	
+	virtual double getRxPower(Packet* p);
 	virtual int command(int argc, const char* const* argv);
 	
 	virtual void startTx(Packet* p);
@@ -98,6 +110,8 @@ public:
 		
 	int use_pkt_error;
 	int use_energy;
+	int use_link_cache;
+	int use_arrival_store;
 
 	set<int> blackList;
 	
@@ -48,9 +48,11 @@ Sunset_Phy_Urick::Sunset_Phy_Urick()
 	
 	use_pkt_error = 0;
 	use_energy = 0;
+	use_link_cache = 1;
 	
 	bind("use_pkt_error_", &use_pkt_error);
 	bind("use_energy_", &use_energy);
+	bind("use_link_cache_", &use_link_cache);
 	
 	energy = NULL;
 	
@@ -60,7 +62,7 @@ Sunset_Phy_Urick::Sunset_Phy_Urick()
 	
 	sid_id = 0;
 	
-	Sunset_Debug::debugInfo(-1, -1, "Sunset_Phy_Urick::Sunset_Phy_Urick CREATED");
+	SUNSET_DEBUG_LOG(-1, -1, "Sunset_Phy_Urick::Sunset_Phy_Urick CREATED");
 	
 }
 
@@ -92,6 +94,10 @@ void Sunset_Phy_Urick::start()
 	if (sid != NULL) {
 		
 		sid->subscribe(phyAddress, sid_id, "TX_POWER");
+		
+		/* the cached link gains are computed again when a node position changes */
+		sid->define(phyAddress, sid_id, "NODE_POSITION");
+		sid->subscribe(phyAddress, sid_id, "NODE_POSITION");
 	}
 	
 	if ( use_pkt_error ) {
@@ -114,7 +120,7 @@ void Sunset_Phy_Urick::stop()
 	double duration = 0;
 	double power = 0.0;
 	
-	Sunset_Debug::debugInfo(3, phyAddress, "Sunset_Phy_Urick::end - STATE %d", state);
+	SUNSET_DEBUG_LOG(3, phyAddress, "Sunset_Phy_Urick::end - STATE %d", state);
 	
 	if ( use_energy ) {
 		
@@ -137,7 +143,7 @@ void Sunset_Phy_Urick::stop()
 				
 			} else {
 				
-				Sunset_Debug::debugInfo(-1, phyAddress, "Sunset_Phy_Urick::end ERROR Energy %f", power);
+				SUNSET_DEBUG_LOG(-1, phyAddress, "Sunset_Phy_Urick::end ERROR Energy %f", power);
 				exit(0);	
 			}
 			
@@ -149,7 +155,7 @@ void Sunset_Phy_Urick::stop()
 			energy->setRxDuration(duration);
 		}
 		else {
-			Sunset_Debug::debugInfo(-1, phyAddress, "Sunset_Phy_Urick::end ERROR - STATE %d", state);
+			SUNSET_DEBUG_LOG(-1, phyAddress, "Sunset_Phy_Urick::end ERROR - STATE %d", state);
 			exit(0);
 		}
 	}
@@ -181,7 +187,7 @@ int Sunset_Phy_Urick::command(int argc, const char * const * argv )
 		
 		if (strcmp(argv[1], "start") == 0) {
 			
-			Sunset_Debug::debugInfo(1, 0, "Sunset_Phy_Urick::command start Module");
+			SUNSET_DEBUG_LOG(1, 0, "Sunset_Phy_Urick::command start Module");
 			start();
 			
 			return TCL_OK;
@@ -191,7 +197,7 @@ int Sunset_Phy_Urick::command(int argc, const char * const * argv )
 		
 		if (strcmp(argv[1], "stop") == 0) {
 			
-			Sunset_Debug::debugInfo(1, 0, "Sunset_Phy_Urick::command stop Module");
+			SUNSET_DEBUG_LOG(1, 0, "Sunset_Phy_Urick::command stop Module");
 			stop();
 			
 			return TCL_OK;
@@ -206,7 +212,7 @@ int Sunset_Phy_Urick::command(int argc, const char * const * argv )
 			
 			use_pkt_error = atoi(argv[2]);
 			
-			Sunset_Debug::debugInfo(3, phyAddress, "Sunset_Phy_Urick::command usePktErrorModel %d", use_pkt_error);
+			SUNSET_DEBUG_LOG(3, phyAddress, "Sunset_Phy_Urick::command usePktErrorModel %d", use_pkt_error);
 			
 			return (TCL_OK);
 		}
@@ -217,7 +223,7 @@ int Sunset_Phy_Urick::command(int argc, const char * const * argv )
 			
 			phyAddress = atoi(argv[2]);
 			
-			Sunset_Debug::debugInfo(3, -1, "Sunset_Phy_Urick::command phyAddress %d", phyAddress);
+			SUNSET_DEBUG_LOG(3, -1, "Sunset_Phy_Urick::command phyAddress %d", phyAddress);
 			
 			return TCL_OK;
 		}
@@ -238,7 +244,7 @@ int Sunset_Phy_Urick::command(int argc, const char * const * argv )
 			
 			lvlPowers.insert(atof(argv[2]));
 			
-			Sunset_Debug::debugInfo(3, -1, "Sunset_Phy_Urick::command addLevelPower %f", atof(argv[2]));
+			SUNSET_DEBUG_LOG(3, -1, "Sunset_Phy_Urick::command addLevelPower %f", atof(argv[2]));
 			
 			return TCL_OK;
 			
@@ -250,7 +256,7 @@ int Sunset_Phy_Urick::command(int argc, const char * const * argv )
 			
 			blackList.insert(atoi(argv[2]));
 			
-			Sunset_Debug::debugInfo(3, phyAddress, "Sunset_Phy_Urick::command Blacklist %d", atoi(argv[2]));
+			SUNSET_DEBUG_LOG(3, phyAddress, "Sunset_Phy_Urick::command Blacklist %d", atoi(argv[2]));
 			
 			return (TCL_OK);
 		}
@@ -286,7 +292,7 @@ void Sunset_Phy_Urick::startTx(Packet* p) {
 			energy->setRxDuration(duration);
 		}
 		else {
-			Sunset_Debug::debugInfo(-1, phyAddress, "Sunset_Phy_Urick::startTx ERROR - STATE %d", state);
+			SUNSET_DEBUG_LOG(-1, phyAddress, "Sunset_Phy_Urick::startTx ERROR - STATE %d", state);
 			exit(0);		
 		}
 		
@@ -311,7 +317,7 @@ void Sunset_Phy_Urick::endTx(Packet* p) {
 	double duration = 0.0;
 	double power = 0.0;
 	
-	Sunset_Debug::debugInfo(3, phyAddress, "Sunset_Phy_Urick::endTx - STATE %d", state);
+	SUNSET_DEBUG_LOG(3, phyAddress, "Sunset_Phy_Urick::endTx - STATE %d", state);
 	
 	if ( use_energy ) {
 		
@@ -329,7 +335,7 @@ void Sunset_Phy_Urick::endTx(Packet* p) {
 				
 			} else {
 				
-				Sunset_Debug::debugInfo(-1, phyAddress, "Sunset_Phy_Urick::endTx ERROR Energy %f", power);
+				SUNSET_DEBUG_LOG(-1, phyAddress, "Sunset_Phy_Urick::endTx ERROR Energy %f", power);
 				exit(0);	
 			}
 		}
@@ -355,13 +361,13 @@ void Sunset_Phy_Urick::startRx(Packet* p) {
 		
 		if ( blackList.find(HDR_CMN(p)->prev_hop_) != blackList.end() ) {
 		
-			Sunset_Debug::debugInfo(3, phyAddress, "Sunset_Phy_Urick::startRx blacklist %d", HDR_CMN(p)->prev_hop_);
+			SUNSET_DEBUG_LOG(3, phyAddress, "Sunset_Phy_Urick::startRx blacklist %d", HDR_CMN(p)->prev_hop_);
 			
 			return;
 		}
 	}
 
-	Sunset_Debug::debugInfo(3, phyAddress, "Sunset_Phy_Urick::startRx - STATE %d", state);
+	SUNSET_DEBUG_LOG(3, phyAddress, "Sunset_Phy_Urick::startRx - STATE %d", state);
 	
 	if ( state == IDLE ) {
 		
@@ -394,7 +400,7 @@ void Sunset_Phy_Urick::startRx(Packet* p) {
 				
 			} else {
 				
-				Sunset_Debug::debugInfo(-1, phyAddress, "Sunset_Phy_Urick::endTx ERROR Energy %f", power);
+				SUNSET_DEBUG_LOG(-1, phyAddress, "Sunset_Phy_Urick::endTx ERROR Energy %f", power);
 				exit(0);	
 			}
 		}
@@ -413,12 +419,12 @@ void Sunset_Phy_Urick::startRx(Packet* p) {
 				
 				endRx_ = NOW + HDR_MPHY(p)->duration;
 				
-				Sunset_Debug::debugInfo(3, phyAddress, "Sunset_Phy_Urick::startRx - STATE %d -%f", state, endRx_);
+				SUNSET_DEBUG_LOG(3, phyAddress, "Sunset_Phy_Urick::startRx - STATE %d -%f", state, endRx_);
 			}
 		}
 	}
 	else {
-		Sunset_Debug::debugInfo(-1, phyAddress, "Sunset_Phy_Urick::startRx ERROR - STATE %d", state);
+		SUNSET_DEBUG_LOG(-1, phyAddress, "Sunset_Phy_Urick::startRx ERROR - STATE %d", state);
 		exit(0);
 	}
 	
@@ -441,7 +447,7 @@ void Sunset_Phy_Urick::endRx(Packet* p) {
 		
 		if ( blackList.find(HDR_CMN(p)->prev_hop_) != blackList.end() ) {
 		
-			Sunset_Debug::debugInfo(3, phyAddress, "Sunset_Phy_Urick::endRx blacklist %d", HDR_CMN(p)->prev_hop_);
+			SUNSET_DEBUG_LOG(3, phyAddress, "Sunset_Phy_Urick::endRx blacklist %d", HDR_CMN(p)->prev_hop_);
 			
 			return;
 		}
@@ -508,24 +514,78 @@ void Sunset_Phy_Urick::endRx(Packet* p) {
 	return UnderwaterMPhyBpsk::endRx(p);
 }
 
+/*!
+ * 	@brief The getNoiseChannel function returns the noise power for the current frequency and bandwidth. When the link cache 
+ *	is used the noise model is evaluated once for each (frequency, bandwidth).
+ */
+
 double Sunset_Phy_Urick::getNoiseChannel()
 {
 	assert(propagation_);
 	
 	double freq = spectralmask_->getFreq();
 	double bw = spectralmask_->getBandwidth();
+	double noisepow = 0.0;
+	
+	if ( use_link_cache && linkCache.getNoise(freq, bw, noisepow) ) {
+		
+		return noisepow;
+	}
 	
 	UnderwaterMPropagation* uwmp = dynamic_cast<UnderwaterMPropagation*>(propagation_);
 	assert(uwmp);
 	
 	double noiseSPDdBperHz = uwmp->uw.getNoise(freq/1000.0);
-	double noisepow = bw * pow(10, noiseSPDdBperHz/10.0);
+	noisepow = bw * pow(10, noiseSPDdBperHz/10.0);
   	
-	Sunset_Debug::debugInfo(5, phyAddress, "Sunset_Phy_Urick::getNoiseChannel - freq %f - bw %f - Pn %f", freq, bw, noisepow);
+	SUNSET_DEBUG_LOG(5, phyAddress, "Sunset_Phy_Urick::getNoiseChannel - freq %f - bw %f - Pn %f", freq, bw, noisepow);
+	
+	if ( use_link_cache ) {
+		
+		linkCache.setNoise(freq, bw, noisepow);
+	}
 	
 	return (noisepow);
 }
 
+/*!
+ * 	@brief The getRxPower function returns the power of the received packet. When the link cache is used the ratio between
+ *	received and transmitted power (propagation, antenna and spectral mask gains) is computed by the channel model once 
+ *	for each link, it is computed again only when the transmitter or the receiver position changes.
+ *	@param p The received packet.
+ */
+
+double Sunset_Phy_Urick::getRxPower(Packet* p)
+{
+	hdr_MPhy* ph = HDR_MPHY(p);
+	int src = HDR_CMN(p)->prev_hop_;
+	double freq = 0.0;
+	double bw = 0.0;
+	double gain = 0.0;
+	double pr = 0.0;
+	
+	if ( !use_link_cache || ph->Pt <= 0.0 || ph->srcSpectralMask == 0 ) {
+		
+		return UnderwaterMPhyBpsk::getRxPower(p);
+	}
+	
+	freq = ph->srcSpectralMask->getFreq();
+	bw = ph->srcSpectralMask->getBandwidth();
+	
+	if ( linkCache.getGain(src, phyAddress, freq, bw, gain) ) {
+		
+		return ph->Pt * gain;
+	}
+	
+	pr = UnderwaterMPhyBpsk::getRxPower(p);
+	
+	linkCache.setGain(src, phyAddress, freq, bw, pr / ph->Pt);
+	
+	SUNSET_DEBUG_LOG(5, phyAddress, "Sunset_Phy_Urick::getRxPower link %d gain %e hits %d misses %d", src, pr / ph->Pt, linkCache.getHits(), linkCache.getMisses());
+	
+	return pr;
+}
+
 int Sunset_Phy_Urick::notify_info(list<notified_info> linfo) 
 { 
 	list<notified_info>::iterator it = linfo.begin();
@@ -536,6 +596,15 @@ int Sunset_Phy_Urick::notify_info(list<notified_info> linfo)
 		ni = *it;
 		string s = "TX_POWER";
 		
+		if ( strcmp((ni.info_name).c_str(), "NODE_POSITION") == 0 ) {
+			
+			Sunset_Phy_Link_Cache::positionChanged(ni.node_id);
+			
+			SUNSET_DEBUG_LOG(3, phyAddress, "Sunset_Phy_Urick::notify_info position changed node %d", ni.node_id);
+			
+			continue;
+		}
+		
 		if ( ni.node_id == phyAddress ) {
 			
 			if (strncmp((ni.info_name).c_str(), s.c_str(), strlen(s.c_str())) == 0 ) {
@@ -543,7 +612,7 @@ int Sunset_Phy_Urick::notify_info(list<notified_info> linfo)
 // 				MaxTxSPL_dB_ =  *static_cast<float *>(ni.info_value);
 				sid->get_value(&MaxTxSPL_dB_, ni);
 				
-				Sunset_Debug::debugInfo(-1, phyAddress, " Sunset_Phy_Urick::notify_info Power Set to %f", MaxTxSPL_dB_);
+				SUNSET_DEBUG_LOG(-1, phyAddress, " Sunset_Phy_Urick::notify_info Power Set to %f", MaxTxSPL_dB_);
 				
 				return 1;
 			}
@@ -53,6 +53,7 @@
 #include <limits>
 #include <climits>
 #include <sunset_packet_error_model.h>
+#include <sunset_phy_link_cache.h>
 
 enum { IDLE = 0, START_TX = 1, END_TX = 2, START_RX = 3, END_RX = 4};
 
@@ -78,11 +79,14 @@ private:
 	
 	double lastPower;
 	
+	Sunset_Phy_Link_Cache linkCache;	// channel gain of each link and noise power, see use_link_cache
+	
 public:
 	Sunset_Phy_Urick();
 	~Sunset_Phy_Urick();
 	
 	virtual double getNoiseChannel();	
+	virtual double getRxPower(Packet* p);
 	virtual int command(int argc, const char* const* argv);
 	
 	virtual void startTx(Packet* p);
@@ -97,6 +101,7 @@ public:
 		
 	int use_pkt_error;
 	int use_energy;
+	int use_link_cache;
 
 	set<int> blackList;
 	
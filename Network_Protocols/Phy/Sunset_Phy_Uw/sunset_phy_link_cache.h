@@ -0,0 +1,208 @@
+/* SUNSET - Sapienza University Networking framework for underwater Simulation, Emulation and real-life Testing
+ *
+ * Copyright (C) 2012 Regents of UWSN Group of SENSES Lab <http://reti.dsi.uniroma1.it/SENSES_lab/>
+ *
+ * Author: Roberto Petroccia - petroccia@di.uniroma1.it
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License as published
+ * at http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANATBILITY or FITNESS FOR A PARTICULAR PURPOSE. See the Creative Commons
+ * Attribution-NonCommercial-ShareAlike 3.0 Unported License for more details.
+ *
+ * You should have received a copy of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License
+ * along with this program. If not, see <http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode>.
+ */
+
+
+#ifndef __Sunset_Phy_Link_Cache_h__
+#define __Sunset_Phy_Link_Cache_h__
+
+#include <vector>
+
+using namespace std;
+
+/*! @brief The channel gain cached for the link from a transmitter to the receiving PHY. */
+
+typedef struct sunset_link_gain {
+	
+	double freq;			// central frequency of the transmission
+	double bw;			// bandwidth of the transmission
+	double gain;			// received power / transmitted power
+	unsigned int srcEpoch;		// position epoch of the transmitter when the gain has been computed
+	unsigned int dstEpoch;		// position epoch of the receiver when the gain has been computed
+	bool valid;
+	
+} sunset_link_gain;
+
+/*! @brief The noise power cached for a given frequency and bandwidth. */
+
+typedef struct sunset_link_noise {
+	
+	double freq;
+	double bw;
+	double noise;
+	
+} sunset_link_noise;
+
+/*! @brief This class caches, for a receiving PHY, the channel gain of each link and the noise power of each (frequency, bandwidth).
+ *  The gain of a link is reused until the position of one of its nodes changes: each node has a position epoch, shared by all 
+ *  the PHYs, which is increased when a new NODE_POSITION is notified by the information dispatcher. An entry computed with 
+ *  older epochs is recomputed, so a static network computes the channel model once per link.
+ */
+
+class Sunset_Phy_Link_Cache {
+	
+public:
+	
+	Sunset_Phy_Link_Cache() { hits_ = misses_ = 0; }
+	
+	/*! @brief The getGain function returns true and the cached gain of the link src-dst if it is still valid. */
+	
+	bool getGain(int src, int dst, double freq, double bw, double& gain)
+	{
+		sunset_link_gain* g = 0;
+		
+		if ( src < 0 || src >= (int)gains_.size() ) {
+			
+			misses_++;
+			
+			return false;
+		}
+		
+		g = &(gains_[src]);
+		
+		if ( !g->valid || g->freq != freq || g->bw != bw || g->srcEpoch != epoch(src) || g->dstEpoch != epoch(dst) ) {
+			
+			misses_++;
+			
+			return false;
+		}
+		
+		hits_++;
+		gain = g->gain;
+		
+		return true;
+	}
+	
+	/*! @brief The setGain function stores the gain of the link src-dst, computed with the current node positions. */
+	
+	void setGain(int src, int dst, double freq, double bw, double gain)
+	{
+		sunset_link_gain* g = 0;
+		
+		if ( src < 0 ) {
+			
+			return;
+		}
+		
+		if ( src >= (int)gains_.size() ) {
+			
+			sunset_link_gain empty;
+			
+			empty.valid = false;
+			gains_.resize(src + 1, empty);
+		}
+		
+		g = &(gains_[src]);
+		
+		g->freq = freq;
+		g->bw = bw;
+		g->gain = gain;
+		g->srcEpoch = epoch(src);
+		g->dstEpoch = epoch(dst);
+		g->valid = true;
+	}
+	
+	/*! @brief The getNoise function returns true and the cached noise power for the given frequency and bandwidth. */
+	
+	bool getNoise(double freq, double bw, double& noise)
+	{
+		for ( int i = 0; i < (int)noises_.size(); i++ ) {
+			
+			if ( noises_[i].freq == freq && noises_[i].bw == bw ) {
+				
+				noise = noises_[i].noise;
+				
+				return true;
+			}
+		}
+		
+		return false;
+	}
+	
+	/*! @brief The setNoise function stores the noise power for the given frequency and bandwidth. */
+	
+	void setNoise(double freq, double bw, double noise)
+	{
+		sunset_link_noise n;
+		
+		n.freq = freq;
+		n.bw = bw;
+		n.noise = noise;
+		
+		noises_.push_back(n);
+	}
+	
+	/*! @brief The clear function removes all the cached information of this PHY. */
+	
+	void clear() 
+	{ 
+		gains_.clear(); 
+		noises_.clear(); 
+	}
+	
+	int getHits() { return hits_; }
+	int getMisses() { return misses_; }
+	
+	/*! @brief The positionChanged function invalidates, in all the PHYs, the gains of the links involving the given node. */
+	
+	static void positionChanged(int node)
+	{
+		vector<unsigned int>& e = epochs();
+		
+		if ( node < 0 ) {
+			
+			return;
+		}
+		
+		if ( node >= (int)e.size() ) {
+			
+			e.resize(node + 1, 0);
+		}
+		
+		e[node]++;
+	}
+	
+private:
+	
+	static vector<unsigned int>& epochs()
+	{
+		static vector<unsigned int> e;
+		
+		return e;
+	}
+	
+	static unsigned int epoch(int node)
+	{
+		vector<unsigned int>& e = epochs();
+		
+		if ( node < 0 || node >= (int)e.size() ) {
+			
+			return 0;
+		}
+		
+		return e[node];
+	}
+	
+	vector<sunset_link_gain> gains_;	// indexed by the transmitter address
+	vector<sunset_link_noise> noises_;
+	
+	int hits_;
+	int misses_;
+};
+
+#endif
@@ -66,7 +66,7 @@ int Sunset_Transport::command(int argc, const char*const* argv)
 		
 		if (strcmp(argv[1], "start") == 0) {
 			
-			Sunset_Debug::debugInfo(1, getModuleAddress(), "Sunset_Transport::command start Module");
+			SUNSET_DEBUG_LOG(1, getModuleAddress(), "Sunset_Transport::command start Module");
 			
 			start();
 			
@@ -90,7 +90,7 @@ int Sunset_Transport::command(int argc, const char*const* argv)
 			
 			module_address = atoi(argv[2]);
 			
-			Sunset_Debug::debugInfo(5, getModuleAddress(), "Sunset_Transport::command module_address %d", module_address);
+			SUNSET_DEBUG_LOG(5, getModuleAddress(), "Sunset_Transport::command module_address %d", module_address);
 			
 			return TCL_OK;
 		}
@@ -115,7 +115,7 @@ void Sunset_Transport::recv(Packet *p)
 		
 		iph->saddr() = getModuleAddress(); //set my address in the IP header
 		
-		Sunset_Debug::debugInfo(5, getModuleAddress(),  "Sunset_Transport::recv receiving something id %d size %d from %d to %d", cmh->uid(), cmh->size(), iph->saddr(), iph->daddr());
+		SUNSET_DEBUG_LOG(5, getModuleAddress(),  "Sunset_Transport::recv receiving something id %d size %d from %d to %d", cmh->uid(), cmh->size(), iph->saddr(), iph->daddr());
 		
 		sendDown(p);
 		
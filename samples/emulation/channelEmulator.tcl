@@ -91,6 +91,7 @@ set params(emulator_port_pos)	8001
 set params(emulator_usePos)	1
 set params(emulator_defProp)	1.0
 set params(emulator_useNSPos)	1
+set params(emulator_server)	0	;# 1 to use Module/Sunset_Channel_Emulator_Server
 
 #POSITION EMULATOR
 set params(position_useNS) 	1
@@ -221,6 +222,7 @@ load $pathSUNSET/libSunset_Emulation_Connection.so.0.0.0
 load $pathSUNSET/libSunset_Emulation_Generic_Modem.so.0.0.0 
 load $pathSUNSET/libSunset_Emulation_Timing_Emulation.so.0.0.0 
 load $pathSUNSET/libSunset_Emulation_Channel_Emulator.so.0.0.0 
+load $pathSUNSET/libSunset_Emulation_Channel_Emulator_Server.so.0.0.0 
 load $pathSUNSET/libSunset_Emulation_Position_Channel.so.0.0.0    
 
 #NETWORK PROTOCOLS-----------------------------
@@ -337,7 +339,11 @@ proc startChannel {} {
 
 	global params channel
 	
-	set channel [new Module/Sunset_Channel_Emulator]
+	if { $params(emulator_server) == 1 } {
+		set channel [new Module/Sunset_Channel_Emulator_Server]
+	} else {
+		set channel [new Module/Sunset_Channel_Emulator]
+	}
 	
 	$channel setChannelPort $params(emulator_port)
 	$channel setPositionPort $params(emulator_port_pos)
@@ -75,6 +75,7 @@ set params(simulationMode) 		0
 set params(urick)			0
 set params(bellhop) 			0
 set params(emulationMode)		1
+set params(monotonicScheduler)	0			;# 1 to run the Scheduler/Sunset_RealTime/Monotonic scheduler (CLOCK_MONOTONIC time base)
 
 #DEVICE DELAY
 set params(device_delay)		0.1
@@ -203,6 +204,11 @@ load $pathSUNSET/libSunset_Core_Energy_Model.so.0.0.0
 #EMULATION COMPONENTS-----------------------------
 
 load $pathSUNSET/libSunset_Emulation_Real_Time_Scheduler.so.0.0.0 
+
+if { $params(monotonicScheduler) == 1 } {
+	load $pathSUNSET/libSunset_Emulation_Monotonic_Scheduler.so.0.0.0 
+}
+
 load $pathSUNSET/libSunset_Emulation_Debug_Emulation.so.0.0.0 
 load $pathSUNSET/libSunset_Emulation_Utilities_Emulation.so.0.0.0 
 load $pathSUNSET/libSunset_Emulation_Connection.so.0.0.0 
@@ -538,6 +544,11 @@ proc finish {} {
 	if {$params(useStat) == 1} {
 		$statistics stop
 	}
+
+	if { $params(monotonicScheduler) == 1 } {
+		# late events, wall-clock steps, dispatched events, mean and max lateness (sec), lateness histogram (log2 us bins)
+		puts "Scheduler lateness [[$ns set scheduler_] getLatenessStats]"
+	}
 }
 
 if { $params(emulationMode) == 1 } {
@@ -546,7 +557,11 @@ if { $params(emulationMode) == 1 } {
 }
 
 $ns use-Miracle
-$ns use-scheduler Sunset_RealTime
+if { $params(monotonicScheduler) == 1 } {
+	$ns use-scheduler Sunset_RealTime/Monotonic
+} else {
+	$ns use-scheduler Sunset_RealTime
+}
 $ns trace-all $params(tracefile)
 
 begin-simulation
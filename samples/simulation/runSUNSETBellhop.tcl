@@ -88,6 +88,8 @@ set params(detectionDB)			1
 set params(maxinterval_)		500.0
 set params(wind)			7.0
 set params(ship)			0.5
+set params(arrivalStore)		""	;# arrival store of the ray tracing results, see sunset_arrival_store
+set params(prewarm)			0	;# 1 to fill the arrival store journal with all the links and exit
 
 #STAT_IFO
 set params(useStat) 			0
@@ -410,6 +412,10 @@ proc createNode { id }  {
 	$phy($id) setModuleAddress $id
 	$phy($id) addPower $params(txPower)
 
+	if { $params(arrivalStore) != "" } {
+		$phy($id) arrivalStore $params(arrivalStore)
+	}
+
 	$node_($id) addModule 6 $cbr_($id)       0 "CBR($id)"
 	$node_($id) addModule 5 $port_($id)      0 "PRT($id)"
 	$node_($id) addModule 4 $transport_($id) 0 "TRA($id)"
@@ -492,6 +498,10 @@ proc createSink { } {
 	$phy($params(sink)) setModuleAddress $params(sink)
 	$phy($params(sink)) addPower $params(txPower)
 
+	if { $params(arrivalStore) != "" } {
+		$phy($params(sink)) arrivalStore $params(arrivalStore)
+	}
+
 	for { set id 1} {$id <= $params(numNodes)} {incr id} {
 		$node_($params(sink)) addModule 6 $cbr_sink_($id) 0 "CBR"
 	}     
@@ -610,7 +620,7 @@ proc endModule { } {
 
 proc finish {} {
 
-	global ns params db_manager statistics cbr_sink_ cbr_ energy
+	global ns params db_manager statistics cbr_sink_ cbr_ energy phy
 
 	if { $params(bellhop) == 1 } {
 		$db_manager closeAllConnections
@@ -623,6 +633,29 @@ proc finish {} {
 	puts "\n"
 	puts "\n"
 
+	if { $params(arrivalStore) != "" } {
+
+		# gains found in the store and time spent computing the missing ones, the propagation delays are not stored
+
+		set hits 0
+		set computed 0
+		set time 0.0
+
+		for {set id 1} {$id <= $params(numNodes)} {incr id}  {
+			set stats [$phy($id) getArrivalStoreStats]
+			set hits [expr $hits + [lindex $stats 0]]
+			set computed [expr $computed + [lindex $stats 3]]
+			set time [expr $time + [lindex $stats 4]]
+		}
+
+		puts "arrival store gains found     : $hits"
+		puts "arrival store gains computed  : $computed in $time sec"
+
+		if { $computed > 0 } {
+			puts "arrival store time saved      : [expr $hits * $time / $computed] sec"
+		}
+	}
+
 	if {$params(useStat) == 1} {
 
 		source "tcl_folder/printStat.tcl"
@@ -694,6 +727,10 @@ for {set id 1} {$id <= $params(numNodes)} {incr id}  {
 	createPosition $id
 }
 
+if { $params(prewarm) == 1 } {
+	source "tcl_folder/SUNSETBellhopPrewarm.tcl"
+}
+
 ###############################
 # create CBR connections
 ###############################
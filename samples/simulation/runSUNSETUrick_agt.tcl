@@ -116,6 +116,7 @@ set params(short_retry)			7
 set params(lambda)			0  ;# poisson traffic (if 0 use cbr)
 set params(usePktTime)			0  ;# use lambda generation packet per packet time
 set params(cbr_period)			400 ;# cbr traffic (if 0 use lamba)
+set params(nativeTraffic)		0  ;# use the Sunset_Traffic_Generator modules instead of the TCL traffic procedures
 set params(seed)			1
 
 ########### PARSING PARAMETERS  ##############################
@@ -824,9 +825,52 @@ proc startTraffic {} {
 	set nowT [$ns now]
 	set time $nowT
 
+	if { $params(nativeTraffic) == 1 } {
+		genTrafficNative
+		return
+	}
+
 	genTrafficSimulation
 }
 
+###################
+# native traffic: one generator per source node, the aggregate traffic is the one of genTrafficSimulation
+###################
+
+proc genTrafficNative {} {
+	global ns source_ params TRAFFIC_RATE rngTrafficStartTimes traffic_
+
+	set numSources [expr $params(numNodes) - 1]
+	set k 0
+
+	for {set id 1} {$id <= $params(numNodes)} {incr id} {
+
+		if { $id == $params(sink) } continue
+
+		set traffic_($id) [new Sunset_Traffic_Generator]
+
+		$traffic_($id) setAgent $source_($id)
+		$traffic_($id) setRng $rngTrafficStartTimes
+		$traffic_($id) set endTime [expr $params(end_traffic) - $params(traffic_barrier)]
+
+		if { $params(randomDest) == 1 } {
+			$traffic_($id) setRandomDestination 1 $params(numNodes)
+		} else {
+			$traffic_($id) setDestination $params(sink)
+		}
+
+		if { $TRAFFIC_RATE != -1.0 } {
+			$traffic_($id) setPoisson [expr $TRAFFIC_RATE / $numSources]
+			$traffic_($id) start
+		} else {
+			$traffic_($id) setCbr [expr $params(cbr_period) * $numSources]
+			$traffic_($id) start [expr [$ns now] + $params(cbr_period) * ($k + 1)]
+		}
+
+		incr k
+	}
+}
+
 
 ############################################################
 
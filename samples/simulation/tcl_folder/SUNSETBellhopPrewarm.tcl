@@ -0,0 +1,59 @@
+# SUNSET - Sapienza University Networking framework for underwater Simulation, Emulation and real-life Testing
+#
+# Copyright (C) 2012 Regents of UWSN Group of SENSES Lab
+#
+# Author: Roberto Petroccia - petroccia@di.uniroma1.it
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License as published
+# at http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANATBILITY or FITNESS FOR A PARTICULAR PURPOSE. See the Creative Commons
+# Attribution-NonCommercial-ShareAlike 3.0 Unported License for more details.
+#
+# You should have received a copy of the Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License
+# along with this program. If not, see <http://creativecommons.org/licenses/by-nc-sa/3.0/legalcode>.
+#
+#
+# Computes the channel gain of all the links of the topology and appends them to the arrival store journal,
+# then exits. It is sourced once nodes and positions have been created, e.g.:
+#
+#	sunset_arrival_store prewarm -j 8 arrivals.db ns runSUNSETBellhop.tcl -arrivalStore arrivals.db -prewarm 1
+#
+# The links are split among the parallel jobs according to SUNSET_PREWARM_SHARD and SUNSET_PREWARM_SHARDS.
+
+global phy position_ params env db_manager
+
+set shard 0
+set shards 1
+
+if { [info exists env(SUNSET_PREWARM_SHARD)] } {
+	set shard $env(SUNSET_PREWARM_SHARD)
+	set shards $env(SUNSET_PREWARM_SHARDS)
+}
+
+set link 0
+
+for {set rx 1} {$rx <= $params(numNodes)} {incr rx}  {
+	for {set tx 1} {$tx <= $params(numNodes)} {incr tx}  {
+		if { $tx == $rx } {
+			continue
+		}
+
+		if { [expr $link % $shards] == $shard } {
+			$phy($rx) prewarmLink $position_($tx)
+		}
+
+		incr link
+	}
+}
+
+puts "Prewarm shard $shard/$shards: [expr ($link + $shards - 1 - $shard) / $shards] links"
+
+if { $params(bellhop) == 1 } {
+	$db_manager closeAllConnections
+}
+
+exit 0
@@ -57,4 +57,9 @@ if {$params(useStat) == 1} {
 
 	puts "-1 -################### ------ALL INFO------ #############################"
 
+	# all the per-link and per-node metrics computed in one pass, e.g. for post-processing scripts
+	if {[info exists params(exportMetrics)] && $params(exportMetrics) != ""} {
+		$statistics exportMetrics csv $params(exportMetrics)
+	}
+
 }
\ No newline at end of file
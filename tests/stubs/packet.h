@@ -0,0 +1,17 @@
+/* Minimal replacement of the ns-2 packet.h used to compile the header-only components outside ns-2: the packets
+ * are only handled by pointer.
+ */
+
+#ifndef ns_packet_h
+#define ns_packet_h
+
+class Packet {
+
+public:
+
+	Packet(int id = 0) { id_ = id; }
+
+	int id_;
+};
+
+#endif
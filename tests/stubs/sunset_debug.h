@@ -0,0 +1,12 @@
+/* Minimal replacement of the core sunset_debug.h used to compile the header-only components outside ns-2: only
+ * the errors (level -1) are printed.
+ */
+
+#ifndef __Sunset_Debug_h__
+#define __Sunset_Debug_h__
+
+#include <stdio.h>
+
+#define SUNSET_DEBUG_LOG(level, id, ...) do { if ( (level) < 0 ) { fprintf(stderr, __VA_ARGS__); fprintf(stderr, "\n"); } } while ( 0 )
+
+#endif
@@ -0,0 +1,16 @@
+/* Minimal replacement of the core sunset_information_dispatcher.h used to compile the header-only components 
+ * outside ns-2: only the node_position structure is defined.
+ */
+
+#ifndef __Sunset_Information_Dispatcher_h__
+#define __Sunset_Information_Dispatcher_h__
+
+typedef struct node_position {
+	
+	double latitude;
+	double longitude;
+	double depth;
+	
+} node_position;
+
+#endif
@@ -0,0 +1,325 @@
+/* Sends packets through Sunset_Channel_Emulator_Core over real sockets using the byte format of the emulator modem
+ * clients: the propagation delays, a node reconnecting, coalesced and split messages, the position port and the
+ * deliveries pending when the core stops.
+ */
+
+#include <assert.h>
+#include <poll.h>
+#include <arpa/inet.h>
+
+#include <sunset_channel_emulator_core.h>
+
+static int port = 0;
+
+static int connectTo(int p)
+{
+	struct sockaddr_in addr;
+	int fd = socket(AF_INET, SOCK_STREAM, 0);
+
+	memset(&addr, 0x0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+	addr.sin_port = htons(p);
+
+	assert(fd >= 0 && connect(fd, (struct sockaddr*)&addr, sizeof(addr)) == 0);
+
+	return fd;
+}
+
+/* Reads exactly len bytes, returns false on timeout. */
+
+static bool readAll(int fd, char* buf, int len, int timeoutMs)
+{
+	struct pollfd p;
+	int off = 0;
+	int r = 0;
+
+	p.fd = fd;
+	p.events = POLLIN;
+
+	while ( off < len ) {
+
+		if ( poll(&p, 1, timeoutMs) <= 0 ) {
+
+			return false;
+		}
+
+		r = read(fd, buf + off, len - off);
+
+		if ( r <= 0 ) {
+
+			return false;
+		}
+
+		off += r;
+	}
+
+	return true;
+}
+
+static bool nothingToRead(int fd, int timeoutMs)
+{
+	struct pollfd p;
+
+	p.fd = fd;
+	p.events = POLLIN;
+
+	return poll(&p, 1, timeoutMs) == 0;
+}
+
+static void sendAll(int fd, const char* data, int len)
+{
+	assert(write(fd, data, len) == len);
+}
+
+/* The node ID is sent as a raw int by the emulator modems. */
+
+static void sendId(int fd, int id)
+{
+	sendAll(fd, (const char*)&id, sizeof(int));
+}
+
+/* Builds a modem message: "**", source and destination as raw ints, hex payload, "##". */
+
+static int message(char* buf, int src, int dst, const char* hex)
+{
+	int len = strlen(hex);
+
+	memcpy(buf, "**", 2);
+	memcpy(buf + 2, &src, sizeof(int));
+	memcpy(buf + 6, &dst, sizeof(int));
+	memcpy(buf + 10, hex, len);
+	memcpy(buf + 10 + len, "##", 2);
+
+	return len + 12;
+}
+
+static bool receive(int fd, const char* expected, int len)
+{
+	char buf[256];
+
+	return readAll(fd, buf, len, 1000) && memcmp(buf, expected, len) == 0;
+}
+
+static void testNodes()
+{
+	Sunset_Channel_Emulator_Core core;
+	node_position a = { 0.0, 0.0, 0.0 };
+	node_position b = { 300.0, 0.0, 0.0 };
+	char msg[64];
+	double t = 0.0;
+	int len = 0;
+	int n1 = 0;
+	int n2 = 0;
+	int n3 = 0;
+
+	core.setCartesian(true);
+	core.setDefPropDelay(0.05);
+	core.setNumWorkers(2);
+	core.setPosition(1, a);
+	core.setPosition(2, b);
+
+	assert(core.listen(port, false));
+	assert(core.start());
+
+	n1 = connectTo(port);
+	n2 = connectTo(port);
+	n3 = connectTo(port);
+
+	sendId(n1, 1);
+	sendId(n2, 2);
+	sendId(n3, 3);
+	usleep(50000);
+
+	// node 2 is 300 m away from node 1 (0.2 s), node 3 has no position and gets the default delay
+
+	len = message(msg, 1, 2, "0A0B0C");
+	t = Sunset_Channel_Emulator_Core::now();
+	sendAll(n1, msg, len);
+
+	assert(receive(n3, msg, len));
+	assert(Sunset_Channel_Emulator_Core::now() - t < 0.19);
+
+	assert(receive(n2, msg, len));
+	assert(Sunset_Channel_Emulator_Core::now() - t >= 0.2 - SUNSET_EMU_WHEEL_RESOLUTION);
+
+	assert(nothingToRead(n1, 300));		// the transmitter does not receive its own packet
+
+	// a node reconnecting with the same ID replaces its old connection
+
+	close(n3);
+	n3 = connectTo(port);
+	sendId(n3, 3);
+	usleep(50000);
+
+	len = message(msg, 2, -1, "FF");
+	sendAll(n2, msg, len);
+
+	assert(receive(n3, msg, len));
+	assert(receive(n1, msg, len));
+
+	core.stop();
+
+	close(n1);
+	close(n2);
+	close(n3);
+
+	puts("nodes ok");
+}
+
+static void testFraming()
+{
+	Sunset_Channel_Emulator_Core core;
+	char out[256];
+	char msg[64];
+	int len = 0;
+	int off = 0;
+	int tx = 0;
+	int rx = 0;
+	int id = 0;
+
+	core.setDefPropDelay(0.01);
+
+	assert(core.listen(port, false));
+	assert(core.start());
+
+	rx = connectTo(port);
+	sendId(rx, 4);
+
+	// the ID and two messages in a single write; the ID (35) and the addresses contain the end marker '#'
+
+	tx = connectTo(port);
+	id = '#';
+	memcpy(out, &id, sizeof(int));
+	off = sizeof(int);
+	off += message(out + off, '#', 0x2323, "01AB");
+	off += message(out + off, '#', 4, "FF");
+	sendAll(tx, out, off);
+
+	len = message(msg, '#', 0x2323, "01AB");
+	assert(receive(rx, msg, len));
+	len = message(msg, '#', 4, "FF");
+	assert(receive(rx, msg, len));
+
+	// a message split in single bytes, preceded by data which are not a message
+
+	sendAll(tx, "xyz", 3);
+	len = message(msg, '#', 4, "C0FFEE");
+
+	for ( int i = 0; i < len; i++ ) {
+
+		sendAll(tx, msg + i, 1);
+		usleep(2000);
+	}
+
+	assert(receive(rx, msg, len));
+	assert(nothingToRead(rx, 100));
+
+	core.stop();
+
+	close(tx);
+	close(rx);
+
+	puts("framing ok");
+}
+
+static int position(char* buf, int node, double x, double y, double depth)
+{
+	memcpy(buf, &node, sizeof(int));
+	memcpy(buf + sizeof(int), &x, sizeof(double));
+	memcpy(buf + sizeof(int) + sizeof(double), &y, sizeof(double));
+	memcpy(buf + sizeof(int) + 2 * sizeof(double), &depth, sizeof(double));
+
+	return SUNSET_EMU_POS_MSG_SIZE;
+}
+
+static void testPositionPort()
+{
+	Sunset_Channel_Emulator_Core core;
+	char buf[3 * SUNSET_EMU_POS_MSG_SIZE];
+	int len = 0;
+	int fd = 0;
+
+	core.setCartesian(true);
+
+	assert(core.listen(port, false));
+	assert(core.listen(port + 1, true));
+	assert(core.start());
+
+	fd = connectTo(port + 1);
+
+	// two positions in a single write, then a position split in two writes
+
+	len = position(buf, 7, 0.0, 0.0, 0.0);
+	len += position(buf + len, 8, 0.0, 1500.0, 0.0);
+	len += position(buf + len, 9, 0.0, 0.0, 750.0);
+
+	sendAll(fd, buf, 2 * SUNSET_EMU_POS_MSG_SIZE + 5);
+	usleep(50000);
+	sendAll(fd, buf + 2 * SUNSET_EMU_POS_MSG_SIZE + 5, SUNSET_EMU_POS_MSG_SIZE - 5);
+	usleep(100000);
+
+	assert(fabs(core.getLinkDelay(7, 8) - 1.0) < 1e-6);
+	assert(fabs(core.getLinkDelay(9, 7) - 0.5) < 1e-6);
+
+	core.stop();
+	close(fd);
+
+	puts("position port ok");
+}
+
+static void testStopPending()
+{
+	Sunset_Channel_Emulator_Core core;
+	char msg[64];
+	int len = 0;
+	int n1 = 0;
+	int n2 = 0;
+	int n3 = 0;
+
+	core.setDefPropDelay(10.0);
+
+	assert(core.listen(port, false));
+	assert(core.start());
+
+	n1 = connectTo(port);
+	n2 = connectTo(port);
+	n3 = connectTo(port);
+
+	sendId(n1, 1);
+	sendId(n2, 2);
+	sendId(n3, 3);
+	usleep(50000);
+
+	len = message(msg, 1, -1, "0102");
+	sendAll(n1, msg, len);
+	usleep(50000);
+
+	core.stop();
+
+	assert(core.getPending() == 0);		// the two deliveries and their shared payload have been released
+
+	close(n1);
+	close(n2);
+	close(n3);
+
+	puts("stop with pending deliveries ok");
+}
+
+int main()
+{
+	port = 20000 + getpid() % 20000;
+
+	testNodes();
+
+	port += 2;
+	testFraming();
+
+	port += 2;
+	testPositionPort();
+
+	port += 2;
+	testStopPending();
+
+	return 0;
+}
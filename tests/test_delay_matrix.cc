@@ -0,0 +1,177 @@
+/* Checks the delay matrix of Sunset_Channel_Emulator_Core against the delays computed per packet by
+ * Sunset_Channel_Emulator: getNodesDelay() divides getCartDistance() by 1500 m/s and uses the default delay when a
+ * node position is unknown.
+ */
+
+#include <assert.h>
+
+#include <sunset_channel_emulator_core.h>
+
+#define NODES 100
+
+/* Sunset_Channel_Emulator::getCartDistance: straight line distance between the points at (6371000 - depth) m from
+ * the Earth center, latitude converted to colatitude.
+ */
+
+static double cartDistance(node_position a, node_position b)
+{
+	double ra = 6371000.0 - a.depth;
+	double rb = 6371000.0 - b.depth;
+	double ta = (90.0 - a.latitude) * M_PI / 180.0;
+	double tb = (90.0 - b.latitude) * M_PI / 180.0;
+	double pa = a.longitude * M_PI / 180.0;
+	double pb = b.longitude * M_PI / 180.0;
+	double dx = ra * sin(ta) * cos(pa) - rb * sin(tb) * cos(pb);
+	double dy = ra * sin(ta) * sin(pa) - rb * sin(tb) * sin(pb);
+	double dz = ra * cos(ta) - rb * cos(tb);
+
+	return sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+static node_position positions[NODES];
+static bool known[NODES];
+static double defDelay = 1.0;
+
+static double legacyDelay(int src, int dst)
+{
+	if ( !known[src] || !known[dst] ) {
+
+		return defDelay;
+	}
+
+	return cartDistance(positions[src], positions[dst]) / 1500.0;
+}
+
+static int checkAll(Sunset_Channel_Emulator_Core& core)
+{
+	double d = 0.0;
+	double ref = 0.0;
+	int n = 0;
+
+	for ( int i = 0; i < NODES; i++ ) {
+
+		for ( int j = 0; j < NODES; j++ ) {
+
+			d = core.getLinkDelay(i, j);
+			ref = legacyDelay(i, j);
+
+			if ( fabs(d - ref) > 1e-6 + 1e-6 * ref ) {
+
+				fprintf(stderr, "link %d -> %d delay %.9f expected %.9f\n", i, j, d, ref);
+
+				return 1;
+			}
+
+			n++;
+		}
+	}
+
+	return n == NODES * NODES ? 0 : 1;
+}
+
+static node_position randomPosition()
+{
+	node_position p;
+
+	p.latitude = 42.0 + (rand() % 10000) / 100000.0;	// nodes within about 10 km
+	p.longitude = 12.0 + (rand() % 10000) / 100000.0;
+	p.depth = (rand() % 2000) / 10.0;
+
+	return p;
+}
+
+int main()
+{
+	Sunset_Channel_Emulator_Core core;
+
+	srand(1);
+
+	core.setNumWorkers(4);
+	assert(core.start());	// full rebuilds are split on the worker pool
+
+	core.setDefPropDelay(defDelay);
+
+	// positions set one at a time, every third node has no position and gets the default delay
+
+	for ( int i = 0; i < NODES; i++ ) {
+
+		known[i] = (i % 3 != 0);
+
+		if ( known[i] ) {
+
+			positions[i] = randomPosition();
+			core.setPosition(i, positions[i]);
+		}
+	}
+
+	assert(checkAll(core) == 0);
+	puts("incremental updates ok");
+
+	// moving nodes recompute only their row and column
+
+	for ( int k = 0; k < 200; k++ ) {
+
+		int i = rand() % NODES;
+
+		known[i] = true;
+		positions[i] = randomPosition();
+		core.setPosition(i, positions[i]);
+	}
+
+	assert(checkAll(core) == 0);
+	puts("moving nodes ok");
+
+	// a new default delay rebuilds the matrix on the workers
+
+	for ( int i = 0; i < NODES; i += 7 ) {
+
+		known[i] = false;
+	}
+
+	defDelay = 2.5;
+
+	{
+		Sunset_Channel_Emulator_Core other;
+
+		other.setNumWorkers(3);
+		assert(other.start());
+
+		for ( int i = 0; i < NODES; i++ ) {
+
+			if ( known[i] ) {
+
+				other.setPosition(i, positions[i]);
+			}
+		}
+
+		other.setDefPropDelay(defDelay);
+
+		assert(checkAll(other) == 0);
+
+		other.stop();
+	}
+
+	puts("rebuild ok");
+
+	// nodes outside the matrix get the default delay
+
+	assert(core.getLinkDelay(1, 10000) == 1.0 && core.getLinkDelay(-1, 1) == 1.0);
+
+	// Cartesian positions: x, y and depth in meters
+
+	core.setCartesian(true);
+
+	node_position a = { 0.0, 0.0, 10.0 };
+	node_position b = { 300.0, 400.0, 10.0 };
+
+	core.setPosition(1, a);
+	core.setPosition(2, b);
+
+	assert(fabs(core.getLinkDelay(1, 2) - 500.0 / 1500.0) < 1e-6);
+	assert(core.getLinkDelay(2, 1) == core.getLinkDelay(1, 2));
+	puts("cartesian ok");
+
+	core.stop();
+
+	return 0;
+}
@@ -0,0 +1,187 @@
+/* Positions computed by Sunset_Mobility and Sunset_Position_Store: waypoint and trace interpolation, constant velocity
+ * and the movement threshold used for the position notifications.
+ */
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include <sunset_mobility.h>
+
+static node_position makePos(double lat, double lon, double depth)
+{
+	node_position p;
+
+	p.latitude = lat;
+	p.longitude = lon;
+	p.depth = depth;
+
+	return p;
+}
+
+static bool near(node_position p, double lat, double lon, double depth)
+{
+	return fabs(p.latitude - lat) < 1e-9 && fabs(p.longitude - lon) < 1e-9 && fabs(p.depth - depth) < 1e-9;
+}
+
+static void testWaypoints()
+{
+	Sunset_Mobility m;
+	node_position p;
+
+	assert(!m.getPosition(0.0, &p));
+
+	assert(m.addWaypoint(10.0, makePos(0.0, 0.0, 0.0)));
+	assert(m.addWaypoint(20.0, makePos(100.0, 0.0, 10.0)));
+	assert(m.addWaypoint(20.0, makePos(100.0, 0.0, 10.0)));	// a stop: zero length segment
+	assert(m.addWaypoint(40.0, makePos(100.0, 200.0, 50.0)));
+	assert(!m.addWaypoint(30.0, makePos(0.0, 0.0, 0.0)));		// older than the last waypoint
+	assert(m.isMoving() && m.getType() == SUNSET_MOBILITY_WAYPOINTS);
+
+	// before the first and after the last waypoint the node does not move
+
+	assert(m.getPosition(0.0, &p) && near(p, 0.0, 0.0, 0.0));
+	assert(m.getPosition(100.0, &p) && near(p, 100.0, 200.0, 50.0));
+
+	// linear interpolation, queries forward in time
+
+	assert(m.getPosition(15.0, &p) && near(p, 50.0, 0.0, 5.0));
+	assert(m.getPosition(20.0, &p) && near(p, 100.0, 0.0, 10.0));
+	assert(m.getPosition(30.0, &p) && near(p, 100.0, 100.0, 30.0));
+	assert(m.getPosition(39.0, &p) && near(p, 100.0, 190.0, 48.0));
+
+	// a query back in time restarts from the first segment
+
+	assert(m.getPosition(12.0, &p) && near(p, 20.0, 0.0, 2.0));
+
+	// a fixed position replaces the waypoints
+
+	m.setPosition(makePos(1.0, 2.0, 3.0), 50.0);
+
+	assert(!m.isMoving() && m.getPosition(15.0, &p) && near(p, 1.0, 2.0, 3.0));
+
+	puts("waypoints ok");
+}
+
+static void testTrace()
+{
+	Sunset_Mobility m;
+	node_position p;
+	char file[] = "/tmp/sunset_trace_XXXXXX";
+	int fd = mkstemp(file);
+	FILE* f = fdopen(fd, "w");
+
+	assert(f != NULL);
+
+	fprintf(f, "# time latitude longitude depth\n");
+	fprintf(f, "0 42.0 12.0 5\n");
+	fprintf(f, "\n");
+	fprintf(f, "100 42.001 12.002 15\r\n");
+	fprintf(f, "wrong line\n");
+	fprintf(f, "50 42.5 12.5 0\n");			// out of order, discarded
+	fprintf(f, "300 42.001 12.004 15\n");
+	fclose(f);
+
+	assert(m.loadTrace(file));
+
+	assert(m.getPosition(-1.0, &p) && near(p, 42.0, 12.0, 5.0));
+	assert(m.getPosition(50.0, &p) && near(p, 42.0005, 12.001, 10.0));
+	assert(m.getPosition(200.0, &p) && near(p, 42.001, 12.003, 15.0));
+	assert(m.getPosition(1000.0, &p) && near(p, 42.001, 12.004, 15.0));
+
+	// an empty trace leaves the node without position
+
+	f = fopen(file, "w");
+	fprintf(f, "# no waypoints\n");
+	fclose(f);
+
+	assert(!m.loadTrace(file) && !m.getPosition(0.0, &p));
+	assert(!m.loadTrace("/nonexistent/sunset_trace"));
+
+	unlink(file);
+
+	puts("trace ok");
+}
+
+static void testVelocity()
+{
+	Sunset_Mobility m;
+	node_position p;
+
+	// Cartesian: heading clockwise from x, vertical speed positive moving deeper
+
+	m.setCartesian(true);
+	m.setPosition(makePos(0.0, 0.0, 10.0), 0.0);
+	m.setVelocity(2.0, 90.0, 0.5, 10.0);
+
+	assert(m.isMoving());
+	assert(m.getPosition(20.0, &p) && near(p, 0.0, 20.0, 15.0));
+
+	// a new velocity starts from the current position
+
+	m.setVelocity(1.0, 0.0, 0.0, 20.0);
+
+	assert(m.getPosition(30.0, &p) && near(p, 10.0, 20.0, 15.0));
+
+	m.setVelocity(0.0, 0.0, 0.0, 30.0);
+
+	assert(!m.isMoving() && m.getPosition(100.0, &p) && near(p, 10.0, 20.0, 15.0));
+
+	// geographic: a degree of latitude is 2 * pi * R / 360 m
+
+	Sunset_Mobility g;
+	double degree = 2.0 * M_PI * SUNSET_MOBILITY_EARTH_RADIUS / 360.0;
+
+	g.setPosition(makePos(42.0, 12.0, 0.0), 0.0);
+	g.setVelocity(1.0, 0.0, 0.0, 0.0);
+
+	assert(g.getPosition(degree / 1000.0, &p) && fabs(p.latitude - 42.001) < 1e-9 && fabs(p.longitude - 12.0) < 1e-12);
+	assert(fabs(Sunset_Mobility::getDistance(makePos(42.0, 12.0, 0.0), p, false) - degree / 1000.0) < 1e-6);
+
+	puts("velocity ok");
+}
+
+static void testStore()
+{
+	Sunset_Position_Store* s = Sunset_Position_Store::instance();
+	node_position p;
+
+	assert(!s->hasPosition(3) && !s->getPosition(3, 0.0, &p) && s->getMobility(-1) == NULL);
+
+	s->setCartesian(true);
+	s->setPosition(3, makePos(0.0, 0.0, 0.0), 0.0);
+
+	assert(s->hasPosition(3) && !s->isMoving(3));
+
+	s->getMobility(3)->setVelocity(1.0, 0.0, 0.0, 0.0);
+	s->setReported(3, makePos(0.0, 0.0, 0.0));
+
+	assert(s->isMoving(3));
+
+	// notified only after moving more than the threshold from the last notified position
+
+	assert(!s->checkMoved(3, 0.9, 1.0, &p));
+	assert(s->checkMoved(3, 1.1, 1.0, &p) && near(p, 1.1, 0.0, 0.0));
+	assert(!s->checkMoved(3, 2.0, 1.0, &p));
+	assert(s->checkMoved(3, 2.2, 1.0, &p));
+
+	// nodes created after setCartesian use the same coordinates
+
+	s->setPosition(8, makePos(0.0, 0.0, 0.0), 0.0);
+	s->getMobility(8)->setVelocity(1.0, 90.0, 0.0, 0.0);
+
+	assert(s->getPosition(8, 5.0, &p) && near(p, 0.0, 5.0, 0.0));
+
+	puts("store ok");
+}
+
+int main()
+{
+	testWaypoints();
+	testTrace();
+	testVelocity();
+	testStore();
+
+	return 0;
+}
@@ -0,0 +1,129 @@
+/* Sunset_RT_Clock: the monotonic time, the wall-clock steps, the waits on the scheduler condition variable and the
+ * lateness histogram.
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <sunset_rt_clock.h>
+
+static pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t cond;
+
+static void* signaller(void*)
+{
+	usleep(20000);
+
+	pthread_mutex_lock(&mutex);
+	pthread_cond_signal(&cond);
+	pthread_mutex_unlock(&mutex);
+
+	return 0;
+}
+
+static void testTime()
+{
+	Sunset_RT_Clock clk;
+	double t = 0.0;
+
+	// the time starts from the value given to reset
+
+	clk.reset(100.0);
+
+	t = clk.now();
+
+	assert(t >= 100.0 && t < 100.1);
+
+	usleep(10000);
+
+	assert(clk.now() - t >= 0.01);
+
+	// only the differences larger than the threshold are steps
+
+	clk.setStepThreshold(0.1);
+
+	assert(clk.checkStep(clk.now() + 0.05) == 0.0 && clk.getWallSteps() == 0);
+	assert(clk.checkStep(clk.now() + 5.0) > 4.9 && clk.getWallSteps() == 1);
+	assert(clk.checkStep(clk.now() - 5.0) < -4.9 && clk.getWallSteps() == 2);
+
+	puts("time ok");
+}
+
+static void testWait()
+{
+	Sunset_RT_Clock clk;
+	pthread_t th;
+	double t = 0.0;
+
+	clk.initCondition(&cond);
+	clk.setSpinWindow(0.002);
+
+	// a deadline reached: the mutex is locked again on return
+
+	pthread_mutex_lock(&mutex);
+
+	t = clk.now() + 0.03;
+
+	assert(clk.waitUntil(t, &cond, &mutex) == 0);
+	assert(clk.now() >= t && clk.now() - t < 0.05);
+	assert(pthread_mutex_trylock(&mutex) != 0);
+
+	// a deadline in the past returns at once
+
+	assert(clk.waitUntil(clk.now() - 1.0, &cond, &mutex) == 0);
+
+	// a new event wakes the wait before the deadline
+
+	pthread_create(&th, 0, signaller, 0);
+
+	t = clk.now();
+
+	assert(clk.waitUntil(t + 5.0, &cond, &mutex) == 1);
+	assert(clk.now() - t < 1.0);
+
+	pthread_mutex_unlock(&mutex);
+	pthread_join(th, 0);
+
+	pthread_cond_destroy(&cond);
+
+	puts("wait ok");
+}
+
+static void testLateness()
+{
+	Sunset_RT_Clock clk;
+	char buf[512];
+
+	clk.recordLateness(-0.001);
+	clk.recordLateness(0.0000005);
+	clk.recordLateness(0.000003);
+	clk.recordLateness(0.001);
+	clk.recordLateness(100.0);
+
+	// bin 0 up to 1 us, bin 2 up to 4 us, bin 10 up to 1024 us, the last bin all the others
+
+	assert(clk.getDispatched() == 5 && clk.getLateness(0) == 2 && clk.getLateness(2) == 1);
+	assert(clk.getLateness(10) == 1 && clk.getLateness(SUNSET_RT_LATENESS_BINS - 1) == 1);
+	assert(clk.getMaxLateness() == 100.0 && clk.getMeanLateness() > 20.0);
+
+	clk.printLateness(buf, sizeof(buf));
+
+	assert(strncmp(buf, "5 ", 2) == 0);
+
+	clk.clearLateness();
+
+	assert(clk.getDispatched() == 0 && clk.getLateness(0) == 0 && clk.getMaxLateness() == 0.0);
+
+	puts("lateness ok");
+}
+
+int main()
+{
+	testTime();
+	testWait();
+	testLateness();
+
+	return 0;
+}
@@ -0,0 +1,248 @@
+/* Slot times of Sunset_Mac_Slot_Clock: the TDMA transmissions of a node waking up only in its slot when a packet is
+ * waiting have to be the ones of a node waking up at every slot, packets arriving exactly on a boundary included.
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <vector>
+
+#include <sunset_mac_slot_clock.h>
+
+using namespace std;
+
+#define SLOT_TIME 0.3
+#define SLOT_PER_FRAME 5
+#define MY_SLOT 2
+#define BOUNDARIES 400
+
+static double boundary[BOUNDARIES];
+
+/* Slot timer restarted at every slot: the slot timer has been scheduled one slot before, it expires before the packets
+ * arriving at the same time.
+ */
+
+static vector<double> perSlot(const vector<double>& arrivals)
+{
+	vector<double> tx;
+	int waiting = 0;
+	unsigned int a = 0;
+
+	for ( int k = 0; k < BOUNDARIES; k++ ) {
+
+		while ( a < arrivals.size() && arrivals[a] < boundary[k] ) {
+
+			waiting++;
+			a++;
+		}
+
+		if ( k % SLOT_PER_FRAME == MY_SLOT && waiting > 0 ) {
+
+			tx.push_back(boundary[k]);
+			waiting--;
+		}
+	}
+
+	return tx;
+}
+
+/* Slot timer scheduled only on the own slots when a packet is waiting, as done by Sunset_Tdma::armSlotTimer(). */
+
+class Skipping {
+
+public:
+
+	Skipping() { pending = false; wake = 0.0; waiting = 0; }
+
+	void start(double now)
+	{
+		clock.start(now, SLOT_TIME, SLOT_TIME);
+	}
+
+	void arm(double now)
+	{
+		long next = 0;
+		double w = 0.0;
+
+		clock.update(now, pending && wake <= now);
+		next = clock.getCount();
+
+		if ( waiting == 0 ) {
+
+			pending = false;
+			return;
+		}
+
+		next = Sunset_Mac_Slot_Clock::getNextInFrame(next, MY_SLOT, SLOT_PER_FRAME);
+		w = clock.getBoundary(next);
+
+		if ( pending && wake == w ) {
+
+			return;
+		}
+
+		assert(now + Sunset_Mac_Slot_Clock::getDelay(now, w) == w);
+
+		wake = w;
+		pending = true;
+	}
+
+	void send(double now)
+	{
+		waiting++;
+		arm(now);
+	}
+
+	void slotHandler(double now)
+	{
+		pending = false;
+		handled++;
+
+		assert(clock.advanceTo(now) > 0);
+
+		if ( (clock.getCount() - 1) % SLOT_PER_FRAME == MY_SLOT && waiting > 0 ) {
+
+			tx.push_back(now);
+			waiting--;
+		}
+
+		arm(now);
+	}
+
+	vector<double> run(const vector<double>& arrivals)
+	{
+		unsigned int a = 0;
+
+		handled = 0;
+		start(0.0);
+
+		while ( a < arrivals.size() || pending ) {
+
+			if ( pending && (a == arrivals.size() || wake <= arrivals[a]) ) {
+
+				slotHandler(wake);
+			}
+			else {
+
+				send(arrivals[a++]);
+			}
+		}
+
+		return tx;
+	}
+
+	Sunset_Mac_Slot_Clock clock;
+	vector<double> tx;
+	bool pending;
+	double wake;
+	int waiting;
+	int handled;
+};
+
+static void testClock()
+{
+	Sunset_Mac_Slot_Clock c;
+
+	c.start(0.0, SLOT_TIME, SLOT_TIME);
+
+	// a boundary equal to now is passed only by advanceTo, update passes it unless the slot timer is pending on it
+
+	assert(c.advance(boundary[0]) == 0 && c.getCount() == 0);
+	assert(c.update(boundary[0], true) == 0 && c.getCount() == 0);
+	assert(c.update(boundary[0], false) == 1 && c.getCount() == 1 && c.getNext() == boundary[1]);
+	assert(c.advanceTo(boundary[0]) == 0);
+
+	assert(c.update(boundary[9] + 0.01, false) == 9 && c.getNext() == boundary[10]);
+	assert(c.getBoundary(30) == boundary[30]);
+
+	assert(Sunset_Mac_Slot_Clock::getNextInFrame(5, 2, 4) == 6);
+	assert(Sunset_Mac_Slot_Clock::getNextInFrame(6, 2, 4) == 6);
+	assert(Sunset_Mac_Slot_Clock::getNextInFrame(7, 2, 4) == 10);
+
+	c.stop();
+
+	assert(!c.isRunning() && c.advanceTo(1000.0) == 0);
+
+	puts("clock ok");
+}
+
+static void compare(const char* name, vector<double> arrivals)
+{
+	Skipping s;
+	vector<double> ref = perSlot(arrivals);
+	vector<double> tx = s.run(arrivals);
+
+	if ( ref != tx ) {
+
+		for ( unsigned int i = 0; i < ref.size() || i < tx.size(); i++ ) {
+
+			fprintf(stderr, "%s packet %d per slot %.9f skipping %.9f\n", name, i, i < ref.size() ? ref[i] : -1.0, i < tx.size() ? tx[i] : -1.0);
+		}
+
+		exit(1);
+	}
+
+	assert(s.handled == (int)tx.size());	// the node wakes up only to transmit
+
+	printf("%s ok: %d packets, %d slot events instead of %d\n", name, (int)tx.size(), s.handled, BOUNDARIES);
+}
+
+int main()
+{
+	vector<double> arrivals;
+
+	boundary[0] = SLOT_TIME;
+
+	for ( int k = 1; k < BOUNDARIES; k++ ) {
+
+		boundary[k] = boundary[k - 1] + SLOT_TIME;		// computed as the restarted slot timer does
+	}
+
+	testClock();
+
+	// packets arriving exactly on the own slot boundary, the one before and the one after: the slot is over when the
+	// packet arrives on its boundary
+
+	arrivals.clear();
+	arrivals.push_back(boundary[MY_SLOT]);
+	arrivals.push_back(boundary[MY_SLOT + 3 * SLOT_PER_FRAME - 1]);
+	arrivals.push_back(boundary[MY_SLOT + 6 * SLOT_PER_FRAME + 1]);
+	compare("exact boundaries", arrivals);
+
+	assert(perSlot(arrivals)[0] == boundary[MY_SLOT + SLOT_PER_FRAME]);
+	assert(perSlot(arrivals)[1] == boundary[MY_SLOT + 3 * SLOT_PER_FRAME]);
+
+	// every boundary, queued packets sent one per frame
+
+	arrivals.clear();
+
+	for ( int k = 0; k < 3 * SLOT_PER_FRAME; k++ ) {
+
+		arrivals.push_back(boundary[k]);
+	}
+
+	compare("all boundaries", arrivals);
+
+	// random times and bursts, some on the boundaries
+
+	srand(1);
+	arrivals.clear();
+
+	for ( int i = 0; i < 40; i++ ) {
+
+		double t = (rand() % 2) ? boundary[rand() % (BOUNDARIES / 2)] : (rand() % 10000) * (BOUNDARIES / 2) * SLOT_TIME / 10000.0;
+
+		arrivals.push_back(t);
+
+		if ( rand() % 4 == 0 ) {
+
+			arrivals.push_back(t);
+		}
+	}
+
+	sort(arrivals.begin(), arrivals.end());
+	compare("random arrivals", arrivals);
+
+	return 0;
+}
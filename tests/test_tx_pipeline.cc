@@ -0,0 +1,161 @@
+/* Sunset_Modem_Tx_Pipeline: a full pipeline, the credits of the window, the order of the frames and the frames still
+ * queued when the pipeline is destroyed.
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <sunset_modem_tx_pipeline.h>
+
+static Packet pkt[32];
+
+/* Converted packet: its ID as text. */
+
+static char* convert(Packet* p)
+{
+	char* buffer = (char*)malloc(8);
+
+	snprintf(buffer, 8, "%d", p->id_);
+
+	return buffer;
+}
+
+static bool push(Sunset_Modem_Tx_Pipeline& pipe, Packet* p)
+{
+	char* buffer = convert(p);
+
+	if ( !pipe.push(p, buffer, strlen(buffer), p->id_ % 4) ) {
+
+		free(buffer);
+
+		return false;
+	}
+
+	return true;
+}
+
+static void testFull()
+{
+	Sunset_Modem_Tx_Pipeline pipe(1, 3);
+	char* buffer = 0;
+
+	for ( int i = 0; i < 3; i++ ) {
+
+		assert(push(pipe, &pkt[i]));
+	}
+
+	// the buffer of a refused frame is still owned by the caller
+
+	buffer = (char*)malloc(8);
+
+	assert(!pipe.push(&pkt[3], buffer, 8, 1) && pipe.pending() == 3);
+
+	free(buffer);
+
+	assert(pipe.ready(0) && !pipe.ready(1));
+	assert(pipe.front()->p == &pkt[0] && pipe.pop() == &pkt[0] && pipe.pending() == 2);
+	assert(push(pipe, &pkt[3]));
+
+	// window and maximum length are at least one
+
+	pipe.setWindow(0);
+	pipe.setMaxPending(-1);
+
+	assert(pipe.getWindow() == 1 && !pipe.push(&pkt[4], 0, 0, 1));
+
+	assert(pipe.pop() == &pkt[1] && pipe.pop() == &pkt[2] && pipe.pop() == &pkt[3]);
+	assert(pipe.pop() == 0 && pipe.front() == 0 && !pipe.ready(0));
+
+	puts("full pipeline ok");
+}
+
+static void testWindow()
+{
+	Sunset_Modem_Tx_Pipeline pipe(3, 16);
+	sunset_tx_frame* f = 0;
+	int inFlight = 0;
+	int written = 0;
+
+	for ( int i = 0; i < 5; i++ ) {
+
+		assert(push(pipe, &pkt[i]));
+	}
+
+	// a credit per packet in flight, the frames keep the converted packet and its destination
+
+	while ( pipe.ready(inFlight) ) {
+
+		f = pipe.front();
+
+		assert(f->p == &pkt[written] && atoi(f->buffer) == written && f->len == (int)strlen(f->buffer) && f->dst == written % 4);
+
+		assert(pipe.pop() == &pkt[written]);
+
+		inFlight++;
+		written++;
+	}
+
+	assert(written == 3 && pipe.pending() == 2 && !pipe.ready(3));
+
+	// a completed packet returns a credit
+
+	assert(pipe.ready(2) && pipe.pop() == &pkt[3]);
+
+	// a smaller window takes effect with the next credit
+
+	pipe.setWindow(1);
+
+	assert(!pipe.ready(2) && !pipe.ready(1) && pipe.ready(0));
+	assert(pipe.pop() == &pkt[4] && !pipe.ready(0));
+
+	puts("window ok");
+}
+
+static void testDrain()
+{
+	Sunset_Modem_Tx_Pipeline pipe(1, 16);
+	int pending = 0;
+
+	for ( int i = 0; i < 4; i++ ) {
+
+		assert(push(pipe, &pkt[i]));
+	}
+
+	// the frames queued while the pipeline is drained stay queued, as done by the drivers on a reset
+
+	pending = pipe.pending();
+
+	while ( pending-- > 0 ) {
+
+		assert(pipe.pop() != 0);
+
+		if ( pending == 2 ) {
+
+			assert(push(pipe, &pkt[10]));
+		}
+	}
+
+	assert(pipe.pending() == 1 && pipe.front()->p == &pkt[10]);
+
+	// the frames still queued are freed with the pipeline
+
+	assert(push(pipe, &pkt[11]));
+	assert(push(pipe, &pkt[12]));
+
+	puts("drain ok");
+}
+
+int main()
+{
+	for ( int i = 0; i < 32; i++ ) {
+
+		pkt[i].id_ = i;
+	}
+
+	testFull();
+	testWindow();
+	testDrain();
+
+	return 0;
+}